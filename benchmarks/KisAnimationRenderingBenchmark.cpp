@@ -17,6 +17,18 @@
 #include "kis_image.h"
 #include "kis_image_config.h"
 
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+
+#include "KisInMemoryFrameCacheSwapper.h"
+#include "KisCompressedFrameCacheSwapper.h"
+#include "KisFrameCacheSwapper.h"
+#include "opengl/KisOpenGLUpdateInfoBuilder.h"
+
+#include "kis_update_info.h"
+
 namespace {
 void removeTempFiles(const QString &filesMask)
 {
@@ -97,4 +109,94 @@ void KisAnimationRenderingBenchmark::testCacheRendering()
     }
 }
 
+void KisAnimationRenderingBenchmark::benchmarkFrameCacheSwapper_data()
+{
+    QTest::addColumn<QString>("swapperType");
+
+    QTest::addRow("in-memory") << "in-memory";
+    QTest::addRow("compressed") << "compressed";
+    QTest::addRow("on-disk") << "on-disk";
+}
+
+void KisAnimationRenderingBenchmark::benchmarkFrameCacheSwapper()
+{
+    QFETCH(QString, swapperType);
+
+    // two seconds of a 1080p animation at 24 fps
+    const QRect bounds(0, 0, 1920, 1080);
+    const int numFrames = 48;
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP background = new KisPaintDevice(cs);
+
+    KisSequentialIterator it(background, bounds);
+    while (it.nextPixel()) {
+        quint8 *pixel = it.rawData();
+        pixel[0] = quint8(it.x() * 255 / bounds.width());
+        pixel[1] = quint8(it.y() * 255 / bounds.height());
+        pixel[2] = quint8((it.x() + it.y()) & 0xff);
+        pixel[3] = 255;
+    }
+
+    KisOpenGLUpdateInfoBuilder builder;
+    builder.setTextureInfoPool(toQShared(new KisTextureTileInfoPool(256, 256)));
+    builder.setConversionOptions(
+        ConversionOptions(cs,
+                          KoColorConversionTransformation::internalRenderingIntent(),
+                          KoColorConversionTransformation::internalConversionFlags()));
+    builder.setTextureBorder(4);
+    builder.setEffectiveTextureSize(QSize(248, 248));
+
+    QScopedPointer<KisAbstractFrameCacheSwapper> swapper;
+    KisCompressedFrameCacheSwapper *compressedSwapper = 0;
+
+    if (swapperType == "compressed") {
+        compressedSwapper = new KisCompressedFrameCacheSwapper(builder);
+        swapper.reset(compressedSwapper);
+    } else if (swapperType == "on-disk") {
+        swapper.reset(new KisFrameCacheSwapper(builder));
+    } else {
+        swapper.reset(new KisInMemoryFrameCacheSwapper());
+    }
+
+    // a character moving over a static background
+    QVector<KisOpenGLUpdateInfoSP> infos;
+    for (int i = 0; i < numFrames; i++) {
+        KisPaintDeviceSP frame = new KisPaintDevice(*background);
+        frame->fill(QRect(100 + 30 * i, 400, 200, 300), KoColor(Qt::blue, cs));
+        infos << builder.buildUpdateInfo(bounds, frame, bounds, 0, true);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < numFrames; i++) {
+        swapper->saveFrame(i, infos[i], bounds);
+    }
+    infos.clear();
+
+    const qint64 saveTime = timer.restart();
+
+    for (int i = 0; i < numFrames; i++) {
+        KisOpenGLUpdateInfoSP info = swapper->loadFrame(i);
+        QVERIFY(info);
+    }
+
+    const qint64 loadTime = timer.elapsed();
+
+    qDebug() << swapperType
+             << "Frames:" << numFrames
+             << "Memory (MiB):" << qreal(swapper->memoryUsage()) / 1024 / 1024
+             << "Save (ms/frame):" << qreal(saveTime) / numFrames
+             << "Load (ms/frame):" << qreal(loadTime) / numFrames;
+
+    if (compressedSwapper) {
+        const KisCompressedFrameCacheSwapper::Statistics stats = compressedSwapper->statistics();
+        qDebug() << "    Keyframes:" << stats.numKeyframes
+                 << "Raw (MiB):" << qreal(stats.rawSize) / 1024 / 1024
+                 << "Compressed (MiB):" << qreal(stats.compressedSize) / 1024 / 1024;
+    }
+}
+
 SIMPLE_TEST_MAIN(KisAnimationRenderingBenchmark)
@@ -14,6 +14,9 @@ class KisAnimationRenderingBenchmark : public QObject
     Q_OBJECT
 private Q_SLOTS:
    void testCacheRendering();
+
+   void benchmarkFrameCacheSwapper_data();
+   void benchmarkFrameCacheSwapper();
 };
 
 #endif // KISANIMATIONRENDERINGBENCHMARK_H
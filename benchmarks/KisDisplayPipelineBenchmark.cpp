@@ -0,0 +1,179 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDisplayPipelineBenchmark.h"
+
+#include <cmath>
+
+#include <QElapsedTimer>
+
+#include <KoColor.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+
+#include <canvas/kis_display_filter.h>
+#include <canvas/kis_exposure_gamma_correction_interface.h>
+#include <canvas/KisDisplayPipeline.h>
+
+#include "kis_benchmark_values.h"
+
+namespace {
+
+/**
+ * A stand-in for the OCIO filter: exposure and gamma, which are
+ * the part of every OCIO display processor
+ */
+class ExposureGammaDisplayFilter : public KisDisplayFilter
+{
+public:
+    ExposureGammaDisplayFilter(float exposure, float gamma)
+        : m_gain(std::pow(2.0f, exposure)),
+          m_exponent(1.0f / gamma)
+    {
+    }
+
+    QString program() const override {
+        return QString();
+    }
+
+    void setupTextures(GLFunctions *f, QOpenGLShaderProgram *program) const override {
+        Q_UNUSED(f);
+        Q_UNUSED(program);
+    }
+
+    void filter(quint8 *pixels, quint32 numPixels) override {
+        float *ptr = reinterpret_cast<float*>(pixels);
+
+        for (quint32 i = 0; i < numPixels; i++) {
+            for (int c = 0; c < 3; c++) {
+                ptr[c] = std::pow(qMax(0.0f, ptr[c] * m_gain), m_exponent);
+            }
+            ptr += 4;
+        }
+    }
+
+    void approximateInverseTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    void approximateForwardTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    bool useInternalColorManagement() const override {
+        return false;
+    }
+
+    KisExposureGammaCorrectionInterface *correctionInterface() const override {
+        return KisDumbExposureGammaCorrectionInterface::instance();
+    }
+
+    bool lockCurrentColorVisualRepresentation() const override {
+        return false;
+    }
+
+    bool updateShader() override {
+        return false;
+    }
+
+private:
+    float m_gain;
+    float m_exponent;
+};
+
+}
+
+void KisDisplayPipelineBenchmark::benchmarkFrame_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<bool>("useFusedPipeline");
+
+    const QStringList depthIds({Float16BitsColorDepthID.id(), Float32BitsColorDepthID.id()});
+
+    Q_FOREACH (const QString &depthId, depthIds) {
+        QTest::addRow("%s-separate", depthId.toLatin1().data()) << depthId << false;
+        QTest::addRow("%s-fused", depthId.toLatin1().data()) << depthId << true;
+    }
+}
+
+void KisDisplayPipelineBenchmark::benchmarkFrame()
+{
+    QFETCH(QString, depthId);
+    QFETCH(bool, useFusedPipeline);
+
+    const KoColorSpace *srcColorSpace =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId, 0);
+
+    if (!srcColorSpace) {
+        QSKIP("The color space is not available in this build");
+    }
+
+    const KoColorSpace *floatColorSpace =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+
+    const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent();
+    const KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags();
+
+    const QRect bounds(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    // a full HD viewport update in the middle of the document
+    const QRect frameRect(QPoint(TEST_IMAGE_WIDTH / 4, TEST_IMAGE_HEIGHT / 4), QSize(1920, 1080));
+    const int numPixels = frameRect.width() * frameRect.height();
+
+    KisPaintDeviceSP device = new KisPaintDevice(srcColorSpace);
+
+    KoColor color(srcColorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(device, bounds);
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), srcColorSpace->pixelSize());
+    }
+
+    QSharedPointer<KisDisplayFilter> filter(new ExposureGammaDisplayFilter(1.5, 2.2));
+
+    QScopedArrayPointer<quint8> dstPixels(new quint8[numPixels * dstColorSpace->pixelSize()]);
+
+    int numIterations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (useFusedPipeline) {
+        QBENCHMARK {
+            KisDisplayPipeline pipeline(srcColorSpace, filter, floatColorSpace, floatColorSpace, dstColorSpace,
+                                        renderingIntent, conversionFlags);
+            pipeline.apply(device, frameRect, dstPixels.data());
+            numIterations++;
+        }
+    } else {
+        QBENCHMARK {
+            QScopedArrayPointer<quint8> srcPixels(new quint8[numPixels * srcColorSpace->pixelSize()]);
+            device->readBytes(srcPixels.data(), frameRect);
+
+            QScopedArrayPointer<quint8> floatPixels(new quint8[numPixels * floatColorSpace->pixelSize()]);
+            srcColorSpace->convertPixelsTo(srcPixels.data(), floatPixels.data(), floatColorSpace,
+                                           numPixels, renderingIntent, conversionFlags);
+            filter->filter(floatPixels.data(), numPixels);
+            floatColorSpace->convertPixelsTo(floatPixels.data(), dstPixels.data(), dstColorSpace,
+                                             numPixels, renderingIntent, conversionFlags);
+            numIterations++;
+        }
+    }
+
+    qDebug() << depthId << (useFusedPipeline ? "fused" : "separate")
+             << "ms per frame:" << qreal(timer.elapsed()) / numIterations;
+}
+
+SIMPLE_TEST_MAIN(KisDisplayPipelineBenchmark)
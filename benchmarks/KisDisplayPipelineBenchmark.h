@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDISPLAYPIPELINEBENCHMARK_H
+#define KISDISPLAYPIPELINEBENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Measures the per-frame cost of converting an HDR projection for the
+ * display through a display filter: the legacy sequence of the
+ * full-size conversions against the fused KisDisplayPipeline.
+ */
+class KisDisplayPipelineBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkFrame_data();
+    void benchmarkFrame();
+};
+
+#endif // KISDISPLAYPIPELINEBENCHMARK_H
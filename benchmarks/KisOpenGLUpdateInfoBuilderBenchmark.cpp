@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOpenGLUpdateInfoBuilderBenchmark.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+
+#include <opengl/KisOpenGLUpdateInfoBuilder.h>
+#include <opengl/kis_texture_tile_update_info.h>
+
+#include <kis_update_info.h>
+
+#include "kis_benchmark_values.h"
+
+
+void KisOpenGLUpdateInfoBuilderBenchmark::benchmarkBuildUpdateInfo_data()
+{
+    QTest::addColumn<QString>("colorSpace");
+    QTest::addColumn<int>("numThreads");
+
+    const QStringList colorSpaces({"rgb8", "rgb16", "lab16"});
+
+    Q_FOREACH (const QString &colorSpace, colorSpaces) {
+        QTest::addRow("%s-serial", colorSpace.toLatin1().data()) << colorSpace << 1;
+        QTest::addRow("%s-parallel", colorSpace.toLatin1().data()) << colorSpace << 0;
+    }
+}
+
+void KisOpenGLUpdateInfoBuilderBenchmark::benchmarkBuildUpdateInfo()
+{
+    QFETCH(QString, colorSpace);
+    QFETCH(int, numThreads);
+
+    const KoColorSpace *srcColorSpace =
+        colorSpace == "rgb16" ? KoColorSpaceRegistry::instance()->rgb16() :
+        colorSpace == "lab16" ? KoColorSpaceRegistry::instance()->lab16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    const QRect bounds(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP device = new KisPaintDevice(srcColorSpace);
+
+    KoColor color(srcColorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(device, bounds);
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), srcColorSpace->pixelSize());
+    }
+
+    KisOpenGLUpdateInfoBuilder builder;
+    builder.setTextureInfoPool(toQShared(new KisTextureTileInfoPool(256, 256)));
+    builder.setConversionOptions(
+        ConversionOptions(KoColorSpaceRegistry::instance()->rgb8(),
+                          KoColorConversionTransformation::internalRenderingIntent(),
+                          KoColorConversionTransformation::internalConversionFlags()));
+    builder.setTextureBorder(4);
+    builder.setEffectiveTextureSize(QSize(248, 248));
+    builder.setMaxThreadCount(numThreads);
+
+    const qreal numMegapixels = qreal(bounds.width()) * bounds.height() / 1e6;
+    int numIterations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        KisOpenGLUpdateInfoSP info = builder.buildUpdateInfo(bounds, device, bounds, 0, true);
+        numIterations++;
+    }
+
+    qDebug() << colorSpace << "threads:" << (numThreads ? numThreads : QThread::idealThreadCount())
+             << "ms per megapixel:" << qreal(timer.elapsed()) / numIterations / numMegapixels;
+}
+
+SIMPLE_TEST_MAIN(KisOpenGLUpdateInfoBuilderBenchmark)
@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPENGLUPDATEINFOBUILDERBENCHMARK_H
+#define KISOPENGLUPDATEINFOBUILDERBENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Measures the time KisOpenGLUpdateInfoBuilder spends on reading and
+ * converting the projection into the texture updates. The builder does
+ * not touch OpenGL, so the benchmark runs without a GL context.
+ */
+class KisOpenGLUpdateInfoBuilderBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkBuildUpdateInfo_data();
+    void benchmarkBuildUpdateInfo();
+};
+
+#endif // KISOPENGLUPDATEINFOBUILDERBENCHMARK_H
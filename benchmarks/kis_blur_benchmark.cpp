@@ -28,6 +28,16 @@
 
 #include <KisPortingUtils.h>
 
+#include "kis_convolution_painter.h"
+#include "kis_gaussian_kernel.h"
+#include "KisRecursiveGaussianBlur.h"
+
+#include "config_convolution.h"
+
+#ifdef HAVE_FFTW3
+#include "KisFFTWPlanCache.h"
+#endif
+
 void KisBlurBenchmark::initTestCase()
 {
     m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();    
@@ -79,5 +89,94 @@ void KisBlurBenchmark::benchmarkFilter()
 }
 
 
+void KisBlurBenchmark::benchmarkConvolution_data()
+{
+    QTest::addColumn<QString>("engine");
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<bool>("coldPlanCache");
+    QTest::addColumn<bool>("tiled");
+
+    for (int radius : {5, 20, 50}) {
+        QTest::addRow("spatial-%d", radius) << "spatial" << radius << false << false;
+        QTest::addRow("fftw-%d", radius) << "fftw" << radius << false << false;
+        QTest::addRow("fftw-%d-cold-plans", radius) << "fftw" << radius << true << false;
+        QTest::addRow("fftw-%d-tiled", radius) << "fftw" << radius << false << true;
+        QTest::addRow("recursive-%d", radius) << "recursive" << radius << false << false;
+    }
+}
+
+void KisBlurBenchmark::benchmarkConvolution()
+{
+    QFETCH(QString, engine);
+    QFETCH(int, radius);
+    QFETCH(bool, coldPlanCache);
+    QFETCH(bool, tiled);
+
+    const bool useFftw = engine == "fftw";
+
+    if (useFftw && !KisConvolutionPainter::supportsFFTW()) {
+        QSKIP("Krita is built without FFTW3");
+    }
+
+    const QRect applyRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+
+    if (engine == "recursive") {
+        KisPaintDeviceSP dst = new KisPaintDevice(*m_device);
+
+        QBENCHMARK {
+            KisRecursiveGaussianBlur blur(radius, radius);
+            blur.apply(dst, applyRect, BORDER_REPEAT);
+        }
+
+        return;
+    }
+
+    KisConvolutionKernelSP kernelHoriz = KisGaussianKernel::createHorizontalKernel(radius);
+    KisConvolutionKernelSP kernelVertical = KisGaussianKernel::createVerticalKernel(radius);
+
+    KisConvolutionPainter::EnginePreference enginePreference =
+        useFftw ? KisConvolutionPainter::FFTW : KisConvolutionPainter::SPATIAL;
+
+#ifdef HAVE_FFTW3
+    KisFFTWPlanCache *planCache = KisFFTWPlanCache::instance();
+    const qint64 oldMaxMemory = planCache->maxTransformMemory();
+
+    if (tiled) {
+        planCache->setMaxTransformMemory(16 * 1024 * 1024);
+    }
+#else
+    Q_UNUSED(tiled);
+#endif
+
+    KisPaintDeviceSP interm = new KisPaintDevice(m_colorSpace);
+    KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+
+    QBENCHMARK {
+#ifdef HAVE_FFTW3
+        if (coldPlanCache) {
+            planCache->clear();
+        }
+#else
+        Q_UNUSED(coldPlanCache);
+#endif
+
+        KisConvolutionPainter horizPainter(interm, enginePreference);
+        horizPainter.applyMatrix(kernelHoriz, m_device,
+                                 applyRect.topLeft() - QPoint(0, radius),
+                                 applyRect.topLeft() - QPoint(0, radius),
+                                 applyRect.size() + QSize(0, 2 * radius),
+                                 BORDER_REPEAT);
+
+        KisConvolutionPainter verticalPainter(dst, enginePreference);
+        verticalPainter.applyMatrix(kernelVertical, interm,
+                                    applyRect.topLeft(),
+                                    applyRect.topLeft(),
+                                    applyRect.size(), BORDER_REPEAT);
+    }
+
+#ifdef HAVE_FFTW3
+    planCache->setMaxTransformMemory(oldMaxMemory);
+#endif
+}
 
 SIMPLE_TEST_MAIN(KisBlurBenchmark)
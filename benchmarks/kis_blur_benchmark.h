@@ -27,6 +27,9 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
+
+    void benchmarkConvolution_data();
+    void benchmarkConvolution();
     
 };
 
@@ -29,6 +29,7 @@
 #include <KoCompositeOpOver.h>
 #include <KoCompositeOpCopy2.h>
 #include <KoOptimizedCompositeOpFactory.h>
+#include <KoOptimizedCompositeOpGenericSCModes.h>
 #include <KoAlphaDarkenParamsWrapper.h>
 
 // for posix_memalign()
@@ -885,6 +886,43 @@ void KisCompositionBenchmark::compareRgbF32CopyOps()
     delete opAct;
 }
 
+template<typename channels_type>
+void compareGenericSCOps(const KoColorSpace *cs,
+                         KoCompositeOp* (*createOptimizedOp)(const KoColorSpace*, const QString&, const QString&))
+{
+    Q_FOREACH (const QString &id, KoOptimizedGenericSCModes::ids()) {
+        KoCompositeOp *opAct = createOptimizedOp(cs, id, QString());
+        KoCompositeOp *opExp = KoOptimizedGenericSCModes::createLegacyOp<channels_type>(cs, id, QString());
+
+        QVERIFY2(opAct, qPrintable(id));
+        QVERIFY2(opExp, qPrintable(id));
+
+        QVERIFY2(compareTwoOps(true, opAct, opExp), qPrintable(id));
+        QVERIFY2(compareTwoOps(false, opAct, opExp), qPrintable(id));
+
+        delete opExp;
+        delete opAct;
+    }
+}
+
+void KisCompositionBenchmark::compareRgbU8GenericSCOps()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    compareGenericSCOps<quint8>(cs, &KoOptimizedCompositeOpFactory::createGenericSCOp32);
+}
+
+void KisCompositionBenchmark::compareRgbU16GenericSCOps()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+    compareGenericSCOps<quint16>(cs, &KoOptimizedCompositeOpFactory::createGenericSCOpU64);
+}
+
+void KisCompositionBenchmark::compareRgbF32GenericSCOps()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F32", "");
+    compareGenericSCOps<float>(cs, &KoOptimizedCompositeOpFactory::createGenericSCOp128);
+}
+
 void KisCompositionBenchmark::testRgb8CompositeAlphaDarkenLegacy()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -47,6 +47,10 @@ private Q_SLOTS:
     void compareRgbU16CopyOps();
     void compareRgbF32CopyOps();
 
+    void compareRgbU8GenericSCOps();
+    void compareRgbU16GenericSCOps();
+    void compareRgbF32GenericSCOps();
+
     void testRgb8CompositeAlphaDarkenLegacy();
     void testRgb8CompositeAlphaDarkenOptimized();
 
@@ -9,6 +9,7 @@
 
 #include <simpletest.h>
 #include <kis_datamanager.h>
+#include <tiles3/swap/kis_tile_compressor_2.h>
 
 // RGBA
 #define PIXEL_SIZE 4
@@ -186,5 +187,157 @@ void KisDatamanagerBenchmark::benchmarkMemCpy()
     delete[] dst;
 }
 
+// 16-bit RGBA
+#define SWAP_PIXEL_SIZE 8
+#define SWAP_IMAGE_SIZE 2048
+
+namespace {
+
+/**
+ * Fills the data manager with a 16-bit gradient and a bit of noise,
+ * which is close to what we usually have in real paintings
+ */
+void fillSwapTestData(KisDataManager &dm)
+{
+    QVector<quint16> bytes(4 * SWAP_IMAGE_SIZE * SWAP_IMAGE_SIZE);
+    quint32 seed = 1;
+
+    quint16 *ptr = bytes.data();
+    for (int y = 0; y < SWAP_IMAGE_SIZE; y++) {
+        for (int x = 0; x < SWAP_IMAGE_SIZE; x++) {
+            seed = seed * 1103515245 + 12345;
+            const quint16 noise = (seed >> 16) & 0xff;
+
+            *ptr++ = quint16(x * 32 + noise);
+            *ptr++ = quint16(y * 32 + noise);
+            *ptr++ = quint16((x + y) * 16);
+            *ptr++ = 0xffff;
+        }
+    }
+
+    dm.writeBytes((quint8*)bytes.data(), 0, 0, SWAP_IMAGE_SIZE, SWAP_IMAGE_SIZE);
+}
+
+QVector<KisTileSP> collectTiles(KisDataManager &dm)
+{
+    QVector<KisTileSP> tiles;
+
+    const int numTiles = SWAP_IMAGE_SIZE / KisTileData::WIDTH;
+    for (int row = 0; row < numTiles; row++) {
+        for (int col = 0; col < numTiles; col++) {
+            tiles << dm.getTile(col, row, false);
+        }
+    }
+
+    return tiles;
+}
+
+void addCodecRows()
+{
+    QTest::addColumn<int>("codec");
+
+    Q_FOREACH (KisCompressionRegistry::CodecId codec,
+               KisCompressionRegistry::availableCodecs()) {
+
+        QTest::newRow(KisCompressionRegistry::codecName(codec).toLatin1().data()) << int(codec);
+    }
+}
+
+}
+
+void KisDatamanagerBenchmark::benchmarkSwapCompression_data()
+{
+    addCodecRows();
+}
+
+void KisDatamanagerBenchmark::benchmarkSwapCompression()
+{
+    QFETCH(int, codec);
+
+    quint8 defaultPixel[SWAP_PIXEL_SIZE];
+    memset(defaultPixel, 0, SWAP_PIXEL_SIZE);
+    KisDataManager dm(SWAP_PIXEL_SIZE, defaultPixel);
+    fillSwapTestData(dm);
+
+    const QVector<KisTileSP> tiles = collectTiles(dm);
+
+    KisTileCompressor2 compressor;
+    compressor.setSwapCodecs(KisCompressionRegistry::CodecId(codec),
+                             KisCompressionRegistry::CodecId(codec));
+
+    QByteArray buffer(compressor.tileDataBufferSize(tiles.first()->tileData()), 0);
+    qint64 compressedSize = 0;
+
+    QBENCHMARK {
+        compressedSize = 0;
+
+        Q_FOREACH (KisTileSP tile, tiles) {
+            qint32 bytesWritten = 0;
+
+            tile->lockForRead();
+            compressor.compressTileData(tile->tileData(), (quint8*)buffer.data(),
+                                        buffer.size(), bytesWritten);
+            tile->unlockForRead();
+
+            compressedSize += bytesWritten;
+        }
+    }
+
+    const qint64 uncompressedSize =
+        qint64(SWAP_PIXEL_SIZE) * SWAP_IMAGE_SIZE * SWAP_IMAGE_SIZE;
+
+    qDebug() << "Codec:" << KisCompressionRegistry::codecName(KisCompressionRegistry::CodecId(codec))
+             << "compressed size:" << compressedSize << "/" << uncompressedSize
+             << "ratio:" << qreal(compressedSize) / uncompressedSize;
+}
+
+void KisDatamanagerBenchmark::benchmarkSwapDecompression_data()
+{
+    addCodecRows();
+}
+
+void KisDatamanagerBenchmark::benchmarkSwapDecompression()
+{
+    QFETCH(int, codec);
+
+    quint8 defaultPixel[SWAP_PIXEL_SIZE];
+    memset(defaultPixel, 0, SWAP_PIXEL_SIZE);
+    KisDataManager dm(SWAP_PIXEL_SIZE, defaultPixel);
+    fillSwapTestData(dm);
+
+    const QVector<KisTileSP> tiles = collectTiles(dm);
+
+    KisTileCompressor2 compressor;
+    compressor.setSwapCodecs(KisCompressionRegistry::CodecId(codec),
+                             KisCompressionRegistry::CodecId(codec));
+
+    const qint32 bufferSize = compressor.tileDataBufferSize(tiles.first()->tileData());
+    QVector<QByteArray> compressedTiles;
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        QByteArray buffer(bufferSize, 0);
+        qint32 bytesWritten = 0;
+
+        tile->lockForRead();
+        compressor.compressTileData(tile->tileData(), (quint8*)buffer.data(),
+                                    buffer.size(), bytesWritten);
+        tile->unlockForRead();
+
+        buffer.resize(bytesWritten);
+        compressedTiles << buffer;
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < tiles.size(); i++) {
+            KisTileSP tile = tiles[i];
+
+            tile->lockForWrite();
+            compressor.decompressTileData((quint8*)compressedTiles[i].data(),
+                                          compressedTiles[i].size(),
+                                          tile->tileData());
+            tile->unlockForWrite();
+        }
+    }
+}
 
 SIMPLE_TEST_MAIN(KisDatamanagerBenchmark)
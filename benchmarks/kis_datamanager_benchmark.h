@@ -24,6 +24,11 @@ private Q_SLOTS:
     void benchmarkExtent();
     void benchmarkClear();
     void benchmarkMemCpy();
+
+    void benchmarkSwapCompression_data();
+    void benchmarkSwapCompression();
+    void benchmarkSwapDecompression_data();
+    void benchmarkSwapDecompression();
 };
 
 #endif
@@ -21,6 +21,11 @@
 #include "kis_floodfill_benchmark.h"
 
 #include <kis_fill_painter.h>
+#include <kis_pixel_selection.h>
+#include <kis_default_bounds.h>
+#include <floodfill/kis_scanline_fill.h>
+
+static const int LARGE_IMAGE_SIZE = 8192;
 
 void KisFloodFillBenchmark::initTestCase()
 {
@@ -70,6 +75,27 @@ void KisFloodFillBenchmark::initTestCase()
     m_existingSelection = new KisPaintDevice(alphacs);
     m_existingSelection->fill(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT, defaultSelected.data());
 
+    // a large "lineart" layer: a grid of cells with doors in their walls,
+    // so that the filled region winds through the whole image
+    m_largeLineartDevice = new KisPaintDevice(m_colorSpace);
+    const KoColor lineColor(Qt::black, m_colorSpace);
+
+    const int cellSize = 97;
+    const int lineWidth = 3;
+    const int doorSize = 11;
+
+    for (int y = 0; y < LARGE_IMAGE_SIZE; y += cellSize) {
+        for (int x = 0; x < LARGE_IMAGE_SIZE; x += cellSize) {
+            const int doorX = rand() % (cellSize - doorSize);
+            const int doorY = rand() % (cellSize - doorSize);
+
+            m_largeLineartDevice->fill(QRect(x, y, doorX, lineWidth), lineColor);
+            m_largeLineartDevice->fill(QRect(x + doorX + doorSize, y, cellSize - doorX - doorSize, lineWidth), lineColor);
+
+            m_largeLineartDevice->fill(QRect(x, y, lineWidth, doorY), lineColor);
+            m_largeLineartDevice->fill(QRect(x, y + doorY + doorSize, lineWidth, cellSize - doorY - doorSize), lineColor);
+        }
+    }
 }
 
 void KisFloodFillBenchmark::benchmarkFlood()
@@ -171,6 +197,68 @@ void KisFloodFillBenchmark::benchmarkFloodWithSelectionAsBoundary()
 }
 
 
+void KisFloodFillBenchmark::benchmarkFloodGapClosing()
+{
+    KoColor fg(m_colorSpace);
+    KoColor bg(m_colorSpace);
+    fg.fromQColor(Qt::blue);
+    bg.fromQColor(Qt::black);
+
+    QBENCHMARK
+    {
+        KisFillPainter fillPainter(m_deviceWithoutSelectionAsBoundary);
+        fillPainter.setPaintColor( fg );
+        fillPainter.setBackgroundColor( bg );
+
+        fillPainter.beginTransaction(kundo2_noi18n("Flood Fill"));
+
+        fillPainter.setOpacityToUnit();
+        fillPainter.setFillThreshold(15);
+        fillPainter.setCompositeOpId(COMPOSITE_OVER);
+        fillPainter.setCareForSelection(true);
+        fillPainter.setWidth(GMP_IMAGE_WIDTH);
+        fillPainter.setHeight(GMP_IMAGE_HEIGHT);
+        fillPainter.setUseSelectionAsBoundary(false);
+        fillPainter.setUseCompositing(true);
+        fillPainter.setCloseGap(5);
+
+        fillPainter.createFloodSelection(1, 1, m_deviceWithoutSelectionAsBoundary, m_existingSelection);
+
+        fillPainter.deleteTransaction();
+    }
+}
+
+void KisFloodFillBenchmark::benchmarkFloodLargeImage(bool parallel)
+{
+    const QRect boundingRect(0, 0, LARGE_IMAGE_SIZE, LARGE_IMAGE_SIZE);
+    QRect fillExtent;
+
+    QBENCHMARK
+    {
+        KisPixelSelectionSP pixelSelection =
+            new KisPixelSelection(new KisSelectionDefaultBounds(m_largeLineartDevice));
+
+        KisScanlineFill gc(m_largeLineartDevice, QPoint(LARGE_IMAGE_SIZE / 2, LARGE_IMAGE_SIZE / 2), boundingRect);
+        gc.setThreshold(15);
+        gc.setParallelFillEnabled(parallel);
+        gc.fillSelection(pixelSelection);
+
+        fillExtent = gc.fillExtent();
+    }
+
+    qDebug() << "Filled extent:" << fillExtent;
+}
+
+void KisFloodFillBenchmark::benchmarkFloodLargeImageSerial()
+{
+    benchmarkFloodLargeImage(false);
+}
+
+void KisFloodFillBenchmark::benchmarkFloodLargeImageParallel()
+{
+    benchmarkFloodLargeImage(true);
+}
+
 void KisFloodFillBenchmark::cleanupTestCase()
 {
 
@@ -25,6 +25,7 @@ private:
     KisPaintDeviceSP m_deviceWithSelectionAsBoundary;
     KisPaintDeviceSP m_deviceWithoutSelectionAsBoundary;
     KisPaintDeviceSP m_existingSelection;
+    KisPaintDeviceSP m_largeLineartDevice;
     int m_startX;
     int m_startY;
     
@@ -36,9 +37,13 @@ private Q_SLOTS:
     void benchmarkFloodWithoutSelectionAsBoundary();
     void benchmarkFloodWithSelectionAsBoundary();
 
-    
-    
-    
+    void benchmarkFloodGapClosing();
+
+    void benchmarkFloodLargeImageSerial();
+    void benchmarkFloodLargeImageParallel();
+
+private:
+    void benchmarkFloodLargeImage(bool parallel);
 };
 
 #endif
@@ -0,0 +1,78 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_liquify_benchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+#include <kis_liquify_transform_worker.h>
+
+void KisLiquifyBenchmark::initTestCase()
+{
+    m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(m_colorSpace);
+
+    KoColor color(m_colorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(m_device, QRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT));
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), m_colorSpace->pixelSize());
+    }
+}
+
+void KisLiquifyBenchmark::cleanupTestCase()
+{
+}
+
+void KisLiquifyBenchmark::benchmarkStroke_data()
+{
+    QTest::addColumn<bool>("incremental");
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("full-serial") << false << 1;
+    QTest::newRow("full-parallel") << false << 0;
+    QTest::newRow("incremental-serial") << true << 1;
+    QTest::newRow("incremental-parallel") << true << 0;
+}
+
+void KisLiquifyBenchmark::benchmarkStroke()
+{
+    QFETCH(bool, incremental);
+    QFETCH(int, numThreads);
+
+    KisLiquifyTransformWorker worker(m_device->exactBounds(), 0, 8);
+    worker.setMaxThreadCount(numThreads);
+
+    KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+    worker.run(m_device, dst);
+
+    const int numDabs = 20;
+    const QPointF strokeStart(0.3 * GMP_IMAGE_WIDTH, 0.4 * GMP_IMAGE_HEIGHT);
+    const QPointF strokeStep(30, 15);
+
+    QBENCHMARK {
+        for (int i = 0; i < numDabs; i++) {
+            worker.translatePoints(strokeStart + i * strokeStep, strokeStep, 80, false, 0.2);
+
+            if (incremental) {
+                worker.runIncremental(m_device, dst);
+            } else {
+                worker.run(m_device, dst);
+            }
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisLiquifyBenchmark)
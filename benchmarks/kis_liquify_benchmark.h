@@ -0,0 +1,34 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_LIQUIFY_BENCHMARK_H
+#define KIS_LIQUIFY_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KoColorSpace;
+
+/**
+ * Measures the throughput of a liquify stroke, applying the
+ * deformation to the layer after every dab
+ */
+class KisLiquifyBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    const KoColorSpace *m_colorSpace;
+    KisPaintDeviceSP m_device;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkStroke_data();
+    void benchmarkStroke();
+};
+
+#endif
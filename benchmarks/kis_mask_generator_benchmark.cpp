@@ -6,8 +6,18 @@
 
 #include <simpletest.h>
 
+#include <cmath>
+
 #include "kis_mask_generator_benchmark.h"
 
+#include <KoColor.h>
+#include <kis_auto_brush.h>
+#include <kis_dab_cache.h>
+#include <KisDabMaskCache.h>
+#include <kis_precision_option.h>
+#include <kis_paint_information.h>
+#include <kis_dab_shape.h>
+
 #include "kis_circle_mask_generator.h"
 #include "kis_rect_mask_generator.h"
 
@@ -81,4 +91,76 @@ void KisMaskGeneratorBenchmark::benchmarkSquare()
     }
 }
 
+namespace {
+
+void benchmarkTabletStroke(bool useSharedCache)
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColor color(Qt::black, cs);
+
+    KisCircleMaskGenerator *circle = new KisCircleMaskGenerator(150, 1.0, 0.5, 0.5, 2, false);
+    KisBrushSP brush(new KisAutoBrush(circle, 0.0, 0.0));
+
+    // the precision level used by auto-precision for big brushes
+    KisPropertiesConfiguration config;
+    KisPrecisionOption precisionOption(&config);
+    precisionOption.setPrecisionLevel(3);
+
+    /**
+     * Emulate a typical tablet input: the pressure changes smoothly
+     * along the path, so the size of the dabs changes almost with
+     * every dab and the same sizes repeat within the stroke
+     */
+    QVector<KisPaintInformation> path;
+    for (int i = 0; i < 1000; i++) {
+        const QPointF pos(100.0 + 0.73 * i, 100.0 + 0.31 * i);
+        const qreal pressure = 0.5 + 0.4 * std::sin(0.05 * i);
+        path << KisPaintInformation(pos, pressure);
+    }
+
+    KisDabMaskCache::instance()->clear();
+    KisDabMaskCache::instance()->resetStatistics();
+
+    int numStrokes = 0;
+
+    QBENCHMARK {
+        // the dab cache is recreated for every stroke, like in the paintop
+        KisDabCache cache(brush);
+        cache.setPrecisionOption(&precisionOption);
+        cache.setSharedCacheEnabled(useSharedCache);
+
+        QRect dstDabRect;
+
+        Q_FOREACH (const KisPaintInformation &info, path) {
+            cache.fetchDab(cs, color, info.pos(),
+                           KisDabShape(info.pressure(), 1.0, 0.0),
+                           info, 1.0, &dstDabRect);
+        }
+
+        numStrokes++;
+    }
+
+    const KisDabMaskCache::Statistics stats = KisDabMaskCache::instance()->statistics();
+
+    qDebug() << "Shared cache:" << useSharedCache
+             << "strokes:" << numStrokes
+             << "hits:" << stats.hits
+             << "misses:" << stats.misses
+             << "hit rate:" << stats.hitRate()
+             << "entries:" << stats.numEntries
+             << "memory:" << stats.memoryUsage;
+}
+
+}
+
+void KisMaskGeneratorBenchmark::benchmarkTabletStrokeDabs()
+{
+    benchmarkTabletStroke(false);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkTabletStrokeDabsSharedCache()
+{
+    benchmarkTabletStroke(true);
+}
+
 SIMPLE_TEST_MAIN(KisMaskGeneratorBenchmark)
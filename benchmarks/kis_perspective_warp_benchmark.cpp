@@ -0,0 +1,119 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_perspective_warp_benchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <QThread>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+#include <kis_perspectivetransform_worker.h>
+#include <kis_warptransform_worker.h>
+
+void KisPerspectiveWarpBenchmark::initTestCase()
+{
+    m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(m_colorSpace);
+
+    const QRect imageRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+
+    KoColor color(m_colorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(m_device, imageRect);
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), m_colorSpace->pixelSize());
+    }
+
+    const QRectF bounds = imageRect;
+
+    m_origPoints << bounds.topLeft();
+    m_origPoints << bounds.topRight();
+    m_origPoints << bounds.bottomRight();
+    m_origPoints << bounds.bottomLeft();
+    m_origPoints << bounds.center();
+    m_origPoints << bounds.center() + QPointF(-200, 0);
+
+    m_transfPoints << bounds.topLeft();
+    m_transfPoints << bounds.bottomLeft() + 0.6 * (bounds.topRight() - bounds.bottomLeft());
+    m_transfPoints << bounds.topLeft() + 0.8 * (bounds.bottomRight() - bounds.topLeft());
+    m_transfPoints << bounds.bottomLeft() + QPointF(200, 0);
+    m_transfPoints << bounds.center() + QPointF(400, 200);
+    m_transfPoints << bounds.center() + QPointF(-200, 0) + QPointF(-400, 200);
+}
+
+void KisPerspectiveWarpBenchmark::cleanupTestCase()
+{
+}
+
+static void addThreadCountColumn()
+{
+    QTest::addColumn<int>("numThreads");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+
+    for (int numThreads = 1; numThreads < idealThreadCount; numThreads *= 2) {
+        QTest::newRow(QString("threads-%1").arg(numThreads).toLatin1()) << numThreads;
+    }
+    QTest::newRow(QString("threads-%1").arg(idealThreadCount).toLatin1()) << idealThreadCount;
+}
+
+static void runPerspective(KisPaintDeviceSP device, int numThreads)
+{
+    QBENCHMARK {
+        KisPaintDeviceSP dev = new KisPaintDevice(*device);
+
+        KisPerspectiveTransformWorker worker(dev, QPointF(GMP_IMAGE_WIDTH / 2, GMP_IMAGE_HEIGHT / 2),
+                                             0.72, 0.4, 1024, false, 0);
+        worker.setMaxThreadCount(numThreads);
+        worker.run();
+    }
+}
+
+static void runWarp(KisPaintDeviceSP device, int numThreads,
+                    const QVector<QPointF> &origPoints, const QVector<QPointF> &transfPoints)
+{
+    QBENCHMARK {
+        KisPaintDeviceSP dev = new KisPaintDevice(device->colorSpace());
+
+        KisWarpTransformWorker worker(KisWarpTransformWorker::RIGID_TRANSFORM,
+                                      origPoints, transfPoints, 1.0, 0);
+        worker.setMaxThreadCount(numThreads);
+        worker.run(device, dev);
+    }
+}
+
+void KisPerspectiveWarpBenchmark::benchmarkPerspective_data()
+{
+    addThreadCountColumn();
+}
+
+void KisPerspectiveWarpBenchmark::benchmarkPerspective()
+{
+    QFETCH(int, numThreads);
+    runPerspective(m_device, numThreads);
+}
+
+void KisPerspectiveWarpBenchmark::benchmarkWarp_data()
+{
+    addThreadCountColumn();
+}
+
+void KisPerspectiveWarpBenchmark::benchmarkWarp()
+{
+    QFETCH(int, numThreads);
+    runWarp(m_device, numThreads, m_origPoints, m_transfPoints);
+}
+
+SIMPLE_TEST_MAIN(KisPerspectiveWarpBenchmark)
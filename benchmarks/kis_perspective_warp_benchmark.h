@@ -0,0 +1,40 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_PERSPECTIVE_WARP_BENCHMARK_H
+#define KIS_PERSPECTIVE_WARP_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KoColorSpace;
+
+/**
+ * Measures the speedup of KisPerspectiveTransformWorker and
+ * KisWarpTransformWorker depending on the number of threads they
+ * may use
+ */
+class KisPerspectiveWarpBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    const KoColorSpace *m_colorSpace;
+    KisPaintDeviceSP m_device;
+
+    QVector<QPointF> m_origPoints;
+    QVector<QPointF> m_transfPoints;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkPerspective_data();
+    void benchmarkPerspective();
+    void benchmarkWarp_data();
+    void benchmarkWarp();
+};
+
+#endif
@@ -14,6 +14,7 @@
 #include <kis_paint_device.h>
 #include <KisDocument.h>
 #include <kis_image.h>
+#include <kis_image_config.h>
 #include <KisPart.h>
 
 void KisProjectionBenchmark::initTestCase()
@@ -46,5 +47,50 @@ void KisProjectionBenchmark::benchmarkLoading()
     }
 }
 
+void KisProjectionBenchmark::benchmarkRefreshGraph_data()
+{
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<bool>("useWorkStealing");
+
+    for (int numThreads = 8; numThreads <= 64; numThreads *= 2) {
+        QTest::addRow("qthreadpool-%d", numThreads) << numThreads << false;
+        QTest::addRow("work-stealing-%d", numThreads) << numThreads << true;
+    }
+}
+
+void KisProjectionBenchmark::benchmarkRefreshGraph()
+{
+    QFETCH(int, numThreads);
+    QFETCH(bool, useWorkStealing);
+
+    const int oldNumThreads = KisImageConfig(true).maxNumberOfThreads();
+    const bool oldUseWorkStealing = KisImageConfig(true).useWorkStealingUpdater();
+
+    {
+        // the scheduler reads these values on creation of the image
+        KisImageConfig cfg(false);
+        cfg.setMaxNumberOfThreads(numThreads);
+        cfg.setUseWorkStealingUpdater(useWorkStealing);
+    }
+
+    KisDocument *doc = KisPart::instance()->createDocument();
+    doc->loadNativeFormat(QString(FILES_DATA_DIR) + '/' + "load_test.kra");
+    KisImageSP image = doc->image();
+    image->initialRefreshGraph();
+
+    QBENCHMARK {
+        image->refreshGraphAsync();
+        image->waitForDone();
+    }
+
+    image.clear();
+    delete doc;
+
+    {
+        KisImageConfig cfg(false);
+        cfg.setMaxNumberOfThreads(oldNumThreads);
+        cfg.setUseWorkStealingUpdater(oldUseWorkStealing);
+    }
+}
 
 SIMPLE_TEST_MAIN(KisProjectionBenchmark)
@@ -20,6 +20,8 @@ private Q_SLOTS:
 
     void benchmarkProjection();
     void benchmarkLoading();
+    void benchmarkRefreshGraph_data();
+    void benchmarkRefreshGraph();
 };
 
 #endif
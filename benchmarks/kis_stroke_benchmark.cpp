@@ -40,6 +40,15 @@ inline double drand48()
 
 #include <KisGlobalResourcesInterface.h>
 
+#include <kis_image_config.h>
+#include <kis_simple_stroke_strategy.h>
+#include <KisRunnableBasedStrokeStrategy.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobsInterface.h>
+#include <brushengine/kis_paintop.h>
+#include <brushengine/kis_paintop_settings.h>
+#include <KoID.h>
+
 //#define SAVE_OUTPUT
 
 static const int LINES = 20;
@@ -348,6 +357,16 @@ void KisStrokeBenchmark::colorsmudgeRL()
 }
 
 
+void KisStrokeBenchmark::mypaint300pxRL()
+{
+    benchmarkMyPaint(false);
+}
+
+void KisStrokeBenchmark::mypaint300pxBatchedRL()
+{
+    benchmarkMyPaint(true);
+}
+
 void KisStrokeBenchmark::roundMarker()
 {
     // Quick Brush engine ( b) Basic - 1 brush, size 40px)
@@ -584,6 +603,64 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
 #endif
 }
 
+void KisStrokeBenchmark::benchmarkMyPaint(bool useAsynchronousUpdates)
+{
+    KisPaintOpPresetSP preset =
+        KisPaintOpRegistry::instance()->defaultPreset(KoID("mypaintbrush"),
+                                                      KisGlobalResourcesInterface::instance());
+    if (!preset) {
+        QSKIP("MyPaint paintop is not available");
+    }
+
+    preset->settings()->setPaintOpSize(300);
+    m_painter->setPaintOpPreset(preset, m_layer, m_image);
+
+    /**
+     * The lines are painted inside a stroke, so that the paintop could
+     * render the queued dabs in the stroke jobs, like in a freehand stroke
+     */
+    QBENCHMARK{
+        KisRunnableBasedStrokeStrategy *strategy =
+            new KisRunnableBasedStrokeStrategy(QLatin1String("mypaint-benchmark-stroke"));
+        KisRunnableStrokeJobsInterface *jobsInterface = strategy->runnableJobsInterface();
+
+        KisStrokeId id = m_image->startStroke(strategy);
+
+        QSharedPointer<KisDistanceInformation> currentDistance(new KisDistanceInformation());
+
+        auto doUpdate = [this, jobsInterface] () {
+            QVector<KisRunnableStrokeJobData*> jobs;
+            m_painter->paintOp()->doAsynchronousUpdate(jobs);
+            jobsInterface->addRunnableJobs(jobs);
+        };
+
+        for (int i = 0; i < LINES; i++){
+            KisPaintInformation pi1(m_startPoints[i], 0.0);
+            KisPaintInformation pi2(m_endPoints[i], 1.0);
+
+            m_image->addJob(id, new KisRunnableStrokeJobData(
+                [this, pi1, pi2, currentDistance, doUpdate, useAsynchronousUpdates] () {
+                    m_painter->paintLine(pi1, pi2, currentDistance.data());
+
+                    if (useAsynchronousUpdates) {
+                        doUpdate();
+                    }
+                }));
+        }
+
+        if (useAsynchronousUpdates) {
+            m_image->addJob(id, new KisRunnableStrokeJobData(doUpdate));
+        }
+
+        m_image->endStroke(id);
+        m_image->waitForDone();
+    }
+
+#ifdef SAVE_OUTPUT
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + "mypaint300px_randomLines" + OUTPUT_FORMAT);
+#endif
+}
+
 static const int COUNT = 1000000;
 void KisStrokeBenchmark::benchmarkRand48()
 {
@@ -621,5 +698,96 @@ void KisStrokeBenchmark::benchmarkPresetCloning()
     }
 }
 
+namespace {
+
+struct FillRectJobData : public KisStrokeJobData
+{
+    FillRectJobData(const QRect &_rect)
+        : KisStrokeJobData(KisStrokeJobData::CONCURRENT),
+          rect(_rect)
+    {
+    }
+
+    QRect rect;
+};
+
+/**
+ * A stroke consisting of many tiny concurrent jobs, so that
+ * the time is dominated by the dispatching of the jobs rather
+ * than by the jobs themselves.
+ */
+class FillRectsStrokeStrategy : public KisSimpleStrokeStrategy
+{
+public:
+    FillRectsStrokeStrategy(KisPaintDeviceSP device, const KoColor &color)
+        : KisSimpleStrokeStrategy(QLatin1String("fill-rects-benchmark-stroke")),
+          m_device(device),
+          m_color(color)
+    {
+        enableJob(JOB_DOSTROKE, true, KisStrokeJobData::CONCURRENT);
+    }
+
+    void doStrokeCallback(KisStrokeJobData *data) override {
+        FillRectJobData *d = dynamic_cast<FillRectJobData*>(data);
+        KIS_ASSERT_RECOVER_RETURN(d);
+        m_device->fill(d->rect, m_color);
+    }
+
+private:
+    KisPaintDeviceSP m_device;
+    KoColor m_color;
+};
+
+}
+
+void KisStrokeBenchmark::benchmarkConcurrentStrokeJobs_data()
+{
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<bool>("useWorkStealing");
+
+    for (int numThreads = 8; numThreads <= 64; numThreads *= 2) {
+        QTest::addRow("qthreadpool-%d", numThreads) << numThreads << false;
+        QTest::addRow("work-stealing-%d", numThreads) << numThreads << true;
+    }
+}
+
+void KisStrokeBenchmark::benchmarkConcurrentStrokeJobs()
+{
+    QFETCH(int, numThreads);
+    QFETCH(bool, useWorkStealing);
+
+    const bool oldUseWorkStealing = KisImageConfig(true).useWorkStealingUpdater();
+
+    {
+        // the scheduler reads the value on creation of the image
+        KisImageConfig cfg(false);
+        cfg.setUseWorkStealingUpdater(useWorkStealing);
+    }
+
+    KisImageSP image = new KisImage(0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT, m_colorSpace, "scheduler benchmark image");
+    image->setWorkingThreadsLimit(numThreads);
+
+    KisPaintDeviceSP device = new KisPaintDevice(m_colorSpace);
+    const KoColor color(Qt::red, m_colorSpace);
+    const int patchSize = 32;
+
+    QBENCHMARK {
+        KisStrokeId id = image->startStroke(new FillRectsStrokeStrategy(device, color));
+
+        for (int y = 0; y < TEST_IMAGE_HEIGHT; y += patchSize) {
+            for (int x = 0; x < TEST_IMAGE_WIDTH; x += patchSize) {
+                image->addJob(id, new FillRectJobData(QRect(x, y, patchSize, patchSize)));
+            }
+        }
+
+        image->endStroke(id);
+        image->waitForDone();
+    }
+
+    {
+        KisImageConfig cfg(false);
+        cfg.setUseWorkStealingUpdater(oldUseWorkStealing);
+    }
+}
 
 SIMPLE_TEST_MAIN(KisStrokeBenchmark)
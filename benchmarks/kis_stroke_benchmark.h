@@ -56,6 +56,7 @@ private:
         inline void benchmarkLine(QString presetFileName);
         inline void benchmarkCircle(QString presetFileName);
         inline void benchmarkRectangle(QString presetFileName);
+        inline void benchmarkMyPaint(bool useAsynchronousUpdates);
 
 private Q_SLOTS:
     void initTestCase();
@@ -115,6 +116,10 @@ private Q_SLOTS:
     void colorsmudge();
     void colorsmudgeRL();
 
+    // MyPaint brush with default (high) spacing
+    void mypaint300pxRL();
+    void mypaint300pxBatchedRL();
+
     void roundMarker();
     void roundMarkerRandomLines();
     void roundMarkerRectangle();
@@ -131,6 +136,9 @@ private Q_SLOTS:
     void benchmarkRand48();
 
     void benchmarkPresetCloning();
+
+    void benchmarkConcurrentStrokeJobs_data();
+    void benchmarkConcurrentStrokeJobs();
 };
 
 #endif
@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_transform_worker_benchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <QtMath>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+#include <kis_filter_strategy.h>
+#include <kis_transform_worker.h>
+
+void KisTransformWorkerBenchmark::initTestCase()
+{
+    m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(m_colorSpace);
+
+    KoColor color(m_colorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(m_device, QRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT));
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), m_colorSpace->pixelSize());
+    }
+}
+
+void KisTransformWorkerBenchmark::cleanupTestCase()
+{
+}
+
+void KisTransformWorkerBenchmark::benchmarkTransform(qreal scale, qreal shear, qreal rotation)
+{
+    QFETCH(bool, parallel);
+
+    KisBicubicFilterStrategy filter;
+
+    QBENCHMARK {
+        KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+
+        KisTransformWorker worker(dev, scale, scale, shear, shear, rotation, 0, 0, 0, &filter);
+        worker.setParallelProcessingEnabled(parallel);
+        worker.run();
+    }
+}
+
+static void addParallelColumn()
+{
+    QTest::addColumn<bool>("parallel");
+
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void KisTransformWorkerBenchmark::benchmarkScale_data()
+{
+    addParallelColumn();
+}
+
+void KisTransformWorkerBenchmark::benchmarkScale()
+{
+    benchmarkTransform(1.379, 0.0, 0.0);
+}
+
+void KisTransformWorkerBenchmark::benchmarkRotate_data()
+{
+    addParallelColumn();
+}
+
+void KisTransformWorkerBenchmark::benchmarkRotate()
+{
+    benchmarkTransform(1.0, 0.0, M_PI / 6.0);
+}
+
+void KisTransformWorkerBenchmark::benchmarkShear_data()
+{
+    addParallelColumn();
+}
+
+void KisTransformWorkerBenchmark::benchmarkShear()
+{
+    benchmarkTransform(1.0, 0.479, 0.0);
+}
+
+void KisTransformWorkerBenchmark::benchmarkScaleRotateShear_data()
+{
+    addParallelColumn();
+}
+
+void KisTransformWorkerBenchmark::benchmarkScaleRotateShear()
+{
+    benchmarkTransform(1.379, 0.479, M_PI / 6.0);
+}
+
+SIMPLE_TEST_MAIN(KisTransformWorkerBenchmark)
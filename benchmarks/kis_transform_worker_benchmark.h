@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TRANSFORM_WORKER_BENCHMARK_H
+#define KIS_TRANSFORM_WORKER_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KoColorSpace;
+
+class KisTransformWorkerBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    const KoColorSpace *m_colorSpace;
+    KisPaintDeviceSP m_device;
+
+    void benchmarkTransform(qreal scale, qreal shear, qreal rotation);
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkScale_data();
+    void benchmarkScale();
+    void benchmarkRotate_data();
+    void benchmarkRotate();
+    void benchmarkShear_data();
+    void benchmarkShear();
+    void benchmarkScaleRotateShear_data();
+    void benchmarkScaleRotateShear();
+};
+
+#endif
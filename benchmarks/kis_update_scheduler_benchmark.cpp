@@ -0,0 +1,127 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_update_scheduler_benchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_layer.h>
+#include <kis_paint_device.h>
+#include <kis_filter_mask.h>
+#include "filter/kis_filter_registry.h"
+#include "filter/kis_filter_configuration.h"
+#include "filter/kis_filter.h"
+#include <KisGlobalResourcesInterface.h>
+
+static const int NUM_LAYERS = 50;
+static const int NUM_DIRTY_RECTS_PER_LAYER = 8;
+static const int DIRTY_RECT_SIZE = 256;
+
+void KisUpdateSchedulerBenchmark::initTestCase()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    m_image = new KisImage(0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT, cs, "scheduler benchmark");
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value("blur");
+    KIS_ASSERT(filter);
+    KisFilterConfigurationSP configuration = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    configuration->setProperty("halfWidth", 20);
+    configuration->setProperty("halfHeight", 20);
+
+    srand(31524744);
+
+    m_image->barrierLock();
+
+    for (int i = 0; i < NUM_LAYERS; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(m_image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8 / 2);
+
+        const QRect fillRect(rand() % GMP_IMAGE_WIDTH, rand() % GMP_IMAGE_HEIGHT,
+                             GMP_IMAGE_WIDTH / 2, GMP_IMAGE_HEIGHT / 2);
+        layer->paintDevice()->fill(fillRect & m_image->bounds(),
+                                   KoColor(QColor(rand() % 255, rand() % 255, rand() % 255), cs));
+        m_image->addNode(layer);
+
+        KisFilterMaskSP mask = new KisFilterMask(m_image, "blur mask");
+        mask->initSelection(layer);
+        mask->setFilter(configuration->cloneWithResourcesSnapshot());
+        m_image->addNode(mask, layer);
+
+        m_layers.append(layer);
+    }
+
+    m_image->unlock();
+    m_image->initialRefreshGraph();
+
+    for (int i = 0; i < NUM_LAYERS * NUM_DIRTY_RECTS_PER_LAYER; i++) {
+        m_dirtyRects.append(QRect(rand() % (GMP_IMAGE_WIDTH - DIRTY_RECT_SIZE),
+                                  rand() % (GMP_IMAGE_HEIGHT - DIRTY_RECT_SIZE),
+                                  DIRTY_RECT_SIZE, DIRTY_RECT_SIZE));
+    }
+}
+
+void KisUpdateSchedulerBenchmark::cleanupTestCase()
+{
+    m_layers.clear();
+    m_image.clear();
+}
+
+qint64 KisUpdateSchedulerBenchmark::runUpdates()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < m_dirtyRects.size(); i++) {
+        m_layers[i % m_layers.size()]->setDirty(m_dirtyRects[i]);
+    }
+    m_image->waitForDone();
+
+    return timer.nsecsElapsed();
+}
+
+void KisUpdateSchedulerBenchmark::benchmarkBlurMaskUpdates_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads = 1; numThreads <= QThread::idealThreadCount(); numThreads *= 2) {
+        QTest::addRow("threads-%d", numThreads) << numThreads;
+    }
+}
+
+void KisUpdateSchedulerBenchmark::benchmarkBlurMaskUpdates()
+{
+    QFETCH(int, numThreads);
+
+    m_image->setWorkingThreadsLimit(numThreads);
+
+    QBENCHMARK {
+        runUpdates();
+    }
+
+    /**
+     * Parallel efficiency is the speedup over the single-threaded
+     * run divided by the number of threads
+     */
+    const qint64 time = runUpdates();
+    if (numThreads == 1) {
+        m_singleThreadTime = time;
+    } else if (m_singleThreadTime > 0) {
+        const qreal speedup = qreal(m_singleThreadTime) / time;
+        qDebug() << "threads:" << numThreads
+                 << "speedup:" << speedup
+                 << "efficiency:" << speedup / numThreads;
+    }
+}
+
+SIMPLE_TEST_MAIN(KisUpdateSchedulerBenchmark)
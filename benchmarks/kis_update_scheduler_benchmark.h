@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_UPDATE_SCHEDULER_BENCHMARK_H
+#define KIS_UPDATE_SCHEDULER_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KisUpdateSchedulerBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    KisImageSP m_image;
+    QVector<KisNodeSP> m_layers;
+    QVector<QRect> m_dirtyRects;
+    qint64 m_singleThreadTime = 0;
+
+    qint64 runUpdates();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkBlurMaskUpdates_data();
+    void benchmarkBlurMaskUpdates();
+};
+
+#endif
@@ -315,8 +315,9 @@ macro(xsimd_compile_for_all_implementations _srcs _src)
          "-mavx2 -mfma"   "/arch:AVX2")
       _xsimd_compile_one_implementation(${_srcs} AVX512F
          "-mavx512f"      "/arch:AVX512")
+      # xsimd's avx512bw architecture builds on top of avx512dq and avx512cd
       _xsimd_compile_one_implementation(${_srcs} AVX512BW
-         "-mavx512bw"     "/arch:AVX512")
+         "-mavx512f -mavx512cd -mavx512dq -mavx512bw"     "/arch:AVX512")
       _xsimd_compile_one_implementation(${_srcs} AVX512CD
          "-mavx512cd"     "/arch:AVX512")
       _xsimd_compile_one_implementation(${_srcs} AVX512DQ
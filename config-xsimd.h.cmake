@@ -2,3 +2,6 @@
 
 /* Define if you have xsimd */
 #cmakedefine HAVE_XSIMD 1
+
+/* Define if the multiarch libraries are built with AVX-512 implementations */
+#cmakedefine HAVE_XSIMD_AVX512 1
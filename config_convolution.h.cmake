@@ -2,3 +2,6 @@
 /* Defines if your system has the FFTW3 library */
 #cmakedefine HAVE_FFTW3 1
 
+
+/* Defines if your system has the threads support for the FFTW3 library */
+#cmakedefine HAVE_FFTW3_THREADS 1
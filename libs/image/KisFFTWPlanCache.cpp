@@ -0,0 +1,418 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisFFTWPlanCache.h"
+
+#include <list>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+#include <kis_debug.h>
+
+#include "kis_image_config.h"
+#include "KisImageConfigNotifier.h"
+#include "kis_update_job_item.h"
+
+#include "config_convolution.h"
+
+namespace {
+
+/**
+ * FFTW planner is not thread-safe, so all the calls to fftw_plan_*()
+ * and fftw_destroy_plan() should be guarded by this mutex
+ */
+QMutex s_plannerMutex;
+
+/**
+ * Splitting smaller transforms into threads costs more than it gains
+ */
+const qint64 s_minThreadedTransformSize = 256 * 256;
+
+struct Key {
+    int width = 0;
+    int height = 0;
+    KisFFTWPlanCache::Direction direction = KisFFTWPlanCache::RealToComplex;
+    int numThreads = 1;
+
+    bool operator==(const Key &rhs) const {
+        return width == rhs.width &&
+            height == rhs.height &&
+            direction == rhs.direction &&
+            numThreads == rhs.numThreads;
+    }
+};
+
+uint qHash(const Key &key, uint seed = 0)
+{
+    return ::qHash(key.width, seed) ^
+        ::qHash(key.height << 16, seed) ^
+        ::qHash(int(key.direction), seed) ^
+        ::qHash(key.numThreads << 24, seed);
+}
+
+}
+
+Q_GLOBAL_STATIC(KisFFTWPlanCache, s_instance)
+
+
+KisFFTWPlanCache::Plan::Plan(fftw_plan plan)
+    : m_plan(plan)
+{
+}
+
+KisFFTWPlanCache::Plan::~Plan()
+{
+    QMutexLocker l(&s_plannerMutex);
+    fftw_destroy_plan(m_plan);
+}
+
+struct KisFFTWPlanCache::Private
+{
+    struct Entry {
+        Key key;
+        PlanSP plan;
+    };
+
+    using EntriesList = std::list<Entry>;
+
+    mutable QMutex mutex;
+
+    /// most recently used plans are stored at the front of the list
+    EntriesList entries;
+    QHash<Key, EntriesList::iterator> index;
+
+    int maxNumPlans = 64;
+    qint64 maxTransformMemory = 512 * 1024 * 1024;
+    int numThreads = 1;
+    bool useWisdom = false;
+    bool wisdomChanged = false;
+
+    Statistics stats;
+
+    QMetaObject::Connection configConnection;
+    QMetaObject::Connection quitConnection;
+
+    void evictExtraEntries();
+    static PlanSP createPlan(const Key &key, bool measure);
+};
+
+void KisFFTWPlanCache::Private::evictExtraEntries()
+{
+    while (!entries.empty() && int(entries.size()) > maxNumPlans) {
+        index.remove(entries.back().key);
+        entries.pop_back();
+        stats.evictions++;
+    }
+
+    stats.numPlans = index.size();
+}
+
+KisFFTWPlanCache::PlanSP KisFFTWPlanCache::Private::createPlan(const Key &key, bool measure)
+{
+    /**
+     * FFTW_MEASURE overwrites the arrays while planning, so the plan is
+     * created on a temporary buffer of the same layout. The alignment
+     * of fftw_malloc() is the same for all the buffers, so the plan is
+     * valid for any of them.
+     */
+    const size_t length = size_t(key.height) * (key.width / 2 + 1);
+    fftw_complex *buffer = fftw_alloc_complex(length);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(buffer, PlanSP());
+
+    fftw_plan plan = 0;
+
+    {
+        QMutexLocker l(&s_plannerMutex);
+
+#ifdef HAVE_FFTW3_THREADS
+        fftw_plan_with_nthreads(key.numThreads);
+#endif
+
+        const unsigned flags = measure ? FFTW_MEASURE : FFTW_ESTIMATE;
+
+        if (key.direction == RealToComplex) {
+            plan = fftw_plan_dft_r2c_2d(key.height, key.width,
+                                        reinterpret_cast<double*>(buffer), buffer,
+                                        flags);
+        } else {
+            plan = fftw_plan_dft_c2r_2d(key.height, key.width,
+                                        buffer, reinterpret_cast<double*>(buffer),
+                                        flags);
+        }
+    }
+
+    fftw_free(buffer);
+
+    return plan ? PlanSP(new Plan(plan)) : PlanSP();
+}
+
+KisFFTWPlanCache::KisFFTWPlanCache()
+    : m_d(new Private)
+{
+#ifdef HAVE_FFTW3_THREADS
+    {
+        QMutexLocker l(&s_plannerMutex);
+        fftw_init_threads();
+    }
+#endif
+
+    updateSettings();
+
+    m_d->configConnection =
+        QObject::connect(KisImageConfigNotifier::instance(), &KisImageConfigNotifier::configChanged,
+                         [this] () { updateSettings(); });
+
+    if (QCoreApplication::instance()) {
+        m_d->quitConnection =
+            QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                             [this] () { saveChangedWisdom(); });
+    }
+}
+
+KisFFTWPlanCache::~KisFFTWPlanCache()
+{
+    QObject::disconnect(m_d->configConnection);
+    QObject::disconnect(m_d->quitConnection);
+
+    clear();
+}
+
+KisFFTWPlanCache *KisFFTWPlanCache::instance()
+{
+    return s_instance;
+}
+
+KisFFTWPlanCache::PlanSP KisFFTWPlanCache::plan(int width, int height, Direction direction)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(width > 0 && height > 0, PlanSP());
+
+    /**
+     * Stroke jobs already run on all the threads of the updater context,
+     * so the plans used inside them are single-threaded. The number of
+     * threads is baked into a plan, so it is a part of the key.
+     */
+    const bool useThreads =
+        qint64(width) * height >= s_minThreadedTransformSize &&
+        !KisUpdateJobItem::isUpdaterThread();
+
+    Key key {width, height, direction};
+    bool measure = false;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        key.numThreads = useThreads ? m_d->numThreads : 1;
+
+        auto it = m_d->index.find(key);
+        if (it != m_d->index.end()) {
+            m_d->stats.hits++;
+
+            Private::EntriesList::iterator entry = it.value();
+            m_d->entries.splice(m_d->entries.begin(), m_d->entries, entry);
+            return entry->plan;
+        }
+
+        m_d->stats.misses++;
+
+        measure = m_d->useWisdom;
+    }
+
+    /**
+     * The planning may take a while, especially in the measuring mode,
+     * so it happens without holding the lock of the cache
+     */
+    PlanSP plan = Private::createPlan(key, measure);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(plan, plan);
+
+    QMutexLocker l(&m_d->mutex);
+
+    auto it = m_d->index.find(key);
+    if (it != m_d->index.end()) {
+        // someone has created the same plan in the meantime
+        return it.value()->plan;
+    }
+
+    m_d->entries.push_front({key, plan});
+    m_d->index.insert(key, m_d->entries.begin());
+    m_d->wisdomChanged |= measure;
+
+    m_d->evictExtraEntries();
+
+    return plan;
+}
+
+void KisFFTWPlanCache::updateSettings()
+{
+    KisImageConfig cfg(true);
+
+    setNumThreads(cfg.maxNumberOfThreads());
+    setUseWisdom(cfg.useFFTWWisdom());
+}
+
+void KisFFTWPlanCache::setNumThreads(int value)
+{
+#ifdef HAVE_FFTW3_THREADS
+    value = qMax(1, value);
+#else
+    value = 1;
+#endif
+
+    QMutexLocker l(&m_d->mutex);
+
+    if (value == m_d->numThreads) return;
+
+    m_d->numThreads = value;
+
+    l.unlock();
+    clear();
+}
+
+int KisFFTWPlanCache::numThreads() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->numThreads;
+}
+
+void KisFFTWPlanCache::setUseWisdom(bool value)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    if (value == m_d->useWisdom) return;
+
+    m_d->useWisdom = value;
+    const bool needsSaving = !value && m_d->wisdomChanged;
+
+    l.unlock();
+
+    if (value) {
+        loadWisdom();
+    } else if (needsSaving) {
+        saveWisdom();
+    }
+}
+
+bool KisFFTWPlanCache::useWisdom() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->useWisdom;
+}
+
+QString KisFFTWPlanCache::wisdomFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/fftw_wisdom";
+}
+
+bool KisFFTWPlanCache::loadWisdom()
+{
+    const QString fileName = wisdomFilePath();
+    if (!QFile::exists(fileName)) return false;
+
+    QMutexLocker l(&s_plannerMutex);
+    const bool result = fftw_import_wisdom_from_filename(QFile::encodeName(fileName).constData());
+
+    if (!result) {
+        warnKrita << "KisFFTWPlanCache: failed to load FFTW wisdom from" << fileName;
+    }
+
+    return result;
+}
+
+bool KisFFTWPlanCache::saveWisdom()
+{
+    const QString fileName = wisdomFilePath();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    bool result = false;
+
+    {
+        QMutexLocker l(&s_plannerMutex);
+        result = fftw_export_wisdom_to_filename(QFile::encodeName(fileName).constData());
+    }
+
+    if (result) {
+        QMutexLocker l(&m_d->mutex);
+        m_d->wisdomChanged = false;
+    } else {
+        warnKrita << "KisFFTWPlanCache: failed to save FFTW wisdom to" << fileName;
+    }
+
+    return result;
+}
+
+void KisFFTWPlanCache::saveChangedWisdom()
+{
+    {
+        QMutexLocker l(&m_d->mutex);
+        if (!m_d->useWisdom || !m_d->wisdomChanged) return;
+    }
+
+    saveWisdom();
+}
+
+void KisFFTWPlanCache::setMaxNumPlans(int value)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->maxNumPlans = qMax(1, value);
+    m_d->evictExtraEntries();
+}
+
+int KisFFTWPlanCache::maxNumPlans() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->maxNumPlans;
+}
+
+void KisFFTWPlanCache::setMaxTransformMemory(qint64 value)
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->maxTransformMemory = value;
+}
+
+qint64 KisFFTWPlanCache::maxTransformMemory() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->maxTransformMemory;
+}
+
+void KisFFTWPlanCache::clear()
+{
+    Private::EntriesList entries;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        entries.swap(m_d->entries);
+        m_d->index.clear();
+        m_d->stats.numPlans = 0;
+    }
+
+    // the plans are destroyed outside the lock of the cache
+    entries.clear();
+}
+
+KisFFTWPlanCache::Statistics KisFFTWPlanCache::statistics() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->stats;
+}
+
+void KisFFTWPlanCache::resetStatistics()
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->stats.hits = 0;
+    m_d->stats.misses = 0;
+    m_d->stats.evictions = 0;
+}
@@ -0,0 +1,146 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISFFTWPLANCACHE_H
+#define KISFFTWPLANCACHE_H
+
+#include "kritaimage_export.h"
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+
+#include <fftw3.h>
+
+
+/**
+ * @brief KisFFTWPlanCache is a process-wide cache of FFTW plans
+ *
+ * Creating a plan is the only part of FFTW that is not thread-safe and,
+ * for big matrices, it takes a considerable share of the convolution
+ * time. The cache keeps the plans of the recently used sizes, so the
+ * repeated convolutions (e.g. a blur filter applied to the tiles of the
+ * same size or the preview of a filter dialog) skip the planning
+ * entirely.
+ *
+ * All the plans describe an *in-place* 2D transform of a real
+ * width x height matrix, whose rows are padded to 2 * (width / 2 + 1)
+ * doubles, i.e. the layout FFTW uses for in-place r2c/c2r transforms.
+ * The plans should be executed with fftw_execute_dft_r2c() and
+ * fftw_execute_dft_c2r() on the buffers allocated with fftw_malloc(),
+ * which is thread-safe.
+ *
+ * When FFTW wisdom is enabled in KisImageConfig, the plans are measured
+ * instead of estimated and the wisdom is loaded from and saved into
+ * wisdomFilePath(), so the measuring happens only once per size. The
+ * wisdom is saved when the application quits, not when the cache is
+ * destroyed, because the latter happens during static destruction.
+ *
+ * When Krita is built with fftw3_threads, the plans for big matrices
+ * are created for the number of threads limited by KisImageConfig,
+ * except the plans requested from the threads of the updater context,
+ * which are single-threaded.
+ */
+class KRITAIMAGE_EXPORT KisFFTWPlanCache
+{
+public:
+    enum Direction {
+        RealToComplex,
+        ComplexToReal
+    };
+
+    class KRITAIMAGE_EXPORT Plan
+    {
+    public:
+        ~Plan();
+
+        fftw_plan handle() const {
+            return m_plan;
+        }
+
+    private:
+        friend class KisFFTWPlanCache;
+        Plan(fftw_plan plan);
+        Q_DISABLE_COPY(Plan)
+
+    private:
+        fftw_plan m_plan;
+    };
+
+    using PlanSP = QSharedPointer<Plan>;
+
+    struct Statistics {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 evictions = 0;
+        int numPlans = 0;
+    };
+
+public:
+    KisFFTWPlanCache();
+    ~KisFFTWPlanCache();
+
+    static KisFFTWPlanCache* instance();
+
+    /**
+     * @return a plan for the transform of a \p width x \p height matrix
+     * in \p direction. The plan stays valid while the returned pointer is
+     * alive, even if it is evicted from the cache in the meantime.
+     */
+    PlanSP plan(int width, int height, Direction direction);
+
+    /**
+     * Reads the thread limit and the wisdom usage from KisImageConfig.
+     * Called automatically on KisImageConfigNotifier::configChanged().
+     */
+    void updateSettings();
+
+    /**
+     * The number of threads used by the plans of big matrices. Changing
+     * the value drops all the cached plans.
+     */
+    void setNumThreads(int value);
+    int numThreads() const;
+
+    /**
+     * Enables measuring the plans and the persistence of FFTW wisdom.
+     * Enabling loads the stored wisdom, disabling saves it.
+     */
+    void setUseWisdom(bool value);
+    bool useWisdom() const;
+
+    bool loadWisdom();
+    bool saveWisdom();
+
+    /**
+     * Saves the wisdom if wisdom is enabled and new plans have been
+     * measured since the last save. Called on
+     * QCoreApplication::aboutToQuit().
+     */
+    void saveChangedWisdom();
+    static QString wisdomFilePath();
+
+    void setMaxNumPlans(int value);
+    int maxNumPlans() const;
+
+    /**
+     * The maximum amount of memory that the FFT buffers of a single
+     * convolution may occupy. Bigger areas are convolved in tiles.
+     */
+    void setMaxTransformMemory(qint64 value);
+    qint64 maxTransformMemory() const;
+
+    void clear();
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISFFTWPLANCACHE_H
@@ -0,0 +1,589 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisRecursiveGaussianBlur.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <QAtomicInt>
+#include <QRect>
+#include <QThreadPool>
+
+#include <KoChannelInfo.h>
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include <kis_debug.h>
+
+#include "kis_default_bounds.h"
+#include "kis_gaussian_kernel.h"
+#include "kis_image_config.h"
+#include "kis_math_toolbox.h"
+#include "kis_paint_device.h"
+#include "kis_progress_update_helper.h"
+#include "kis_sequential_iterator.h"
+#include "kis_update_job_item.h"
+
+
+namespace {
+
+/**
+ * The passes are split into the strips of this size, aligned to the
+ * tiles of the paint device, so that different threads never write
+ * into the same tile
+ */
+const int s_stripSize = 64;
+
+struct ChannelConverter
+{
+    ChannelConverter(const QList<KoChannelInfo*> &_channels)
+        : channels(_channels)
+    {
+        KisMathToolbox mathToolbox;
+
+        for (int i = 0; i < channels.count(); ++i) {
+            minClamp.append(mathToolbox.minChannelValue(channels[i]));
+            maxClamp.append(mathToolbox.maxChannelValue(channels[i]));
+            channelPos.append(channels[i]->pos());
+
+            if (channels[i]->channelType() == KoChannelInfo::ALPHA) {
+                alphaCachePos = i;
+                alphaRealPos = channels[i]->pos();
+            }
+        }
+
+        bool result = mathToolbox.getToDoubleChannelPtr(channels, toDouble);
+        result &= mathToolbox.getFromDoubleChannelPtr(channels, fromDouble);
+        result &= mathToolbox.getFromDoubleCheckNullChannelPtr(channels, fromDoubleCheckNull);
+
+        KIS_ASSERT(result);
+    }
+
+    inline int numChannels() const {
+        return channels.size();
+    }
+
+    inline double limitValue(double value, int channel) const {
+        // the comparison with NaN is always false
+        return value > maxClamp[channel] ? maxClamp[channel] :
+               value >= minClamp[channel] ? value : minClamp[channel];
+    }
+
+    /**
+     * The color channels are premultiplied by alpha, exactly
+     * as KisConvolutionWorkerFFT does
+     */
+    inline void read(const quint8 *data, double *const *planes, int index) const {
+        const double alpha = alphaRealPos >= 0 ?
+            toDouble[alphaCachePos](data, alphaRealPos) : 1.0;
+
+        for (int k = 0; k < channels.size(); ++k) {
+            planes[k][index] = k != alphaCachePos ?
+                toDouble[k](data, channelPos[k]) * alpha : alpha;
+        }
+    }
+
+    inline void write(quint8 *data, double *const *planes, int index) const {
+        if (alphaCachePos >= 0) {
+            bool alphaIsNull = false;
+
+            const double alpha = limitValue(planes[alphaCachePos][index], alphaCachePos);
+            fromDoubleCheckNull[alphaCachePos](data, alphaRealPos, alpha, &alphaIsNull);
+
+            if (!alphaIsNull && alpha > std::numeric_limits<double>::epsilon()) {
+                const double alphaInv = 1.0 / alpha;
+
+                for (int k = 0; k < channels.size(); ++k) {
+                    if (k == alphaCachePos) continue;
+                    fromDouble[k](data, channelPos[k], limitValue(planes[k][index] * alphaInv, k));
+                }
+            } else {
+                for (int k = 0; k < channels.size(); ++k) {
+                    if (k == alphaCachePos) continue;
+                    fromDouble[k](data, channelPos[k], 0.0);
+                }
+            }
+        } else {
+            for (int k = 0; k < channels.size(); ++k) {
+                fromDouble[k](data, channelPos[k], limitValue(planes[k][index], k));
+            }
+        }
+    }
+
+    QList<KoChannelInfo*> channels;
+    QVector<int> channelPos;
+    QVector<double> minClamp;
+    QVector<double> maxClamp;
+
+    QVector<PtrToDouble> toDouble;
+    QVector<PtrFromDouble> fromDouble;
+    QVector<PtrFromDoubleCheckNull> fromDoubleCheckNull;
+
+    int alphaCachePos = -1;
+    int alphaRealPos = -1;
+};
+
+/**
+ * Runs the recursive filter along \p numRows rows of \p data, i.e.
+ * every column of the matrix is filtered separately. The rows are
+ * processed as a whole, so the compiler vectorizes the inner loop.
+ */
+void blurColumns(double *data, int numColumns, int numRows,
+                 const KisRecursiveGaussianBlur::Coefficients &c)
+{
+    const int stride = numColumns;
+
+    std::vector<double> edges(5 * numColumns);
+    double *first = edges.data();
+    double *last = first + numColumns;
+    double *init[3] = {last + numColumns, last + 2 * numColumns, last + 3 * numColumns};
+
+    std::copy(data, data + numColumns, first);
+    std::copy(data + (numRows - 1) * stride, data + numRows * stride, last);
+
+    /**
+     * The history of the causal pass is initialized with the steady
+     * state for the first row repeated infinitely
+     */
+    auto forwardRow = [&] (int i) -> const double* {
+        return i >= 0 ? data + i * stride : first;
+    };
+
+    for (int y = 0; y < numRows; y++) {
+        double *row = data + y * stride;
+        const double *r1 = forwardRow(y - 1);
+        const double *r2 = forwardRow(y - 2);
+        const double *r3 = forwardRow(y - 3);
+
+        for (int x = 0; x < numColumns; x++) {
+            row[x] = c.B * row[x] + c.a1 * r1[x] + c.a2 * r2[x] + c.a3 * r3[x];
+        }
+    }
+
+    /**
+     * The history of the anticausal pass is calculated from the last
+     * state of the causal one, as if the last row were repeated
+     * infinitely (Triggs and Sdika)
+     */
+    {
+        const double *w1 = forwardRow(numRows - 1);
+        const double *w2 = forwardRow(numRows - 2);
+        const double *w3 = forwardRow(numRows - 3);
+
+        for (int x = 0; x < numColumns; x++) {
+            const double u0 = w1[x] - last[x];
+            const double u1 = w2[x] - last[x];
+            const double u2 = w3[x] - last[x];
+
+            for (int i = 0; i < 3; i++) {
+                init[i][x] = c.M[i][0] * u0 + c.M[i][1] * u1 + c.M[i][2] * u2 + last[x];
+            }
+        }
+    }
+
+    auto backwardRow = [&] (int i) -> const double* {
+        return i < numRows ? data + i * stride : init[i - numRows];
+    };
+
+    for (int y = numRows - 1; y >= 0; y--) {
+        double *row = data + y * stride;
+        const double *r1 = backwardRow(y + 1);
+        const double *r2 = backwardRow(y + 2);
+        const double *r3 = backwardRow(y + 3);
+
+        for (int x = 0; x < numColumns; x++) {
+            row[x] = c.B * row[x] + c.a1 * r1[x] + c.a2 * r2[x] + c.a3 * r3[x];
+        }
+    }
+}
+
+struct StripJob {
+    KisPaintDeviceSP src;
+    KisPaintDeviceSP dst;
+    QRect readRect;
+    QRect writeRect;
+    Qt::Orientation orientation;
+};
+
+void processStrip(const StripJob &job,
+                  const KisRecursiveGaussianBlur::Coefficients &c,
+                  const ChannelConverter &converter)
+{
+    const bool horizontal = job.orientation == Qt::Horizontal;
+    const QRect &readRect = job.readRect;
+
+    const int length = horizontal ? readRect.width() : readRect.height();
+    const int numLines = horizontal ? readRect.height() : readRect.width();
+    const int planeSize = length * numLines;
+
+    /**
+     * The lines of the strip are stored as the columns of the matrix,
+     * so the filter runs along all of them at once
+     */
+    auto bufferIndex = [&] (int x, int y) {
+        x -= readRect.x();
+        y -= readRect.y();
+        return horizontal ? x * numLines + y : y * numLines + x;
+    };
+
+    std::vector<double> buffer(size_t(converter.numChannels()) * planeSize);
+    QVector<double*> planes(converter.numChannels());
+    for (int k = 0; k < planes.size(); k++) {
+        planes[k] = buffer.data() + k * planeSize;
+    }
+
+    KisSequentialConstIterator srcIt(job.src, readRect);
+    while (srcIt.nextPixel()) {
+        converter.read(srcIt.rawDataConst(), planes.constData(), bufferIndex(srcIt.x(), srcIt.y()));
+    }
+
+    Q_FOREACH (double *plane, planes) {
+        blurColumns(plane, numLines, length, c);
+    }
+
+    KisSequentialIterator dstIt(job.dst, job.writeRect);
+    while (dstIt.nextPixel()) {
+        converter.write(dstIt.rawData(), planes.constData(), bufferIndex(dstIt.x(), dstIt.y()));
+    }
+}
+
+/**
+ * Aligns \p value down to the strip grid starting at \p origin
+ */
+int alignDown(int value, int origin)
+{
+    value -= origin;
+    return origin + (value >= 0 ? value / s_stripSize * s_stripSize : -((-value + s_stripSize - 1) / s_stripSize * s_stripSize));
+}
+
+/**
+ * Splits \p rect into strips aligned to the tile grid of a device
+ * with the offset \p origin, so that every tile is written by one
+ * strip only
+ */
+QVector<QRect> splitIntoStrips(const QRect &rect, Qt::Orientation orientation, const QPoint &origin)
+{
+    QVector<QRect> strips;
+
+    if (orientation == Qt::Horizontal) {
+        for (int y = rect.top(); y <= rect.bottom(); y = alignDown(y, origin.y()) + s_stripSize) {
+            const int bottom = qMin(rect.bottom(), alignDown(y, origin.y()) + s_stripSize - 1);
+            strips << QRect(rect.left(), y, rect.width(), bottom - y + 1);
+        }
+    } else {
+        for (int x = rect.left(); x <= rect.right(); x = alignDown(x, origin.x()) + s_stripSize) {
+            const int right = qMin(rect.right(), alignDown(x, origin.x()) + s_stripSize - 1);
+            strips << QRect(x, rect.top(), right - x + 1, rect.height());
+        }
+    }
+
+    return strips;
+}
+
+}
+
+struct KisRecursiveGaussianBlur::Private
+{
+    qreal xRadius = 0.0;
+    qreal yRadius = 0.0;
+
+    QBitArray channelFlags;
+    KoUpdater *progressUpdater = 0;
+    int maxThreadCount = 0;
+
+    void runJobs(const QVector<StripJob> &jobs,
+                 const Coefficients &coefficients,
+                 const ChannelConverter &converter,
+                 KisProgressUpdateHelper &progressHelper);
+};
+
+void KisRecursiveGaussianBlur::Private::runJobs(const QVector<StripJob> &jobs,
+                                                const Coefficients &coefficients,
+                                                const ChannelConverter &converter,
+                                                KisProgressUpdateHelper &progressHelper)
+{
+    auto isInterrupted = [this] () {
+        return progressUpdater && progressUpdater->interrupted();
+    };
+
+    /**
+     * Filters, layer styles and other stroke jobs already run on all the
+     * threads of the updater context, so inside them the passes are not
+     * split any further
+     */
+    int numThreads = maxThreadCount;
+
+    if (numThreads <= 0) {
+        numThreads = KisUpdateJobItem::isUpdaterThread() ?
+            1 : KisImageConfig(true).maxNumberOfThreads();
+    }
+
+    if (numThreads <= 1 || jobs.size() <= 1) {
+        Q_FOREACH (const StripJob &job, jobs) {
+            if (isInterrupted()) return;
+
+            processStrip(job, coefficients, converter);
+            progressHelper.step();
+        }
+    } else {
+        QAtomicInt numProcessedJobs;
+
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
+
+        Q_FOREACH (const StripJob &job, jobs) {
+            threadPool.start(QRunnable::create(
+                [job, &coefficients, &converter, &numProcessedJobs, isInterrupted] () {
+                    if (!isInterrupted()) {
+                        processStrip(job, coefficients, converter);
+                    }
+                    numProcessedJobs.ref();
+                }));
+        }
+
+        int numReportedJobs = 0;
+        bool isDone = false;
+
+        while (!isDone) {
+            isDone = threadPool.waitForDone(50);
+
+            const int numJobsDone = numProcessedJobs.loadAcquire();
+            for (; numReportedJobs < numJobsDone; numReportedJobs++) {
+                progressHelper.step();
+            }
+        }
+    }
+}
+
+
+KisRecursiveGaussianBlur::KisRecursiveGaussianBlur(qreal xRadius, qreal yRadius)
+    : m_d(new Private)
+{
+    m_d->xRadius = xRadius;
+    m_d->yRadius = yRadius;
+}
+
+KisRecursiveGaussianBlur::~KisRecursiveGaussianBlur()
+{
+}
+
+qreal KisRecursiveGaussianBlur::minimumRadius()
+{
+    return 20.0;
+}
+
+bool KisRecursiveGaussianBlur::isApplicable(qreal xRadius, qreal yRadius)
+{
+    return (xRadius > 0.0 || yRadius > 0.0) &&
+        (xRadius <= 0.0 || xRadius >= minimumRadius()) &&
+        (yRadius <= 0.0 || yRadius >= minimumRadius());
+}
+
+KisRecursiveGaussianBlur::Coefficients KisRecursiveGaussianBlur::coefficients(qreal sigma)
+{
+    sigma = qMax(0.5, sigma);
+
+    // Young, van Vliet, "Recursive implementation of the Gaussian filter", 1995
+    const double q = sigma >= 2.5 ?
+        0.98711 * sigma - 0.96330 :
+        3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+
+    const double q2 = q * q;
+    const double q3 = q2 * q;
+
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    const double b1 = 2.44413 * q + 2.85619 * q2 + 1.26661 * q3;
+    const double b2 = -(1.4281 * q2 + 1.26661 * q3);
+    const double b3 = 0.422205 * q3;
+
+    Coefficients c;
+    c.a1 = b1 / b0;
+    c.a2 = b2 / b0;
+    c.a3 = b3 / b0;
+    c.B = 1.0 - (c.a1 + c.a2 + c.a3);
+
+    /**
+     * The matrix of the initial conditions of the anticausal pass is
+     * found by feeding the unit states of the causal pass into the
+     * filter and letting them decay. It is exact up to the precision
+     * of double and doesn't depend on the sign conventions of the
+     * closed-form solution.
+     */
+    const int decayLength = int(std::ceil(20 * sigma)) + 50;
+    std::vector<double> response(decayLength);
+
+    for (int k = 0; k < 3; k++) {
+        double state[3] = {0.0, 0.0, 0.0};
+        state[k] = 1.0;
+
+        for (int i = 0; i < decayLength; i++) {
+            const double value = c.a1 * state[0] + c.a2 * state[1] + c.a3 * state[2];
+            response[i] = value;
+            state[2] = state[1];
+            state[1] = state[0];
+            state[0] = value;
+        }
+
+        double backwardState[3] = {0.0, 0.0, 0.0};
+
+        for (int i = decayLength - 1; i >= 0; i--) {
+            const double value = c.B * response[i] +
+                c.a1 * backwardState[0] + c.a2 * backwardState[1] + c.a3 * backwardState[2];
+            backwardState[2] = backwardState[1];
+            backwardState[1] = backwardState[0];
+            backwardState[0] = value;
+
+            if (i < 3) {
+                c.M[i][k] = value;
+            }
+        }
+    }
+
+    return c;
+}
+
+void KisRecursiveGaussianBlur::setChannelFlags(const QBitArray &channelFlags)
+{
+    m_d->channelFlags = channelFlags;
+}
+
+void KisRecursiveGaussianBlur::setProgress(KoUpdater *progressUpdater)
+{
+    m_d->progressUpdater = progressUpdater;
+}
+
+void KisRecursiveGaussianBlur::setMaxThreadCount(int value)
+{
+    m_d->maxThreadCount = value;
+}
+
+int KisRecursiveGaussianBlur::maxThreadCount() const
+{
+    return m_d->maxThreadCount;
+}
+
+void KisRecursiveGaussianBlur::apply(KisPaintDeviceSP device, const QRect &rect, KisConvolutionBorderOp borderOp)
+{
+    const bool blurX = m_d->xRadius > 0.0;
+    const bool blurY = m_d->yRadius > 0.0;
+
+    if (rect.isEmpty() || (!blurX && !blurY)) return;
+
+    /**
+     * Force BORDER_IGNORE op for the wraparound mode, because the
+     * paint device has its own special iterators, the same way as
+     * KisConvolutionPainter does
+     */
+    if (device->defaultBounds()->wrapAroundMode() && device->supportsWraproundMode()) {
+        borderOp = BORDER_IGNORE;
+    }
+
+    /**
+     * With BORDER_REPEAT the pixels outside the data rect are never
+     * read, the initial conditions of the filter repeat the border
+     * pixels instead
+     */
+    QRect dataRect;
+    if (borderOp == BORDER_REPEAT) {
+        const QRect boundsRect = device->defaultBounds()->bounds();
+        dataRect = rect | boundsRect;
+
+        KIS_SAFE_ASSERT_RECOVER(boundsRect != KisDefaultBounds().bounds()) {
+            dataRect = rect | device->exactBounds();
+        }
+    }
+
+    QBitArray channelFlags = m_d->channelFlags;
+    if (channelFlags.isEmpty()) {
+        channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
+    }
+
+    QList<KoChannelInfo*> channels;
+    const QList<KoChannelInfo*> channelInfo = device->colorSpace()->channels();
+    for (int c = 0; c < channelInfo.count(); ++c) {
+        if (channelFlags.testBit(c)) {
+            channels.append(channelInfo[c]);
+        }
+    }
+
+    if (channels.isEmpty()) return;
+
+    const ChannelConverter converter(channels);
+
+    // read exactly the same area as the exact kernel would
+    const int halfWidth = blurX ? KisGaussianKernel::kernelSizeFromRadius(m_d->xRadius) / 2 : 0;
+    const int halfHeight = blurY ? KisGaussianKernel::kernelSizeFromRadius(m_d->yRadius) / 2 : 0;
+
+    QVector<StripJob> horizontalJobs;
+    QVector<StripJob> verticalJobs;
+    KisPaintDeviceSP intermediate;
+
+    if (blurX) {
+        QRect rowsRect = rect.adjusted(0, -halfHeight, 0, halfHeight);
+
+        if (dataRect.isValid()) {
+            rowsRect.setTop(qMax(rowsRect.top(), dataRect.top()));
+            rowsRect.setBottom(qMin(rowsRect.bottom(), dataRect.bottom()));
+        }
+
+        /**
+         * The horizontal pass reads and writes the same rows of every
+         * strip, so it can work in place. When followed by the
+         * vertical pass it should keep the rows around the rect,
+         * which are not supposed to be changed, so it writes into
+         * an intermediate device.
+         */
+        KisPaintDeviceSP dst = device;
+        if (blurY) {
+            intermediate = new KisPaintDevice(device->colorSpace());
+            intermediate->prepareClone(device);
+            dst = intermediate;
+        }
+
+        Q_FOREACH (const QRect &strip, splitIntoStrips(rowsRect, Qt::Horizontal, QPoint(dst->x(), dst->y()))) {
+            QRect readRect = strip.adjusted(-halfWidth, 0, halfWidth, 0);
+
+            if (dataRect.isValid()) {
+                readRect.setLeft(qMax(readRect.left(), dataRect.left()));
+                readRect.setRight(qMin(readRect.right(), dataRect.right()));
+            }
+
+            horizontalJobs << StripJob{device, dst, readRect, strip, Qt::Horizontal};
+        }
+    }
+
+    if (blurY) {
+        KisPaintDeviceSP src = blurX ? intermediate : device;
+
+        Q_FOREACH (const QRect &strip, splitIntoStrips(rect, Qt::Vertical, QPoint(device->x(), device->y()))) {
+            QRect readRect = strip.adjusted(0, -halfHeight, 0, halfHeight);
+
+            if (dataRect.isValid()) {
+                readRect.setTop(qMax(readRect.top(), dataRect.top()));
+                readRect.setBottom(qMin(readRect.bottom(), dataRect.bottom()));
+            }
+
+            verticalJobs << StripJob{src, device, readRect, strip, Qt::Vertical};
+        }
+    }
+
+    KisProgressUpdateHelper progressHelper(m_d->progressUpdater, 100,
+                                           horizontalJobs.size() + verticalJobs.size());
+
+    if (!horizontalJobs.isEmpty()) {
+        m_d->runJobs(horizontalJobs,
+                     coefficients(KisGaussianKernel::sigmaFromRadius(m_d->xRadius)),
+                     converter, progressHelper);
+    }
+
+    if (!verticalJobs.isEmpty()) {
+        m_d->runJobs(verticalJobs,
+                     coefficients(KisGaussianKernel::sigmaFromRadius(m_d->yRadius)),
+                     converter, progressHelper);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISRECURSIVEGAUSSIANBLUR_H
+#define KISRECURSIVEGAUSSIANBLUR_H
+
+#include "kritaimage_export.h"
+
+#include <QBitArray>
+#include <QScopedPointer>
+
+#include "kis_types.h"
+#include "kis_convolution_painter.h"
+
+class QRect;
+class KoUpdater;
+
+
+/**
+ * @brief KisRecursiveGaussianBlur approximates the gaussian blur with
+ * a third-order recursive (IIR) filter by Young and van Vliet
+ *
+ * The cost of the filter doesn't depend on the radius, so for big radii
+ * it is much faster than the convolution with the exact kernel, both
+ * spatial and FFT-based. The result deviates from the exact kernel by
+ * about 1% of the channel range on sharp edges, which is not visible on
+ * such radii, so KisGaussianKernel::applyGaussian() switches to this
+ * engine automatically for radii bigger than minimumRadius().
+ *
+ * The borders are handled with the initial conditions by Triggs and
+ * Sdika, which are equivalent to the infinite repetition of the edge
+ * pixels, so BORDER_REPEAT is exact and the engine reads the same
+ * area of the source device as the exact kernel does.
+ *
+ * The blur is separable. Every pass splits the area into the strips
+ * aligned to the tiles of the device and processes them on multiple
+ * threads. Inside a strip, the recursion runs for all the rows
+ * (or columns) of the strip at once, so the inner loop is vectorized.
+ */
+class KRITAIMAGE_EXPORT KisRecursiveGaussianBlur
+{
+public:
+    struct Coefficients {
+        double B = 1.0;
+        double a1 = 0.0;
+        double a2 = 0.0;
+        double a3 = 0.0;
+
+        /// maps the forward state at the right border to the initial
+        /// backward state (Triggs and Sdika)
+        double M[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+    };
+
+public:
+    KisRecursiveGaussianBlur(qreal xRadius, qreal yRadius);
+    ~KisRecursiveGaussianBlur();
+
+    /**
+     * The radius starting from which KisGaussianKernel::applyGaussian()
+     * uses the recursive approximation instead of the exact kernel
+     */
+    static qreal minimumRadius();
+
+    /**
+     * @return true if the recursive approximation should be used for
+     * the blur with \p xRadius and \p yRadius
+     */
+    static bool isApplicable(qreal xRadius, qreal yRadius);
+
+    static Coefficients coefficients(qreal sigma);
+
+    void setChannelFlags(const QBitArray &channelFlags);
+    void setProgress(KoUpdater *progressUpdater);
+
+    /**
+     * Sets the number of threads the passes are split into. Zero means
+     * the number of threads set in the preferences, or a single thread
+     * when called from a job of the updater context. One disables
+     * multithreading.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
+    /**
+     * Blurs \p rect of \p device in place. The pixels around \p rect
+     * are read in the same range as the exact kernel of the same
+     * radius would read.
+     */
+    void apply(KisPaintDeviceSP device, const QRect &rect, KisConvolutionBorderOp borderOp);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISRECURSIVEGAUSSIANBLUR_H
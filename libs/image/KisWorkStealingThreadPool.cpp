@@ -0,0 +1,264 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisWorkStealingThreadPool.h"
+
+#include <atomic>
+
+#include <QMutex>
+#include <QRunnable>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "kis_assert.h"
+#include "kis_lockless_stack.h"
+
+namespace {
+
+/**
+ * The number of times an idle worker checks for new jobs before
+ * going to sleep. Every check yields the CPU, so the other threads
+ * are not starved.
+ */
+const int SPIN_COUNT = 64;
+
+}
+
+struct Q_DECL_HIDDEN KisWorkStealingThreadPool::Private
+{
+    class Worker : public QThread
+    {
+    public:
+        Worker(Private *_pool, int _index)
+            : pool(_pool), index(_index)
+        {
+        }
+
+        void run() override;
+
+        Private *pool;
+        const int index;
+        KisLocklessStack<QRunnable*> jobs;
+    };
+
+    QVector<Worker*> workers;
+
+    /**
+     * Jobs pushed into the stacks, but not yet taken by any worker
+     */
+    std::atomic<int> pendingJobs {0};
+
+    /**
+     * Jobs taken by the workers, but not yet completed
+     */
+    std::atomic<int> activeJobs {0};
+
+    std::atomic<int> numSleepingWorkers {0};
+    std::atomic<unsigned int> nextWorker {0};
+    std::atomic<int> numStolenJobs {0};
+    std::atomic<bool> shouldExit {false};
+
+    QMutex sleepLock;
+    QWaitCondition jobAdded;
+    QWaitCondition allJobsDone;
+
+    static thread_local Worker *currentWorker;
+
+    QRunnable* tryTakeJob(Worker *worker);
+    void runJob(QRunnable *job);
+    void startWorkers(int count);
+    void stopWorkers();
+};
+
+thread_local KisWorkStealingThreadPool::Private::Worker*
+KisWorkStealingThreadPool::Private::currentWorker = nullptr;
+
+
+void KisWorkStealingThreadPool::Private::Worker::run()
+{
+    currentWorker = this;
+
+    while (1) {
+        QRunnable *job = pool->tryTakeJob(this);
+        if (job) {
+            pool->runJob(job);
+            continue;
+        }
+
+        bool hasPendingJobs = false;
+        for (int i = 0; i < SPIN_COUNT && !pool->shouldExit; i++) {
+            if (pool->pendingJobs.load() > 0) {
+                hasPendingJobs = true;
+                break;
+            }
+            QThread::yieldCurrentThread();
+        }
+
+        if (hasPendingJobs) continue;
+
+        /**
+         * The sleeping counter is incremented *before* the pending
+         * jobs counter is checked, and KisWorkStealingThreadPool::start()
+         * does it in the reverse order, so at least one side always
+         * notices the other one and the wake-up cannot be lost.
+         */
+        QMutexLocker l(&pool->sleepLock);
+        pool->numSleepingWorkers++;
+
+        while (!pool->pendingJobs.load() && !pool->shouldExit) {
+            pool->jobAdded.wait(&pool->sleepLock);
+        }
+
+        pool->numSleepingWorkers--;
+
+        if (pool->shouldExit && !pool->pendingJobs.load()) break;
+    }
+
+    currentWorker = nullptr;
+}
+
+QRunnable* KisWorkStealingThreadPool::Private::tryTakeJob(Worker *worker)
+{
+    QRunnable *job = 0;
+
+    bool found = worker->jobs.pop(job);
+
+    for (int i = 1; !found && i < workers.size(); i++) {
+        Worker *victim = workers[(worker->index + i) % workers.size()];
+        found = victim->jobs.pop(job);
+
+        if (found) {
+            numStolenJobs++;
+        }
+    }
+
+    if (found) {
+        // increment first to keep waitForDone() from a false wake-up
+        activeJobs++;
+        pendingJobs--;
+    }
+
+    return found ? job : 0;
+}
+
+void KisWorkStealingThreadPool::Private::runJob(QRunnable *job)
+{
+    job->run();
+
+    if (job->autoDelete()) {
+        delete job;
+    }
+
+    if (--activeJobs == 0 && !pendingJobs.load()) {
+        QMutexLocker l(&sleepLock);
+        allJobsDone.wakeAll();
+    }
+}
+
+void KisWorkStealingThreadPool::Private::startWorkers(int count)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(workers.isEmpty());
+
+    for (int i = 0; i < count; i++) {
+        workers.append(new Worker(this, i));
+    }
+
+    Q_FOREACH (Worker *worker, workers) {
+        worker->start();
+    }
+}
+
+void KisWorkStealingThreadPool::Private::stopWorkers()
+{
+    if (workers.isEmpty()) return;
+
+    {
+        QMutexLocker l(&sleepLock);
+        shouldExit = true;
+        jobAdded.wakeAll();
+    }
+
+    Q_FOREACH (Worker *worker, workers) {
+        worker->wait();
+    }
+
+    qDeleteAll(workers);
+    workers.clear();
+
+    shouldExit = false;
+}
+
+
+KisWorkStealingThreadPool::KisWorkStealingThreadPool()
+    : m_d(new Private)
+{
+}
+
+KisWorkStealingThreadPool::~KisWorkStealingThreadPool()
+{
+    waitForDone();
+    m_d->stopWorkers();
+}
+
+void KisWorkStealingThreadPool::setMaxThreadCount(int value)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(value > 0);
+    if (value == m_d->workers.size()) return;
+
+    waitForDone();
+    m_d->stopWorkers();
+    m_d->startWorkers(value);
+}
+
+int KisWorkStealingThreadPool::maxThreadCount() const
+{
+    return m_d->workers.size();
+}
+
+void KisWorkStealingThreadPool::start(QRunnable *runnable)
+{
+    KIS_SAFE_ASSERT_RECOVER(!m_d->workers.isEmpty()) {
+        runnable->run();
+        if (runnable->autoDelete()) {
+            delete runnable;
+        }
+        return;
+    }
+
+    Private::Worker *worker = Private::currentWorker;
+
+    if (!worker || worker->pool != m_d.data()) {
+        const unsigned int index = m_d->nextWorker++;
+        worker = m_d->workers[index % unsigned(m_d->workers.size())];
+    }
+
+    /**
+     * The counter is incremented before the job becomes visible to the
+     * workers, so that it never goes negative and waitForDone() never
+     * misses the job.
+     */
+    m_d->pendingJobs++;
+    worker->jobs.push(runnable);
+
+    if (m_d->numSleepingWorkers.load() > 0) {
+        QMutexLocker l(&m_d->sleepLock);
+        m_d->jobAdded.wakeOne();
+    }
+}
+
+void KisWorkStealingThreadPool::waitForDone()
+{
+    QMutexLocker l(&m_d->sleepLock);
+
+    while (m_d->pendingJobs.load() || m_d->activeJobs.load()) {
+        m_d->allJobsDone.wait(&m_d->sleepLock);
+    }
+}
+
+int KisWorkStealingThreadPool::numStolenJobs() const
+{
+    return m_d->numStolenJobs.load();
+}
@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISWORKSTEALINGTHREADPOOL_H
+#define KISWORKSTEALINGTHREADPOOL_H
+
+#include <QScopedPointer>
+
+#include "kritaimage_export.h"
+
+class QRunnable;
+
+/**
+ * @brief A thread pool with per-thread job stacks and work stealing
+ *
+ * KisWorkStealingThreadPool is an alternative executor for
+ * KisUpdaterContext. It has the same interface as the subset of
+ * QThreadPool used by the context, but schedules the jobs differently:
+ *
+ * 1) Every worker thread owns a lock-free job stack (KisLocklessStack).
+ *    When a job is started from inside a worker (which is the usual case,
+ *    since the scheduler is re-entered from KisUpdateJobItem::run() when a
+ *    job finishes), it is pushed into the stack of this very worker, so
+ *    no global lock is touched.
+ *
+ * 2) Jobs started from outside the pool are distributed in round-robin
+ *    manner.
+ *
+ * 3) A worker that has nothing to do tries to steal a job from the other
+ *    workers and spins for a short while before going to sleep. Merge
+ *    jobs are usually very short, so the spinning lets the next job be
+ *    picked up without an expensive wake-up of a sleeping thread.
+ *
+ * The pool knows nothing about the exclusivity and sequentiality of the
+ * jobs, these rules are still enforced by KisStrokesQueue and
+ * KisUpdaterContext before the job is started.
+ */
+class KRITAIMAGE_EXPORT KisWorkStealingThreadPool
+{
+public:
+    KisWorkStealingThreadPool();
+    ~KisWorkStealingThreadPool();
+
+    /**
+     * Sets the number of worker threads. The pool must be idle
+     * when calling this method.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
+    /**
+     * Schedules \p runnable for execution. If runnable->autoDelete()
+     * is true, the runnable is deleted after completion.
+     */
+    void start(QRunnable *runnable);
+
+    /**
+     * Blocks until all the scheduled jobs are completed
+     */
+    void waitForDone();
+
+    /**
+     * The number of jobs that were executed by a thread different from
+     * the one they were pushed to. Used for statistics and testing only.
+     */
+    int numStolenJobs() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISWORKSTEALINGTHREADPOOL_H
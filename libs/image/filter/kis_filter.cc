@@ -17,11 +17,13 @@
 #include "kis_selection.h"
 #include "kis_types.h"
 #include <kis_painter.h>
+#include <kis_lod_transform_base.h>
 #include <KoUpdater.h>
 
 KisFilter::KisFilter(const KoID& _id, const KoID & category, const QString & entry)
     : KisBaseProcessor(_id, category, entry),
-      m_supportsLevelOfDetail(false)
+      m_supportsLevelOfDetail(false),
+      m_scalesConfigurationForLevelOfDetail(false)
 {
     init(id() + "_filter_bookmarks");
 }
@@ -49,6 +51,7 @@ void KisFilter::process(const KisPaintDeviceSP src,
 
     if (applyRect.isEmpty()) return;
     QRect needRect = neededRect(applyRect, config, src->defaultBounds()->currentLevelOfDetail());
+    src->prefetchRect(needRect);
 
     KisPaintDeviceSP temporary;
     KisTransaction *transaction = 0;
@@ -114,6 +117,71 @@ void KisFilter::setSupportsLevelOfDetail(bool value)
     m_supportsLevelOfDetail = value;
 }
 
+KisFilterConfigurationSP KisFilter::configurationForLevelOfDetail(const KisFilterConfigurationSP config, int lod) const
+{
+    if (!config || lod <= 0 || !m_scalesConfigurationForLevelOfDetail) return config;
+
+    KisFilterConfigurationSP scaledConfig = config->clone();
+    scaleConfigurationForLevelOfDetail(scaledConfig, lod);
+    return scaledConfig;
+}
+
+KisFilterConfigurationSP KisFilter::configurationForLevelOfDetail(const KisFilterConfigurationSP config, KisPaintDeviceSP device) const
+{
+    return configurationForLevelOfDetail(config, device->defaultBounds()->currentLevelOfDetail());
+}
+
+void KisFilter::addLevelOfDetailScaledProperty(const QString &name, qreal minimumValue)
+{
+    m_levelOfDetailScaledProperties.append({name, minimumValue});
+    setScalesConfigurationForLevelOfDetail(true);
+}
+
+void KisFilter::setScalesConfigurationForLevelOfDetail(bool value)
+{
+    m_scalesConfigurationForLevelOfDetail = value;
+    setSupportsLevelOfDetail(value);
+}
+
+void KisFilter::scaleConfigurationForLevelOfDetail(KisFilterConfigurationSP config, int lod) const
+{
+    Q_FOREACH (const LevelOfDetailScaledProperty &property, m_levelOfDetailScaledProperties) {
+        scaleLevelOfDetailProperty(config, property.name, lod, property.minimumValue);
+    }
+}
+
+void KisFilter::scaleLevelOfDetailProperty(KisFilterConfigurationSP config, const QString &name, int lod, qreal minimumValue)
+{
+    QVariant value;
+    if (!config->getProperty(name, value)) return;
+
+    /**
+     * The configurations loaded from XML store all the values as
+     * strings, so the type of the property is guessed from the value
+     */
+    bool isInteger = false;
+
+    if (value.type() == QVariant::String) {
+        value.toString().toInt(&isInteger);
+    } else {
+        isInteger =
+            value.type() == QVariant::Int ||
+            value.type() == QVariant::UInt ||
+            value.type() == QVariant::LongLong ||
+            value.type() == QVariant::ULongLong;
+    }
+
+    bool isNumber = false;
+    const qreal scaledValue = qMax(minimumValue, KisLodTransformScalar(lod).scale(value.toReal(&isNumber)));
+    KIS_SAFE_ASSERT_RECOVER_RETURN(isNumber);
+
+    if (isInteger) {
+        config->setProperty(name, qMax(qCeil(minimumValue), qRound(scaledValue)));
+    } else {
+        config->setProperty(name, scaledValue);
+    }
+}
+
 bool KisFilter::needsTransparentPixels(const KisFilterConfigurationSP config, const KoColorSpace *cs) const
 {
     Q_UNUSED(config);
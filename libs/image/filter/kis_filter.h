@@ -9,6 +9,7 @@
 #include <list>
 
 #include <QString>
+#include <QVector>
 
 #include <klocalizedstring.h>
 
@@ -98,6 +99,25 @@ public:
      */
     virtual bool supportsLevelOfDetail(const KisFilterConfigurationSP config, int lod) const;
 
+    /**
+     * Returns a copy of \p config with all the parameters measured in
+     * pixels (radii, kernel sizes, spacing, amplitudes) scaled down for
+     * the level of detail \p lod. The filters that opted into the scaling
+     * with addLevelOfDetailScaledProperty() or
+     * setScalesConfigurationForLevelOfDetail() call it in processImpl(),
+     * neededRect() and changedRect(), so the preview on a LoD plane looks
+     * the same as the full-size result and costs proportionally less.
+     *
+     * If \p lod is zero or the filter doesn't scale its configuration,
+     * \p config itself is returned.
+     */
+    KisFilterConfigurationSP configurationForLevelOfDetail(const KisFilterConfigurationSP config, int lod) const;
+
+    /**
+     * A convenience overload that takes the level of detail of \p device
+     */
+    KisFilterConfigurationSP configurationForLevelOfDetail(const KisFilterConfigurationSP config, KisPaintDeviceSP device) const;
+
     virtual bool needsTransparentPixels(const KisFilterConfigurationSP config, const KoColorSpace *cs) const;
 
     virtual bool configurationAllowedForMask(KisFilterConfigurationSP config) const;
@@ -108,9 +128,48 @@ protected:
     QString configEntryGroup() const;
     void setSupportsLevelOfDetail(bool value);
 
+    /**
+     * Registers a configuration property measured in pixels, which should
+     * be scaled by configurationForLevelOfDetail(). Integer properties are
+     * rounded after scaling. The scaled value is never smaller than
+     * \p minimumValue, so the parameters that the filter divides by (e.g.
+     * a wavelength) may be protected from becoming zero.
+     *
+     * Registering a property marks the filter as supporting level of detail.
+     */
+    void addLevelOfDetailScaledProperty(const QString &name, qreal minimumValue = 0.0);
+
+    /**
+     * Marks the filter as supporting level of detail by the means of
+     * scaling its configuration. Use it for the filters that override
+     * scaleConfigurationForLevelOfDetail() instead of registering the
+     * properties.
+     */
+    void setScalesConfigurationForLevelOfDetail(bool value);
+
+    /**
+     * The scaling hook called by configurationForLevelOfDetail() on a
+     * private copy of the configuration. The default implementation scales
+     * the properties registered with addLevelOfDetailScaledProperty().
+     * Override it when the parameters cannot be described by a property
+     * name, e.g. when they are stored in nested configurations.
+     */
+    virtual void scaleConfigurationForLevelOfDetail(KisFilterConfigurationSP config, int lod) const;
+
+    /**
+     * Scales property \p name of \p config for level of detail \p lod
+     */
+    static void scaleLevelOfDetailProperty(KisFilterConfigurationSP config, const QString &name, int lod, qreal minimumValue = 0.0);
 
 private:
+    struct LevelOfDetailScaledProperty {
+        QString name;
+        qreal minimumValue;
+    };
+
     bool m_supportsLevelOfDetail;
+    bool m_scalesConfigurationForLevelOfDetail;
+    QVector<LevelOfDetailScaledProperty> m_levelOfDetailScaledProperties;
 };
 
 
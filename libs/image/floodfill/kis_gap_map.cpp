@@ -120,7 +120,9 @@ void KisGapMap::loadOpacityTiles(const QRect& tileRect)
     for (int ty = tileRect.top(); ty <= tileRect.bottom(); ++ty) {
         for (int tx = tileRect.left(); tx <= tileRect.right(); ++tx) {
             TileFlags* const pFlags = tileFlagsPtr(tx, ty);
-            if ((*pFlags & TILE_OPACITY_LOADED) == 0) {
+            if ((*pFlags & TILE_OPACITY_STALE) != 0) {
+                revalidateOpacityTile(tx, ty, pFlags);
+            } else if ((*pFlags & TILE_OPACITY_LOADED) == 0) {
                 // Resize and clamp to image bounds.
                 QRect rect(tx * TileSize, ty * TileSize, TileSize, TileSize);
                 rect.setRight(qMin(rect.right(), m_size.width() - 1));
@@ -143,6 +145,97 @@ void KisGapMap::loadOpacityTiles(const QRect& tileRect)
 #endif
 }
 
+void KisGapMap::setFillOpacityFunc(const FillOpacityFunc& fillOpacityFunc)
+{
+    m_fillOpacityFunc = fillOpacityFunc;
+}
+
+void KisGapMap::markTilesForRevalidation()
+{
+    for (int ty = 0; ty < m_numTiles.height(); ++ty) {
+        for (int tx = 0; tx < m_numTiles.width(); ++tx) {
+            TileFlags* const pFlags = tileFlagsPtr(tx, ty);
+
+            if ((*pFlags & TILE_OPACITY_LOADED) != 0) {
+                *pFlags |= TILE_OPACITY_STALE;
+            }
+
+            // The distance data is kept, but it cannot be used before
+            // the opacity of all the nearby tiles has been revalidated.
+            if ((*pFlags & TILE_DISTANCE_LOADED) != 0) {
+                *pFlags &= ~TILE_DISTANCE_LOADED;
+                *pFlags |= TILE_DISTANCE_STALE;
+            }
+        }
+    }
+}
+
+/** Reload the opacity of a tile loaded by a previous fill and compare it with the old data.
+ *  If anything has changed, the distance data of all the tiles that depend on it is dropped.
+ */
+void KisGapMap::revalidateOpacityTile(int tileX, int tileY, TileFlags* pFlags)
+{
+    QRect rect(tileX * TileSize, tileY * TileSize, TileSize, TileSize);
+    rect.setRight(qMin(rect.right(), m_size.width() - 1));
+    rect.setBottom(qMin(rect.bottom(), m_size.height() - 1));
+
+    // The callback only marks the opaque pixels, so the tile must be reset first.
+    quint8 oldOpacity[TileSize * TileSize];
+    Data* const tileDataPtr = reinterpret_cast<Data*>(m_accessor->tileRawData(tileX, tileY));
+
+    for (int y = 0; y < rect.height(); ++y) {
+        Data* ptr = tileDataPtr + TileSize * y;
+        for (int x = 0; x < rect.width(); ++x, ++ptr) {
+            oldOpacity[TileSize * y + x] = ptr->opacity;
+            ptr->opacity = MAX_SELECTED;
+        }
+    }
+
+    const bool hasOpaquePixels = m_fillOpacityFunc(m_deviceSp.data(), rect);
+
+    bool changed = false;
+    for (int y = 0; y < rect.height() && !changed; ++y) {
+        const Data* ptr = tileDataPtr + TileSize * y;
+        for (int x = 0; x < rect.width(); ++x, ++ptr) {
+            if (oldOpacity[TileSize * y + x] != ptr->opacity) {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    *pFlags &= ~(TILE_OPACITY_STALE | TILE_HAS_OPAQUE_PIXELS);
+    *pFlags |= (hasOpaquePixels ? TILE_HAS_OPAQUE_PIXELS : 0);
+
+    if (changed) {
+        // The distance of a tile depends on the opacity of its direct neighbors.
+        invalidateDistanceTiles(QRect(QPoint(qMax(0, tileX - 1), qMax(0, tileY - 1)),
+                                      QPoint(qMin(tileX + 1, m_numTiles.width() - 1),
+                                             qMin(tileY + 1, m_numTiles.height() - 1))));
+    }
+}
+
+void KisGapMap::invalidateDistanceTiles(const QRect& tileRect)
+{
+    for (int ty = tileRect.top(); ty <= tileRect.bottom(); ++ty) {
+        for (int tx = tileRect.left(); tx <= tileRect.right(); ++tx) {
+            TileFlags* const pFlags = tileFlagsPtr(tx, ty);
+
+            // A tile that is already loaded in this fill has had all its neighbors
+            // revalidated beforehand, so only the stale data has to be dropped.
+            if ((*pFlags & TILE_DISTANCE_STALE) == 0) continue;
+
+            *pFlags &= ~TILE_DISTANCE_STALE;
+
+            // The distance calculation only ever lowers the values, so start from scratch.
+            Data* ptr = reinterpret_cast<Data*>(m_accessor->tileRawData(tx, ty));
+            for (int i = 0; i < TileSize * TileSize; ++i, ++ptr) {
+                ptr->distance = DISTANCE_INFINITE;
+            }
+        }
+    }
+}
+
 /** This is a part of loadDistanceTile() implementation. */
 void KisGapMap::distanceSearchRowInnerLoop(bool boundsCheck, int y, int x1, int x2)
 {
@@ -350,8 +443,16 @@ quint16 KisGapMap::lazyDistance(int x, int y)
     // For opacity data, we always load all the adjacent tiles (up to 9 tiles in total).
     loadOpacityTiles(nearbyTiles);
 
-    // For distance data, we always load a single tile.
-    loadDistanceTile(QPoint(tx, ty), nearbyTiles, m_gapSize);
+    // For distance data, we always load a single tile. The revalidation above
+    // has already dropped the stale data, if any of the nearby tiles has changed.
+    TileFlags* const pFlags = tileFlagsPtr(tx, ty);
+    if ((*pFlags & TILE_DISTANCE_STALE) != 0) {
+        *pFlags &= ~TILE_DISTANCE_STALE;
+        *pFlags |= TILE_DISTANCE_LOADED;
+    } else {
+        m_numComputedDistanceTiles++;
+        loadDistanceTile(QPoint(tx, ty), nearbyTiles, m_gapSize);
+    }
 
     // The data is now ready to be returned.
     return dataPtr(x, y)->distance;
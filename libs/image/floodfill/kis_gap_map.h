@@ -124,6 +124,39 @@ public:
         return m_gapSize;
     }
 
+    ALWAYS_INLINE QSize size() const
+    {
+        return m_size;
+    }
+
+    /** The amount of memory taken by the distance and opacity data of the map */
+    qint64 memoryUsage() const
+    {
+        return qint64(m_size.width()) * m_size.height() * sizeof(Data);
+    }
+
+    /** Replace the opacity callback. A gap map kept in KisGapMapCache must be
+     *  given the callback of the new fill before distance() is called again.
+     */
+    void setFillOpacityFunc(const FillOpacityFunc& fillOpacityFunc);
+
+    /** Prepare the map for reuse after the source of the opacity data might have changed.
+     *
+     *  All the loaded tiles are kept, but they are marked as stale. The opacity of a stale
+     *  tile is reloaded and compared with the old data the first time the tile is needed.
+     *  The distance data of a tile is recomputed only if the opacity of the tile itself or
+     *  one of its neighbors has actually changed.
+     */
+    void markTilesForRevalidation();
+
+    /** @return the total number of tiles, whose distance data has been computed
+     *  by this map, including the recomputations caused by revalidation.
+     */
+    int numComputedDistanceTiles() const
+    {
+        return m_numComputedDistanceTiles;
+    }
+
 #if KIS_GAP_MAP_MEASURE_ELAPSED_TIME
 public:
     quint64 opacityElapsedMillis() const
@@ -153,6 +186,8 @@ private:
         TILE_DISTANCE_LOADED     = 0x1,      ///< Distance data is available
         TILE_OPACITY_LOADED      = 0x2,      ///< Opacity data is available
         TILE_HAS_OPAQUE_PIXELS   = 0x4,      ///< Some pixels of the loaded tile are opaque
+        TILE_OPACITY_STALE       = 0x8,      ///< Opacity was loaded by a previous fill and must be revalidated
+        TILE_DISTANCE_STALE      = 0x10,     ///< Distance was computed by a previous fill, valid if the nearby opacity is unchanged
     };
 
     struct Data
@@ -164,6 +199,8 @@ private:
     static_assert(sizeof(Data) == sizeof(quint32));
 
     void loadOpacityTiles(const QRect& tileRect);
+    void revalidateOpacityTile(int tileX, int tileY, TileFlags* pFlags);
+    void invalidateDistanceTiles(const QRect& tileRect);
     void loadDistanceTile(const QPoint& tile, const QRect& nearbyTilesRect, int guardBand);
     void distanceSearchRowInnerLoop(bool boundsCheck, int y, int x1, int x2);
     quint16 lazyDistance(int x, int y);
@@ -197,7 +234,8 @@ private:
     const int m_gapSize;                      ///< Gap size in pixels for this map
     const QSize m_size;                       ///< Size in pixels of the opacity/gap map
     const QSize m_numTiles;                   ///< Map size in tiles
-    const FillOpacityFunc m_fillOpacityFunc;  ///< A callback to get the opacity data from the fill class
+    FillOpacityFunc m_fillOpacityFunc;        ///< A callback to get the opacity data from the fill class
+    int m_numComputedDistanceTiles = 0;       ///< Statistics of the lazy loading
 
     QPoint m_tilePosition;                    ///< The position of the currently computed tile compared to the whole region
     Data* m_tileDataPtr;                      ///< The pointer to the currently computed tile data
@@ -206,4 +244,6 @@ private:
     std::unique_ptr<KisTileOptimizedAccessor> m_accessor;   ///< An accessor for the paint device
 };
 
+typedef KisSharedPtr<KisGapMap> KisGapMapSP;
+
 #endif /* __KIS_GAP_MAP_H */
@@ -0,0 +1,222 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_gap_map_cache.h"
+
+#include <QGlobalStatic>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <kis_paint_device.h>
+
+Q_GLOBAL_STATIC(KisGapMapCache, s_instance)
+
+
+namespace {
+int sequenceNumberOf(KisPaintDeviceSP device)
+{
+    return device ? device->sequenceNumber() : -1;
+}
+
+const KisPaintDevice* devicePtr(const KisPaintDeviceWSP &device)
+{
+    return device.isValid() ? device.data() : nullptr;
+}
+}
+
+KisGapMapCache::SourceState::SourceState(KisPaintDeviceSP _referenceDevice, KisPaintDeviceSP _boundaryDevice)
+    : referenceDevice(_referenceDevice),
+      referenceSequenceNumber(sequenceNumberOf(_referenceDevice)),
+      boundaryDevice(_boundaryDevice),
+      boundarySequenceNumber(sequenceNumberOf(_boundaryDevice))
+{
+}
+
+bool KisGapMapCache::SourceState::isSameDevice(const SourceState &rhs) const
+{
+    const KisPaintDevice *device = devicePtr(referenceDevice);
+    return device && device == devicePtr(rhs.referenceDevice);
+}
+
+bool KisGapMapCache::SourceState::isUnchanged(const SourceState &rhs) const
+{
+    return isSameDevice(rhs) &&
+        referenceSequenceNumber == rhs.referenceSequenceNumber &&
+        devicePtr(boundaryDevice) == devicePtr(rhs.boundaryDevice) &&
+        boundarySequenceNumber == rhs.boundarySequenceNumber;
+}
+
+struct KisGapMapCache::Private
+{
+    struct Entry {
+        QByteArray opacityKey;
+        SourceState state;
+        KisGapMapSP gapMap;
+    };
+
+    QMutex mutex;
+
+    /// most recently used entries are stored at the front of the list
+    QList<Entry> entries;
+    int maxEntries = 0;
+    qint64 maxMemoryUsage = 0;
+
+    qint64 memoryUsage() const;
+    void evictExtraEntries();
+};
+
+qint64 KisGapMapCache::Private::memoryUsage() const
+{
+    qint64 result = 0;
+    Q_FOREACH (const Entry &entry, entries) {
+        result += entry.gapMap->memoryUsage();
+    }
+    return result;
+}
+
+void KisGapMapCache::Private::evictExtraEntries()
+{
+    // the maps of the deleted devices will never be reused as they are
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (!it->state.referenceDevice.isValid()) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (entries.size() > maxEntries) {
+        entries.removeLast();
+    }
+
+    qint64 totalMemoryUsage = memoryUsage();
+
+    while (!entries.isEmpty() && totalMemoryUsage > maxMemoryUsage) {
+        totalMemoryUsage -= entries.last().gapMap->memoryUsage();
+        entries.removeLast();
+    }
+}
+
+KisGapMapCache::KisGapMapCache(int maxEntries, qint64 maxMemoryUsage)
+    : m_d(new Private)
+{
+    m_d->maxEntries = maxEntries;
+    m_d->maxMemoryUsage = maxMemoryUsage;
+}
+
+KisGapMapCache::~KisGapMapCache()
+{
+}
+
+KisGapMapCache *KisGapMapCache::instance()
+{
+    return s_instance;
+}
+
+KisGapMapSP KisGapMapCache::take(const QByteArray &opacityKey,
+                                 int gapSize,
+                                 const QRect &bounds,
+                                 const SourceState &state,
+                                 bool *sourceChanged)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->evictExtraEntries();
+
+    int foundIndex = -1;
+
+    for (int i = 0; i < m_d->entries.size(); i++) {
+        const Private::Entry &entry = m_d->entries[i];
+
+        if (entry.opacityKey != opacityKey ||
+            entry.gapMap->gapSize() != gapSize ||
+            entry.gapMap->size() != bounds.size()) {
+
+            continue;
+        }
+
+        if (foundIndex < 0 || entry.state.isSameDevice(state)) {
+            foundIndex = i;
+        }
+
+        if (entry.state.isSameDevice(state)) break;
+    }
+
+    if (foundIndex < 0) return KisGapMapSP();
+
+    const Private::Entry entry = m_d->entries.takeAt(foundIndex);
+    *sourceChanged = !entry.state.isUnchanged(state);
+
+    return entry.gapMap;
+}
+
+void KisGapMapCache::store(const QByteArray &opacityKey,
+                           const SourceState &state,
+                           KisGapMapSP gapMap)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    if (gapMap->memoryUsage() > m_d->maxMemoryUsage) return;
+
+    // keep only one map per reference device
+    for (auto it = m_d->entries.begin(); it != m_d->entries.end();) {
+        if (it->state.isSameDevice(state)) {
+            it = m_d->entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_d->entries.prepend({opacityKey, state, gapMap});
+    m_d->evictExtraEntries();
+}
+
+void KisGapMapCache::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->entries.clear();
+}
+
+int KisGapMapCache::numEntries() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->entries.size();
+}
+
+qint64 KisGapMapCache::memoryUsage() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->memoryUsage();
+}
+
+void KisGapMapCache::setMaxEntries(int value)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->maxEntries = value;
+    m_d->evictExtraEntries();
+}
+
+int KisGapMapCache::maxEntries() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->maxEntries;
+}
+
+void KisGapMapCache::setMaxMemoryUsage(qint64 value)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->maxMemoryUsage = value;
+    m_d->evictExtraEntries();
+}
+
+qint64 KisGapMapCache::maxMemoryUsage() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->maxMemoryUsage;
+}
@@ -0,0 +1,114 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_GAP_MAP_CACHE_H
+#define __KIS_GAP_MAP_CACHE_H
+
+#include "kritaimage_export.h"
+
+#include <QByteArray>
+#include <QRect>
+#include <QScopedPointer>
+
+#include <kis_types.h>
+#include "kis_gap_map.h"
+
+
+/**
+ * Keeps the gap maps of the recent gap closing fills, so that successive
+ * clicks with the fill or enclose-and-fill tool on the same lineart do not
+ * recompute the whole distance map.
+ *
+ * A gap map is stored together with the opacity key, which describes all
+ * the parameters the opacity data depends on (the selection policy, the
+ * reference color, threshold, softness), and the state of the source
+ * devices (their identity and sequence numbers) at the moment of the fill.
+ *
+ * When the sources are unchanged, the map is reused as it is. Otherwise
+ * the map is reused only after calling KisGapMap::markTilesForRevalidation(),
+ * so only the tiles that have actually changed are recomputed.
+ *
+ * The maps are as big as the filled area, so the cache is limited both
+ * by the number of maps and by the memory they take. The maps of the
+ * deleted devices are dropped, and the whole cache is cleared when an
+ * image is destroyed.
+ *
+ * The cache is thread-safe. A map is removed from the cache while a fill
+ * is using it, so it is never shared between two fills.
+ */
+class KRITAIMAGE_EXPORT KisGapMapCache
+{
+public:
+    /**
+     * Identity and sequence numbers of the devices the opacity data
+     * of a gap map has been calculated from
+     */
+    struct SourceState {
+        SourceState() = default;
+        SourceState(KisPaintDeviceSP referenceDevice, KisPaintDeviceSP boundaryDevice);
+
+        bool isSameDevice(const SourceState &rhs) const;
+        bool isUnchanged(const SourceState &rhs) const;
+
+        KisPaintDeviceWSP referenceDevice;
+        int referenceSequenceNumber = -1;
+        KisPaintDeviceWSP boundaryDevice;
+        int boundarySequenceNumber = -1;
+    };
+
+public:
+    KisGapMapCache(int maxEntries = 2, qint64 maxMemoryUsage = 256 * 1024 * 1024);
+    ~KisGapMapCache();
+
+    static KisGapMapCache* instance();
+
+    /**
+     * Removes a matching gap map from the cache and returns it. The maps
+     * calculated from the same reference device are preferred, but a map of
+     * another device (e.g. a freshly merged copy of the same image) is also
+     * accepted, since it is revalidated by content anyway.
+     *
+     * @param opacityKey the parameters of the opacity data
+     * @param gapSize the gap size of the fill
+     * @param bounds the bounds of the fill
+     * @param state the current state of the source devices
+     * @param sourceChanged is set to false if the sources of the returned
+     *        map are unchanged and the map can be used without revalidation
+     * @return the gap map or a null pointer if there is no matching map
+     */
+    KisGapMapSP take(const QByteArray &opacityKey,
+                     int gapSize,
+                     const QRect &bounds,
+                     const SourceState &state,
+                     bool *sourceChanged);
+
+    /**
+     * Stores \p gapMap for reuse by the following fills, evicting the least
+     * recently used maps if the cache is full. The map is not stored if it
+     * alone exceeds the memory limit. \p state must be the state of the
+     * sources captured *before* the fill has started.
+     */
+    void store(const QByteArray &opacityKey,
+               const SourceState &state,
+               KisGapMapSP gapMap);
+
+    void clear();
+
+    int numEntries() const;
+    qint64 memoryUsage() const;
+
+    void setMaxEntries(int value);
+    int maxEntries() const;
+
+    void setMaxMemoryUsage(qint64 value);
+    qint64 maxMemoryUsage() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif /* __KIS_GAP_MAP_CACHE_H */
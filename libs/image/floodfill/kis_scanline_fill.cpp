@@ -13,14 +13,18 @@
 #include <KoColorSpace.h>
 #include <KoCompositeOpRegistry.h>
 #include "kis_image.h"
+#include "kis_image_config.h"
 #include "kis_fill_interval_map.h"
 #include "kis_pixel_selection.h"
 #include "kis_random_accessor_ng.h"
 #include "kis_fill_sanity_checks.h"
 #include <KisColorSelectionPolicies.h>
 #include "kis_gap_map.h"
+#include "kis_gap_map_cache.h"
 #include <queue>
 
+#include <QThreadPool>
+
 #define MEASURE_FILL_TIME 0
 #if MEASURE_FILL_TIME
 #include <QElapsedTimer>
@@ -28,8 +32,6 @@
 
 namespace {
 
-typedef KisSharedPtr<KisGapMap> KisGapMapSP;
-
 /**
  * A work item for the gap closing fill.
  * Can work as a seed point and as a next queued pixel to continue the fill.
@@ -51,15 +53,26 @@ struct CloseGapFillPoint
     }
 };
 
+/**
+ * NOTE: copying a policy creates new random accessors, so that the copies
+ *       can be used by the parallel fill in different threads
+ */
+
 class BasePixelAccessPolicy
 {
 public:
     using SourceAccessorType = KisRandomAccessorSP;
 
+    KisPaintDeviceSP m_sourceDevice;
     SourceAccessorType m_srcIt;
 
     BasePixelAccessPolicy(KisPaintDeviceSP sourceDevice)
-        : m_srcIt(sourceDevice->createRandomAccessorNG())
+        : m_sourceDevice(sourceDevice)
+        , m_srcIt(sourceDevice->createRandomAccessorNG())
+    {}
+
+    BasePixelAccessPolicy(const BasePixelAccessPolicy &rhs)
+        : BasePixelAccessPolicy(rhs.m_sourceDevice)
     {}
 };
 
@@ -68,10 +81,16 @@ class ConstBasePixelAccessPolicy
 public:
     using SourceAccessorType = KisRandomConstAccessorSP;
 
+    KisPaintDeviceSP m_sourceDevice;
     SourceAccessorType m_srcIt;
 
     ConstBasePixelAccessPolicy(KisPaintDeviceSP sourceDevice)
-        : m_srcIt(sourceDevice->createRandomConstAccessorNG())
+        : m_sourceDevice(sourceDevice)
+        , m_srcIt(sourceDevice->createRandomConstAccessorNG())
+    {}
+
+    ConstBasePixelAccessPolicy(const ConstBasePixelAccessPolicy &rhs)
+        : ConstBasePixelAccessPolicy(rhs.m_sourceDevice)
     {}
 };
 
@@ -84,6 +103,10 @@ public:
         , m_selectionIterator(m_pixelSelection->createRandomAccessorNG())
     {}
 
+    CopyToSelectionPixelAccessPolicy(const CopyToSelectionPixelAccessPolicy &rhs)
+        : CopyToSelectionPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_pixelSelection)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(dstPtr);
@@ -106,6 +129,10 @@ public:
         , m_pixelSize(m_fillColor.colorSpace()->pixelSize())
     {}
 
+    FillWithColorPixelAccessPolicy(const FillWithColorPixelAccessPolicy &rhs)
+        : FillWithColorPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_fillColor)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(x);
@@ -136,6 +163,10 @@ public:
         , m_pixelSize(m_fillColor.colorSpace()->pixelSize())
     {}
 
+    FillWithColorExternalPixelAccessPolicy(const FillWithColorExternalPixelAccessPolicy &rhs)
+        : FillWithColorExternalPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_fillColor, rhs.m_externalDevice)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(dstPtr);
@@ -181,9 +212,14 @@ public:
     MaskedSelectionPolicy(BaseSelectionPolicy baseSelectionPolicy,
                           KisPaintDeviceSP maskDevice)
         : m_baseSelectionPolicy(baseSelectionPolicy)
+        , m_maskDevice(maskDevice)
         , m_maskIterator(maskDevice->createRandomConstAccessorNG())
     {}
 
+    MaskedSelectionPolicy(const MaskedSelectionPolicy &rhs)
+        : MaskedSelectionPolicy(rhs.m_baseSelectionPolicy, rhs.m_maskDevice)
+    {}
+
     ALWAYS_INLINE quint8 opacityFromDifference(quint8 difference, int x, int y)
     {
         m_maskIterator->moveTo(x, y);
@@ -198,6 +234,7 @@ public:
 
 private:
     BaseSelectionPolicy m_baseSelectionPolicy;
+    KisPaintDeviceSP m_maskDevice;
     KisRandomConstAccessorSP m_maskIterator;
 };
 
@@ -242,11 +279,16 @@ public:
                                 qint32 groupIndex)
         : BasePixelAccessPolicy(scribbleDevice)
         , m_groupIndex(groupIndex)
+        , m_groupMapDevice(groupMapDevice)
         , m_groupMapIt(groupMapDevice->createRandomAccessorNG())
     {
         KIS_SAFE_ASSERT_RECOVER_NOOP(m_groupIndex > 0);
     }
 
+    GroupSplitPixelAccessPolicy(const GroupSplitPixelAccessPolicy &rhs)
+        : GroupSplitPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_groupMapDevice, rhs.m_groupIndex)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(opacity);
@@ -269,11 +311,99 @@ public:
 
 private:
     qint32 m_groupIndex;
+    KisPaintDeviceSP m_groupMapDevice;
     KisRandomAccessorSP m_groupMapIt;
 };
 
+inline int findRoot(QVector<int> &parents, int index)
+{
+    while (parents[index] != index) {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+inline void uniteRoots(QVector<int> &parents, int a, int b)
+{
+    a = findRoot(parents, a);
+    b = findRoot(parents, b);
+
+    if (a < b) {
+        parents[b] = a;
+    } else if (b < a) {
+        parents[a] = b;
+    }
+}
+
+inline bool intervalsTouch(const KisFillInterval &a, const KisFillInterval &b)
+{
+    return a.start <= b.end && b.start <= a.end;
+}
+
+/**
+ * Unites all the 4-connected intervals of the two adjacent rows
+ * given by the ranges [firstBegin, firstEnd) and [secondBegin, secondEnd).
+ * The intervals of both the rows are sorted by their start.
+ */
+template <typename IndexFunc>
+void uniteAdjacentRows(const QVector<KisFillInterval> &firstIntervals, int firstBegin, int firstEnd,
+                       const QVector<KisFillInterval> &secondIntervals, int secondBegin, int secondEnd,
+                       IndexFunc unite)
+{
+    int i = firstBegin;
+    int j = secondBegin;
+
+    while (i < firstEnd && j < secondEnd) {
+        const KisFillInterval &a = firstIntervals[i];
+        const KisFillInterval &b = secondIntervals[j];
+
+        if (intervalsTouch(a, b)) {
+            unite(i, j);
+        }
+
+        if (a.end < b.end) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+}
+
 } // anonymous namespace
 
+/**
+ * A horizontal band of the fill area used by the parallel fill. The band
+ * stores all the fillable intervals of its rows and their connected
+ * components, found with a union-find over the intervals.
+ */
+struct KisScanlineFill::FillBand
+{
+    QRect rect;
+    bool isLabeled = false;
+
+    /// index of the first interval of the band in the global union-find
+    int firstIntervalIndex = 0;
+
+    QVector<KisFillInterval> intervals;
+
+    /// index of the first interval of every row, plus the total number of intervals
+    QVector<int> rowOffsets;
+
+    /// union-find parents of the intervals, indices are local to the band
+    QVector<int> parents;
+
+    QRect fillExtent;
+
+    int rowBegin(int row) const {
+        return rowOffsets[row - rect.top()];
+    }
+
+    int rowEnd(int row) const {
+        return rowOffsets[row - rect.top() + 1];
+    }
+};
+
 struct Q_DECL_HIDDEN KisScanlineFill::Private
 {
     KisPaintDeviceSP device;
@@ -286,9 +416,21 @@ struct Q_DECL_HIDDEN KisScanlineFill::Private
     KisFillIntervalMap backwardMap;
     QStack<KisFillInterval> forwardStack;
 
+    bool parallelFillEnabled = true;
+    int parallelFillBandHeight = 0; ///< for testing purposes only, zero means automatic
+
+    /**
+     * The fill runs inside a stroke job, so it uses the same thread
+     * limit as the updater context instead of all the cores
+     */
+    int maxNumThreads = 1;
+
     int closeGap;           ///< try to close gaps up to this size in pixels
     KisGapMapSP gapMapSp;   ///< maintains the distance and opacity maps required for the algorithm
 
+    QByteArray gapMapCacheKey;              ///< describes the opacity data, empty if the gap map cannot be reused
+    KisPaintDeviceSP gapMapBoundaryDevice;  ///< the boundary selection the opacity data depends on
+
     QRect fillExtent;
 
     // The priority queue is required to correctly handle the fill "expansion" case
@@ -302,6 +444,27 @@ struct Q_DECL_HIDDEN KisScanlineFill::Private
     KisRandomAccessorSP filledSelectionIterator;
 
 
+    /**
+     * The opacity data of a selection fill depends on the fill mode,
+     * the reference color and the difference thresholds only, so
+     * the gap map can be reused by the following fills with the same
+     * parameters.
+     */
+    void setupGapMapCacheKey(const char *fillMode, const KoColor &srcColor,
+                             int softness, KisPaintDeviceSP boundarySelection) {
+        if (closeGap <= 0) return;
+
+        gapMapCacheKey = QByteArray(fillMode);
+        gapMapCacheKey += '/' + device->colorSpace()->id().toLatin1();
+        gapMapCacheKey += '/' + QByteArray::number(threshold);
+        gapMapCacheKey += '/' + QByteArray::number(softness);
+        gapMapCacheKey += boundarySelection ? "/masked/" : "/unmasked/";
+        gapMapCacheKey += QByteArray(reinterpret_cast<const char*>(srcColor.data()),
+                                     srcColor.colorSpace()->pixelSize());
+
+        gapMapBoundaryDevice = boundarySelection;
+    }
+
     inline void swapDirection() {
         rowIncrement *= -1;
         KIS_SAFE_ASSERT_RECOVER_NOOP(forwardStack.isEmpty() &&
@@ -326,6 +489,8 @@ KisScanlineFill::KisScanlineFill(KisPaintDeviceSP device, const QPoint &startPoi
     m_d->threshold = 0;
     m_d->opacitySpread = 0;
     m_d->closeGap = 0;
+
+    m_d->maxNumThreads = KisImageConfig(true).maxNumberOfThreads();
 }
 
 KisScanlineFill::~KisScanlineFill()
@@ -352,6 +517,42 @@ QRect KisScanlineFill::fillExtent() const
     return m_d->fillExtent;
 }
 
+void KisScanlineFill::setParallelFillEnabled(bool value)
+{
+    m_d->parallelFillEnabled = value;
+}
+
+bool KisScanlineFill::parallelFillEnabled() const
+{
+    return m_d->parallelFillEnabled;
+}
+
+bool KisScanlineFill::canUseParallelFill(int gapSize) const
+{
+    /**
+     * The gap closing fill depends on the order in which the pixels are
+     * visited and KisGapMap is not thread-safe, so it always uses the
+     * serial algorithm.
+     */
+    if (!m_d->parallelFillEnabled || gapSize > 0 ||
+        !m_d->boundingRect.contains(m_d->startPoint)) {
+
+        return false;
+    }
+
+    if (m_d->parallelFillBandHeight > 0) return true;
+
+    /**
+     * The parallel fill has to scan at least one band of the fill area
+     * even when the filled region is tiny, so it pays off only on big
+     * areas.
+     */
+    static const qint64 minParallelFillArea = 2048 * 2048;
+
+    return m_d->maxNumThreads > 1 &&
+        qint64(m_d->boundingRect.width()) * m_d->boundingRect.height() >= minParallelFillArea;
+}
+
 
 /**
  * Used with the scanline fill algorithm.
@@ -630,6 +831,11 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
         gapSize = 0;
     }
 
+    if (canUseParallelFill(gapSize)) {
+        runParallelImpl(differencePolicy, selectionPolicy, pixelAccessPolicy);
+        return;
+    }
+
 #if MEASURE_FILL_TIME
     QElapsedTimer timerTotal;
     QElapsedTimer timerScanlineFill;
@@ -640,6 +846,8 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
     timerTotal.start();
 #endif
 
+    KisGapMapCache::SourceState gapMapSourceState;
+
     if (gapSize > 0) {
         // We need to reuse the complex policies used by this class and only provide the final
         // "projection" of opacity for the distance map calculation.
@@ -647,9 +855,28 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
             return fillOpacity(differencePolicy, selectionPolicy, pixelAccessPolicy, devicePtr, rect);
         };
 
+        // Reuse the gap map of a previous fill with the same parameters. If the source
+        // devices have changed since then, only the changed tiles are recalculated.
+        if (!m_d->gapMapCacheKey.isEmpty()) {
+            gapMapSourceState = KisGapMapCache::SourceState(m_d->device, m_d->gapMapBoundaryDevice);
+
+            bool sourceChanged = true;
+            m_d->gapMapSp = KisGapMapCache::instance()->take(m_d->gapMapCacheKey, gapSize,
+                                                             m_d->boundingRect, gapMapSourceState,
+                                                             &sourceChanged);
+            if (m_d->gapMapSp) {
+                m_d->gapMapSp->setFillOpacityFunc(opacityFunc);
+                if (sourceChanged) {
+                    m_d->gapMapSp->markTilesForRevalidation();
+                }
+            }
+        }
+
         // Prime the resources. The computations are made lazily, when distance at a pixel is requested.
         // Resources are freed automatically when the object is destroyed, that is together with the KisScanlineFill object.
-        m_d->gapMapSp = KisGapMapSP(new KisGapMap(gapSize, m_d->boundingRect, opacityFunc));
+        if (!m_d->gapMapSp) {
+            m_d->gapMapSp = KisGapMapSP(new KisGapMap(gapSize, m_d->boundingRect, opacityFunc));
+        }
     }
 
     m_d->fillExtent = QRect();
@@ -741,6 +968,333 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
 #endif
     qDebug() << "----------------------------------------";
 #endif
+
+    if (gapSize > 0 && !m_d->gapMapCacheKey.isEmpty()) {
+        // the callback refers to the policies on the stack of the caller
+        m_d->gapMapSp->setFillOpacityFunc(KisGapMap::FillOpacityFunc());
+        KisGapMapCache::instance()->store(m_d->gapMapCacheKey, gapMapSourceState, m_d->gapMapSp);
+        m_d->gapMapSp.clear();
+    }
+}
+
+template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+void KisScanlineFill::labelBand(FillBand *band,
+                                DifferencePolicy &differencePolicy,
+                                SelectionPolicy &selectionPolicy,
+                                PixelAccessPolicy &pixelAccessPolicy) const
+{
+    const QRect &rc = band->rect;
+    const int pixelSize = m_d->device->pixelSize();
+
+    band->intervals.clear();
+    band->rowOffsets.clear();
+    band->rowOffsets.reserve(rc.height() + 1);
+
+    // 1. Collect the fillable intervals of every row
+
+    for (int row = rc.top(); row <= rc.bottom(); row++) {
+        band->rowOffsets.append(band->intervals.size());
+
+        KisFillInterval currentInterval;
+
+        int numPixelsLeft = 0;
+        const quint8 *dataPtr = 0;
+
+        for (int x = rc.left(); x <= rc.right(); x++) {
+            if (numPixelsLeft <= 0) {
+                pixelAccessPolicy.m_srcIt->moveTo(x, row);
+                numPixelsLeft = pixelAccessPolicy.m_srcIt->numContiguousColumns(x) - 1;
+                dataPtr = pixelAccessPolicy.m_srcIt->rawDataConst();
+            } else {
+                numPixelsLeft--;
+                dataPtr += pixelSize;
+            }
+
+            const quint8 difference = differencePolicy.difference(dataPtr);
+            const quint8 opacity = selectionPolicy.opacityFromDifference(difference, x, row);
+
+            if (opacity) {
+                if (!currentInterval.isValid()) {
+                    currentInterval = KisFillInterval(x, x, row);
+                } else {
+                    currentInterval.end = x;
+                }
+            } else if (currentInterval.isValid()) {
+                band->intervals.append(currentInterval);
+                currentInterval.invalidate();
+            }
+        }
+
+        if (currentInterval.isValid()) {
+            band->intervals.append(currentInterval);
+        }
+    }
+
+    band->rowOffsets.append(band->intervals.size());
+
+    // 2. Unite the intervals connected inside the band
+
+    band->parents.resize(band->intervals.size());
+    for (int i = 0; i < band->parents.size(); i++) {
+        band->parents[i] = i;
+    }
+
+    for (int row = rc.top() + 1; row <= rc.bottom(); row++) {
+        uniteAdjacentRows(band->intervals, band->rowBegin(row - 1), band->rowEnd(row - 1),
+                          band->intervals, band->rowBegin(row), band->rowEnd(row),
+                          [band] (int i, int j) {
+                              uniteRoots(band->parents, i, j);
+                          });
+    }
+
+    for (int i = 0; i < band->parents.size(); i++) {
+        band->parents[i] = findRoot(band->parents, i);
+    }
+
+    band->isLabeled = true;
+}
+
+template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+void KisScanlineFill::fillBand(FillBand *band, const QVector<int> &globalParents, int seedRoot,
+                               DifferencePolicy &differencePolicy,
+                               SelectionPolicy &selectionPolicy,
+                               PixelAccessPolicy &pixelAccessPolicy) const
+{
+    const int pixelSize = m_d->device->pixelSize();
+
+    band->fillExtent = QRect();
+
+    for (int i = 0; i < band->intervals.size(); i++) {
+        if (globalParents[band->firstIntervalIndex + i] != seedRoot) continue;
+
+        const KisFillInterval &interval = band->intervals[i];
+
+        int numPixelsLeft = 0;
+        quint8 *dataPtr = 0;
+
+        for (int x = interval.start; x <= interval.end; x++) {
+            if (numPixelsLeft <= 0) {
+                pixelAccessPolicy.m_srcIt->moveTo(x, interval.row);
+                numPixelsLeft = pixelAccessPolicy.m_srcIt->numContiguousColumns(x) - 1;
+                dataPtr = const_cast<quint8*>(pixelAccessPolicy.m_srcIt->rawDataConst());
+            } else {
+                numPixelsLeft--;
+                dataPtr += pixelSize;
+            }
+
+            const quint8 difference = differencePolicy.difference(dataPtr);
+            const quint8 opacity = selectionPolicy.opacityFromDifference(difference, x, interval.row);
+
+            pixelAccessPolicy.fillPixel(dataPtr, opacity, x, interval.row);
+        }
+
+        band->fillExtent |= QRect(interval.start, interval.row, interval.width(), 1);
+    }
+}
+
+/**
+ * The parallel version of the fill works in three stages:
+ *
+ * 1) The fill area is split into horizontal bands. In every band all the
+ *    fillable intervals are found and united into connected components.
+ *    The bands are labeled concurrently.
+ *
+ * 2) The components are merged on the seams of the bands, which gives
+ *    the global components of the whole area.
+ *
+ * 3) The intervals of the component containing the seed point are filled,
+ *    again concurrently.
+ *
+ * The serial fill fills exactly the 4-connected component of the seed
+ * point, so the results of both the algorithms are identical.
+ *
+ * To avoid scanning the whole area when the filled region is small, the
+ * band containing the seed point is labeled first and the rest of the
+ * bands are labeled only if the region touches the seams of that band.
+ */
+template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+void KisScanlineFill::runParallelImpl(DifferencePolicy &differencePolicy,
+                                      SelectionPolicy &selectionPolicy,
+                                      PixelAccessPolicy &pixelAccessPolicy)
+{
+    const QRect &rc = m_d->boundingRect;
+    const int numThreads = qMax(1, m_d->maxNumThreads);
+
+    m_d->fillExtent = QRect();
+
+    // split the area into bands aligned to the tiles
+
+    static const int tileSize = 64;
+    int bandHeight = m_d->parallelFillBandHeight;
+    bool alignBands = false;
+
+    if (bandHeight <= 0) {
+        const int numBands = 4 * numThreads;
+        bandHeight = qMax(tileSize, (rc.height() / numBands + tileSize - 1) / tileSize * tileSize);
+        alignBands = true;
+    }
+
+    QVector<FillBand> bands;
+    int seedBandIndex = -1;
+
+    for (int y = rc.top(); y <= rc.bottom();) {
+        int nextY = y + bandHeight;
+
+        if (alignBands) {
+            const int alignedY = nextY >> 6 << 6;
+            if (alignedY > y) {
+                nextY = alignedY;
+            }
+        }
+
+        nextY = qMin(nextY, rc.bottom() + 1);
+
+        FillBand band;
+        band.rect = QRect(rc.left(), y, rc.width(), nextY - y);
+
+        if (band.rect.contains(m_d->startPoint)) {
+            seedBandIndex = bands.size();
+        }
+
+        bands.append(band);
+        y = nextY;
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(seedBandIndex >= 0);
+
+    QVector<int> globalParents;
+
+    auto addLabeledBands = [&] (const QVector<int> &newBands) {
+        Q_FOREACH (int index, newBands) {
+            FillBand &band = bands[index];
+            band.firstIntervalIndex = globalParents.size();
+
+            for (int i = 0; i < band.parents.size(); i++) {
+                globalParents.append(band.firstIntervalIndex + band.parents[i]);
+            }
+        }
+
+        // merge the components on the seams of the newly labeled bands
+        for (int index = 0; index < bands.size() - 1; index++) {
+            FillBand &upper = bands[index];
+            FillBand &lower = bands[index + 1];
+
+            if (!upper.isLabeled || !lower.isLabeled ||
+                (!newBands.contains(index) && !newBands.contains(index + 1))) {
+
+                continue;
+            }
+
+            const int upperRow = upper.rect.bottom();
+            const int lowerRow = lower.rect.top();
+
+            uniteAdjacentRows(upper.intervals, upper.rowBegin(upperRow), upper.rowEnd(upperRow),
+                              lower.intervals, lower.rowBegin(lowerRow), lower.rowEnd(lowerRow),
+                              [&] (int i, int j) {
+                                  uniteRoots(globalParents,
+                                             upper.firstIntervalIndex + i,
+                                             lower.firstIntervalIndex + j);
+                              });
+        }
+    };
+
+    auto seedComponentTouchesRow = [&] (const FillBand &band, int row, int seedRoot) {
+        for (int i = band.rowBegin(row); i < band.rowEnd(row); i++) {
+            if (findRoot(globalParents, band.firstIntervalIndex + i) == seedRoot) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // 1. Label the band of the seed point
+
+    labelBand(&bands[seedBandIndex], differencePolicy, selectionPolicy, pixelAccessPolicy);
+    addLabeledBands({seedBandIndex});
+
+    int seedIndex = -1;
+    {
+        const FillBand &band = bands[seedBandIndex];
+        const int row = m_d->startPoint.y();
+
+        for (int i = band.rowBegin(row); i < band.rowEnd(row); i++) {
+            const KisFillInterval &interval = band.intervals[i];
+            if (interval.start <= m_d->startPoint.x() && m_d->startPoint.x() <= interval.end) {
+                seedIndex = band.firstIntervalIndex + i;
+                break;
+            }
+        }
+    }
+
+    // the seed pixel itself is not fillable
+    if (seedIndex < 0) return;
+
+    // 2. Label the rest of the bands if the region can spread into them
+
+    {
+        const FillBand &band = bands[seedBandIndex];
+        const int seedRoot = findRoot(globalParents, seedIndex);
+
+        const bool needsMoreBands =
+            (seedBandIndex > 0 &&
+             seedComponentTouchesRow(band, band.rect.top(), seedRoot)) ||
+            (seedBandIndex < bands.size() - 1 &&
+             seedComponentTouchesRow(band, band.rect.bottom(), seedRoot));
+
+        if (needsMoreBands) {
+            QVector<int> newBands;
+
+            QThreadPool threadPool;
+            threadPool.setMaxThreadCount(numThreads);
+
+            for (int index = 0; index < bands.size(); index++) {
+                if (bands[index].isLabeled) continue;
+
+                newBands.append(index);
+
+                FillBand *bandPtr = &bands[index];
+                threadPool.start(QRunnable::create(
+                    [this, bandPtr, differencePolicy, selectionPolicy, pixelAccessPolicy] () mutable {
+                        labelBand(bandPtr, differencePolicy, selectionPolicy, pixelAccessPolicy);
+                    }));
+            }
+
+            threadPool.waitForDone();
+
+            addLabeledBands(newBands);
+        }
+    }
+
+    // 3. Fill the component of the seed point
+
+    for (int i = 0; i < globalParents.size(); i++) {
+        globalParents[i] = findRoot(globalParents, i);
+    }
+
+    const int seedRoot = globalParents[seedIndex];
+
+    {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
+
+        for (int index = 0; index < bands.size(); index++) {
+            if (!bands[index].isLabeled) continue;
+
+            FillBand *bandPtr = &bands[index];
+            const QVector<int> *parentsPtr = &globalParents;
+
+            threadPool.start(QRunnable::create(
+                [this, bandPtr, parentsPtr, seedRoot, differencePolicy, selectionPolicy, pixelAccessPolicy] () mutable {
+                    fillBand(bandPtr, *parentsPtr, seedRoot, differencePolicy, selectionPolicy, pixelAccessPolicy);
+                }));
+        }
+
+        threadPool.waitForDone();
+    }
+
+    Q_FOREACH (const FillBand &band, bands) {
+        m_d->fillExtent |= band.fillExtent;
+    }
 }
 
 template <template <typename SrcPixelType> typename OptimizedDifferencePolicy,
@@ -842,6 +1396,8 @@ void KisScanlineFill::fillSelection(KisPixelSelectionSP pixelSelection, KisPaint
 
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelection", srcColor, softness, boundarySelection);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -869,6 +1425,8 @@ void KisScanlineFill::fillSelection(KisPixelSelectionSP pixelSelection)
     
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelection", srcColor, softness, nullptr);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -895,6 +1453,8 @@ void KisScanlineFill::fillSelectionUntilColor(KisPixelSelectionSP pixelSelection
     
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelectionUntilColor", srcColor, softness, boundarySelection);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -923,6 +1483,8 @@ void KisScanlineFill::fillSelectionUntilColor(KisPixelSelectionSP pixelSelection
     
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelectionUntilColor", srcColor, softness, nullptr);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -951,6 +1513,8 @@ void KisScanlineFill::fillSelectionUntilColorOrTransparent(KisPixelSelectionSP p
     
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelectionUntilColorOrTransparent", srcColor, softness, boundarySelection);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -981,6 +1545,8 @@ void KisScanlineFill::fillSelectionUntilColorOrTransparent(KisPixelSelectionSP p
     
     CopyToSelectionPixelAccessPolicy pap(m_d->device, pixelSelection);
 
+    m_d->setupGapMapCacheKey("fillSelectionUntilColorOrTransparent", srcColor, softness, nullptr);
+
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
     }
@@ -1123,6 +1689,11 @@ void KisScanlineFill::testingProcessLine(const KisFillInterval &processInterval)
     processLine(processInterval, 1, dp, sp, pap);
 }
 
+void KisScanlineFill::testingSetParallelFillBandHeight(int value)
+{
+    m_d->parallelFillBandHeight = value;
+}
+
 QVector<KisFillInterval> KisScanlineFill::testingGetForwardIntervals() const
 {
     return QVector<KisFillInterval>(m_d->forwardStack);
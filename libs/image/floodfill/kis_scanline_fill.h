@@ -137,6 +137,15 @@ public:
      */
     QRect fillExtent() const;
 
+    /**
+     * Allow filling big areas using multiple threads. The area is split
+     * into horizontal bands, which are processed concurrently, the result
+     * is exactly the same as of the serial fill. The parallel fill is not
+     * used for gap closing fills. Enabled by default.
+     */
+    void setParallelFillEnabled(bool value);
+    bool parallelFillEnabled() const;
+
 private:
     friend class KisScanlineFillTest;
     Q_DISABLE_COPY(KisScanlineFill)
@@ -179,8 +188,30 @@ private:
 
     inline bool tryPushingCloseGapSeed(int x, int y, bool allowExpand);
 
+    struct FillBand;
+
+    bool canUseParallelFill(int gapSize) const;
+
+    template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+    void runParallelImpl(DifferencePolicy &differencePolicy,
+                         SelectionPolicy &selectionPolicy,
+                         PixelAccessPolicy &pixelAccessPolicy);
+
+    template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+    void labelBand(FillBand *band,
+                   DifferencePolicy &differencePolicy,
+                   SelectionPolicy &selectionPolicy,
+                   PixelAccessPolicy &pixelAccessPolicy) const;
+
+    template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+    void fillBand(FillBand *band, const QVector<int> &globalParents, int seedRoot,
+                  DifferencePolicy &differencePolicy,
+                  SelectionPolicy &selectionPolicy,
+                  PixelAccessPolicy &pixelAccessPolicy) const;
+
 private:
     void testingProcessLine(const KisFillInterval &processInterval);
+    void testingSetParallelFillBandHeight(int value);
     QVector<KisFillInterval> testingGetForwardIntervals() const;
     KisFillIntervalMap* testingGetBackwardIntervals() const;
 private:
@@ -175,6 +175,18 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
     const bool useTempProjections = walker.needRectVaries();
 
+    /**
+     * Ask the tile engine to bring the swapped-out parts of the
+     * involved projections back into memory while we are busy
+     * merging the topmost leaves. It is a no-op when nothing is
+     * swapped out.
+     */
+    Q_FOREACH (const KisMergeWalker::JobItem &item, leafStack) {
+        if (item.m_leaf && item.m_leaf->projection()) {
+            item.m_leaf->projection()->prefetchRect(item.m_applyRect);
+        }
+    }
+
     while(!leafStack.isEmpty()) {
         KisMergeWalker::JobItem item = leafStack.pop();
         KisProjectionLeafSP currentLeaf = item.m_leaf;
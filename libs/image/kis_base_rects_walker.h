@@ -8,6 +8,7 @@
 #define __KIS_BASE_RECTS_WALKER_H
 
 #include <QStack>
+#include <QHash>
 
 #include "kis_layer.h"
 
@@ -106,6 +107,12 @@ public:
 
     typedef QStack<JobItem> LeafStack;
 
+    /**
+     * The area of every node accessed by the walker, see
+     * nodeAccessRects()
+     */
+    typedef QHash<const KisNode*, QRect> NodeAccessRects;
+
     enum SubtreeVisitFlag {
         None = 0x0,
         SkipNonRenderableNodes = 0x1,
@@ -138,6 +145,7 @@ public:
         m_levelOfDetail = getNodeLevelOfDetail(startLeaf);
         startTrip(startLeaf);
         addCloneSourceRegenerationJobs();
+        collectNodeAccessRects();
     }
 
     inline void recalculate(const QRect& requestedRect) {
@@ -210,6 +218,26 @@ public:
         return m_resultChangeRect;
     }
 
+    /**
+     * Splits accessRect() into per-node parts: for every node
+     * touched by the merge task the map contains the rect that the
+     * walker may read or write on this node. Two walkers may run
+     * concurrently if their rects don't intersect on any common node,
+     * even when their total access rects do.
+     *
+     * The map is valid only when hasUntrackedAccess() is false. Some
+     * layers (e.g. clone layers) read the devices of the nodes which
+     * are not present in the merge task, so the walker should be
+     * checked with the total accessRect() in such a case.
+     */
+    inline const NodeAccessRects& nodeAccessRects() const {
+        return m_nodeAccessRects;
+    }
+
+    inline bool hasUntrackedAccess() const {
+        return m_hasUntrackedAccess;
+    }
+
     inline QRect uncroppedChangeRect() const {
         return m_resultUncroppedChangeRect;
     }
@@ -278,12 +306,58 @@ protected:
         m_needRectVaries = m_changeRectVaries = false;
         m_mergeTask.clear();
         m_cloneNotifications.clear();
+        m_nodeAccessRects.clear();
+        m_hasUntrackedAccess = false;
 
         // Not needed really. Think over removing.
         //m_startNode = 0;
         //m_requestedRect = QRect();
     }
 
+    void collectNodeAccessRects() {
+        m_nodeAccessRects.clear();
+        m_hasUntrackedAccess = false;
+
+        Q_FOREACH (const JobItem &item, m_mergeTask) {
+            KisProjectionLeafSP leaf = item.m_leaf;
+            const QRect &applyRect = item.m_applyRect;
+            if (applyRect.isEmpty()) continue;
+
+            /**
+             * Clone layers read the projection of their source, which
+             * is not necessarily a part of the merge task
+             */
+            if (leaf->node()->inherits("KisCloneLayer")) {
+                m_hasUntrackedAccess = true;
+            }
+
+            const KisNode::PositionToFilthy pos = convertPositionToFilthy(item.m_position);
+            KisAbstractProjectionPlaneSP plane = leaf->projectionPlane();
+
+            const QRect needRect = plane->needRect(applyRect, pos);
+
+            m_nodeAccessRects[leaf->node().data()] |=
+                applyRect |
+                needRect |
+                plane->changeRect(applyRect, pos) |
+                plane->accessRect(applyRect, pos);
+
+            /**
+             * The leaf is composited into the projection of its parent,
+             * and pass-through groups forward it even further, so just
+             * mark the whole chain of the parents. The layers depending
+             * on the lower nodes also read the parent's projection in
+             * the need rect.
+             */
+            const QRect parentRect =
+                leaf->dependsOnLowerNodes() ? applyRect | needRect : applyRect;
+
+            for (KisProjectionLeafSP parent = leaf->parent(); parent; parent = parent->parent()) {
+                m_nodeAccessRects[parent->node().data()] |= parentRect;
+            }
+        }
+    }
+
     inline void pushJob(KisProjectionLeafSP leaf, NodePosition position, QRect applyRect, KisRenderPassFlags flags) {
         JobItem item = {leaf, position, applyRect, flags};
         m_mergeTask.push(item);
@@ -505,6 +579,8 @@ private:
     bool m_changeRectVaries {false};
     LeafStack m_mergeTask;
     CloneNotificationsVector m_cloneNotifications;
+    NodeAccessRects m_nodeAccessRects;
+    bool m_hasUntrackedAccess {false};
 
     /**
      * Used by update optimization framework
@@ -9,11 +9,13 @@
 #define KIS_CONVOLUTION_WORKER_FFT_H
 
 #include <iostream>
+#include <cmath>
 
 #include <KoChannelInfo.h>
 
 #include "kis_convolution_worker.h"
 #include "kis_math_toolbox.h"
+#include "KisFFTWPlanCache.h"
 
 #include <QMutex>
 #include <QVector>
@@ -47,6 +49,7 @@ public:
 
     ~KisConvolutionWorkerFFT()
     {
+        cleanUp();
     }
 
     void execute(const KisConvolutionKernelSP kernel,
@@ -74,88 +77,40 @@ public:
         const quint32 halfKernelWidth = (kernel->width() - 1) / 2;
         const quint32 halfKernelHeight = (kernel->height() - 1) / 2;
 
-        m_fftWidth = areaSize.width() + 4 * halfKernelWidth;
-        m_fftHeight = areaSize.height() + 2 * halfKernelHeight;
-
-        /**
-         * FIXME: check whether this "optimization" is needed to
-         * be uncommented. My tests showed about 30% better performance
-         * when the line is commented out (DK).
-         */
-        //optimumDimensions(m_fftWidth, m_fftHeight);
-
-        m_fftLength = m_fftHeight * (m_fftWidth / 2 + 1);
-        m_extraMem = (m_fftWidth % 2) ? 1 : 2;
-
-        // create and fill kernel
-        m_kernelFFT = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
-        memset(m_kernelFFT, 0, sizeof(fftw_complex) * m_fftLength);
-        fftFillKernelMatrix(kernel, m_kernelFFT);
-
         // find out which channels need convolving
         QList<KoChannelInfo*> convChannelList = this->convolvableChannelList(src);
 
-        m_channelFFT.resize(convChannelList.count());
-        for (auto i = m_channelFFT.begin(); i != m_channelFFT.end(); ++i) {
-            *i = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
-        }
-
-        const double kernelFactor = kernel->factor() ? kernel->factor() : 1;
-        const double fftScale = 1.0 / (m_fftHeight * m_fftWidth) / kernelFactor;
-
-        FFTInfo info (fftScale, convChannelList, kernel, this->m_painter->device()->colorSpace());
-        int cacheRowStride = m_fftWidth + m_extraMem;
-
-        fillCacheFromDevice(src,
-                            QRect(srcPos.x() - halfKernelWidth,
-                                  srcPos.y() - halfKernelHeight,
-                                  m_fftWidth,
-                                  m_fftHeight),
-                            cacheRowStride,
-                            info, dataRect);
-
-        addToProgress(10);
-        if (isInterrupted()) return;
-
-        // calculate number off fft operations required for progress reporting
-        const float progressPerFFT = (100 - 30) / (double)(convChannelList.count() * 2 + 1);
-
-        // perform FFT
-        fftw_plan fftwPlanForward, fftwPlanBackward;
-
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftwPlanForward = fftw_plan_dft_r2c_2d(m_fftHeight, m_fftWidth, (double*)m_kernelFFT, m_kernelFFT, FFTW_ESTIMATE);
-        fftwPlanBackward = fftw_plan_dft_c2r_2d(m_fftHeight, m_fftWidth, m_kernelFFT, (double*)m_kernelFFT, FFTW_ESTIMATE);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
+        FFTInfo info (0.0, convChannelList, kernel, this->m_painter->device()->colorSpace());
 
-        fftw_execute(fftwPlanForward);
-        addToProgress(progressPerFFT);
-        if (isInterrupted()) return;
+        /**
+         * The FFT buffers take 16 bytes per pixel per channel, so big
+         * areas are split into tiles, which are convolved separately.
+         * Every tile reads its own kernel margins from the source device,
+         * so the result doesn't depend on the tiling. The last row and
+         * column of tiles may be cut by the area, but they are still
+         * transformed with the full tile size, and only the part inside
+         * the area is written back. So all the tiles share the plans and
+         * the transformed kernel.
+         */
+        const QSize tileSize = calculateTileSize(areaSize, halfKernelWidth, halfKernelHeight, convChannelList.count());
+        const int numTilesX = (areaSize.width() + tileSize.width() - 1) / tileSize.width();
+        const int numTilesY = (areaSize.height() + tileSize.height() - 1) / tileSize.height();
 
-        for (auto k = m_channelFFT.begin(); k != m_channelFFT.end(); ++k)
-        {
-            fftw_execute_dft_r2c(fftwPlanForward, (double*)(*k), *k);
-            addToProgress(progressPerFFT);
-            if (isInterrupted()) return;
+        m_progressScale = 1.0 / (numTilesX * numTilesY);
 
-            fftMultiply(*k, m_kernelFFT);
+        for (int y = 0; y < areaSize.height(); y += tileSize.height()) {
+            for (int x = 0; x < areaSize.width(); x += tileSize.width()) {
+                const QPoint offset(x, y);
+                const QSize writeSize(qMin(tileSize.width(), areaSize.width() - x),
+                                      qMin(tileSize.height(), areaSize.height() - y));
 
-            fftw_execute_dft_c2r(fftwPlanBackward, *k, (double*)*k);
-            addToProgress(progressPerFFT);
-            if (isInterrupted()) return;
+                if (!processTile(kernel, src, srcPos + offset, dstPos + offset,
+                                 tileSize, writeSize, info, dataRect)) {
+                    return;
+                }
+            }
         }
 
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftw_destroy_plan(fftwPlanForward);
-        fftw_destroy_plan(fftwPlanBackward);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
-
-
-        writeResultToDevice(QRect(dstPos.x(), dstPos.y(), areaSize.width(), areaSize.height()),
-                            cacheRowStride, halfKernelWidth, halfKernelHeight,
-                            info, dataRect);
-
-        addToProgress(20);
         cleanUp();
     }
 
@@ -412,6 +367,138 @@ public:
     }
 
 private:
+    QSize calculateTileSize(const QSize &areaSize,
+                            const quint32 halfKernelWidth,
+                            const quint32 halfKernelHeight,
+                            const int numChannels) const
+    {
+        const qint64 maxMemory = KisFFTWPlanCache::instance()->maxTransformMemory();
+
+        // the channels and the kernel
+        auto memoryUsage = [=] (int width, int height) {
+            const qint64 fftWidth = width + 4 * halfKernelWidth;
+            const qint64 fftHeight = height + 2 * halfKernelHeight;
+
+            return (numChannels + 1) * fftHeight * (fftWidth / 2 + 1) * qint64(sizeof(fftw_complex));
+        };
+
+        if (memoryUsage(areaSize.width(), areaSize.height()) <= maxMemory) {
+            return areaSize;
+        }
+
+        const int minTileSize = 64;
+
+        int tileSize = qMax(minTileSize,
+                            int(std::sqrt(qreal(maxMemory) / ((numChannels + 1) * sizeof(fftw_complex) / 2))));
+
+        while (tileSize > minTileSize && memoryUsage(tileSize, tileSize) > maxMemory) {
+            tileSize = qMax(minTileSize, tileSize * 7 / 8);
+        }
+
+        // distribute the area evenly between the tiles
+        const int numTilesX = (areaSize.width() + tileSize - 1) / tileSize;
+        const int numTilesY = (areaSize.height() + tileSize - 1) / tileSize;
+
+        return QSize((areaSize.width() + numTilesX - 1) / numTilesX,
+                     (areaSize.height() + numTilesY - 1) / numTilesY);
+    }
+
+    bool processTile(const KisConvolutionKernelSP kernel,
+                     const KisPaintDeviceSP src,
+                     const QPoint &srcPos,
+                     const QPoint &dstPos,
+                     const QSize &tileSize,
+                     const QSize &writeSize,
+                     FFTInfo &info,
+                     const QRect &dataRect)
+    {
+        const quint32 halfKernelWidth = (kernel->width() - 1) / 2;
+        const quint32 halfKernelHeight = (kernel->height() - 1) / 2;
+
+        const quint32 fftWidth = tileSize.width() + 4 * halfKernelWidth;
+        const quint32 fftHeight = tileSize.height() + 2 * halfKernelHeight;
+
+        // calculate number off fft operations required for progress reporting
+        const float progressPerFFT = (100 - 30) / (double)(info.numChannels() * 2 + 1);
+
+        /**
+         * FIXME: check whether this "optimization" is needed to
+         * be uncommented. My tests showed about 30% better performance
+         * when the line is commented out (DK).
+         */
+        //optimumDimensions(fftWidth, fftHeight);
+
+        if (fftWidth != m_fftWidth || fftHeight != m_fftHeight) {
+            cleanUp();
+
+            m_fftWidth = fftWidth;
+            m_fftHeight = fftHeight;
+            m_fftLength = m_fftHeight * (m_fftWidth / 2 + 1);
+            m_extraMem = (m_fftWidth % 2) ? 1 : 2;
+
+            KisFFTWPlanCache *planCache = KisFFTWPlanCache::instance();
+            m_planForward = planCache->plan(m_fftWidth, m_fftHeight, KisFFTWPlanCache::RealToComplex);
+            m_planBackward = planCache->plan(m_fftWidth, m_fftHeight, KisFFTWPlanCache::ComplexToReal);
+
+            KIS_SAFE_ASSERT_RECOVER(m_planForward && m_planBackward) {
+                cleanUp();
+                return false;
+            }
+
+            // create and fill kernel
+            m_kernelFFT = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
+            memset(m_kernelFFT, 0, sizeof(fftw_complex) * m_fftLength);
+            fftFillKernelMatrix(kernel, m_kernelFFT);
+
+            m_channelFFT.resize(info.numChannels());
+            for (auto i = m_channelFFT.begin(); i != m_channelFFT.end(); ++i) {
+                *i = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
+            }
+
+            fftw_execute_dft_r2c(m_planForward->handle(), (double*)m_kernelFFT, m_kernelFFT);
+        }
+
+        addToProgress(progressPerFFT);
+        if (isInterrupted()) return false;
+
+        const double kernelFactor = kernel->factor() ? kernel->factor() : 1;
+        info.fftScale = 1.0 / (m_fftHeight * m_fftWidth) / kernelFactor;
+
+        int cacheRowStride = m_fftWidth + m_extraMem;
+
+        fillCacheFromDevice(src,
+                            QRect(srcPos.x() - halfKernelWidth,
+                                  srcPos.y() - halfKernelHeight,
+                                  m_fftWidth,
+                                  m_fftHeight),
+                            cacheRowStride,
+                            info, dataRect);
+
+        addToProgress(10);
+        if (isInterrupted()) return false;
+
+        for (auto k = m_channelFFT.begin(); k != m_channelFFT.end(); ++k)
+        {
+            fftw_execute_dft_r2c(m_planForward->handle(), (double*)(*k), *k);
+            addToProgress(progressPerFFT);
+            if (isInterrupted()) return false;
+
+            fftMultiply(*k, m_kernelFFT);
+
+            fftw_execute_dft_c2r(m_planBackward->handle(), *k, (double*)*k);
+            addToProgress(progressPerFFT);
+            if (isInterrupted()) return false;
+        }
+
+        writeResultToDevice(QRect(dstPos, writeSize),
+                            cacheRowStride, halfKernelWidth, halfKernelHeight,
+                            info, dataRect);
+
+        addToProgress(20);
+
+        return true;
+    }
+
     void fftFillKernelMatrix(const KisConvolutionKernelSP kernel, fftw_complex *m_kernelFFT)
     {
         // find central item
@@ -514,7 +601,7 @@ private:
 
     void addToProgress(float amount)
     {
-        m_currentProgress += amount;
+        m_currentProgress += amount * m_progressScale;
 
         if (this->m_progress) {
             this->m_progress->setProgress((int)m_currentProgress);
@@ -536,12 +623,20 @@ private:
         // free kernel fft data
         if (m_kernelFFT) {
             fftw_free(m_kernelFFT);
+            m_kernelFFT = 0;
         }
 
         Q_FOREACH (fftw_complex *channel, m_channelFFT) {
             fftw_free(channel);
         }
         m_channelFFT.clear();
+
+        m_planForward.clear();
+        m_planBackward.clear();
+
+        m_fftWidth = 0;
+        m_fftHeight = 0;
+        m_fftLength = 0;
     }
 private:
     quint32 m_fftWidth {0};
@@ -549,9 +644,13 @@ private:
     quint32 m_fftLength {0};
     quint32 m_extraMem {0};
     float m_currentProgress {0.0};
+    float m_progressScale {1.0};
 
     fftw_complex* m_kernelFFT {0};
     QVector<fftw_complex*> m_channelFFT;
+
+    KisFFTWPlanCache::PlanSP m_planForward;
+    KisFFTWPlanCache::PlanSP m_planBackward;
 };
 
 #endif
@@ -14,6 +14,10 @@
 
 #include <KoColorSpace.h>
 #include <KoMixColorsOp.h>
+#include <KoRgbaWeightedMixerFactory.h>
+
+#include <QScopedPointer>
+#include <vector>
 
 
 namespace tmp {
@@ -106,6 +110,13 @@ public:
           m_dx(dx),
           m_clampToEdge(clampToEdge)
     {
+        /**
+         * RGBA pixels are mixed by a vectorized mixer, other color
+         * spaces use their own mixing op
+         */
+        if (m_src) {
+            m_rgbaMixer.reset(KoRgbaWeightedMixerFactory::create(m_src->colorSpace()));
+        }
     }
 
     struct BlendSpan {
@@ -234,7 +245,10 @@ public:
         const KoColor defaultPixelObject = m_src->defaultPixel();
         const quint8 *defaultPixel = defaultPixelObject.data();
         const quint8 *borderPixel = defaultPixel;
-        quint8 *srcLineBuf = new quint8[pixelSize * (rightSrcBorder - leftSrcBorder)];
+
+        // the buffer is reused by all the lines processed by this applicator
+        m_srcLineBuf.resize(pixelSize * (rightSrcBorder - leftSrcBorder));
+        quint8 *srcLineBuf = m_srcLineBuf.data();
 
         int i = leftSrcBorder;
         quint8 *bufPtr = srcLineBuf;
@@ -264,27 +278,30 @@ public:
             memcpy(bufPtr, borderPixel, pixelSize);
         }
 
-        const quint8 **colors = new const quint8* [buffer->maxSpan()];
-
         T dstIt = tmp::createIterator<T>(m_dst, dstStart, line, dstEnd - dstStart);
         for (int i = dstStart; i < dstEnd; i++) {
             BlendSpan span = calculateBlendSpan(i, line, buffer);
 
             int bufIndexStart = span.firstBlendPixel - leftSrcBorder;
-            int bufIndexEnd = bufIndexStart + span.weights->span;
 
-            const quint8 **colorsPtr = colors;
-            for (int j = bufIndexStart; j < bufIndexEnd; j++) {
-                *(colorsPtr++) = srcLineBuf + j * pixelSize;
+            /**
+             * The source pixels of the span are stored contiguously in the
+             * line buffer, so we can use the array version of the mixing op.
+             * It avoids building the array of pointers for every single pixel
+             * and lets the compiler vectorize the accumulation loop.
+             */
+            if (m_rgbaMixer) {
+                m_rgbaMixer->mixColors(srcLineBuf + bufIndexStart * pixelSize,
+                                       span.weights->weight, span.weights->span,
+                                       dstIt->rawData());
+            } else {
+                mixOp->mixColors(srcLineBuf + bufIndexStart * pixelSize,
+                                 span.weights->weight, span.weights->span,
+                                 dstIt->rawData());
             }
-
-            mixOp->mixColors(colors, span.weights->weight, span.weights->span, dstIt->rawData());
             dstIt->nextPixel();
         }
 
-        delete[] colors;
-        delete[] srcLineBuf;
-
         return LinePos(dstStart, qMax(0, dstEnd - dstStart));
     }
 
@@ -334,6 +351,9 @@ private:
     qreal m_shear;
     qreal m_dx;
     bool m_clampToEdge;
+
+    std::vector<quint8> m_srcLineBuf;
+    QScopedPointer<KoRgbaWeightedMixerBase> m_rgbaMixer;
 };
 
 #endif /* __KIS_FILTER_WEIGHTS_APPLICATOR_H */
@@ -12,6 +12,8 @@
 #include <kis_transaction.h>
 #include <QRect>
 
+#include "KisRecursiveGaussianBlur.h"
+
 
 qreal KisGaussianKernel::sigmaFromRadius(qreal radius)
 {
@@ -109,8 +111,18 @@ void KisGaussianKernel::applyGaussian(KisPaintDeviceSP device,
 {
     QPoint srcTopLeft = rect.topLeft();
 
+    /**
+     * For big radii the recursive approximation is much faster than
+     * any convolution and its error is not visible. It reads all the
+     * source pixels before writing them, so it needs no transaction.
+     */
+    if (KisRecursiveGaussianBlur::isApplicable(xRadius, yRadius)) {
+        KisRecursiveGaussianBlur blur(xRadius, yRadius);
+        blur.setChannelFlags(channelFlags);
+        blur.setProgress(progressUpdater);
+        blur.apply(device, rect, borderOp);
 
-    if (KisConvolutionPainter::supportsFFTW()) {
+    } else if (KisConvolutionPainter::supportsFFTW()) {
         KisConvolutionPainter painter(device, KisConvolutionPainter::FFTW);
         painter.setChannelFlags(channelFlags);
         painter.setProgress(progressUpdater);
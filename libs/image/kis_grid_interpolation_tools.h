@@ -51,6 +51,30 @@ inline QSize calcGridSize(const QRect &srcBounds, const int pixelPrecision) {
                  calcGridDimension(srcBounds.y(), srcBounds.bottom(), pixelPrecision));
 }
 
+/**
+ * Returns the positions of the grid lines processGrid() walks through
+ * between \p start and \p end (inclusive)
+ */
+inline QVector<int> calcGridLinePositions(int start, int end, const int pixelPrecision)
+{
+    const int alignmentMask = ~(pixelPrecision - 1);
+
+    QVector<int> positions;
+
+    for (int pos = start; pos <= end;) {
+        positions << pos;
+        pos += pixelPrecision;
+
+        if (pos > end && pos <= end + pixelPrecision - 1) {
+            pos = end;
+        } else {
+            pos &= alignmentMask;
+        }
+    }
+
+    return positions;
+}
+
 template <class ProcessPolygon, class ForwardTransform>
 struct CellOp
 {
@@ -173,6 +197,9 @@ struct PaintDevicePolygonOp
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
         QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+        if (!m_dstClipRect.isNull()) {
+            boundRect &= m_dstClipRect;
+        }
         if (boundRect.isEmpty()) return;
 
         KisSequentialIterator dstIt(m_dstDev, boundRect);
@@ -232,6 +259,12 @@ struct PaintDevicePolygonOp
 
     KisPaintDeviceSP m_srcDev;
     KisPaintDeviceSP m_dstDev;
+
+    /**
+     * If set, only the pixels inside this rect are written. It lets
+     * several ops render disjoint parts of the same polygons concurrently.
+     */
+    QRect m_dstClipRect;
 };
 
 struct QImagePolygonOp
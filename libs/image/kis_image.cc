@@ -99,6 +99,7 @@
 #include "KisBusyWaitBroker.h"
 #include <KisStaticInitializer.h>
 #include "KisImageGlobalSelectionManagementInterface.h"
+#include "floodfill/kis_gap_map_cache.h"
 
 
 // #define SANITY_CHECKS
@@ -334,6 +335,12 @@ KisImage::~KisImage()
      */
     waitForDone();
 
+    /**
+     * The cached gap maps are as big as the image, don't keep
+     * them after the image is closed
+     */
+    KisGapMapCache::instance()->clear();
+
     delete m_d;
     disconnect(); // in case Qt gets confused
 }
@@ -2557,6 +2564,16 @@ KisLodPreferences KisImage::lodPreferences() const
     return m_d->scheduler.lodPreferences();
 }
 
+void KisImage::setProjectionUpdatesPriorityPoint(const QPointF &imagePoint)
+{
+    m_d->scheduler.setUpdatesPriorityPoint(imagePoint);
+}
+
+void KisImage::resetProjectionUpdatesPriorityPoint()
+{
+    m_d->scheduler.resetUpdatesPriorityPoint();
+}
+
 void KisImage::nodeCollapsedChanged(KisNode * node)
 {
     Q_UNUSED(node);
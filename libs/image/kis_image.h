@@ -785,6 +785,19 @@ public:
      */
     KisLodPreferences lodPreferences() const;
 
+    /**
+     * Makes the scheduler update the dirty areas closest to \p imagePoint
+     * first, instead of the oldest ones. The canvas passes the position of
+     * the tool here, so that the area under the stylus is not delayed by
+     * the distant areas dirtied by the same stroke.
+     */
+    void setProjectionUpdatesPriorityPoint(const QPointF &imagePoint);
+
+    /**
+     * Returns the scheduler to the FIFO processing of the updates
+     */
+    void resetProjectionUpdatesPriorityPoint();
+
     KisImageAnimationInterface *animationInterface() const;
 
     /**
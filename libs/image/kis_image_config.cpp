@@ -168,6 +168,28 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+bool KisImageConfig::useSparseSwapFile(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useSparseSwapFile", false) : false;
+}
+
+void KisImageConfig::setUseSparseSwapFile(bool value)
+{
+    m_config.writeEntry("useSparseSwapFile", value);
+}
+
+bool KisImageConfig::lazyLayerLoading(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("lazyLayerLoading", true) : true;
+}
+
+void KisImageConfig::setLazyLayerLoading(bool value)
+{
+    m_config.writeEntry("lazyLayerLoading", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
@@ -587,6 +609,16 @@ void KisImageConfig::setMaxNumberOfThreads(int value)
     }
 }
 
+bool KisImageConfig::useWorkStealingUpdater(bool defaultValue) const
+{
+    return defaultValue ? false : m_config.readEntry("useWorkStealingUpdater", false);
+}
+
+void KisImageConfig::setUseWorkStealingUpdater(bool value)
+{
+    m_config.writeEntry("useWorkStealingUpdater", value);
+}
+
 int KisImageConfig::frameRenderingClones(bool defaultValue) const
 {
     const int defaultClonesCount = qMax(1, maxNumberOfThreads(defaultValue) / 2);
@@ -640,6 +672,26 @@ void KisImageConfig::setAnimationCacheDir(const QString &value)
     m_config.writeEntry("animationCacheDir", value);
 }
 
+bool KisImageConfig::useAnimationCacheCompression(bool defaultValue) const
+{
+    return defaultValue ? true : m_config.readEntry("useAnimationCacheCompression", true);
+}
+
+void KisImageConfig::setUseAnimationCacheCompression(bool value)
+{
+    m_config.writeEntry("useAnimationCacheCompression", value);
+}
+
+int KisImageConfig::animationCacheMemoryLimit(bool defaultValue) const
+{
+    return defaultValue ? 1024 : m_config.readEntry("animationCacheMemoryLimit", 1024);
+}
+
+void KisImageConfig::setAnimationCacheMemoryLimit(int value)
+{
+    m_config.writeEntry("animationCacheMemoryLimit", value);
+}
+
 bool KisImageConfig::useAnimationCacheFrameSizeLimit(bool defaultValue) const
 {
     return defaultValue ? true : m_config.readEntry("useAnimationCacheFrameSizeLimit", true);
@@ -736,6 +788,16 @@ void KisImageConfig::setRenameDuplicatedLayers(bool value)
     m_config.writeEntry("renameDuplicatedLayers", value);
 }
 
+bool KisImageConfig::useFFTWWisdom(bool defaultValue) const
+{
+    return defaultValue ? false : m_config.readEntry("useFFTWWisdom", false);
+}
+
+void KisImageConfig::setUseFFTWWisdom(bool value)
+{
+    m_config.writeEntry("useFFTWWisdom", value);
+}
+
 QString KisImageConfig::exportConfigurationXML(const QString &exportConfigId, bool defaultValue) const
 {
     return (defaultValue ? QString() : m_config.readEntry("ExportConfiguration-" + exportConfigId, QString()));
@@ -46,6 +46,23 @@ public:
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    /**
+     * If enabled, the whole swap file is mapped into memory at once
+     * (sparsely), which allows concurrent swap-in of the tiles and
+     * reclaiming of disk space for freed chunks. Supported on Linux
+     * only, other platforms always use the sliding-window swap file.
+     */
+    bool useSparseSwapFile(bool requestDefault = false) const;
+    void setUseSparseSwapFile(bool value);
+
+    /**
+     * If enabled, the layers of .kra files are not decompressed while
+     * loading. Their compressed tiles are moved into the swap file and
+     * decompressed on the first access.
+     */
+    bool lazyLayerLoading(bool requestDefault = false) const;
+    void setLazyLayerLoading(bool value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
@@ -112,6 +129,14 @@ public:
     int maxNumberOfThreads(bool defaultValue = false) const;
     void setMaxNumberOfThreads(int value);
 
+    /**
+     * Run the update jobs on KisWorkStealingThreadPool instead of
+     * QThreadPool. Reduces the idle time of the worker threads
+     * on machines with high core count.
+     */
+    bool useWorkStealingUpdater(bool defaultValue = false) const;
+    void setUseWorkStealingUpdater(bool value);
+
     int frameRenderingClones(bool defaultValue = false) const;
     void setFrameRenderingClones(int value);
 
@@ -127,6 +152,22 @@ public:
     QString animationCacheDir(bool defaultValue = false) const;
     void setAnimationCacheDir(const QString &value);
 
+    /**
+     * Store the frames of the in-memory animation cache as compressed
+     * differences to the keyframes. Used only when on-disk swapping
+     * is disabled.
+     */
+    bool useAnimationCacheCompression(bool defaultValue = false) const;
+    void setUseAnimationCacheCompression(bool value);
+
+    /**
+     * The maximum amount of RAM used by the compressed animation cache
+     * in MiB. The frames furthest from the playhead are dropped when the
+     * limit is exceeded. Zero means no limit.
+     */
+    int animationCacheMemoryLimit(bool defaultValue = false) const;
+    void setAnimationCacheMemoryLimit(int value);
+
     bool useAnimationCacheFrameSizeLimit(bool defaultValue = false) const;
     void setUseAnimationCacheFrameSizeLimit(bool value);
 
@@ -155,6 +196,14 @@ public:
     bool renameDuplicatedLayers(bool defaultValue = false) const;
     void setRenameDuplicatedLayers(bool value);
 
+    /**
+     * When enabled, FFT convolution plans are measured rather than
+     * estimated and the resulting FFTW wisdom is persisted between
+     * the sessions
+     */
+    bool useFFTWWisdom(bool defaultValue = false) const;
+    void setUseFFTWWisdom(bool value);
+
     template<class T>
     void writeEntry(const QString& name, const T& value) {
         m_config.writeEntry(name, value);
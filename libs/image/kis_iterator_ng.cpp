@@ -18,6 +18,11 @@ KisHLineConstIteratorNG::~KisHLineConstIteratorNG()
 {
 }
 
+void KisHLineConstIteratorNG::setNumIteratedRows(qint32 numRows)
+{
+    Q_UNUSED(numRows);
+}
+
 KisHLineIteratorNG::~KisHLineIteratorNG()
 {
 }
@@ -26,6 +31,11 @@ KisVLineConstIteratorNG::~KisVLineConstIteratorNG()
 {
 }
 
+void KisVLineConstIteratorNG::setNumIteratedColumns(qint32 numColumns)
+{
+    Q_UNUSED(numColumns);
+}
+
 KisVLineIteratorNG::~KisVLineIteratorNG()
 {
 }
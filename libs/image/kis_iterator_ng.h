@@ -54,6 +54,14 @@ public:
 
     virtual void resetPixelPos() = 0;
     virtual void resetRowPos() = 0;
+
+    /**
+     * Tells the iterator how many rows the caller is going to walk
+     * through. The iterator prefetches the swapped-out tiles of the
+     * next rows, but never beyond this limit. By default only the
+     * current row is known, so nothing is prefetched.
+     */
+    virtual void setNumIteratedRows(qint32 numRows);
 };
 
 /**
@@ -83,6 +91,12 @@ public:
 
     virtual void resetPixelPos() = 0;
     virtual void resetColumnPos() = 0;
+
+    /**
+     * Same as KisHLineConstIteratorNG::setNumIteratedRows(), but for
+     * the columns
+     */
+    virtual void setNumIteratedColumns(qint32 numColumns);
 };
 
 /**
@@ -6,10 +6,15 @@
 
 #include "kis_liquify_transform_worker.h"
 
+#include <QMap>
+#include <QThreadPool>
+
 #include <KoColorSpace.h>
 #include "kis_grid_interpolation_tools.h"
 #include "kis_dom_utils.h"
 #include "krita_utils.h"
+#include "kis_image_config.h"
+#include "kis_update_job_item.h"
 
 
 struct Q_DECL_HIDDEN KisLiquifyTransformWorker::Private
@@ -31,9 +36,31 @@ struct Q_DECL_HIDDEN KisLiquifyTransformWorker::Private
     KoUpdater *progress;
     int pixelPrecision;
     QSize gridSize;
+    int maxThreadCount = 0;
+
+    /**
+     * The transformed points the destination device has been rendered
+     * with the last time. It is empty if nothing has been rendered yet
+     * or the whole grid has been changed since then.
+     */
+    QVector<QPointF> renderedTransformedPoints;
+
+    /// the points changed since the last rendering, in grid coordinates
+    QRect dirtyPointsRect;
 
     void preparePoints();
 
+    inline void markPointDirty(int index) {
+        dirtyPointsRect |= QRect(index % gridSize.width(), index / gridSize.width(), 1, 1);
+    }
+
+    void invalidateRenderedState();
+    void saveRenderedState();
+
+    void renderCells(KisPaintDeviceSP srcDevice,
+                     KisPaintDeviceSP dstDevice,
+                     const QRect &dstClipRect);
+
     struct MapIndexesOp;
 
     template <class ProcessOp>
@@ -69,6 +96,8 @@ KisLiquifyTransformWorker::KisLiquifyTransformWorker(const QRect &srcBounds,
 KisLiquifyTransformWorker::KisLiquifyTransformWorker(const KisLiquifyTransformWorker &rhs)
     : m_d(new Private(*rhs.m_d.data()))
 {
+    // the copy has not rendered anything yet
+    m_d->invalidateRenderedState();
 }
 
 KisLiquifyTransformWorker::~KisLiquifyTransformWorker()
@@ -118,6 +147,8 @@ const QVector<QPointF>& KisLiquifyTransformWorker::originalPoints() const
 
 QVector<QPointF>& KisLiquifyTransformWorker::transformedPoints()
 {
+    // the points may be changed arbitrarily by the caller
+    m_d->invalidateRenderedState();
     return m_d->transformedPoints;
 }
 
@@ -163,6 +194,8 @@ void KisLiquifyTransformWorker::Private::preparePoints()
 
 void KisLiquifyTransformWorker::translate(const QPointF &offset)
 {
+    m_d->invalidateRenderedState();
+
     QVector<QPointF>::iterator it = m_d->transformedPoints.begin();
     QVector<QPointF>::iterator end = m_d->transformedPoints.end();
 
@@ -178,6 +211,8 @@ void KisLiquifyTransformWorker::translate(const QPointF &offset)
 
 void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
 {
+    m_d->invalidateRenderedState();
+
     QVector<QPointF>::iterator it = m_d->transformedPoints.begin();
     QVector<QPointF>::iterator end = m_d->transformedPoints.end();
 
@@ -212,6 +247,8 @@ void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
         qreal lambda = exp(-0.5 * pow2(dist / sigma));
         lambda *= amount;
         *it = *refIt * lambda + *it * (1.0 - lambda);
+
+        m_d->markPointDirty(it - m_d->transformedPoints.begin());
     }
 }
 
@@ -237,6 +274,8 @@ processTransformedPixelsBuildUp(ProcessOp op,
 
         const qreal lambda = exp(-0.5 * pow2(dist / sigma));
         *it = op(*it, base, diff, lambda);
+
+        markPointDirty(it - transformedPoints.begin());
     }
 }
 
@@ -270,6 +309,7 @@ processTransformedPixelsWash(ProcessOp op,
 
         if (kisDistance(dstPt, *refIt) > kisDistance(*it, *refIt)) {
             *it = (1.0 - flow) * (*it) + flow * dstPt;
+            markPointDirty(it - transformedPoints.begin());
         }
     }
 }
@@ -389,20 +429,243 @@ void KisLiquifyTransformWorker::rotatePoints(const QPointF &base,
     m_d->processTransformedPixels(op, base, sigma, useWashMode, flow);
 }
 
+void KisLiquifyTransformWorker::Private::invalidateRenderedState()
+{
+    renderedTransformedPoints.clear();
+    dirtyPointsRect = QRect();
+}
+
+void KisLiquifyTransformWorker::Private::saveRenderedState()
+{
+    // the points are implicitly shared until the next change
+    renderedTransformedPoints = transformedPoints;
+    dirtyPointsRect = QRect();
+}
+
+namespace {
+
+/**
+ * Returns the polygon of the cell with the top-left corner at (\p col, \p row)
+ * the same way iterateThroughGrid() builds it
+ */
+inline QPolygonF cellPolygon(int col, int row,
+                             const QSize &gridSize,
+                             const QVector<QPointF> &points)
+{
+    const int tl = col + row * gridSize.width();
+    const int bl = tl + gridSize.width();
+
+    QPolygonF polygon(4);
+    polygon[0] = points[tl];
+    polygon[1] = points[tl + 1];
+    polygon[2] = points[bl + 1];
+    polygon[3] = points[bl];
+
+    GridIterationTools::adjustAlignedPolygon(polygon);
+    return polygon;
+}
+
+inline QRect cellDstRect(int col, int row,
+                         const QSize &gridSize,
+                         const QVector<QPointF> &points)
+{
+    return cellPolygon(col, row, gridSize, points).boundingRect().toAlignedRect();
+}
+
+}
+
+void KisLiquifyTransformWorker::Private::renderCells(KisPaintDeviceSP srcDevice,
+                                                     KisPaintDeviceSP dstDevice,
+                                                     const QRect &dstClipRect)
+{
+    using namespace GridIterationTools;
+
+    const int numCols = gridSize.width() - 1;
+    const int numRows = gridSize.height() - 1;
+
+    /**
+     * The cells are rasterized in horizontal bands aligned to the tile grid
+     * of the destination device. Every band processes, in the original
+     * order, only the cells covering it, clipped by the band's rect. So
+     * every pixel is written by the same sequence of cells as in a plain
+     * serial pass, and every tile is written by a single thread only.
+     */
+    const int bandHeight = 256;
+    const int bandOffset = dstDevice->y();
+
+    auto bandIndex = [bandOffset, bandHeight] (int y) {
+        y -= bandOffset;
+        return y >= 0 ? y / bandHeight : -((-y + bandHeight - 1) / bandHeight);
+    };
+
+    QMap<int, QVector<int>> bandCells;
+    QRect dstBounds;
+
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            QRect rc = cellDstRect(col, row, gridSize, transformedPoints);
+            if (!dstClipRect.isNull()) {
+                rc &= dstClipRect;
+            }
+            if (rc.isEmpty()) continue;
+
+            dstBounds |= rc;
+
+            const int lastBand = bandIndex(rc.bottom());
+            for (int band = bandIndex(rc.top()); band <= lastBand; band++) {
+                bandCells[band] << col + row * gridSize.width();
+            }
+        }
+    }
+
+    // the points are accessed by the worker threads via const references
+    // only, so that the implicitly shared vectors are never detached
+    const QVector<QPointF> &srcPoints = originalPoints;
+    const QVector<QPointF> &dstPoints = transformedPoints;
+
+    auto processBand = [&] (const QRect &bandRect, const QVector<int> &cells) {
+        PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
+        polygonOp.m_dstClipRect = bandRect;
+
+        Q_FOREACH (int index, cells) {
+            const int col = index % gridSize.width();
+            const int row = index / gridSize.width();
+
+            polygonOp(cellPolygon(col, row, gridSize, srcPoints),
+                      cellPolygon(col, row, gridSize, dstPoints));
+        }
+    };
+
+    /**
+     * Stroke jobs already run on all the threads of the updater context,
+     * so inside them the bands are rasterized serially
+     */
+    int numThreads = maxThreadCount;
+    if (numThreads <= 0) {
+        numThreads = KisUpdateJobItem::isUpdaterThread() ?
+            1 : KisImageConfig(true).maxNumberOfThreads();
+    }
+
+    if (numThreads <= 1 || bandCells.size() <= 1) {
+        for (auto it = bandCells.constBegin(); it != bandCells.constEnd(); ++it) {
+            const QRect bandRect(dstBounds.left(), bandOffset + it.key() * bandHeight,
+                                 dstBounds.width(), bandHeight);
+            processBand(bandRect & dstBounds, it.value());
+        }
+    } else {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
+
+        for (auto it = bandCells.constBegin(); it != bandCells.constEnd(); ++it) {
+            const QRect bandRect(dstBounds.left(), bandOffset + it.key() * bandHeight,
+                                 dstBounds.width(), bandHeight);
+            const QVector<int> cells = it.value();
+
+            threadPool.start(QRunnable::create(
+                [&processBand, bandRect, dstBounds, cells] () {
+                    processBand(bandRect & dstBounds, cells);
+                }));
+        }
+
+        threadPool.waitForDone();
+    }
+}
+
 void KisLiquifyTransformWorker::run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(*srcDevice->colorSpace() == *dstDevice->colorSpace());
 
     dstDevice->clear();
 
-    using namespace GridIterationTools;
+    m_d->renderCells(srcDevice, dstDevice, QRect());
+    m_d->saveRenderedState();
+}
 
-    PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
-    RegularGridIndexesOp indexesOp(m_d->gridSize);
-    iterateThroughGrid<AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
-                                                    m_d->gridSize,
-                                                    m_d->originalPoints,
-                                                    m_d->transformedPoints);
+QRect KisLiquifyTransformWorker::runIncremental(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice)
+{
+    KIS_SAFE_ASSERT_RECOVER(*srcDevice->colorSpace() == *dstDevice->colorSpace()) {
+        return QRect();
+    }
+
+    if (m_d->renderedTransformedPoints.size() != m_d->transformedPoints.size()) {
+        const QRect oldExtent = dstDevice->extent();
+        run(srcDevice, dstDevice);
+        return oldExtent | dstDevice->extent();
+    }
+
+    const QRect dirtyCells =
+        m_d->dirtyPointsRect.adjusted(-1, -1, 0, 0) &
+        QRect(0, 0, m_d->gridSize.width() - 1, m_d->gridSize.height() - 1);
+
+    if (dirtyCells.isEmpty()) return QRect();
+
+    /**
+     * The changed area consists of the old and the new positions of the
+     * dirty cells. All the other cells keep their positions, so outside
+     * this area the destination stays the same.
+     */
+    QRect changedRect;
+
+    for (int row = dirtyCells.top(); row <= dirtyCells.bottom(); row++) {
+        for (int col = dirtyCells.left(); col <= dirtyCells.right(); col++) {
+            changedRect |= cellDstRect(col, row, m_d->gridSize, m_d->renderedTransformedPoints);
+            changedRect |= cellDstRect(col, row, m_d->gridSize, m_d->transformedPoints);
+        }
+    }
+
+    if (!changedRect.isEmpty()) {
+        dstDevice->clear(changedRect);
+
+        /**
+         * The area is re-rendered by all the cells covering it, including
+         * the clean ones overlapping the dirty cells
+         */
+        m_d->renderCells(srcDevice, dstDevice, changedRect);
+    }
+
+    m_d->saveRenderedState();
+
+    return changedRect;
+}
+
+void KisLiquifyTransformWorker::updatePointsFrom(const KisLiquifyTransformWorker &rhs)
+{
+    if (m_d->srcBounds != rhs.m_d->srcBounds ||
+        m_d->pixelPrecision != rhs.m_d->pixelPrecision ||
+        m_d->gridSize != rhs.m_d->gridSize ||
+        m_d->originalPoints != rhs.m_d->originalPoints ||
+        m_d->transformedPoints.size() != rhs.m_d->transformedPoints.size()) {
+
+        const int maxThreadCount = m_d->maxThreadCount;
+
+        *m_d = *rhs.m_d;
+        m_d->maxThreadCount = maxThreadCount;
+        m_d->invalidateRenderedState();
+        return;
+    }
+
+    const QVector<QPointF> &srcPoints = rhs.m_d->transformedPoints;
+
+    for (int i = 0; i < srcPoints.size(); i++) {
+        const QPointF &pt = srcPoints[i];
+        const QPointF &oldPt = m_d->transformedPoints.at(i);
+
+        // compare exactly, QPointF::operator== is fuzzy
+        if (pt.x() != oldPt.x() || pt.y() != oldPt.y()) {
+            m_d->transformedPoints[i] = pt;
+            m_d->markPointDirty(i);
+        }
+    }
+}
+
+int KisLiquifyTransformWorker::maxThreadCount() const
+{
+    return m_d->maxThreadCount;
+}
+
+void KisLiquifyTransformWorker::setMaxThreadCount(int value)
+{
+    m_d->maxThreadCount = value;
 }
 
 QRect KisLiquifyTransformWorker::approxChangeRect(const QRect &rc)
@@ -437,6 +700,8 @@ void KisLiquifyTransformWorker::transformSrcAndDst(const QTransform &t)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(t.type() <= QTransform::TxScale);
 
+    m_d->invalidateRenderedState();
+
     m_d->srcBounds = t.mapRect(m_d->srcBounds);
 
     for (auto it = m_d->originalPoints.begin(); it != m_d->originalPoints.end(); ++it) {
@@ -64,6 +64,39 @@ public:
     QVector<QPointF>& transformedPoints();
 
     void run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice);
+
+    /**
+     * Updates \p dstDevice after the points have been changed with
+     * translatePoints(), scalePoints(), rotatePoints() or undoPoints().
+     * Only the part of the destination covered by the grid cells changed
+     * since the last run() or runIncremental() call is re-rasterized.
+     *
+     * \p dstDevice must contain the result of that last call, rendered
+     * from the same \p srcDevice. If nothing has been rendered yet, or the
+     * whole grid has been changed since then, a full run() is done.
+     *
+     * @return the rect of \p dstDevice that has been changed
+     */
+    QRect runIncremental(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice);
+
+    /**
+     * Copies the transformed points of \p rhs into this worker. If both
+     * workers have the same grid, only the points that differ are marked
+     * as changed, so the following runIncremental() re-rasterizes only
+     * the cells covering them. Otherwise the worker becomes a copy of
+     * \p rhs and the following runIncremental() does a full run().
+     */
+    void updatePointsFrom(const KisLiquifyTransformWorker &rhs);
+
+    /**
+     * The maximum number of threads the grid cells are rasterized with.
+     * Zero (the default) means the number of threads set in the preferences
+     * (KisImageConfig::maxNumberOfThreads()), or a single thread when the
+     * worker runs on a thread of the updater context. One disables
+     * parallel processing.
+     */
+    int maxThreadCount() const;
+    void setMaxThreadCount(int value);
     QImage runOnQImage(const QImage &srcImage,
                        const QPointF &srcImageOffset,
                        const QTransform &imageToThumbTransform,
@@ -144,6 +144,8 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.swapFileSize = tileStats.swapFileSize;
+    stats.swapReclaimedSize = tileStats.swapReclaimedSize;
 
     KisImageConfig cfg(true);
 
@@ -33,6 +33,8 @@ public:
               poolSize(0),
 
               swapSize(0),
+              swapFileSize(0),
+              swapReclaimedSize(0),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
@@ -52,6 +54,8 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapFileSize;
+        qint64 swapReclaimedSize;
 
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
@@ -378,11 +378,11 @@ public:
         return m_frames.keys();
     }
 
-    bool readFrame(QIODevice *stream, int frameId)
+    bool readFrame(QIODevice *stream, int frameId, bool lazy)
     {
         bool retval = false;
         DataSP data = m_frames[frameId];
-        retval = data->dataManager()->read(stream);
+        retval = data->dataManager()->read(stream, lazy);
         data->cache()->invalidate();
         return retval;
     }
@@ -1530,6 +1530,11 @@ void KisPaintDevice::clear(const QRect & rc)
     m_d->currentStrategy()->clear(rc);
 }
 
+void KisPaintDevice::prefetchRect(const QRect &rc) const
+{
+    m_d->dataManager()->prefetchRect(rc.translated(-x(), -y()));
+}
+
 void KisPaintDevice::fill(const QRect & rc, const KoColor &color)
 {
     KIS_ASSERT_RECOVER_RETURN(*color.colorSpace() == *colorSpace());
@@ -1547,11 +1552,11 @@ bool KisPaintDevice::write(KisPaintDeviceWriter &store)
     return m_d->dataManager()->write(store);
 }
 
-bool KisPaintDevice::read(QIODevice *stream)
+bool KisPaintDevice::read(QIODevice *stream, bool lazy)
 {
     bool retval;
 
-    retval = m_d->dataManager()->read(stream);
+    retval = m_d->dataManager()->read(stream, lazy);
     m_d->cache()->invalidate();
 
     return retval;
@@ -2284,12 +2289,12 @@ bool KisPaintDeviceFramesInterface::writeFrame(KisPaintDeviceWriter &store, int
     return q->m_d->writeFrame(store, frameId);
 }
 
-bool KisPaintDeviceFramesInterface::readFrame(QIODevice *stream, int frameId)
+bool KisPaintDeviceFramesInterface::readFrame(QIODevice *stream, int frameId, bool lazy)
 {
     KIS_ASSERT_RECOVER(frameId >= 0) {
         return false;
     }
-    return q->m_d->readFrame(stream, frameId);
+    return q->m_d->readFrame(stream, frameId, lazy);
 }
 
 int KisPaintDeviceFramesInterface::currentFrameId() const
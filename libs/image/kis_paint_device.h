@@ -124,8 +124,11 @@ public:
 
     /**
      * Fill this paint device with the pixels from the specified file store.
+     *
+     * If \p lazy is true, the pixel data is kept compressed in the swap
+     * until it is accessed for the first time.
      */
-    bool read(QIODevice *stream);
+    bool read(QIODevice *stream, bool lazy = false);
 
 public:
 
@@ -276,6 +279,14 @@ public:
      */
     void clear(const QRect & rc);
 
+    /**
+     * Asks the tile engine to asynchronously load all the swapped-out
+     * tiles intersecting \p rc. Call it right before reading a large
+     * area of the device to overlap the disk reads with the processing.
+     * It is only a hint, the device stays readable regardless.
+     */
+    void prefetchRect(const QRect &rc) const;
+
     /**
      * Frees the memory occupied by the pixels containing default
      * values. The extents() and exactBounds() of the paint device will
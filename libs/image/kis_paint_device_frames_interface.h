@@ -91,12 +91,13 @@ public:
     bool writeFrame(KisPaintDeviceWriter &store, int frameId);
 
     /**
-     * Loads content of a \p frameId from \p stream.
+     * Loads content of a \p frameId from \p stream. If \p lazy is
+     * true, the pixel data is decompressed on the first access.
      *
      * NOTE: the frame must be created manually with createFrame()
      *       beforehand!
      */
-    bool readFrame(QIODevice *stream, int frameId);
+    bool readFrame(QIODevice *stream, int frameId, bool lazy = false);
 
 
     /**
@@ -15,6 +15,8 @@
 #include <QTransform>
 #include <QVector3D>
 #include <QPolygonF>
+#include <QThreadPool>
+#include <QAtomicInt>
 
 #include <KoUpdater.h>
 #include <KoColor.h>
@@ -31,6 +33,8 @@
 #include "kis_painter.h"
 #include "kis_image.h"
 #include "kis_algebra_2d.h"
+#include "kis_image_config.h"
+#include "kis_update_job_item.h"
 
 
 KisPerspectiveTransformWorker::KisPerspectiveTransformWorker(KisPaintDeviceSP dev, QPointF center, double aX, double aY, double distance, bool cropDst, KoUpdaterPtr progress)
@@ -143,6 +147,26 @@ struct NearestNeighbourWrapper
     int m_pixelSize;
 };
 
+template <class SrcAccessorWrapper>
+void KisPerspectiveTransformWorker::processPatch(KisPaintDeviceSP srcDev, const QRect &rect)
+{
+    SrcAccessorWrapper srcAcc(srcDev);
+    KisRandomAccessorSP accessor = m_dev->createRandomAccessorNG();
+
+    for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+        for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
+
+            QPointF dstPoint(x, y);
+            QPointF srcPoint = m_backwardTransform.map(dstPoint);
+
+            if (m_srcRect.contains(srcPoint)) {
+                accessor->moveTo(dstPoint.x(), dstPoint.y());
+                srcAcc.samplePixel(srcPoint, accessor->rawData());
+            }
+        }
+    }
+}
+
 template <class SrcAccessorWrapper>
 void KisPerspectiveTransformWorker::runImpl()
 {
@@ -167,25 +191,57 @@ void KisPerspectiveTransformWorker::runImpl()
 
     KIS_ASSERT_RECOVER_NOOP(!m_isIdentity);
 
-    KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, m_dstRegion.rectCount());
+    /**
+     * Every destination pixel is calculated independently, so the
+     * destination region is split into patches, each processed with
+     * its own pair of accessors. The source device is only read.
+     */
+    const QVector<QRect> patches =
+        KritaUtils::splitRegionIntoPatches(m_dstRegion, KritaUtils::optimalPatchSize());
+
+    KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, patches.size());
+
+    /**
+     * Stroke jobs already run on all the threads of the updater context,
+     * so inside them the work is not split any further
+     */
+    int numThreads = m_maxThreadCount;
+    if (numThreads <= 0) {
+        numThreads = KisUpdateJobItem::isUpdaterThread() ?
+            1 : KisImageConfig(true).maxNumberOfThreads();
+    }
 
-    SrcAccessorWrapper srcAcc(cloneDevice);
-    KisRandomAccessorSP accessor = m_dev->createRandomAccessorNG();
+    if (numThreads <= 1 || patches.size() <= 1) {
+        Q_FOREACH (const QRect &rect, patches) {
+            processPatch<SrcAccessorWrapper>(cloneDevice, rect);
+            progressHelper.step();
+        }
+    } else {
+        QAtomicInt numProcessedPatches;
 
-    Q_FOREACH (const QRect &rect, m_dstRegion.rects()) {
-        for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
-            for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
 
-                QPointF dstPoint(x, y);
-                QPointF srcPoint = m_backwardTransform.map(dstPoint);
+        Q_FOREACH (const QRect &rect, patches) {
+            threadPool.start(QRunnable::create(
+                [this, cloneDevice, rect, &numProcessedPatches] () {
+                    processPatch<SrcAccessorWrapper>(cloneDevice, rect);
+                    numProcessedPatches.ref();
+                }));
+        }
 
-                if (m_srcRect.contains(srcPoint)) {
-                    accessor->moveTo(dstPoint.x(), dstPoint.y());
-                    srcAcc.samplePixel(srcPoint, accessor->rawData());
-                }
+        // the progress is reported from the calling thread only
+        int numReportedPatches = 0;
+        bool isDone = false;
+
+        while (!isDone) {
+            isDone = threadPool.waitForDone(50);
+
+            const int numPatchesDone = numProcessedPatches.loadAcquire();
+            for (; numReportedPatches < numPatchesDone; numReportedPatches++) {
+                progressHelper.step();
             }
         }
-        progressHelper.step();
     }
 }
 
@@ -254,3 +310,13 @@ void KisPerspectiveTransformWorker::setForceSubPixelTranslation(bool value)
 {
     m_forceSubPixelTranslation = value;
 }
+
+int KisPerspectiveTransformWorker::maxThreadCount() const
+{
+    return m_maxThreadCount;
+}
+
+void KisPerspectiveTransformWorker::setMaxThreadCount(int value)
+{
+    m_maxThreadCount = value;
+}
@@ -43,6 +43,16 @@ public:
     bool forceSubPixelTranslation() const;
     void setForceSubPixelTranslation(bool value);
 
+    /**
+     * The maximum number of threads run() spreads the destination patches
+     * over. Zero (the default) means the number of threads set in the
+     * preferences (KisImageConfig::maxNumberOfThreads()), or a single
+     * thread when run() is called on a thread of the updater context.
+     * One disables parallel processing.
+     */
+    int maxThreadCount() const;
+    void setMaxThreadCount(int value);
+
 private:
     void init(const QTransform &transform);
 
@@ -54,6 +64,9 @@ private:
     template <class SrcAccessorPolicy>
     void runImpl();
 
+    template <class SrcAccessorPolicy>
+    void processPatch(KisPaintDeviceSP srcDev, const QRect &rect);
+
 private:
     KisPaintDeviceSP m_dev;
     KoUpdaterPtr m_progressUpdater;
@@ -65,6 +78,7 @@ private:
     bool m_isTranslating;
     bool m_cropDst;
     bool m_forceSubPixelTranslation {false};
+    int m_maxThreadCount {0};
 };
 
 #endif
@@ -21,11 +21,15 @@ struct DevicePolicy {
     DevicePolicy(Convertible sel) : m_dev(sel) {}
 
     KisHLineConstIteratorSP createConstIterator(const QRect &rect) {
-        return m_dev->createHLineConstIteratorNG(rect.x(), rect.y(), rect.width());
+        KisHLineConstIteratorSP it = m_dev->createHLineConstIteratorNG(rect.x(), rect.y(), rect.width());
+        it->setNumIteratedRows(rect.height());
+        return it;
     }
 
     KisHLineIteratorSP createIterator(const QRect &rect) {
-        return m_dev->createHLineIteratorNG(rect.x(), rect.y(), rect.width());
+        KisHLineIteratorSP it = m_dev->createHLineIteratorNG(rect.x(), rect.y(), rect.width());
+        it->setNumIteratedRows(rect.height());
+        return it;
     }
 
     int pixelSize() const {
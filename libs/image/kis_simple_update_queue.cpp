@@ -9,7 +9,11 @@
 #include <QMutexLocker>
 #include <QVector>
 
+#include <algorithm>
+
+#include "kis_algebra_2d.h"
 #include "kis_image_config.h"
+#include "kis_lod_transform_base.h"
 #include "kis_full_refresh_walker.h"
 #include "kis_spontaneous_job.h"
 
@@ -42,7 +46,8 @@
 
 
 KisSimpleUpdateQueue::KisSimpleUpdateQueue()
-    : m_overrideLevelOfDetail(-1)
+    : m_overrideLevelOfDetail(-1),
+      m_hasPriorityPoint(false)
 {
     updateSettings();
 }
@@ -75,6 +80,96 @@ int KisSimpleUpdateQueue::overrideLevelOfDetail() const
     return m_overrideLevelOfDetail;
 }
 
+void KisSimpleUpdateQueue::setPriorityPoint(const QPointF &imagePoint)
+{
+    QMutexLocker locker(&m_lock);
+
+    if (m_hasPriorityPoint && m_priorityPoint == imagePoint) return;
+
+    m_hasPriorityPoint = true;
+    m_priorityPoint = imagePoint;
+    m_priorityDistances.clear();
+}
+
+void KisSimpleUpdateQueue::resetPriorityPoint()
+{
+    QMutexLocker locker(&m_lock);
+
+    m_hasPriorityPoint = false;
+    m_priorityDistances.clear();
+}
+
+qreal KisSimpleUpdateQueue::priorityDistance(KisBaseRectsWalkerSP walker)
+{
+    PriorityDistance &cached = m_priorityDistances[walker.data()];
+
+    // the requested rect of the walker grows when other jobs are merged into it
+    if (cached.rect != walker->requestedRect() ||
+        cached.levelOfDetail != walker->levelOfDetail()) {
+
+        // the rects of the walkers are stored in the coordinates of their LoD plane
+        const QPointF pt = m_priorityPoint * KisLodTransformBase::lodToScale(walker->levelOfDetail());
+
+        cached.rect = walker->requestedRect();
+        cached.levelOfDetail = walker->levelOfDetail();
+        cached.distance = kisSquareDistance(pt, KisAlgebra2D::clampPoint(pt, QRectF(cached.rect)));
+    }
+
+    return cached.distance;
+}
+
+bool KisSimpleUpdateQueue::isJobReady(KisBaseRectsWalkerSP walker,
+                                      KisUpdaterContext &updaterContext,
+                                      int currentLevelOfDetail)
+{
+    if (currentLevelOfDetail >= 0 && currentLevelOfDetail != walker->levelOfDetail()) {
+        return false;
+    }
+
+    if (!walker->checksumValid()) {
+        m_overrideLevelOfDetail = walker->levelOfDetail();
+        walker->recalculate(walker->requestedRect());
+        m_overrideLevelOfDetail = -1;
+    }
+
+    return updaterContext.isJobAllowed(walker);
+}
+
+KisBaseRectsWalkerSP KisSimpleUpdateQueue::findPriorityJob(KisUpdaterContext &updaterContext,
+                                                           int currentLevelOfDetail)
+{
+    /**
+     * The walkers are checked in the order of their distance to the
+     * priority point, so, like in the FIFO mode, only the walkers up to
+     * the first allowed one are recalculated. The walkers recalculate
+     * the projection from the current state of the nodes, so the order
+     * of non-overlapping ones doesn't affect the result, and the
+     * overlapping ones are serialized by isJobAllowed() anyway.
+     */
+    QVector<std::pair<qreal, KisBaseRectsWalkerSP>> candidates;
+    candidates.reserve(m_updatesList.size());
+
+    Q_FOREACH (KisBaseRectsWalkerSP walker, m_updatesList) {
+        if (currentLevelOfDetail >= 0 && currentLevelOfDetail != walker->levelOfDetail()) continue;
+        candidates.append(std::make_pair(priorityDistance(walker), walker));
+    }
+
+    // the walkers at the same distance keep their FIFO order
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [] (const std::pair<qreal, KisBaseRectsWalkerSP> &lhs,
+                         const std::pair<qreal, KisBaseRectsWalkerSP> &rhs) {
+                         return lhs.first < rhs.first;
+                     });
+
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (isJobReady(it->second, updaterContext, currentLevelOfDetail)) {
+            return it->second;
+        }
+    }
+
+    return KisBaseRectsWalkerSP();
+}
+
 void KisSimpleUpdateQueue::processQueue(KisUpdaterContext &updaterContext)
 {
     updaterContext.lock();
@@ -90,32 +185,38 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
     QMutexLocker locker(&m_lock);
 
     KisBaseRectsWalkerSP item;
-    KisMutableWalkersListIterator iter(m_updatesList);
     bool jobAdded = false;
 
     int currentLevelOfDetail = updaterContext.currentLevelOfDetail();
 
-    while(iter.hasNext()) {
-        item = iter.next();
-
-        if ((currentLevelOfDetail < 0 || currentLevelOfDetail == item->levelOfDetail()) &&
-            !item->checksumValid()) {
+    if (m_hasPriorityPoint) {
+        item = findPriorityJob(updaterContext, currentLevelOfDetail);
 
-            m_overrideLevelOfDetail = item->levelOfDetail();
-            item->recalculate(item->requestedRect());
-            m_overrideLevelOfDetail = -1;
+        if (item) {
+            updaterContext.addMergeJob(item);
+            m_updatesList.removeOne(item);
+            m_priorityDistances.remove(item.data());
+            jobAdded = true;
         }
+    } else {
+        KisMutableWalkersListIterator iter(m_updatesList);
 
-        if ((currentLevelOfDetail < 0 || currentLevelOfDetail == item->levelOfDetail()) &&
-            updaterContext.isJobAllowed(item)) {
+        while(iter.hasNext()) {
+            item = iter.next();
 
-            updaterContext.addMergeJob(item);
-            iter.remove();
-            jobAdded = true;
-            break;
+            if (isJobReady(item, updaterContext, currentLevelOfDetail)) {
+                updaterContext.addMergeJob(item);
+                iter.remove();
+                jobAdded = true;
+                break;
+            }
         }
     }
 
+    if (m_updatesList.isEmpty()) {
+        m_priorityDistances.clear();
+    }
+
     if (jobAdded) return true;
 
     if (!m_spontaneousJobsList.isEmpty()) {
@@ -380,6 +481,7 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
         if(item->levelOfDetail() != baseWalker->levelOfDetail()) continue;
 
         if(joinRects(baseRect, item->requestedRect(), maxAlpha)) {
+            m_priorityDistances.remove(item.data());
             iter.remove();
         }
     }
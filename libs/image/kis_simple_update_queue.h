@@ -7,7 +7,9 @@
 #ifndef __KIS_SIMPLE_UPDATE_QUEUE_H
 #define __KIS_SIMPLE_UPDATE_QUEUE_H
 
+#include <QHash>
 #include <QMutex>
+#include <QPointF>
 #include "kis_updater_context.h"
 #include <KisProjectionUpdateFlags.h>
 
@@ -49,6 +51,20 @@ public:
 
     int overrideLevelOfDetail() const;
 
+    /**
+     * Makes the queue start the walkers closest to \p imagePoint
+     * first, instead of the oldest ones. The point is usually the
+     * position of the tool, so the area under the stylus is updated
+     * before the distant areas dirtied by the same stroke. The point
+     * is in the coordinates of the image at LoD0.
+     */
+    void setPriorityPoint(const QPointF &imagePoint);
+
+    /**
+     * Returns the queue to the FIFO processing of the walkers
+     */
+    void resetPriorityPoint();
+
 protected:
     void addJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
 
@@ -61,6 +77,10 @@ protected:
                      const qreal maxAlpha);
     bool joinRects(QRect& baseRect, const QRect& newRect, qreal maxAlpha);
 
+    bool isJobReady(KisBaseRectsWalkerSP walker, KisUpdaterContext &updaterContext, int currentLevelOfDetail);
+    KisBaseRectsWalkerSP findPriorityJob(KisUpdaterContext &updaterContext, int currentLevelOfDetail);
+    qreal priorityDistance(KisBaseRectsWalkerSP walker);
+
 protected:
 
     mutable QMutex m_lock;
@@ -97,6 +117,22 @@ protected:
     qreal m_maxMergeCollectAlpha;
 
     int m_overrideLevelOfDetail;
+
+    bool m_hasPriorityPoint;
+    QPointF m_priorityPoint;
+
+    /**
+     * The distances of the walkers to the priority point. The entry
+     * stays valid while the requested rect of the walker is the same
+     * as the one the distance was calculated for.
+     */
+    struct PriorityDistance {
+        QRect rect;
+        int levelOfDetail = -1;
+        qreal distance = 0.0;
+    };
+
+    QHash<KisBaseRectsWalker*, PriorityDistance> m_priorityDistances;
 };
 
 class KRITAIMAGE_EXPORT KisTestableSimpleUpdateQueue : public KisSimpleUpdateQueue
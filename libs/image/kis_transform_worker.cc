@@ -14,12 +14,16 @@
 #include <klocalizedstring.h>
 
 #include <QTransform>
+#include <QThreadPool>
+#include <QAtomicInt>
 
 #include <KoColorSpace.h>
 #include <KoCompositeOpRegistry.h>
 #include <KoColor.h>
 
 #include "kis_paint_device.h"
+#include "kis_image_config.h"
+#include "kis_update_job_item.h"
 #include "kis_debug.h"
 #include "kis_selection.h"
 #include "kis_iterator_ng.h"
@@ -150,6 +154,16 @@ void KisTransformWorker::setForceSubPixelTranslation(bool value)
     m_forceSubPixelTranslation = value;
 }
 
+bool KisTransformWorker::parallelProcessingEnabled() const
+{
+    return m_parallelProcessingEnabled;
+}
+
+void KisTransformWorker::setParallelProcessingEnabled(bool value)
+{
+    m_parallelProcessingEnabled = value;
+}
+
 template <class iter> void calcDimensions(QRect rc, qint32 &srcStart, qint32 &srcLen, qint32 &firstLine, qint32 &numLines);
 
 template <> void calcDimensions <KisHLineIteratorSP>
@@ -189,6 +203,22 @@ void updateBounds<KisVLineIteratorSP>(QRect &boundRect, const KisFilterWeightsAp
     boundRect.setHeight(newBounds.size());
 }
 
+/**
+ * Returns the offset of the tile grid of the device in the direction
+ * perpendicular to the lines of the pass
+ */
+template <class iter> int lineTileGridOffset(KisPaintDevice *dev);
+
+template <> int lineTileGridOffset<KisHLineIteratorSP>(KisPaintDevice *dev)
+{
+    return dev->y();
+}
+
+template <> int lineTileGridOffset<KisVLineIteratorSP>(KisPaintDevice *dev)
+{
+    return dev->x();
+}
+
 template <class T>
 void KisTransformWorker::transformPass(KisPaintDevice *src, KisPaintDevice *dst,
                                        double floatscale, double shear, double dx,
@@ -201,19 +231,91 @@ void KisTransformWorker::transformPass(KisPaintDevice *src, KisPaintDevice *dst,
     calcDimensions<T>(m_boundRect, srcStart, srcLen, firstLine, numLines);
 
     KisProgressUpdateHelper progressHelper(m_progressUpdater, portion, numLines);
+
+    // The weights are precomputed once per pass and the buffer is
+    // read-only afterwards, so it is shared by all the worker threads
     KisFilterWeightsBuffer buf(filterStrategy, qAbs(floatscale));
-    KisFilterWeightsApplicator applicator(src, dst, floatscale, shear, dx, clampToEdge);
+    const qreal filterSupport = filterStrategy->support(buf.weightsPositionScale().toFloat());
 
-    KisFilterWeightsApplicator::LinePos dstBounds;
+    QVector<KisFilterWeightsApplicator::LinePos> dstLines(numLines);
+    KisFilterWeightsApplicator::LinePos *dstLinesPtr = dstLines.data();
 
-    for (int i = firstLine; i < firstLine + numLines; i++) {
-        KisFilterWeightsApplicator::LinePos dstPos;
-        KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+    auto processLines = [&] (int start, int end, QAtomicInt *numProcessedLines) {
+        KisFilterWeightsApplicator applicator(src, dst, floatscale, shear, dx, clampToEdge);
 
-        dstPos = applicator.processLine<T>(srcPos, i, &buf, filterStrategy->support(buf.weightsPositionScale().toFloat()));
-        dstBounds.unite(dstPos);
+        for (int i = start; i < end; i++) {
+            KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+            dstLinesPtr[i - firstLine] = applicator.processLine<T>(srcPos, i, &buf, filterSupport);
 
-        progressHelper.step();
+            if (numProcessedLines) {
+                numProcessedLines->ref();
+            } else {
+                progressHelper.step();
+            }
+        }
+    };
+
+    static constexpr int tileSize = 64;
+
+    const bool isBigPass =
+        numLines > tileSize && qint64(numLines) * srcLen >= minParallelPassArea;
+
+    /**
+     * Stroke jobs already run on all the threads of the updater context,
+     * so inside them the pass is not split any further
+     */
+    const int numThreads =
+        m_parallelProcessingEnabled && isBigPass && !KisUpdateJobItem::isUpdaterThread() ?
+            KisImageConfig(true).maxNumberOfThreads() : 1;
+
+    if (numThreads <= 1) {
+
+        processLines(firstLine, firstLine + numLines, nullptr);
+    } else {
+        /**
+         * Every line of the pass reads and writes only the pixels of its own
+         * row (or column), so the lines are independent. The lines are split
+         * into chunks aligned to the tile grid of the device, so that every
+         * tile is accessed by a single thread only.
+         */
+        const int gridOffset = lineTileGridOffset<T>(dst);
+        const int lastLine = firstLine + numLines;
+
+        QAtomicInt numProcessedLines;
+
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
+
+        int chunkStart = firstLine;
+        while (chunkStart < lastLine) {
+            const int posInTile = ((chunkStart - gridOffset) % tileSize + tileSize) % tileSize;
+            const int chunkEnd = qMin(chunkStart + tileSize - posInTile, lastLine);
+
+            threadPool.start(QRunnable::create(
+                [&processLines, &numProcessedLines, chunkStart, chunkEnd] () {
+                    processLines(chunkStart, chunkEnd, &numProcessedLines);
+                }));
+
+            chunkStart = chunkEnd;
+        }
+
+        // the progress is reported from the calling thread only
+        int numReportedLines = 0;
+        bool isDone = false;
+
+        while (!isDone) {
+            isDone = threadPool.waitForDone(50);
+
+            const int numLinesDone = numProcessedLines.loadAcquire();
+            for (; numReportedLines < numLinesDone; numReportedLines++) {
+                progressHelper.step();
+            }
+        }
+    }
+
+    KisFilterWeightsApplicator::LinePos dstBounds;
+    Q_FOREACH (const KisFilterWeightsApplicator::LinePos &dstPos, dstLines) {
+        dstBounds.unite(dstPos);
     }
 
     updateBounds<T>(m_boundRect, dstBounds);
@@ -95,6 +95,14 @@ public:
     bool forceSubPixelTranslation() const;
     void setForceSubPixelTranslation(bool value);
 
+    /**
+     * The scale and shear passes of big devices are processed on
+     * multiple threads, unless the worker runs on a thread of the
+     * updater context. Enabled by default.
+     */
+    bool parallelProcessingEnabled() const;
+    void setParallelProcessingEnabled(bool value);
+
 private:
     // XXX (BSAR): Why didn't we use the shared-pointer versions of the paint device classes?
     // CBR: because the template functions used within don't work if it's not true pointers
@@ -133,6 +141,10 @@ private:
     KisFilterStrategy *m_filter;
     QRect m_boundRect;
     bool m_forceSubPixelTranslation {false};
+    bool m_parallelProcessingEnabled {true};
+
+    /// the passes processing fewer pixels are not worth spawning threads
+    static constexpr qint64 minParallelPassArea = 512 * 512;
 };
 
 #endif // KIS_TRANSFORM_VISITOR_H_
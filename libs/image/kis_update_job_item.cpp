@@ -9,3 +9,17 @@
 /**
  * This cpp-file is for QObject support mostly
  */
+
+namespace {
+thread_local bool s_isUpdaterThread = false;
+}
+
+bool KisUpdateJobItem::isUpdaterThread()
+{
+    return s_isUpdaterThread;
+}
+
+void KisUpdateJobItem::setIsUpdaterThread(bool value)
+{
+    s_isUpdaterThread = value;
+}
@@ -46,14 +46,25 @@ public:
     }
 
     void run() override {
+        setIsUpdaterThread(true);
         runImpl();
+        setIsUpdaterThread(false);
 
         // notify that the job is exiting and wake everybody
         // waiting on wakeForDone()
         m_updaterContext->jobThreadExited();
     }
 
+    /**
+     * Returns true if the calling thread is executing a job of an updater
+     * context. The code running inside such a job should not spread its
+     * work over more threads, because the other threads of the context
+     * are already busy with the other jobs.
+     */
+    static bool isUpdaterThread();
+
 private:
+    static void setIsUpdaterThread(bool value);
 
     ALWAYS_INLINE void runImpl() {
         if (!isRunning()) return;
@@ -144,6 +155,8 @@ public:
 
         m_accessRect = walker->accessRect();
         m_changeRect = walker->changeRect();
+        m_nodeAccessRects = walker->nodeAccessRects();
+        m_hasUntrackedAccess = walker->hasUntrackedAccess();
         m_walker = walker;
 
         m_exclusive = false;
@@ -163,6 +176,8 @@ public:
         m_exclusive = strokeJob->isExclusive();
         m_walker = 0;
         m_accessRect = m_changeRect = QRect();
+        m_nodeAccessRects.clear();
+        m_hasUntrackedAccess = false;
 
         const Type oldState = m_atomicType.exchange(Type::STROKE);
         return oldState == Type::EMPTY;
@@ -177,6 +192,8 @@ public:
         m_exclusive = spontaneousJob->isExclusive();
         m_walker = 0;
         m_accessRect = m_changeRect = QRect();
+        m_nodeAccessRects.clear();
+        m_hasUntrackedAccess = false;
 
         const Type oldState = m_atomicType.exchange(Type::SPONTANEOUS);
         return oldState == Type::EMPTY;
@@ -205,6 +222,14 @@ public:
         return m_changeRect;
     }
 
+    inline const KisBaseRectsWalker::NodeAccessRects& nodeAccessRects() const {
+        return m_nodeAccessRects;
+    }
+
+    inline bool hasUntrackedAccess() const {
+        return m_hasUntrackedAccess;
+    }
+
     inline KisStrokeJobData::Sequentiality strokeJobSequentiality() const {
         return m_strokeJobSequentiality;
     }
@@ -259,6 +284,8 @@ private:
      */
     QRect m_accessRect;
     QRect m_changeRect;
+    KisBaseRectsWalker::NodeAccessRects m_nodeAccessRects;
+    bool m_hasUntrackedAccess {false};
 };
 
 
@@ -97,6 +97,17 @@ void KisUpdateScheduler::setThreadsLimit(int value)
     unlock(false);
 }
 
+void KisUpdateScheduler::setUseWorkStealingPool(bool value)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!m_d->processingBlocked);
+
+    immediateLockForReadOnly();
+    m_d->updaterContext.lock();
+    m_d->updaterContext.setUseWorkStealingPool(value);
+    m_d->updaterContext.unlock();
+    unlock(false);
+}
+
 int KisUpdateScheduler::threadsLimit() const
 {
     std::lock_guard<KisUpdaterContext> l(m_d->updaterContext);
@@ -229,6 +240,16 @@ KisLodPreferences KisUpdateScheduler::lodPreferences() const
     return m_d->strokesQueue.lodPreferences();
 }
 
+void KisUpdateScheduler::setUpdatesPriorityPoint(const QPointF &imagePoint)
+{
+    m_d->updatesQueue.setPriorityPoint(imagePoint);
+}
+
+void KisUpdateScheduler::resetUpdatesPriorityPoint()
+{
+    m_d->updatesQueue.resetPriorityPoint();
+}
+
 void KisUpdateScheduler::explicitRegenerateLevelOfDetail()
 {
     m_d->strokesQueue.explicitRegenerateLevelOfDetail();
@@ -284,6 +305,7 @@ void KisUpdateScheduler::updateSettings()
     KisImageConfig config(true);
     m_d->defaultBalancingRatio = config.schedulerBalancingRatio();
     setThreadsLimit(config.maxNumberOfThreads());
+    setUseWorkStealingPool(config.useWorkStealingUpdater());
 }
 
 void KisUpdateScheduler::immediateLockForReadOnly()
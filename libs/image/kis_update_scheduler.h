@@ -18,6 +18,7 @@
 #include "KisProjectionUpdateFlags.h"
 
 class QRect;
+class QPointF;
 class KoProgressProxy;
 class KisProjectionUpdateListener;
 class KisSpontaneousJob;
@@ -42,6 +43,12 @@ public:
      */
     int threadsLimit() const;
 
+    /**
+     * Switch the scheduler between QThreadPool and
+     * KisWorkStealingThreadPool for executing the jobs
+     */
+    void setUseWorkStealingPool(bool value);
+
     /**
      * Sets the proxy that is going to be notified about the progress
      * of processing of the queues. If you want to switch the proxy
@@ -156,6 +163,17 @@ public:
      */
     KisLodPreferences lodPreferences() const;
 
+    /**
+     * Makes the updates queue process the dirty areas closest to
+     * \p imagePoint first. See KisSimpleUpdateQueue::setPriorityPoint()
+     */
+    void setUpdatesPriorityPoint(const QPointF &imagePoint);
+
+    /**
+     * Returns the updates queue to the FIFO processing
+     */
+    void resetUpdatesPriorityPoint();
+
     /**
      * Explicitly start regeneration of LoD planes of all the devices
      * in the image. This call should be performed when the user is idle,
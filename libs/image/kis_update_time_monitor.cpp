@@ -8,6 +8,7 @@
 
 #include <QGlobalStatic>
 #include <QHash>
+#include <QList>
 #include <QSet>
 #include <QMutex>
 #include <QMutexLocker>
@@ -21,6 +22,8 @@
 
 #include <QFileInfo>
 
+#include <atomic>
+
 #include <kis_debug.h>
 #include <KisPortingUtils.h>
 #include "kis_image_config.h"
@@ -30,6 +33,26 @@
 
 Q_GLOBAL_STATIC(KisUpdateTimeMonitor, s_instance)
 
+namespace {
+
+/**
+ * Tool events which have not been painted during this time (e.g. the
+ * tool doesn't paint at all) are not counted in the latency
+ */
+const qint64 s_maxToolEventLatency = 1000;
+
+/**
+ * The amount of pending tool events that are tracked at once
+ */
+const int s_maxPendingToolEvents = 256;
+
+struct PendingToolEvent {
+    QPointF pos;
+    qint64 time = 0;
+};
+
+}
+
 
 struct StrokeTicket
 {
@@ -73,9 +96,15 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
           numTickets(0),
           numUpdates(0),
           mousePath(0.0),
-          loggingEnabled(false)
+          loggingEnabled(false),
+          latencyTrackingEnabled(false)
     {
         loggingEnabled = KisImageConfig(true).enablePerfLog();
+        latencyClock.start();
+    }
+
+    bool isTrackingLatency() const {
+        return loggingEnabled || latencyTrackingEnabled;
     }
 
     QHash<void*, StrokeTicket*> preliminaryTickets;
@@ -92,7 +121,16 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
     QElapsedTimer strokeTime;
     KisPaintOpPresetSP preset;
 
-    bool loggingEnabled;
+    /**
+     * The flags are read without the lock, since the reporting
+     * functions are called from the updater and GUI threads
+     */
+    std::atomic<bool> loggingEnabled;
+
+    std::atomic<bool> latencyTrackingEnabled;
+    QElapsedTimer latencyClock;
+    QList<PendingToolEvent> pendingToolEvents;
+    LatencyStatistics latency;
 };
 
 KisUpdateTimeMonitor::KisUpdateTimeMonitor()
@@ -132,6 +170,9 @@ void KisUpdateTimeMonitor::startStrokeMeasure()
     m_d->lastMousePos = QPointF();
     m_d->preset = 0;
     m_d->strokeTime.start();
+
+    m_d->pendingToolEvents.clear();
+    m_d->latency = LatencyStatistics();
 }
 
 void KisUpdateTimeMonitor::endStrokeMeasure()
@@ -192,7 +233,8 @@ void KisUpdateTimeMonitor::printValues()
            << i18n("Mouse Speed:") << QString::number( mouseSpeed, 'f', 3 ) << "\t"
            << i18n("Jobs/Update:") << QString::number( jobsPerUpdate, 'f', 3 ) << "\t"
            << i18n("Non Update Time:") << QString::number( nonUpdateTime, 'f', 3 ) << "\t"
-           << i18n("Response Time:") << responseTime << Qt::endl; // 'endl' will use the correct OS line ending
+           << i18n("Response Time:") << responseTime << "\t"
+           << i18n("Tool Latency:") << QString::number( m_d->latency.averageLatency, 'f', 3 ) << Qt::endl; // 'endl' will use the correct OS line ending
     logFile.close();
 }
 
@@ -245,3 +287,83 @@ void KisUpdateTimeMonitor::reportUpdateFinished(const QRect &rect)
     }
     m_d->numUpdates++;
 }
+
+void KisUpdateTimeMonitor::setLatencyTrackingEnabled(bool value)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->latencyTrackingEnabled = value;
+
+    if (!m_d->isTrackingLatency()) {
+        m_d->pendingToolEvents.clear();
+    }
+}
+
+bool KisUpdateTimeMonitor::latencyTrackingEnabled() const
+{
+    QMutexLocker locker(&m_d->mutex);
+    return m_d->isTrackingLatency();
+}
+
+void KisUpdateTimeMonitor::reportToolEvent(const QPointF &imagePos)
+{
+    if (!m_d->isTrackingLatency()) return;
+
+    QMutexLocker locker(&m_d->mutex);
+
+    const qint64 now = m_d->latencyClock.elapsed();
+
+    while (!m_d->pendingToolEvents.isEmpty() &&
+           (now - m_d->pendingToolEvents.first().time > s_maxToolEventLatency ||
+            m_d->pendingToolEvents.size() >= s_maxPendingToolEvents)) {
+
+        m_d->pendingToolEvents.removeFirst();
+    }
+
+    PendingToolEvent event;
+    event.pos = imagePos;
+    event.time = now;
+    m_d->pendingToolEvents.append(event);
+}
+
+void KisUpdateTimeMonitor::reportCanvasUpdateReady(const QRect &imageRect)
+{
+    if (!m_d->isTrackingLatency()) return;
+
+    QMutexLocker locker(&m_d->mutex);
+
+    const qint64 now = m_d->latencyClock.elapsed();
+    const QRectF rect(imageRect);
+
+    auto it = m_d->pendingToolEvents.begin();
+    while (it != m_d->pendingToolEvents.end()) {
+        const qint64 latency = now - it->time;
+
+        if (latency > s_maxToolEventLatency) {
+            it = m_d->pendingToolEvents.erase(it);
+        } else if (rect.contains(it->pos)) {
+            LatencyStatistics &stats = m_d->latency;
+
+            stats.averageLatency =
+                (stats.averageLatency * stats.numSamples + latency) / (stats.numSamples + 1);
+            stats.maxLatency = qMax(stats.maxLatency, latency);
+            stats.numSamples++;
+
+            it = m_d->pendingToolEvents.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+KisUpdateTimeMonitor::LatencyStatistics KisUpdateTimeMonitor::latencyStatistics() const
+{
+    QMutexLocker locker(&m_d->mutex);
+    return m_d->latency;
+}
+
+void KisUpdateTimeMonitor::resetLatencyStatistics()
+{
+    QMutexLocker locker(&m_d->mutex);
+    m_d->latency = LatencyStatistics();
+}
@@ -18,6 +18,17 @@ class QRect;
 
 class KRITAIMAGE_EXPORT KisUpdateTimeMonitor
 {
+public:
+    /**
+     * The latency between a tool event and the moment the canvas
+     * has the pixels under the position of this event ready
+     */
+    struct LatencyStatistics {
+        int numSamples = 0;
+        qreal averageLatency = 0.0; ///< in milliseconds
+        qint64 maxLatency = 0; ///< in milliseconds
+    };
+
 public:
     KisUpdateTimeMonitor();
     ~KisUpdateTimeMonitor();
@@ -34,6 +45,28 @@ public:
     void reportJobFinished(void *key, const QVector<QRect> &rects);
     void reportUpdateFinished(const QRect &rect);
 
+    /**
+     * Enables measuring of the latency even when the performance log
+     * is disabled, e.g. for showing it on the canvas
+     */
+    void setLatencyTrackingEnabled(bool value);
+    bool latencyTrackingEnabled() const;
+
+    /**
+     * Reports the event that has been passed to the tool at \p imagePos
+     */
+    void reportToolEvent(const QPointF &imagePos);
+
+    /**
+     * Reports that the canvas has uploaded the pixels of \p imageRect.
+     * All the pending tool events inside \p imageRect are considered
+     * to be complete.
+     */
+    void reportCanvasUpdateReady(const QRect &imageRect);
+
+    LatencyStatistics latencyStatistics() const;
+    void resetLatencyStatistics();
+
 
 private:
     struct Private;
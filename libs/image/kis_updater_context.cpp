@@ -11,6 +11,7 @@
 
 #include "kis_update_job_item.h"
 #include "kis_stroke_job.h"
+#include "KisWorkStealingThreadPool.h"
 
 const int KisUpdaterContext::useIdealThreadCountTag = -1;
 
@@ -28,6 +29,9 @@ KisUpdaterContext::KisUpdaterContext(qint32 threadCount, KisUpdateScheduler *par
 KisUpdaterContext::~KisUpdaterContext()
 {
     m_threadPool.waitForDone();
+    if (m_workStealingPool) {
+        m_workStealingPool->waitForDone();
+    }
 
     if (m_testingMode) {
         clear();
@@ -149,7 +153,11 @@ void KisUpdaterContext::startThread(int index)
         m_numRunningThreads++;
     }
 
-    m_threadPool.start(m_jobs[index]);
+    if (m_workStealingPool) {
+        m_workStealingPool->start(m_jobs[index]);
+    } else {
+        m_threadPool.start(m_jobs[index]);
+    }
 }
 
 /**
@@ -217,13 +225,35 @@ void KisUpdaterContext::waitForDone()
 bool KisUpdaterContext::walkerIntersectsJob(KisBaseRectsWalkerSP walker,
                                             const KisUpdateJobItem* job)
 {
+    if (!walker->accessRect().intersects(job->accessRect())) return false;
+
+    /**
+     * Some layers access nodes outside their merge task,
+     * so we can't rely on per-node rects for them
+     */
+    if (walker->hasUntrackedAccess() || job->hasUntrackedAccess()) return true;
+
     /**
-     * TODO: theoretically, we should compare rects intersection
-     * on a per-layer basis. The current solution is too rough and
-     * basically makes updates single-threaded in some cases (e.g.
-     * when a transform mask is present in the stack)
+     * The total access rects intersect, but it might happen
+     * that they intersect on different nodes only, e.g. when
+     * a transform mask reads the whole layer, but other walkers
+     * do not pass through this layer at all.
      */
-    return walker->accessRect().intersects(job->accessRect());
+    const KisBaseRectsWalker::NodeAccessRects &walkerRects = walker->nodeAccessRects();
+    const KisBaseRectsWalker::NodeAccessRects &jobRects = job->nodeAccessRects();
+
+    const bool iterateWalker = walkerRects.size() <= jobRects.size();
+    const KisBaseRectsWalker::NodeAccessRects &smaller = iterateWalker ? walkerRects : jobRects;
+    const KisBaseRectsWalker::NodeAccessRects &bigger = iterateWalker ? jobRects : walkerRects;
+
+    for (auto it = smaller.constBegin(); it != smaller.constEnd(); ++it) {
+        auto otherIt = bigger.constFind(it.key());
+        if (otherIt != bigger.constEnd() && otherIt.value().intersects(it.value())) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 qint32 KisUpdaterContext::findSpareThread()
@@ -248,6 +278,9 @@ void KisUpdaterContext::unlock()
 void KisUpdaterContext::setThreadsLimit(int value)
 {
     m_threadPool.setMaxThreadCount(value);
+    if (m_workStealingPool) {
+        m_workStealingPool->setMaxThreadCount(value);
+    }
 
     for (int i = 0; i < m_jobs.size(); i++) {
         KIS_SAFE_ASSERT_RECOVER_RETURN(!m_jobs[i]->isRunning());
@@ -271,6 +304,28 @@ int KisUpdaterContext::threadsLimit() const
     return m_jobs.size();
 }
 
+void KisUpdaterContext::setUseWorkStealingPool(bool value)
+{
+    if (value == bool(m_workStealingPool)) return;
+
+    for (int i = 0; i < m_jobs.size(); i++) {
+        KIS_SAFE_ASSERT_RECOVER_RETURN(!m_jobs[i]->isRunning());
+    }
+
+    if (value) {
+        m_workStealingPool.reset(new KisWorkStealingThreadPool());
+        m_workStealingPool->setMaxThreadCount(m_jobs.size());
+    } else {
+        m_workStealingPool->waitForDone();
+        m_workStealingPool.reset();
+    }
+}
+
+bool KisUpdaterContext::useWorkStealingPool() const
+{
+    return bool(m_workStealingPool);
+}
+
 void KisUpdaterContext::continueUpdate(const QRect& rc)
 {
     if (m_scheduler) m_scheduler->continueUpdate(rc);
@@ -9,6 +9,7 @@
 
 #include <QMutex>
 #include <QReadWriteLock>
+#include <QScopedPointer>
 #include <QThreadPool>
 #include <QWaitCondition>
 
@@ -20,6 +21,7 @@
 #include "kis_update_scheduler.h"
 
 class KisUpdateJobItem;
+class KisWorkStealingThreadPool;
 class KisSpontaneousJob;
 class KisStrokeJob;
 class KisUpdateScheduler;
@@ -127,6 +129,14 @@ public:
      */
     int threadsLimit() const;
 
+    /**
+     * Execute the jobs on KisWorkStealingThreadPool instead of the
+     * default QThreadPool. The same restrictions as for
+     * setThreadsLimit() apply.
+     */
+    void setUseWorkStealingPool(bool value);
+    bool useWorkStealingPool() const;
+
     void continueUpdate(const QRect& rc);
     void doSomeUsefulWork();
     void jobFinished();
@@ -154,6 +164,7 @@ protected:
     QWaitCondition m_waitForDoneCondition;
     QVector<KisUpdateJobItem*> m_jobs;
     QThreadPool m_threadPool;
+    QScopedPointer<KisWorkStealingThreadPool> m_workStealingPool;
     KisLockFreeLodCounter m_lodCounter;
     KisUpdateScheduler *m_scheduler;
     bool m_testingMode = false;
@@ -15,6 +15,8 @@
 #include <QVector2D>
 #include <QPainter>
 #include <QVarLengthArray>
+#include <QMap>
+#include <QThreadPool>
 
 #include <KoColorSpace.h>
 #include <KoColor.h>
@@ -22,6 +24,8 @@
 #include <math.h>
 
 #include "kis_grid_interpolation_tools.h"
+#include "kis_image_config.h"
+#include "kis_update_job_item.h"
 
 QPointF KisWarpTransformWorker::affineTransformMath(QPointF v, QVector<QPointF> p, QVector<QPointF> q, qreal alpha)
 {
@@ -245,9 +249,156 @@ void KisWarpTransformWorker::run(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDe
     const int pixelPrecision = 8;
 
     FunctionTransformOp functionOp(m_warpMathFunction, m_origPoint, m_transfPoint, m_alpha);
-    GridIterationTools::PaintDevicePolygonOp polygonOp(srcDev, dstDev);
-    GridIterationTools::processGrid(polygonOp, functionOp,
-                                    srcBounds, pixelPrecision);
+
+    /**
+     * Stroke jobs already run on all the threads of the updater context,
+     * so inside them the work is not split any further
+     */
+    int numThreads = m_maxThreadCount;
+    if (numThreads <= 0) {
+        numThreads = KisUpdateJobItem::isUpdaterThread() ?
+            1 : KisImageConfig(true).maxNumberOfThreads();
+    }
+
+    if (numThreads > 1 && srcBounds.height() > 2 * pixelPrecision) {
+        runParallel(srcDev, dstDev, srcBounds, pixelPrecision, functionOp, numThreads);
+    } else {
+        GridIterationTools::PaintDevicePolygonOp polygonOp(srcDev, dstDev);
+        GridIterationTools::processGrid(polygonOp, functionOp,
+                                        srcBounds, pixelPrecision);
+    }
+}
+
+void KisWarpTransformWorker::runParallel(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev,
+                                         const QRect &srcBounds, const int pixelPrecision,
+                                         const FunctionTransformOp &functionOp,
+                                         int numThreads)
+{
+    using namespace GridIterationTools;
+
+    const QVector<int> cols = calcGridLinePositions(srcBounds.left(), srcBounds.right(), pixelPrecision);
+    const QVector<int> rows = calcGridLinePositions(srcBounds.top(), srcBounds.bottom(), pixelPrecision);
+    const int gridWidth = cols.size();
+    const int gridHeight = rows.size();
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(numThreads);
+
+    /**
+     * The transformation of the grid nodes is the most expensive part
+     * of the warp: every node is calculated over all the control points.
+     * The nodes are independent, so the rows of the grid are transformed
+     * concurrently.
+     */
+    QVector<QPointF> dstPoints(gridWidth * gridHeight);
+    QPointF *dstPointsPtr = dstPoints.data();
+
+    for (int row = 0; row < gridHeight; row++) {
+        threadPool.start(QRunnable::create(
+            [&functionOp, &cols, &rows, gridWidth, dstPointsPtr, row] () {
+                QPointF *dstRow = dstPointsPtr + row * gridWidth;
+
+                for (int col = 0; col < gridWidth; col++) {
+                    dstRow[col] = functionOp(QPointF(cols[col], rows[row]));
+                }
+            }));
+    }
+
+    threadPool.waitForDone();
+
+    /**
+     * The polygons are built exactly the same way as
+     * GridIterationTools::CellOp does it
+     */
+    auto cellPolygons = [&cols, &rows, gridWidth, dstPointsPtr] (int row, int col,
+                                                                 QPolygonF *srcPolygon,
+                                                                 QPolygonF *dstPolygon) {
+        srcPolygon->resize(4);
+        (*srcPolygon)[0] = QPointF(cols[col - 1], rows[row - 1]);
+        (*srcPolygon)[1] = QPointF(cols[col], rows[row - 1]);
+        (*srcPolygon)[2] = QPointF(cols[col], rows[row]);
+        (*srcPolygon)[3] = QPointF(cols[col - 1], rows[row]);
+
+        const QPointF *prevLine = dstPointsPtr + (row - 1) * gridWidth;
+        const QPointF *currLine = dstPointsPtr + row * gridWidth;
+
+        dstPolygon->resize(4);
+        (*dstPolygon)[0] = prevLine[col - 1];
+        (*dstPolygon)[1] = prevLine[col];
+        (*dstPolygon)[2] = currLine[col];
+        (*dstPolygon)[3] = currLine[col - 1];
+    };
+
+    /**
+     * The destination is split into horizontal bands aligned to the tile
+     * grid of the device. Every band renders, in the original order, only
+     * the cells that cover it, clipped by the band's rect. So each pixel is
+     * written by the same sequence of cells as in the serial processing
+     * and every tile is written by a single thread only.
+     */
+    const int bandHeight = 256;
+    const int bandOffset = dstDev->y();
+
+    auto bandIndex = [bandOffset, bandHeight] (int y) {
+        y -= bandOffset;
+        return y >= 0 ? y / bandHeight : -((-y + bandHeight - 1) / bandHeight);
+    };
+
+    QMap<int, QVector<int>> bandCells;
+    QRect dstBounds;
+
+    {
+        QPolygonF srcPolygon;
+        QPolygonF dstPolygon;
+
+        for (int row = 1; row < gridHeight; row++) {
+            for (int col = 1; col < gridWidth; col++) {
+                cellPolygons(row, col, &srcPolygon, &dstPolygon);
+
+                const QRect rc = dstPolygon.boundingRect().toAlignedRect();
+                if (rc.isEmpty()) continue;
+
+                dstBounds |= rc;
+
+                const int lastBand = bandIndex(rc.bottom());
+                for (int band = bandIndex(rc.top()); band <= lastBand; band++) {
+                    bandCells[band] << row * gridWidth + col;
+                }
+            }
+        }
+    }
+
+    for (auto it = bandCells.constBegin(); it != bandCells.constEnd(); ++it) {
+        const QRect bandRect(dstBounds.left(), bandOffset + it.key() * bandHeight,
+                             dstBounds.width(), bandHeight);
+        const QVector<int> cells = it.value();
+
+        threadPool.start(QRunnable::create(
+            [&cellPolygons, srcDev, dstDev, gridWidth, bandRect, cells] () {
+                PaintDevicePolygonOp polygonOp(srcDev, dstDev);
+                polygonOp.m_dstClipRect = bandRect;
+
+                QPolygonF srcPolygon;
+                QPolygonF dstPolygon;
+
+                Q_FOREACH (int index, cells) {
+                    cellPolygons(index / gridWidth, index % gridWidth, &srcPolygon, &dstPolygon);
+                    polygonOp(srcPolygon, dstPolygon);
+                }
+            }));
+    }
+
+    threadPool.waitForDone();
+}
+
+int KisWarpTransformWorker::maxThreadCount() const
+{
+    return m_maxThreadCount;
+}
+
+void KisWarpTransformWorker::setMaxThreadCount(int value)
+{
+    m_maxThreadCount = value;
 }
 
 #include "krita_utils.h"
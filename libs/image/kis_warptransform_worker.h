@@ -58,10 +58,25 @@ public:
     QRect approxChangeRect(const QRect &rc);
     QRect approxNeedRect(const QRect &rc, const QRect &fullBounds);
 
+    /**
+     * The maximum number of threads run() uses for calculating the grid
+     * and rasterizing its cells. Zero (the default) means the number of
+     * threads set in the preferences (KisImageConfig::maxNumberOfThreads()),
+     * or a single thread when run() is called on a thread of the updater
+     * context. One disables parallel processing.
+     */
+    int maxThreadCount() const;
+    void setMaxThreadCount(int value);
+
 private:
     struct FunctionTransformOp;
     typedef QPointF (*WarpMathFunction)(QPointF, QVector<QPointF>, QVector<QPointF>, qreal);
 
+    void runParallel(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev,
+                     const QRect &srcBounds, const int pixelPrecision,
+                     const FunctionTransformOp &functionOp,
+                     int numThreads);
+
 private:
     WarpMathFunction m_warpMathFunction;
     WarpCalculation m_warpCalc {GRID};
@@ -69,6 +84,7 @@ private:
     QVector<QPointF> m_transfPoint;
     qreal m_alpha {1.0};
     KoUpdater *m_progress {0};
+    int m_maxThreadCount {0};
 };
 
 #endif
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISRECURSIVEGAUSSIANBLURTEST_H
+#define KISRECURSIVEGAUSSIANBLURTEST_H
+
+#include <simpletest.h>
+
+class KisRecursiveGaussianBlurTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCoefficients();
+
+    void testAccuracy_data();
+    void testAccuracy();
+
+    void testSelection();
+    void testParallelProcessing_data();
+    void testParallelProcessing();
+};
+
+#endif // KISRECURSIVEGAUSSIANBLURTEST_H
@@ -25,6 +25,12 @@
 #include "testutil.h"
 #include "testing_timed_default_bounds.h"
 
+#include "config_convolution.h"
+
+#ifdef HAVE_FFTW3
+#include "KisFFTWPlanCache.h"
+#endif
+
 KisPaintDeviceSP initAsymTestDevice(QRect &imageRect, int &pixelSize, QByteArray &initialData)
 {
     KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
@@ -581,4 +587,63 @@ void KisConvolutionPainterTest::testNormalMapFFTW()
     testNormalMap(true);
 }
 
+void KisConvolutionPainterTest::testFFTWTiling()
+{
+#ifdef HAVE_FFTW3
+    QImage referenceImage(TestUtil::fetchDataFileLazy("resolution_test.png"));
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(dev->exactBounds());
+    dev->setDefaultBounds(bounds);
+
+    const QRect applyRect = dev->exactBounds();
+    KisConvolutionKernelSP kernel = KisGaussianKernel::createUniform2DKernel(10, 10);
+
+    auto convolve = [&] () {
+        KisPaintDeviceSP result = new KisPaintDevice(dev->colorSpace());
+        result->setDefaultBounds(bounds);
+
+        KisConvolutionPainter painter(result, KisConvolutionPainter::FFTW);
+        painter.applyMatrix(kernel, dev, applyRect.topLeft(), applyRect.topLeft(),
+                            applyRect.size(), BORDER_REPEAT);
+
+        return result->convertToQImage(0, applyRect);
+    };
+
+    KisFFTWPlanCache *planCache = KisFFTWPlanCache::instance();
+    const qint64 oldMaxMemory = planCache->maxTransformMemory();
+
+    const QImage referenceResult = convolve();
+
+    // force the area to be split into 64-px tiles
+    planCache->setMaxTransformMemory(1);
+
+    const QImage tiledResult = convolve();
+
+    // the second pass should reuse all the plans
+    planCache->resetStatistics();
+    convolve();
+
+    const KisFFTWPlanCache::Statistics stats = planCache->statistics();
+
+    planCache->setMaxTransformMemory(oldMaxMemory);
+
+    QPoint pt;
+    if (!TestUtil::compareQImages(pt, referenceResult, tiledResult, 1, 1)) {
+        referenceResult.save("fftw_tiling_reference.png");
+        tiledResult.save("fftw_tiling_tiled.png");
+        QFAIL(QString("Tiled convolution differs from the reference at %1,%2")
+              .arg(pt.x()).arg(pt.y()).toLatin1());
+    }
+
+    // all the tiles, including the edge ones, have the same size, so the
+    // plans are fetched and the kernel is transformed only once per pass
+    QCOMPARE(stats.hits, qint64(2));
+    QCOMPARE(stats.misses, qint64(0));
+#else
+    QSKIP("Krita is built without FFTW3");
+#endif
+}
+
 KISTEST_MAIN(KisConvolutionPainterTest)
@@ -52,6 +52,8 @@ private Q_SLOTS:
 
     void testNormalMapSpatial();
     void testNormalMapFFTW();
+
+    void testFFTWTiling();
 };
 
 #endif
@@ -42,6 +42,15 @@ public:
 
 };
 
+class TestLodFilter : public TestFilter
+{
+public:
+    TestLodFilter() {
+        addLevelOfDetailScaledProperty("radius");
+        addLevelOfDetailScaledProperty("spacing", 1.0);
+    }
+};
+
 void KisFilterTest::testCreation()
 {
     TestFilter test;
@@ -237,5 +246,44 @@ void KisFilterTest::testBlurFilterApplicationRect()
     QVERIFY(TestUtil::compareQImages(pt, refImage, dst2Image));
 }
 
+void KisFilterTest::testLevelOfDetailConfiguration()
+{
+    TestFilter plainFilter;
+    TestLodFilter lodFilter;
+
+    KisFilterConfigurationSP config =
+        new KisFilterConfiguration("test", 1, KisGlobalResourcesInterface::instance());
+
+    config->setProperty("radius", 10);
+    config->setProperty("spacing", 2.0);
+    config->setProperty("strength", 50);
+
+    QVERIFY(!plainFilter.supportsLevelOfDetail(config, 2));
+    QVERIFY(lodFilter.supportsLevelOfDetail(config, 2));
+
+    QCOMPARE(plainFilter.configurationForLevelOfDetail(config, 2).data(), config.data());
+    QCOMPARE(lodFilter.configurationForLevelOfDetail(config, 0).data(), config.data());
+
+    KisFilterConfigurationSP scaledConfig = lodFilter.configurationForLevelOfDetail(config, 2);
+    QVERIFY(scaledConfig.data() != config.data());
+
+    QCOMPARE(scaledConfig->getProperty("radius").type(), QVariant::Int);
+    QCOMPARE(scaledConfig->getInt("radius"), 3);
+    QCOMPARE(scaledConfig->getDouble("spacing"), 1.0); // clamped to the minimum
+    QCOMPARE(scaledConfig->getInt("strength"), 50);
+
+    // the original configuration is not modified
+    QCOMPARE(config->getInt("radius"), 10);
+    QCOMPARE(config->getDouble("spacing"), 2.0);
+
+    // the values loaded from XML are stored as strings
+    config->setProperty("radius", QString("16"));
+    config->setProperty("spacing", QString("12.0"));
+
+    scaledConfig = lodFilter.configurationForLevelOfDetail(config, 2);
+    QCOMPARE(scaledConfig->getInt("radius"), 4);
+    QCOMPARE(scaledConfig->getDouble("spacing"), 3.0);
+}
+
 
 SIMPLE_TEST_MAIN(KisFilterTest)
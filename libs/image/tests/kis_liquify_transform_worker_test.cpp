@@ -148,4 +148,124 @@ void KisLiquifyTransformWorkerTest::testIdentityTransform()
     TestUtil::checkQImage(result, "liquify_transform_test", "liquify_dev", "identity");
 }
 
+bool compareDevices(KisPaintDeviceSP dev1, KisPaintDeviceSP dev2)
+{
+    const QRect rc = dev1->exactBounds() | dev2->exactBounds();
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint,
+                                  dev1->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()),
+                                  dev2->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()))) {
+        qWarning() << "Devices differ, first different pixel:" << errpoint + rc.topLeft();
+        return false;
+    }
+
+    return true;
+}
+
+void KisLiquifyTransformWorkerTest::testParallelProcessing()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+
+    KisPaintDeviceSP srcDev = new KisPaintDevice(cs);
+    srcDev->convertFromQImage(image, 0);
+    // make the tile grid misaligned with the bands
+    srcDev->moveTo(13, 27);
+
+    KisLiquifyTransformWorker worker(srcDev->exactBounds(), 0, 8);
+
+    worker.translatePoints(QPointF(300, 300), QPointF(150, 400), 150, false, 0.2);
+    worker.rotatePoints(QPointF(600, 500), M_PI / 3, 200, false, 0.2);
+    worker.scalePoints(QPointF(400, 700), -0.5, 100, false, 0.2);
+
+    KisPaintDeviceSP serialDev = new KisPaintDevice(cs);
+    worker.setMaxThreadCount(1);
+    worker.run(srcDev, serialDev);
+
+    KisPaintDeviceSP parallelDev = new KisPaintDevice(cs);
+    worker.setMaxThreadCount(4);
+    worker.run(srcDev, parallelDev);
+
+    QVERIFY(compareDevices(serialDev, parallelDev));
+}
+
+void KisLiquifyTransformWorkerTest::testIncrementalProcessing()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+
+    KisPaintDeviceSP srcDev = new KisPaintDevice(cs);
+    srcDev->convertFromQImage(image, 0);
+
+    KisLiquifyTransformWorker worker(srcDev->exactBounds(), 0, 8);
+
+    KisPaintDeviceSP incrementalDev = new KisPaintDevice(cs);
+
+    // nothing has been rendered yet, so the full device is rendered
+    QVERIFY(worker.runIncremental(srcDev, incrementalDev).contains(srcDev->exactBounds()));
+
+    // no changes, no updates
+    QCOMPARE(worker.runIncremental(srcDev, incrementalDev), QRect());
+
+    // emulate a stroke, applying the changes after every dab
+    for (int i = 0; i < 10; i++) {
+        const QPointF pos(200 + 40 * i, 300 + 20 * i);
+
+        worker.translatePoints(pos, QPointF(20, 10), 60, false, 0.2);
+
+        const QRect changedRect = worker.runIncremental(srcDev, incrementalDev);
+        QVERIFY(!changedRect.isEmpty());
+        QVERIFY(!changedRect.contains(srcDev->exactBounds()));
+    }
+
+    worker.rotatePoints(QPointF(600, 500), M_PI / 3, 100, true, 0.5);
+    worker.undoPoints(QPointF(300, 350), 0.7, 80);
+    worker.runIncremental(srcDev, incrementalDev);
+
+    KisPaintDeviceSP fullDev = new KisPaintDevice(cs);
+    worker.run(srcDev, fullDev);
+
+    QVERIFY(compareDevices(incrementalDev, fullDev));
+}
+
+void KisLiquifyTransformWorkerTest::testUpdatePointsFrom()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+
+    KisPaintDeviceSP srcDev = new KisPaintDevice(cs);
+    srcDev->convertFromQImage(image, 0);
+
+    // the tool's worker and the copy the preview is rendered with
+    KisLiquifyTransformWorker toolWorker(srcDev->exactBounds(), 0, 8);
+    KisLiquifyTransformWorker previewWorker(toolWorker);
+
+    KisPaintDeviceSP previewDev = new KisPaintDevice(cs);
+    previewWorker.runIncremental(srcDev, previewDev);
+
+    for (int i = 0; i < 10; i++) {
+        const QPointF pos(200 + 40 * i, 300 + 20 * i);
+
+        toolWorker.translatePoints(pos, QPointF(20, 10), 60, false, 0.2);
+        previewWorker.updatePointsFrom(toolWorker);
+
+        const QRect changedRect = previewWorker.runIncremental(srcDev, previewDev);
+        QVERIFY(!changedRect.isEmpty());
+        QVERIFY(!changedRect.contains(srcDev->exactBounds()));
+    }
+
+    QVERIFY(previewWorker == toolWorker);
+
+    KisPaintDeviceSP fullDev = new KisPaintDevice(cs);
+    toolWorker.run(srcDev, fullDev);
+
+    QVERIFY(compareDevices(previewDev, fullDev));
+
+    // a different grid makes the next update a full one
+    toolWorker.translate(QPointF(10, 10));
+    previewWorker.updatePointsFrom(toolWorker);
+    QVERIFY(previewWorker.runIncremental(srcDev, previewDev).contains(fullDev->exactBounds()));
+}
+
 SIMPLE_TEST_MAIN(KisLiquifyTransformWorkerTest)
@@ -16,6 +16,9 @@ private Q_SLOTS:
     void testPoints();
     void testPointsQImage();
     void testIdentityTransform();
+    void testParallelProcessing();
+    void testIncrementalProcessing();
+    void testUpdatePointsFrom();
 };
 
 #endif /* __KIS_LIQUIFY_TRANSFORM_WORKER_TEST_H */
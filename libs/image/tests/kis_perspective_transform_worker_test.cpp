@@ -60,4 +60,51 @@ void KisPerspectiveTransformWorkerTest::testSimpleTransform()
     t.checkLayer("simple_transform");
 }
 
+void KisPerspectiveTransformWorkerTest::testParallelProcessing_data()
+{
+    QTest::addColumn<int>("sampleType");
+
+    QTest::newRow("nearest") << int(KisPerspectiveTransformWorker::NearestNeighbour);
+    QTest::newRow("bilinear") << int(KisPerspectiveTransformWorker::Bilinear);
+}
+
+void KisPerspectiveTransformWorkerTest::testParallelProcessing()
+{
+    QFETCH(int, sampleType);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+
+    KisPaintDeviceSP serialDev = new KisPaintDevice(cs);
+    serialDev->convertFromQImage(image, 0);
+    // make the tile grid misaligned with the patches
+    serialDev->moveTo(13, 27);
+
+    KisPaintDeviceSP parallelDev = new KisPaintDevice(*serialDev);
+
+    QPointF center(558, 438);
+    qreal aX = 0.72;
+    qreal aY = 0.4;
+    qreal z = 1024;
+
+    KisPerspectiveTransformWorker serialWorker(serialDev, center, aX, aY, z, false, 0);
+    serialWorker.setMaxThreadCount(1);
+    serialWorker.run(KisPerspectiveTransformWorker::SampleType(sampleType));
+
+    KisPerspectiveTransformWorker parallelWorker(parallelDev, center, aX, aY, z, false, 0);
+    parallelWorker.setMaxThreadCount(4);
+    parallelWorker.run(KisPerspectiveTransformWorker::SampleType(sampleType));
+
+    const QRect rc = serialDev->exactBounds();
+    QCOMPARE(parallelDev->exactBounds(), rc);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint,
+                                  serialDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()),
+                                  parallelDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()))) {
+        QFAIL(QString("Parallel transformation differs from the serial one, first different pixel: %1,%2 \n")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 SIMPLE_TEST_MAIN(KisPerspectiveTransformWorkerTest)
@@ -14,6 +14,8 @@ class KisPerspectiveTransformWorkerTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void testSimpleTransform();
+    void testParallelProcessing_data();
+    void testParallelProcessing();
 };
 
 #endif /* __KIS_PERSPECTIVE_TRANSFORM_WORKER_TEST_H */
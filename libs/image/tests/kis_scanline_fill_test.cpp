@@ -12,6 +12,7 @@
 #include <floodfill/kis_scanline_fill.h>
 #include <floodfill/kis_fill_interval.h>
 #include <floodfill/kis_fill_interval_map.h>
+#include <floodfill/kis_gap_map_cache.h>
 
 #include <KoColor.h>
 #include <KoColorSpace.h>
@@ -20,6 +21,9 @@
 #include "kis_paint_device.h"
 #include "kis_default_bounds.h"
 #include "kis_pixel_selection.h"
+#include "kis_image.h"
+
+#include <random>
 
 void KisScanlineFillTest::testFillGeneral(const QVector<KisFillInterval> &initialBackwardIntervals,
                                           const QVector<QColor> &expectedResult,
@@ -356,4 +360,196 @@ void KisScanlineFillTest::testGapClosingFill()
     testGapClosingFillGeneral(QPoint(147, 97), 32);
 }
 
+namespace {
+QImage gapClosingFillSelection(KisPaintDeviceSP dev, const QRect &imageRect, const QPoint &seed, int gapSize)
+{
+    KisPixelSelectionSP pixelSelection = new KisPixelSelection(new KisSelectionDefaultBounds(dev));
+
+    KisScanlineFill gc(dev, seed, imageRect);
+    gc.setThreshold(1);
+    gc.setOpacitySpread(100);
+    gc.setCloseGap(gapSize);
+    gc.fillSelection(pixelSelection);
+
+    return pixelSelection->convertToQImage(0,
+                                           imageRect.x(), imageRect.y(),
+                                           imageRect.width(), imageRect.height());
+}
+}
+
+void KisScanlineFillTest::testGapMapCache()
+{
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    QImage srcImage(TestUtil::fetchDataFileLazy("close_gap_low.png"));
+    QVERIFY(!srcImage.isNull());
+    dev->convertFromQImage(srcImage, 0, 0, 0);
+
+    const QRect imageRect = srcImage.rect();
+    const QPoint seed(103, 94);
+    const int gapSize = 3;
+
+    KisGapMapCache::instance()->clear();
+
+    const QImage reference = gapClosingFillSelection(dev, imageRect, seed, gapSize);
+    QCOMPARE(KisGapMapCache::instance()->numEntries(), 1);
+
+    // the unchanged lineart reuses the map as it is
+    QCOMPARE(gapClosingFillSelection(dev, imageRect, seed, gapSize), reference);
+    QCOMPARE(KisGapMapCache::instance()->numEntries(), 1);
+
+    // draw a line across the filled region, the map must be revalidated
+    dev->fill(QRect(0, 90, imageRect.width(), 2), KoColor(Qt::black, cs));
+
+    const QImage cached = gapClosingFillSelection(dev, imageRect, seed, gapSize);
+
+    KisGapMapCache::instance()->clear();
+    const QImage uncached = gapClosingFillSelection(dev, imageRect, seed, gapSize);
+
+    QCOMPARE(cached, uncached);
+    QVERIFY(cached != reference);
+
+    // a copy of the same lineart reuses the map as well
+    KisPaintDeviceSP copy = new KisPaintDevice(*dev);
+    QCOMPARE(gapClosingFillSelection(copy, imageRect, seed, gapSize), uncached);
+
+    KisGapMapCache::instance()->clear();
+}
+
+void KisScanlineFillTest::testGapMapCacheLimits()
+{
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KisGapMap::FillOpacityFunc opacityFunc =
+        [] (KisPaintDevice*, const QRect&) { return false; };
+
+    auto createMap = [&] (int size) {
+        return KisGapMapSP(new KisGapMap(3, QRect(0, 0, size, size), opacityFunc));
+    };
+
+    QVector<KisPaintDeviceSP> devices;
+    for (int i = 0; i < 4; i++) {
+        devices << new KisPaintDevice(cs);
+    }
+
+    const qint64 mapSize = createMap(64)->memoryUsage();
+
+    // the memory limit is reached before the limit of the entries
+    KisGapMapCache cache(3, 2 * mapSize);
+
+    cache.store("key", KisGapMapCache::SourceState(devices[0], KisPaintDeviceSP()), createMap(64));
+    cache.store("key", KisGapMapCache::SourceState(devices[1], KisPaintDeviceSP()), createMap(64));
+    QCOMPARE(cache.numEntries(), 2);
+    QCOMPARE(cache.memoryUsage(), 2 * mapSize);
+
+    cache.store("key", KisGapMapCache::SourceState(devices[2], KisPaintDeviceSP()), createMap(64));
+    QCOMPARE(cache.numEntries(), 2);
+    QCOMPARE(cache.memoryUsage(), 2 * mapSize);
+
+    // the map that is bigger than the limit is not stored at all
+    cache.store("key", KisGapMapCache::SourceState(devices[3], KisPaintDeviceSP()), createMap(128));
+    QCOMPARE(cache.numEntries(), 2);
+
+    // only two maps are left in the cache
+    bool sourceChanged = false;
+    const KisGapMapCache::SourceState state0(devices[0], KisPaintDeviceSP());
+    QVERIFY(cache.take("key", 3, QRect(0, 0, 64, 64), state0, &sourceChanged));
+    QVERIFY(cache.take("key", 3, QRect(0, 0, 64, 64), state0, &sourceChanged));
+    QVERIFY(!cache.take("key", 3, QRect(0, 0, 64, 64), state0, &sourceChanged));
+
+    cache.store("key", KisGapMapCache::SourceState(devices[1], KisPaintDeviceSP()), createMap(64));
+    QCOMPARE(cache.numEntries(), 1);
+
+    cache.setMaxMemoryUsage(0);
+    QCOMPARE(cache.numEntries(), 0);
+
+    // the maps of the deleted devices are dropped
+    cache.setMaxMemoryUsage(4 * mapSize);
+    cache.store("key", KisGapMapCache::SourceState(devices[0], KisPaintDeviceSP()), createMap(64));
+    QCOMPARE(cache.numEntries(), 1);
+
+    devices.clear();
+    QVERIFY(!cache.take("key", 3, QRect(0, 0, 64, 64), state0, &sourceChanged));
+    QCOMPARE(cache.numEntries(), 0);
+
+    // a closed image drops all the cached maps
+    KisPaintDeviceSP imageDevice = new KisPaintDevice(cs);
+    KisGapMapCache::instance()->store("key", KisGapMapCache::SourceState(imageDevice, KisPaintDeviceSP()), createMap(64));
+    QCOMPARE(KisGapMapCache::instance()->numEntries(), 1);
+
+    {
+        KisImageSP image = new KisImage(0, 64, 64, cs, "test");
+    }
+
+    QCOMPARE(KisGapMapCache::instance()->numEntries(), 0);
+}
+
+void KisScanlineFillTest::testParallelFill()
+{
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect boundingRect(0, 0, 300, 300);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    // a noisy "lineart" with a lot of winding regions crossing the bands
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 99);
+
+    for (int y = boundingRect.top(); y <= boundingRect.bottom(); y++) {
+        for (int x = boundingRect.left(); x <= boundingRect.right(); x++) {
+            if (dist(gen) < 40) {
+                dev->setPixel(x, y, KoColor(Qt::black, cs));
+            }
+        }
+    }
+
+    auto fillSelection = [&] (const QPoint &seed, bool parallel, QRect *fillExtent) {
+        KisPixelSelectionSP pixelSelection = new KisPixelSelection(new KisSelectionDefaultBounds(dev));
+
+        KisScanlineFill gc(dev, seed, boundingRect);
+        gc.setParallelFillEnabled(parallel);
+        gc.testingSetParallelFillBandHeight(parallel ? 7 : 0);
+        gc.fillSelection(pixelSelection);
+
+        *fillExtent = gc.fillExtent();
+
+        return pixelSelection->convertToQImage(0, boundingRect.x(), boundingRect.y(),
+                                               boundingRect.width(), boundingRect.height());
+    };
+
+    const QVector<QPoint> seeds({QPoint(0, 0), QPoint(150, 150), QPoint(299, 100), QPoint(10, 296)});
+
+    Q_FOREACH (const QPoint &seed, seeds) {
+        QRect serialExtent;
+        QRect parallelExtent;
+
+        const QImage serialResult = fillSelection(seed, false, &serialExtent);
+        const QImage parallelResult = fillSelection(seed, true, &parallelExtent);
+
+        QCOMPARE(parallelExtent, serialExtent);
+        QCOMPARE(parallelResult, serialResult);
+    }
+
+    // fill the device itself
+    {
+        KisPaintDeviceSP serialDev = new KisPaintDevice(*dev);
+        KisPaintDeviceSP parallelDev = new KisPaintDevice(*dev);
+
+        const QPoint seed(150, 150);
+
+        KisScanlineFill serialFill(serialDev, seed, boundingRect);
+        serialFill.setParallelFillEnabled(false);
+        serialFill.fill(KoColor(Qt::red, cs));
+
+        KisScanlineFill parallelFill(parallelDev, seed, boundingRect);
+        parallelFill.testingSetParallelFillBandHeight(13);
+        parallelFill.fill(KoColor(Qt::red, cs));
+
+        QCOMPARE(parallelFill.fillExtent(), serialFill.fillExtent());
+
+        QPoint errorPoint;
+        QVERIFY(TestUtil::comparePaintDevices(errorPoint, serialDev, parallelDev));
+    }
+}
+
 SIMPLE_TEST_MAIN(KisScanlineFillTest)
@@ -28,6 +28,10 @@ private Q_SLOTS:
     void testExternalFill();
 
     void testGapClosingFill();
+    void testGapMapCache();
+    void testGapMapCacheLimits();
+
+    void testParallelFill();
 
 private:
     void testFillGeneral(const QVector<KisFillInterval> &initialBackwardIntervals,
@@ -278,5 +278,46 @@ void KisSimpleUpdateQueueTest::testSpontaneousJobsCompression()
     QCOMPARE(jobsList[0], job3);
 }
 
+void KisSimpleUpdateQueueTest::testPriorityPoint()
+{
+    KisTestableUpdaterContext context(1);
+
+    QRect imageRect(0,0,200,200);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    QRect dirtyRect1(0,0,50,50);
+    QRect dirtyRect2(150,150,50,50);
+
+    KisTestableSimpleUpdateQueue queue;
+
+    queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+    queue.addUpdateJob(paintLayer, dirtyRect2, imageRect, 0);
+
+    /**
+     * The newer update is closer to the priority point,
+     * so it should be started first
+     */
+    queue.setPriorityPoint(QPointF(175, 175));
+    queue.processQueue(context);
+
+    QVector<KisUpdateJobItem*> jobs = context.getJobs();
+
+    QCOMPARE(jobs.size(), 1);
+    QVERIFY(checkWalker(jobs[0]->walker(), dirtyRect2));
+
+    KisWalkersList walkersList = queue.getWalkersList();
+
+    QCOMPARE(walkersList.size(), 1);
+    QVERIFY(checkWalker(walkersList[0], dirtyRect1));
+}
+
 KISTEST_MAIN(KisSimpleUpdateQueueTest)
 
@@ -962,6 +962,57 @@ void KisTransformWorkerTest::testPartialProcessing()
     TestUtil::checkQImage(result, "transform_test", "partial", "single");
 }
 
+void KisTransformWorkerTest::testParallelProcessing_data()
+{
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<qreal>("shear");
+    QTest::addColumn<qreal>("rotation");
+
+    QTest::newRow("scale-up") << 1.387 << 0.0 << 0.0;
+    QTest::newRow("scale-down") << 0.613 << 0.0 << 0.0;
+    QTest::newRow("shear") << 1.0 << 0.479 << 0.0;
+    QTest::newRow("rotate") << 1.0 << 0.0 << M_PI / 6.0;
+    QTest::newRow("all") << 1.379 << 0.479 << M_PI / 6.0;
+}
+
+void KisTransformWorkerTest::testParallelProcessing()
+{
+    QFETCH(qreal, scale);
+    QFETCH(qreal, shear);
+    QFETCH(qreal, rotation);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+
+    KisPaintDeviceSP serialDev = new KisPaintDevice(cs);
+    serialDev->convertFromQImage(image, 0);
+    // make the tile grid misaligned with the processed lines
+    serialDev->moveTo(13, 27);
+
+    KisPaintDeviceSP parallelDev = new KisPaintDevice(*serialDev);
+
+    QScopedPointer<KisFilterStrategy> filter(new KisBicubicFilterStrategy());
+
+    KisTransformWorker serialWorker(serialDev, scale, scale, shear, shear, rotation, 0, 0, 0, filter.data());
+    serialWorker.setParallelProcessingEnabled(false);
+    serialWorker.run();
+
+    KisTransformWorker parallelWorker(parallelDev, scale, scale, shear, shear, rotation, 0, 0, 0, filter.data());
+    QVERIFY(parallelWorker.parallelProcessingEnabled());
+    parallelWorker.run();
+
+    const QRect rc = serialDev->exactBounds();
+    QCOMPARE(parallelDev->exactBounds(), rc);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint,
+                                  serialDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()),
+                                  parallelDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()))) {
+        QFAIL(QString("Parallel transformation differs from the serial one, first different pixel: %1,%2 \n")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 void KisTransformWorkerTest::testXScaleUpPixelAlignment_data()
 {
     QTest::addColumn<int>("newSize");
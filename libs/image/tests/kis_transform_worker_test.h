@@ -52,6 +52,9 @@ private Q_SLOTS:
 
     void testPartialProcessing();
 
+    void testParallelProcessing_data();
+    void testParallelProcessing();
+
     void testXScaleUpPixelAlignment_data();
     void testXScaleUpPixelAlignment();
 
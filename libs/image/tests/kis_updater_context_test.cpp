@@ -14,6 +14,7 @@
 #include <KoColorSpaceRegistry.h>
 
 #include "kis_paint_layer.h"
+#include "kis_group_layer.h"
 
 #include "kis_merge_walker.h"
 #include "kis_updater_context.h"
@@ -85,6 +86,96 @@ void KisUpdaterContextTest::testJobInterference()
     }
 }
 
+namespace {
+
+/**
+ * A layer that reads the whole image on every update, like
+ * a layer with a transform mask does
+ */
+class WideAccessPaintLayer : public KisPaintLayer
+{
+public:
+    WideAccessPaintLayer(KisImageWSP image, const QString &name, quint8 opacity)
+        : KisPaintLayer(image, name, opacity)
+    {
+    }
+
+    QRect accessRect(const QRect &rect, PositionToFilthy pos = N_FILTHY) const override {
+        Q_UNUSED(pos);
+        return rect | image()->bounds();
+    }
+};
+
+}
+
+void KisUpdaterContextTest::testNodeLocalAccessRects()
+{
+    KisTestableUpdaterContext context(3);
+
+    QRect imageRect(0,0,100,100);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "paint", OPACITY_OPAQUE_U8);
+    KisGroupLayerSP groupLayer = new KisGroupLayer(image, "group", OPACITY_OPAQUE_U8);
+    KisPaintLayerSP wideLayer = new WideAccessPaintLayer(image, "wide", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->addNode(groupLayer);
+    image->addNode(wideLayer, groupLayer);
+    image->unlock();
+
+    QRect dirtyRect1(0,0,50,100);
+    KisBaseRectsWalkerSP walker1 = new KisMergeWalker(imageRect);
+    walker1->collectRects(wideLayer, dirtyRect1);
+
+    QCOMPARE(walker1->accessRect(), imageRect);
+    QVERIFY(!walker1->hasUntrackedAccess());
+
+    context.lock();
+    context.addMergeJob(walker1);
+    context.unlock();
+
+    // the total access rects intersect only on the wide layer,
+    // which the second walker doesn't touch --- allowed
+    {
+        QRect dirtyRect(60,0,40,100);
+        KisBaseRectsWalkerSP walker = new KisMergeWalker(imageRect);
+        walker->collectRects(paintLayer, dirtyRect);
+
+        QVERIFY(walker->accessRect().intersects(walker1->accessRect()));
+        QVERIFY(!walker->nodeAccessRects().contains(wideLayer.data()));
+
+        context.lock();
+        QVERIFY(context.isJobAllowed(walker));
+        context.unlock();
+    }
+
+    // overlapping on the root projection --- forbidden
+    {
+        QRect dirtyRect(30,0,40,100);
+        KisBaseRectsWalkerSP walker = new KisMergeWalker(imageRect);
+        walker->collectRects(paintLayer, dirtyRect);
+
+        context.lock();
+        QVERIFY(!context.isJobAllowed(walker));
+        context.unlock();
+    }
+
+    // passing through the wide layer --- forbidden
+    {
+        QRect dirtyRect(60,0,40,100);
+        KisBaseRectsWalkerSP walker = new KisMergeWalker(imageRect);
+        walker->collectRects(wideLayer, dirtyRect);
+
+        context.lock();
+        QVERIFY(!context.isJobAllowed(walker));
+        context.unlock();
+    }
+}
+
 void KisUpdaterContextTest::testSnapshot()
 {
     KisTestableUpdaterContext context(3);
@@ -202,9 +293,22 @@ private:
     QAtomicInt &m_hadConcurrency;
 };
 
+void KisUpdaterContextTest::stressTestExclusiveJobs_data()
+{
+    QTest::addColumn<bool>("useWorkStealingPool");
+
+    QTest::newRow("qthreadpool") << false;
+    QTest::newRow("work-stealing") << true;
+}
+
 void KisUpdaterContextTest::stressTestExclusiveJobs()
 {
+    QFETCH(bool, useWorkStealingPool);
+
     KisUpdaterContext context(NUM_THREADS);
+    context.setUseWorkStealingPool(useWorkStealingPool);
+    QCOMPARE(context.useWorkStealingPool(), useWorkStealingPool);
+
     QAtomicInt counter;
     QAtomicInt hadConcurrency;
 
@@ -15,7 +15,9 @@ class KisUpdaterContextTest : public QObject
 
 private Q_SLOTS:
     void testJobInterference();
+    void testNodeLocalAccessRects();
     void testSnapshot();
+    void stressTestExclusiveJobs_data();
     void stressTestExclusiveJobs();
 };
 
@@ -336,5 +336,57 @@ void KisWarpTransformWorkerTest::testNeedChangeRects()
     QCOMPARE(worker.approxChangeRect(d.bounds.toAlignedRect()), QRect(-44,-44, 982,986));
 }
 
+void KisWarpTransformWorkerTest::testGridLinePositions()
+{
+    QCOMPARE(GridIterationTools::calcGridLinePositions(1, 7, 4), QVector<int>({1, 4, 7}));
+    QCOMPARE(GridIterationTools::calcGridLinePositions(1, 9, 4), QVector<int>({1, 4, 8, 9}));
+    QCOMPARE(GridIterationTools::calcGridLinePositions(-1, 9, 4), QVector<int>({-1, 0, 4, 8, 9}));
+
+    for (int start = -9; start < 9; start++) {
+        for (int end = start + 1; end < 40; end++) {
+            QCOMPARE(GridIterationTools::calcGridLinePositions(start, end, 8).size(),
+                     GridIterationTools::calcGridDimension(start, end, 8));
+        }
+    }
+}
+
+void KisWarpTransformWorkerTest::testParallelProcessing()
+{
+    WarpTransformWorkerData d;
+
+    // make the tile grid misaligned with the bands
+    d.dev->moveTo(13, 27);
+
+    KisPaintDeviceSP srcDev = new KisPaintDevice(*d.dev);
+    KisPaintDeviceSP serialDev = new KisPaintDevice(d.dev->colorSpace());
+    KisPaintDeviceSP parallelDev = new KisPaintDevice(d.dev->colorSpace());
+
+    KisWarpTransformWorker serialWorker(KisWarpTransformWorker::RIGID_TRANSFORM,
+                                        d.origPoints,
+                                        d.transfPoints,
+                                        d.alpha,
+                                        d.updater);
+    serialWorker.setMaxThreadCount(1);
+    serialWorker.run(srcDev, serialDev);
+
+    KisWarpTransformWorker parallelWorker(KisWarpTransformWorker::RIGID_TRANSFORM,
+                                          d.origPoints,
+                                          d.transfPoints,
+                                          d.alpha,
+                                          d.updater);
+    parallelWorker.setMaxThreadCount(4);
+    parallelWorker.run(srcDev, parallelDev);
+
+    const QRect rc = serialDev->exactBounds();
+    QCOMPARE(parallelDev->exactBounds(), rc);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint,
+                                  serialDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()),
+                                  parallelDev->convertToQImage(0, rc.x(), rc.y(), rc.width(), rc.height()))) {
+        QFAIL(QString("Parallel warp differs from the serial one, first different pixel: %1,%2 \n")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
 
 SIMPLE_TEST_MAIN(KisWarpTransformWorkerTest)
@@ -24,6 +24,8 @@ private Q_SLOTS:
     void testBackwardInterpolatorExtrapolation();
 
     void testNeedChangeRects();
+    void testGridLinePositions();
+    void testParallelProcessing();
 };
 
 #endif /* __KIS_WARP_TRANSFORM_WORKER_TEST_H */
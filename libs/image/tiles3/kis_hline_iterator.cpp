@@ -25,6 +25,7 @@ KisHLineIterator2::KisHLineIterator2(KisDataManager *dataManager, qint32 x, qint
     m_right = x + w - 1;
 
     m_top = y;
+    m_bottom = y;
 
     m_havePixels = (w == 0) ? false : true;
     if (m_left > m_right) {
@@ -49,10 +50,30 @@ KisHLineIterator2::KisHLineIterator2(KisDataManager *dataManager, qint32 x, qint
     for (quint32 i = 0; i < m_tilesCacheSize; i++){
         fetchTileDataForCache(m_tilesCache[i], m_leftCol + i, m_row);
     }
+
     m_index = 0;
     switchToTile(m_leftInLeftmostTile);
 }
 
+void KisHLineIterator2::setNumIteratedRows(qint32 numRows)
+{
+    if (!m_havePixels) return;
+
+    m_bottom = m_top + qMax(1, numRows) - 1;
+    prefetchNextRow();
+}
+
+void KisHLineIterator2::prefetchNextRow()
+{
+    const qint32 nextRowTop = (m_row + 1) * KisTileData::HEIGHT;
+    if (nextRowTop > m_bottom) return;
+
+    const qint32 nextRowBottom = qMin(nextRowTop + KisTileData::HEIGHT - 1, m_bottom);
+    const QRect nextRowRect(m_left, nextRowTop,
+                            m_right - m_left + 1, nextRowBottom - nextRowTop + 1);
+    m_dataManager->prefetchRect(nextRowRect);
+}
+
 void KisHLineIterator2::resetPixelPos()
 {
     m_x = m_left;
@@ -107,6 +128,7 @@ void KisHLineIterator2::nextRow()
         ++m_row;
         m_yInTile = 0;
         preallocateTiles();
+        prefetchNextRow();
     }
     m_index = 0;
     switchToTile(m_leftInLeftmostTile);
@@ -40,6 +40,7 @@ public:
 
     void resetPixelPos() override;
     void resetRowPos() override;
+    void setNumIteratedRows(qint32 numRows) override;
 
 private:
     qint32 m_offsetX {0};
@@ -57,6 +58,7 @@ private:
     qint32 m_right {0};
     qint32 m_left {0};
     qint32 m_top {0};
+    qint32 m_bottom {0}; // the last row the prefetching may reach
     qint32 m_leftCol {0};
     qint32 m_rightCol {0};
 
@@ -73,5 +75,6 @@ private:
     void switchToTile(qint32 xInTile);
     void fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint32 row);
     void preallocateTiles();
+    void prefetchNextRow();
 };
 #endif
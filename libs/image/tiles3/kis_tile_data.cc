@@ -68,6 +68,19 @@ KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataSt
 }
 
 
+KisTileData::KisTileData(qint32 pixelSize, KisTileDataStore *store)
+    : m_state(NORMAL),
+      m_mementoFlag(0),
+      m_age(0),
+      m_usersCount(0),
+      m_refCount(0),
+      m_pixelSize(pixelSize),
+      m_store(store)
+{
+    m_data = 0;
+}
+
+
 /**
  * Duplicating tiledata
  * + new object loaded in memory
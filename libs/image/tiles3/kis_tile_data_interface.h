@@ -93,6 +93,13 @@ public:
 private:
     KisTileData(const KisTileData& rhs, bool checkFreeMemory = true);
 
+    /**
+     * Creates a tile data that owns no pixel memory. Its content
+     * should be put into the swap store right after construction
+     * (see KisTileDataStore::createSwappedTileData())
+     */
+    KisTileData(qint32 pixelSize, KisTileDataStore *store);
+
 public:
     ~KisTileData();
 
@@ -13,6 +13,7 @@
 #include "kis_tile_data_store.h"
 #include "kis_tile_data.h"
 #include "kis_debug.h"
+#include "KisUsageLogger.h"
 
 #include "kis_tile_data_store_iterators.h"
 
@@ -58,17 +59,23 @@ qint64 __preclone_miss_age = 0;
 KisTileDataStore::KisTileDataStore()
     : m_pooler(this),
       m_swapper(this),
+      m_backgroundLoader(this),
       m_numTiles(0),
       m_memoryMetric(0),
       m_counter(1),
-      m_clockIndex(1)
+      m_clockIndex(1),
+      m_numCorruptedTiles(0)
 {
     m_pooler.start();
     m_swapper.start();
+    m_prefetcher.start();
+    m_backgroundLoader.start(QThread::IdlePriority);
 }
 
 KisTileDataStore::~KisTileDataStore()
 {
+    m_backgroundLoader.terminateLoader();
+    m_prefetcher.terminatePrefetcher();
     m_pooler.terminatePooler();
     m_swapper.terminateSwapper();
 
@@ -99,6 +106,8 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
     stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize;
 
     stats.swapSize = m_swappedStore.totalSwapMemoryUsed();
+    stats.swapFileSize = m_swappedStore.swapFileSize();
+    stats.swapReclaimedSize = m_swappedStore.swapReclaimedSize();
 
     return stats;
 }
@@ -171,6 +180,26 @@ KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *def
     return td;
 }
 
+KisTileData *KisTileDataStore::createSwappedTileData(qint32 pixelSize, const quint8 *data, qint32 dataSize)
+{
+    /**
+     * The tile data is not registered in the store until it is
+     * swapped-in, so no one except the caller can access it
+     * and we don't need to take any locks here.
+     *
+     * The tile data is created without any pixel memory, it will
+     * be allocated by the swap-in routine on the first access.
+     */
+    KisTileData *td = new KisTileData(pixelSize, this);
+
+    if (!m_swappedStore.tryStoreCompressedTileData(td, data, dataSize)) {
+        delete td;
+        td = 0;
+    }
+
+    return td;
+}
+
 KisTileData *KisTileDataStore::duplicateTileData(KisTileData *rhs)
 {
     KisTileData *td = 0;
@@ -243,7 +272,9 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
         if (!td->data()) {
             td->m_swapLock.lockForWrite();
 
-            m_swappedStore.swapInTileData(td);
+            if (!m_swappedStore.swapInTileData(td)) {
+                reportCorruptedTileData();
+            }
             registerTileDataImp(td);
 
             td->m_swapLock.unlock();
@@ -259,6 +290,29 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
     }
 }
 
+void KisTileDataStore::reportCorruptedTileData()
+{
+    /**
+     * The lazily loaded tiles are decompressed on the first access, when
+     * there is no one to return the error to anymore. Log only the first
+     * failure, a broken file may have lots of such tiles.
+     */
+    if (m_numCorruptedTiles.fetchAndAddOrdered(1) == 0) {
+        warnTiles << "Failed to decompress the tile data loaded from the swap, the tile is reset to zero";
+        KisUsageLogger::log("WARNING: failed to decompress the tile data, the document may be corrupted");
+    }
+}
+
+void KisTileDataStore::loadInBackground(KisTileData *td)
+{
+    m_backgroundLoader.loadTileData(td);
+}
+
+void KisTileDataStore::prefetchTiles(const QVector<KisTileSP> &tiles)
+{
+    m_prefetcher.prefetch(tiles);
+}
+
 bool KisTileDataStore::trySwapTileData(KisTileData *td)
 {
     /**
@@ -379,3 +433,23 @@ void KisTileDataStore::testingResumePooler()
 {
     m_pooler.start();
 }
+
+void KisTileDataStore::testingWaitForPrefetcher()
+{
+    m_prefetcher.testingWaitForIdle();
+}
+
+void KisTileDataStore::testingWaitForBackgroundLoader()
+{
+    m_backgroundLoader.testingWaitForIdle();
+}
+
+void KisTileDataStore::testingSuspendBackgroundLoader()
+{
+    m_backgroundLoader.testingSuspend();
+}
+
+void KisTileDataStore::testingResumeBackgroundLoader()
+{
+    m_backgroundLoader.testingResume();
+}
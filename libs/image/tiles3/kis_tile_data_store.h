@@ -15,6 +15,8 @@
 
 #include "kis_tile_data_pooler.h"
 #include "swap/kis_tile_data_swapper.h"
+#include "swap/kis_tile_data_prefetcher.h"
+#include "swap/kis_tile_data_background_loader.h"
 #include "swap/kis_swapped_data_store.h"
 #include "3rdparty/lock_free_map/concurrent_map.h"
 
@@ -42,6 +44,8 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapFileSize;
+        qint64 swapReclaimedSize;
     };
 
     MemoryStatistics memoryStatistics();
@@ -69,6 +73,33 @@ public:
         m_swapper.checkFreeMemory();
     }
 
+    /**
+     * Returns true if at least one tile data is currently swapped
+     * out. Used as a fast path to avoid prefetching when there is
+     * nothing to prefetch.
+     */
+    inline bool hasSwappedTiles() const
+    {
+        return m_swappedStore.numTiles() > 0;
+    }
+
+    /**
+     * Asynchronously loads the \p tiles from the swap file in a
+     * background thread. The tiles, which are already present in
+     * memory are skipped.
+     */
+    void prefetchTiles(const QVector<KisTileSP> &tiles);
+
+    /**
+     * Returns the number of tile datas that could not be decompressed
+     * when they were loaded from the swap, e.g. the lazily loaded tiles
+     * of a corrupted file. The content of such tiles is reset to zero.
+     */
+    inline qint32 numCorruptedTiles() const
+    {
+        return m_numCorruptedTiles.loadAcquire();
+    }
+
     /**
      * \see m_memoryMetric
      */
@@ -91,6 +122,25 @@ public:
         return allocTileData(pixelSize, defPixel);
     }
 
+    /**
+     * Creates a tile data, whose content is stored in the swap store
+     * in a compressed form right from the beginning. The \p data should
+     * be in the format of KisTileCompressor2. It is decompressed when the
+     * tile data is accessed for the first time.
+     *
+     * Returns null if the swap store cannot accept the data, then the
+     * caller should decompress the data itself.
+     */
+    KisTileData* createSwappedTileData(qint32 pixelSize, const quint8 *data, qint32 dataSize);
+
+    /**
+     * Queues a tile data created by createSwappedTileData() for
+     * decompression in a background thread, when the application
+     * is idle. Should be called after the tile data has been
+     * attached to its tile.
+     */
+    void loadInBackground(KisTileData *td);
+
     // Called by The Memento Manager after every commit
     inline void kickPooler()
     {
@@ -139,6 +189,8 @@ private:
     inline void unregisterTileDataImp(KisTileData *td);
     void freeRegisteredTiles();
 
+    void reportCorruptedTileData();
+
     friend class DeadlockyThread;
     friend class KisLowMemoryTests;
     void debugSwapAll();
@@ -150,9 +202,18 @@ private:
 
     friend class KisLowMemoryBenchmark;
     void testingRereadConfig();
+
+    void testingWaitForPrefetcher();
+
+    friend class KisTileCompressorsTest;
+    void testingWaitForBackgroundLoader();
+    void testingSuspendBackgroundLoader();
+    void testingResumeBackgroundLoader();
 private:
     KisTileDataPooler m_pooler;
     KisTileDataSwapper m_swapper;
+    KisTileDataPrefetcher m_prefetcher;
+    KisTileDataBackgroundLoader m_backgroundLoader;
 
     friend class KisTileDataStoreTest;
     friend class KisTileDataPoolerTest;
@@ -167,6 +228,7 @@ private:
     QAtomicInt m_memoryMetric;
     QAtomicInt m_counter;
     QAtomicInt m_clockIndex;
+    QAtomicInt m_numCorruptedTiles;
     ConcurrentMap<int, KisTileData*> m_tileDataMap;
     QReadWriteLock m_iteratorLock;
 };
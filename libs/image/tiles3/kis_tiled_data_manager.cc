@@ -130,7 +130,7 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
 
     return retval;
 }
-bool KisTiledDataManager::read(QIODevice *stream)
+bool KisTiledDataManager::read(QIODevice *stream, bool lazy)
 {
     clear();
 
@@ -169,7 +169,11 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
     bool readSuccess = true;
     for (quint32 i = 0; i < numTiles; i++) {
-        if (!compressor->readTile(stream, this)) {
+        const bool result = lazy ?
+            compressor->readTileLazily(stream, this) :
+            compressor->readTile(stream, this);
+
+        if (!result) {
             readSuccess = false;
         }
     }
@@ -178,6 +182,18 @@ bool KisTiledDataManager::read(QIODevice *stream)
     return readSuccess;
 }
 
+void KisTiledDataManager::setTileData(qint32 col, qint32 row, KisTileData *td)
+{
+    const bool wasDeleted = m_hashTable->deleteTile(col, row);
+
+    KisTileSP tile = KisTileSP(new KisTile(col, row, td, m_mementoManager));
+    m_hashTable->addTile(tile);
+
+    if (!wasDeleted) {
+        m_extentManager.notifyTileAdded(col, row);
+    }
+}
+
 bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles)
 {
     QString buffer;
@@ -691,6 +707,39 @@ void KisTiledDataManager::writeBytes(const quint8 *data,
     writeBytesBody(data, x, y, width, height, dataRowStride);
 }
 
+void KisTiledDataManager::prefetchRect(const QRect &rect) const
+{
+    if (rect.isEmpty() || !KisTileDataStore::instance()->hasSwappedTiles()) return;
+
+    QVector<KisTileSP> tiles;
+
+    {
+        QReadLocker locker(&m_lock);
+
+        const qint32 firstColumn = xToCol(rect.left());
+        const qint32 lastColumn = xToCol(rect.right());
+        const qint32 firstRow = yToRow(rect.top());
+        const qint32 lastRow = yToRow(rect.bottom());
+
+        for (qint32 row = firstRow; row <= lastRow; row++) {
+            for (qint32 column = firstColumn; column <= lastColumn; column++) {
+                KisTileSP tile = m_hashTable->getExistingTile(column, row);
+
+                /**
+                 * The check for the tile data is racy, but it is only a hint
+                 * to avoid queueing tiles that are already in memory. The
+                 * prefetcher checks it properly under the swap lock.
+                 */
+                if (tile && !tile->tileData()->data()) {
+                    tiles.append(tile);
+                }
+            }
+        }
+    }
+
+    KisTileDataStore::instance()->prefetchTiles(tiles);
+}
+
 void KisTiledDataManager::readBytes(quint8 *data,
                                     qint32 x, qint32 y,
                                     qint32 width, qint32 height,
@@ -195,9 +195,13 @@ public:
 protected:
     /**
      * Reads and writes the tiles
+     *
+     * When \p lazy is true, the tiles are not decompressed while
+     * reading. Their compressed data is moved into the swap store
+     * and is decompressed on the first access to the tile.
      */
     bool write(KisPaintDeviceWriter &store);
-    bool read(QIODevice *stream);
+    bool read(QIODevice *stream, bool lazy = false);
 
     void purge(const QRect& area);
 
@@ -254,6 +258,16 @@ public:
      */
     void setPixel(qint32 x, qint32 y, const quint8 * data);
 
+    /**
+     * Schedules asynchronous swap-in of all the swapped-out tiles
+     * intersecting \p rect. Should be called by the walkers
+     * right before they start reading the area, so that the disk
+     * reads are done in a background thread instead of blocking the
+     * walker on every tile. If there are no swapped-out tiles in the
+     * store, the call costs nothing.
+     */
+    void prefetchRect(const QRect &rect) const;
+
 
     /**
      * Copy the bytes in the specified rect to a vector. The caller is responsible
@@ -354,6 +368,13 @@ private:
         return divideRoundDown(y, KisTileData::HEIGHT);
     }
 
+    /**
+     * Replaces the tile at (\p col, \p row) with a new one, which uses
+     * \p td for its data. Used by the tile compressors for loading the
+     * tiles lazily. The caller should hold the write lock.
+     */
+    void setTileData(qint32 col, qint32 row, KisTileData *td);
+
 private:
     void setDefaultPixelImpl(const quint8 *defPixel);
 
@@ -30,6 +30,7 @@ KisVLineIterator2::KisVLineIterator2(KisDataManager *dataManager, qint32 x, qint
     m_bottom = y + h - 1;
 
     m_left = m_x;
+    m_right = m_x;
 
     m_havePixels = (h == 0) ? false : true;
     if (m_top > m_bottom) {
@@ -54,10 +55,30 @@ KisVLineIterator2::KisVLineIterator2(KisDataManager *dataManager, qint32 x, qint
     for (int i = 0; i < m_tilesCacheSize; i++){
         fetchTileDataForCache(m_tilesCache[i], m_column, m_topRow + i);
     }
+
     m_index = 0;
     switchToTile(m_topInTopmostTile);
 }
 
+void KisVLineIterator2::setNumIteratedColumns(qint32 numColumns)
+{
+    if (!m_havePixels) return;
+
+    m_right = m_left + qMax(1, numColumns) - 1;
+    prefetchNextColumn();
+}
+
+void KisVLineIterator2::prefetchNextColumn()
+{
+    const qint32 nextColumnLeft = (m_column + 1) * KisTileData::WIDTH;
+    if (nextColumnLeft > m_right) return;
+
+    const qint32 nextColumnRight = qMin(nextColumnLeft + KisTileData::WIDTH - 1, m_right);
+    const QRect nextColumnRect(nextColumnLeft, m_top,
+                               nextColumnRight - nextColumnLeft + 1, m_bottom - m_top + 1);
+    m_dataManager->prefetchRect(nextColumnRect);
+}
+
 void KisVLineIterator2::resetPixelPos()
 {
     m_y = m_top;
@@ -112,6 +133,7 @@ void KisVLineIterator2::nextColumn()
         ++m_column;
         m_xInTile = 0;
         preallocateTiles();
+        prefetchNextColumn();
     }
     m_index = 0;
     switchToTile(m_topInTopmostTile);
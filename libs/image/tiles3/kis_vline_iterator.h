@@ -31,6 +31,7 @@ public:
 
     void resetPixelPos() override;
     void resetColumnPos() override;
+    void setNumIteratedColumns(qint32 numColumns) override;
 
     bool nextPixel() override;
     void nextColumn() override;
@@ -59,6 +60,7 @@ private:
     qint32 m_top {0};
     qint32 m_bottom {0};
     qint32 m_left {0};
+    qint32 m_right {0}; // the last column the prefetching may reach
     qint32 m_topRow {0};
     qint32 m_bottomRow {0};
 
@@ -74,5 +76,6 @@ private:
     void switchToTile(qint32 xInTile);
     void fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint32 row);
     void preallocateTiles();
+    void prefetchNextColumn();
 };
 #endif
@@ -19,6 +19,12 @@ void KisAbstractCompression::adjustForDataSize(qint32 dataSize)
     Q_UNUSED(dataSize);
 }
 
+bool KisAbstractCompression::checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength)
+{
+    Q_UNUSED(input);
+    return inputLength > 0 && inputLength <= outputBufferSize(outputLength);
+}
+
 void KisAbstractCompression::linearizeColors(quint8 *input, quint8 *output,
                                              qint32 dataSize, qint32 pixelSize)
 {
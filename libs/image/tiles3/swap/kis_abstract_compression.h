@@ -52,6 +52,16 @@ public:
      */
     virtual qint32 outputBufferSize(qint32 dataSize) = 0;
 
+    /**
+     * Checks if \p input looks like a valid compressed stream that
+     * decompresses into exactly \p outputLength bytes. The check does
+     * not produce any output, so it is much cheaper than decompress().
+     *
+     * The default implementation only checks that \p inputLength is
+     * within the bounds this codec may produce for such output.
+     */
+    virtual bool checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength);
+
     /**
      * Some algorithms may decide to optimize them work depending on
      * the usual size of the data.
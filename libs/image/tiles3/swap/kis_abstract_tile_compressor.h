@@ -43,6 +43,15 @@ public:
      */
     virtual bool readTile(QIODevice *stream, KisTiledDataManager *dm) = 0;
 
+    /**
+     * The same as readTile(), but the compressed data of the tile
+     * may be put into the swap store as it is, so that the tile is
+     * decompressed only when it is accessed for the first time.
+     *
+     * The default implementation just reads the tile with readTile().
+     */
+    virtual bool readTileLazily(QIODevice *stream, KisTiledDataManager *dm);
+
     /**
      * Compresses a \p tileData and writes it into the \p buffer.
      * The buffer must be at least tileDataBufferSize() bytes long.
@@ -90,6 +99,10 @@ protected:
     inline qint32 pixelSize(KisTiledDataManager *dm) {
         return dm->pixelSize();
     }
+
+    inline void setTileData(KisTiledDataManager *dm, qint32 col, qint32 row, KisTileData *td) {
+        dm->setTileData(col, row, td);
+    }
 };
 
 #endif /* __KIS_ABSTRACT_TILE_COMPRESSOR_H */
@@ -0,0 +1,121 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_compression_registry.h"
+
+#include <config-swap-compression.h>
+
+#include "kis_lzf_compression.h"
+
+#ifdef HAVE_LZ4
+#include "kis_lz4_compression.h"
+#endif
+
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
+
+
+bool KisCompressionRegistry::isAvailable(CodecId id)
+{
+    switch (id) {
+    case Lzf:
+        return true;
+    case Lz4:
+#ifdef HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case Zstd:
+#ifdef HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+QVector<KisCompressionRegistry::CodecId> KisCompressionRegistry::availableCodecs()
+{
+    QVector<CodecId> result;
+
+    for (CodecId id : {Lzf, Lz4, Zstd}) {
+        if (isAvailable(id)) {
+            result << id;
+        }
+    }
+
+    return result;
+}
+
+QString KisCompressionRegistry::codecName(CodecId id)
+{
+    switch (id) {
+    case Lzf:
+        return "LZF";
+    case Lz4:
+        return "LZ4";
+    case Zstd:
+        return "ZSTD";
+    }
+
+    return QString();
+}
+
+bool KisCompressionRegistry::codecFromName(const QString &name, CodecId *id)
+{
+    for (CodecId candidate : {Lzf, Lz4, Zstd}) {
+        if (codecName(candidate) == name) {
+            *id = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool KisCompressionRegistry::codecFromRawId(quint8 rawId, CodecId *id)
+{
+    if (rawId < Lzf || rawId > Zstd) return false;
+
+    *id = CodecId(rawId);
+    return true;
+}
+
+KisAbstractCompression* KisCompressionRegistry::create(CodecId id)
+{
+    switch (id) {
+    case Lzf:
+        return new KisLzfCompression();
+    case Lz4:
+#ifdef HAVE_LZ4
+        return new KisLz4Compression();
+#else
+        return nullptr;
+#endif
+    case Zstd:
+#ifdef HAVE_ZSTD
+        return new KisZstdCompression();
+#else
+        return nullptr;
+#endif
+    }
+
+    return nullptr;
+}
+
+KisCompressionRegistry::CodecId KisCompressionRegistry::fastestCodec()
+{
+    return isAvailable(Lz4) ? Lz4 : Lzf;
+}
+
+KisCompressionRegistry::CodecId KisCompressionRegistry::densestCodec()
+{
+    return isAvailable(Zstd) ? Zstd : Lzf;
+}
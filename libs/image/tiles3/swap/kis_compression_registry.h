@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_COMPRESSION_REGISTRY_H
+#define __KIS_COMPRESSION_REGISTRY_H
+
+#include "kritaimage_export.h"
+
+#include <QString>
+#include <QVector>
+
+class KisAbstractCompression;
+
+/**
+ * The registry of all the compression algorithms that can be used
+ * for storing the tiles in the swap file and in .kra files.
+ *
+ * Some of the codecs depend on optional libraries, so the caller
+ * should check isAvailable() before creating the codec.
+ */
+class KRITAIMAGE_EXPORT KisCompressionRegistry
+{
+public:
+    /**
+     * The ids are written into the header of every compressed tile,
+     * so they must never be changed or reused for another algorithm.
+     * Zero is reserved for uncompressed (raw) tile data.
+     */
+    enum CodecId : quint8 {
+        Lzf = 1,
+        Lz4 = 2,
+        Zstd = 3
+    };
+
+    static bool isAvailable(CodecId id);
+    static QVector<CodecId> availableCodecs();
+
+    /**
+     * \return a short (not longer than 5 symbols) name of the codec
+     * used in the tile headers of .kra files, e.g. "LZF"
+     */
+    static QString codecName(CodecId id);
+
+    /**
+     * Resolves codec id from its name. Returns false if the name is
+     * not known
+     */
+    static bool codecFromName(const QString &name, CodecId *id);
+
+    /**
+     * Resolves codec id from the raw id read from the tile header.
+     * Returns false if the id is not known
+     */
+    static bool codecFromRawId(quint8 rawId, CodecId *id);
+
+    /**
+     * Creates a new compression object. The caller takes ownership
+     * of the object. Returns null if the codec is not available in
+     * this build.
+     */
+    static KisAbstractCompression* create(CodecId id);
+
+    /**
+     * The fastest codec available in this build. Used for the tiles that
+     * are expected to be swapped-in soon.
+     */
+    static CodecId fastestCodec();
+
+    /**
+     * The codec with the best compression ratio available in this build.
+     * Used for the tiles that are not expected to be accessed soon,
+     * e.g. the ones stored in the undo history.
+     */
+    static CodecId densestCodec();
+
+private:
+    KisCompressionRegistry();
+};
+
+#endif /* __KIS_COMPRESSION_REGISTRY_H */
@@ -0,0 +1,101 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_lz4_compression.h"
+
+#include <lz4.h>
+
+
+KisLz4Compression::KisLz4Compression()
+{
+}
+
+KisLz4Compression::~KisLz4Compression()
+{
+}
+
+qint32 KisLz4Compression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const int result =
+        LZ4_compress_default(reinterpret_cast<const char*>(input),
+                             reinterpret_cast<char*>(output),
+                             inputLength, outputLength);
+
+    return qMax(0, result);
+}
+
+qint32 KisLz4Compression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const int result =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(input),
+                            reinterpret_cast<char*>(output),
+                            inputLength, outputLength);
+
+    return qMax(0, result);
+}
+
+qint32 KisLz4Compression::outputBufferSize(qint32 dataSize)
+{
+    return LZ4_compressBound(dataSize);
+}
+
+namespace {
+inline bool readLz4Length(const quint8 *&ip, const quint8 *end, qint64 &length)
+{
+    quint8 byte;
+
+    do {
+        if (ip >= end) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+}
+
+bool KisLz4Compression::checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength)
+{
+    /**
+     * Walks through the sequences of the LZ4 block and checks that
+     * all the literals and offsets stay within the bounds
+     */
+    const quint8 *ip = input;
+    const quint8 *end = input + inputLength;
+    qint64 op = 0;
+
+    while (true) {
+        if (ip >= end) return false;
+
+        const quint8 token = *ip++;
+
+        qint64 literalLength = token >> 4;
+        if (literalLength == 15 && !readLz4Length(ip, end, literalLength)) return false;
+
+        if (end - ip < literalLength) return false;
+        ip += literalLength;
+        op += literalLength;
+
+        if (op > outputLength) return false;
+
+        // the last sequence consists of literals only
+        if (ip == end) break;
+
+        if (end - ip < 2) return false;
+        const qint64 offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > op) return false;
+
+        qint64 matchLength = token & 15;
+        if (matchLength == 15 && !readLz4Length(ip, end, matchLength)) return false;
+
+        op += matchLength + 4;
+        if (op > outputLength) return false;
+    }
+
+    return op == outputLength;
+}
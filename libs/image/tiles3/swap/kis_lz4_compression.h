@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_LZ4_COMPRESSION_H
+#define __KIS_LZ4_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+/**
+ * A wrapper around LZ4 library. LZ4 is a bit worse than LZF in
+ * compression ratio, but it is several times faster both in
+ * compression and decompression, so it is used for the tiles
+ * that are likely to be swapped-in soon.
+ */
+class KRITAIMAGE_EXPORT KisLz4Compression : public KisAbstractCompression
+{
+public:
+    KisLz4Compression();
+    ~KisLz4Compression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+    bool checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength) override;
+};
+
+#endif /* __KIS_LZ4_COMPRESSION_H */
@@ -235,6 +235,54 @@ int lzff_decompress(const void* input, int length, void* output, int maxout)
     return op - (quint8*)output;
 }
 
+/**
+ * Walks through the stream in exactly the same way as
+ * lzff_decompress() does, but only counts the output
+ */
+bool lzff_check(const void* input, int length, int expectedOut)
+{
+    const quint8* ip = (const quint8*) input;
+    const quint8* ip_limit  = ip + length - 1;
+    const quint8* ip_end = ip + length;
+    qint64 op = 0;
+
+    while (ip < ip_limit) {
+        quint32 ctrl = (*ip) + 1;
+        quint32 ofs = ((*ip) & 31) << 8;
+        quint32 len = (*ip++) >> 5;
+
+        if (ctrl < 33) {
+            /* literal copy */
+            if (op + ctrl > expectedOut || ip + ctrl > ip_end)
+                return false;
+
+            ip += ctrl;
+            op += ctrl;
+        } else {
+            /* back reference */
+            len--;
+            qint64 ref = op - ofs - 1;
+
+            if (len == 7 - 1) {
+                if (ip >= ip_end)
+                    return false;
+                len += *ip++;
+            }
+
+            if (ip >= ip_end)
+                return false;
+            ref -= *ip++;
+
+            if (op + len + 3 > expectedOut || ref < 0)
+                return false;
+
+            op += len + 3;
+        }
+    }
+
+    return op == expectedOut;
+}
+
 
 
 KisLzfCompression::KisLzfCompression()
@@ -260,6 +308,11 @@ qint32 KisLzfCompression::decompress(const quint8* input, qint32 inputLength, qu
     return lzff_decompress(input, inputLength, output, outputLength);
 }
 
+bool KisLzfCompression::checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength)
+{
+    return lzff_check(input, inputLength, outputLength);
+}
+
 qint32 KisLzfCompression::outputBufferSize(qint32 dataSize)
 {
     // WARNING: Copy-pasted from LZO samples, do not know how to prove it
@@ -20,6 +20,8 @@ public:
 
     qint32 outputBufferSize(qint32 dataSize) override;
 
+    bool checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength) override;
+
     //void adjustForDataSize(qint32 dataSize);
 };
 
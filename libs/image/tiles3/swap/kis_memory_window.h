@@ -35,6 +35,13 @@ public:
     quint8* getReadChunkPtr(const KisChunkData &readChunk);
     quint8* getWriteChunkPtr(const KisChunkData &writeChunk);
 
+    /**
+     * The current size of the swap file
+     */
+    inline qint64 fileSize() const {
+        return m_file.size();
+    }
+
 private:
     struct MappingWindow {
         MappingWindow(quint64 _defaultSize)
@@ -0,0 +1,126 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_sparse_swap_file.h"
+
+#include <QDir>
+
+#include "kis_debug.h"
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#define SWP_PREFIX "KRITA_SPARSE_SWAP_FILE_XXXXXX"
+
+KisSparseSwapFile::KisSparseSwapFile(const QString &swapDir, quint64 size)
+    : m_mapping(0),
+      m_size(size),
+      m_pageSize(4096),
+      m_reclaimedSize(0)
+{
+    if (!isSupported()) return;
+
+#ifdef Q_OS_LINUX
+    m_pageSize = qMax(4096L, sysconf(_SC_PAGESIZE));
+#endif
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!swapDir.isEmpty());
+
+    QDir d(swapDir);
+    if (!d.exists() && !d.mkpath(swapDir)) {
+        qWarning() << "Could not create swap directory for the sparse swap file" << swapDir;
+        return;
+    }
+
+    m_file.setFileTemplate(swapDir + '/' + SWP_PREFIX);
+
+    if (!m_file.open() || m_file.fileName().isEmpty()) {
+        qWarning() << "Could not create the sparse swap file in" << swapDir;
+        return;
+    }
+
+    /**
+     * Resizing the file with ftruncate() does not allocate
+     * any blocks on the disk, so the file is sparse
+     */
+    if (!m_file.resize(m_size)) {
+        qWarning() << "Could not resize the sparse swap file to" << m_size;
+        return;
+    }
+
+    m_mapping = m_file.map(0, m_size);
+
+    if (!m_mapping) {
+        qWarning() << "Could not map the sparse swap file of size" << m_size;
+    }
+}
+
+KisSparseSwapFile::~KisSparseSwapFile()
+{
+    if (m_mapping) {
+        m_file.unmap(m_mapping);
+    }
+}
+
+bool KisSparseSwapFile::isSupported()
+{
+#if defined Q_OS_LINUX && QT_POINTER_SIZE >= 8
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool KisSparseSwapFile::isValid() const
+{
+    return m_mapping;
+}
+
+void KisSparseSwapFile::reclaimChunk(const KisChunkData &chunk)
+{
+#ifdef Q_OS_LINUX
+    const quint64 pageMask = ~(m_pageSize - 1);
+    const quint64 begin = (chunk.m_begin + m_pageSize - 1) & pageMask;
+    const quint64 end = (chunk.m_end + 1) & pageMask;
+
+    /**
+     * The pages at the borders of the chunk may be shared
+     * with the neighbouring chunks, so we can punch only
+     * the pages that lay fully inside the chunk
+     */
+    if (end <= begin) return;
+
+    const int result = fallocate(m_file.handle(),
+                                 FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                                 begin, end - begin);
+
+    if (!result) {
+        m_reclaimedSize.fetchAndAddRelaxed(end - begin);
+    }
+#else
+    Q_UNUSED(chunk);
+#endif
+}
+
+qint64 KisSparseSwapFile::diskUsage() const
+{
+#ifdef Q_OS_LINUX
+    struct stat fileStat;
+    if (!m_mapping || fstat(m_file.handle(), &fileStat)) return 0;
+
+    return qint64(fileStat.st_blocks) * 512;
+#else
+    return 0;
+#endif
+}
+
+qint64 KisSparseSwapFile::reclaimedSize() const
+{
+    return m_reclaimedSize.loadAcquire();
+}
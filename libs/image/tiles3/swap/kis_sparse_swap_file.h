@@ -0,0 +1,84 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_SPARSE_SWAP_FILE_H
+#define __KIS_SPARSE_SWAP_FILE_H
+
+#include <QTemporaryFile>
+#include <QAtomicInteger>
+
+#include "kis_chunk_allocator.h"
+
+
+/**
+ * An alternative to KisMemoryWindow. Instead of moving a small
+ * mapping window along the swap file, KisSparseSwapFile maps the
+ * whole file (of the maximum swap size) at once. The file is created
+ * sparse, so the disk space is allocated only for the chunks that
+ * are actually written.
+ *
+ * Since the mapping never moves, the pointers returned by chunkPtr()
+ * stay valid for the lifetime of the object, so the chunks can be
+ * read from multiple threads without any locking.
+ *
+ * When a chunk is freed, reclaimChunk() punches a hole in the file,
+ * returning the occupied disk space to the file system.
+ */
+class KRITAIMAGE_EXPORT KisSparseSwapFile
+{
+public:
+    /**
+     * @param swapDir If the dir doesn't exist, it'll be created
+     * @param size the size of the file and of its mapping
+     */
+    KisSparseSwapFile(const QString &swapDir, quint64 size);
+    ~KisSparseSwapFile();
+
+    /**
+     * Sparse mapping is supported on the current platform
+     */
+    static bool isSupported();
+
+    /**
+     * The file has been created and mapped successfully
+     */
+    bool isValid() const;
+
+    inline quint8* chunkPtr(KisChunk chunk) {
+        return chunkPtr(chunk.data());
+    }
+
+    inline quint8* chunkPtr(const KisChunkData &chunk) const {
+        Q_ASSERT(chunk.m_end < m_size);
+        return m_mapping + chunk.m_begin;
+    }
+
+    /**
+     * Releases the disk space occupied by the pages lying fully
+     * inside the chunk. The chunk must not be used after that.
+     */
+    void reclaimChunk(const KisChunkData &chunk);
+
+    /**
+     * The amount of disk space actually allocated for the file
+     */
+    qint64 diskUsage() const;
+
+    /**
+     * The total amount of disk space returned to the file system
+     * since the creation of the file
+     */
+    qint64 reclaimedSize() const;
+
+private:
+    QTemporaryFile m_file;
+    quint8 *m_mapping;
+    quint64 m_size;
+    quint64 m_pageSize;
+    QAtomicInteger<qint64> m_reclaimedSize;
+};
+
+#endif /* __KIS_SPARSE_SWAP_FILE_H */
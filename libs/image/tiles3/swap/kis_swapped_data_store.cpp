@@ -7,6 +7,7 @@
 //#include "kis_debug.h"
 #include "kis_swapped_data_store.h"
 #include "kis_memory_window.h"
+#include "kis_sparse_swap_file.h"
 #include "kis_image_config.h"
 
 #include "kis_tile_compressor_2.h"
@@ -14,7 +15,10 @@
 //#define COMPRESSOR_VERSION 2
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_totalSwapMemoryUsed(0)
+    : m_swapSpace(0),
+      m_sparseSwapSpace(0),
+      m_totalSwapMemoryUsed(0),
+      m_numTiles(0)
 {
     KisImageConfig config(true);
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
@@ -22,7 +26,26 @@ KisSwappedDataStore::KisSwappedDataStore()
     const quint64 swapWindowSize = config.swapWindowSize() * MiB;
 
     m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+
+    /**
+     * The allocator aborts the application when the swap is
+     * exhausted, so leave the other half for the swapper
+     */
+    m_maxCompressedStorageSize = maxSwapSize / 2;
+
+    if (config.useSparseSwapFile() && KisSparseSwapFile::isSupported()) {
+        m_sparseSwapSpace = new KisSparseSwapFile(config.swapDir(), maxSwapSize);
+
+        if (!m_sparseSwapSpace->isValid()) {
+            qWarning() << "Failed to create sparse swap file, falling back to the windowed one";
+            delete m_sparseSwapSpace;
+            m_sparseSwapSpace = 0;
+        }
+    }
+
+    if (!m_sparseSwapSpace) {
+        m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    }
 
     // FIXME: use a factory after the patch is committed
     m_compressor = new KisTileCompressor2();
@@ -30,17 +53,20 @@ KisSwappedDataStore::KisSwappedDataStore()
 
 KisSwappedDataStore::~KisSwappedDataStore()
 {
+    KisAbstractTileCompressor *compressor = 0;
+    while (m_readCompressors.pop(compressor)) {
+        delete compressor;
+    }
+
     delete m_compressor;
     delete m_swapSpace;
+    delete m_sparseSwapSpace;
     delete m_allocator;
 }
 
 quint64 KisSwappedDataStore::numTiles() const
 {
-    // We are not acquiring the lock here...
-    // Hope QLinkedList will ensure atomic access to it's size...
-
-    return m_allocator->numChunks();
+    return m_numTiles.loadAcquire();
 }
 
 bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
@@ -54,6 +80,8 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
      * So we can modify the tile data freely.
      */
 
+    processPendingFreeChunks();
+
     const qint32 expectedBufferSize = m_compressor->tileDataBufferSize(td);
     if(m_buffer.size() < expectedBufferSize)
         m_buffer.resize(expectedBufferSize);
@@ -62,7 +90,10 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
 
     KisChunk chunk = m_allocator->getChunk(bytesWritten);
-    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
+    quint8 *ptr = m_sparseSwapSpace ?
+        m_sparseSwapSpace->chunkPtr(chunk) :
+        m_swapSpace->getWriteChunkPtr(chunk);
+
     if (!ptr) {
         qWarning() << "swap out of tile failed";
         return false;
@@ -72,47 +103,164 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     td->releaseMemory();
     td->setSwapChunk(chunk);
 
-    m_totalSwapMemoryUsed += chunk.size();
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(chunk.size());
+    m_numTiles.ref();
 
     return true;
 }
 
-void KisSwappedDataStore::swapInTileData(KisTileData *td)
+bool KisSwappedDataStore::tryStoreCompressedTileData(KisTileData *td, const quint8 *data, qint32 dataSize)
+{
+    QMutexLocker locker(&m_lock);
+
+    processPendingFreeChunks();
+
+    if (m_totalSwapMemoryUsed.loadAcquire() + dataSize > m_maxCompressedStorageSize) {
+        return false;
+    }
+
+    KisChunk chunk = m_allocator->getChunk(dataSize);
+    quint8 *ptr = m_sparseSwapSpace ?
+        m_sparseSwapSpace->chunkPtr(chunk) :
+        m_swapSpace->getWriteChunkPtr(chunk);
+
+    if (!ptr) {
+        m_allocator->freeChunk(chunk);
+        return false;
+    }
+    memcpy(ptr, data, dataSize);
+
+    td->releaseMemory();
+    td->setSwapChunk(chunk);
+
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(chunk.size());
+    m_numTiles.ref();
+
+    return true;
+}
+
+bool KisSwappedDataStore::swapInTileData(KisTileData *td)
 {
     Q_ASSERT(!td->data());
+
+    if (m_sparseSwapSpace) {
+        return swapInTileDataSparse(td);
+    }
+
     QMutexLocker locker(&m_lock);
 
     // see comment in swapOutTileData()
 
     KisChunk chunk = td->swapChunk();
-    m_totalSwapMemoryUsed -= chunk.size();
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(-qint64(chunk.size()));
+    m_numTiles.deref();
 
     td->allocateMemory();
     td->setSwapChunk(KisChunk());
 
     quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
     Q_ASSERT(ptr);
-    m_compressor->decompressTileData(ptr, chunk.size(), td);
+    const bool result = m_compressor->decompressTileData(ptr, chunk.size(), td);
     m_allocator->freeChunk(chunk);
+
+    if (!result) {
+        memset(td->data(), 0, td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT);
+    }
+
+    return result;
+}
+
+bool KisSwappedDataStore::swapInTileDataSparse(KisTileData *td)
+{
+    /**
+     * The mapping of the sparse file never moves and the chunk
+     * belongs to this tile data only (which is locked by the caller),
+     * so we can read it without taking the global lock. The chunk
+     * itself is returned to the allocator later, when the lock is
+     * taken by the swap-out routine.
+     */
+
+    KisChunk chunk = td->swapChunk();
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(-qint64(chunk.size()));
+    m_numTiles.deref();
+
+    td->allocateMemory();
+    td->setSwapChunk(KisChunk());
+
+    KisAbstractTileCompressor *compressor = 0;
+    if (!m_readCompressors.pop(compressor)) {
+        compressor = new KisTileCompressor2();
+    }
+
+    quint8 *ptr = m_sparseSwapSpace->chunkPtr(chunk);
+    const bool result = compressor->decompressTileData(ptr, chunk.size(), td);
+
+    m_readCompressors.push(compressor);
+    m_pendingFreeChunks.push(chunk);
+
+    if (!result) {
+        memset(td->data(), 0, td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT);
+    }
+
+    return result;
+}
+
+void KisSwappedDataStore::freeChunkSparse(KisChunk chunk)
+{
+    m_sparseSwapSpace->reclaimChunk(chunk.data());
+    m_allocator->freeChunk(chunk);
+}
+
+void KisSwappedDataStore::processPendingFreeChunks()
+{
+    if (!m_sparseSwapSpace) return;
+
+    KisChunk chunk;
+    while (m_pendingFreeChunks.pop(chunk)) {
+        freeChunkSparse(chunk);
+    }
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
 {
     QMutexLocker locker(&m_lock);
 
-    m_totalSwapMemoryUsed -= td->swapChunk().size();
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(-qint64(td->swapChunk().size()));
+    m_numTiles.deref();
 
-    m_allocator->freeChunk(td->swapChunk());
+    if (m_sparseSwapSpace) {
+        // the lock is held anyway, so return the chunks
+        // freed by the lockless swap-in as well
+        processPendingFreeChunks();
+        freeChunkSparse(td->swapChunk());
+    } else {
+        m_allocator->freeChunk(td->swapChunk());
+    }
     td->setSwapChunk(KisChunk());
 }
 
 qint64 KisSwappedDataStore::totalSwapMemoryUsed() const
 {
-    return m_totalSwapMemoryUsed;
+    return m_totalSwapMemoryUsed.loadAcquire();
+}
+
+qint64 KisSwappedDataStore::swapFileSize() const
+{
+    return m_sparseSwapSpace ?
+        m_sparseSwapSpace->diskUsage() :
+        m_swapSpace->fileSize();
+}
+
+qint64 KisSwappedDataStore::swapReclaimedSize() const
+{
+    return m_sparseSwapSpace ? m_sparseSwapSpace->reclaimedSize() : 0;
 }
 
 void KisSwappedDataStore::debugStatistics()
 {
+    QMutexLocker locker(&m_lock);
+    processPendingFreeChunks();
+
     m_allocator->sanityCheck();
     m_allocator->debugFragmentation();
 }
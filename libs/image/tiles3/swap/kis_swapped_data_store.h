@@ -11,13 +11,17 @@
 
 #include <QMutex>
 #include <QByteArray>
+#include <QAtomicInteger>
+
+#include "kis_lockless_stack.h"
+#include "kis_chunk_allocator.h"
 
 
 class QMutex;
 class KisTileData;
 class KisAbstractTileCompressor;
-class KisChunkAllocator;
 class KisMemoryWindow;
+class KisSparseSwapFile;
 
 class KRITAIMAGE_EXPORT KisSwappedDataStore
 {
@@ -38,13 +42,30 @@ public:
      */
     bool trySwapOutTileData(KisTileData *td);
 
+    /**
+     * Put already compressed data of the \a td into the swap file
+     * and free memory occupied by td->data(). The \a data must be
+     * in the format produced by KisTileCompressor2.
+     *
+     * Fails if the data would take too big part of the swap file,
+     * which is needed by the swapper itself.
+     */
+    bool tryStoreCompressedTileData(KisTileData *td, const quint8 *data, qint32 dataSize);
+
     /**
      * Restore the data of a \a td basing on information
      * stored in the swap file.
      * LOCKING: the lock on the tile data should be taken
      *          by the caller before making a call.
+     *
+     * When the sparse swap file is used, the tile data is
+     * read and decompressed without taking the global lock,
+     * so multiple threads can swap-in their tiles concurrently.
+     *
+     * Returns false if the stored data cannot be decompressed. The
+     * tile data is filled with zeros in such a case.
      */
-    void swapInTileData(KisTileData *td);
+    bool swapInTileData(KisTileData *td);
 
     /**
      * Forget all the information linked with the tile data.
@@ -59,21 +80,64 @@ public:
      */
     qint64 totalSwapMemoryUsed() const;
 
+    /**
+     * Returns the amount of disk space occupied by the swap file
+     */
+    qint64 swapFileSize() const;
+
+    /**
+     * Returns the amount of disk space returned to the file system
+     * after freeing the swapped chunks. Always zero for the
+     * sliding-window swap file.
+     */
+    qint64 swapReclaimedSize() const;
+
     /**
      * Some debugging output
      */
     void debugStatistics();
 
+private:
+    bool swapInTileDataSparse(KisTileData *td);
+    void freeChunkSparse(KisChunk chunk);
+    void processPendingFreeChunks();
+
 private:
     QByteArray m_buffer;
     KisAbstractTileCompressor *m_compressor;
 
     KisChunkAllocator *m_allocator;
     KisMemoryWindow *m_swapSpace;
+    KisSparseSwapFile *m_sparseSwapSpace;
+
+    /**
+     * The chunks freed by the lockless swap-in. They are returned to
+     * the allocator on the next swap-out, when the lock is held anyway.
+     */
+    KisLocklessStack<KisChunk> m_pendingFreeChunks;
+
+    /**
+     * The compressors used by the lockless swap-in. Every thread
+     * takes its own one, so the work buffers are never shared.
+     */
+    KisLocklessStack<KisAbstractTileCompressor*> m_readCompressors;
 
     QMutex m_lock;
 
-    qint64 m_totalSwapMemoryUsed;
+    /**
+     * The limit of the swap usage for storing the tiles
+     * passed via tryStoreCompressedTileData()
+     */
+    qint64 m_maxCompressedStorageSize;
+
+    QAtomicInteger<qint64> m_totalSwapMemoryUsed;
+
+    /**
+     * The number of swapped-out tile data objects. The chunks
+     * pending for freeing make the allocator's counter unreliable
+     * without the lock.
+     */
+    QAtomicInteger<qint64> m_numTiles;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
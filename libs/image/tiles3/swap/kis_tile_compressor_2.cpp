@@ -5,22 +5,59 @@
  */
 
 #include "kis_tile_compressor_2.h"
-#include "kis_lzf_compression.h"
+#include "kis_abstract_compression.h"
 #include <QIODevice>
 #include "kis_paint_device_writer.h"
+#include "../kis_tile_data_store.h"
 #define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
-
 
 KisTileCompressor2::KisTileCompressor2()
+    : m_fileCodec(KisCompressionRegistry::Lzf),
+      m_hotCodec(KisCompressionRegistry::fastestCodec()),
+      m_coldCodec(KisCompressionRegistry::densestCodec())
 {
-    m_compression = new KisLzfCompression();
 }
 
 KisTileCompressor2::~KisTileCompressor2()
 {
-    delete m_compression;
+    qDeleteAll(m_compressions);
+}
+
+void KisTileCompressor2::setSwapCodecs(KisCompressionRegistry::CodecId hotCodec,
+                                       KisCompressionRegistry::CodecId coldCodec)
+{
+    m_hotCodec = KisCompressionRegistry::isAvailable(hotCodec) ?
+        hotCodec : KisCompressionRegistry::Lzf;
+
+    m_coldCodec = KisCompressionRegistry::isAvailable(coldCodec) ?
+        coldCodec : KisCompressionRegistry::Lzf;
+}
+
+KisAbstractCompression* KisTileCompressor2::compression(KisCompressionRegistry::CodecId id)
+{
+    KisAbstractCompression *result = m_compressions.value(id, 0);
+
+    if (!result) {
+        result = KisCompressionRegistry::create(id);
+        if (result) {
+            m_compressions.insert(id, result);
+        }
+    }
+
+    return result;
+}
+
+KisCompressionRegistry::CodecId KisTileCompressor2::chooseSwapCodec(KisTileData *tileData) const
+{
+    /**
+     * Historical tiles are accessed only on undo/redo, so we can
+     * spend some more time on compressing them densely
+     */
+    const bool isCold =
+        tileData->historical() || tileData->age() >= COLD_TILE_AGE;
+
+    return isCold ? m_coldCodec : m_hotCodec;
 }
 
 bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
@@ -31,8 +68,9 @@ bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
     qint32 bytesWritten;
 
     tile->lockForRead();
-    compressTileData(tile->tileData(), (quint8*)m_streamingBuffer.data(),
-                     m_streamingBuffer.size(), bytesWritten);
+    compressTileDataImpl(tile->tileData(), m_fileCodec,
+                         (quint8*)m_streamingBuffer.data(),
+                         m_streamingBuffer.size(), bytesWritten);
     tile->unlockForRead();
 
     QString header = getHeader(tile, bytesWritten);
@@ -49,6 +87,16 @@ bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 }
 
 bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
+{
+    return readTileImpl(stream, dm, false);
+}
+
+bool KisTileCompressor2::readTileLazily(QIODevice *stream, KisTiledDataManager *dm)
+{
+    return readTileImpl(stream, dm, true);
+}
+
+bool KisTileCompressor2::readTileImpl(QIODevice *stream, KisTiledDataManager *dm, bool lazy)
 {
     const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize(dm));
     prepareStreamingBuffer(tileDataSize);
@@ -63,14 +111,48 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
         qint32 dataSize = headerItems.takeFirst().toInt();
 
         Q_ASSERT(headerItems.isEmpty());
-        Q_ASSERT(compressionName == m_compressionName);
+
+        /**
+         * The actual codec is stored in the flag byte of the tile
+         * data, the name in the header is checked only for sanity
+         */
+        KisCompressionRegistry::CodecId codecId;
+        if (!KisCompressionRegistry::codecFromName(compressionName, &codecId)) {
+            warnFile << "Unknown tile compression algorithm:" << compressionName;
+            return false;
+        }
 
         qint32 row = yToRow(dm, y);
         qint32 col = xToCol(dm, x);
 
+        if (lazy) {
+            if (dataSize <= 0 || dataSize > m_streamingBuffer.size()) {
+                warnFile << "Invalid size of the tile data:" << dataSize;
+                return false;
+            }
+
+            stream->read(m_streamingBuffer.data(), dataSize);
+
+            const quint8 *data = reinterpret_cast<const quint8*>(m_streamingBuffer.constData());
+            KisTileData *td = 0;
+
+            if (isDecodableTileData(data, dataSize, tileDataSize)) {
+                td = KisTileDataStore::instance()->
+                    createSwappedTileData(pixelSize(dm), data, dataSize);
+            }
+
+            if (td) {
+                setTileData(dm, col, row, td);
+                KisTileDataStore::instance()->loadInBackground(td);
+                return true;
+            }
+        }
+
         KisTileSP tile = dm->getTile(col, row, true);
 
-        stream->read(m_streamingBuffer.data(), dataSize);
+        if (!lazy) {
+            stream->read(m_streamingBuffer.data(), dataSize);
+        }
 
         tile->lockForWrite();
         bool res = decompressTileData((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData());
@@ -80,6 +162,29 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
     return false;
 }
 
+bool KisTileCompressor2::isDecodableTileData(const quint8 *buffer, qint32 bufferSize, qint32 tileDataSize)
+{
+    KisCompressionRegistry::CodecId codecId;
+
+    if (KisCompressionRegistry::codecFromRawId(buffer[0], &codecId)) {
+        KisAbstractCompression *codec = compression(codecId);
+
+        /**
+         * The data is decoded only when the tile is accessed for the
+         * first time, so check the structure of the stream right now to
+         * make sure a corrupted file is still reported by the eager loading
+         * path. The check does not decode anything, for LZF (the codec
+         * used in .kra files) and LZ4 it catches all the errors the
+         * decoder may report.
+         */
+        return codec && codec->checkCompressedData(buffer + 1, bufferSize - 1, tileDataSize);
+    } else if (buffer[0] == RAW_DATA_FLAG) {
+        return bufferSize == tileDataSize + 1;
+    }
+
+    return false;
+}
+
 void KisTileCompressor2::prepareStreamingBuffer(qint32 tileDataSize)
 {
     /**
@@ -89,9 +194,9 @@ void KisTileCompressor2::prepareStreamingBuffer(qint32 tileDataSize)
     m_streamingBuffer.resize(tileDataSize + 1);
 }
 
-void KisTileCompressor2::prepareWorkBuffers(qint32 tileDataSize)
+void KisTileCompressor2::prepareWorkBuffers(KisAbstractCompression *compression, qint32 tileDataSize)
 {
-    const qint32 bufferSize = m_compression->outputBufferSize(tileDataSize);
+    const qint32 bufferSize = compression->outputBufferSize(tileDataSize);
 
     if (m_linearizationBuffer.size() < tileDataSize) {
         m_linearizationBuffer.resize(tileDataSize);
@@ -106,6 +211,16 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
                                           quint8 *buffer,
                                           qint32 bufferSize,
                                           qint32 &bytesWritten)
+{
+    compressTileDataImpl(tileData, chooseSwapCodec(tileData),
+                         buffer, bufferSize, bytesWritten);
+}
+
+void KisTileCompressor2::compressTileDataImpl(KisTileData *tileData,
+                                              KisCompressionRegistry::CodecId codecId,
+                                              quint8 *buffer,
+                                              qint32 bufferSize,
+                                              qint32 &bytesWritten)
 {
     const qint32 pixelSize = tileData->pixelSize();
     const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
@@ -114,16 +229,19 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
     Q_UNUSED(bufferSize);
     Q_ASSERT(bufferSize >= tileDataSize + 1);
 
-    prepareWorkBuffers(tileDataSize);
+    KisAbstractCompression *codec = compression(codecId);
+    Q_ASSERT(codec);
+
+    prepareWorkBuffers(codec, tileDataSize);
 
     KisAbstractCompression::linearizeColors(tileData->data(), (quint8*)m_linearizationBuffer.data(),
                                             tileDataSize, pixelSize);
 
-    compressedBytes = m_compression->compress((quint8*)m_linearizationBuffer.data(), tileDataSize,
-                                              (quint8*)m_compressionBuffer.data(), m_compressionBuffer.size());
+    compressedBytes = codec->compress((quint8*)m_linearizationBuffer.data(), tileDataSize,
+                                      (quint8*)m_compressionBuffer.data(), m_compressionBuffer.size());
 
-    if(compressedBytes < tileDataSize) {
-        buffer[0] = COMPRESSED_DATA_FLAG;
+    if(compressedBytes > 0 && compressedBytes < tileDataSize) {
+        buffer[0] = codecId;
         memcpy(buffer + 1, m_compressionBuffer.data(), compressedBytes);
         bytesWritten = compressedBytes + 1;
     }
@@ -141,12 +259,21 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
     const qint32 pixelSize = tileData->pixelSize();
     const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
 
-    if(buffer[0] == COMPRESSED_DATA_FLAG) {
-        prepareWorkBuffers(tileDataSize);
+    KisCompressionRegistry::CodecId codecId;
+
+    if(KisCompressionRegistry::codecFromRawId(buffer[0], &codecId)) {
+        KisAbstractCompression *codec = compression(codecId);
+        if (!codec) {
+            warnFile << "Tile compression algorithm is not supported by this build:"
+                     << KisCompressionRegistry::codecName(codecId);
+            return false;
+        }
+
+        prepareWorkBuffers(codec, tileDataSize);
 
         qint32 bytesWritten;
-        bytesWritten = m_compression->decompress(buffer + 1, bufferSize - 1,
-                                                 (quint8*)m_linearizationBuffer.data(), tileDataSize);
+        bytesWritten = codec->decompress(buffer + 1, bufferSize - 1,
+                                         (quint8*)m_linearizationBuffer.data(), tileDataSize);
         if (bytesWritten == tileDataSize) {
             KisAbstractCompression::delinearizeColors((quint8*)m_linearizationBuffer.data(),
                                                       tileData->data(),
@@ -155,7 +282,7 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
         }
         return false;
     }
-    else {
+    else if (buffer[0] == RAW_DATA_FLAG) {
         memcpy(tileData->data(), buffer + 1, tileDataSize);
         return true;
     }
@@ -184,5 +311,7 @@ inline QString KisTileCompressor2::getHeader(KisTileSP tile,
     qint32 width, height;
     tile->extent().getRect(&x, &y, &width, &height);
 
-    return QString("%1,%2,%3,%4\n").arg(x).arg(y).arg(m_compressionName).arg(compressedSize);
+    return QString("%1,%2,%3,%4\n").arg(x).arg(y)
+        .arg(KisCompressionRegistry::codecName(m_fileCodec))
+        .arg(compressedSize);
 }
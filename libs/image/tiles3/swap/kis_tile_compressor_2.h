@@ -8,18 +8,58 @@
 #define __KIS_TILE_COMPRESSOR_2_H
 
 #include "kis_abstract_tile_compressor.h"
+#include "kis_compression_registry.h"
+
+#include <QHash>
 
 class KisAbstractCompression;
 
+/**
+ * Every compressed tile is prepended with a one-byte flag, which
+ * is either RAW_DATA_FLAG or the id of the codec used for compression
+ * (see KisCompressionRegistry::CodecId). LZF has always been stored
+ * with the flag equal to 1, so the data written by older versions
+ * decodes without any changes.
+ *
+ * When swapping, the codec is chosen per-tile: the tiles that are
+ * likely to be swapped-in soon are compressed with the fastest codec,
+ * and the tiles that belong to the undo history (or have not been
+ * accessed for a long time) are compressed with the densest codec.
+ *
+ * The tiles written into .kra files are always compressed with LZF
+ * to keep the files readable by older versions of Krita, but the
+ * reader accepts all the codecs known to the registry.
+ */
 class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
     KisTileCompressor2();
     ~KisTileCompressor2() override;
 
+    /**
+     * Overrides the codecs used for the "hot" (recently used) and
+     * "cold" (historical or old) tiles in compressTileData(). If the
+     * codec is not available in this build, LZF is used instead.
+     */
+    void setSwapCodecs(KisCompressionRegistry::CodecId hotCodec,
+                       KisCompressionRegistry::CodecId coldCodec);
+
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
     bool readTile(QIODevice *io, KisTiledDataManager *dm) override;
 
+    /**
+     * The data of the tiles in .kra files is stored in exactly the same
+     * format as in the swap file, so the tile data is just copied into
+     * the swap store and decompressed when the tile is accessed for the
+     * first time, or earlier by KisTileDataBackgroundLoader when the
+     * application is idle. The structure of the compressed stream is
+     * still checked while reading (without decoding it), so if it is
+     * corrupted, not decodable by this build or the swap store refuses
+     * it, the tile is decompressed immediately and the error is reported
+     * as in readTile().
+     */
+    bool readTileLazily(QIODevice *io, KisTiledDataManager *dm) override;
+
 
     void compressTileData(KisTileData *tileData,quint8 *buffer,
                           qint32 bufferSize, qint32 &bytesWritten) override;
@@ -34,19 +74,39 @@ private:
 
     QString getHeader(KisTileSP tile, qint32 compressedSize);
 
-    void prepareWorkBuffers(qint32 tileDataSize);
+    void prepareWorkBuffers(KisAbstractCompression *compression, qint32 tileDataSize);
     void prepareStreamingBuffer(qint32 tileDataSize);
 
+    KisAbstractCompression* compression(KisCompressionRegistry::CodecId id);
+    KisCompressionRegistry::CodecId chooseSwapCodec(KisTileData *tileData) const;
+
+    bool readTileImpl(QIODevice *stream, KisTiledDataManager *dm, bool lazy);
+
+    bool isDecodableTileData(const quint8 *buffer, qint32 bufferSize, qint32 tileDataSize);
+
+    void compressTileDataImpl(KisTileData *tileData,
+                              KisCompressionRegistry::CodecId codecId,
+                              quint8 *buffer, qint32 bufferSize,
+                              qint32 &bytesWritten);
+
 private:
     static const qint8 RAW_DATA_FLAG = 0;
-    static const qint8 COMPRESSED_DATA_FLAG = 1;
+
+    /**
+     * The tiles that have not been accessed for this number of swapper
+     * passes are considered "cold"
+     */
+    static const int COLD_TILE_AGE = 2;
 
 private:
     QByteArray m_linearizationBuffer;
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
-    KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+    QHash<int, KisAbstractCompression*> m_compressions;
+
+    KisCompressionRegistry::CodecId m_fileCodec;
+    KisCompressionRegistry::CodecId m_hotCodec;
+    KisCompressionRegistry::CodecId m_coldCodec;
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
@@ -0,0 +1,133 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "tiles3/swap/kis_tile_data_background_loader.h"
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "tiles3/swap/kis_tile_data_swapper_p.h"
+
+
+struct Q_DECL_HIDDEN KisTileDataBackgroundLoader::Private
+{
+    KisTileDataStore *store = 0;
+    KisStoreLimits limits;
+
+    QMutex lock;
+    QWaitCondition queueChanged;
+    QQueue<KisTileData*> queue;
+    bool isBusy = false;
+    bool isSuspended = false;
+    bool shouldExitFlag = false;
+};
+
+KisTileDataBackgroundLoader::KisTileDataBackgroundLoader(KisTileDataStore *store)
+    : QThread(),
+      m_d(new Private())
+{
+    m_d->store = store;
+}
+
+KisTileDataBackgroundLoader::~KisTileDataBackgroundLoader()
+{
+    delete m_d;
+}
+
+void KisTileDataBackgroundLoader::loadTileData(KisTileData *td)
+{
+    td->ref();
+
+    QMutexLocker locker(&m_d->lock);
+    m_d->queue.enqueue(td);
+    m_d->queueChanged.wakeAll();
+}
+
+void KisTileDataBackgroundLoader::terminateLoader()
+{
+    QQueue<KisTileData*> droppedTiles;
+
+    {
+        QMutexLocker locker(&m_d->lock);
+        m_d->shouldExitFlag = true;
+        std::swap(droppedTiles, m_d->queue);
+        m_d->queueChanged.wakeAll();
+    }
+
+    wait();
+
+    Q_FOREACH (KisTileData *td, droppedTiles) {
+        td->deref();
+    }
+}
+
+void KisTileDataBackgroundLoader::testingWaitForIdle()
+{
+    QMutexLocker locker(&m_d->lock);
+
+    while (!m_d->queue.isEmpty() || m_d->isBusy) {
+        m_d->queueChanged.wait(&m_d->lock);
+    }
+}
+
+void KisTileDataBackgroundLoader::testingSuspend()
+{
+    QMutexLocker locker(&m_d->lock);
+    m_d->isSuspended = true;
+
+    while (m_d->isBusy) {
+        m_d->queueChanged.wait(&m_d->lock);
+    }
+}
+
+void KisTileDataBackgroundLoader::testingResume()
+{
+    QMutexLocker locker(&m_d->lock);
+    m_d->isSuspended = false;
+    m_d->queueChanged.wakeAll();
+}
+
+void KisTileDataBackgroundLoader::run()
+{
+    while (1) {
+        KisTileData *td = 0;
+
+        {
+            QMutexLocker locker(&m_d->lock);
+
+            m_d->isBusy = false;
+            m_d->queueChanged.wakeAll();
+
+            while ((m_d->queue.isEmpty() || m_d->isSuspended) && !m_d->shouldExitFlag) {
+                m_d->queueChanged.wait(&m_d->lock);
+            }
+
+            if (m_d->shouldExitFlag) return;
+
+            td = m_d->queue.dequeue();
+            m_d->isBusy = true;
+        }
+
+        /**
+         * If the tile data has no users anymore, its layer has been
+         * removed before we reached it, so it is just dropped.
+         *
+         * Blocking swapping loads the data from the swap store if
+         * needed, exactly as on the first access to the tile.
+         */
+        if (td->numUsers() > 0 &&
+            m_d->store->memoryMetric() < m_d->limits.softLimitThreshold()) {
+
+            td->blockSwapping();
+            td->unblockSwapping();
+        }
+
+        td->deref();
+    }
+}
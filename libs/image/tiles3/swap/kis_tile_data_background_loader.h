@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_BACKGROUND_LOADER_H_
+#define KIS_TILE_DATA_BACKGROUND_LOADER_H_
+
+#include <QThread>
+
+#include "kritaimage_export.h"
+
+class KisTileData;
+class KisTileDataStore;
+
+
+/**
+ * A background thread that decompresses the lazily loaded tiles (see
+ * KisTileDataStore::createSwappedTileData()) when the application is
+ * idle. The thread runs with the idle priority, so the tiles are
+ * usually decoded before the user accesses them, but the update
+ * threads are never slowed down by it.
+ *
+ * The tiles are not decoded while the memory used by the tiles is
+ * above the soft limit of the swapper, otherwise they would just be
+ * swapped out again. Such tiles are left in the swap and decoded on
+ * the first access.
+ */
+class KRITAIMAGE_EXPORT KisTileDataBackgroundLoader : public QThread
+{
+    Q_OBJECT
+
+public:
+    KisTileDataBackgroundLoader(KisTileDataStore *store);
+    ~KisTileDataBackgroundLoader() override;
+
+    /**
+     * Queues \p td for decompression. The tile data is
+     * referenced until it is processed.
+     */
+    void loadTileData(KisTileData *td);
+
+    void terminateLoader();
+
+    /**
+     * Blocks until all the queued tiles are processed.
+     * Used for testing purposes only.
+     */
+    void testingWaitForIdle();
+
+    /**
+     * Stops/resumes processing of the queue.
+     * Used for testing purposes only.
+     */
+    void testingSuspend();
+    void testingResume();
+
+private:
+    void run() override;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_TILE_DATA_BACKGROUND_LOADER_H_ */
@@ -0,0 +1,117 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "tiles3/swap/kis_tile_data_prefetcher.h"
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+
+#include "tiles3/kis_tile.h"
+
+
+const int KisTileDataPrefetcher::MAX_QUEUE_SIZE = 4096;
+
+struct Q_DECL_HIDDEN KisTileDataPrefetcher::Private
+{
+    QMutex lock;
+    QWaitCondition queueChanged;
+    QQueue<KisTileSP> queue;
+    bool isBusy = false;
+    bool shouldExitFlag = false;
+};
+
+KisTileDataPrefetcher::KisTileDataPrefetcher()
+    : QThread(),
+      m_d(new Private())
+{
+}
+
+KisTileDataPrefetcher::~KisTileDataPrefetcher()
+{
+    delete m_d;
+}
+
+void KisTileDataPrefetcher::prefetch(const QVector<KisTileSP> &tiles)
+{
+    if (tiles.isEmpty()) return;
+
+    /**
+     * The dropped tiles should be released outside the lock,
+     * because the destruction of a tile may touch its memento
+     * manager
+     */
+    QVector<KisTileSP> droppedTiles;
+
+    {
+        QMutexLocker locker(&m_d->lock);
+
+        Q_FOREACH (KisTileSP tile, tiles) {
+            m_d->queue.enqueue(tile);
+        }
+
+        while (m_d->queue.size() > MAX_QUEUE_SIZE) {
+            droppedTiles.append(m_d->queue.dequeue());
+        }
+
+        m_d->queueChanged.wakeAll();
+    }
+}
+
+void KisTileDataPrefetcher::terminatePrefetcher()
+{
+    QQueue<KisTileSP> droppedTiles;
+
+    {
+        QMutexLocker locker(&m_d->lock);
+        m_d->shouldExitFlag = true;
+        std::swap(droppedTiles, m_d->queue);
+        m_d->queueChanged.wakeAll();
+    }
+
+    wait();
+}
+
+void KisTileDataPrefetcher::testingWaitForIdle()
+{
+    QMutexLocker locker(&m_d->lock);
+
+    while (!m_d->queue.isEmpty() || m_d->isBusy) {
+        m_d->queueChanged.wait(&m_d->lock);
+    }
+}
+
+void KisTileDataPrefetcher::run()
+{
+    while (1) {
+        KisTileSP tile;
+
+        {
+            QMutexLocker locker(&m_d->lock);
+
+            m_d->isBusy = false;
+            m_d->queueChanged.wakeAll();
+
+            while (m_d->queue.isEmpty() && !m_d->shouldExitFlag) {
+                m_d->queueChanged.wait(&m_d->lock);
+            }
+
+            if (m_d->shouldExitFlag) return;
+
+            tile = m_d->queue.dequeue();
+            m_d->isBusy = true;
+        }
+
+        /**
+         * Locking the tile for read blocks its swapping and loads
+         * its data from the swap file if needed. We release the lock
+         * right away, the tile is supposed to be accessed soon, so
+         * the swapper will not choose it since its age is reset.
+         */
+        tile->lockForRead();
+        tile->unlockForRead();
+    }
+}
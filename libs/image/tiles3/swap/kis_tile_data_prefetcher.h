@@ -0,0 +1,56 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_PREFETCHER_H_
+#define KIS_TILE_DATA_PREFETCHER_H_
+
+#include <QThread>
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_shared_ptr.h"
+
+class KisTile;
+typedef KisSharedPtr<KisTile> KisTileSP;
+
+
+/**
+ * A background thread that swaps-in the tiles, which are going
+ * to be accessed soon. The tiles are queued by the data managers
+ * (see KisTiledDataManager::prefetchRect()) and loaded in FIFO order.
+ *
+ * The queue is bounded: when it overflows, the oldest requests
+ * are dropped, because they have most probably already been
+ * loaded synchronously by the walker itself.
+ */
+class KRITAIMAGE_EXPORT KisTileDataPrefetcher : public QThread
+{
+    Q_OBJECT
+
+public:
+    KisTileDataPrefetcher();
+    ~KisTileDataPrefetcher() override;
+
+    void prefetch(const QVector<KisTileSP> &tiles);
+    void terminatePrefetcher();
+
+    /**
+     * Blocks until all the queued tiles are loaded.
+     * Used for testing purposes only.
+     */
+    void testingWaitForIdle();
+
+private:
+    void run() override;
+
+private:
+    static const int MAX_QUEUE_SIZE;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_TILE_DATA_PREFETCHER_H_ */
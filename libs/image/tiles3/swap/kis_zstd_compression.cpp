@@ -0,0 +1,70 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zstd_compression.h"
+
+#include <zstd.h>
+
+
+struct KisZstdCompression::Private
+{
+    ZSTD_CCtx *compressionContext {nullptr};
+    ZSTD_DCtx *decompressionContext {nullptr};
+    int compressionLevel {3};
+};
+
+KisZstdCompression::KisZstdCompression(int compressionLevel)
+    : m_d(new Private)
+{
+    m_d->compressionLevel = compressionLevel;
+    m_d->compressionContext = ZSTD_createCCtx();
+    m_d->decompressionContext = ZSTD_createDCtx();
+}
+
+KisZstdCompression::~KisZstdCompression()
+{
+    ZSTD_freeCCtx(m_d->compressionContext);
+    ZSTD_freeDCtx(m_d->decompressionContext);
+}
+
+qint32 KisZstdCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result =
+        ZSTD_compressCCtx(m_d->compressionContext,
+                          output, outputLength,
+                          input, inputLength,
+                          m_d->compressionLevel);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result =
+        ZSTD_decompressDCtx(m_d->decompressionContext,
+                            output, outputLength,
+                            input, inputLength);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::outputBufferSize(qint32 dataSize)
+{
+    return qint32(ZSTD_compressBound(dataSize));
+}
+
+bool KisZstdCompression::checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength)
+{
+    /**
+     * Both the functions read the frame and block headers only,
+     * the content size is always stored by ZSTD_compressCCtx()
+     */
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(input, inputLength);
+    if (contentSize != static_cast<unsigned long long>(outputLength)) return false;
+
+    const size_t frameSize = ZSTD_findFrameCompressedSize(input, inputLength);
+    return !ZSTD_isError(frameSize) && frameSize == size_t(inputLength);
+}
@@ -0,0 +1,42 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ZSTD_COMPRESSION_H
+#define __KIS_ZSTD_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+#include <QScopedPointer>
+
+/**
+ * A wrapper around Zstandard library. Zstd is slower than LZF
+ * on compression, but gives much better compression ratio and
+ * still decompresses fast, so it is used for the tiles that are
+ * not expected to be swapped-in any time soon, e.g. the ones
+ * belonging to the undo history.
+ *
+ * The object keeps its own compression and decompression contexts,
+ * so it should not be used from multiple threads simultaneously.
+ */
+class KRITAIMAGE_EXPORT KisZstdCompression : public KisAbstractCompression
+{
+public:
+    KisZstdCompression(int compressionLevel = 3);
+    ~KisZstdCompression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+    bool checkCompressedData(const quint8* input, qint32 inputLength, qint32 outputLength) override;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif /* __KIS_ZSTD_COMPRESSION_H */
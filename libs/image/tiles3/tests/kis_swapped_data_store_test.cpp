@@ -8,6 +8,7 @@
 #include <simpletest.h>
 
 #include <QRandomGenerator>
+#include <QThreadPool>
 
 #include "kis_debug.h"
 
@@ -17,6 +18,7 @@
 #include "tiles_test_utils.h"
 
 #include "tiles3/kis_tile_data_store.h"
+#include "tiles3/swap/kis_sparse_swap_file.h"
 
 
 #define COLUMN2COLOR(col) (col%255)
@@ -121,5 +123,146 @@ void KisSwappedDataStoreTest::testRandomAccess()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testRoundTripSparse()
+{
+    if (!KisSparseSwapFile::isSupported()) {
+        QSKIP("Sparse swap file is not supported on this platform");
+    }
+
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 10000;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(40);
+    config.setSwapSlabSize(1);
+    config.setUseSparseSwapFile(true);
+
+    KisSwappedDataStore store;
+
+    config.setUseSparseSwapFile(false);
+
+    QList<KisTileData*> tileDataList;
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        tileDataList.append(new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance()));
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        memset(td->data(), COLUMN2COLOR(i), TILESIZE);
+        QVERIFY(store.trySwapOutTileData(td));
+    }
+
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+    QVERIFY(store.totalSwapMemoryUsed() > 0);
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        QVERIFY(!td->data());
+
+        store.swapInTileData(td);
+        QVERIFY(memoryIsFilled(COLUMN2COLOR(i), td->data(), TILESIZE));
+    }
+
+    QCOMPARE(store.numTiles(), quint64(0));
+    QCOMPARE(store.totalSwapMemoryUsed(), qint64(0));
+
+    store.debugStatistics();
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+}
+
+class KisSwapInJob : public QRunnable
+{
+public:
+    KisSwapInJob(KisSwappedDataStore &store, const QList<KisTileData*> &tiles, int firstColumn)
+        : m_store(store),
+          m_tiles(tiles),
+          m_firstColumn(firstColumn),
+          m_failed(false)
+    {
+    }
+
+    void run() override {
+        for (int i = 0; i < m_tiles.size(); i++) {
+            KisTileData *td = m_tiles[i];
+            m_store.swapInTileData(td);
+
+            if (!memoryIsFilled(COLUMN2COLOR(m_firstColumn + i), td->data(), TILESIZE)) {
+                m_failed = true;
+            }
+        }
+    }
+
+    bool failed() const {
+        return m_failed;
+    }
+
+private:
+    KisSwappedDataStore &m_store;
+    QList<KisTileData*> m_tiles;
+    int m_firstColumn;
+    bool m_failed;
+};
+
+void KisSwappedDataStoreTest::testConcurrentSwapInSparse()
+{
+    if (!KisSparseSwapFile::isSupported()) {
+        QSKIP("Sparse swap file is not supported on this platform");
+    }
+
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 8000;
+    const qint32 NUM_THREADS = 8;
+    const qint32 TILES_PER_THREAD = NUM_TILES / NUM_THREADS;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(40);
+    config.setSwapSlabSize(1);
+    config.setUseSparseSwapFile(true);
+
+    KisSwappedDataStore store;
+
+    config.setUseSparseSwapFile(false);
+
+    QList<KisTileData*> tileDataList;
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+        memset(td->data(), COLUMN2COLOR(i), TILESIZE);
+        QVERIFY(store.trySwapOutTileData(td));
+        tileDataList.append(td);
+    }
+
+    QList<KisSwapInJob*> jobs;
+    QThreadPool pool;
+    pool.setMaxThreadCount(NUM_THREADS);
+
+    for (int i = 0; i < NUM_THREADS; i++) {
+        KisSwapInJob *job =
+            new KisSwapInJob(store,
+                             tileDataList.mid(i * TILES_PER_THREAD, TILES_PER_THREAD),
+                             i * TILES_PER_THREAD);
+        job->setAutoDelete(false);
+        jobs.append(job);
+        pool.start(job);
+    }
+
+    pool.waitForDone();
+
+    Q_FOREACH (KisSwapInJob *job, jobs) {
+        QVERIFY(!job->failed());
+        delete job;
+    }
+
+    QCOMPARE(store.numTiles(), quint64(0));
+    QCOMPARE(store.totalSwapMemoryUsed(), qint64(0));
+
+    store.debugStatistics();
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+}
+
 SIMPLE_TEST_MAIN(KisSwappedDataStoreTest)
 
@@ -22,6 +22,9 @@ private Q_SLOTS:
     void testRoundTrip();
     void testRandomAccess();
 
+    void testRoundTripSparse();
+    void testConcurrentSwapInSparse();
+
 };
 
 #endif /* KIS_SWAPPED_DATA_STORE_TEST_H */
@@ -10,6 +10,8 @@
 #include "tiles3/kis_tiled_data_manager.h"
 #include "tiles3/swap/kis_legacy_tile_compressor.h"
 #include "tiles3/swap/kis_tile_compressor_2.h"
+#include "tiles3/swap/kis_lzf_compression.h"
+#include "tiles3/kis_tile_data_store.h"
 
 #include "tiles_test_utils.h"
 
@@ -167,6 +169,200 @@ void KisTileCompressorsTest::testLowLevelRoundTripIncompressible2()
     delete compressor;
 }
 
+void KisTileCompressorsTest::testLowLevelRoundTripAllCodecs()
+{
+    Q_FOREACH (KisCompressionRegistry::CodecId codecId,
+               KisCompressionRegistry::availableCodecs()) {
+
+        dbgKrita << "Testing codec" << KisCompressionRegistry::codecName(codecId);
+
+        KisTileCompressor2 *compressor = new KisTileCompressor2();
+        compressor->setSwapCodecs(codecId, codecId);
+        doLowLevelRoundTrip(compressor);
+        doLowLevelRoundTripIncompressible(compressor);
+        delete compressor;
+    }
+}
+
+void KisTileCompressorsTest::testDecompressLegacyLzfData()
+{
+    const qint32 pixelSize = 1;
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    KisTiledDataManager dm(pixelSize, &oddPixel1);
+    KisTileSP tile = dm.getTile(0, 0, true);
+    tile->lockForWrite();
+
+    KisTileData *td = tile->tileData();
+
+    /**
+     * Emulate the data written by the older versions of Krita,
+     * which used to store LZF-compressed data with flag '1'
+     */
+    KisLzfCompression lzf;
+    QByteArray buffer(lzf.outputBufferSize(TILESIZE) + 1, 0);
+    QByteArray linearized(TILESIZE, 0);
+    KisAbstractCompression::linearizeColors(td->data(), (quint8*)linearized.data(), TILESIZE, pixelSize);
+
+    buffer[0] = 1;
+    const qint32 bytesWritten =
+        lzf.compress((quint8*)linearized.data(), TILESIZE,
+                     (quint8*)buffer.data() + 1, buffer.size() - 1) + 1;
+
+    memset(td->data(), oddPixel2, TILESIZE);
+
+    KisTileCompressor2 compressor;
+    QVERIFY(compressor.decompressTileData((quint8*)buffer.data(), bytesWritten, td));
+    QVERIFY(memoryIsFilled(oddPixel1, td->data(), TILESIZE));
+
+    tile->unlockForWrite();
+}
+
+void KisTileCompressorsTest::testLazyRoundTrip2()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    dm.clear(64, 64, 64, 64, &oddPixel1);
+
+    KisTileCompressor2 compressor;
+
+    KoStoreFake fakeStore;
+    KisFakePaintDeviceWriter writer(&fakeStore);
+
+    QVERIFY(compressor.writeTile(dm.getTile(1, 1, false), writer));
+
+    fakeStore.startReading();
+    dm.clear();
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->testingSuspendBackgroundLoader();
+
+    QVERIFY(compressor.readTileLazily(fakeStore.device(), &dm));
+    QCOMPARE(dm.extent(), QRect(64, 64, 64, 64));
+
+    KisTileSP tile11 = dm.getTile(1, 1, false);
+
+    // the data is still in the swap, it is loaded by the lock
+    QVERIFY(!tile11->tileData()->data());
+
+    tile11->lockForRead();
+    QVERIFY(memoryIsFilled(oddPixel1, tile11->data(), TILESIZE));
+    tile11->unlockForRead();
+
+    store->testingResumeBackgroundLoader();
+    store->testingWaitForBackgroundLoader();
+}
+
+void KisTileCompressorsTest::testLazyBackgroundLoading2()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    dm.clear(64, 64, 64, 64, &oddPixel1);
+
+    KisTileCompressor2 compressor;
+
+    KoStoreFake fakeStore;
+    KisFakePaintDeviceWriter writer(&fakeStore);
+
+    QVERIFY(compressor.writeTile(dm.getTile(1, 1, false), writer));
+
+    fakeStore.startReading();
+    dm.clear();
+
+    QVERIFY(compressor.readTileLazily(fakeStore.device(), &dm));
+
+    KisTileDataStore::instance()->testingWaitForBackgroundLoader();
+
+    // the data has been decoded without any access to the tile
+    KisTileSP tile11 = dm.getTile(1, 1, false);
+    QVERIFY(tile11->tileData()->data());
+    QVERIFY(memoryIsFilled(oddPixel1, tile11->tileData()->data(), TILESIZE));
+}
+
+void KisTileCompressorsTest::testLazyCorruptedData2()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    /**
+     * A pattern that is compressible, but not trivially
+     */
+    for (int i = 0; i < 64; i++) {
+        quint8 pixel = i % 7;
+        dm.clear(64, 64 + i, 64, 1, &pixel);
+    }
+
+    KisTileCompressor2 compressor;
+
+    KoStoreFake fakeStore;
+    KisFakePaintDeviceWriter writer(&fakeStore);
+
+    QVERIFY(compressor.writeTile(dm.getTile(1, 1, false), writer));
+
+    fakeStore.startReading();
+
+    const QList<QByteArray> headerItems = fakeStore.device()->readLine().trimmed().split(',');
+    QCOMPARE(headerItems.size(), 4);
+
+    const QByteArray data = fakeStore.device()->readAll();
+    QCOMPARE(data.size(), headerItems[3].toInt());
+
+    // cut off the end of the compressed stream
+    const QByteArray corruptedData = data.left(data.size() / 2);
+
+    QBuffer corruptedStream;
+    corruptedStream.open(QIODevice::ReadWrite);
+    corruptedStream.write(headerItems[0] + ',' + headerItems[1] + ',' + headerItems[2] + ',' +
+                          QByteArray::number(corruptedData.size()) + '\n');
+    corruptedStream.write(corruptedData);
+    corruptedStream.seek(0);
+
+    dm.clear();
+
+    // the error is reported while loading, not on the first access
+    QVERIFY(!compressor.readTileLazily(&corruptedStream, &dm));
+
+    KisTileSP tile11 = dm.getTile(1, 1, false);
+    QVERIFY(tile11->tileData()->data());
+}
+
+void KisTileCompressorsTest::testCheckCompressedData()
+{
+    /**
+     * A pattern that is compressible, but not trivially
+     */
+    QByteArray input(TILESIZE, 0);
+    for (int i = 0; i < input.size(); i++) {
+        input[i] = (i / 64) % 7 + (i % 5 == 0 ? 1 : 0);
+    }
+
+    Q_FOREACH (KisCompressionRegistry::CodecId codecId,
+               KisCompressionRegistry::availableCodecs()) {
+
+        dbgKrita << "Testing codec" << KisCompressionRegistry::codecName(codecId);
+
+        QScopedPointer<KisAbstractCompression> codec(KisCompressionRegistry::create(codecId));
+
+        QByteArray output(codec->outputBufferSize(input.size()), 0);
+        const qint32 bytesWritten =
+            codec->compress(reinterpret_cast<const quint8*>(input.constData()), input.size(),
+                            reinterpret_cast<quint8*>(output.data()), output.size());
+        QVERIFY(bytesWritten > 0);
+
+        const quint8 *data = reinterpret_cast<const quint8*>(output.constData());
+
+        QVERIFY(codec->checkCompressedData(data, bytesWritten, input.size()));
+
+        QVERIFY(!codec->checkCompressedData(data, bytesWritten / 2, input.size()));
+        QVERIFY(!codec->checkCompressedData(data, bytesWritten, input.size() + 1));
+        QVERIFY(!codec->checkCompressedData(data, bytesWritten, input.size() - 1));
+    }
+}
 
 SIMPLE_TEST_MAIN(KisTileCompressorsTest)
 
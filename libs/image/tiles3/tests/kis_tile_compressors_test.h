@@ -26,6 +26,14 @@ private Q_SLOTS:
     void testRoundTrip2();
     void testLowLevelRoundTrip2();
     void testLowLevelRoundTripIncompressible2();
+
+    void testLowLevelRoundTripAllCodecs();
+    void testDecompressLegacyLzfData();
+
+    void testLazyRoundTrip2();
+    void testLazyBackgroundLoading2();
+    void testLazyCorruptedData2();
+    void testCheckCompressedData();
 };
 
 #endif /* KIS_TILE_COMPRESSORS_TEST_H */
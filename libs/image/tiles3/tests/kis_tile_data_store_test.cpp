@@ -16,6 +16,7 @@
 
 #include "tiles3/kis_tile_data_store.h"
 #include "tiles3/kis_tile_data_store_iterators.h"
+#include "tiles3/swap/kis_compression_registry.h"
 
 
 void KisTileDataStoreTest::testClockIterator()
@@ -176,5 +177,77 @@ void KisTileDataStoreTest::testSwapping()
     }
 }
 
+void KisTileDataStoreTest::testPrefetching()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisTiledDataManager dm(pixelSize, &defaultPixel);
+
+    const qint32 numColumns = 16;
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->tileData()->data(), COLUMN2COLOR(col), TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    store->debugSwapAll();
+    QVERIFY(store->hasSwappedTiles());
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, false);
+        QVERIFY(!tile->tileData()->data());
+    }
+
+    dm.prefetchRect(QRect(0, 0, numColumns * KisTileData::WIDTH, KisTileData::HEIGHT));
+    store->testingWaitForPrefetcher();
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, false);
+        KisTileData *td = tile->tileData();
+
+        // the data should be already loaded by the prefetcher
+        QVERIFY(td->data());
+        QVERIFY(memoryIsFilled(COLUMN2COLOR(col), td->data(), TILESIZE));
+    }
+
+    QVERIFY(!store->hasSwappedTiles());
+}
+
+void KisTileDataStoreTest::testCorruptedSwappedTileData()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 numCorruptedTiles = store->numCorruptedTiles();
+
+    /**
+     * A stream with a valid codec flag, but broken content, as if
+     * a lazily loaded tile could not be decoded on the first access
+     */
+    QByteArray data(64, '\xff');
+    data[0] = KisCompressionRegistry::Lzf;
+
+    KisTileData *td =
+        store->createSwappedTileData(1, reinterpret_cast<const quint8*>(data.constData()), data.size());
+    QVERIFY(td);
+    QVERIFY(!td->data());
+
+    td->ref();
+
+    td->blockSwapping();
+    QVERIFY(td->data());
+    QVERIFY(memoryIsFilled(0, td->data(), TILESIZE));
+    td->unblockSwapping();
+
+    QCOMPARE(store->numCorruptedTiles(), numCorruptedTiles + 1);
+
+    td->deref();
+}
+
 SIMPLE_TEST_MAIN(KisTileDataStoreTest)
 
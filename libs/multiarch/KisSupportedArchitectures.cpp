@@ -132,3 +132,31 @@ QString KisSupportedArchitectures::supportedInstructionSets()
     }();
     return archs;
 }
+
+QStringList KisSupportedArchitectures::optimizedArchNames(bool withAvx512)
+{
+    QStringList result;
+
+#ifdef HAVE_XSIMD
+    const auto available = xsimd::available_architectures();
+
+#ifdef Q_PROCESSOR_X86
+    if (available.sse2) result << xsimd::sse2::name();
+    if (available.ssse3) result << xsimd::ssse3::name();
+    if (available.sse4_1) result << xsimd::sse4_1::name();
+    if (available.avx) result << xsimd::avx::name();
+    if (available.fma3_avx2) result << xsimd::fma3<xsimd::avx2>::name();
+#if HAVE_XSIMD_AVX512
+    if (withAvx512 && available.avx512bw) result << xsimd::avx512bw::name();
+#endif
+#elif XSIMD_WITH_NEON64
+    if (available.neon64) result << xsimd::neon64::name();
+#elif XSIMD_WITH_NEON
+    if (available.neon) result << xsimd::neon::name();
+#else
+    Q_UNUSED(available);
+#endif
+#endif
+
+    return result;
+}
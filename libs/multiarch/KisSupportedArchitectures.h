@@ -10,6 +10,7 @@
 #include "kritamultiarch_export.h"
 
 #include <QString>
+#include <QStringList>
 
 class KRITAMULTIARCH_EXPORT KisSupportedArchitectures
 {
@@ -21,6 +22,18 @@ public:
     static unsigned int bestArch();
 
     static QString supportedInstructionSets();
+
+    /**
+     * Names of the architectures the multiarch factories are compiled
+     * for and that the current CPU supports, from the worst to the
+     * best one. Every name can be passed to createOptimizedClassForArch().
+     *
+     * AVX-512BW is listed only if \p withAvx512 is true, because only
+     * the factories created with createOptimizedClassWithAvx512() are
+     * compiled for it. Pass such names to
+     * createOptimizedClassForArchWithAvx512().
+     */
+    static QStringList optimizedArchNames(bool withAvx512 = false);
 };
 
 #endif // KIS_SUPPORTED_ARCHITECTURES_H
@@ -43,7 +43,6 @@ auto createOptimizedClass(Args &&...param)
     }
 
 #ifdef Q_PROCESSOR_X86
-
     if (!disableAVXOptimizations &&
         xsimd::available_architectures().fma3_avx2) {
 
@@ -83,6 +82,98 @@ auto createOptimizedClass(Args &&...param)
         std::forward<Args>(param)...);
 }
 
+/**
+ * Creates the implementation for the architecture with name \p archName
+ * (as returned by KisSupportedArchitectures::optimizedArchNames()),
+ * ignoring the vectorization settings. Falls back to the scalar
+ * implementation if the architecture is unknown. Used in tests and
+ * benchmarks to compare the implementations with each other.
+ */
+template<class FactoryType, class... Args>
+auto createOptimizedClassForArch(const QString &archName, Args &&...param)
+{
+#ifdef HAVE_XSIMD
+#ifdef Q_PROCESSOR_X86
+    if (archName == xsimd::fma3<xsimd::avx2>::name()) {
+        return FactoryType::template create<xsimd::fma3<xsimd::avx2>>(
+            std::forward<Args>(param)...);
+    } else if (archName == xsimd::avx::name()) {
+        return FactoryType::template create<xsimd::avx>(
+            std::forward<Args>(param)...);
+    } else if (archName == xsimd::sse4_1::name()) {
+        return FactoryType::template create<xsimd::sse4_1>(
+            std::forward<Args>(param)...);
+    } else if (archName == xsimd::ssse3::name()) {
+        return FactoryType::template create<xsimd::ssse3>(
+            std::forward<Args>(param)...);
+    } else if (archName == xsimd::sse2::name()) {
+        return FactoryType::template create<xsimd::sse2>(
+            std::forward<Args>(param)...);
+    }
+#elif XSIMD_WITH_NEON64
+    if (archName == xsimd::neon64::name()) {
+        return FactoryType::template create<xsimd::neon64>(
+            std::forward<Args>(param)...);
+    }
+#elif XSIMD_WITH_NEON
+    if (archName == xsimd::neon::name()) {
+        return FactoryType::template create<xsimd::neon>(
+            std::forward<Args>(param)...);
+    }
+#endif
+#else
+    Q_UNUSED(archName);
+#endif // HAVE_XSIMD
+
+    return FactoryType::template create<xsimd::generic>(
+        std::forward<Args>(param)...);
+}
+
+/**
+ * Same as createOptimizedClass(), but also uses the AVX-512BW
+ * implementation when the CPU supports it. AVX-512 is opt-in: the
+ * factory must be compiled with
+ * ko_compile_for_all_implementations_with_avx512_no_scalar()
+ * and its implementations must be tested at this architecture.
+ */
+template<class FactoryType, class... Args>
+auto createOptimizedClassWithAvx512(Args &&...param)
+{
+#if defined HAVE_XSIMD && defined Q_PROCESSOR_X86 && HAVE_XSIMD_AVX512
+    bool useVectorization = true;
+    bool disableAVXOptimizations = false;
+
+    std::tie(useVectorization, disableAVXOptimizations) =
+        vectorizationConfiguration();
+
+    if (useVectorization && !disableAVXOptimizations &&
+        xsimd::available_architectures().avx512bw) {
+
+        return FactoryType::template create<xsimd::avx512bw>(
+            std::forward<Args>(param)...);
+    }
+#endif
+
+    return createOptimizedClass<FactoryType>(std::forward<Args>(param)...);
+}
+
+/**
+ * Same as createOptimizedClassForArch(), but also accepts the AVX-512BW
+ * architecture name (see createOptimizedClassWithAvx512())
+ */
+template<class FactoryType, class... Args>
+auto createOptimizedClassForArchWithAvx512(const QString &archName, Args &&...param)
+{
+#if defined HAVE_XSIMD && defined Q_PROCESSOR_X86 && HAVE_XSIMD_AVX512
+    if (archName == xsimd::avx512bw::name()) {
+        return FactoryType::template create<xsimd::avx512bw>(
+            std::forward<Args>(param)...);
+    }
+#endif
+
+    return createOptimizedClassForArch<FactoryType>(archName, std::forward<Args>(param)...);
+}
+
 template<class FactoryType, class... Args>
 auto createScalarClass(Args &&...params)
 {
@@ -6,12 +6,14 @@
 
 #include "KoColorConversionCache.h"
 
+#include <QElapsedTimer>
 #include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QThreadStorage>
 
 #include <KoColorSpace.h>
+#include <DebugPigment.h>
 
 struct KoColorConversionCacheKey {
 
@@ -68,6 +70,8 @@ struct KoColorConversionCache::Private {
     QMutex cacheMutex;
 
     QThreadStorage<FastPathCacheItem*> fastStorage;
+
+    Statistics statistics;
 };
 
 
@@ -113,7 +117,18 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
         }
     }
     if (!cacheItem) {
+        QElapsedTimer timer;
+        timer.start();
+
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
+
+        const qint64 creationTime = timer.nsecsElapsed();
+        d->statistics.numCreated++;
+        d->statistics.creationTime += creationTime;
+
+        dbgPigment << "Created color conversion" << src->id() << "->" << dst->id()
+                   << "in" << creationTime / 1000000.0 << "ms";
+
         CachedTransformation* ct = new CachedTransformation(transfo);
         d->cache.insert(key, ct);
         cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
@@ -123,6 +138,12 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
     return cacheItem->second;
 }
 
+KoColorConversionCache::Statistics KoColorConversionCache::statistics() const
+{
+    QMutexLocker lock(&d->cacheMutex);
+    return d->statistics;
+}
+
 void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
 {
     d->fastStorage.setLocalData(0);
@@ -11,16 +11,24 @@ class KoCachedColorConversionTransformation;
 class KoColorSpace;
 
 #include "KoColorConversionTransformation.h"
+#include "kritapigment_export.h"
 
 /**
  * This class holds a cache of KoColorConversionTransformations.
  *
  * This class is not part of public API, and can be changed without notice.
  */
-class KoColorConversionCache
+class KRITAPIGMENT_EXPORT KoColorConversionCache
 {
 public:
     struct CachedTransformation;
+
+    struct Statistics {
+        /// number of transformations created by the cache
+        int numCreated = 0;
+        /// total time spent on creating the transformations (ns)
+        qint64 creationTime = 0;
+    };
 public:
     KoColorConversionCache();
     ~KoColorConversionCache();
@@ -45,6 +53,12 @@ public:
      * @param src source color space
      */
     void colorSpaceIsDestroyed(const KoColorSpace* src);
+
+    /**
+     * @return the number of transformations created so far and the time
+     * spent on creating them. Used for startup time instrumentation.
+     */
+    Statistics statistics() const;
 private:
     struct Private;
     Private* const d;
@@ -46,6 +46,11 @@ bool KoColorSpaceEngine::supportsColorSpace(const QString &colorModelId, const Q
     return true;
 }
 
+KoColorSpaceEngine::TransformCacheStatistics KoColorSpaceEngine::transformCacheStatistics() const
+{
+    return TransformCacheStatistics();
+}
+
 KoColorSpaceEngineRegistry::KoColorSpaceEngineRegistry()
 {
 }
@@ -28,6 +28,22 @@ class KoColorProfile;
  */
 class KRITAPIGMENT_EXPORT KoColorSpaceEngine : public KoColorConversionTransformationAbstractFactory
 {
+public:
+    /**
+     * The statistics of the persistent cache of the transformations
+     * the engine may keep between the sessions
+     */
+    struct TransformCacheStatistics {
+        /// number of transformations loaded from the cache
+        int hits = 0;
+        /// number of cacheable transformations built from scratch
+        int misses = 0;
+        /// time spent on loading the transformations from the cache (ns)
+        qint64 loadTime = 0;
+        /// time saved by loading the transformations instead of building them (ns)
+        qint64 savedTime = 0;
+    };
+
 public:
     KoColorSpaceEngine(const QString& id, const QString& name);
     ~KoColorSpaceEngine() override;
@@ -53,6 +69,12 @@ public:
      */
     virtual bool supportsColorSpace(const QString& colorModelId, const QString& colorDepthId, const KoColorProfile *profile) const;
 
+    /**
+     * \return the statistics of the transformation cache of the engine,
+     * the default implementation has no cache and returns zeros
+     */
+    virtual TransformCacheStatistics transformCacheStatistics() const;
+
 private:
     struct Private;
     Private* const d;
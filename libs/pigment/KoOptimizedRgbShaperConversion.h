@@ -0,0 +1,329 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERCONVERSION_H
+#define KOOPTIMIZEDRGBSHAPERCONVERSION_H
+
+#include <limits>
+#include <type_traits>
+
+#include "KoColorConversionTransformation.h"
+#include "KoRgbShaperConversionData.h"
+#include "KoColorSpaceMaths.h"
+#include "KoBgrColorSpaceTraits.h"
+#include "KoRgbColorSpaceTraits.h"
+#include "KoMultiArchBuildSupport.h"
+
+
+template<typename channels_type>
+struct KoRgbShaperTraits;
+
+template<>
+struct KoRgbShaperTraits<quint8> {
+    using type = KoBgrU8Traits;
+};
+
+template<>
+struct KoRgbShaperTraits<quint16> {
+    using type = KoBgrU16Traits;
+};
+
+#ifdef HAVE_OPENEXR
+template<>
+struct KoRgbShaperTraits<half> {
+    using type = KoRgbF16Traits;
+};
+#endif
+
+template<>
+struct KoRgbShaperTraits<float> {
+    using type = KoRgbF32Traits;
+};
+
+
+/**
+ * Operations of the conversion pipeline that work on planar
+ * (one array per channel) float data. The generic version is
+ * plain scalar code, the specialization below uses xsimd.
+ */
+template<typename _impl, typename EnableDummyType = void>
+struct KoRgbShaperPlanarMath
+{
+    static void applyCurve(const KoShaperCurve &curve, float *values, int numValues)
+    {
+        if (curve.type == KoShaperCurve::Linear) return;
+
+        for (int i = 0; i < numValues; i++) {
+            values[i] = curve.evaluate(values[i]);
+        }
+    }
+
+    static void applyMatrix(const float *m, float *r, float *g, float *b, int numValues)
+    {
+        for (int i = 0; i < numValues; i++) {
+            const float red = r[i];
+            const float green = g[i];
+            const float blue = b[i];
+
+            r[i] = m[0] * red + m[1] * green + m[2] * blue;
+            g[i] = m[3] * red + m[4] * green + m[5] * blue;
+            b[i] = m[6] * red + m[7] * green + m[8] * blue;
+        }
+    }
+
+    /**
+     * Clamps the values into [0, 1] range and scales them into
+     * [0.5, unitValue + 0.5], so that a simple cast rounds them
+     */
+    static void clampAndScale(float *values, int numValues, float unitValue)
+    {
+        for (int i = 0; i < numValues; i++) {
+            values[i] = qBound(0.0f, values[i], 1.0f) * unitValue + 0.5f;
+        }
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+template<typename _impl>
+struct KoRgbShaperPlanarMath<
+        _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using ScalarMath = KoRgbShaperPlanarMath<xsimd::generic>;
+
+    static void applyCurve(const KoShaperCurve &curve, float *values, int numValues)
+    {
+        if (curve.type == KoShaperCurve::Linear) return;
+
+        /**
+         * Tabulated curves need gather operations, which are not
+         * available (or not faster) on most of the architectures
+         */
+        if (curve.type == KoShaperCurve::Table) {
+            ScalarMath::applyCurve(curve, values, numValues);
+            return;
+        }
+
+        const float_v g(curve.g);
+        const float_v a(curve.a);
+        const float_v b(curve.b);
+        const float_v c(curve.c);
+        const float_v d(curve.d);
+        const float_v e(curve.e);
+        const float_v f(curve.f);
+        const float_v s(curve.s);
+        const float_v zero(0.0f);
+
+        const int block = numValues / static_cast<int>(float_v::size);
+        const int rest = numValues % static_cast<int>(float_v::size);
+
+        for (int i = 0; i < block; i++) {
+            const float_v x = float_v::load_unaligned(values);
+
+            const float_v powerPart = s * xsimd::pow(xsimd::max(a * x + b, zero), g) + e;
+            const float_v linearPart = c * x + f;
+
+            xsimd::select(x >= d, powerPart, linearPart).store_unaligned(values);
+
+            values += float_v::size;
+        }
+
+        ScalarMath::applyCurve(curve, values, rest);
+    }
+
+    static void applyMatrix(const float *m, float *r, float *g, float *b, int numValues)
+    {
+        const float_v m0(m[0]), m1(m[1]), m2(m[2]);
+        const float_v m3(m[3]), m4(m[4]), m5(m[5]);
+        const float_v m6(m[6]), m7(m[7]), m8(m[8]);
+
+        const int block = numValues / static_cast<int>(float_v::size);
+        const int rest = numValues % static_cast<int>(float_v::size);
+
+        for (int i = 0; i < block; i++) {
+            const float_v red = float_v::load_unaligned(r);
+            const float_v green = float_v::load_unaligned(g);
+            const float_v blue = float_v::load_unaligned(b);
+
+            xsimd::fma(m0, red, xsimd::fma(m1, green, m2 * blue)).store_unaligned(r);
+            xsimd::fma(m3, red, xsimd::fma(m4, green, m5 * blue)).store_unaligned(g);
+            xsimd::fma(m6, red, xsimd::fma(m7, green, m8 * blue)).store_unaligned(b);
+
+            r += float_v::size;
+            g += float_v::size;
+            b += float_v::size;
+        }
+
+        ScalarMath::applyMatrix(m, r, g, b, rest);
+    }
+
+    static void clampAndScale(float *values, int numValues, float unitValue)
+    {
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+        const float_v unit(unitValue);
+        const float_v half(0.5f);
+
+        const int block = numValues / static_cast<int>(float_v::size);
+        const int rest = numValues % static_cast<int>(float_v::size);
+
+        for (int i = 0; i < block; i++) {
+            const float_v x = xsimd::clip(float_v::load_unaligned(values), zero, one);
+            xsimd::fma(x, unit, half).store_unaligned(values);
+            values += float_v::size;
+        }
+
+        ScalarMath::clampAndScale(values, rest, unitValue);
+    }
+};
+
+#endif /* defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+
+/**
+ * @brief Converts RGBA pixels between two matrix-shaper profiles
+ *
+ * The pixels are processed in chunks. Every chunk is unpacked into
+ * planar float buffers, linearized with the source curves, converted
+ * with a 3x3 matrix, encoded with the destination curves and packed
+ * back. 8-bit sources are linearized via a precomputed lookup
+ * table, which is exact, since the table has an entry for every
+ * possible channel value. Other sources are normalized and the
+ * curves are evaluated directly: a table for every 16-bit value
+ * would take 768 KiB and about 196k pow() calls per transform.
+ *
+ * Alpha channel is copied (and rescaled if needed). In-place
+ * conversion is supported as long as both color spaces have
+ * the same pixel size.
+ */
+template<typename SrcCSTraits, typename DstCSTraits, typename _impl>
+class KoOptimizedRgbShaperConversion : public KoColorConversionTransformation
+{
+    using src_channel_type = typename SrcCSTraits::channels_type;
+    using dst_channel_type = typename DstCSTraits::channels_type;
+    using Math = KoRgbShaperPlanarMath<_impl>;
+
+    static constexpr bool srcIsInteger = std::numeric_limits<src_channel_type>::is_integer;
+    static constexpr bool srcUsesLut = std::is_same<src_channel_type, quint8>::value;
+    static constexpr bool dstIsInteger = std::numeric_limits<dst_channel_type>::is_integer;
+
+    static constexpr int chunkSize = 256;
+
+public:
+    KoOptimizedRgbShaperConversion(const KoColorSpace *srcCs,
+                                   const KoColorSpace *dstCs,
+                                   const KoRgbShaperConversionData &data,
+                                   Intent renderingIntent,
+                                   ConversionFlags conversionFlags)
+        : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+        , m_data(data)
+    {
+        if constexpr (srcUsesLut) {
+            const int numValues = int(KoColorSpaceMathsTraits<src_channel_type>::unitValue) + 1;
+            const float unitValue = KoColorSpaceMathsTraits<src_channel_type>::unitValue;
+
+            for (int ch = 0; ch < 3; ch++) {
+                m_srcLut[ch].resize(numValues);
+                for (int i = 0; i < numValues; i++) {
+                    m_srcLut[ch][i] = m_data.srcCurves[ch].evaluate(i / unitValue);
+                }
+            }
+        }
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override
+    {
+        const typename SrcCSTraits::Pixel *srcPixel =
+            reinterpret_cast<const typename SrcCSTraits::Pixel*>(src);
+        typename DstCSTraits::Pixel *dstPixel =
+            reinterpret_cast<typename DstCSTraits::Pixel*>(dst);
+
+        float red[chunkSize];
+        float green[chunkSize];
+        float blue[chunkSize];
+        src_channel_type alpha[chunkSize];
+
+        while (nPixels > 0) {
+            const int numPixels = qMin(nPixels, chunkSize);
+
+            unpack(srcPixel, red, green, blue, alpha, numPixels);
+
+            Math::applyMatrix(m_data.matrix, red, green, blue, numPixels);
+
+            Math::applyCurve(m_data.dstCurves[0], red, numPixels);
+            Math::applyCurve(m_data.dstCurves[1], green, numPixels);
+            Math::applyCurve(m_data.dstCurves[2], blue, numPixels);
+
+            pack(red, green, blue, alpha, dstPixel, numPixels);
+
+            srcPixel += numPixels;
+            dstPixel += numPixels;
+            nPixels -= numPixels;
+        }
+    }
+
+private:
+    void unpack(const typename SrcCSTraits::Pixel *srcPixel,
+                float *red, float *green, float *blue, src_channel_type *alpha,
+                int numPixels) const
+    {
+        if constexpr (srcUsesLut) {
+            const float *redLut = m_srcLut[0].constData();
+            const float *greenLut = m_srcLut[1].constData();
+            const float *blueLut = m_srcLut[2].constData();
+
+            for (int i = 0; i < numPixels; i++) {
+                red[i] = redLut[srcPixel[i].red];
+                green[i] = greenLut[srcPixel[i].green];
+                blue[i] = blueLut[srcPixel[i].blue];
+                alpha[i] = srcPixel[i].alpha;
+            }
+        } else {
+            const float scale = srcIsInteger ?
+                1.0f / float(KoColorSpaceMathsTraits<src_channel_type>::unitValue) : 1.0f;
+
+            for (int i = 0; i < numPixels; i++) {
+                red[i] = float(srcPixel[i].red) * scale;
+                green[i] = float(srcPixel[i].green) * scale;
+                blue[i] = float(srcPixel[i].blue) * scale;
+                alpha[i] = srcPixel[i].alpha;
+            }
+
+            Math::applyCurve(m_data.srcCurves[0], red, numPixels);
+            Math::applyCurve(m_data.srcCurves[1], green, numPixels);
+            Math::applyCurve(m_data.srcCurves[2], blue, numPixels);
+        }
+    }
+
+    void pack(float *red, float *green, float *blue, const src_channel_type *alpha,
+              typename DstCSTraits::Pixel *dstPixel,
+              int numPixels) const
+    {
+        if constexpr (dstIsInteger) {
+            const float unitValue = KoColorSpaceMathsTraits<dst_channel_type>::unitValue;
+
+            Math::clampAndScale(red, numPixels, unitValue);
+            Math::clampAndScale(green, numPixels, unitValue);
+            Math::clampAndScale(blue, numPixels, unitValue);
+        }
+
+        for (int i = 0; i < numPixels; i++) {
+            dstPixel[i].red = dst_channel_type(red[i]);
+            dstPixel[i].green = dst_channel_type(green[i]);
+            dstPixel[i].blue = dst_channel_type(blue[i]);
+            dstPixel[i].alpha =
+                KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(alpha[i]);
+        }
+    }
+
+private:
+    KoRgbShaperConversionData m_data;
+    QVector<float> m_srcLut[3];
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERCONVERSION_H
@@ -0,0 +1,47 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbShaperConversionFactory.h"
+
+#include <KoConfig.h>
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+
+#include "KoOptimizedRgbShaperConversionFactoryImpl.h"
+
+namespace {
+
+bool isSupportedDepth(const KoID &depthId)
+{
+    return depthId == Integer8BitsColorDepthID ||
+        depthId == Integer16BitsColorDepthID ||
+#ifdef HAVE_OPENEXR
+        depthId == Float16BitsColorDepthID ||
+#endif
+        depthId == Float32BitsColorDepthID;
+}
+
+}
+
+bool KoOptimizedRgbShaperConversionFactory::supportsColorSpaces(const KoColorSpace *srcCs, const KoColorSpace *dstCs)
+{
+    return srcCs->colorModelId() == RGBAColorModelID &&
+        dstCs->colorModelId() == RGBAColorModelID &&
+        isSupportedDepth(srcCs->colorDepthId()) &&
+        isSupportedDepth(dstCs->colorDepthId());
+}
+
+KoColorConversionTransformation *KoOptimizedRgbShaperConversionFactory::create(const KoColorSpace *srcCs,
+                                                                               const KoColorSpace *dstCs,
+                                                                               const KoRgbShaperConversionData &data,
+                                                                               KoColorConversionTransformation::Intent renderingIntent,
+                                                                               KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    if (!supportsColorSpaces(srcCs, dstCs)) return nullptr;
+
+    return createOptimizedClass<KoOptimizedRgbShaperConversionFactoryImpl>(
+        srcCs, dstCs, &data, renderingIntent, conversionFlags);
+}
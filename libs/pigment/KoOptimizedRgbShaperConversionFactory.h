@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORY_H
+#define KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORY_H
+
+#include "KoColorConversionTransformation.h"
+#include "KoRgbShaperConversionData.h"
+
+/**
+ * @brief Creates fast conversions between RGB matrix-shaper profiles
+ *
+ * Color engines may use this factory to convert between two RGBA
+ * color spaces with matrix-shaper profiles without going through
+ * the full CMS pipeline. The engine is responsible for checking that
+ * the profiles are really matrix-shaper ones and for filling
+ * KoRgbShaperConversionData. The factory creates a version of the
+ * conversion optimized for the current CPU architecture.
+ *
+ * \see KoOptimizedRgbShaperConversion
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedRgbShaperConversionFactory
+{
+public:
+    /**
+     * @return true if the conversion between the depths and the models
+     *         of the color spaces is supported (the profiles are not
+     *         checked)
+     */
+    static bool supportsColorSpaces(const KoColorSpace *srcCs, const KoColorSpace *dstCs);
+
+    /**
+     * @return a new conversion or nullptr if the color spaces are not supported
+     */
+    static KoColorConversionTransformation* create(const KoColorSpace *srcCs,
+                                                   const KoColorSpace *dstCs,
+                                                   const KoRgbShaperConversionData &data,
+                                                   KoColorConversionTransformation::Intent renderingIntent,
+                                                   KoColorConversionTransformation::ConversionFlags conversionFlags);
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORY_H
@@ -0,0 +1,69 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbShaperConversionFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedRgbShaperConversion.h"
+
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIdsUtils.h>
+
+namespace {
+
+template<typename _impl>
+struct CreateRgbShaperConversion
+{
+    template<typename src_channel_type>
+    struct ForSource
+    {
+        template<typename dst_channel_type>
+        struct ForDestination
+        {
+            KoColorConversionTransformation* operator() (const KoColorSpace *srcCs,
+                                                         const KoColorSpace *dstCs,
+                                                         const KoRgbShaperConversionData *data,
+                                                         KoColorConversionTransformation::Intent renderingIntent,
+                                                         KoColorConversionTransformation::ConversionFlags conversionFlags)
+            {
+                return new KoOptimizedRgbShaperConversion<
+                    typename KoRgbShaperTraits<src_channel_type>::type,
+                    typename KoRgbShaperTraits<dst_channel_type>::type,
+                    _impl>(srcCs, dstCs, *data, renderingIntent, conversionFlags);
+            }
+        };
+
+        KoColorConversionTransformation* operator() (const KoColorSpace *srcCs,
+                                                     const KoColorSpace *dstCs,
+                                                     const KoRgbShaperConversionData *data,
+                                                     KoColorConversionTransformation::Intent renderingIntent,
+                                                     KoColorConversionTransformation::ConversionFlags conversionFlags)
+        {
+            return channelTypeForColorDepthId<ForDestination>(dstCs->colorDepthId(),
+                                                              srcCs, dstCs, data,
+                                                              renderingIntent, conversionFlags);
+        }
+    };
+};
+
+}
+
+template<>
+KoColorConversionTransformation*
+KoOptimizedRgbShaperConversionFactoryImpl::create<xsimd::current_arch>(
+    const KoColorSpace *srcCs,
+    const KoColorSpace *dstCs,
+    const KoRgbShaperConversionData *data,
+    KoColorConversionTransformation::Intent renderingIntent,
+    KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    return channelTypeForColorDepthId<CreateRgbShaperConversion<xsimd::current_arch>::ForSource>(
+        srcCs->colorDepthId(),
+        srcCs, dstCs, data,
+        renderingIntent, conversionFlags);
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORYIMPL_H
+#define KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORYIMPL_H
+
+#include <KoColorConversionTransformation.h>
+#include <KoMultiArchBuildSupport.h>
+
+struct KoRgbShaperConversionData;
+
+class KRITAPIGMENT_EXPORT KoOptimizedRgbShaperConversionFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoColorConversionTransformation* create(const KoColorSpace *srcCs,
+                                                   const KoColorSpace *dstCs,
+                                                   const KoRgbShaperConversionData *data,
+                                                   KoColorConversionTransformation::Intent renderingIntent,
+                                                   KoColorConversionTransformation::ConversionFlags conversionFlags);
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERCONVERSIONFACTORYIMPL_H
@@ -0,0 +1,64 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoRgbShaperConversionData.h"
+
+#include <cmath>
+
+#include <QtGlobal>
+
+#include <kis_assert.h>
+
+
+KoShaperCurve KoShaperCurve::linear()
+{
+    return KoShaperCurve();
+}
+
+KoShaperCurve KoShaperCurve::parametric(float g, float a, float b, float c, float d,
+                                        float e, float f, float s)
+{
+    KoShaperCurve curve;
+    curve.type = Parametric;
+    curve.g = g;
+    curve.a = a;
+    curve.b = b;
+    curve.c = c;
+    curve.d = d;
+    curve.e = e;
+    curve.f = f;
+    curve.s = s;
+    return curve;
+}
+
+KoShaperCurve KoShaperCurve::table(const QVector<float> &samples)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(samples.size() >= 2, linear());
+
+    KoShaperCurve curve;
+    curve.type = Table;
+    curve.samples = samples;
+    return curve;
+}
+
+float KoShaperCurve::evaluate(float x) const
+{
+    switch (type) {
+    case Linear:
+        return x;
+    case Parametric:
+        return x >= d ? s * std::pow(qMax(0.0f, a * x + b), g) + e : c * x + f;
+    case Table: {
+        const int lastIndex = samples.size() - 1;
+        const float pos = qBound(0.0f, x, 1.0f) * lastIndex;
+        const int index = qMin(int(pos), lastIndex - 1);
+        const float t = pos - index;
+        return samples[index] + t * (samples[index + 1] - samples[index]);
+    }
+    }
+
+    return x;
+}
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KORGBSHAPERCONVERSIONDATA_H
+#define KORGBSHAPERCONVERSIONDATA_H
+
+#include <QVector>
+
+#include "kritapigment_export.h"
+
+/**
+ * @brief A tone reproduction curve of a matrix-shaper profile
+ *
+ * The curve is stored in one of the three forms:
+ *
+ * 1) Linear: the value is passed as it is
+ *
+ * 2) Parametric: the generic form that covers pure gamma and
+ *    sRGB-like parametric curves (LittleCMS types 1, 4 and 5)
+ *    and their inverses:
+ *
+ *    \code
+ *    y = x >= d ? s * (a * x + b)^g + e : c * x + f
+ *    \endcode
+ *
+ *    Parametric curves are evaluated directly, which works for
+ *    unbounded floating point values as well.
+ *
+ * 3) Table: the curve is sampled uniformly in [0, 1] range and
+ *    the values in between are linearly interpolated. The input
+ *    is clamped into [0, 1] range.
+ */
+struct KRITAPIGMENT_EXPORT KoShaperCurve
+{
+    enum Type {
+        Linear,
+        Parametric,
+        Table
+    };
+
+    static KoShaperCurve linear();
+    static KoShaperCurve parametric(float g, float a, float b, float c, float d,
+                                    float e = 0.0f, float f = 0.0f, float s = 1.0f);
+    static KoShaperCurve table(const QVector<float> &samples);
+
+    float evaluate(float x) const;
+
+    Type type = Linear;
+
+    float g = 1.0f;
+    float a = 1.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    float d = 0.0f;
+    float e = 0.0f;
+    float f = 0.0f;
+    float s = 1.0f;
+
+    QVector<float> samples;
+};
+
+/**
+ * All the data needed to convert between two RGB matrix-shaper
+ * profiles:
+ *
+ * 1) \p srcCurves linearize the source channels (red, green, blue)
+ *
+ * 2) \p matrix converts the linear source RGB into linear
+ *    destination RGB (row-major, applied to a column vector)
+ *
+ * 3) \p dstCurves encode the linear destination channels
+ *
+ * The data is filled by the color engine, which knows how to parse
+ * the profiles, and is consumed by KoOptimizedRgbShaperConversionFactory.
+ */
+struct KRITAPIGMENT_EXPORT KoRgbShaperConversionData
+{
+    KoShaperCurve srcCurves[3];
+    KoShaperCurve dstCurves[3];
+    float matrix[9] = {1.0f, 0.0f, 0.0f,
+                       0.0f, 1.0f, 0.0f,
+                       0.0f, 0.0f, 1.0f};
+};
+
+#endif // KORGBSHAPERCONVERSIONDATA_H
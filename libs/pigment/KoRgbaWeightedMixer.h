@@ -0,0 +1,353 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KORGBAWEIGHTEDMIXER_H
+#define KORGBAWEIGHTEDMIXER_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "KoRgbaWeightedMixerBase.h"
+#include "KoColorSpaceMaths.h"
+#include "KoMixColorsOpImpl.h"
+#include "KoMultiArchBuildSupport.h"
+
+
+/**
+ * Scalar accumulator of the mixer. It does exactly the same operations
+ * as KoMixColorsOpImpl for a 4-channel pixel with alpha in the last
+ * channel, so it is used by the generic version of the mixer and for
+ * the tails of the arrays that do not fill a whole vector.
+ */
+template<typename channels_type>
+struct KoRgbaWeightedMixResult
+{
+    using MathsTraits = KoColorSpaceMathsTraits<channels_type>;
+    using mix_type = typename MathsTraits::mixtype;
+
+    static constexpr int pixelSize = 4 * sizeof(channels_type);
+
+    mix_type totals[3] = {0, 0, 0};
+    mix_type totalAlpha = 0;
+
+    void accumulate(const quint8 *colors, const qint16 *weights, int nColors)
+    {
+        for (int i = 0; i < nColors; i++) {
+            const channels_type *color = reinterpret_cast<const channels_type*>(colors);
+
+            mix_type alphaTimesWeight = color[3];
+            alphaTimesWeight *= weights[i];
+
+            for (int c = 0; c < 3; c++) {
+                totals[c] += color[c] * alphaTimesWeight;
+            }
+
+            totalAlpha += alphaTimesWeight;
+            colors += pixelSize;
+        }
+    }
+
+    void computeMixedColor(quint8 *dst, int weightSum) const
+    {
+        channels_type *dstColor = reinterpret_cast<channels_type*>(dst);
+
+        if (totalAlpha > 0) {
+            for (int c = 0; c < 3; c++) {
+                const mix_type v = safeDivideWithRound(totals[c], totalAlpha);
+                dstColor[c] = qBound<mix_type>(MathsTraits::min, v, MathsTraits::max);
+            }
+
+            const mix_type v = safeDivideWithRound(totalAlpha, mix_type(weightSum));
+            dstColor[3] = qBound<mix_type>(MathsTraits::min, v, MathsTraits::max);
+        } else {
+            memset(dst, 0, pixelSize);
+        }
+    }
+};
+
+template<typename _channels_type_,
+         typename _impl,
+         typename EnableDummyType = void>
+struct KoRgbaWeightedMixer : public KoRgbaWeightedMixerBase
+{
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum) const override
+    {
+        KoRgbaWeightedMixResult<_channels_type_> result;
+        result.accumulate(colors, weights, nColors);
+        result.computeMixedColor(dst, weightSum);
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+/**
+ * 8-bit pixels are unpacked from 32-bit lanes and the products
+ * color * alpha * weight are accumulated in 32-bit integer lanes.
+ * Every product fits into 31 bits and the lanes are flushed into the
+ * 64-bit totals before they may overflow, so the result is exactly
+ * the same as the one of the scalar version.
+ */
+template<typename _impl>
+struct KoRgbaWeightedMixer<
+        quint8, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type> : public KoRgbaWeightedMixerBase
+{
+    using int_v = xsimd::batch<int, _impl>;
+    using uint_v = xsimd::batch<unsigned int, _impl>;
+
+    static constexpr int laneSize = static_cast<int>(int_v::size);
+    static constexpr int maxLaneWeight = std::numeric_limits<int>::max() / (255 * 255);
+
+    static void flushLanes(int_v &lanes, qint64 &total)
+    {
+        int values[laneSize];
+        lanes.store_unaligned(values);
+
+        for (int i = 0; i < laneSize; i++) {
+            total += values[i];
+        }
+
+        lanes = int_v(0);
+    }
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum) const override
+    {
+        KoRgbaWeightedMixResult<quint8> result;
+
+        const int block = nColors / laneSize;
+        const int rest = nColors % laneSize;
+
+        const uint_v mask(0xFF);
+
+        int_v total1(0);
+        int_v total2(0);
+        int_v total3(0);
+        int_v totalAlpha(0);
+        int laneWeight = 0;
+
+        auto flushAll = [&] () {
+            flushLanes(total1, result.totals[0]);
+            flushLanes(total2, result.totals[1]);
+            flushLanes(total3, result.totals[2]);
+            flushLanes(totalAlpha, result.totalAlpha);
+        };
+
+        for (int i = 0; i < block; i++) {
+            int laneWeights[laneSize];
+            int maxWeight = 0;
+
+            for (int j = 0; j < laneSize; j++) {
+                laneWeights[j] = weights[j];
+                maxWeight = qMax(maxWeight, qAbs(laneWeights[j]));
+            }
+
+            if (laneWeight + maxWeight > maxLaneWeight) {
+                flushAll();
+                laneWeight = 0;
+            }
+            laneWeight += maxWeight;
+
+            const auto data = uint_v::load_unaligned(reinterpret_cast<const quint32*>(colors));
+            const auto alphaTimesWeight =
+                xsimd::bitwise_cast_compat<int>(data >> 24) * int_v::load_unaligned(laneWeights);
+
+            total1 += xsimd::bitwise_cast_compat<int>(data & mask) * alphaTimesWeight;
+            total2 += xsimd::bitwise_cast_compat<int>((data >> 8) & mask) * alphaTimesWeight;
+            total3 += xsimd::bitwise_cast_compat<int>((data >> 16) & mask) * alphaTimesWeight;
+            totalAlpha += alphaTimesWeight;
+
+            colors += laneSize * 4;
+            weights += laneSize;
+        }
+
+        flushAll();
+
+        result.accumulate(colors, weights, rest);
+        result.computeMixedColor(dst, weightSum);
+    }
+};
+
+/**
+ * 16-bit pixels are unpacked from 64-bit lanes and the products are
+ * accumulated in double lanes. The products take at most 47 bits, and
+ * the lanes are flushed into the 64-bit totals before their sums may
+ * exceed the 53-bit mantissa, so the result is exact as well.
+ *
+ * 32-bit ARM NEON has no double lanes, so it uses the scalar version.
+ */
+template<typename _impl>
+struct KoRgbaWeightedMixer<
+        quint16, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value &&
+                                !std::is_same<_impl, xsimd::neon>::value>::type> : public KoRgbaWeightedMixerBase
+{
+    using double_v = xsimd::batch<double, _impl>;
+    using uint64_v = xsimd::batch<std::uint64_t, _impl>;
+
+    static constexpr int laneSize = static_cast<int>(double_v::size);
+    static constexpr qint64 maxLaneWeight = (qint64(1) << 53) / (qint64(65535) * 65535);
+
+    /**
+     * The values have at most 16 bits, so they are put directly into
+     * the mantissa of 2^52 and the exponent part is subtracted
+     */
+    static double_v toDouble(const uint64_v &value)
+    {
+        const uint64_v exponentBits(0x4330000000000000ULL);
+        return xsimd::bitwise_cast_compat<double>(value | exponentBits) - double_v(4503599627370496.0);
+    }
+
+    static void flushLanes(double_v &lanes, qint64 &total)
+    {
+        double values[laneSize];
+        lanes.store_unaligned(values);
+
+        for (int i = 0; i < laneSize; i++) {
+            total += qint64(values[i]);
+        }
+
+        lanes = double_v(0.0);
+    }
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum) const override
+    {
+        KoRgbaWeightedMixResult<quint16> result;
+
+        const int block = nColors / laneSize;
+        const int rest = nColors % laneSize;
+
+        const uint64_v mask(0xFFFF);
+
+        double_v total1(0.0);
+        double_v total2(0.0);
+        double_v total3(0.0);
+        double_v totalAlpha(0.0);
+        qint64 laneWeight = 0;
+
+        auto flushAll = [&] () {
+            flushLanes(total1, result.totals[0]);
+            flushLanes(total2, result.totals[1]);
+            flushLanes(total3, result.totals[2]);
+            flushLanes(totalAlpha, result.totalAlpha);
+        };
+
+        for (int i = 0; i < block; i++) {
+            double laneWeights[laneSize];
+            int maxWeight = 0;
+
+            for (int j = 0; j < laneSize; j++) {
+                laneWeights[j] = weights[j];
+                maxWeight = qMax(maxWeight, qAbs(int(weights[j])));
+            }
+
+            if (laneWeight + maxWeight > maxLaneWeight) {
+                flushAll();
+                laneWeight = 0;
+            }
+            laneWeight += maxWeight;
+
+            const auto data = uint64_v::load_unaligned(reinterpret_cast<const std::uint64_t*>(colors));
+            const auto alphaTimesWeight = toDouble(data >> 48) * double_v::load_unaligned(laneWeights);
+
+            total1 += toDouble(data & mask) * alphaTimesWeight;
+            total2 += toDouble((data >> 16) & mask) * alphaTimesWeight;
+            total3 += toDouble((data >> 32) & mask) * alphaTimesWeight;
+            totalAlpha += alphaTimesWeight;
+
+            colors += laneSize * 8;
+            weights += laneSize;
+        }
+
+        flushAll();
+
+        result.accumulate(colors, weights, rest);
+        result.computeMixedColor(dst, weightSum);
+    }
+};
+
+/**
+ * Float pixels are converted into double while the block is staged,
+ * the products are accumulated in double lanes. The lanes are summed
+ * in a different order than in the scalar version, so the totals may
+ * differ in the last bits of the double mantissa, which is far below
+ * the precision of the resulting float channels.
+ */
+template<typename _impl>
+struct KoRgbaWeightedMixer<
+        float, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value &&
+                                !std::is_same<_impl, xsimd::neon>::value>::type> : public KoRgbaWeightedMixerBase
+{
+    using double_v = xsimd::batch<double, _impl>;
+
+    static constexpr int laneSize = static_cast<int>(double_v::size);
+
+    static void flushLanes(const double_v &lanes, double &total)
+    {
+        double values[laneSize];
+        lanes.store_unaligned(values);
+
+        for (int i = 0; i < laneSize; i++) {
+            total += values[i];
+        }
+    }
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum) const override
+    {
+        KoRgbaWeightedMixResult<float> result;
+
+        const int block = nColors / laneSize;
+        const int rest = nColors % laneSize;
+
+        double_v total1(0.0);
+        double_v total2(0.0);
+        double_v total3(0.0);
+        double_v totalAlpha(0.0);
+
+        for (int i = 0; i < block; i++) {
+            double c1[laneSize];
+            double c2[laneSize];
+            double c3[laneSize];
+            double alpha[laneSize];
+            double laneWeights[laneSize];
+
+            const float *color = reinterpret_cast<const float*>(colors);
+
+            for (int j = 0; j < laneSize; j++) {
+                c1[j] = color[0];
+                c2[j] = color[1];
+                c3[j] = color[2];
+                alpha[j] = color[3];
+                laneWeights[j] = weights[j];
+                color += 4;
+            }
+
+            const auto alphaTimesWeight =
+                double_v::load_unaligned(alpha) * double_v::load_unaligned(laneWeights);
+
+            total1 += double_v::load_unaligned(c1) * alphaTimesWeight;
+            total2 += double_v::load_unaligned(c2) * alphaTimesWeight;
+            total3 += double_v::load_unaligned(c3) * alphaTimesWeight;
+            totalAlpha += alphaTimesWeight;
+
+            colors += laneSize * 16;
+            weights += laneSize;
+        }
+
+        flushLanes(total1, result.totals[0]);
+        flushLanes(total2, result.totals[1]);
+        flushLanes(total3, result.totals[2]);
+        flushLanes(totalAlpha, result.totalAlpha);
+
+        result.accumulate(colors, weights, rest);
+        result.computeMixedColor(dst, weightSum);
+    }
+};
+
+#endif /* defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KORGBAWEIGHTEDMIXER_H
@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KORGBAWEIGHTEDMIXERBASE_H
+#define KORGBAWEIGHTEDMIXERBASE_H
+
+#include "kritapigment_export.h"
+#include <QtGlobal>
+
+/**
+ * @brief Mixes contiguous arrays of RGBA pixels with integer weights
+ *
+ * The result is the same as the one of the contiguous weighted version
+ * of KoMixColorsOp::mixColors(), but the accumulation is vectorized for
+ * the current CPU architecture.
+ *
+ * \see KoRgbaWeightedMixerFactory
+ */
+class KRITAPIGMENT_EXPORT KoRgbaWeightedMixerBase
+{
+public:
+    virtual ~KoRgbaWeightedMixerBase();
+
+    virtual void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum = 255) const = 0;
+};
+
+#endif // KORGBAWEIGHTEDMIXERBASE_H
@@ -0,0 +1,43 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoRgbaWeightedMixerFactory.h"
+
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+
+#include "KoRgbaWeightedMixerFactoryImpl.h"
+
+namespace {
+
+bool isSupportedDepth(const KoID &depthId)
+{
+    return depthId == Integer8BitsColorDepthID ||
+        depthId == Integer16BitsColorDepthID ||
+        depthId == Float32BitsColorDepthID;
+}
+
+}
+
+bool KoRgbaWeightedMixerFactory::supportsColorSpace(const KoColorSpace *cs)
+{
+    return cs->colorModelId() == RGBAColorModelID &&
+        isSupportedDepth(cs->colorDepthId());
+}
+
+KoRgbaWeightedMixerBase *KoRgbaWeightedMixerFactory::create(const KoID &depthId)
+{
+    if (!isSupportedDepth(depthId)) return nullptr;
+
+    return createOptimizedClass<KoRgbaWeightedMixerFactoryImpl>(depthId);
+}
+
+KoRgbaWeightedMixerBase *KoRgbaWeightedMixerFactory::create(const KoColorSpace *cs)
+{
+    if (!supportsColorSpace(cs)) return nullptr;
+
+    return create(cs->colorDepthId());
+}
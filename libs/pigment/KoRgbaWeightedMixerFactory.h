@@ -0,0 +1,39 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KORGBAWEIGHTEDMIXERFACTORY_H
+#define KORGBAWEIGHTEDMIXERFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+#include <KoRgbaWeightedMixerBase.h>
+
+class KoColorSpace;
+
+class KRITAPIGMENT_EXPORT KoRgbaWeightedMixerFactory
+{
+public:
+    /**
+     * @return true if \p cs is an RGBA color space with 8-bit, 16-bit
+     *         integer or 32-bit float channels
+     */
+    static bool supportsColorSpace(const KoColorSpace *cs);
+
+    /**
+     * @return a new mixer for the RGBA pixels of depth \p depthId or
+     *         nullptr if the depth is not supported
+     */
+    static KoRgbaWeightedMixerBase* create(const KoID &depthId);
+
+    /**
+     * @return a new mixer for the pixels of \p cs or nullptr if the
+     *         color space is not supported
+     */
+    static KoRgbaWeightedMixerBase* create(const KoColorSpace *cs);
+};
+
+#endif // KORGBAWEIGHTEDMIXERFACTORY_H
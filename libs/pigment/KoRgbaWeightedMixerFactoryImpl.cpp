@@ -0,0 +1,29 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoRgbaWeightedMixerFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoRgbaWeightedMixer.h"
+
+#include <KoColorModelStandardIds.h>
+
+template<>
+KoRgbaWeightedMixerBase *
+KoRgbaWeightedMixerFactoryImpl::create<xsimd::current_arch>(const KoID &depthId)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        return new KoRgbaWeightedMixer<quint8, xsimd::current_arch>();
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return new KoRgbaWeightedMixer<quint16, xsimd::current_arch>();
+    } else if (depthId == Float32BitsColorDepthID) {
+        return new KoRgbaWeightedMixer<float, xsimd::current_arch>();
+    }
+
+    return nullptr;
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
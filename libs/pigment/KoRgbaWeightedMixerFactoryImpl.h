@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KORGBAWEIGHTEDMIXERFACTORYIMPL_H
+#define KORGBAWEIGHTEDMIXERFACTORYIMPL_H
+
+#include <KoID.h>
+#include <KoRgbaWeightedMixerBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoRgbaWeightedMixerFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoRgbaWeightedMixerBase* create(const KoID &depthId);
+};
+
+#endif // KORGBAWEIGHTEDMIXERFACTORYIMPL_H
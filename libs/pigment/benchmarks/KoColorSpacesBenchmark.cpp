@@ -9,6 +9,11 @@
 #include <simpletest.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpace.h>
+#include <KoColorProfile.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorConversionTransformation.h>
+
+#include <lcms2.h>
 
 #define NB_PIXELS 1000000
 
@@ -134,4 +139,137 @@ void KoColorSpacesBenchmark::benchmarkSetAlpha2IndividualCall()
     END_BENCHMARK
 }
 
+namespace {
+
+cmsUInt32Number lcmsPixelType(const KoColorSpace *cs)
+{
+    const KoID depthId = cs->colorDepthId();
+
+    if (depthId == Integer8BitsColorDepthID) {
+        return TYPE_BGRA_8;
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return TYPE_BGRA_16;
+    } else if (depthId == Float16BitsColorDepthID) {
+        return TYPE_RGBA_HALF_FLT;
+    }
+
+    return TYPE_RGBA_FLT;
+}
+
+cmsHPROFILE lcmsProfile(const KoColorSpace *cs)
+{
+    const QByteArray rawData = cs->profile()->rawData();
+    return cmsOpenProfileFromMem(rawData.constData(), rawData.size());
+}
+
+}
+
+void KoColorSpacesBenchmark::benchmarkRgbConversion_data()
+{
+    QTest::addColumn<QString>("srcDepthID");
+    QTest::addColumn<QString>("srcProfile");
+    QTest::addColumn<QString>("dstDepthID");
+    QTest::addColumn<QString>("dstProfile");
+    QTest::addColumn<bool>("useLcms");
+
+    const QString srgb = "sRGB-elle-V2-srgbtrc.icc";
+    const QString linear = "sRGB-elle-V2-g10.icc";
+    const QString rec2020 = "Rec2020-elle-V4-g10.icc";
+
+    struct Pair {
+        QString srcDepth;
+        QString srcProfile;
+        QString dstDepth;
+        QString dstProfile;
+    };
+
+    const QVector<Pair> pairs = {
+        {"U8", srgb, "U16", srgb},
+        {"U16", srgb, "U8", srgb},
+        {"U8", srgb, "F16", srgb},
+        {"U8", srgb, "F32", srgb},
+        {"F32", srgb, "U8", srgb},
+        {"U8", srgb, "F32", linear},
+        {"F32", linear, "U8", srgb},
+        {"U16", srgb, "F32", linear},
+        {"F32", linear, "U16", srgb},
+        {"F32", rec2020, "U8", srgb},
+    };
+
+    Q_FOREACH (const Pair &pair, pairs) {
+        if (!KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), pair.srcDepth, pair.srcProfile) ||
+            !KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), pair.dstDepth, pair.dstProfile)) {
+            continue;
+        }
+
+        const QString name = QString("%1 %2 -> %3 %4")
+            .arg(pair.srcProfile, pair.srcDepth, pair.dstProfile, pair.dstDepth);
+
+        QTest::newRow(QString("%1, krita").arg(name).toLatin1().data())
+            << pair.srcDepth << pair.srcProfile << pair.dstDepth << pair.dstProfile << false;
+        QTest::newRow(QString("%1, lcms").arg(name).toLatin1().data())
+            << pair.srcDepth << pair.srcProfile << pair.dstDepth << pair.dstProfile << true;
+    }
+}
+
+void KoColorSpacesBenchmark::benchmarkRgbConversion()
+{
+    QFETCH(QString, srcDepthID);
+    QFETCH(QString, srcProfile);
+    QFETCH(QString, dstDepthID);
+    QFETCH(QString, dstProfile);
+    QFETCH(bool, useLcms);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), srcDepthID, srcProfile);
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), dstDepthID, dstProfile);
+
+    const KoColorConversionTransformation::Intent intent = KoColorConversionTransformation::internalRenderingIntent();
+    KoColorConversionTransformation::ConversionFlags flags = KoColorConversionTransformation::internalConversionFlags();
+
+    QVector<quint8> srcData(NB_PIXELS * srcCs->pixelSize());
+    QVector<quint8> dstData(NB_PIXELS * dstCs->pixelSize());
+
+    {
+        const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
+        QVector<quint8> rgb8Data(NB_PIXELS * rgb8->pixelSize());
+
+        for (int i = 0; i < rgb8Data.size(); i++) {
+            rgb8Data[i] = quint8((i * 37) ^ (i >> 8));
+        }
+        rgb8->convertPixelsTo(rgb8Data.constData(), srcData.data(), srcCs, NB_PIXELS, intent, flags);
+    }
+
+    if (useLcms) {
+        // the same flags as used by the ICC engine
+        if (srcCs->profile()->isLinear() || dstCs->profile()->isLinear()) {
+            flags |= KoColorConversionTransformation::NoOptimization;
+        }
+        flags |= KoColorConversionTransformation::CopyAlpha;
+
+        cmsHPROFILE srcLcmsProfile = lcmsProfile(srcCs);
+        cmsHPROFILE dstLcmsProfile = lcmsProfile(dstCs);
+
+        cmsHTRANSFORM transform = cmsCreateTransform(srcLcmsProfile, lcmsPixelType(srcCs),
+                                                     dstLcmsProfile, lcmsPixelType(dstCs),
+                                                     intent, flags);
+        QVERIFY(transform);
+
+        QBENCHMARK {
+            cmsDoTransform(transform, srcData.constData(), dstData.data(), NB_PIXELS);
+        }
+
+        cmsDeleteTransform(transform);
+        cmsCloseProfile(srcLcmsProfile);
+        cmsCloseProfile(dstLcmsProfile);
+    } else {
+        QScopedPointer<KoColorConversionTransformation> transform(
+            KoColorSpaceRegistry::instance()->createColorConverter(srcCs, dstCs, intent, flags));
+        QVERIFY(transform);
+
+        QBENCHMARK {
+            transform->transform(srcData.constData(), dstData.data(), NB_PIXELS);
+        }
+    }
+}
+
 SIMPLE_TEST_MAIN(KoColorSpacesBenchmark)
@@ -9,9 +9,12 @@
 #include "../compositeops/KoCompositeOpAlphaDarken.h"
 #include "../compositeops/KoCompositeOpOver.h"
 #include <KoOptimizedCompositeOpFactory.h>
+#include <KoOptimizedCompositeOpGenericSCModes.h>
+#include <KisSupportedArchitectures.h>
 
 #include <KoColorSpaceTraits.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoColorSpaceMaths.h>
 
 #include <QRandomGenerator>
 
@@ -98,5 +101,94 @@ void KoCompositeOpsBenchmark::benchmarkCompositeAlphaDarkenCreamy()
     }
 }
 
+namespace {
+
+template<typename channels_type>
+void fillRandomPixels(quint8 *buffer, int numChannels, QRandomGenerator &rng)
+{
+    channels_type *ptr = reinterpret_cast<channels_type*>(buffer);
+
+    for (int i = 0; i < numChannels; i++) {
+        ptr[i] = KoColorSpaceMaths<float, channels_type>::scaleToA(float(rng.generateDouble()));
+    }
+}
+
+}
+
+void KoCompositeOpsBenchmark::benchmarkGenericSCOps_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<QString>("depth");
+    QTest::addColumn<QString>("arch");
+
+    QStringList archs = KisSupportedArchitectures::optimizedArchNames(true);
+    archs.prepend("generic");
+
+    Q_FOREACH (const QString &id, KoOptimizedGenericSCModes::ids()) {
+        Q_FOREACH (const QString &depth, QStringList() << "U8" << "U16" << "F32") {
+            Q_FOREACH (const QString &arch, archs) {
+                QTest::addRow("%s-%s-%s", qPrintable(id), qPrintable(depth), qPrintable(arch))
+                    << id << depth << arch;
+            }
+        }
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkGenericSCOps()
+{
+    QFETCH(QString, id);
+    QFETCH(QString, depth);
+    QFETCH(QString, arch);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", depth, "");
+    QVERIFY(cs);
+
+    const int pixelSize = cs->pixelSize();
+    const int numPixels = IMG_WIDTH * IMG_HEIGHT;
+    const int numChannels = numPixels * cs->channelCount();
+
+    QVector<quint8> dstBuffer(numPixels * pixelSize);
+    QVector<quint8> srcBuffer(numPixels * pixelSize);
+    QVector<quint8> mskBuffer(numPixels);
+
+    QRandomGenerator rng(42);
+
+    if (depth == "U8") {
+        fillRandomPixels<quint8>(dstBuffer.data(), numChannels, rng);
+        fillRandomPixels<quint8>(srcBuffer.data(), numChannels, rng);
+    } else if (depth == "U16") {
+        fillRandomPixels<quint16>(dstBuffer.data(), numChannels, rng);
+        fillRandomPixels<quint16>(srcBuffer.data(), numChannels, rng);
+    } else {
+        fillRandomPixels<float>(dstBuffer.data(), numChannels, rng);
+        fillRandomPixels<float>(srcBuffer.data(), numChannels, rng);
+    }
+    fillRandomPixels<quint8>(mskBuffer.data(), numPixels, rng);
+
+    /**
+     * "generic" is not a name of any optimized architecture, so
+     * the factory falls back to the legacy scalar op
+     */
+    QScopedPointer<KoCompositeOp> compositeOp(
+        KoOptimizedCompositeOpFactory::createGenericSCOpForArch(cs, id, QString(), arch));
+    QVERIFY(compositeOp);
+
+    const int rowStride = IMG_WIDTH * pixelSize;
+    const int maskRowStride = IMG_WIDTH;
+
+    QBENCHMARK {
+        for (int y = 0; y < TILES_IN_HEIGHT; y++) {
+            for (int x = 0; x < TILES_IN_WIDTH; x++) {
+                const int bufOffset = y * TILE_HEIGHT * rowStride + x * TILE_WIDTH * pixelSize;
+                const int maskOffset = y * TILE_HEIGHT * maskRowStride + x * TILE_WIDTH;
+                compositeOp->composite(dstBuffer.data() + bufOffset, rowStride,
+                                       srcBuffer.data() + bufOffset, rowStride,
+                                       mskBuffer.data() + maskOffset, maskRowStride,
+                                       TILE_WIDTH, TILE_HEIGHT,
+                                       OPACITY_HALF);
+            }
+        }
+    }
+}
 
 QTEST_GUILESS_MAIN(KoCompositeOpsBenchmark)
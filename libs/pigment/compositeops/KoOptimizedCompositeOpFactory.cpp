@@ -7,6 +7,8 @@
 #include "KoOptimizedCompositeOpFactoryPerArch.h"
 #include "KoOptimizedCompositeOpFactory.h"
 
+#include <KoColorSpace.h>
+
 KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHard32(const KoColorSpace *cs)
 {
     return createOptimizedClass<
@@ -78,3 +80,32 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp32(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClassWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<quint8>>(cs, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpU64(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClassWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<quint16>>(cs, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp128(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return createOptimizedClassWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<float>>(cs, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpForArch(const KoColorSpace *cs, const QString &id, const QString &category, const QString &archName)
+{
+    switch (cs->pixelSize()) {
+    case 4:
+        return createOptimizedClassForArchWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<quint8>>(archName, cs, id, category);
+    case 8:
+        return createOptimizedClassForArchWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<quint16>>(archName, cs, id, category);
+    case 16:
+        return createOptimizedClassForArchWithAvx512<KoOptimizedGenericSCOpFactoryPerArch<float>>(archName, cs, id, category);
+    default:
+        return nullptr;
+    }
+}
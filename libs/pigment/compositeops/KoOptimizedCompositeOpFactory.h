@@ -11,6 +11,7 @@
 
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
 
 /**
  * The creation of the optimized composite ops is moved into a separate
@@ -39,6 +40,24 @@ public:
     static KoCompositeOp* createCopyOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpHardU64(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpCreamyU64(const KoColorSpace *cs);
+
+    /**
+     * Create vectorized versions of the separable blending modes
+     * (KoCompositeOpGenericSC) for RGBA color spaces. The list of the
+     * supported modes is in KoOptimizedCompositeOpGenericSCModes.h,
+     * for any other mode nullptr is returned.
+     */
+    static KoCompositeOp* createGenericSCOp32(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOpU64(const KoColorSpace *cs, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOp128(const KoColorSpace *cs, const QString &id, const QString &category);
+
+    /**
+     * Same as createGenericSCOp*(), but uses the implementation for
+     * \p archName (see KisSupportedArchitectures::optimizedArchNames(true))
+     * instead of the best one. The depth is selected by the pixel
+     * size of \p cs. Used by the tests and benchmarks.
+     */
+    static KoCompositeOp* createGenericSCOpForArch(const KoColorSpace *cs, const QString &id, const QString &category, const QString &archName);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
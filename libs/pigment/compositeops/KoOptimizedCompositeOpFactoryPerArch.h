@@ -12,6 +12,7 @@
 
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
 
 template<typename _impl>
 class KoOptimizedCompositeOpAlphaDarkenCreamy32;
@@ -55,4 +56,15 @@ struct KoOptimizedCompositeOpFactoryPerArch {
     static KoCompositeOp *create(const KoColorSpace *);
 };
 
+/**
+ * Creates a vectorized version of a separable blending mode for RGBA
+ * color spaces with \p channels_type channels. Returns nullptr if the
+ * mode has no vectorized implementation.
+ */
+template<typename channels_type>
+struct KoOptimizedGenericSCOpFactoryPerArch {
+    template<typename _impl>
+    static KoCompositeOp *create(const KoColorSpace *, const QString &id, const QString &category);
+};
+
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORYPERARCH_H */
@@ -12,6 +12,7 @@
 #include "KoAlphaDarkenParamsWrapper.h"
 #include "KoCompositeOpOver.h"
 #include "KoCompositeOpCopy2.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
 
 template<>
 template<>
@@ -121,3 +122,29 @@ KoCompositeOp *KoOptimizedCompositeOpFactoryPerArch<
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<quint8>::create<xsimd::generic>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return KoOptimizedGenericSCModes::createLegacyOp<quint8>(param, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<quint16>::create<xsimd::generic>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return KoOptimizedGenericSCModes::createLegacyOp<quint16>(param, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<float>::create<xsimd::generic>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return KoOptimizedGenericSCModes::createLegacyOp<float>(param, id, category);
+}
@@ -0,0 +1,516 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICSC_H_
+#define KOOPTIMIZEDCOMPOSITEOPGENERICSC_H_
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+
+/**
+ * Vectorized versions of the separable blending functions from
+ * KoCompositeOpFunctions.h. All the functions work with normalized
+ * channel values, that is, [0.0, 1.0] for the integer color spaces.
+ *
+ * The clamping of the source and destination channels follows the
+ * policies of the scalar functors (see KoCompositeOpGenericFunctorBase.h).
+ * For the integer color spaces the channels are always in SDR range, so
+ * the clamping is a no-op.
+ */
+template<class Mode>
+struct KoVectorBlendFunction;
+
+struct KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampSourceChannelValue(const float_v &value) {
+        return value;
+    }
+
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampDestinationChannelValue(const float_v &value) {
+        return value;
+    }
+};
+
+struct KoVectorBlendClampedSource
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampSourceChannelValue(const float_v &value) {
+        return xsimd::max(float_v(0.0f), xsimd::min(value, float_v(1.0f)));
+    }
+
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampDestinationChannelValue(const float_v &value) {
+        return value;
+    }
+};
+
+struct KoVectorBlendClampedSourceAndDestination
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampSourceChannelValue(const float_v &value) {
+        return xsimd::max(float_v(0.0f), xsimd::min(value, float_v(1.0f)));
+    }
+
+    template<typename float_v>
+    static ALWAYS_INLINE float_v clampDestinationChannelValue(const float_v &value) {
+        return xsimd::max(float_v(0.0f), xsimd::min(value, float_v(1.0f)));
+    }
+};
+
+namespace KoVectorBlendFunctions {
+
+template<typename T, typename float_v>
+ALWAYS_INLINE float_v clampToSDRIfInteger(const float_v &value)
+{
+    if constexpr (std::numeric_limits<T>::is_integer) {
+        return xsimd::max(float_v(0.0f), xsimd::min(value, float_v(1.0f)));
+    } else {
+        return value;
+    }
+}
+
+template<typename float_v>
+ALWAYS_INLINE float_v hardLight(const float_v &src, const float_v &dst)
+{
+    const float_v src2 = src + src;
+    const float_v screenSrc = src2 - float_v(1.0f);
+    const float_v screen = screenSrc + dst - screenSrc * dst;
+    return xsimd::select(src > float_v(0.5f), screen, src2 * dst);
+}
+
+template<typename float_v>
+ALWAYS_INLINE float_v softLight(const float_v &src, const float_v &dst, const float_v &d)
+{
+    const float_v one(1.0f);
+    const float_v src2 = src + src;
+    const float_v lighten = dst + (src2 - one) * (d - dst);
+    const float_v darken = dst - (one - src2) * dst * (one - dst);
+    return xsimd::select(src > float_v(0.5f), lighten, darken);
+}
+
+}
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Multiply<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return src * dst;
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Screen<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return src + dst - src * dst;
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::HardLight<T>> : KoVectorBlendClampedSource
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return KoVectorBlendFunctions::hardLight(src, dst);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Overlay<T>> : KoVectorBlendClampedSource
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return KoVectorBlendFunctions::hardLight(dst, src);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::SoftLight<T>> : KoVectorBlendClampedSourceAndDestination
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return KoVectorBlendFunctions::softLight(src, dst, xsimd::sqrt(dst));
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::SoftLightSvg<T>> : KoVectorBlendClampedSourceAndDestination
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        const float_v d = xsimd::select(dst > float_v(0.25f),
+                                        xsimd::sqrt(dst),
+                                        ((float_v(16.0f) * dst - float_v(12.0f)) * dst + float_v(4.0f)) * dst);
+        return KoVectorBlendFunctions::softLight(src, dst, d);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::ColorDodge<T>> : KoVectorBlendClampedSource
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+
+        const auto srcIsUnit = src >= one;
+        float_v result = dst / (one - xsimd::select(srcIsUnit, zero, src));
+
+        /**
+         * Follow the SDR clamp policy of CFColorDodge exactly: a non-finite
+         * division result (the destination itself is infinite or NaN) is
+         * replaced with the unit value before clamping. NaN fails both
+         * comparisons, so it is handled by the same check.
+         */
+        const auto resultIsFinite = xsimd::abs(result) <= float_v(std::numeric_limits<float>::max());
+        result = xsimd::select(resultIsFinite, xsimd::max(zero, xsimd::min(result, one)), one);
+
+        return xsimd::select(srcIsUnit,
+                             xsimd::select(dst <= zero, zero, one),
+                             result);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::ColorBurn<T>> : KoVectorBlendClampedSourceAndDestination
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+
+        const auto srcIsZero = src <= zero;
+        const float_v result = (one - dst) / xsimd::select(srcIsZero, one, src);
+
+        return xsimd::select(dst >= one, one,
+                             xsimd::select(srcIsZero, zero,
+                                           one - xsimd::max(zero, xsimd::min(result, one))));
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Darken<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return xsimd::min(src, dst);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Lighten<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return xsimd::max(src, dst);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Difference<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return xsimd::abs(src - dst);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Exclusion<T>> : KoVectorBlendClampedSourceAndDestination
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        const float_v x = src * dst;
+        return dst + src - (x + x);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Addition<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return KoVectorBlendFunctions::clampToSDRIfInteger<T>(src + dst);
+    }
+};
+
+template<typename T>
+struct KoVectorBlendFunction<KoOptimizedGenericSCModes::Subtract<T>> : KoVectorBlendNoClamp
+{
+    template<typename float_v>
+    static ALWAYS_INLINE float_v composeChannel(const float_v &src, const float_v &dst) {
+        return KoVectorBlendFunctions::clampToSDRIfInteger<T>(dst - src);
+    }
+};
+
+
+/**
+ * A compositor for KoStreamedMath that implements the formula of
+ * KoCompositeOpGenericSCFunctor::composeColorChannels() for RGBA
+ * pixels with alpha at the last position.
+ *
+ * The vector path handles all the special cases of the scalar op
+ * (transparent/opaque source and destination) with a single blending
+ * formula. The scalar path (used for unaligned pixels, the tail of the
+ * row and for the partial channel flags) just calls the scalar op, so
+ * its results are exactly the same as the ones of the legacy op.
+ */
+template<typename channels_type, class Mode, bool alphaLocked, bool allChannelsFlag>
+struct GenericSCCompositor {
+    using Traits = typename KoOptimizedGenericSCTraits<channels_type>::Traits;
+    using ScalarOp = KoCompositeOpGenericSCFunctor<Traits,
+                                                   typename Mode::ScalarFunctor,
+                                                   KoAdditiveBlendingPolicy<Traits>>;
+    using VectorFunction = KoVectorBlendFunction<Mode>;
+
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : channelFlags(params.channelFlags)
+            , opacity(Arithmetic::scale<channels_type>(params.opacity))
+        {
+        }
+        const QBitArray &channelFlags;
+        const channels_type opacity;
+    };
+
+    /**
+     * The scalar op compares alpha values in the native channel type,
+     * that is, integer alpha is rounded before the comparison and float
+     * alpha is compared in a fuzzy way (see qFuzzyIsNull()). Do the same
+     * to avoid different results for almost transparent pixels.
+     */
+    static ALWAYS_INLINE float alphaThreshold()
+    {
+        if constexpr (std::numeric_limits<channels_type>::is_integer) {
+            return 0.5f / float(KoColorSpaceMathsTraits<channels_type>::unitValue);
+        } else {
+            return 0.00001f;
+        }
+    }
+
+    template<typename float_v>
+    static ALWAYS_INLINE float_v normalizeColor(const float_v &value)
+    {
+        if constexpr (std::numeric_limits<channels_type>::is_integer) {
+            return value * float_v(1.0f / float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        } else {
+            return value;
+        }
+    }
+
+    template<typename float_v>
+    static ALWAYS_INLINE float_v denormalizeColor(const float_v &value)
+    {
+        if constexpr (std::numeric_limits<channels_type>::is_integer) {
+            return value * float_v(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        } else {
+            return value;
+        }
+    }
+
+    template<bool haveMask, bool src_aligned, typename _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        Q_UNUSED(oparams);
+
+        using float_v = typename KoStreamedMath<_impl>::float_v;
+
+        PixelWrapper<channels_type, _impl> dataWrapper;
+
+        float_v src_c1;
+        float_v src_c2;
+        float_v src_c3;
+        float_v src_alpha;
+
+        dataWrapper.read(src, src_c1, src_c2, src_c3, src_alpha);
+
+        src_alpha *= float_v(opacity);
+
+        if (haveMask) {
+            const float_v uint8MaxRec1(1.0f / 255.0f);
+            src_alpha *= KoStreamedMath<_impl>::fetch_mask_8(mask) * uint8MaxRec1;
+        }
+
+        const float_v zeroValue(0.0f);
+        const float_v oneValue(1.0f);
+        const float_v threshold(alphaThreshold());
+
+        // the source cannot change the destination, since it is fully transparent
+        const auto srcAlphaIsZero = src_alpha <= threshold;
+        if (xsimd::all(srcAlphaIsZero)) {
+            return;
+        }
+
+        float_v dst_c1;
+        float_v dst_c2;
+        float_v dst_c3;
+        float_v dst_alpha;
+
+        dataWrapper.read(dst, dst_c1, dst_c2, dst_c3, dst_alpha);
+
+        const auto dstAlphaIsZero = dst_alpha <= threshold;
+        const auto dstAlphaIsUnit = xsimd::abs(dst_alpha - oneValue) <= threshold;
+        const auto srcAlphaIsUnit =
+            (xsimd::abs(src_alpha - oneValue) <= threshold) & !(dstAlphaIsZero | dstAlphaIsUnit);
+
+        const float_v sa = xsimd::select(srcAlphaIsUnit, oneValue, src_alpha);
+        const float_v da = xsimd::select(dstAlphaIsZero, zeroValue,
+                                         xsimd::select(dstAlphaIsUnit, oneValue, dst_alpha));
+
+        float_v new_alpha = xsimd::select(dstAlphaIsUnit | srcAlphaIsUnit,
+                                          oneValue, sa + da - sa * da);
+
+        /**
+         * blend(src, sa, dst, da, cf) / unionShapeOpacity(sa, da) covers
+         * all the special cases of the scalar op, e.g. it becomes
+         * lerp(dst, cf, sa) for an opaque destination and just src for
+         * a transparent one.
+         */
+        const float_v dstWeight = (oneValue - sa) * da;
+        const float_v srcWeight = (oneValue - da) * sa;
+        const float_v blendWeight = sa * da;
+        const float_v newAlphaRec = oneValue / xsimd::select(srcAlphaIsZero, oneValue, new_alpha);
+
+        auto blendChannel = [&] (const float_v &s, float_v &d) {
+            const float_v srcValue = VectorFunction::clampSourceChannelValue(normalizeColor(s));
+            const float_v dstValue = VectorFunction::clampDestinationChannelValue(normalizeColor(d));
+            const float_v cfValue = VectorFunction::composeChannel(srcValue, dstValue);
+
+            float_v result = (dstWeight * dstValue + srcWeight * srcValue + blendWeight * cfValue) * newAlphaRec;
+
+            /**
+             * The scalar op just copies the source over a transparent
+             * destination. Do the same instead of relying on the zero
+             * weights, because 0 * inf gives NaN for an invalid float
+             * destination.
+             */
+            result = xsimd::select(dstAlphaIsZero, srcValue, result);
+
+            if constexpr (std::numeric_limits<channels_type>::is_integer) {
+                result = xsimd::max(zeroValue, xsimd::min(result, oneValue));
+            }
+
+            d = xsimd::select(srcAlphaIsZero, d, denormalizeColor(result));
+        };
+
+        blendChannel(src_c1, dst_c1);
+        blendChannel(src_c2, dst_c2);
+        blendChannel(src_c3, dst_c3);
+
+        new_alpha = xsimd::select(srcAlphaIsZero, dst_alpha, new_alpha);
+
+        dataWrapper.write(dst, dst_c1, dst_c2, dst_c3, new_alpha);
+    }
+
+    template<bool haveMask, typename _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src,
+                                                      quint8 *dst,
+                                                      const quint8 *mask,
+                                                      float opacity,
+                                                      const ParamsWrapper &oparams)
+    {
+        using namespace Arithmetic;
+        Q_UNUSED(opacity);
+
+        const qint32 alpha_pos = 3;
+
+        const auto *s = reinterpret_cast<const channels_type*>(src);
+        auto *d = reinterpret_cast<channels_type*>(dst);
+
+        const channels_type srcAlpha = s[alpha_pos];
+        const channels_type dstAlpha = d[alpha_pos];
+        const channels_type mskAlpha = haveMask ? scale<channels_type>(*mask) : unitValue<channels_type>();
+
+        if (!allChannelsFlag && dstAlpha == zeroValue<channels_type>()) {
+            KoStreamedMathFunctions::clearPixel<4 * sizeof(channels_type)>(dst);
+        }
+
+        const channels_type newDstAlpha =
+            ScalarOp::template composeColorChannels<alphaLocked, allChannelsFlag>(
+                s, srcAlpha, d, dstAlpha, mskAlpha, oparams.opacity, oparams.channelFlags);
+
+        d[alpha_pos] = alphaLocked ? dstAlpha : newDstAlpha;
+    }
+};
+
+/**
+ * An optimized version of KoCompositeOpGenericSCFunctor for RGBA color
+ * spaces with U8, U16 and F32 channels and alpha channel placed at the
+ * last position of the pixel: C1_C2_C3_A.
+ */
+template<typename channels_type, class Mode, typename _impl>
+class KoOptimizedCompositeOpGenericSC : public KoCompositeOp
+{
+    static const int pixelSize = 4 * sizeof(channels_type);
+
+public:
+    KoOptimizedCompositeOpGenericSC(const KoColorSpace* cs, const QString &id, const QString &category)
+        : KoCompositeOp(cs, id, category) {}
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite<haveMask, false, GenericSCCompositor<channels_type, Mode, false, true>, pixelSize>(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSCCompositor<channels_type, Mode, true, true>, pixelSize>(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSCCompositor<channels_type, Mode, false, false>, pixelSize>(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSCCompositor<channels_type, Mode, true, false>, pixelSize>(params);
+            }
+        }
+    }
+};
+
+template<typename channels_type, typename _impl>
+struct KoOptimizedGenericSCOpFactory {
+    template<class Mode>
+    KoCompositeOp *create() const
+    {
+        return new KoOptimizedCompositeOpGenericSC<channels_type, Mode, _impl>(cs, id, category);
+    }
+
+    const KoColorSpace *cs;
+    const QString &id;
+    const QString &category;
+};
+
+template<typename channels_type, typename _impl>
+KoCompositeOp *createOptimizedGenericSCOp(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return KoOptimizedGenericSCModes::dispatch<channels_type>(
+        id, KoOptimizedGenericSCOpFactory<channels_type, _impl>{cs, id, category});
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICSC_H_
@@ -0,0 +1,211 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
+
+#include <QString>
+#include <QStringList>
+
+#include <KoColorSpaceTraits.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpFunctions.h"
+#include "KoColorSpaceBlendingPolicy.h"
+
+/**
+ * The list of separable blending modes that have a vectorized
+ * implementation in KoOptimizedCompositeOpGenericSC.h
+ *
+ * Every mode is described by a tag structure that only knows the scalar
+ * functor used by KoCompositeOpGenericSCFunctor for the same mode. The
+ * vector counterpart is defined as a specialization of
+ * KoVectorBlendFunction<Mode> in KoOptimizedCompositeOpGenericSC.h. The
+ * split lets the scalar build pass create the legacy ops without
+ * including any xsimd code.
+ */
+
+template<typename channels_type>
+struct KoOptimizedGenericSCTraits;
+
+template<>
+struct KoOptimizedGenericSCTraits<quint8> {
+    using Traits = KoBgrU8Traits;
+};
+
+template<>
+struct KoOptimizedGenericSCTraits<quint16> {
+    using Traits = KoBgrU16Traits;
+};
+
+template<>
+struct KoOptimizedGenericSCTraits<float> {
+    using Traits = KoRgbF32Traits;
+};
+
+namespace KoOptimizedGenericSCModes {
+
+template<typename T,
+         T compositeFunc(T, T)>
+using FunctionWrapper =
+    detail::CompositeFunctionWrapper<typename KoOptimizedGenericSCTraits<T>::Traits, compositeFunc>;
+
+template<typename T>
+struct Multiply {
+    using ScalarFunctor = FunctionWrapper<T, &cfMultiply<T>>;
+};
+
+template<typename T>
+struct Screen {
+    using ScalarFunctor = FunctionWrapper<T, &cfScreen<T>>;
+};
+
+template<typename T>
+struct Overlay {
+    using ScalarFunctor = CFOverlay<T>;
+};
+
+template<typename T>
+struct HardLight {
+    using ScalarFunctor = CFHardLight<T>;
+};
+
+template<typename T>
+struct SoftLight {
+    using ScalarFunctor = CFSoftLight<T>;
+};
+
+template<typename T>
+struct SoftLightSvg {
+    using ScalarFunctor = CFSoftLightSvg<T>;
+};
+
+template<typename T>
+struct ColorDodge {
+    using ScalarFunctor = KoCompositeOpClampPolicy::FunctorWithSDRClampPolicy<CFColorDodge, T>;
+};
+
+template<typename T>
+struct ColorBurn {
+    using ScalarFunctor = CFColorBurn<T>;
+};
+
+template<typename T>
+struct Darken {
+    using ScalarFunctor = FunctionWrapper<T, &cfDarkenOnly<T>>;
+};
+
+template<typename T>
+struct Lighten {
+    using ScalarFunctor = FunctionWrapper<T, &cfLightenOnly<T>>;
+};
+
+template<typename T>
+struct Difference {
+    using ScalarFunctor = FunctionWrapper<T, &cfDifference<T>>;
+};
+
+template<typename T>
+struct Exclusion {
+    using ScalarFunctor = CFExclusion<T>;
+};
+
+template<typename T>
+struct Addition {
+    using ScalarFunctor = FunctionWrapper<T, &cfAddition<T>>;
+};
+
+template<typename T>
+struct Subtract {
+    using ScalarFunctor = FunctionWrapper<T, &cfSubtract<T>>;
+};
+
+/**
+ * Calls `factory.template create<Mode>()` for the blending mode
+ * with \p id and returns the result. Returns nullptr if the mode
+ * has no vectorized implementation.
+ */
+template<typename T, class Factory>
+KoCompositeOp *dispatch(const QString &id, const Factory &factory)
+{
+    if (id == COMPOSITE_MULT) {
+        return factory.template create<Multiply<T>>();
+    } else if (id == COMPOSITE_SCREEN) {
+        return factory.template create<Screen<T>>();
+    } else if (id == COMPOSITE_OVERLAY) {
+        return factory.template create<Overlay<T>>();
+    } else if (id == COMPOSITE_HARD_LIGHT) {
+        return factory.template create<HardLight<T>>();
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        return factory.template create<SoftLight<T>>();
+    } else if (id == COMPOSITE_SOFT_LIGHT_SVG) {
+        return factory.template create<SoftLightSvg<T>>();
+    } else if (id == COMPOSITE_DODGE) {
+        return factory.template create<ColorDodge<T>>();
+    } else if (id == COMPOSITE_BURN) {
+        return factory.template create<ColorBurn<T>>();
+    } else if (id == COMPOSITE_DARKEN) {
+        return factory.template create<Darken<T>>();
+    } else if (id == COMPOSITE_LIGHTEN) {
+        return factory.template create<Lighten<T>>();
+    } else if (id == COMPOSITE_DIFF) {
+        return factory.template create<Difference<T>>();
+    } else if (id == COMPOSITE_EXCLUSION) {
+        return factory.template create<Exclusion<T>>();
+    } else if (id == COMPOSITE_ADD || id == COMPOSITE_LINEAR_DODGE) {
+        return factory.template create<Addition<T>>();
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return factory.template create<Subtract<T>>();
+    }
+
+    return nullptr;
+}
+
+/**
+ * Ids of all the modes handled by dispatch()
+ */
+inline QStringList ids()
+{
+    return QStringList()
+        << COMPOSITE_MULT << COMPOSITE_SCREEN << COMPOSITE_OVERLAY
+        << COMPOSITE_HARD_LIGHT << COMPOSITE_SOFT_LIGHT_PHOTOSHOP
+        << COMPOSITE_SOFT_LIGHT_SVG << COMPOSITE_DODGE << COMPOSITE_BURN
+        << COMPOSITE_DARKEN << COMPOSITE_LIGHTEN << COMPOSITE_DIFF
+        << COMPOSITE_EXCLUSION << COMPOSITE_ADD << COMPOSITE_LINEAR_DODGE
+        << COMPOSITE_SUBTRACT;
+}
+
+template<typename T>
+struct LegacyOpFactory {
+    using Traits = typename KoOptimizedGenericSCTraits<T>::Traits;
+
+    template<class Mode>
+    KoCompositeOp *create() const
+    {
+        return new KoCompositeOpGenericSCFunctor<Traits,
+                                                 typename Mode::ScalarFunctor,
+                                                 KoAdditiveBlendingPolicy<Traits>>(cs, id, category);
+    }
+
+    const KoColorSpace *cs;
+    const QString &id;
+    const QString &category;
+};
+
+/**
+ * Creates the scalar op that is used by KoCompositeOps.h for
+ * the same mode, or nullptr if \p id is not handled by dispatch()
+ */
+template<typename T>
+KoCompositeOp *createLegacyOp(const KoColorSpace *cs, const QString &id, const QString &category)
+{
+    return dispatch<T>(id, LegacyOpFactory<T>{cs, id, category});
+}
+
+} // namespace KoOptimizedGenericSCModes
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+/**
+ * The generic SC ops live in a separate per-arch unit, because they are
+ * the only composite ops compiled for AVX-512 as well (see
+ * ko_compile_for_all_implementations_with_avx512_no_scalar)
+ */
+
+#include "KoOptimizedCompositeOpFactoryPerArch.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedCompositeOpGenericSC.h"
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<quint8>::create<xsimd::current_arch>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return createOptimizedGenericSCOp<quint8, xsimd::current_arch>(param, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<quint16>::create<xsimd::current_arch>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return createOptimizedGenericSCOp<quint16, xsimd::current_arch>(param, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedGenericSCOpFactoryPerArch<float>::create<xsimd::current_arch>(
+    const KoColorSpace *param, const QString &id, const QString &category)
+{
+    return createOptimizedGenericSCOp<float, xsimd::current_arch>(param, id, category);
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,260 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedCompositeOpGenericSC.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <QBitArray>
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <simpletest.h>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOp.h>
+#include <KoOptimizedCompositeOpFactory.h>
+#include <KoOptimizedCompositeOpGenericSCModes.h>
+#include <KisSupportedArchitectures.h>
+
+#include <testpigment.h>
+
+namespace {
+
+/**
+ * The row is longer than the widest vector (16 floats for AVX-512) and
+ * is not a multiple of it, so the unaligned head, the vector body and the
+ * scalar tail of the row are all exercised
+ */
+const int numColumns = 67;
+const int numRows = 5;
+
+/**
+ * The same precision as the one kis_composition_benchmark uses to compare
+ * the other optimized ops against the legacy ones. The vector ops use a
+ * single float formula instead of the integer arithmetic, so the results
+ * for the integer color spaces may differ in rounding.
+ */
+template<typename T>
+struct Precision;
+
+template<>
+struct Precision<quint8> {
+    static int value() { return 2; }
+};
+
+template<>
+struct Precision<quint16> {
+    static int value() { return 90; }
+};
+
+template<>
+struct Precision<float> {
+    static float value() { return 1e-5f; }
+};
+
+template<typename T>
+bool compareChannels(T act, T exp)
+{
+    if constexpr (std::numeric_limits<T>::is_integer) {
+        return qAbs(int(act) - int(exp)) <= Precision<T>::value();
+    } else {
+        // infinite values are kept in transparent pixels, compare them exactly
+        if (act == exp) return true;
+        if (!std::isfinite(act) || !std::isfinite(exp)) return false;
+
+        return qAbs(act - exp) <= Precision<T>::value() * qMax(1.0f, qAbs(exp));
+    }
+}
+
+template<typename T>
+T randomAlpha(QRandomGenerator &rng)
+{
+    const T unit = KoColorSpaceMathsTraits<T>::unitValue;
+
+    switch (rng.bounded(4)) {
+    case 0:
+        return KoColorSpaceMathsTraits<T>::zeroValue;
+    case 1:
+        return unit;
+    default:
+        if constexpr (std::numeric_limits<T>::is_integer) {
+            return T(rng.bounded(1, int(unit) + 1));
+        } else {
+            return T(rng.generateDouble());
+        }
+    }
+}
+
+template<typename T>
+T randomColor(QRandomGenerator &rng)
+{
+    if constexpr (std::numeric_limits<T>::is_integer) {
+        return T(rng.bounded(int(KoColorSpaceMathsTraits<T>::unitValue) + 1));
+    } else {
+        static const float outOfRangeValues[] = {-0.5f, 1.5f, 4.0f};
+
+        if (rng.bounded(8) == 0) {
+            return outOfRangeValues[rng.bounded(3)];
+        }
+        return T(rng.generateDouble());
+    }
+}
+
+/**
+ * Fills RGBA pixels with alpha at the last position. A quarter of the
+ * pixels is fully transparent and a quarter is opaque. The float
+ * pixels have out-of-range color values, and the transparent float
+ * destination pixels may also have infinite ones.
+ */
+template<typename T>
+void fillRandomPixels(std::vector<T> &pixels, QRandomGenerator &rng, bool isDestination)
+{
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        const T alpha = randomAlpha<T>(rng);
+
+        for (int ch = 0; ch < 3; ch++) {
+            pixels[i + ch] = randomColor<T>(rng);
+
+            if constexpr (!std::numeric_limits<T>::is_integer) {
+                if (isDestination && alpha == 0.0f && rng.bounded(2)) {
+                    pixels[i + ch] = rng.bounded(2) ?
+                        std::numeric_limits<T>::infinity() :
+                        -std::numeric_limits<T>::infinity();
+                }
+            }
+        }
+
+        pixels[i + 3] = alpha;
+    }
+}
+
+template<typename T>
+void compareWithLegacyOp(const KoColorSpace *cs, const QString &id, const QString &arch)
+{
+    QScopedPointer<KoCompositeOp> opAct(
+        KoOptimizedCompositeOpFactory::createGenericSCOpForArch(cs, id, QString(), arch));
+    QScopedPointer<KoCompositeOp> opExp(
+        KoOptimizedGenericSCModes::createLegacyOp<T>(cs, id, QString()));
+
+    QVERIFY(opAct);
+    QVERIFY(opExp);
+
+    // one extra pixel per row lets us shift the start of the row
+    const int channelsPerRow = (numColumns + 1) * 4;
+    const int rowStride = channelsPerRow * sizeof(T);
+
+    QRandomGenerator rng(1234);
+
+    std::vector<T> src(numRows * channelsPerRow);
+    std::vector<T> dst(numRows * channelsPerRow);
+    std::vector<quint8> mask(numRows * numColumns);
+
+    fillRandomPixels(src, rng, false);
+    fillRandomPixels(dst, rng, true);
+
+    for (size_t i = 0; i < mask.size(); i++) {
+        const int type = rng.bounded(4);
+        mask[i] = type == 0 ? 0 : type == 1 ? 255 : quint8(rng.bounded(256));
+    }
+
+    QBitArray alphaLockedFlags(4, true);
+    alphaLockedFlags.clearBit(3);
+
+    for (int srcShift = 0; srcShift <= 1; srcShift++) {
+        for (int haveMask = 0; haveMask <= 1; haveMask++) {
+            for (float opacity : {1.0f, 0.5f}) {
+                for (int alphaLocked = 0; alphaLocked <= 1; alphaLocked++) {
+                    std::vector<T> dstAct(dst);
+                    std::vector<T> dstExp(dst);
+
+                    KoCompositeOp::ParameterInfo params;
+                    params.dstRowStride = rowStride;
+                    params.srcRowStart = reinterpret_cast<const quint8*>(src.data() + 4 * srcShift);
+                    params.srcRowStride = rowStride;
+                    params.maskRowStart = haveMask ? mask.data() : nullptr;
+                    params.maskRowStride = numColumns;
+                    params.rows = numRows;
+                    params.cols = numColumns;
+                    params.opacity = opacity;
+                    params.flow = 1.0f;
+                    params.channelFlags = alphaLocked ? alphaLockedFlags : QBitArray();
+
+                    // the destination always starts at an unaligned pixel
+                    params.dstRowStart = reinterpret_cast<quint8*>(dstAct.data() + 4);
+                    opAct->composite(params);
+
+                    params.dstRowStart = reinterpret_cast<quint8*>(dstExp.data() + 4);
+                    opExp->composite(params);
+
+                    for (size_t i = 0; i < dstAct.size(); i++) {
+                        if (!compareChannels(dstAct[i], dstExp[i])) {
+                            const size_t pixel = i / 4;
+
+                            QFAIL(qPrintable(
+                                QString("Pixel (%1, %2), channel %3 differs: act %4, exp %5, "
+                                        "src %6, dst %7, dst alpha %8 "
+                                        "(srcShift %9, mask %10, opacity %11, alphaLocked %12)")
+                                    .arg(pixel % (numColumns + 1)).arg(pixel / (numColumns + 1)).arg(i % 4)
+                                    .arg(double(dstAct[i])).arg(double(dstExp[i]))
+                                    .arg(double(src[i - 4 + 4 * srcShift])).arg(double(dst[i]))
+                                    .arg(double(dst[pixel * 4 + 3]))
+                                    .arg(srcShift).arg(haveMask).arg(opacity).arg(alphaLocked)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+void TestKoOptimizedCompositeOpGenericSC::testCompareWithLegacy_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<QString>("depth");
+    QTest::addColumn<QString>("arch");
+
+    const QStringList archs = KisSupportedArchitectures::optimizedArchNames(true);
+
+    if (archs.isEmpty()) {
+        QSKIP("Krita is built without vectorized implementations");
+    }
+
+    Q_FOREACH (const QString &id, KoOptimizedGenericSCModes::ids()) {
+        Q_FOREACH (const QString &depth, QStringList() << "U8" << "U16" << "F32") {
+            Q_FOREACH (const QString &arch, archs) {
+                QTest::addRow("%s-%s-%s", qPrintable(id), qPrintable(depth), qPrintable(arch))
+                    << id << depth << arch;
+            }
+        }
+    }
+}
+
+void TestKoOptimizedCompositeOpGenericSC::testCompareWithLegacy()
+{
+    QFETCH(QString, id);
+    QFETCH(QString, depth);
+    QFETCH(QString, arch);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", depth, "");
+    QVERIFY(cs);
+
+    if (depth == "U8") {
+        compareWithLegacyOp<quint8>(cs, id, arch);
+    } else if (depth == "U16") {
+        compareWithLegacyOp<quint16>(cs, id, arch);
+    } else {
+        compareWithLegacyOp<float>(cs, id, arch);
+    }
+}
+
+KISTEST_MAIN(TestKoOptimizedCompositeOpGenericSC)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+#define TESTKOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+
+#include <QObject>
+
+class TestKoOptimizedCompositeOpGenericSC : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCompareWithLegacy_data();
+    void testCompareWithLegacy();
+};
+
+#endif // TESTKOOPTIMIZEDCOMPOSITEOPGENERICSC_H
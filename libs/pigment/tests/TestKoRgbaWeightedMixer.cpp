@@ -0,0 +1,135 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoRgbaWeightedMixer.h"
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <simpletest.h>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpaceTraits.h>
+#include <KoMixColorsOpImpl.h>
+#include <KoRgbaWeightedMixerFactory.h>
+
+namespace {
+
+template<typename channels_type>
+channels_type randomChannel(QRandomGenerator &random)
+{
+    return channels_type(random.bounded(int(KoColorSpaceMathsTraits<channels_type>::unitValue) + 1));
+}
+
+template<>
+float randomChannel<float>(QRandomGenerator &random)
+{
+    return float(random.generateDouble());
+}
+
+/**
+ * Mixes random spans with the mixer and with the scalar KoMixColorsOpImpl.
+ * The spans are long enough to cover several vectors and a tail, the
+ * weights are either filter-like (summing to 255, some of them negative)
+ * or arbitrary 16-bit values, which forces the integer lanes to be
+ * flushed in the middle of the span. The arbitrary weights are not used
+ * for floating point pixels, since their totals cancel out and the
+ * result depends on the order of summation.
+ */
+template<typename channels_type, typename Compare>
+void testMixImpl(const KoID &depthId, bool useArbitraryWeights, Compare compare)
+{
+    using Traits = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    QScopedPointer<KoRgbaWeightedMixerBase> mixer(KoRgbaWeightedMixerFactory::create(depthId));
+    QVERIFY(mixer);
+
+    KoMixColorsOpImpl<Traits> scalarOp;
+
+    QRandomGenerator random(0x2026);
+
+    for (int nColors = 1; nColors <= 70; nColors++) {
+        for (int pass = 0; pass < 3; pass++) {
+            if (pass == 1 && !useArbitraryWeights) continue;
+
+            QVector<channels_type> colors(nColors * 4);
+            QVector<qint16> weights(nColors);
+
+            for (int i = 0; i < colors.size(); i++) {
+                colors[i] = randomChannel<channels_type>(random);
+            }
+
+            int weightSum = 255;
+
+            if (pass != 1) {
+                int restWeight = 255;
+                for (int i = 0; i < nColors - 1; i++) {
+                    weights[i] = qint16(random.bounded(-16, 64));
+                    restWeight -= weights[i];
+                }
+                weights[nColors - 1] = qint16(qBound(-32768, restWeight, 32767));
+            } else {
+                for (int i = 0; i < nColors; i++) {
+                    weights[i] = qint16(random.bounded(-32768, 32768));
+                }
+                weightSum = random.bounded(1, 65536);
+            }
+
+            // some fully transparent pixels
+            if (pass == 2) {
+                for (int i = 0; i < nColors; i += 3) {
+                    colors[i * 4 + 3] = 0;
+                }
+            }
+
+            channels_type expected[4];
+            channels_type result[4];
+
+            const quint8 *src = reinterpret_cast<const quint8*>(colors.constData());
+
+            scalarOp.mixColors(src, weights.constData(), nColors,
+                               reinterpret_cast<quint8*>(expected), weightSum);
+            mixer->mixColors(src, weights.constData(), nColors,
+                             reinterpret_cast<quint8*>(result), weightSum);
+
+            for (int c = 0; c < 4; c++) {
+                if (!compare(result[c], expected[c])) {
+                    qDebug() << ppVar(nColors) << ppVar(pass) << ppVar(c)
+                             << ppVar(result[c]) << ppVar(expected[c]);
+                    QFAIL("the mixed color is different from the one of KoMixColorsOpImpl");
+                }
+            }
+        }
+    }
+}
+
+}
+
+void TestKoRgbaWeightedMixer::testUnsupportedDepth()
+{
+    QScopedPointer<KoRgbaWeightedMixerBase> mixer(KoRgbaWeightedMixerFactory::create(Float16BitsColorDepthID));
+    QVERIFY(!mixer);
+}
+
+void TestKoRgbaWeightedMixer::testMixU8()
+{
+    testMixImpl<quint8>(Integer8BitsColorDepthID, true,
+                        [] (quint8 a, quint8 b) { return a == b; });
+}
+
+void TestKoRgbaWeightedMixer::testMixU16()
+{
+    testMixImpl<quint16>(Integer16BitsColorDepthID, true,
+                         [] (quint16 a, quint16 b) { return a == b; });
+}
+
+void TestKoRgbaWeightedMixer::testMixF32()
+{
+    testMixImpl<float>(Float32BitsColorDepthID, false,
+                       [] (float a, float b) { return qFuzzyCompare(a + 1.0f, b + 1.0f); });
+}
+
+QTEST_GUILESS_MAIN(TestKoRgbaWeightedMixer)
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKORGBAWEIGHTEDMIXER_H
+#define TESTKORGBAWEIGHTEDMIXER_H
+
+#include <QObject>
+
+class TestKoRgbaWeightedMixer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testUnsupportedDepth();
+    void testMixU8();
+    void testMixU16();
+    void testMixF32();
+};
+
+#endif // TESTKORGBAWEIGHTEDMIXER_H
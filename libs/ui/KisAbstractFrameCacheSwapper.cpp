@@ -8,3 +8,19 @@
 KisAbstractFrameCacheSwapper::~KisAbstractFrameCacheSwapper()
 {
 }
+
+qint64 KisAbstractFrameCacheSwapper::memoryUsage() const
+{
+    return 0;
+}
+
+int KisAbstractFrameCacheSwapper::frameGroupId(int frameId) const
+{
+    return frameId;
+}
+
+bool KisAbstractFrameCacheSwapper::isKeyframe(int frameId) const
+{
+    Q_UNUSED(frameId);
+    return true;
+}
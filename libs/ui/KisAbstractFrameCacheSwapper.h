@@ -8,6 +8,8 @@
 
 #include "kritaui_export.h"
 
+#include <QtGlobal>
+
 class QRect;
 
 template<class T>
@@ -33,6 +35,28 @@ public:
 
     virtual int frameLevelOfDetail(int frameId) const = 0;
     virtual QRect frameDirtyRect(int frameId) const = 0;
+
+    /**
+     * The amount of RAM occupied by the stored frames, in bytes. The
+     * swappers keeping the frames on disk report only the memory of
+     * their in-memory caches.
+     */
+    virtual qint64 memoryUsage() const;
+
+    /**
+     * The frames sharing their stored data, e.g. a keyframe and the
+     * frames stored as a difference to it, have the same group id.
+     * The shared data is freed only when all the frames of the group
+     * are forgotten. By default every frame is a group of its own.
+     */
+    virtual int frameGroupId(int frameId) const;
+
+    /**
+     * @return true if the other frames of the group depend on the data
+     *         of \p frameId. Forgetting such a frame frees nothing until
+     *         the dependent frames are forgotten as well.
+     */
+    virtual bool isKeyframe(int frameId) const;
 };
 
 #endif // KISABSTRACTFRAMECACHESWAPPER_H
@@ -44,6 +44,8 @@
 #include <KoDockRegistry.h>
 #include <KoToolRegistry.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoColorConversionCache.h>
+#include <KoColorSpaceEngine.h>
 #include <KoPluginLoader.h>
 #include <KoShapeRegistry.h>
 #include "KoConfig.h"
@@ -704,6 +706,26 @@ bool KisApplication::start(const KisApplicationArguments &args)
 
     KisUsageLogger::writeSysInfo(KisUsageLogger::screenInformation());
 
+    {
+        const KoColorConversionCache::Statistics stats =
+            KoColorSpaceRegistry::instance()->colorConversionCache()->statistics();
+        KisUsageLogger::log(QString("Created %1 color conversions during startup in %2 ms")
+                            .arg(stats.numCreated)
+                            .arg(stats.creationTime / 1000000.0, 0, 'f', 1));
+
+        KoColorSpaceEngine *iccEngine = KoColorSpaceEngineRegistry::instance()->get("icc");
+        if (iccEngine) {
+            const KoColorSpaceEngine::TransformCacheStatistics cacheStats =
+                iccEngine->transformCacheStatistics();
+            KisUsageLogger::log(QString("Loaded %1 color transformations from the disk cache in %2 ms, "
+                                        "saved %3 ms, built %4 from scratch")
+                                .arg(cacheStats.hits)
+                                .arg(cacheStats.loadTime / 1000000.0, 0, 'f', 1)
+                                .arg(cacheStats.savedTime / 1000000.0, 0, 'f', 1)
+                                .arg(cacheStats.misses));
+        }
+    }
+
     // process File open event files
     if (!d->earlyFileOpenEvents.isEmpty()) {
         hideSplashScreen();
@@ -0,0 +1,432 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisCompressedFrameCacheSwapper.h"
+
+#include <cstring>
+#include <vector>
+
+#include <QMap>
+#include <QSharedPointer>
+
+#include "kis_update_info.h"
+#include "KisFrameCacheStore.h"
+#include "KisFrameDataSerializer.h"
+#include "opengl/KisOpenGLUpdateInfoBuilder.h"
+
+#include "tiles3/swap/kis_abstract_compression.h"
+#include "tiles3/swap/kis_compression_registry.h"
+
+namespace {
+
+struct TileGeometry {
+    int col = -1;
+    int row = -1;
+    QRect rect;
+};
+
+struct CompressedTile {
+    int index = -1;
+    bool isCompressed = false;
+    QByteArray data;
+};
+
+struct FrameData;
+typedef QSharedPointer<FrameData> FrameDataSP;
+
+struct FrameData
+{
+    FrameData(qint64 &memoryUsage, FrameDataSP _keyframe)
+        : keyframe(_keyframe),
+          m_memoryUsage(memoryUsage)
+    {
+    }
+
+    ~FrameData() {
+        m_memoryUsage -= compressedSize;
+    }
+
+    bool isKeyframe() const {
+        return !keyframe;
+    }
+
+    int groupId() const {
+        return isKeyframe() ? keyframeGroupId : keyframe->keyframeGroupId;
+    }
+
+    void addTile(CompressedTile &&tile) {
+        compressedSize += tile.data.size();
+        m_memoryUsage += tile.data.size();
+        tiles.push_back(std::move(tile));
+    }
+
+    QRect dirtyImageRect;
+    QRect imageBounds;
+    int levelOfDetail = 0;
+    int pixelSize = 0;
+    qint64 rawSize = 0;
+    qint64 compressedSize = 0;
+
+    /// the keyframe the frame is a difference to, null for keyframes
+    FrameDataSP keyframe;
+
+    /// the id of the group of the keyframe, used by keyframes only
+    int keyframeGroupId = -1;
+
+    /// the layout of the tiles, filled for keyframes only
+    std::vector<TileGeometry> layout;
+
+    /// the stored tiles sorted by index; the tiles that are
+    /// equal to the ones of the keyframe are not stored
+    std::vector<CompressedTile> tiles;
+
+private:
+    qint64 &m_memoryUsage;
+};
+
+qint64 decodedFrameSize(const KisFrameDataSerializer::Frame &frame)
+{
+    qint64 size = 0;
+    for (auto it = frame.frameTiles.begin(); it != frame.frameTiles.end(); ++it) {
+        size += it->data.size();
+    }
+    return size;
+}
+
+}
+
+
+struct KRITAUI_NO_EXPORT KisCompressedFrameCacheSwapper::Private
+{
+    Private(const KisOpenGLUpdateInfoBuilder &_builder)
+        : builder(_builder),
+          compression(KisCompressionRegistry::create(KisCompressionRegistry::fastestCodec()))
+    {
+    }
+
+    CompressedTile compressTile(int index, const KisFrameDataSerializer::FrameTile &tile, int pixelSize);
+    bool decompressTile(const CompressedTile &src, KisFrameDataSerializer::FrameTile &dst, int pixelSize);
+
+    KisFrameDataSerializer::Frame decodeKeyframe(FrameDataSP keyframe);
+    const KisFrameDataSerializer::Frame& decodedKeyframe(FrameDataSP keyframe);
+
+    const KisOpenGLUpdateInfoBuilder &builder;
+    QScopedPointer<KisAbstractCompression> compression;
+    QByteArray compressionBuffer;
+
+    // the counter should be destroyed after *all* the frame data
+    // objects, because they update it in their own destruction
+    qint64 compressedMemoryUsage = 0;
+
+    KisFrameDataSerializer::Frame lastSavedKeyframe;
+    FrameDataSP lastSavedKeyframeData;
+
+    KisFrameDataSerializer::Frame lastLoadedKeyframe;
+    FrameDataSP lastLoadedKeyframeData;
+
+    QMap<int, FrameDataSP> savedFrames;
+    int nextKeyframeGroupId = 0;
+};
+
+CompressedTile KisCompressedFrameCacheSwapper::Private::compressTile(int index, const KisFrameDataSerializer::FrameTile &tile, int pixelSize)
+{
+    CompressedTile result;
+    result.index = index;
+
+    const int numBytes = pixelSize * tile.rect.width() * tile.rect.height();
+    const int maxBufferSize = compression->outputBufferSize(numBytes);
+
+    if (compressionBuffer.size() < maxBufferSize) {
+        compressionBuffer.resize(maxBufferSize);
+    }
+    quint8 *buffer = reinterpret_cast<quint8*>(compressionBuffer.data());
+
+    const int compressedSize =
+        compression->compress(tile.data.data(), numBytes, buffer, maxBufferSize);
+
+    result.isCompressed = compressedSize > 0 && compressedSize < numBytes;
+
+    if (result.isCompressed) {
+        result.data = QByteArray(reinterpret_cast<const char*>(buffer), compressedSize);
+    } else {
+        result.data = QByteArray(reinterpret_cast<const char*>(tile.data.data()), numBytes);
+    }
+
+    return result;
+}
+
+bool KisCompressedFrameCacheSwapper::Private::decompressTile(const CompressedTile &src, KisFrameDataSerializer::FrameTile &dst, int pixelSize)
+{
+    const int numBytes = pixelSize * dst.rect.width() * dst.rect.height();
+
+    dst.data.allocate(pixelSize);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(numBytes <= dst.data.size(), false);
+
+    const quint8 *srcData = reinterpret_cast<const quint8*>(src.data.constData());
+
+    if (src.isCompressed) {
+        const int decompressedSize =
+            compression->decompress(srcData, src.data.size(), dst.data.data(), numBytes);
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(decompressedSize == numBytes, false);
+    } else {
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(src.data.size() == numBytes, false);
+        memcpy(dst.data.data(), srcData, numBytes);
+    }
+
+    return true;
+}
+
+KisFrameDataSerializer::Frame KisCompressedFrameCacheSwapper::Private::decodeKeyframe(FrameDataSP keyframe)
+{
+    KisFrameDataSerializer::Frame frame;
+    frame.pixelSize = keyframe->pixelSize;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(keyframe->tiles.size() == keyframe->layout.size(),
+                                         KisFrameDataSerializer::Frame());
+
+    for (auto it = keyframe->tiles.begin(); it != keyframe->tiles.end(); ++it) {
+        const TileGeometry &geometry = keyframe->layout[it->index];
+
+        KisFrameDataSerializer::FrameTile tile(builder.textureInfoPool());
+        tile.col = geometry.col;
+        tile.row = geometry.row;
+        tile.rect = geometry.rect;
+
+        if (!decompressTile(*it, tile, frame.pixelSize)) {
+            return KisFrameDataSerializer::Frame();
+        }
+
+        frame.frameTiles.push_back(std::move(tile));
+    }
+
+    return frame;
+}
+
+const KisFrameDataSerializer::Frame& KisCompressedFrameCacheSwapper::Private::decodedKeyframe(FrameDataSP keyframe)
+{
+    if (keyframe == lastSavedKeyframeData) {
+        return lastSavedKeyframe;
+    }
+
+    if (keyframe != lastLoadedKeyframeData) {
+        lastLoadedKeyframe = decodeKeyframe(keyframe);
+        lastLoadedKeyframeData = keyframe;
+    }
+
+    return lastLoadedKeyframe;
+}
+
+
+KisCompressedFrameCacheSwapper::KisCompressedFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder)
+    : m_d(new Private(builder))
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->compression);
+}
+
+KisCompressedFrameCacheSwapper::~KisCompressedFrameCacheSwapper()
+{
+}
+
+void KisCompressedFrameCacheSwapper::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds)
+{
+    KisFrameDataSerializer::Frame frame = KisFrameCacheStore::frameFromUpdateInfo(info);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(frame.isValid());
+
+    KIS_SAFE_ASSERT_RECOVER(!m_d->savedFrames.contains(frameId)) {
+        forgetFrame(frameId);
+    }
+
+    FrameDataSP keyframe;
+
+    if (m_d->lastSavedKeyframe.isValid() &&
+        m_d->lastSavedKeyframeData->levelOfDetail == info->levelOfDetail()) {
+
+        boost::optional<qreal> uniqueness =
+            KisFrameDataSerializer::estimateFrameUniqueness(m_d->lastSavedKeyframe, frame, 0.01);
+
+        if (uniqueness && *uniqueness < 0.5) {
+            keyframe = m_d->lastSavedKeyframeData;
+        }
+    }
+
+    FrameDataSP frameData(new FrameData(m_d->compressedMemoryUsage, keyframe));
+    frameData->dirtyImageRect = info->dirtyImageRect();
+    frameData->imageBounds = imageBounds;
+    frameData->levelOfDetail = info->levelOfDetail();
+    frameData->pixelSize = frame.pixelSize;
+
+    if (!keyframe) {
+        frameData->keyframeGroupId = m_d->nextKeyframeGroupId++;
+    }
+
+    for (int i = 0; i < int(frame.frameTiles.size()); i++) {
+        KisFrameDataSerializer::FrameTile &tile = frame.frameTiles[i];
+
+        frameData->rawSize += frame.pixelSize * tile.rect.width() * tile.rect.height();
+
+        if (keyframe) {
+            const bool tileIsSame =
+                KisFrameDataSerializer::subtractTiles(tile, m_d->lastSavedKeyframe.frameTiles[i], frame.pixelSize);
+
+            if (tileIsSame) continue;
+        } else {
+            TileGeometry geometry;
+            geometry.col = tile.col;
+            geometry.row = tile.row;
+            geometry.rect = tile.rect;
+            frameData->layout.push_back(geometry);
+        }
+
+        frameData->addTile(m_d->compressTile(i, tile, frame.pixelSize));
+    }
+
+    if (!keyframe) {
+        m_d->lastSavedKeyframe = std::move(frame);
+        m_d->lastSavedKeyframeData = frameData;
+    }
+
+    m_d->savedFrames.insert(frameId, frameData);
+}
+
+KisOpenGLUpdateInfoSP KisCompressedFrameCacheSwapper::loadFrame(int frameId)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), KisOpenGLUpdateInfoSP());
+
+    FrameDataSP frameData = m_d->savedFrames[frameId];
+    FrameDataSP keyframe = frameData->isKeyframe() ? frameData : frameData->keyframe;
+
+    const KisFrameDataSerializer::Frame &baseFrame = m_d->decodedKeyframe(keyframe);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(baseFrame.isValid(), KisOpenGLUpdateInfoSP());
+
+    KisFrameDataSerializer::Frame frame;
+
+    if (frameData->isKeyframe()) {
+        frame = baseFrame.clone();
+    } else {
+        frame.pixelSize = baseFrame.pixelSize;
+
+        auto diffIt = frameData->tiles.begin();
+
+        for (int i = 0; i < int(baseFrame.frameTiles.size()); i++) {
+            const KisFrameDataSerializer::FrameTile &baseTile = baseFrame.frameTiles[i];
+
+            if (diffIt == frameData->tiles.end() || diffIt->index != i) {
+                frame.frameTiles.push_back(baseTile.clone());
+                continue;
+            }
+
+            KisFrameDataSerializer::FrameTile tile(m_d->builder.textureInfoPool());
+            tile.col = baseTile.col;
+            tile.row = baseTile.row;
+            tile.rect = baseTile.rect;
+
+            if (!m_d->decompressTile(*diffIt, tile, frame.pixelSize)) {
+                return KisOpenGLUpdateInfoSP();
+            }
+
+            KisFrameDataSerializer::addTiles(tile, baseTile, frame.pixelSize);
+            frame.frameTiles.push_back(std::move(tile));
+
+            ++diffIt;
+        }
+
+        KIS_SAFE_ASSERT_RECOVER_NOOP(diffIt == frameData->tiles.end());
+    }
+
+    return KisFrameCacheStore::updateInfoFromFrame(frame,
+                                                   frameData->dirtyImageRect,
+                                                   frameData->imageBounds,
+                                                   frameData->levelOfDetail,
+                                                   m_d->builder);
+}
+
+void KisCompressedFrameCacheSwapper::moveFrame(int srcFrameId, int dstFrameId)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(srcFrameId != dstFrameId);
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_d->savedFrames.contains(srcFrameId));
+
+    KIS_SAFE_ASSERT_RECOVER(!m_d->savedFrames.contains(dstFrameId)) {
+        m_d->savedFrames.remove(dstFrameId);
+    }
+
+    m_d->savedFrames.insert(dstFrameId, m_d->savedFrames[srcFrameId]);
+    m_d->savedFrames.remove(srcFrameId);
+}
+
+void KisCompressedFrameCacheSwapper::forgetFrame(int frameId)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_d->savedFrames.contains(frameId));
+
+    FrameDataSP frameData = m_d->savedFrames.take(frameId);
+
+    /**
+     * The dependent frames still keep the compressed keyframe alive,
+     * but its uncompressed copy can be dropped. It will be decoded
+     * again if any of them is loaded.
+     */
+    if (frameData == m_d->lastSavedKeyframeData) {
+        m_d->lastSavedKeyframe = KisFrameDataSerializer::Frame();
+        m_d->lastSavedKeyframeData.clear();
+    }
+
+    if (frameData == m_d->lastLoadedKeyframeData) {
+        m_d->lastLoadedKeyframe = KisFrameDataSerializer::Frame();
+        m_d->lastLoadedKeyframeData.clear();
+    }
+}
+
+bool KisCompressedFrameCacheSwapper::hasFrame(int frameId) const
+{
+    return m_d->savedFrames.contains(frameId);
+}
+
+int KisCompressedFrameCacheSwapper::frameLevelOfDetail(int frameId) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), 0);
+    return m_d->savedFrames[frameId]->levelOfDetail;
+}
+
+QRect KisCompressedFrameCacheSwapper::frameDirtyRect(int frameId) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), QRect());
+    return m_d->savedFrames[frameId]->dirtyImageRect;
+}
+
+qint64 KisCompressedFrameCacheSwapper::memoryUsage() const
+{
+    return m_d->compressedMemoryUsage +
+        decodedFrameSize(m_d->lastSavedKeyframe) +
+        decodedFrameSize(m_d->lastLoadedKeyframe);
+}
+
+int KisCompressedFrameCacheSwapper::frameGroupId(int frameId) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), -1);
+    return m_d->savedFrames[frameId]->groupId();
+}
+
+bool KisCompressedFrameCacheSwapper::isKeyframe(int frameId) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), false);
+    return m_d->savedFrames[frameId]->isKeyframe();
+}
+
+KisCompressedFrameCacheSwapper::Statistics KisCompressedFrameCacheSwapper::statistics() const
+{
+    Statistics stats;
+
+    stats.numFrames = m_d->savedFrames.size();
+    stats.compressedSize = m_d->compressedMemoryUsage;
+
+    Q_FOREACH (FrameDataSP frameData, m_d->savedFrames) {
+        stats.rawSize += frameData->rawSize;
+        if (frameData->isKeyframe()) {
+            stats.numKeyframes++;
+        }
+    }
+
+    return stats;
+}
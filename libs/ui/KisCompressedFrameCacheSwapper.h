@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISCOMPRESSEDFRAMECACHESWAPPER_H
+#define KISCOMPRESSEDFRAMECACHESWAPPER_H
+
+#include <QScopedPointer>
+
+#include "KisAbstractFrameCacheSwapper.h"
+
+class KisOpenGLUpdateInfoBuilder;
+
+
+/**
+ * KisCompressedFrameCacheSwapper keeps the animation frames in memory,
+ * but in a compact form:
+ *
+ * 1) Every frame that is similar enough to the last keyframe is stored
+ *    as a difference to it, and only the tiles where the difference is
+ *    non-zero are stored at all. A frame that is too different from the
+ *    keyframe (or has a different tile layout) becomes a new keyframe.
+ *
+ * 2) The stored tiles are compressed with the fastest codec available
+ *    (LZ4 when Krita is built with it, LZF otherwise). The differences
+ *    consist mostly of zeros, so they compress very well.
+ *
+ * 3) The last saved and the last loaded keyframes are kept uncompressed,
+ *    so sequential playback decompresses only the changed tiles of every
+ *    frame.
+ *
+ * The keyframes are shared between the dependent frames, so a keyframe
+ * stays in memory until all its dependent frames are forgotten.
+ */
+class KRITAUI_EXPORT KisCompressedFrameCacheSwapper : public KisAbstractFrameCacheSwapper
+{
+public:
+    struct Statistics {
+        int numFrames = 0;
+        int numKeyframes = 0;
+
+        /// the size the frames would take if stored as plain pixel data
+        qint64 rawSize = 0;
+
+        /// the size of the compressed data of the frames
+        qint64 compressedSize = 0;
+    };
+
+public:
+    KisCompressedFrameCacheSwapper(const KisOpenGLUpdateInfoBuilder &builder);
+    ~KisCompressedFrameCacheSwapper();
+
+    // WARNING: after transferring \p info to saveFrame() the object becomes invalid
+    void saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds) override;
+    KisOpenGLUpdateInfoSP loadFrame(int frameId) override;
+
+    void moveFrame(int srcFrameId, int dstFrameId) override;
+
+    void forgetFrame(int frameId) override;
+    bool hasFrame(int frameId) const override;
+
+    int frameLevelOfDetail(int frameId) const override;
+
+    QRect frameDirtyRect(int frameId) const override;
+
+    /**
+     * The compressed data of all the frames plus the uncompressed
+     * keyframes kept for saving and loading
+     */
+    qint64 memoryUsage() const override;
+
+    int frameGroupId(int frameId) const override;
+    bool isKeyframe(int frameId) const override;
+
+    Statistics statistics() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISCOMPRESSEDFRAMECACHESWAPPER_H
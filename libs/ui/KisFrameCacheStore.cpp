@@ -148,7 +148,7 @@ KisFrameCacheStore::~KisFrameCacheStore()
 {
 }
 
-void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds)
+KisFrameDataSerializer::Frame KisFrameCacheStore::frameFromUpdateInfo(KisOpenGLUpdateInfoSP info)
 {
     int pixelSize = 0;
 
@@ -157,7 +157,7 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
         if (!pixelSize) {
             pixelSize = tile->pixelSize();
         } else {
-            KIS_SAFE_ASSERT_RECOVER_RETURN(pixelSize == tile->pixelSize());
+            KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(pixelSize == tile->pixelSize(), KisFrameDataSerializer::Frame());
         }
 #else
         pixelSize = tile->pixelSize();
@@ -165,7 +165,7 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
 #endif
     }
 
-    KIS_SAFE_ASSERT_RECOVER_RETURN(pixelSize);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(pixelSize, KisFrameDataSerializer::Frame());
 
     // TODO: assert that dirty image rect is equal to the full image rect
     // TODO: assert tile color space coincides with the destination color space
@@ -185,6 +185,54 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
         frame.frameTiles.push_back(std::move(tile));
     }
 
+    return frame;
+}
+
+KisOpenGLUpdateInfoSP KisFrameCacheStore::updateInfoFromFrame(KisFrameDataSerializer::Frame &frame,
+                                                              const QRect &dirtyImageRect,
+                                                              const QRect &imageBounds,
+                                                              int levelOfDetail,
+                                                              const KisOpenGLUpdateInfoBuilder &builder)
+{
+    KisOpenGLUpdateInfoSP info = new KisOpenGLUpdateInfo();
+
+    info->assignDirtyImageRect(dirtyImageRect);
+    info->assignLevelOfDetail(levelOfDetail);
+
+    for (auto it = frame.frameTiles.begin(); it != frame.frameTiles.end(); ++it) {
+        KisFrameDataSerializer::FrameTile &tile = *it;
+
+        QRect patchRect = tile.rect;
+
+        if (levelOfDetail) {
+            patchRect = KisLodTransform::upscaledRect(patchRect, levelOfDetail);
+        }
+
+        const QRect fullSizeTileRect =
+            builder.calculatePhysicalTileRect(tile.col, tile.row,
+                                              imageBounds,
+                                              levelOfDetail);
+
+        KisTextureTileUpdateInfoSP tileInfo(
+            new KisTextureTileUpdateInfo(tile.col, tile.row,
+                                         fullSizeTileRect, patchRect,
+                                         imageBounds,
+                                         levelOfDetail,
+                                         builder.textureInfoPool()));
+
+        tileInfo->putPixelData(std::move(tile.data), builder.destinationColorSpace());
+
+        info->tileList << tileInfo;
+    }
+
+    return info;
+}
+
+void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds)
+{
+    KisFrameDataSerializer::Frame frame = frameFromUpdateInfo(info);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(frame.isValid());
+
     FrameInfoSP frameInfo;
 
     if (m_d->lastSavedFullFrame.isValid()) {
@@ -244,14 +292,10 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
 
 KisOpenGLUpdateInfoSP KisFrameCacheStore::loadFrame(int frameId, const KisOpenGLUpdateInfoBuilder &builder)
 {
-    KisOpenGLUpdateInfoSP info = new KisOpenGLUpdateInfo();
-    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), info);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->savedFrames.contains(frameId), new KisOpenGLUpdateInfo());
 
     FrameInfoSP frameInfo = m_d->savedFrames[frameId];
 
-    info->assignDirtyImageRect(frameInfo->dirtyImageRect());
-    info->assignLevelOfDetail(frameInfo->levelOfDetail());
-
     KisFrameDataSerializer::Frame frame;
 
     switch (frameInfo->type()) {
@@ -295,33 +339,11 @@ KisOpenGLUpdateInfoSP KisFrameCacheStore::loadFrame(int frameId, const KisOpenGL
     }
     }
 
-    for (auto it = frame.frameTiles.begin(); it != frame.frameTiles.end(); ++it) {
-        KisFrameDataSerializer::FrameTile &tile = *it;
-
-        QRect patchRect = tile.rect;
-
-        if (frameInfo->levelOfDetail()) {
-            patchRect = KisLodTransform::upscaledRect(patchRect, frameInfo->levelOfDetail());
-        }
-
-        const QRect fullSizeTileRect =
-            builder.calculatePhysicalTileRect(tile.col, tile.row,
-                                              frameInfo->imageBounds(),
-                                              frameInfo->levelOfDetail());
-
-        KisTextureTileUpdateInfoSP tileInfo(
-            new KisTextureTileUpdateInfo(tile.col, tile.row,
-                                         fullSizeTileRect, patchRect,
-                                         frameInfo->imageBounds(),
-                                         frameInfo->levelOfDetail(),
-                                         builder.textureInfoPool()));
-
-        tileInfo->putPixelData(std::move(tile.data), builder.destinationColorSpace());
-
-        info->tileList << tileInfo;
-    }
-
-    return info;
+    return updateInfoFromFrame(frame,
+                               frameInfo->dirtyImageRect(),
+                               frameInfo->imageBounds(),
+                               frameInfo->levelOfDetail(),
+                               builder);
 }
 
 void KisFrameCacheStore::moveFrame(int srcFrameId, int dstFrameId)
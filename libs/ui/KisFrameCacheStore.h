@@ -11,6 +11,7 @@
 #include "kis_types.h"
 
 #include "opengl/kis_texture_tile_info_pool.h"
+#include "KisFrameDataSerializer.h"
 
 class KisOpenGLUpdateInfoBuilder;
 
@@ -55,6 +56,23 @@ public:
     int frameLevelOfDetail(int frameId) const;
     QRect frameDirtyRect(int frameId) const;
 
+    /**
+     * Converts the tiles of \p info into the serializable format. The
+     * pixel data is moved from \p info into the frame, so \p info
+     * becomes invalid afterwards.
+     */
+    static KisFrameDataSerializer::Frame frameFromUpdateInfo(KisOpenGLUpdateInfoSP info);
+
+    /**
+     * Converts \p frame back into the update info suitable for uploading
+     * into the textures. The pixel data is moved from \p frame.
+     */
+    static KisOpenGLUpdateInfoSP updateInfoFromFrame(KisFrameDataSerializer::Frame &frame,
+                                                     const QRect &dirtyImageRect,
+                                                     const QRect &imageBounds,
+                                                     int levelOfDetail,
+                                                     const KisOpenGLUpdateInfoBuilder &builder);
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -308,30 +308,37 @@ bool processData(T *dst, const T *src, int numUnits)
 
 
 template<template <typename U> class OpPolicy>
-bool KisFrameDataSerializer::processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src)
+bool KisFrameDataSerializer::processTiles(KisFrameDataSerializer::FrameTile &dst, const KisFrameDataSerializer::FrameTile &src, int pixelSize)
 {
-    bool framesAreSame = true;
+    bool tilesAreSame = true;
 
-    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(estimateFrameUniqueness(src, dst, 0.0), false);
+    const int numBytes = src.rect.width() * src.rect.height() * pixelSize;
+    const int numQWords = numBytes / 8;
 
-    for (int i = 0; i < int(src.frameTiles.size()); i++) {
-        const FrameTile &srcTile = src.frameTiles[i];
-        FrameTile &dstTile = dst.frameTiles[i];
+    const quint64 *srcDataPtr = reinterpret_cast<const quint64*>(src.data.data());
+    quint64 *dstDataPtr = reinterpret_cast<quint64*>(dst.data.data());
+
+    tilesAreSame &= processData<OpPolicy>(dstDataPtr, srcDataPtr, numQWords);
 
-        const int numBytes = srcTile.rect.width() * srcTile.rect.height() * src.pixelSize;
-        const int numQWords = numBytes / 8;
 
-        const quint64 *srcDataPtr = reinterpret_cast<const quint64*>(srcTile.data.data());
-        quint64 *dstDataPtr = reinterpret_cast<quint64*>(dstTile.data.data());
+    const int tailBytes = numBytes % 8;
+    const quint8 *srcTailDataPtr = src.data.data() + numBytes - tailBytes;
+    quint8 *dstTailDataPtr = dst.data.data() + numBytes - tailBytes;
 
-        framesAreSame &= processData<OpPolicy>(dstDataPtr, srcDataPtr, numQWords);
+    tilesAreSame &= processData<OpPolicy>(dstTailDataPtr, srcTailDataPtr, tailBytes);
 
+    return tilesAreSame;
+}
 
-        const int tailBytes = numBytes % 8;
-        const quint8 *srcTailDataPtr = srcTile.data.data() + numBytes - tailBytes;
-        quint8 *dstTailDataPtr = dstTile.data.data() + numBytes - tailBytes;
+template<template <typename U> class OpPolicy>
+bool KisFrameDataSerializer::processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src)
+{
+    bool framesAreSame = true;
 
-        framesAreSame &= processData<OpPolicy>(dstTailDataPtr, srcTailDataPtr, tailBytes);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(estimateFrameUniqueness(src, dst, 0.0), false);
+
+    for (int i = 0; i < int(src.frameTiles.size()); i++) {
+        framesAreSame &= processTiles<OpPolicy>(dst.frameTiles[i], src.frameTiles[i], src.pixelSize);
     }
 
     return framesAreSame;
@@ -347,3 +354,15 @@ void KisFrameDataSerializer::addFrames(KisFrameDataSerializer::Frame &dst, const
     // TODO: don't spend time on calculation of "framesAreSame" in this case
     (void) processFrames<std::plus>(dst, src);
 }
+
+bool KisFrameDataSerializer::subtractTiles(KisFrameDataSerializer::FrameTile &dst, const KisFrameDataSerializer::FrameTile &src, int pixelSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(dst.rect == src.rect, false);
+    return processTiles<std::minus>(dst, src, pixelSize);
+}
+
+void KisFrameDataSerializer::addTiles(KisFrameDataSerializer::FrameTile &dst, const KisFrameDataSerializer::FrameTile &src, int pixelSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dst.rect == src.rect);
+    (void) processTiles<std::plus>(dst, src, pixelSize);
+}
@@ -111,7 +111,18 @@ public:
     static bool subtractFrames(Frame &dst, const Frame &src);
     static void addFrames(Frame &dst, const Frame &src);
 
+    /**
+     * Per-tile versions of subtractFrames() and addFrames(). The tiles
+     * must have the same rect. subtractTiles() returns true if the
+     * tiles were equal, i.e. the resulting difference is zero.
+     */
+    static bool subtractTiles(FrameTile &dst, const FrameTile &src, int pixelSize);
+    static void addTiles(FrameTile &dst, const FrameTile &src, int pixelSize);
+
 private:
+    template<template <typename U> class OpPolicy>
+    static bool processTiles(FrameTile &dst, const FrameTile &src, int pixelSize);
+
     template<template <typename U> class OpPolicy>
     static bool processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src);
 
@@ -12,6 +12,17 @@
 struct KRITAUI_NO_EXPORT KisInMemoryFrameCacheSwapper::Private
 {
     QMap<int, KisOpenGLUpdateInfoSP> framesMap;
+    qint64 memoryUsage = 0;
+
+    static qint64 frameSize(KisOpenGLUpdateInfoSP info) {
+        qint64 size = 0;
+        if (!info) return size;
+
+        Q_FOREACH (KisTextureTileUpdateInfoSP tile, info->tileList) {
+            size += tile->patchPixelsLength();
+        }
+        return size;
+    }
 };
 
 KisInMemoryFrameCacheSwapper::KisInMemoryFrameCacheSwapper()
@@ -26,9 +37,12 @@ KisInMemoryFrameCacheSwapper::~KisInMemoryFrameCacheSwapper()
 void KisInMemoryFrameCacheSwapper::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, const QRect &imageBounds)
 {
     Q_UNUSED(imageBounds);
-    KIS_SAFE_ASSERT_RECOVER_NOOP(!m_d->framesMap.contains(frameId));
+    KIS_SAFE_ASSERT_RECOVER(!m_d->framesMap.contains(frameId)) {
+        m_d->memoryUsage -= m_d->frameSize(m_d->framesMap[frameId]);
+    }
 
     m_d->framesMap.insert(frameId, info);
+    m_d->memoryUsage += m_d->frameSize(info);
 }
 
 KisOpenGLUpdateInfoSP KisInMemoryFrameCacheSwapper::loadFrame(int frameId)
@@ -49,6 +63,7 @@ void KisInMemoryFrameCacheSwapper::moveFrame(int srcFrameId, int dstFrameId)
 void KisInMemoryFrameCacheSwapper::forgetFrame(int frameId)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(m_d->framesMap.contains(frameId));
+    m_d->memoryUsage -= m_d->frameSize(m_d->framesMap[frameId]);
     m_d->framesMap.remove(frameId);
 }
 
@@ -70,3 +85,8 @@ QRect KisInMemoryFrameCacheSwapper::frameDirtyRect(int frameId) const
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!m_d->framesMap[frameId].isNull(), QRect());
     return m_d->framesMap[frameId]->dirtyImageRect();
 }
+
+qint64 KisInMemoryFrameCacheSwapper::memoryUsage() const
+{
+    return m_d->memoryUsage;
+}
@@ -0,0 +1,253 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDisplayPipeline.h"
+
+#include <optional>
+
+#include <QRect>
+#include <QVector>
+
+#include <KoColorConversionCache.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_assert.h"
+
+#include "kis_display_filter.h"
+#include "kis_paint_device.h"
+#include "kis_random_accessor_ng.h"
+
+namespace {
+
+/**
+ * One tile of the paint device. The float buffer of the block takes
+ * 64 KiB, so it stays in L2 cache between the stages.
+ */
+const int s_blockWidth = 64;
+const int s_blockSize = s_blockWidth * s_blockWidth;
+
+const int s_floatPixelSize = 4 * sizeof(float);
+
+}
+
+struct KisDisplayPipeline::Private
+{
+    const KoColorSpace *srcColorSpace = 0;
+    QSharedPointer<KisDisplayFilter> displayFilter;
+    const KoColorSpace *filterInputColorSpace = 0;
+    const KoColorSpace *filterOutputColorSpace = 0;
+    const KoColorSpace *dstColorSpace = 0;
+    KoColorConversionTransformation::Intent inputRenderingIntent;
+    KoColorConversionTransformation::ConversionFlags inputConversionFlags;
+    KoColorConversionTransformation::Intent renderingIntent;
+    KoColorConversionTransformation::ConversionFlags conversionFlags;
+
+    bool needsInputConversion = false;
+    bool needsOutputConversion = false;
+
+    /**
+     * The state of a single apply() call. The cached transformations
+     * are owned by the context exclusively while it is alive, so the
+     * concurrent calls never share them.
+     */
+    struct Context {
+        std::optional<KoCachedColorConversionTransformation> input;
+        std::optional<KoCachedColorConversionTransformation> output;
+        QVector<float> buffer;
+
+        quint8* bufferPixels(int offset) {
+            return reinterpret_cast<quint8*>(buffer.data()) + offset * s_floatPixelSize;
+        }
+    };
+
+    void initContext(Context &context) const;
+
+    void loadPixels(Context &context, const quint8 *src, int offset, int numPixels) const;
+    void filterPixels(Context &context, int numPixels) const;
+    void storePixels(Context &context, int offset, quint8 *dst, int numPixels) const;
+};
+
+void KisDisplayPipeline::Private::initContext(Context &context) const
+{
+    KoColorConversionCache *cache = KoColorSpaceRegistry::instance()->colorConversionCache();
+
+    if (needsInputConversion) {
+        context.input.emplace(
+            cache->cachedConverter(srcColorSpace, filterInputColorSpace,
+                                   inputRenderingIntent, inputConversionFlags));
+    }
+
+    if (needsOutputConversion) {
+        context.output.emplace(
+            cache->cachedConverter(filterOutputColorSpace, dstColorSpace,
+                                   renderingIntent, conversionFlags));
+    }
+
+    context.buffer.resize(s_blockSize * 4);
+}
+
+void KisDisplayPipeline::Private::loadPixels(Context &context, const quint8 *src, int offset, int numPixels) const
+{
+    if (context.input) {
+        context.input->transformation()->transform(src, context.bufferPixels(offset), numPixels);
+    } else {
+        memcpy(context.bufferPixels(offset), src, numPixels * s_floatPixelSize);
+    }
+}
+
+void KisDisplayPipeline::Private::filterPixels(Context &context, int numPixels) const
+{
+    if (displayFilter) {
+        displayFilter->filter(context.bufferPixels(0), numPixels);
+    }
+}
+
+void KisDisplayPipeline::Private::storePixels(Context &context, int offset, quint8 *dst, int numPixels) const
+{
+    if (context.output) {
+        context.output->transformation()->transform(context.bufferPixels(offset), dst, numPixels);
+    } else {
+        memmove(dst, context.bufferPixels(offset), numPixels * s_floatPixelSize);
+    }
+}
+
+
+KisDisplayPipeline::KisDisplayPipeline(const KoColorSpace *srcColorSpace,
+                                       QSharedPointer<KisDisplayFilter> displayFilter,
+                                       const KoColorSpace *filterInputColorSpace,
+                                       const KoColorSpace *filterOutputColorSpace,
+                                       const KoColorSpace *dstColorSpace,
+                                       KoColorConversionTransformation::Intent renderingIntent,
+                                       KoColorConversionTransformation::ConversionFlags conversionFlags)
+    : m_d(new Private)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(filterInputColorSpace->pixelSize() == s_floatPixelSize);
+    KIS_SAFE_ASSERT_RECOVER_NOOP(filterOutputColorSpace->pixelSize() == s_floatPixelSize);
+
+    m_d->srcColorSpace = srcColorSpace;
+    m_d->displayFilter = displayFilter;
+    m_d->filterInputColorSpace = filterInputColorSpace;
+    m_d->filterOutputColorSpace = filterOutputColorSpace;
+    m_d->dstColorSpace = dstColorSpace;
+    m_d->inputRenderingIntent = renderingIntent;
+    m_d->inputConversionFlags = conversionFlags;
+    m_d->renderingIntent = renderingIntent;
+    m_d->conversionFlags = conversionFlags;
+
+    // we use two-stage check of the color space equivalence:
+    // first check pointers, and if not, check the spaces themselves
+    m_d->needsInputConversion =
+        srcColorSpace != filterInputColorSpace &&
+        !(*srcColorSpace == *filterInputColorSpace);
+
+    m_d->needsOutputConversion =
+        filterOutputColorSpace != dstColorSpace &&
+        !(*filterOutputColorSpace == *dstColorSpace);
+}
+
+KisDisplayPipeline::~KisDisplayPipeline()
+{
+}
+
+int KisDisplayPipeline::blockSize()
+{
+    return s_blockSize;
+}
+
+void KisDisplayPipeline::setInputConversionOptions(KoColorConversionTransformation::Intent renderingIntent,
+                                                   KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    m_d->inputRenderingIntent = renderingIntent;
+    m_d->inputConversionFlags = conversionFlags;
+}
+
+const KoColorSpace *KisDisplayPipeline::srcColorSpace() const
+{
+    return m_d->srcColorSpace;
+}
+
+const KoColorSpace *KisDisplayPipeline::dstColorSpace() const
+{
+    return m_d->dstColorSpace;
+}
+
+void KisDisplayPipeline::apply(const quint8 *src, quint8 *dst, int numPixels) const
+{
+    Private::Context context;
+    m_d->initContext(context);
+
+    const int srcPixelSize = m_d->srcColorSpace->pixelSize();
+    const int dstPixelSize = m_d->dstColorSpace->pixelSize();
+
+    /**
+     * Every block is loaded completely before it is stored, and the
+     * stored block never extends past the loaded one as long as the
+     * destination pixel is not bigger than the source one, so the
+     * in-place processing is safe.
+     */
+    KIS_SAFE_ASSERT_RECOVER_RETURN(src != dst || dstPixelSize <= srcPixelSize);
+
+    for (int i = 0; i < numPixels; i += s_blockSize) {
+        const int blockPixels = qMin(s_blockSize, numPixels - i);
+
+        m_d->loadPixels(context, src + i * srcPixelSize, 0, blockPixels);
+        m_d->filterPixels(context, blockPixels);
+        m_d->storePixels(context, 0, dst + i * dstPixelSize, blockPixels);
+    }
+}
+
+void KisDisplayPipeline::apply(KisPaintDeviceSP device, const QRect &rect, quint8 *dst) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(*device->colorSpace() == *m_d->srcColorSpace);
+
+    if (rect.isEmpty()) return;
+
+    Private::Context context;
+    m_d->initContext(context);
+
+    const int dstPixelSize = m_d->dstColorSpace->pixelSize();
+    const int dstRowStride = rect.width() * dstPixelSize;
+
+    KisRandomConstAccessorSP srcIt = device->createRandomConstAccessorNG();
+
+    int rows = 1;
+    int columns = 1;
+
+    /**
+     * The contiguous chunk of a tile is loaded row by row into the block
+     * and then passes the filter at once, so the filter is called once
+     * per tile, not once per row
+     */
+    for (int y = rect.y(); y <= rect.bottom(); y += rows) {
+        rows = qMin(qMin(srcIt->numContiguousRows(y), rect.bottom() - y + 1), s_blockWidth);
+
+        for (int x = rect.x(); x <= rect.right(); x += columns) {
+            columns = qMin(qMin(srcIt->numContiguousColumns(x), rect.right() - x + 1), s_blockWidth);
+
+            srcIt->moveTo(x, y);
+
+            const int srcRowStride = srcIt->rowStride(x, y);
+            const quint8 *srcPtr = srcIt->rawDataConst();
+
+            for (int i = 0; i < rows; i++) {
+                m_d->loadPixels(context, srcPtr, i * columns, columns);
+                srcPtr += srcRowStride;
+            }
+
+            m_d->filterPixels(context, rows * columns);
+
+            quint8 *dstPtr = dst +
+                (y - rect.y()) * dstRowStride +
+                (x - rect.x()) * dstPixelSize;
+
+            for (int i = 0; i < rows; i++) {
+                m_d->storePixels(context, i * columns, dstPtr, columns);
+                dstPtr += dstRowStride;
+            }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDISPLAYPIPELINE_H
+#define KISDISPLAYPIPELINE_H
+
+#include "kritaui_export.h"
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include <KoColorConversionTransformation.h>
+
+#include "kis_types.h"
+
+class QRect;
+class KoColorSpace;
+class KisDisplayFilter;
+
+
+/**
+ * @brief KisDisplayPipeline converts the pixels of the image into the
+ * display color space through a display filter (OCIO) in a single pass
+ *
+ * Without the pipeline the projection is converted into the input
+ * color space of the filter as a whole, then the filter processes the
+ * whole buffer, and then the buffer is converted into the display
+ * color space once again. Every stage touches every pixel in its own
+ * full-size buffer, which for HDR documents means 16 bytes per pixel
+ * read and written three times.
+ *
+ * The pipeline instead runs all three stages on small blocks of pixels
+ * that fit into the CPU cache:
+ *
+ *  1) the ICC conversion from the source color space into the
+ *     floating-point input color space of the filter;
+ *  2) KisDisplayFilter::filter(), i.e. the OCIO processor, which
+ *     already includes the exposure and gamma set via
+ *     KisExposureGammaCorrectionInterface;
+ *  3) the ICC conversion from the output color space of the filter
+ *     into the destination color space.
+ *
+ * The stages whose color spaces are equal are skipped. The conversions
+ * are fetched from the color conversion cache of the registry once per
+ * call, so the pipeline itself is cheap to create and can be used from
+ * multiple threads at once as long as the display filter can.
+ */
+class KRITAUI_EXPORT KisDisplayPipeline
+{
+public:
+    /**
+     * @param srcColorSpace the color space of the pixels passed to apply()
+     * @param displayFilter the filter, may be null, then only the
+     *        ICC conversions are applied
+     * @param filterInputColorSpace the RGBA F32 color space the filter
+     *        expects its input in
+     * @param filterOutputColorSpace the RGBA F32 color space the output
+     *        of the filter is interpreted in
+     * @param dstColorSpace the color space of the resulting pixels
+     */
+    KisDisplayPipeline(const KoColorSpace *srcColorSpace,
+                       QSharedPointer<KisDisplayFilter> displayFilter,
+                       const KoColorSpace *filterInputColorSpace,
+                       const KoColorSpace *filterOutputColorSpace,
+                       const KoColorSpace *dstColorSpace,
+                       KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent(),
+                       KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags());
+    ~KisDisplayPipeline();
+
+    /**
+     * The number of pixels processed by every stage at once
+     */
+    static int blockSize();
+
+    /**
+     * Sets the options of the conversion into the filter input color
+     * space separately. By default both conversions use the options
+     * passed to the constructor.
+     */
+    void setInputConversionOptions(KoColorConversionTransformation::Intent renderingIntent,
+                                   KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+    const KoColorSpace* srcColorSpace() const;
+    const KoColorSpace* dstColorSpace() const;
+
+    /**
+     * Processes \p numPixels pixels of \p src into \p dst. The
+     * processing may happen in place, i.e. \p dst may be equal to
+     * \p src, if the pixel size of the destination color space is not
+     * bigger than the one of the source color space.
+     */
+    void apply(const quint8 *src, quint8 *dst, int numPixels) const;
+
+    /**
+     * Processes \p rect of \p device into \p dst, which is a plain array
+     * of rect.width() * rect.height() pixels. The pixels are read
+     * directly from the tiles of the device without an intermediate copy.
+     * The color space of \p device must be equal to srcColorSpace().
+     */
+    void apply(KisPaintDeviceSP device, const QRect &rect, quint8 *dst) const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISDISPLAYPIPELINE_H
@@ -82,6 +82,7 @@
 #include "kis_painting_assistants_decoration.h"
 
 #include "kis_canvas_updates_compressor.h"
+#include "kis_update_time_monitor.h"
 #include "KoZoomController.h"
 
 #include <KisStrokeSpeedMonitor.h>
@@ -133,6 +134,7 @@ public:
         , displayColorConverter(resourceManager, view)
         , inputActionGroupsMaskInterface(new CanvasInputActionGroupsMaskInterface(this))
         , regionOfInterestUpdateCompressor(100, KisSignalCompressor::FIRST_INACTIVE)
+        , deferredUpdatesCompressor(250, KisSignalCompressor::POSTPONE)
     {
     }
 
@@ -181,6 +183,10 @@ public:
     QRect regionOfInterest;
     qreal regionOfInterestMargin = 0.25;
 
+    bool prioritizeUpdatesAroundCursor = false;
+    bool flushDeferredUpdates = false;
+    KisSignalCompressor deferredUpdatesCompressor;
+
     QRect renderingLimit;
     int isBatchUpdateActive = 0;
 
@@ -256,8 +262,10 @@ void KisCanvas2::setup()
     m_d->vastScrolling = cfg.vastScrolling();
     m_d->lodPreferredInImage = cfg.levelOfDetailEnabled();
     m_d->regionOfInterestMargin = KisImageConfig(true).animationCacheRegionOfInterestMargin();
+    m_d->prioritizeUpdatesAroundCursor = cfg.prioritizeUpdatesAroundCursor();
 
     createCanvas(cfg.useOpenGL());
+    applyUpdatesPriorityMode();
 
     setLodPreferredInCanvas(m_d->lodPreferredInImage);
     
@@ -295,6 +303,7 @@ void KisCanvas2::setup()
     connect(this, SIGNAL(sigContinueResizeImage(qint32,qint32)), SLOT(finishResizingImage(qint32,qint32)));
 
     connect(&m_d->regionOfInterestUpdateCompressor, SIGNAL(timeout()), SLOT(slotUpdateRegionOfInterest()));
+    connect(&m_d->deferredUpdatesCompressor, SIGNAL(timeout()), SLOT(slotFlushDeferredProjectionUpdates()));
 
     connect(m_d->view->document(), SIGNAL(sigReferenceImagesChanged()), this, SLOT(slotReferenceImagesChanged()));
 
@@ -859,13 +868,27 @@ void KisCanvas2::updateCanvasProjection()
                                             QRect(), std::bit_or<QRect>());
 
         tryIssueCanvasUpdates(vRect);
+
+        KisUpdateTimeMonitor *monitor = KisUpdateTimeMonitor::instance();
+        if (monitor->latencyTrackingEnabled()) {
+            Q_FOREACH (KisUpdateInfoSP info, infoObjects) {
+                monitor->reportCanvasUpdateReady(
+                    KisLodTransformBase::upscaledRect(info->dirtyImageRect(), info->levelOfDetail()));
+            }
+        }
     };
 
     bool shouldExplicitlyIssueUpdates = false;
 
     QVector<KisUpdateInfoSP> infoObjects;
     KisUpdateInfoList originalInfoObjects;
-    m_d->projectionUpdatesCompressor.takeUpdateInfo(originalInfoObjects);
+    m_d->projectionUpdatesCompressor.takeUpdateInfo(originalInfoObjects, m_d->flushDeferredUpdates);
+    m_d->flushDeferredUpdates = false;
+
+    if (m_d->projectionUpdatesCompressor.hasDeferredUpdates()) {
+        // the off-screen updates are uploaded when the user is idle
+        m_d->deferredUpdatesCompressor.start();
+    }
 
     for (auto it = originalInfoObjects.constBegin();
          it != originalInfoObjects.constEnd();
@@ -906,6 +929,63 @@ void KisCanvas2::updateCanvasProjection()
     }
 }
 
+void KisCanvas2::slotFlushDeferredProjectionUpdates()
+{
+    m_d->flushDeferredUpdates = true;
+    Q_EMIT sigCanvasCacheUpdated();
+}
+
+void KisCanvas2::notifyToolEventPosition(const QPointF &documentPoint)
+{
+    const QPointF imagePoint = m_d->coordinatesConverter->documentToImage(documentPoint);
+
+    KisUpdateTimeMonitor::instance()->reportToolEvent(imagePoint);
+
+    if (!m_d->prioritizeUpdatesAroundCursor) return;
+
+    KisImageSP image = this->image();
+    if (image) {
+        image->setProjectionUpdatesPriorityPoint(imagePoint);
+    }
+
+    m_d->projectionUpdatesCompressor.setToolPosition(imagePoint);
+}
+
+void KisCanvas2::applyUpdatesPriorityMode()
+{
+    KisConfig cfg(true);
+
+    /**
+     * The texture tiles are uploaded together with their borders, so
+     * the updates closer to each other than the border should never
+     * be reordered
+     */
+    m_d->projectionUpdatesCompressor.setPriorityMode(m_d->prioritizeUpdatesAroundCursor,
+                                                     cfg.textureOverlapBorder());
+
+    if (!m_d->prioritizeUpdatesAroundCursor) {
+        KisImageSP image = this->image();
+        if (image) {
+            image->resetProjectionUpdatesPriorityPoint();
+        }
+
+        if (m_d->projectionUpdatesCompressor.hasDeferredUpdates()) {
+            Q_EMIT sigCanvasCacheUpdated();
+        }
+    }
+
+    updatePriorityVisibleRect();
+}
+
+void KisCanvas2::updatePriorityVisibleRect()
+{
+    const QRect visibleRect = m_d->coordinatesConverter->widgetRectInImagePixels().toAlignedRect();
+
+    if (m_d->projectionUpdatesCompressor.setVisibleRect(visibleRect)) {
+        Q_EMIT sigCanvasCacheUpdated();
+    }
+}
+
 void KisCanvas2::slotBeginUpdatesBatch()
 {
     KisUpdateInfoSP info =
@@ -1085,6 +1165,7 @@ void KisCanvas2::notifyZoomChanged()
     notifyLevelOfDetailChange();
     updateCanvas(); // update the canvas, because that isn't done when zooming using KoZoomAction
 
+    updatePriorityVisibleRect();
     m_d->regionOfInterestUpdateCompressor.start();
 }
 
@@ -1208,6 +1289,7 @@ void KisCanvas2::documentOffsetMoved(const QPoint &documentOffset)
 
     updateCanvas();
 
+    updatePriorityVisibleRect();
     m_d->regionOfInterestUpdateCompressor.start();
 }
 
@@ -1216,8 +1298,10 @@ void KisCanvas2::slotConfigChanged()
     KisConfig cfg(true);
     m_d->vastScrolling = cfg.vastScrolling();
     m_d->regionOfInterestMargin = KisImageConfig(true).animationCacheRegionOfInterestMargin();
+    m_d->prioritizeUpdatesAroundCursor = cfg.prioritizeUpdatesAroundCursor();
 
     resetCanvas(cfg.useOpenGL());
+    applyUpdatesPriorityMode();
 
     QWidget *mainWindow = m_d->view->mainWindow();
     KIS_SAFE_ASSERT_RECOVER_RETURN(mainWindow);
@@ -216,6 +216,18 @@ public: // KisCanvas2 methods
      * @return a reference to alter this canvas' input action groups mask
      */
     KisInputActionGroupsMaskInterface::SharedInterface inputActionGroupsMaskInterface();
+
+    /**
+     * Notifies the canvas about the position of an event passed to the
+     * active tool. The position is used for measuring the latency of the
+     * canvas updates, and, if KisConfig::prioritizeUpdatesAroundCursor()
+     * is enabled, the image and the canvas update the area around this
+     * position first.
+     *
+     * \p documentPoint is measured in document coordinates
+     */
+    void notifyToolEventPosition(const QPointF &documentPoint);
+
 Q_SIGNALS:
     void sigCanvasEngineChanged();
 
@@ -275,6 +287,8 @@ private Q_SLOTS:
     void startUpdateCanvasProjection(const QRect & rc);
     void updateCanvasProjection();
 
+    void slotFlushDeferredProjectionUpdates();
+
     void slotBeginUpdatesBatch();
     void slotEndUpdatesBatch();
     void slotSetLodUpdatesBlocked(bool value);
@@ -329,6 +343,9 @@ private:
 
     void notifyLevelOfDetailChange();
 
+    void applyUpdatesPriorityMode();
+    void updatePriorityVisibleRect();
+
     // Completes construction of canvas.
     // To be called by KisView in its constructor, once it has been setup enough
     // (to be defined what that means) for things KisCanvas2 expects from KisView
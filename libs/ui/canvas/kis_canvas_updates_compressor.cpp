@@ -6,6 +6,45 @@
 
 #include "kis_canvas_updates_compressor.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "kis_algebra_2d.h"
+#include "kis_lod_transform_base.h"
+
+namespace {
+
+struct PendingUpdate {
+    KisUpdateInfoSP info;
+    QRect rect;
+    qreal distance = 0.0;
+    bool taken = false;
+};
+
+/**
+ * Appends the update at \p index to \p result, but only after all the
+ * older updates overlapping it, so that the stale data of an older update
+ * never overwrites the fresh data of the newer one
+ */
+void appendWithDependencies(std::vector<PendingUpdate> &updates, int index, KisUpdateInfoList &result)
+{
+    PendingUpdate &update = updates[index];
+    if (update.taken) return;
+
+    update.taken = true;
+
+    for (int i = 0; i < index; i++) {
+        if (!updates[i].taken && updates[i].rect.intersects(update.rect)) {
+            appendWithDependencies(updates, i, result);
+        }
+    }
+
+    result << update.info;
+}
+
+}
+
 bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
 {
     const int levelOfDetail = info->levelOfDetail();
@@ -15,22 +54,27 @@ bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
     QMutexLocker l(&m_mutex);
 
     if (info->canBeCompressed()) {
-        KisUpdateInfoList::iterator it = m_updatesList.begin();
-        while (it != m_updatesList.end()) {
-            if ((*it)->canBeCompressed() &&
-                levelOfDetail == (*it)->levelOfDetail() &&
-                newUpdateRect.contains((*it)->dirtyImageRect())) {
-
-                /**
-                 * We should always remove the overridden update and put 'info' to the end
-                 * of the queue. Otherwise, the updates will become reordered and the canvas
-                 * may have tiles artifacts with "outdated" data
-                 */
-                it = m_updatesList.erase(it);
-            } else {
-                ++it;
+        auto compressList = [&] (KisUpdateInfoList &list) {
+            KisUpdateInfoList::iterator it = list.begin();
+            while (it != list.end()) {
+                if ((*it)->canBeCompressed() &&
+                    levelOfDetail == (*it)->levelOfDetail() &&
+                    newUpdateRect.contains((*it)->dirtyImageRect())) {
+
+                    /**
+                     * We should always remove the overridden update and put 'info' to the end
+                     * of the queue. Otherwise, the updates will become reordered and the canvas
+                     * may have tiles artifacts with "outdated" data
+                     */
+                    it = list.erase(it);
+                } else {
+                    ++it;
+                }
             }
-        }
+        };
+
+        compressList(m_deferredList);
+        compressList(m_updatesList);
     }
 
     m_updatesList.append(info);
@@ -38,10 +82,151 @@ bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
     return m_updatesList.size() <= 1;
 }
 
-void KisCanvasUpdatesCompressor::takeUpdateInfo(KisUpdateInfoList &list)
+void KisCanvasUpdatesCompressor::takeUpdateInfo(KisUpdateInfoList &list, bool flushDeferred)
 {
     KIS_SAFE_ASSERT_RECOVER(list.isEmpty()) { list.clear(); }
 
     QMutexLocker l(&m_mutex);
-    m_updatesList.swap(list);
+
+    KisUpdateInfoList updates;
+    updates.swap(m_deferredList);
+    updates.append(m_updatesList);
+    m_updatesList.clear();
+
+    if (!m_priorityMode) {
+        list.swap(updates);
+        return;
+    }
+
+    releaseUpdates(updates, flushDeferred, list, m_deferredList);
+    sortUpdates(list);
+}
+
+void KisCanvasUpdatesCompressor::setPriorityMode(bool value, int overlapMargin)
+{
+    QMutexLocker l(&m_mutex);
+    m_priorityMode = value;
+    m_overlapMargin = qMax(0, overlapMargin);
+}
+
+bool KisCanvasUpdatesCompressor::priorityMode() const
+{
+    QMutexLocker l(&m_mutex);
+    return m_priorityMode;
+}
+
+void KisCanvasUpdatesCompressor::setToolPosition(const QPointF &imagePos)
+{
+    QMutexLocker l(&m_mutex);
+    m_hasToolPosition = true;
+    m_toolPosition = imagePos;
+}
+
+bool KisCanvasUpdatesCompressor::setVisibleRect(const QRect &imageRect)
+{
+    QMutexLocker l(&m_mutex);
+    m_visibleRect = imageRect;
+
+    if (m_visibleRect.isEmpty()) {
+        return !m_deferredList.isEmpty();
+    }
+
+    return std::any_of(m_deferredList.constBegin(), m_deferredList.constEnd(),
+                       [this] (KisUpdateInfoSP info) {
+                           return m_visibleRect.intersects(effectiveRect(info));
+                       });
+}
+
+bool KisCanvasUpdatesCompressor::hasDeferredUpdates() const
+{
+    QMutexLocker l(&m_mutex);
+    return !m_deferredList.isEmpty();
+}
+
+QRect KisCanvasUpdatesCompressor::effectiveRect(KisUpdateInfoSP info) const
+{
+    const QRect rect = KisLodTransformBase::upscaledRect(info->dirtyImageRect(), info->levelOfDetail());
+    return rect.adjusted(-m_overlapMargin, -m_overlapMargin, m_overlapMargin, m_overlapMargin);
+}
+
+void KisCanvasUpdatesCompressor::releaseUpdates(KisUpdateInfoList &updates, bool flushDeferred,
+                                                KisUpdateInfoList &released, KisUpdateInfoList &deferred) const
+{
+    QVector<QRect> releasedRects;
+    bool hasBarrierAfter = false;
+
+    /**
+     * Walk from the newest update to the oldest one: an update must be
+     * released if any newer update overlapping it is released, otherwise
+     * it would overwrite the newer data later. Nothing can be deferred
+     * past a marker either.
+     */
+    for (int i = updates.size() - 1; i >= 0; i--) {
+        KisUpdateInfoSP info = updates[i];
+
+        if (!info->canBeCompressed()) {
+            hasBarrierAfter = true;
+            released.prepend(info);
+            continue;
+        }
+
+        const QRect rect = effectiveRect(info);
+
+        const bool shouldRelease =
+            flushDeferred || hasBarrierAfter ||
+            m_visibleRect.isEmpty() || m_visibleRect.intersects(rect) ||
+            std::any_of(releasedRects.constBegin(), releasedRects.constEnd(),
+                        [rect] (const QRect &rc) { return rc.intersects(rect); });
+
+        if (shouldRelease) {
+            releasedRects.append(rect);
+            released.prepend(info);
+        } else {
+            deferred.prepend(info);
+        }
+    }
+}
+
+void KisCanvasUpdatesCompressor::sortUpdates(KisUpdateInfoList &updates) const
+{
+    if (!m_hasToolPosition || updates.size() < 2) return;
+
+    KisUpdateInfoList result;
+    std::vector<PendingUpdate> segment;
+
+    auto flushSegment = [&] () {
+        std::vector<int> order(segment.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&segment] (int lhs, int rhs) {
+                             return segment[lhs].distance < segment[rhs].distance;
+                         });
+
+        for (int index : order) {
+            appendWithDependencies(segment, index, result);
+        }
+
+        segment.clear();
+    };
+
+    Q_FOREACH (KisUpdateInfoSP info, updates) {
+        if (!info->canBeCompressed()) {
+            flushSegment();
+            result << info;
+            continue;
+        }
+
+        PendingUpdate update;
+        update.info = info;
+        update.rect = effectiveRect(info);
+        update.distance =
+            kisSquareDistance(m_toolPosition,
+                              KisAlgebra2D::clampPoint(m_toolPosition, QRectF(update.rect)));
+
+        segment.push_back(update);
+    }
+
+    flushSegment();
+
+    updates.swap(result);
 }
@@ -10,20 +10,88 @@
 #include <QList>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QPointF>
+#include <QRect>
 
+#include "kritaui_export.h"
 #include "kis_update_info.h"
 
 typedef QList<KisUpdateInfoSP> KisUpdateInfoList;
 
-class KisCanvasUpdatesCompressor
+/**
+ * Collects the update infos prepared by the image threads until the
+ * GUI thread uploads them to the canvas.
+ *
+ * In the priority mode the compressor sorts the updates by their
+ * distance to the position of the tool, so the area under the stylus
+ * is uploaded first, and defers the updates lying completely outside
+ * the visible area of the canvas until they become visible or until
+ * takeUpdateInfo() is explicitly asked to flush them, which the canvas
+ * does when the user is idle. The ordering never swaps two updates
+ * that overlap, and the markers (batches and LoD blocking) act as
+ * barriers, which nothing is moved across.
+ */
+class KRITAUI_EXPORT KisCanvasUpdatesCompressor
 {
 public:
+    /**
+     * @return true if \p info is the first pending update, that is, the
+     *         canvas should be notified about the new updates
+     */
     bool putUpdateInfo(KisUpdateInfoSP info);
-    void takeUpdateInfo(KisUpdateInfoList &list);
+
+    /**
+     * Moves the updates ready to be uploaded into \p list. If \p flushDeferred
+     * is true, the deferred off-screen updates are taken as well.
+     */
+    void takeUpdateInfo(KisUpdateInfoList &list, bool flushDeferred = false);
+
+    /**
+     * Enables or disables the priority mode. Disabling the mode releases
+     * all the deferred updates on the next call to takeUpdateInfo().
+     *
+     * @param overlapMargin the distance in image pixels, starting from
+     *        which two updates are considered to be not overlapping. It
+     *        should cover the border of the texture tiles of the canvas,
+     *        since the updates upload their dirty rects with it.
+     */
+    void setPriorityMode(bool value, int overlapMargin = 0);
+    bool priorityMode() const;
+
+    /**
+     * Sets the position of the tool in image pixels, the updates are
+     * sorted by the distance to it
+     */
+    void setToolPosition(const QPointF &imagePos);
+
+    /**
+     * Sets the visible area of the canvas in image pixels. The updates
+     * outside it are deferred. An empty rect means that everything is
+     * visible.
+     *
+     * @return true if some of the deferred updates became visible, that
+     *         is, the canvas should be notified about the new updates
+     */
+    bool setVisibleRect(const QRect &imageRect);
+
+    bool hasDeferredUpdates() const;
 
 private:
-    QMutex m_mutex;
+    QRect effectiveRect(KisUpdateInfoSP info) const;
+    void releaseUpdates(KisUpdateInfoList &updates, bool flushDeferred,
+                        KisUpdateInfoList &released, KisUpdateInfoList &deferred) const;
+    void sortUpdates(KisUpdateInfoList &updates) const;
+
+private:
+    mutable QMutex m_mutex;
     KisUpdateInfoList m_updatesList;
+    KisUpdateInfoList m_deferredList;
+
+    bool m_priorityMode = false;
+    int m_overlapMargin = 0;
+    bool m_hasToolPosition = false;
+    QPointF m_toolPosition;
+    QRect m_visibleRect;
 };
 
 #endif /* __KIS_CANVAS_UPDATES_COMPRESSOR_H */
@@ -31,6 +31,7 @@
 #include "kis_fixed_paint_device.h"
 #include "opengl/KisOpenGLModeProber.h"
 #include "KisDisplayConfig.h"
+#include "KisDisplayPipeline.h"
 
 Q_GLOBAL_STATIC(KisDisplayColorConverter, s_instance)
 
@@ -558,27 +559,30 @@ QImage KisDisplayColorConverter::toQImage(KisPaintDeviceSP srcDevice, bool proof
         srcDevice->convertTo(paintingColorSpace(), m_d->renderingIntent, m_d->conversionFlags);
     }
 
+    // we expect the display profile is rgb8, which is BGRA here
+    KIS_ASSERT_RECOVER(m_d->qtWidgetsColorSpace()->pixelSize() == 4) {
+        return QImage();
+    }
+
     if (m_d->useOcio()) {
         KIS_ASSERT_RECOVER(m_d->ocioInputColorSpace()->pixelSize() == 16) {
             return QImage();
         }
 
-        device = new KisPaintDevice(*srcDevice);
-        device->convertTo(m_d->ocioInputColorSpace());
-
-        KisSequentialIterator it(device, bounds);
-        int numConseqPixels = it.nConseqPixels();
-        while (it.nextPixels(numConseqPixels)) {
-            numConseqPixels = it.nConseqPixels();
-            m_d->displayFilter->filter(it.rawData(), numConseqPixels);
-        }
+        KisDisplayPipeline pipeline(device->colorSpace(),
+                                    m_d->displayFilter,
+                                    m_d->ocioInputColorSpace(),
+                                    m_d->ocioOutputColorSpace(),
+                                    m_d->qtWidgetsColorSpace(),
+                                    m_d->renderingIntent, m_d->conversionFlags);
 
-        device->setProfile(m_d->ocioOutputProfile(), 0);
-    }
+        // the device is converted into the filter space with the internal options
+        pipeline.setInputConversionOptions(KoColorConversionTransformation::internalRenderingIntent(),
+                                           KoColorConversionTransformation::internalConversionFlags());
 
-    // we expect the display profile is rgb8, which is BGRA here
-    KIS_ASSERT_RECOVER(m_d->qtWidgetsColorSpace()->pixelSize() == 4) {
-        return QImage();
+        QImage image(bounds.size(), QImage::Format_ARGB32);
+        pipeline.apply(device, bounds, image.bits());
+        return image;
     }
 
     return device->convertToQImage(m_d->qtWidgetsProfile(),
@@ -607,20 +611,17 @@ QImage KisDisplayColorConverter::toQImage(const KoColorSpace *srcColorSpace, con
         pixels = proofBuffer.data();
     }
 
-    QScopedArrayPointer<quint8> ocioBuffer;
     if (m_d->useOcio()) {
-        const int imageSize = numPixels * m_d->ocioInputColorSpace()->pixelSize();
-        ocioBuffer.reset(new quint8[imageSize]);
-        colorSpace->convertPixelsTo(pixels, ocioBuffer.data(),
-                                      m_d->ocioInputColorSpace(),
-                                      numPixels,
-                                      m_d->renderingIntent,
-                                      m_d->conversionFlags);
-        m_d->displayFilter->filter(ocioBuffer.data(), numPixels);
-
-        return m_d->ocioOutputColorSpace()->convertToQImage(ocioBuffer.data(), size.width(), size.height(),
-                                                            m_d->qtWidgetsProfile(),
-                                                            m_d->renderingIntent, m_d->conversionFlags);
+        KisDisplayPipeline pipeline(colorSpace,
+                                    m_d->displayFilter,
+                                    m_d->ocioInputColorSpace(),
+                                    m_d->ocioOutputColorSpace(),
+                                    m_d->qtWidgetsColorSpace(),
+                                    m_d->renderingIntent, m_d->conversionFlags);
+
+        QImage image(size, QImage::Format_ARGB32);
+        pipeline.apply(pixels, image.bits(), numPixels);
+        return image;
     }
 
     return colorSpace->convertToQImage(pixels, size.width(), size.height(),
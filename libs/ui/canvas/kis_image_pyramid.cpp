@@ -5,7 +5,12 @@
  */
 #include "kis_image_pyramid.h"
 
+#include <cstring>
+
 #include <QBitArray>
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
 #include <KoChannelInfo.h>
 #include <KoCompositeOp.h>
 #include <KoColorSpaceRegistry.h>
@@ -13,6 +18,7 @@
 #include <KoColorSpaceMaths.h>
 
 #include "kis_display_filter.h"
+#include "KisDisplayPipeline.h"
 #include "kis_painter.h"
 #include "kis_iterator_ng.h"
 #include "kis_datamanager.h"
@@ -29,6 +35,18 @@
 #define FIRST_NOT_ORIGINAL_INDEX 1
 #define SCALE_FROM_INDEX(idx) (1./qreal(1<<(idx)))
 
+/**
+ * The size of the dirty tiles of the levels, equal to the size
+ * of the tiles of the paint devices
+ */
+#define PYRAMID_TILE_SIZE 64
+
+/**
+ * Downsampling smaller updates on multiple threads costs more than
+ * it gains
+ */
+#define MIN_THREADED_TILES 4
+
 
 /************* AUXILIARY FUNCTIONS **********************************/
 
@@ -71,6 +89,16 @@ inline void alignByPow2Lo(qint32 &value, qint32 alignment)
     value &= ~mask;
 }
 
+/**
+ * Returns the rect of the pixels of the pyramid level @p index
+ * that depend on @p rect of the original level
+ */
+inline QRect levelRectFromImageRect(const QRect &rect, qint32 index)
+{
+    return QRect(QPoint(rect.left() >> index, rect.top() >> index),
+                 QPoint(rect.right() >> index, rect.bottom() >> index));
+}
+
 inline void alignRectBy2(qint32 &x, qint32 &y, qint32 &w, qint32 &h)
 {
     x -= isOdd(x);
@@ -146,6 +174,8 @@ void KisImagePyramid::rebuildPyramid()
     for (qint32 i = 0; i < m_pyramidHeight; i++) {
         m_pyramid.append(new KisPaintDevice(m_monitorColorSpace));
     }
+
+    resetDirtyTiles();
 }
 
 void KisImagePyramid::clearPyramid()
@@ -153,6 +183,8 @@ void KisImagePyramid::clearPyramid()
     for (qint32 i = 0; i < m_pyramidHeight; i++) {
         m_pyramid[i]->clear();
     }
+
+    resetDirtyTiles();
 }
 
 void KisImagePyramid::setImage(KisImageWSP newImage)
@@ -192,20 +224,161 @@ void KisImagePyramid::setImage(KisImageWSP newImage)
             }
 
         }
-        //TODO: check whether there is needed recalculateCache()
+        /**
+         * All the tiles of the higher levels are dirty after
+         * setImageSize(), they will be generated when displayed
+         */
     }
 }
 
 void KisImagePyramid::setImageSize(qint32 w, qint32 h)
 {
-    Q_UNUSED(w);
-    Q_UNUSED(h);
-    /* nothing interesting */
+    m_imageSize = QSize(w, h);
+    resetDirtyTiles();
 }
 
 void KisImagePyramid::updateCache(const QRect &dirtyImageRect)
 {
     retrieveImageData(dirtyImageRect);
+    markDirty(dirtyImageRect);
+}
+
+void KisImagePyramid::resetDirtyTiles()
+{
+    QMutexLocker l(&m_dirtyTilesLock);
+
+    m_dirtyTiles.resize(m_pyramidHeight);
+
+    for (qint32 i = FIRST_NOT_ORIGINAL_INDEX; i < m_pyramidHeight; i++) {
+        const qint32 levelWidth = (m_imageSize.width() + (1 << i) - 1) >> i;
+        const qint32 levelHeight = (m_imageSize.height() + (1 << i) - 1) >> i;
+
+        DirtyTiles &tiles = m_dirtyTiles[i];
+        tiles.columns = (levelWidth + PYRAMID_TILE_SIZE - 1) / PYRAMID_TILE_SIZE;
+        tiles.rows = (levelHeight + PYRAMID_TILE_SIZE - 1) / PYRAMID_TILE_SIZE;
+        tiles.bits = QBitArray(tiles.columns * tiles.rows, true);
+    }
+}
+
+void KisImagePyramid::markDirty(const QRect &imageRect)
+{
+    if (imageRect.isEmpty()) return;
+
+    QMutexLocker l(&m_dirtyTilesLock);
+
+    for (qint32 i = FIRST_NOT_ORIGINAL_INDEX; i < m_dirtyTiles.size(); i++) {
+        DirtyTiles &tiles = m_dirtyTiles[i];
+        const QRect levelRect = levelRectFromImageRect(imageRect, i);
+
+        const qint32 firstColumn = qMax(0, levelRect.left() / PYRAMID_TILE_SIZE);
+        const qint32 lastColumn = qMin(tiles.columns - 1, levelRect.right() / PYRAMID_TILE_SIZE);
+        const qint32 firstRow = qMax(0, levelRect.top() / PYRAMID_TILE_SIZE);
+        const qint32 lastRow = qMin(tiles.rows - 1, levelRect.bottom() / PYRAMID_TILE_SIZE);
+
+        for (qint32 row = firstRow; row <= lastRow; row++) {
+            for (qint32 column = firstColumn; column <= lastColumn; column++) {
+                tiles.bits.setBit(row * tiles.columns + column);
+            }
+        }
+    }
+}
+
+QVector<QRect> KisImagePyramid::takeDirtyTiles(int level, const QRect &levelRect)
+{
+    QVector<QRect> result;
+
+    QMutexLocker l(&m_dirtyTilesLock);
+
+    if (level >= m_dirtyTiles.size() || levelRect.isEmpty()) return result;
+
+    DirtyTiles &tiles = m_dirtyTiles[level];
+
+    const qint32 firstColumn = qMax(0, levelRect.left() / PYRAMID_TILE_SIZE);
+    const qint32 lastColumn = qMin(tiles.columns - 1, levelRect.right() / PYRAMID_TILE_SIZE);
+    const qint32 firstRow = qMax(0, levelRect.top() / PYRAMID_TILE_SIZE);
+    const qint32 lastRow = qMin(tiles.rows - 1, levelRect.bottom() / PYRAMID_TILE_SIZE);
+
+    for (qint32 row = firstRow; row <= lastRow; row++) {
+        for (qint32 column = firstColumn; column <= lastColumn; column++) {
+            const qint32 index = row * tiles.columns + column;
+
+            if (tiles.bits.testBit(index)) {
+                tiles.bits.clearBit(index);
+                result.append(QRect(column * PYRAMID_TILE_SIZE, row * PYRAMID_TILE_SIZE,
+                                    PYRAMID_TILE_SIZE, PYRAMID_TILE_SIZE));
+            }
+        }
+    }
+
+    return result;
+}
+
+void KisImagePyramid::ensureLevelUpToDate(int level, const QRect &levelRect)
+{
+    if (level < FIRST_NOT_ORIGINAL_INDEX) return;
+
+    const QVector<QRect> tiles = takeDirtyTiles(level, levelRect);
+    if (tiles.isEmpty()) return;
+
+    QRect srcRect;
+    Q_FOREACH (const QRect &tile, tiles) {
+        srcRect |= QRect(tile.topLeft() * 2, tile.size() * 2);
+    }
+
+    ensureLevelUpToDate(level - 1, srcRect);
+
+    KisPaintDevice *src = m_pyramid[level - 1].data();
+    KisPaintDevice *dst = m_pyramid[level].data();
+
+    auto processTile = [src, dst] (const QRect &tile) {
+        downsampleByFactor2(QRect(tile.topLeft() * 2, tile.size() * 2), src, dst);
+    };
+
+    const int numThreads = m_maxThreadCount > 0 ? m_maxThreadCount : QThread::idealThreadCount();
+
+    if (numThreads <= 1 || tiles.size() < MIN_THREADED_TILES) {
+        Q_FOREACH (const QRect &tile, tiles) {
+            processTile(tile);
+        }
+    } else {
+        /**
+         * Every tile of the level is written into its own tile of the
+         * destination device, so the tiles don't interfere
+         */
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(numThreads);
+
+        Q_FOREACH (const QRect &tile, tiles) {
+            threadPool.start(QRunnable::create(
+                [&processTile, tile] () {
+                    processTile(tile);
+                }));
+        }
+
+        threadPool.waitForDone();
+    }
+}
+
+QImage KisImagePyramid::levelImage(int level, const QRect &levelRect)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(level >= ORIGINAL_INDEX && level < m_pyramidHeight, QImage());
+
+    {
+        QMutexLocker l(&m_levelsLock);
+        ensureLevelUpToDate(level, levelRect);
+    }
+
+    return convertToQImageFast(m_pyramid[level], levelRect);
+}
+
+void KisImagePyramid::setMaxThreadCount(int value)
+{
+    m_maxThreadCount = value;
+}
+
+int KisImagePyramid::maxThreadCount() const
+{
+    return m_maxThreadCount;
 }
 
 void KisImagePyramid::retrieveImageData(const QRect &rect)
@@ -217,10 +390,7 @@ void KisImagePyramid::retrieveImageData(const QRect &rect)
     KisPaintDeviceSP originalProjection = m_originalImage->projection();
     quint32 numPixels = rect.width() * rect.height();
 
-    QScopedArrayPointer<quint8> originalBytes(
-        new quint8[originalProjection->colorSpace()->pixelSize() * numPixels]);
-
-    originalProjection->readBytes(originalBytes.data(), rect);
+    QScopedArrayPointer<quint8> originalBytes;
 
     if (m_displayFilter &&
         m_useOcio &&
@@ -243,23 +413,29 @@ void KisImagePyramid::retrieveImageData(const QRect &rect)
                 Integer8BitsColorDepthID.id(),
                 destinationProfile);
 
-        if (projectionCs->colorDepthId() == Float32BitsColorDepthID) {
-            m_displayFilter->filter(originalBytes.data(), numPixels);
-        } else {
-            QScopedArrayPointer<quint8> dst(new quint8[floatCs->pixelSize() * numPixels]);
-            projectionCs->convertPixelsTo(originalBytes.data(), dst.data(), floatCs, numPixels, KoColorConversionTransformation::internalRenderingIntent(), KoColorConversionTransformation::internalConversionFlags());
-            m_displayFilter->filter(dst.data(), numPixels);
-            originalBytes.swap(dst);
-        }
-
-        {
-            QScopedArrayPointer<quint8> dst(new quint8[modifiedMonitorCs->pixelSize() * numPixels]);
-            floatCs->convertPixelsTo(originalBytes.data(), dst.data(), modifiedMonitorCs, numPixels, KoColorConversionTransformation::internalRenderingIntent(), KoColorConversionTransformation::internalConversionFlags());
-            originalBytes.swap(dst);
-        }
+        /**
+         * The float projection is passed to the filter as it is, the
+         * other depths are converted into the float space first. All
+         * the stages run on the tiles of the projection in a single
+         * pass, without the full-size intermediate buffers.
+         */
+        const KoColorSpace *filterInputCs =
+            projectionCs->colorDepthId() == Float32BitsColorDepthID ? projectionCs : floatCs;
+
+        KisDisplayPipeline pipeline(projectionCs, m_displayFilter,
+                                    filterInputCs, floatCs, modifiedMonitorCs);
+
+        originalBytes.reset(new quint8[modifiedMonitorCs->pixelSize() * numPixels]);
+        pipeline.apply(originalProjection, rect, originalBytes.data());
+#else
+        originalBytes.reset(new quint8[projectionCs->pixelSize() * numPixels]);
+        originalProjection->readBytes(originalBytes.data(), rect);
 #endif
     }
     else {
+        originalBytes.reset(new quint8[projectionCs->pixelSize() * numPixels]);
+        originalProjection->readBytes(originalBytes.data(), rect);
+
         if (m_channelFlags.size() != projectionCs->channelCount()) {
             setChannelFlags(QBitArray());
         }
@@ -287,16 +463,16 @@ void KisImagePyramid::retrieveImageData(const QRect &rect)
 
 void KisImagePyramid::recalculateCache(KisPPUpdateInfoSP info)
 {
-    KisPaintDevice *src;
-    KisPaintDevice *dst;
-    QRect currentSrcRect = info->dirtyImageRectVar;
+    /**
+     * Only the level that is going to be displayed is regenerated,
+     * the other levels stay dirty until they are needed
+     */
+    const qint32 index = findFirstGoodPlaneIndex(qMax(info->scaleX, info->scaleY),
+                                                 info->imageRect.size());
 
-    for (int i = FIRST_NOT_ORIGINAL_INDEX; i < m_pyramidHeight; i++) {
-        src = m_pyramid[i-1].data();
-        dst = m_pyramid[i].data();
-        if (!currentSrcRect.isEmpty()) {
-            currentSrcRect = downsampleByFactor2(currentSrcRect, src, dst);
-        }
+    {
+        QMutexLocker l(&m_levelsLock);
+        ensureLevelUpToDate(index, levelRectFromImageRect(info->imageRect, index));
     }
 
 #ifdef DEBUG_PYRAMID
@@ -365,26 +541,39 @@ void  KisImagePyramid::downsamplePixels(const quint8 *srcRow0,
                                         qint32 numSrcPixels)
 {
     /**
-     * FIXME (mandatory): Use SSE and friends here.
+     * The pixels are averaged as whole 32-bit words: the even and the
+     * odd channels are summed separately in 16-bit lanes, which cannot
+     * overflow for four 8-bit values. The loop has no branches and no
+     * per-channel code, so the compiler vectorizes it for the target
+     * instruction set. The result is the same as the one of the
+     * per-channel division by four.
      */
 
-    qint16 b = 0;
-    qint16 g = 0;
-    qint16 r = 0;
-    qint16 a = 0;
-
     static const qint32 pixelSize = 4; // This is preview argb8 mode
+    static const quint32 laneMask = 0x00FF00FF;
+
+    const qint32 numDstPixels = numSrcPixels / 2;
 
-    for (qint32 i = 0; i < numSrcPixels / 2; i++) {
-        b = srcRow0[0] + srcRow1[0] + srcRow0[4] + srcRow1[4];
-        g = srcRow0[1] + srcRow1[1] + srcRow0[5] + srcRow1[5];
-        r = srcRow0[2] + srcRow1[2] + srcRow0[6] + srcRow1[6];
-        a = srcRow0[3] + srcRow1[3] + srcRow0[7] + srcRow1[7];
+    for (qint32 i = 0; i < numDstPixels; i++) {
+        quint32 p00, p01, p10, p11;
 
-        dstRow[0] = b / 4;
-        dstRow[1] = g / 4;
-        dstRow[2] = r / 4;
-        dstRow[3] = a / 4;
+        memcpy(&p00, srcRow0, pixelSize);
+        memcpy(&p01, srcRow0 + pixelSize, pixelSize);
+        memcpy(&p10, srcRow1, pixelSize);
+        memcpy(&p11, srcRow1 + pixelSize, pixelSize);
+
+        const quint32 even =
+            (p00 & laneMask) + (p01 & laneMask) +
+            (p10 & laneMask) + (p11 & laneMask);
+
+        const quint32 odd =
+            ((p00 >> 8) & laneMask) + ((p01 >> 8) & laneMask) +
+            ((p10 >> 8) & laneMask) + ((p11 >> 8) & laneMask);
+
+        const quint32 result =
+            ((even >> 2) & laneMask) | (((odd >> 2) & laneMask) << 8);
+
+        memcpy(dstRow, &result, pixelSize);
 
         dstRow += pixelSize;
         srcRow0 += 2 * pixelSize;
@@ -458,8 +647,7 @@ KisImagePatch KisImagePyramid::getNearestPatch(KisPPUpdateInfoSP info)
     KisImagePatch patch(info->imageRect, info->borderWidth,
                         planeScale, planeScale);
 
-    patch.setImage(convertToQImageFast(m_pyramid[index],
-                                       patch.patchRect()));
+    patch.setImage(levelImage(index, patch.patchRect()));
     return patch;
 }
 
@@ -486,5 +674,7 @@ void KisImagePyramid::configChanged()
 {
     KisConfig cfg(true);
     m_useOcio = cfg.useOcio();
+
+    m_maxThreadCount = KisImageConfig(true).maxNumberOfThreads();
 }
 
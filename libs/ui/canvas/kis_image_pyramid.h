@@ -7,17 +7,33 @@
 #ifndef __KIS_IMAGE_PYRAMID
 #define __KIS_IMAGE_PYRAMID
 
+#include <QBitArray>
 #include <QImage>
+#include <QMutex>
 #include <QVector>
 #include <QThreadStorage>
 
+#include <kritaui_export.h>
+
 #include <KoColorSpace.h>
 #include <kis_image.h>
 #include <kis_paint_device.h>
 #include "kis_projection_backend.h"
 
 
-class KisImagePyramid : QObject, public KisProjectionBackend
+/**
+ * The pyramid of the downscaled copies of the image used by the QPainter
+ * canvas. Level 0 holds the projection converted into the display color
+ * space, every next level is a 2x2 box downsampling of the previous one.
+ *
+ * Only level 0 is updated eagerly in updateCache(). The higher levels
+ * are split into the tiles of the paint device and every level keeps a
+ * bitmap of its dirty tiles. The dirty tiles of a level are regenerated
+ * only when that level is displayed, together with the dirty tiles of
+ * the lower levels they depend on. The tiles of a level are downsampled
+ * on multiple threads.
+ */
+class KRITAUI_EXPORT KisImagePyramid : QObject, public KisProjectionBackend
 {
     Q_OBJECT
 
@@ -61,7 +77,47 @@ public:
 
     void alignSourceRect(QRect& rect, qreal scale) override;
 
+    /**
+     * @return the pixels of \p levelRect of the pyramid level \p level,
+     * the rect is in the coordinates of the level. The dirty tiles of the
+     * level are regenerated before reading.
+     */
+    QImage levelImage(int level, const QRect &levelRect);
+
+    /**
+     * Sets the number of threads the tiles of a level are downsampled
+     * on. Zero means QThread::idealThreadCount(), one disables
+     * multithreading. By default the limit is read from KisImageConfig.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
 private:
+    /**
+     * Marks the tiles of all the levels except the original one
+     * depending on \p imageRect as dirty
+     */
+    void markDirty(const QRect &imageRect);
+
+    /**
+     * Marks all the tiles of all the levels as dirty and adjusts
+     * the size of the bitmaps to the size of the image
+     */
+    void resetDirtyTiles();
+
+    /**
+     * Regenerates the dirty tiles of \p level intersecting \p levelRect
+     * and, before that, the dirty tiles of the lower levels they
+     * are downsampled from
+     */
+    void ensureLevelUpToDate(int level, const QRect &levelRect);
+
+    /**
+     * @return the dirty tiles of \p level intersecting \p levelRect
+     * and marks them as clean
+     */
+    QVector<QRect> takeDirtyTiles(int level, const QRect &levelRect);
+
 
     void retrieveImageData(const QRect &rect);
     void rebuildPyramid();
@@ -72,16 +128,16 @@ private:
      * result into proper place of @dst paint device
      * Returns modified rect of @dst paintDevice
      */
-    QRect downsampleByFactor2(const QRect& srcRect,
-                              KisPaintDevice* src, KisPaintDevice* dst);
+    static QRect downsampleByFactor2(const QRect& srcRect,
+                                     KisPaintDevice* src, KisPaintDevice* dst);
 
     /**
      * Auxiliary function. Downsamples two lines in @srcRow0
      * and @srcRow1 into one line @dstRow
      * Note: @numSrcPixels must be EVEN
      */
-    void downsamplePixels(const quint8 *srcRow0, const quint8 *srcRow1,
-                          quint8 *dstRow, qint32 numSrcPixels);
+    static void downsamplePixels(const quint8 *srcRow0, const quint8 *srcRow1,
+                                 quint8 *dstRow, qint32 numSrcPixels);
 
     /**
      * Searches for the last pyramid plane that can cover
@@ -103,8 +159,30 @@ private Q_SLOTS:
 
 private:
 
+    struct DirtyTiles {
+        QBitArray bits;
+        int columns {0};
+        int rows {0};
+    };
+
     QVector<KisPaintDeviceSP> m_pyramid;
     KisImageWSP  m_originalImage;
+    QSize m_imageSize;
+
+    /**
+     * The bitmaps of dirty tiles of the levels, the bitmap of the
+     * original level is always empty. Guarded by m_dirtyTilesLock,
+     * which is held only while the bits are read or written.
+     */
+    QVector<DirtyTiles> m_dirtyTiles;
+    QMutex m_dirtyTilesLock;
+
+    /**
+     * Serializes regeneration of the levels
+     */
+    QMutex m_levelsLock;
+
+    int m_maxThreadCount {0};
 
     const KoColorProfile* m_monitorProfile {0};
     const KoColorSpace* m_monitorColorSpace {0};
@@ -84,9 +84,9 @@ KisPrescaledProjection::KisPrescaledProjection()
 {
     updateSettings();
 
-    // we disable building the pyramid with setting its height to 1
-    // XXX: setting it higher than 1 is broken because it's not updated until you show/hide the layer
-    m_d->projectionBackend = new KisImagePyramid(1);
+    // the levels of the pyramid are generated lazily when the zoom
+    // needs them, so the levels down to 1/8 cost nothing until then
+    m_d->projectionBackend = new KisImagePyramid(4);
 
     connect(KisConfigNotifier::instance(), SIGNAL(configChanged()), SLOT(updateSettings()));
 }
@@ -164,6 +164,11 @@ void KisToolProxy::forwardToTool(ActionState state, KisTool::ToolAction action,
 
     if (!eventValid || !activeTool) return;
 
+    KisCanvas2 *kritaCanvas = dynamic_cast<KisCanvas2*>(canvas());
+    if (kritaCanvas) {
+        kritaCanvas->notifyToolEventPosition(docPoint);
+    }
+
     switch (state) {
     case BEGIN:
         if (action == KisTool::Primary) {
@@ -240,6 +240,12 @@ struct KisAnimationCachePopulator::Private
         // the image is not animated
         KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(animation->hasAnimation(), RequestRejected);
 
+        // don't let the background regeneration evict the frames
+        // it has just generated itself
+        if (priorityFrame < 0 && cache->isMemoryLimitReached()) {
+            return RequestRejected;
+        }
+
         KisTimeSpan currentRange = animation->documentPlaybackRange();
 
         const int frame = priorityFrame >= 0 ? priorityFrame : KisAsyncAnimationCacheRenderDialog::calcFirstDirtyFrame(cache, currentRange, skipRange);
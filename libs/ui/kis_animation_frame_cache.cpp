@@ -8,6 +8,7 @@
 #include "kis_animation_frame_cache_p.h"
 
 #include <QMap>
+#include <QVector>
 
 #include "kis_debug.h"
 
@@ -20,6 +21,7 @@
 #include <KisAbstractFrameCacheSwapper.h>
 #include "KisFrameCacheSwapper.h"
 #include "KisInMemoryFrameCacheSwapper.h"
+#include "KisCompressedFrameCacheSwapper.h"
 
 #include "kis_image_config.h"
 #include "kis_config_notifier.h"
@@ -27,7 +29,10 @@
 #include "opengl/kis_opengl_image_textures.h"
 
 #include <kis_algebra_2d.h>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 
 
 struct KisAnimationFrameCache::Private
@@ -48,6 +53,18 @@ struct KisAnimationFrameCache::Private
     QScopedPointer<KisAbstractFrameCacheSwapper> swapper;
     int frameSizeLimit = 777;
 
+    qint64 memoryLimit = 0;
+
+    /**
+     * Set when the memory limit made the cache drop the frames closer
+     * to the playhead than the one being added. Reset when the frames
+     * are invalidated or the playhead jumps.
+     */
+    bool framesEvicted = false;
+
+    int playheadTime = -1;
+    int playbackDirection = 1;
+
     KisOpenGLUpdateInfoSP fetchFrameDataImpl(KisImageSP image, const QRect &requestedRect, int lod);
 
     struct Frame
@@ -107,6 +124,176 @@ struct KisAnimationFrameCache::Private
         const int length = range.isInfinite() ? -1 : range.end() - range.start() + 1;
         newFrames.insert(range.start(), length);
         swapper->saveFrame(range.start(), info, image->bounds());
+
+        evictFramesOverLimit(range.start());
+    }
+
+    void updatePlayhead(int time)
+    {
+        if (playheadTime >= 0 && time != playheadTime) {
+            const KisTimeSpan &range = image->animationInterface()->activePlaybackRange();
+            const int delta = time - playheadTime;
+
+            /**
+             * A jump over more than a half of the playback range is
+             * the playback wrapping around the end of the range, not
+             * a change of the direction
+             */
+            const bool rangeIsFinite = range.isValid() && !range.isInfinite();
+
+            if (!rangeIsFinite || 2 * qAbs(delta) < range.duration()) {
+                playbackDirection = delta > 0 ? 1 : -1;
+            }
+
+            /**
+             * The playback moves to the adjacent frame, wrapping around
+             * the range. Any other move is a seek, after which the
+             * background regeneration may refill the cache around the
+             * new position.
+             */
+            int step = qAbs(delta);
+
+            if (rangeIsFinite && range.contains(time) && range.contains(playheadTime)) {
+                step = qMin(step, range.duration() - step);
+            }
+
+            if (step > 1) {
+                framesEvicted = false;
+            }
+        }
+
+        playheadTime = time;
+    }
+
+    /**
+     * The number of frames the playback should pass before it reaches
+     * the cached frame \p start. The playback range is treated as a
+     * ring buffer, so the frames that have just been played are the
+     * furthest ones. The frames outside the range are never reached.
+     */
+    int playbackDistance(int start, int length, int playhead, const KisTimeSpan &range) const
+    {
+        const bool rangeIsFinite = range.isValid() && !range.isInfinite();
+
+        if (playhead >= start && (length == -1 || playhead < start + length)) {
+            return 0;
+        }
+
+        int edge = start;
+
+        if (playbackDirection < 0) {
+            edge = length != -1 ? start + length - 1 : rangeIsFinite ? range.end() : start;
+        }
+
+        int ringSize = std::numeric_limits<int>::max() / 2;
+
+        if (rangeIsFinite) {
+            if (!range.overlaps(KisTimeSpan::fromTimeToTime(start, length == -1 ? range.end() : start + length - 1))) {
+                return std::numeric_limits<int>::max();
+            }
+
+            edge = qBound(range.start(), edge, range.end());
+            ringSize = range.duration();
+        }
+
+        int distance = (edge - playhead) * playbackDirection;
+
+        if (distance < 0) {
+            distance += ringSize;
+        }
+
+        return distance;
+    }
+
+    /**
+     * Drops the frames furthest from the playhead in the direction of
+     * the playback until the swapper fits into the memory limit. The
+     * frame \p protectedFrameId is never dropped.
+     *
+     * The frames sharing their data are dropped group by group: the
+     * groups go in the order of their frame closest to the playhead,
+     * and the keyframe of a group goes after all its dependent frames,
+     * since before that forgetting it frees nothing.
+     */
+    void evictFramesOverLimit(int protectedFrameId)
+    {
+        if (!memoryLimit || swapper->memoryUsage() <= memoryLimit) return;
+
+        const KisTimeSpan range = image->animationInterface()->activePlaybackRange();
+        const int playhead = playheadTime >= 0 ? playheadTime : image->animationInterface()->currentUITime();
+
+        struct FrameGroup {
+            int distance = std::numeric_limits<int>::max();
+            QVector<QPair<int, int>> frames;
+        };
+
+        QMap<int, FrameGroup> groups;
+
+        const int protectedGroupId =
+            swapper->hasFrame(protectedFrameId) ? swapper->frameGroupId(protectedFrameId) : -1;
+
+        for (auto it = newFrames.constBegin(); it != newFrames.constEnd(); ++it) {
+            const int frameId = it.key();
+            if (frameId == protectedFrameId) continue;
+
+            const int groupId = swapper->frameGroupId(frameId);
+
+            /**
+             * The keyframe of the protected frame cannot be freed
+             * anyway, so there is no point in dropping it
+             */
+            if (groupId == protectedGroupId && swapper->isKeyframe(frameId)) continue;
+
+            const int distance = playbackDistance(frameId, it.value(), playhead, range);
+
+            /**
+             * The keyframe is sorted after all the dependent frames of
+             * the group, whatever its own distance is
+             */
+            const int order = swapper->isKeyframe(frameId) ? -1 : distance;
+
+            FrameGroup &group = groups[groupId];
+            group.distance = qMin(group.distance, distance);
+            group.frames << qMakePair(order, frameId);
+        }
+
+        QVector<FrameGroup> sortedGroups;
+        sortedGroups.reserve(groups.size());
+
+        for (auto it = groups.begin(); it != groups.end(); ++it) {
+            std::sort(it->frames.begin(), it->frames.end(), std::greater<QPair<int, int>>());
+            sortedGroups << *it;
+        }
+
+        std::stable_sort(sortedGroups.begin(), sortedGroups.end(),
+                         [] (const FrameGroup &lhs, const FrameGroup &rhs) {
+                             return lhs.distance > rhs.distance;
+                         });
+
+        const int protectedDistance =
+            newFrames.contains(protectedFrameId) ?
+            playbackDistance(protectedFrameId, newFrames[protectedFrameId], playhead, range) :
+            std::numeric_limits<int>::max();
+
+        for (auto groupIt = sortedGroups.constBegin(); groupIt != sortedGroups.constEnd(); ++groupIt) {
+            for (auto it = groupIt->frames.constBegin(); it != groupIt->frames.constEnd(); ++it) {
+                if (swapper->memoryUsage() <= memoryLimit) return;
+
+                const int frameId = it->second;
+
+                /**
+                 * Dropping a frame that the playback reaches earlier
+                 * than the new one means the cache is full of the
+                 * frames around the playhead already
+                 */
+                if (playbackDistance(frameId, newFrames[frameId], playhead, range) <= protectedDistance) {
+                    framesEvicted = true;
+                }
+
+                swapper->forgetFrame(frameId);
+                newFrames.remove(frameId);
+            }
+        }
     }
 
     /**
@@ -216,6 +403,7 @@ KisAnimationFrameCache::KisAnimationFrameCache(KisOpenGLImageTexturesSP textures
     slotConfigChanged();
 
     connect(m_d->image->animationInterface(), SIGNAL(sigFramesChanged(KisTimeSpan,QRect)), this, SLOT(framesChanged(KisTimeSpan,QRect)));
+    connect(m_d->image->animationInterface(), SIGNAL(sigUiTimeChanged(int)), this, SLOT(slotUiTimeChanged(int)));
     connect(KisConfigNotifier::instance(), SIGNAL(configChanged()), SLOT(slotConfigChanged()));
 }
 
@@ -226,6 +414,8 @@ KisAnimationFrameCache::~KisAnimationFrameCache()
 
 bool KisAnimationFrameCache::uploadFrame(int time)
 {
+    m_d->updatePlayhead(time);
+
     KisOpenGLUpdateInfoSP info = m_d->getFrame(time);
 
     if (!info) {
@@ -256,6 +446,11 @@ KisAnimationFrameCache::CacheStatus KisAnimationFrameCache::frameStatus(int time
     return m_d->hasFrame(time) ? Cached : Uncached;
 }
 
+bool KisAnimationFrameCache::isMemoryLimitReached() const
+{
+    return m_d->memoryLimit > 0 && m_d->framesEvicted;
+}
+
 FramesGluerBase::~FramesGluerBase()
 {
 }
@@ -368,10 +563,17 @@ void KisAnimationFrameCache::framesChanged(const KisTimeSpan &range, const QRect
     bool cacheChanged = m_d->invalidate(range);
 
     if (cacheChanged) {
+        m_d->framesEvicted = false;
         Q_EMIT changed();
     }
 }
 
+void KisAnimationFrameCache::slotUiTimeChanged(int time)
+{
+    // the seeks to the uncached frames don't pass through uploadFrame()
+    m_d->updatePlayhead(time);
+}
+
 void KisAnimationFrameCache::slotConfigChanged()
 {
     m_d->newFrames.clear();
@@ -380,10 +582,21 @@ void KisAnimationFrameCache::slotConfigChanged()
 
     if (cfg.useOnDiskAnimationCacheSwapping()) {
         m_d->swapper.reset(new KisFrameCacheSwapper(m_d->textures->updateInfoBuilder(), cfg.swapDir()));
+    } else if (cfg.useAnimationCacheCompression()) {
+        m_d->swapper.reset(new KisCompressedFrameCacheSwapper(m_d->textures->updateInfoBuilder()));
     } else {
         m_d->swapper.reset(new KisInMemoryFrameCacheSwapper());
     }
 
+    /**
+     * The limit is applied to the compressed cache only, the other
+     * swappers keep their old unlimited behavior
+     */
+    m_d->memoryLimit =
+        !cfg.useOnDiskAnimationCacheSwapping() && cfg.useAnimationCacheCompression() ?
+        qint64(cfg.animationCacheMemoryLimit()) * 1024 * 1024 : 0;
+    m_d->framesEvicted = false;
+
     m_d->frameSizeLimit = cfg.useAnimationCacheFrameSizeLimit() ? cfg.animationCacheFrameSizeLimit() : 0;
     Q_EMIT changed();
 }
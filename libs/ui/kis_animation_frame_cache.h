@@ -49,6 +49,16 @@ public:
     };
 
     CacheStatus frameStatus(int time) const;
+
+    /**
+     * @return true if the cache has hit its memory limit, that is, it
+     *         had to drop the frames closer to the playhead than the
+     *         new ones to fit them. The background
+     *         regeneration should not fill the cache any further until
+     *         the frames are invalidated or the playhead jumps.
+     */
+    bool isMemoryLimitReached() const;
+
     bool tryGlueSameFrames(const KisTimeSpan &range);
 
 
@@ -75,6 +85,7 @@ private:
 
 private Q_SLOTS:
     void framesChanged(const KisTimeSpan &range, const QRect &rect);
+    void slotUiTimeChanged(int time);
     void slotConfigChanged();
 };
 
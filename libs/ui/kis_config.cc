@@ -1665,6 +1665,16 @@ void KisConfig::setLevelOfDetailEnabled(bool value)
     m_cfg.writeEntry("levelOfDetailEnabled", value);
 }
 
+bool KisConfig::prioritizeUpdatesAroundCursor(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("prioritizeUpdatesAroundCursor", false));
+}
+
+void KisConfig::setPrioritizeUpdatesAroundCursor(bool value)
+{
+    m_cfg.writeEntry("prioritizeUpdatesAroundCursor", value);
+}
+
 KisOcioConfiguration KisConfig::ocioConfiguration(bool defaultValue) const
 {
     KisOcioConfiguration cfg;
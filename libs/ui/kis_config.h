@@ -417,6 +417,13 @@ public:
     bool levelOfDetailEnabled(bool defaultValue = false) const;
     void setLevelOfDetailEnabled(bool value);
 
+    /**
+     * When enabled, the canvas updates the areas closest to the tool
+     * first and defers the updates outside the visible area until idle
+     */
+    bool prioritizeUpdatesAroundCursor(bool defaultValue = false) const;
+    void setPrioritizeUpdatesAroundCursor(bool value);
+
     KisOcioConfiguration ocioConfiguration(bool defaultValue = false) const;
     void setOcioConfiguration(const KisOcioConfiguration &cfg);
 
@@ -12,6 +12,7 @@
 #include "kis_coordinates_converter.h"
 #include "opengl/kis_opengl_canvas_debugger.h"
 #include <KisStrokeSpeedMonitor.h>
+#include <kis_update_time_monitor.h>
 #include <QGraphicsScene>
 #include <QGraphicsPixmapItem>
 #include <QGraphicsDropShadowEffect>
@@ -119,6 +120,15 @@ QString KisFpsDecoration::getText() const
                 .arg(monitor->avgRenderingSpeed(), 0, 'f', 1);
         lines << QString("Average brush framerate: %1 fps")
                 .arg(monitor->avgFps(), 0, 'f', 1);
+
+        const KisUpdateTimeMonitor::LatencyStatistics latency =
+            KisUpdateTimeMonitor::instance()->latencyStatistics();
+
+        if (latency.numSamples > 0) {
+            lines << QString("Tool event to pixels latency (avg/max): %1/%2 ms")
+                    .arg(latency.averageLatency, 0, 'f', 1)
+                    .arg(latency.maxLatency);
+        }
     }
 
     return lines.join('\n');
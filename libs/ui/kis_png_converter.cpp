@@ -860,32 +860,10 @@ bool KisPNGConverter::saveDeviceToStore(const QString &filename, const QRect &im
             dbgFile << "Could not open for writing:" << filename;
             return false;
         }
-        KisPNGConverter pngconv(0);
-        vKisAnnotationSP_it annotIt;
-        KisMetaData::Store* metaDataStore = 0;
-        if (metaData) {
-            metaDataStore = new KisMetaData::Store(*metaData);
-        }
-        KisPNGOptions options;
-        options.compression = 3;
-        options.interlace = false;
-        options.tryToSaveAsIndexed = false;
-        options.alpha = true;
-        options.saveSRGBProfile = false;
-        options.downsample = false;
-
-        if (dev->colorSpace()->id() != "RGBA") {
-            dev = new KisPaintDevice(*dev.data());
-            dev->convertTo(KoColorSpaceRegistry::instance()->rgb8());
-        }
-
-        KisImportExportErrorCode success = pngconv.buildFile(&io, imageRect, xRes, yRes, dev, annotIt, annotIt, options, metaDataStore);
-        if (!success.isOk()) {
+        if (!saveDeviceToIODevice(&io, imageRect, xRes, yRes, dev, metaData)) {
             dbgFile << "Saving PNG failed:" << filename;
-            delete metaDataStore;
             return false;
         }
-        delete metaDataStore;
         io.close();
         if (!store->close()) {
             return false;
@@ -898,6 +876,33 @@ bool KisPNGConverter::saveDeviceToStore(const QString &filename, const QRect &im
 
 }
 
+bool KisPNGConverter::saveDeviceToIODevice(QIODevice *io, const QRect &imageRect, const qreal xRes, const qreal yRes, KisPaintDeviceSP dev, KisMetaData::Store* metaData)
+{
+    KisPNGConverter pngconv(0);
+    vKisAnnotationSP_it annotIt;
+    KisMetaData::Store* metaDataStore = 0;
+    if (metaData) {
+        metaDataStore = new KisMetaData::Store(*metaData);
+    }
+    KisPNGOptions options;
+    options.compression = 3;
+    options.interlace = false;
+    options.tryToSaveAsIndexed = false;
+    options.alpha = true;
+    options.saveSRGBProfile = false;
+    options.downsample = false;
+
+    if (dev->colorSpace()->id() != "RGBA") {
+        dev = new KisPaintDevice(*dev.data());
+        dev->convertTo(KoColorSpaceRegistry::instance()->rgb8());
+    }
+
+    KisImportExportErrorCode success = pngconv.buildFile(io, imageRect, xRes, yRes, dev, annotIt, annotIt, options, metaDataStore);
+    delete metaDataStore;
+
+    return success.isOk();
+}
+
 
 KisImportExportErrorCode KisPNGConverter::buildFile(const QString &filename, const QRect &imageRect, const qreal xRes, const qreal yRes, KisPaintDeviceSP device, vKisAnnotationSP_it annotationsStart, vKisAnnotationSP_it annotationsEnd, KisPNGOptions options, KisMetaData::Store* metaData)
 {
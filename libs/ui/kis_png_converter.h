@@ -116,6 +116,14 @@ public:
      */
     static bool saveDeviceToStore(const QString &filename, const QRect &imageRect, const qreal xRes, const qreal yRes, KisPaintDeviceSP dev, KoStore *store, KisMetaData::Store* metaData = 0);
 
+    /**
+     * @brief saveDeviceToIODevice encodes the given paint device the same way
+     * as saveDeviceToStore() does, but writes the result into \p io. It does
+     * not access the GUI, so it can be used from a worker thread.
+     * @return true if the saving succeeds
+     */
+    static bool saveDeviceToIODevice(QIODevice *io, const QRect &imageRect, const qreal xRes, const qreal yRes, KisPaintDeviceSP dev, KisMetaData::Store* metaData = 0);
+
     static bool isColorSpaceSupported(const KoColorSpace *cs);
 
 public Q_SLOTS:
@@ -14,6 +14,12 @@
 #include <QReadWriteLock>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+#include <KoColorConversionCache.h>
 
 
 struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
@@ -32,6 +38,13 @@ struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
 
     KisTextureTileInfoPoolSP pool;
     QReadWriteLock lock;
+
+    /**
+     * The pool is persistent, because the builder runs on every canvas
+     * update and starting the threads each time would eat the gain
+     */
+    QThreadPool threadPool;
+    int maxThreadCount = 0;
 };
 
 
@@ -142,16 +155,6 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
                                                      m_d->pool));
             // Don't update empty tiles
             if (tileInfo->valid()) {
-                tileInfo->retrieveData(projection, channelFlags, m_d->onlyOneChannelSelected, m_d->selectedChannelIndex);
-
-                if (convertColorSpace) {
-                    if (m_d->proofingTransform) {
-                        tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->displayFlags, m_d->proofingTransform.data());
-                    } else {
-                        tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
-                    }
-                }
-
                 info->tileList.append(tileInfo);
             }
             else {
@@ -160,6 +163,106 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
         }
     }
 
+    const KoColorSpace *srcColorSpace = projection->colorSpace();
+    const KoColorSpace *dstColorSpace = m_d->conversionOptions.m_destinationColorSpace;
+    const KoColorConversionTransformation::Intent renderingIntent = m_d->conversionOptions.m_renderingIntent;
+    const KoColorConversionTransformation::ConversionFlags conversionFlags = m_d->conversionOptions.m_conversionFlags;
+    KoColorConversionTransformation *proofingTransform = m_d->proofingTransform.data();
+    const KoColorConversionTransformation::ConversionFlags proofingDisplayFlags =
+        proofingTransform ? m_d->proofingConfig->displayFlags : KoColorConversionTransformation::Empty;
+    const bool onlyOneChannelSelected = m_d->onlyOneChannelSelected;
+    const int selectedChannelIndex = m_d->selectedChannelIndex;
+
+    /**
+     * The channel visualization works on the original pixels, so the
+     * patches with the channel flags are still read and converted in
+     * two steps (see KisTextureTileUpdateInfo::retrieveData())
+     */
+    const bool convertsChannels =
+        !channelFlags.isEmpty() &&
+        selectedChannelIndex >= 0 &&
+        selectedChannelIndex < int(srcColorSpace->channelCount());
+
+    const bool needsConversion = convertColorSpace &&
+        (proofingTransform ?
+             dstColorSpace != srcColorSpace || proofingDisplayFlags != KoColorConversionTransformation::Empty :
+             !(dstColorSpace == srcColorSpace || *dstColorSpace == *srcColorSpace) || conversionFlags != KoColorConversionTransformation::Empty);
+
+    auto processTile = [=] (KisTextureTileUpdateInfoSP tileInfo) {
+        if (needsConversion && !convertsChannels) {
+            if (proofingTransform) {
+                tileInfo->retrieveConvertedData(projection, dstColorSpace, proofingTransform);
+            } else {
+                KoCachedColorConversionTransformation cachedTransform =
+                    KoColorSpaceRegistry::instance()->colorConversionCache()->
+                        cachedConverter(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+
+                tileInfo->retrieveConvertedData(projection, dstColorSpace, cachedTransform.transformation());
+            }
+        } else {
+            tileInfo->retrieveData(projection, channelFlags, onlyOneChannelSelected, selectedChannelIndex);
+
+            if (convertColorSpace) {
+                if (proofingTransform) {
+                    tileInfo->proofTo(dstColorSpace, proofingDisplayFlags, proofingTransform);
+                } else {
+                    tileInfo->convertTo(dstColorSpace, renderingIntent, conversionFlags);
+                }
+            }
+        }
+    };
+
+    const int numTiles = info->tileList.size();
+    const int numThreads = m_d->maxThreadCount > 0 ? m_d->maxThreadCount : QThread::idealThreadCount();
+    const int numJobs = qMin(numThreads, numTiles);
+
+    if (numJobs <= 1) {
+        Q_FOREACH (KisTextureTileUpdateInfoSP tileInfo, info->tileList) {
+            processTile(tileInfo);
+        }
+    } else {
+        /**
+         * The tiles are fetched by the jobs one by one, so a job that got
+         * cheap edge tiles doesn't sit idle. The calling thread takes part
+         * in the processing as well.
+         */
+        const KisTextureTileUpdateInfoSPList &tileList = info->tileList;
+        QAtomicInt nextTile;
+
+        auto processTiles = [&tileList, &nextTile, &processTile, numTiles] () {
+            int index = 0;
+            while ((index = nextTile.fetchAndAddOrdered(1)) < numTiles) {
+                processTile(tileList[index]);
+            }
+        };
+
+        QSemaphore jobsDone;
+        int numStartedJobs = 0;
+
+        for (int i = 1; i < numJobs; i++) {
+            QRunnable *job = QRunnable::create(
+                [&processTiles, &jobsDone] () {
+                    processTiles();
+                    jobsDone.release();
+                });
+
+            /**
+             * If the pool is busy with another update, there is no point
+             * in queueing the job: the tiles will be processed by the
+             * calling thread anyway
+             */
+            if (m_d->threadPool.tryStart(job)) {
+                numStartedJobs++;
+            } else {
+                delete job;
+                break;
+            }
+        }
+
+        processTiles();
+        jobsDone.acquire(numStartedJobs);
+    }
+
     info->assignDirtyImageRect(rect);
     info->assignLevelOfDetail(levelOfDetail);
     return info;
@@ -187,6 +290,20 @@ QRect KisOpenGLUpdateInfoBuilder::calculatePhysicalTileRect(int col, int row, co
 }
 
 
+void KisOpenGLUpdateInfoBuilder::setMaxThreadCount(int value)
+{
+    QWriteLocker lock(&m_d->lock);
+
+    m_d->maxThreadCount = value;
+    m_d->threadPool.setMaxThreadCount(value > 0 ? value : QThread::idealThreadCount());
+}
+
+int KisOpenGLUpdateInfoBuilder::maxThreadCount() const
+{
+    QReadLocker lock(&m_d->lock);
+    return m_d->maxThreadCount;
+}
+
 int KisOpenGLUpdateInfoBuilder::xToCol(int x) const
 {
     return x / m_d->effectiveTextureSize.width();
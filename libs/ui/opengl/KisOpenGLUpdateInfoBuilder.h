@@ -38,6 +38,11 @@ public:
     KisOpenGLUpdateInfoBuilder();
     ~KisOpenGLUpdateInfoBuilder();
 
+    /**
+     * Builds the texture updates for all the texture tiles touched by
+     * \p rect. The pixels of the tiles are read and converted into the
+     * display color space on multiple threads (see setMaxThreadCount()).
+     */
     KisOpenGLUpdateInfoSP buildUpdateInfo(const QRect& rect, KisImageSP srcImage, bool convertColorSpace);
     KisOpenGLUpdateInfoSP buildUpdateInfo(const QRect& rect, KisPaintDeviceSP projection, const QRect &bounds, int levelOfDetail, bool convertColorSpace);
 
@@ -60,6 +65,13 @@ public:
     void setProofingConfig(KisProofingConfigurationSP config);
     KisProofingConfigurationSP proofingConfig() const;
 
+    /**
+     * Sets the number of threads the texture tiles are processed on. Zero
+     * means QThread::idealThreadCount(), one disables multithreading.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -25,6 +25,7 @@
 
 #include "kis_image.h"
 #include "kis_config.h"
+#include "kis_image_config.h"
 #include "KisPart.h"
 #include "KisOpenGLModeProber.h"
 #include "kis_fixed_paint_device.h"
@@ -118,6 +119,7 @@ void KisOpenGLImageTextures::initGL(QOpenGLFunctions *f)
     // different images
     static KisTextureTileInfoPoolRegistry s_poolRegistry;
     m_updateInfoBuilder.setTextureInfoPool(s_poolRegistry.getPool(m_texturesInfo.width, m_texturesInfo.height));
+    m_updateInfoBuilder.setMaxThreadCount(KisImageConfig(true).maxNumberOfThreads());
 
     m_checkerTexture = GLuint();
     m_glFuncs->glGenTextures(1, &(*m_checkerTexture));
@@ -449,6 +451,9 @@ GLuint KisOpenGLImageTextures::checkerTexture()
 
 void KisOpenGLImageTextures::updateConfig(bool useBuffer, int NumMipmapLevels)
 {
+    // the thread limit may have been changed in the performance settings
+    m_updateInfoBuilder.setMaxThreadCount(KisImageConfig(true).maxNumberOfThreads());
+
     if(m_textureTiles.isEmpty()) return;
 
     const bool effectiveUseBuffer = KisOpenGL::shouldUseTextureBuffers(useBuffer);
@@ -13,6 +13,7 @@
 #include "kis_config.h"
 #include "kis_image.h"
 #include "kis_paint_device.h"
+#include "kis_random_accessor_ng.h"
 #include "kis_texture_tile_info_pool.h"
 #include <KoChannelInfo.h>
 #include <KoColorConversionTransformation.h>
@@ -177,6 +178,57 @@ public:
 
     }
 
+    /**
+     * Reads the patch from \p projectionDevice and converts it into \p dstCS
+     * with \p transform on the fly. The pixels are converted right from the
+     * tiles of the device into the pooled buffer, so, unlike the
+     * retrieveData() + convertTo() pair, no intermediate copy of the patch
+     * is made.
+     *
+     * The builder calls it from several threads at once. Every tile gets
+     * its own cached converter, but the proofing transform is shared by all
+     * the threads, so \p transform must allow concurrent transform() calls.
+     * The lcms transforms do: cmsDoTransform() keeps no state in the
+     * transform.
+     */
+    void retrieveConvertedData(KisPaintDeviceSP projectionDevice,
+                               const KoColorSpace *dstCS,
+                               const KoColorConversionTransformation *transform)
+    {
+        m_patchColorSpace = dstCS;
+        m_patchPixels.allocate(dstCS->pixelSize());
+
+        const int dstPixelSize = dstCS->pixelSize();
+        const int dstRowStride = m_patchRect.width() * dstPixelSize;
+
+        KisRandomConstAccessorSP srcIt = projectionDevice->createRandomConstAccessorNG();
+
+        int rows = 1;
+        int columns = 1;
+
+        for (int y = m_patchRect.y(); y <= m_patchRect.bottom(); y += rows) {
+            rows = qMin(srcIt->numContiguousRows(y), m_patchRect.bottom() - y + 1);
+
+            for (int x = m_patchRect.x(); x <= m_patchRect.right(); x += columns) {
+                columns = qMin(srcIt->numContiguousColumns(x), m_patchRect.right() - x + 1);
+
+                srcIt->moveTo(x, y);
+
+                const int srcRowStride = srcIt->rowStride(x, y);
+                const quint8 *srcPtr = srcIt->rawDataConst();
+                quint8 *dstPtr = m_patchPixels.data() +
+                    (y - m_patchRect.y()) * dstRowStride +
+                    (x - m_patchRect.x()) * dstPixelSize;
+
+                for (int i = 0; i < rows; i++) {
+                    transform->transform(srcPtr, dstPtr, columns);
+                    srcPtr += srcRowStride;
+                    dstPtr += dstRowStride;
+                }
+            }
+        }
+    }
+
     void convertTo(const KoColorSpace* dstCS,
                    KoColorConversionTransformation::Intent renderingIntent,
                    KoColorConversionTransformation::ConversionFlags conversionFlags)
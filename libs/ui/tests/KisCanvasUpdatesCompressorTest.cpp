@@ -0,0 +1,179 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisCanvasUpdatesCompressorTest.h"
+
+#include <simpletest.h>
+
+#include "canvas/kis_canvas_updates_compressor.h"
+
+
+namespace {
+
+KisUpdateInfoSP createInfo(const QRect &rect, int levelOfDetail = 0)
+{
+    KisOpenGLUpdateInfoSP info = new KisOpenGLUpdateInfo();
+    info->assignDirtyImageRect(rect);
+    info->assignLevelOfDetail(levelOfDetail);
+    return info;
+}
+
+KisUpdateInfoSP createMarker(KisMarkerUpdateInfo::Type type)
+{
+    return new KisMarkerUpdateInfo(type, QRect(0, 0, 2000, 2000));
+}
+
+KisUpdateInfoList takeAll(KisCanvasUpdatesCompressor &compressor, bool flushDeferred = false)
+{
+    KisUpdateInfoList list;
+    compressor.takeUpdateInfo(list, flushDeferred);
+    return list;
+}
+
+}
+
+void KisCanvasUpdatesCompressorTest::testFifoOrder()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setToolPosition(QPointF(1005, 1005));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(0, 0, 10, 10));
+    KisUpdateInfoSP info2 = createInfo(QRect(500, 500, 10, 10));
+    KisUpdateInfoSP info3 = createInfo(QRect(1000, 1000, 10, 10));
+
+    QVERIFY(compressor.putUpdateInfo(info1));
+    QVERIFY(!compressor.putUpdateInfo(info2));
+    QVERIFY(!compressor.putUpdateInfo(info3));
+
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info1, info2, info3}));
+}
+
+void KisCanvasUpdatesCompressorTest::testSortByDistance()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setPriorityMode(true);
+    compressor.setToolPosition(QPointF(505, 505));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(0, 0, 10, 10));
+    KisUpdateInfoSP info2 = createInfo(QRect(1100, 1100, 10, 10));
+    KisUpdateInfoSP info3 = createInfo(QRect(500, 500, 10, 10));
+
+    // the LoD rects are compared in LoD0 coordinates
+    KisUpdateInfoSP info4 = createInfo(QRect(200, 200, 10, 10), 1);
+
+    compressor.putUpdateInfo(info1);
+    compressor.putUpdateInfo(info2);
+    compressor.putUpdateInfo(info3);
+    compressor.putUpdateInfo(info4);
+
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info3, info4, info1, info2}));
+}
+
+void KisCanvasUpdatesCompressorTest::testOverlappingUpdatesKeepOrder()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setPriorityMode(true);
+    compressor.setToolPosition(QPointF(505, 505));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(1000, 1000, 10, 10));
+    KisUpdateInfoSP info2 = createInfo(QRect(0, 0, 100, 100));
+    KisUpdateInfoSP info3 = createInfo(QRect(90, 90, 500, 500));
+
+    compressor.putUpdateInfo(info1);
+    compressor.putUpdateInfo(info2);
+    compressor.putUpdateInfo(info3);
+
+    // info3 is the closest, but info2 must still be uploaded before it
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info2, info3, info1}));
+}
+
+void KisCanvasUpdatesCompressorTest::testDeferOffscreenUpdates()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setPriorityMode(true);
+    QVERIFY(!compressor.setVisibleRect(QRect(0, 0, 100, 100)));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(0, 0, 10, 10));
+    KisUpdateInfoSP info2 = createInfo(QRect(1000, 1000, 10, 10));
+
+    compressor.putUpdateInfo(info1);
+    compressor.putUpdateInfo(info2);
+
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info1}));
+    QVERIFY(compressor.hasDeferredUpdates());
+
+    // the deferred update doesn't notify the canvas
+    KisUpdateInfoSP info3 = createInfo(QRect(50, 50, 10, 10));
+    QVERIFY(compressor.putUpdateInfo(info3));
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info3}));
+
+    // scrolling to the deferred update releases it
+    QVERIFY(compressor.setVisibleRect(QRect(900, 900, 200, 200)));
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info2}));
+    QVERIFY(!compressor.hasDeferredUpdates());
+
+    // ... and so does the flush when idle
+    KisUpdateInfoSP info4 = createInfo(QRect(0, 0, 10, 10));
+    compressor.putUpdateInfo(info4);
+    QVERIFY(takeAll(compressor).isEmpty());
+    QCOMPARE(takeAll(compressor, true), KisUpdateInfoList({info4}));
+
+    // ... and disabling the priority mode
+    KisUpdateInfoSP info5 = createInfo(QRect(0, 0, 10, 10));
+    compressor.putUpdateInfo(info5);
+    QVERIFY(takeAll(compressor).isEmpty());
+    compressor.setPriorityMode(false);
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info5}));
+}
+
+void KisCanvasUpdatesCompressorTest::testReleaseOverlappedDeferredUpdates()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setPriorityMode(true);
+    compressor.setVisibleRect(QRect(0, 0, 100, 100));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(200, 0, 50, 50));
+    KisUpdateInfoSP info2 = createInfo(QRect(500, 500, 50, 50));
+    KisUpdateInfoSP info3 = createInfo(QRect(50, 0, 200, 50));
+
+    compressor.putUpdateInfo(info1);
+    compressor.putUpdateInfo(info2);
+    compressor.putUpdateInfo(info3);
+
+    // info1 is not visible, but it would overwrite the data of info3 otherwise
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info1, info3}));
+    QVERIFY(compressor.hasDeferredUpdates());
+
+    // the newer update containing the deferred one replaces it
+    KisUpdateInfoSP info4 = createInfo(QRect(400, 400, 200, 200));
+    compressor.putUpdateInfo(info4);
+    QVERIFY(!compressor.hasDeferredUpdates());
+    QCOMPARE(takeAll(compressor, true), KisUpdateInfoList({info4}));
+}
+
+void KisCanvasUpdatesCompressorTest::testMarkersAreBarriers()
+{
+    KisCanvasUpdatesCompressor compressor;
+    compressor.setPriorityMode(true);
+    compressor.setVisibleRect(QRect(0, 0, 100, 100));
+    compressor.setToolPosition(QPointF(0, 0));
+
+    KisUpdateInfoSP info1 = createInfo(QRect(1000, 1000, 10, 10));
+    KisUpdateInfoSP marker = createMarker(KisMarkerUpdateInfo::EndBatch);
+    KisUpdateInfoSP info2 = createInfo(QRect(1000, 1000, 5, 5));
+    KisUpdateInfoSP info3 = createInfo(QRect(50, 50, 10, 10));
+    KisUpdateInfoSP info4 = createInfo(QRect(0, 0, 10, 10));
+
+    compressor.putUpdateInfo(info1);
+    compressor.putUpdateInfo(marker);
+    compressor.putUpdateInfo(info2);
+    compressor.putUpdateInfo(info3);
+    compressor.putUpdateInfo(info4);
+
+    QCOMPARE(takeAll(compressor), KisUpdateInfoList({info1, marker, info4, info3}));
+    QCOMPARE(takeAll(compressor, true), KisUpdateInfoList({info2}));
+}
+
+SIMPLE_TEST_MAIN(KisCanvasUpdatesCompressorTest)
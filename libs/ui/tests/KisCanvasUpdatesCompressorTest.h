@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISCANVASUPDATESCOMPRESSORTEST_H
+#define KISCANVASUPDATESCOMPRESSORTEST_H
+
+#include <QObject>
+
+class KisCanvasUpdatesCompressorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testFifoOrder();
+    void testSortByDistance();
+    void testOverlappingUpdatesKeepOrder();
+    void testDeferOffscreenUpdates();
+    void testReleaseOverlappedDeferredUpdates();
+    void testMarkersAreBarriers();
+};
+
+#endif // KISCANVASUPDATESCOMPRESSORTEST_H
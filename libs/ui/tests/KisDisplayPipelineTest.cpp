@@ -0,0 +1,202 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisDisplayPipelineTest.h"
+
+#include <simpletest.h>
+
+#include <cmath>
+
+#include <KoColor.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+
+#include "canvas/kis_display_filter.h"
+#include "canvas/kis_exposure_gamma_correction_interface.h"
+#include "canvas/KisDisplayPipeline.h"
+
+
+namespace {
+
+/**
+ * Applies the exposure and gamma the same way the OCIO filter does,
+ * so the test doesn't need an OCIO config
+ */
+class TestDisplayFilter : public KisDisplayFilter
+{
+public:
+    TestDisplayFilter(float exposure, float gamma)
+        : m_gain(std::pow(2.0f, exposure)),
+          m_exponent(1.0f / gamma)
+    {
+    }
+
+    QString program() const override {
+        return QString();
+    }
+
+    void setupTextures(GLFunctions *f, QOpenGLShaderProgram *program) const override {
+        Q_UNUSED(f);
+        Q_UNUSED(program);
+    }
+
+    void filter(quint8 *pixels, quint32 numPixels) override {
+        float *ptr = reinterpret_cast<float*>(pixels);
+
+        for (quint32 i = 0; i < numPixels; i++) {
+            for (int c = 0; c < 3; c++) {
+                ptr[c] = std::pow(qMax(0.0f, ptr[c] * m_gain), m_exponent);
+            }
+            ptr += 4;
+        }
+    }
+
+    void approximateInverseTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    void approximateForwardTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    bool useInternalColorManagement() const override {
+        return false;
+    }
+
+    KisExposureGammaCorrectionInterface *correctionInterface() const override {
+        return KisDumbExposureGammaCorrectionInterface::instance();
+    }
+
+    bool lockCurrentColorVisualRepresentation() const override {
+        return false;
+    }
+
+    bool updateShader() override {
+        return false;
+    }
+
+private:
+    float m_gain;
+    float m_exponent;
+};
+
+const KoColorSpace* rgbaColorSpace(const KoID &depthId)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId.id(), 0);
+}
+
+void fillRandomPixels(KisPaintDeviceSP device, const QRect &rect)
+{
+    const KoColorSpace *cs = device->colorSpace();
+    KoColor color(cs);
+    srand(31524744);
+
+    KisSequentialIterator it(device, rect);
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), cs->pixelSize());
+    }
+}
+
+}
+
+void KisDisplayPipelineTest::testPipeline_data()
+{
+    QTest::addColumn<QString>("depthId");
+
+    QTest::newRow("U8") << Integer8BitsColorDepthID.id();
+    QTest::newRow("U16") << Integer16BitsColorDepthID.id();
+    QTest::newRow("F16") << Float16BitsColorDepthID.id();
+    QTest::newRow("F32") << Float32BitsColorDepthID.id();
+}
+
+void KisDisplayPipelineTest::testPipeline()
+{
+    QFETCH(QString, depthId);
+
+    const KoColorSpace *srcColorSpace = rgbaColorSpace(KoID(depthId));
+    if (!srcColorSpace) {
+        QSKIP("The color space is not available in this build");
+    }
+
+    const KoColorSpace *floatColorSpace = rgbaColorSpace(Float32BitsColorDepthID);
+    const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent();
+    const KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags();
+
+    QSharedPointer<KisDisplayFilter> filter(new TestDisplayFilter(1.5, 2.2));
+
+    // the rect is not aligned to the tiles of the device
+    const QRect rect(37, 45, 301, 219);
+    const int numPixels = rect.width() * rect.height();
+
+    KisPaintDeviceSP device = new KisPaintDevice(srcColorSpace);
+    fillRandomPixels(device, rect);
+
+    // the reference: every stage in its own full-size buffer
+    QVector<quint8> srcPixels(numPixels * srcColorSpace->pixelSize());
+    device->readBytes(srcPixels.data(), rect);
+
+    QVector<quint8> floatPixels(numPixels * floatColorSpace->pixelSize());
+    srcColorSpace->convertPixelsTo(srcPixels.data(), floatPixels.data(), floatColorSpace,
+                                   numPixels, renderingIntent, conversionFlags);
+    filter->filter(floatPixels.data(), numPixels);
+
+    QVector<quint8> refPixels(numPixels * dstColorSpace->pixelSize());
+    floatColorSpace->convertPixelsTo(floatPixels.data(), refPixels.data(), dstColorSpace,
+                                     numPixels, renderingIntent, conversionFlags);
+
+    KisDisplayPipeline pipeline(srcColorSpace, filter, floatColorSpace, floatColorSpace, dstColorSpace,
+                                renderingIntent, conversionFlags);
+
+    QVector<quint8> devicePixels(refPixels.size());
+    pipeline.apply(device, rect, devicePixels.data());
+    QVERIFY(devicePixels == refPixels);
+
+    QVector<quint8> bufferPixels(refPixels.size());
+    pipeline.apply(srcPixels.data(), bufferPixels.data(), numPixels);
+    QVERIFY(bufferPixels == refPixels);
+}
+
+void KisDisplayPipelineTest::testInPlace()
+{
+    const KoColorSpace *floatColorSpace = rgbaColorSpace(Float32BitsColorDepthID);
+    const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb16();
+
+    QSharedPointer<KisDisplayFilter> filter(new TestDisplayFilter(-0.5, 1.8));
+
+    // more than one block to check that the blocks don't overlap
+    const QRect rect(0, 0, 150, 100);
+    const int numPixels = rect.width() * rect.height();
+    QVERIFY(numPixels > KisDisplayPipeline::blockSize());
+
+    KisPaintDeviceSP device = new KisPaintDevice(floatColorSpace);
+    fillRandomPixels(device, rect);
+
+    QVector<quint8> pixels(numPixels * floatColorSpace->pixelSize());
+    device->readBytes(pixels.data(), rect);
+
+    QVector<quint8> refPixels(numPixels * dstColorSpace->pixelSize());
+    {
+        QVector<quint8> floatPixels(pixels);
+        filter->filter(floatPixels.data(), numPixels);
+        floatColorSpace->convertPixelsTo(floatPixels.data(), refPixels.data(), dstColorSpace, numPixels,
+                                         KoColorConversionTransformation::internalRenderingIntent(),
+                                         KoColorConversionTransformation::internalConversionFlags());
+    }
+
+    KisDisplayPipeline pipeline(floatColorSpace, filter, floatColorSpace, floatColorSpace, dstColorSpace);
+    pipeline.apply(pixels.data(), pixels.data(), numPixels);
+
+    QVERIFY(memcmp(pixels.data(), refPixels.data(), refPixels.size()) == 0);
+}
+
+SIMPLE_TEST_MAIN(KisDisplayPipelineTest)
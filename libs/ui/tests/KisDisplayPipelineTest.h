@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISDISPLAYPIPELINETEST_H
+#define KISDISPLAYPIPELINETEST_H
+
+#include <QObject>
+
+class KisDisplayPipelineTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPipeline_data();
+    void testPipeline();
+    void testInPlace();
+};
+
+#endif // KISDISPLAYPIPELINETEST_H
@@ -24,9 +24,25 @@
 
 
 #include "KisFrameCacheStore.h"
+#include "KisCompressedFrameCacheSwapper.h"
 
 static const int maxTileSize = 256;
 
+void initUpdateInfoBuilder(KisOpenGLUpdateInfoBuilder &builder, KisTextureTileInfoPoolSP pool)
+{
+    builder.setTextureInfoPool(pool);
+
+    const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    builder.setConversionOptions(
+        ConversionOptions(dstColorSpace,
+                          KoColorConversionTransformation::internalRenderingIntent(),
+                          KoColorConversionTransformation::internalConversionFlags()));
+
+    // TODO: refactor setting texture size in raw values!
+    builder.setTextureBorder(8);
+    builder.setEffectiveTextureSize(QSize(256 - 16, 256 - 16));
+}
+
 bool compareTextureTileUpdateInfo(KisTextureTileUpdateInfoSP tile1, KisTextureTileUpdateInfoSP tile2)
 {
     KIS_COMPARE_RF(tile1->patchLevelOfDetail(), tile2->patchLevelOfDetail());
@@ -97,17 +113,7 @@ public:
     TestFramesRenderer()
         : m_pool(m_poolRegistry.getPool(maxTileSize, maxTileSize))
     {
-        m_updateInfoBuilder.setTextureInfoPool(m_pool);
-
-        const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb8();
-        m_updateInfoBuilder.setConversionOptions(
-            ConversionOptions(dstColorSpace,
-                              KoColorConversionTransformation::internalRenderingIntent(),
-                              KoColorConversionTransformation::internalConversionFlags()));
-
-        // TODO: refactor setting texture size in raw values!
-        m_updateInfoBuilder.setTextureBorder(8);
-        m_updateInfoBuilder.setEffectiveTextureSize(QSize(256 - 16, 256 - 16));
+        initUpdateInfoBuilder(m_updateInfoBuilder, m_pool);
 
         connect(this, SIGNAL(sigCompleteRegenerationInternal(int)), SLOT(notifyFrameCompleted(int)));
         connect(this, SIGNAL(sigCancelRegenerationInternal(int, CancelReason)), SLOT(notifyFrameCancelled(int, CancelReason)));
@@ -180,6 +186,60 @@ void KisFrameCacheStoreTest::test()
 
 }
 
+void KisFrameCacheStoreTest::testCompressedSwapper()
+{
+    const QRect bounds(0,0,512,512);
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisTextureTileInfoPoolRegistry poolRegistry;
+    KisOpenGLUpdateInfoBuilder builder;
+    initUpdateInfoBuilder(builder, poolRegistry.getPool(maxTileSize, maxTileSize));
+
+    KisPaintDeviceSP base = new KisPaintDevice(cs);
+    base->fill(QRect(100,100,300,300), KoColor(Qt::red, cs));
+
+    KisPaintDeviceSP changed = new KisPaintDevice(*base);
+    changed->fill(QRect(120,120,10,10), KoColor(Qt::blue, cs));
+
+    KisPaintDeviceSP different = new KisPaintDevice(cs);
+    different->fill(bounds, KoColor(Qt::green, cs));
+
+    // keyframe, diff frame, diff frame with no changed tiles, new keyframe
+    const QVector<KisPaintDeviceSP> devices({base, changed, base, different});
+
+    KisCompressedFrameCacheSwapper swapper(builder);
+
+    for (int i = 0; i < devices.size(); i++) {
+        swapper.saveFrame(i, builder.buildUpdateInfo(bounds, devices[i], bounds, 0, true), bounds);
+        QVERIFY(swapper.hasFrame(i));
+        QCOMPARE(swapper.frameDirtyRect(i), bounds);
+    }
+
+    KisCompressedFrameCacheSwapper::Statistics stats = swapper.statistics();
+    QCOMPARE(stats.numFrames, 4);
+    QCOMPARE(stats.numKeyframes, 2);
+    QVERIFY(stats.compressedSize < stats.rawSize / 4);
+    QVERIFY(swapper.memoryUsage() >= stats.compressedSize);
+
+    // load out of order to make the swapper switch the keyframes
+    Q_FOREACH (int i, QVector<int>({3, 1, 0, 2, 1})) {
+        KisOpenGLUpdateInfoSP refInfo = builder.buildUpdateInfo(bounds, devices[i], bounds, 0, true);
+        QVERIFY(compareUpdateInfo(refInfo, swapper.loadFrame(i)));
+    }
+
+    // the diff frames should survive removal of their keyframe
+    swapper.forgetFrame(0);
+    swapper.moveFrame(1, 10);
+
+    QVERIFY(!swapper.hasFrame(0));
+    QVERIFY(!swapper.hasFrame(1));
+    QVERIFY(swapper.hasFrame(10));
+    QCOMPARE(swapper.statistics().numFrames, 3);
+
+    KisOpenGLUpdateInfoSP refInfo = builder.buildUpdateInfo(bounds, changed, bounds, 0, true);
+    QVERIFY(compareUpdateInfo(refInfo, swapper.loadFrame(10)));
+}
+
 SIMPLE_TEST_MAIN(KisFrameCacheStoreTest)
 
 #include "KisFrameCacheStoreTest.moc"
@@ -13,6 +13,7 @@ class KisFrameCacheStoreTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void test();
+    void testCompressedSwapper();
 };
 
 #endif // KISFRAMECACHESTORETEST_H
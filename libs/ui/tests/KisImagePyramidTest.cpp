@@ -0,0 +1,130 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisImagePyramidTest.h"
+
+#include <simpletest.h>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_device.h>
+#include <kis_paint_layer.h>
+#include <kis_iterator_ng.h>
+
+#include "canvas/kis_image_pyramid.h"
+
+
+namespace {
+
+const int s_pyramidHeight = 4;
+
+/**
+ * The reference 2x2 box downsampling, the pixels outside the
+ * source image are transparent
+ */
+QImage downsample(const QImage &src)
+{
+    QImage dst((src.width() + 1) / 2, (src.height() + 1) / 2, QImage::Format_ARGB32);
+
+    for (int y = 0; y < dst.height(); y++) {
+        for (int x = 0; x < dst.width(); x++) {
+            int sum[4] = {0, 0, 0, 0};
+
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    const int srcX = 2 * x + dx;
+                    const int srcY = 2 * y + dy;
+                    if (srcX >= src.width() || srcY >= src.height()) continue;
+
+                    const quint8 *pixel = src.constScanLine(srcY) + srcX * 4;
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += pixel[c];
+                    }
+                }
+            }
+
+            quint8 *pixel = dst.scanLine(y) + x * 4;
+            for (int c = 0; c < 4; c++) {
+                pixel[c] = sum[c] / 4;
+            }
+        }
+    }
+
+    return dst;
+}
+
+void verifyLevels(KisImagePyramid &pyramid, KisImageSP image)
+{
+    const QRect bounds = image->bounds();
+
+    QImage reference(bounds.size(), QImage::Format_ARGB32);
+    image->projection()->readBytes(reference.bits(), bounds);
+
+    for (int level = 0; level < s_pyramidHeight; level++) {
+        if (level > 0) {
+            reference = downsample(reference);
+        }
+
+        const QImage result = pyramid.levelImage(level, QRect(QPoint(), reference.size()));
+        QCOMPARE(result, reference);
+    }
+}
+
+}
+
+void KisImagePyramidTest::testLevels_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("parallel") << 4;
+}
+
+void KisImagePyramidTest::testLevels()
+{
+    QFETCH(int, numThreads);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    // the size of the image is odd and not aligned to the tiles
+    KisImageSP image = new KisImage(0, 517, 389, cs, "pyramid test");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8, cs);
+    image->addNode(layer, image->rootLayer());
+
+    KoColor color(cs);
+    srand(31524744);
+
+    KisSequentialIterator it(layer->paintDevice(), image->bounds());
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), cs->pixelSize());
+    }
+
+    image->initialRefreshGraph();
+
+    KisImagePyramid pyramid(s_pyramidHeight);
+    pyramid.setMaxThreadCount(numThreads);
+    pyramid.setMonitorProfile(cs->profile(),
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+    pyramid.setImage(image);
+
+    verifyLevels(pyramid, image);
+
+    // the update touches only a few tiles of every level
+    const QRect dirtyRect(100, 70, 150, 90);
+    layer->paintDevice()->fill(dirtyRect, KoColor(Qt::red, cs));
+    layer->setDirty(dirtyRect);
+    image->waitForDone();
+
+    pyramid.updateCache(dirtyRect);
+
+    verifyLevels(pyramid, image);
+}
+
+SIMPLE_TEST_MAIN(KisImagePyramidTest)
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISIMAGEPYRAMIDTEST_H
+#define KISIMAGEPYRAMIDTEST_H
+
+#include <QObject>
+
+class KisImagePyramidTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLevels_data();
+    void testLevels();
+};
+
+#endif // KISIMAGEPYRAMIDTEST_H
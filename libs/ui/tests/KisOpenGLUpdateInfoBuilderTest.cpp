@@ -0,0 +1,92 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisOpenGLUpdateInfoBuilderTest.h"
+
+#include <simpletest.h>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_iterator_ng.h>
+
+#include "opengl/KisOpenGLUpdateInfoBuilder.h"
+#include "opengl/kis_texture_tile_update_info.h"
+
+#include "kis_update_info.h"
+
+
+void KisOpenGLUpdateInfoBuilderTest::testConversion_data()
+{
+    QTest::addColumn<QString>("colorSpace");
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("rgb8-serial") << "rgb8" << 1;
+    QTest::newRow("rgb8-parallel") << "rgb8" << 4;
+    QTest::newRow("rgb16-serial") << "rgb16" << 1;
+    QTest::newRow("rgb16-parallel") << "rgb16" << 4;
+    QTest::newRow("lab16-serial") << "lab16" << 1;
+    QTest::newRow("lab16-parallel") << "lab16" << 4;
+}
+
+void KisOpenGLUpdateInfoBuilderTest::testConversion()
+{
+    QFETCH(QString, colorSpace);
+    QFETCH(int, numThreads);
+
+    const KoColorSpace *srcColorSpace =
+        colorSpace == "rgb16" ? KoColorSpaceRegistry::instance()->rgb16() :
+        colorSpace == "lab16" ? KoColorSpaceRegistry::instance()->lab16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    const KoColorSpace *dstColorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent();
+    const KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags();
+
+    // the bounds are not aligned to the tiles neither of the device nor of the textures
+    const QRect bounds(0, 0, 613, 517);
+    const QRect updateRect(37, 45, 501, 419);
+
+    KisPaintDeviceSP device = new KisPaintDevice(srcColorSpace);
+
+    KoColor color(srcColorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(device, bounds);
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), srcColorSpace->pixelSize());
+    }
+
+    KisOpenGLUpdateInfoBuilder builder;
+    builder.setTextureInfoPool(toQShared(new KisTextureTileInfoPool(256, 256)));
+    builder.setConversionOptions(ConversionOptions(dstColorSpace, renderingIntent, conversionFlags));
+    builder.setTextureBorder(4);
+    builder.setEffectiveTextureSize(QSize(248, 248));
+    builder.setMaxThreadCount(numThreads);
+
+    KisOpenGLUpdateInfoSP info = builder.buildUpdateInfo(updateRect, device, bounds, 0, true);
+
+    QCOMPARE(info->tileList.size(), 6);
+
+    Q_FOREACH (KisTextureTileUpdateInfoSP tileInfo, info->tileList) {
+        const QRect patchRect = tileInfo->realPatchRect();
+        const int numPixels = patchRect.width() * patchRect.height();
+
+        QVector<quint8> srcPixels(numPixels * srcColorSpace->pixelSize());
+        device->readBytes(srcPixels.data(), patchRect);
+
+        QVector<quint8> refPixels(numPixels * dstColorSpace->pixelSize());
+        srcColorSpace->convertPixelsTo(srcPixels.data(), refPixels.data(), dstColorSpace,
+                                       numPixels, renderingIntent, conversionFlags);
+
+        QCOMPARE(tileInfo->patchColorSpace(), dstColorSpace);
+        QVERIFY(memcmp(tileInfo->data(), refPixels.data(), refPixels.size()) == 0);
+    }
+}
+
+SIMPLE_TEST_MAIN(KisOpenGLUpdateInfoBuilderTest)
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISOPENGLUPDATEINFOBUILDERTEST_H
+#define KISOPENGLUPDATEINFOBUILDERTEST_H
+
+#include <QObject>
+
+class KisOpenGLUpdateInfoBuilderTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testConversion_data();
+    void testConversion();
+};
+
+#endif // KISOPENGLUPDATEINFOBUILDERTEST_H
@@ -12,6 +12,7 @@
 #include <QImage>
 
 #include <KoZoomHandler.h>
+#include <KoColor.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoCompositeOp.h>
 #include <KoColorSpaceConstants.h>
@@ -413,6 +414,65 @@ void KisPrescaledProjectionTest::testUpdates()
                                   "zoom50", 1));
 }
 
+void KisPrescaledProjectionTest::testZoomedOutUpdates_data()
+{
+    QTest::addColumn<qreal>("zoom");
+
+    QTest::newRow("zoom50") << 0.5;
+    QTest::newRow("zoom25") << 0.25;
+    QTest::newRow("zoom20") << 0.2;
+}
+
+void KisPrescaledProjectionTest::testZoomedOutUpdates()
+{
+    QFETCH(qreal, zoom);
+
+    const QSize canvasSize(300, 300);
+
+    PrescaledProjectionTester t;
+
+    t.converter.setDocumentOffset(QPoint(0,0));
+    t.converter.setCanvasWidgetSize(canvasSize);
+    t.projection.notifyCanvasSizeChanged(canvasSize);
+
+    t.converter.setZoom(zoom);
+    t.projection.notifyZoomChanged();
+
+    const KoColorSpace *cs = t.layer->paintDevice()->colorSpace();
+    const QRect dirtyRect(37, 53, 91, 67);
+    const QPoint dirtyCenter =
+        t.converter.imageToViewport(QPointF(dirtyRect.center())).toPoint();
+
+    /**
+     * The same area is painted twice, the second update must reach
+     * the canvas even though the level has already been generated
+     * for the first one
+     */
+    const QList<QColor> colors({Qt::red, Qt::blue});
+
+    Q_FOREACH (const QColor &color, colors) {
+        t.layer->paintDevice()->fill(dirtyRect, KoColor(color, cs));
+        t.layer->setDirty(dirtyRect);
+        t.image->waitForDone();
+
+        KisUpdateInfoSP info = t.projection.updateCache(dirtyRect);
+        t.projection.recalculateCache(info);
+
+        const QImage result = t.projection.prescaledQImage();
+        QCOMPARE(QColor(result.pixel(dirtyCenter)), color);
+
+        // the projection rendered from scratch at the same zoom
+        KisPrescaledProjection referenceProjection;
+        referenceProjection.setCoordinatesConverter(&t.converter);
+        referenceProjection.setDisplayConfig(KisDisplayConfig());
+        referenceProjection.setImage(t.image);
+        referenceProjection.notifyCanvasSizeChanged(canvasSize);
+
+        QPoint pt;
+        QVERIFY(TestUtil::compareQImages(pt, result, referenceProjection.prescaledQImage(), 1, 1));
+    }
+}
+
 void KisPrescaledProjectionTest::testQtScaling()
 {
     // See: https://bugreports.qt.nokia.com/browse/QTBUG-22827
@@ -44,6 +44,9 @@ private Q_SLOTS:
     void testScrollingZoom50();
     void testUpdates();
 
+    void testZoomedOutUpdates_data();
+    void testZoomedOutUpdates();
+
     void testQtScaling();
 };
 
@@ -17,6 +17,7 @@
 #include "kis_config.h"
 #include "kis_config_notifier.h"
 #include "KisImageConfigNotifier.h"
+#include "kis_update_time_monitor.h"
 
 
 Q_GLOBAL_STATIC(KisStrokeSpeedMonitor, s_instance)
@@ -89,12 +90,15 @@ void KisStrokeSpeedMonitor::resetAccumulatedValues()
     m_d->avgCursorSpeed.reset(m_d->averageWindow);
     m_d->avgRenderingSpeed.reset(m_d->averageWindow);
     m_d->avgFps.reset(m_d->averageWindow);
+
+    KisUpdateTimeMonitor::instance()->resetLatencyStatistics();
 }
 
 void KisStrokeSpeedMonitor::slotConfigChanged()
 {
     KisConfig cfg(true);
     m_d->haveStrokeSpeedMeasurement = cfg.enableBrushSpeedLogging();
+    KisUpdateTimeMonitor::instance()->setLatencyTrackingEnabled(m_d->haveStrokeSpeedMeasurement);
     resetAccumulatedValues();
     Q_EMIT sigStatsUpdated();
 }
@@ -13,6 +13,8 @@
 #include <kis_assert.h>
 
 #include "LcmsColorSpace.h"
+#include "LcmsMatrixShaperConversion.h"
+#include "LcmsTransformDiskCache.h"
 
 // -- KoLcmsColorConversionTransformation --
 
@@ -37,12 +39,12 @@ public:
         }
         conversionFlags |= KoColorConversionTransformation::CopyAlpha;
 
-        m_transform = cmsCreateTransform(srcProfile->lcmsProfile(),
-                                         srcColorSpaceType,
-                                         dstProfile->lcmsProfile(),
-                                         dstColorSpaceType,
-                                         renderingIntent,
-                                         conversionFlags);
+        m_transform = LcmsTransformDiskCache::instance()->createTransform(srcProfile,
+                                                                          srcColorSpaceType,
+                                                                          dstProfile,
+                                                                          dstColorSpaceType,
+                                                                          renderingIntent,
+                                                                          conversionFlags);
 
         Q_ASSERT(m_transform);
     }
@@ -255,6 +257,16 @@ KoColorConversionTransformation *IccColorSpaceEngine::createColorTransformation(
     KIS_ASSERT(dynamic_cast<const IccColorProfile *>(srcColorSpace->profile()));
     KIS_ASSERT(dynamic_cast<const IccColorProfile *>(dstColorSpace->profile()));
 
+    KoColorConversionTransformation *fastConversion =
+        createLcmsMatrixShaperConversion(srcColorSpace,
+                                         dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(),
+                                         dstColorSpace,
+                                         dynamic_cast<const IccColorProfile *>(dstColorSpace->profile())->asLcms(),
+                                         renderingIntent, conversionFlags);
+    if (fastConversion) {
+        return fastConversion;
+    }
+
     return new KoLcmsColorConversionTransformation(
                 srcColorSpace, computeColorSpaceType(srcColorSpace),
                 dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(), dstColorSpace, computeColorSpaceType(dstColorSpace),
@@ -344,3 +356,16 @@ bool IccColorSpaceEngine::supportsColorSpace(const QString &colorModelId, const
     Q_UNUSED(colorDepthId);
     return colorModelId != RGBAColorModelID.id() || !profile || profile->name() != "High Dynamic Range UHDTV Wide Color Gamut Display (Rec. 2020) - SMPTE ST 2084 PQ EOTF";
 }
+
+KoColorSpaceEngine::TransformCacheStatistics IccColorSpaceEngine::transformCacheStatistics() const
+{
+    const LcmsTransformDiskCache::Statistics diskStats = LcmsTransformDiskCache::instance()->statistics();
+
+    TransformCacheStatistics stats;
+    stats.hits = diskStats.hits;
+    stats.misses = diskStats.misses;
+    stats.loadTime = diskStats.loadTime;
+    stats.savedTime = diskStats.savedTime;
+
+    return stats;
+}
@@ -33,6 +33,8 @@ public:
     quint32 computeColorSpaceType(const KoColorSpace *cs) const;
 
     bool supportsColorSpace(const QString& colorModelId, const QString& colorDepthId, const KoColorProfile *profile) const override;
+
+    TransformCacheStatistics transformCacheStatistics() const override;
 private:
     struct Private;
     Private *const d;
@@ -0,0 +1,300 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "LcmsMatrixShaperConversion.h"
+
+#include <cmath>
+
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+#include <KoOptimizedRgbShaperConversionFactory.h>
+
+#include "LcmsColorProfileContainer.h"
+
+namespace {
+
+/**
+ * The number of samples used for tabulated source curves of 16-bit
+ * and floating point color spaces. With linear
+ * interpolation it keeps the error of sRGB-like curves well
+ * below one step of a 16-bit channel.
+ */
+const int numTableSamples = 16384;
+
+bool readColorantMatrix(cmsHPROFILE profile, double m[9])
+{
+    const cmsCIEXYZ *red = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigRedColorantTag));
+    const cmsCIEXYZ *green = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigGreenColorantTag));
+    const cmsCIEXYZ *blue = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigBlueColorantTag));
+
+    if (!red || !green || !blue) return false;
+
+    m[0] = red->X; m[1] = green->X; m[2] = blue->X;
+    m[3] = red->Y; m[4] = green->Y; m[5] = blue->Y;
+    m[6] = red->Z; m[7] = green->Z; m[8] = blue->Z;
+
+    return true;
+}
+
+bool invertMatrix(const double m[9], double result[9])
+{
+    const double det =
+        m[0] * (m[4] * m[8] - m[5] * m[7]) -
+        m[1] * (m[3] * m[8] - m[5] * m[6]) +
+        m[2] * (m[3] * m[7] - m[4] * m[6]);
+
+    if (std::fabs(det) < 1e-9) return false;
+
+    result[0] =  (m[4] * m[8] - m[5] * m[7]) / det;
+    result[1] = -(m[1] * m[8] - m[2] * m[7]) / det;
+    result[2] =  (m[1] * m[5] - m[2] * m[4]) / det;
+    result[3] = -(m[3] * m[8] - m[5] * m[6]) / det;
+    result[4] =  (m[0] * m[8] - m[2] * m[6]) / det;
+    result[5] = -(m[0] * m[5] - m[2] * m[3]) / det;
+    result[6] =  (m[3] * m[7] - m[4] * m[6]) / det;
+    result[7] = -(m[0] * m[7] - m[1] * m[6]) / det;
+    result[8] =  (m[0] * m[4] - m[1] * m[3]) / det;
+
+    return true;
+}
+
+KoShaperCurve sampleToneCurve(const cmsToneCurve *curve, int numSamples)
+{
+    QVector<float> samples(numSamples);
+    for (int i = 0; i < numSamples; i++) {
+        samples[i] = cmsEvalToneCurveFloat(curve, float(i) / (numSamples - 1));
+    }
+
+    return KoShaperCurve::table(samples);
+}
+
+/**
+ * Reads a linear or a parametric LCMS tone curve into \p result.
+ * Returns false for the curves that can only be sampled.
+ */
+bool readAnalyticToneCurve(const cmsToneCurve *curve, KoShaperCurve *result)
+{
+    if (cmsIsToneCurveLinear(curve)) {
+        *result = KoShaperCurve::linear();
+        return true;
+    }
+
+#if LCMS_VERSION >= 2080
+    const cmsFloat64Number *p = cmsGetToneCurveParams(curve);
+
+    if (p) {
+        switch (cmsGetToneCurveParametricType(curve)) {
+        case 1: // Y = X^g
+            *result = KoShaperCurve::parametric(p[0], 1.0, 0.0, 0.0, 0.0);
+            return true;
+        case 2: // Y = (aX + b)^g, X >= -b/a;  Y = 0, X < -b/a
+            if (p[1] == 0.0) break;
+            *result = KoShaperCurve::parametric(p[0], p[1], p[2], 0.0, -p[2] / p[1]);
+            return true;
+        case 3: // Y = (aX + b)^g + c, X >= -b/a;  Y = c, X < -b/a
+            if (p[1] == 0.0) break;
+            *result = KoShaperCurve::parametric(p[0], p[1], p[2], 0.0, -p[2] / p[1], p[3], p[3]);
+            return true;
+        case 4: // Y = (aX + b)^g, X >= d;  Y = cX, X < d
+            *result = KoShaperCurve::parametric(p[0], p[1], p[2], p[3], p[4]);
+            return true;
+        case 5: // Y = (aX + b)^g + e, X >= d;  Y = cX + f, X < d
+            *result = KoShaperCurve::parametric(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+            return true;
+        default:
+            break;
+        }
+    }
+#endif
+
+    return false;
+}
+
+/**
+ * Converts an LCMS tone curve into KoShaperCurve. Parametric curves
+ * are converted directly, other curves are sampled into a table with
+ * \p numSamples entries.
+ */
+KoShaperCurve convertToneCurve(const cmsToneCurve *curve, int numSamples)
+{
+    KoShaperCurve result;
+
+    if (!readAnalyticToneCurve(curve, &result)) {
+        result = sampleToneCurve(curve, numSamples);
+    }
+
+    return result;
+}
+
+/**
+ * Creates the inverse of an LCMS tone curve. The inverse of the
+ * parametric form is expressible in the same form:
+ *
+ * x = 1/a * ((y - e) / s)^(1/g) - b/a,  y >= s * (a*d + b)^g + e
+ * x = (y - f) / c,                      y <  s * (a*d + b)^g + e
+ *
+ * Tabulated curves are not inverted: the slope of the inverse is
+ * very steep near black, where a uniformly sampled table loses too
+ * much precision. Returns false for them, so the conversion is left
+ * to LCMS.
+ */
+bool invertToneCurve(const cmsToneCurve *lcmsCurve, KoShaperCurve *result)
+{
+    KoShaperCurve curve;
+
+    if (!readAnalyticToneCurve(lcmsCurve, &curve)) {
+        return false;
+    }
+
+    if (curve.type == KoShaperCurve::Linear) {
+        *result = KoShaperCurve::linear();
+        return true;
+    }
+
+    if (curve.a == 0.0f || curve.g == 0.0f || curve.s == 0.0f) {
+        return false;
+    }
+
+    const float threshold =
+        curve.s * std::pow(qMax(0.0f, curve.a * curve.d + curve.b), curve.g) + curve.e;
+
+    const float linearSlope = curve.c != 0.0f ? 1.0f / curve.c : 0.0f;
+    const float linearOffset = curve.c != 0.0f ? -curve.f / curve.c : curve.d;
+
+    *result = KoShaperCurve::parametric(1.0f / curve.g,
+                                        1.0f / curve.s,
+                                        -curve.e / curve.s,
+                                        linearSlope,
+                                        threshold,
+                                        -curve.b / curve.a,
+                                        linearOffset,
+                                        1.0f / curve.a);
+    return true;
+}
+
+/**
+ * For 8-bit color spaces the table has exactly one sample per
+ * channel value, so the lookup is exact
+ */
+int numSourceSamples(const KoColorSpace *cs)
+{
+    if (cs->colorDepthId() == Integer8BitsColorDepthID) {
+        return 256;
+    }
+
+    return numTableSamples;
+}
+
+bool isV4Profile(const LcmsColorProfileContainer *profile)
+{
+    return cmsGetEncodedICCversion(profile->lcmsProfile()) >= 0x4000000;
+}
+
+bool isMatrixShaperRgb(const LcmsColorProfileContainer *profile,
+                       KoColorConversionTransformation::Intent renderingIntent,
+                       cmsUInt32Number direction)
+{
+    return profile->colorSpaceSignature() == cmsSigRgbData &&
+        cmsIsMatrixShaper(profile->lcmsProfile()) &&
+        !cmsIsCLUT(profile->lcmsProfile(), renderingIntent, direction);
+}
+
+const cmsToneCurve *readToneCurve(const LcmsColorProfileContainer *profile, int channel)
+{
+    static const cmsTagSignature tags[3] = {cmsSigRedTRCTag, cmsSigGreenTRCTag, cmsSigBlueTRCTag};
+    return static_cast<const cmsToneCurve*>(cmsReadTag(profile->lcmsProfile(), tags[channel]));
+}
+
+}
+
+KoColorConversionTransformation *createLcmsMatrixShaperConversion(const KoColorSpace *srcColorSpace,
+                                                                  const LcmsColorProfileContainer *srcProfile,
+                                                                  const KoColorSpace *dstColorSpace,
+                                                                  const LcmsColorProfileContainer *dstProfile,
+                                                                  KoColorConversionTransformation::Intent renderingIntent,
+                                                                  KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    if (!KoOptimizedRgbShaperConversionFactory::supportsColorSpaces(srcColorSpace, dstColorSpace)) return nullptr;
+
+    if (renderingIntent == KoColorConversionTransformation::IntentAbsoluteColorimetric ||
+        conversionFlags.testFlag(KoColorConversionTransformation::GamutCheck) ||
+        conversionFlags.testFlag(KoColorConversionTransformation::SoftProofing)) {
+
+        return nullptr;
+    }
+
+    /**
+     * LCMS always applies black point compensation to V4 profiles in
+     * perceptual and saturation intents, whatever the flags are. Its
+     * black point detection is not reproduced here, so leave these
+     * conversions to LCMS.
+     */
+    if ((renderingIntent == KoColorConversionTransformation::IntentPerceptual ||
+         renderingIntent == KoColorConversionTransformation::IntentSaturation) &&
+        (isV4Profile(srcProfile) || isV4Profile(dstProfile))) {
+
+        return nullptr;
+    }
+
+    if (!isMatrixShaperRgb(srcProfile, renderingIntent, LCMS_USED_AS_INPUT) ||
+        !isMatrixShaperRgb(dstProfile, renderingIntent, LCMS_USED_AS_OUTPUT)) {
+
+        return nullptr;
+    }
+
+    double srcMatrix[9];
+    double dstMatrix[9];
+    double dstMatrixInverted[9];
+
+    if (!readColorantMatrix(srcProfile->lcmsProfile(), srcMatrix) ||
+        !readColorantMatrix(dstProfile->lcmsProfile(), dstMatrix) ||
+        !invertMatrix(dstMatrix, dstMatrixInverted)) {
+
+        return nullptr;
+    }
+
+    KoRgbShaperConversionData data;
+
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            double value = 0.0;
+            for (int i = 0; i < 3; i++) {
+                value += dstMatrixInverted[row * 3 + i] * srcMatrix[i * 3 + col];
+            }
+            data.matrix[row * 3 + col] = value;
+        }
+    }
+
+    const int srcSamples = numSourceSamples(srcColorSpace);
+
+    for (int ch = 0; ch < 3; ch++) {
+        const cmsToneCurve *srcCurve = readToneCurve(srcProfile, ch);
+        const cmsToneCurve *dstCurve = readToneCurve(dstProfile, ch);
+
+        if (!srcCurve || !dstCurve) return nullptr;
+
+        /**
+         * LCMS detects black point of a matrix-shaper profile by
+         * converting the darkest colorant, so the compensation is
+         * a no-op only if both curves start at zero.
+         */
+        if (conversionFlags.testFlag(KoColorConversionTransformation::BlackpointCompensation) &&
+            (std::fabs(cmsEvalToneCurveFloat(srcCurve, 0.0f)) > 1e-6f ||
+             std::fabs(cmsEvalToneCurveFloat(dstCurve, 0.0f)) > 1e-6f)) {
+
+            return nullptr;
+        }
+
+        if (!invertToneCurve(dstCurve, &data.dstCurves[ch])) {
+            return nullptr;
+        }
+
+        data.srcCurves[ch] = convertToneCurve(srcCurve, srcSamples);
+    }
+
+    return KoOptimizedRgbShaperConversionFactory::create(srcColorSpace, dstColorSpace, data,
+                                                         renderingIntent, conversionFlags);
+}
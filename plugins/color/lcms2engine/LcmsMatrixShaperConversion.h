@@ -0,0 +1,33 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef LCMSMATRIXSHAPERCONVERSION_H
+#define LCMSMATRIXSHAPERCONVERSION_H
+
+#include <KoColorConversionTransformation.h>
+
+class LcmsColorProfileContainer;
+
+/**
+ * Creates a conversion between two RGB matrix-shaper profiles that
+ * does not go through LCMS (see KoOptimizedRgbShaperConversionFactory).
+ *
+ * The fast path is used only when the result is guaranteed to match
+ * the one of LCMS: both profiles are RGB matrix-shaper ones without
+ * CLUT tags for the requested intent, the intent is not absolute
+ * colorimetric, black point compensation (if requested) is a no-op,
+ * and the tone curves can be represented precisely enough.
+ *
+ * @return the conversion or nullptr if LCMS should be used instead
+ */
+KoColorConversionTransformation *createLcmsMatrixShaperConversion(const KoColorSpace *srcColorSpace,
+                                                                  const LcmsColorProfileContainer *srcProfile,
+                                                                  const KoColorSpace *dstColorSpace,
+                                                                  const LcmsColorProfileContainer *dstProfile,
+                                                                  KoColorConversionTransformation::Intent renderingIntent,
+                                                                  KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+#endif // LCMSMATRIXSHAPERCONVERSION_H
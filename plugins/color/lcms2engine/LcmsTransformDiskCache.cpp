@@ -0,0 +1,315 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "LcmsTransformDiskCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QGlobalStatic>
+#include <QMutex>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <DebugPigment.h>
+
+#include "colorprofiles/LcmsColorProfileContainer.h"
+
+namespace {
+
+/**
+ * Increase the version when the format of the cache entries
+ * or the way the transformations are built changes
+ */
+const quint32 cacheFormatVersion = 2;
+const quint32 cacheFileMagic = 0x4b435443; // "KCTC"
+
+QString defaultCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/colortransforms";
+}
+
+QByteArray cacheKey(const LcmsColorProfileContainer *srcProfile, cmsUInt32Number srcType,
+                    const LcmsColorProfileContainer *dstProfile, cmsUInt32Number dstType,
+                    cmsUInt32Number renderingIntent, cmsUInt32Number flags)
+{
+    QByteArray keyData;
+    QDataStream stream(&keyData, QIODevice::WriteOnly);
+
+    stream << cacheFormatVersion
+           << quint32(cmsGetEncodedCMMversion())
+           << srcProfile->rawDataHash() << quint32(srcType)
+           << dstProfile->rawDataHash() << quint32(dstType)
+           << quint32(renderingIntent) << quint32(flags)
+           << double(cmsSetAdaptationState(-1));
+
+    return QCryptographicHash::hash(keyData, QCryptographicHash::Sha1).toHex();
+}
+
+cmsHTRANSFORM createTransformFromLink(const QByteArray &linkData,
+                                      cmsUInt32Number srcType, cmsUInt32Number dstType,
+                                      cmsUInt32Number renderingIntent, cmsUInt32Number flags)
+{
+    cmsHPROFILE link = cmsOpenProfileFromMem(linkData.constData(), linkData.size());
+    if (!link) return nullptr;
+
+    /**
+     * Black point compensation has already been baked into the link,
+     * it should not be applied for the second time
+     */
+    cmsHTRANSFORM transform = cmsCreateTransform(link, srcType, nullptr, dstType,
+                                                 renderingIntent,
+                                                 flags & ~cmsFLAGS_BLACKPOINTCOMPENSATION);
+    cmsCloseProfile(link);
+
+    return transform;
+}
+
+QByteArray saveTransformToLink(cmsHTRANSFORM transform)
+{
+    QByteArray result;
+
+    cmsHPROFILE link = cmsTransform2DeviceLink(transform, 4.3, 0);
+    if (!link) return result;
+
+    cmsUInt32Number size = 0;
+    if (cmsSaveProfileToMem(link, nullptr, &size) && size > 0) {
+        result.resize(int(size));
+        if (!cmsSaveProfileToMem(link, result.data(), &size)) {
+            result.clear();
+        }
+    }
+
+    cmsCloseProfile(link);
+    return result;
+}
+
+}
+
+struct LcmsTransformDiskCache::Private
+{
+    QString cacheDirectory;
+    qint64 maxCacheSize = 0;
+
+    mutable QMutex statisticsMutex;
+    Statistics statistics;
+
+    /// serializes writing and pruning of the entries
+    QMutex storageMutex;
+
+    QString entryPath(const QByteArray &key) const {
+        return cacheDirectory + "/" + QString::fromLatin1(key) + ".kct";
+    }
+
+    bool loadEntry(const QString &path, QByteArray *linkData, qint64 *buildTime);
+    void storeEntry(const QString &path, const QByteArray &linkData, qint64 buildTime);
+    void pruneEntries();
+};
+
+bool LcmsTransformDiskCache::Private::loadEntry(const QString &path, QByteArray *linkData, qint64 *buildTime)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream stream(&file);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+
+    if (magic != cacheFileMagic || version != cacheFormatVersion) return false;
+
+    stream >> *buildTime >> *linkData;
+
+    if (stream.status() != QDataStream::Ok || linkData->isEmpty()) return false;
+
+    file.close();
+
+    // mark the entry as recently used, so that it would survive pruning
+    if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+
+    return true;
+}
+
+void LcmsTransformDiskCache::Private::storeEntry(const QString &path, const QByteArray &linkData, qint64 buildTime)
+{
+    QMutexLocker l(&storageMutex);
+
+    if (!QDir().mkpath(cacheDirectory)) {
+        warnPigment << "Failed to create color transformations cache directory" << cacheDirectory;
+        return;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    QDataStream stream(&file);
+    stream << cacheFileMagic << cacheFormatVersion << buildTime << linkData;
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        warnPigment << "Failed to write color transformation cache entry" << path;
+        return;
+    }
+
+    pruneEntries();
+}
+
+void LcmsTransformDiskCache::Private::pruneEntries()
+{
+    QDir dir(cacheDirectory);
+    const QFileInfoList entries =
+        dir.entryInfoList(QStringList() << "*.kct", QDir::Files, QDir::Time);
+
+    qint64 totalSize = 0;
+
+    Q_FOREACH (const QFileInfo &info, entries) {
+        totalSize += info.size();
+
+        if (totalSize > maxCacheSize) {
+            QFile::remove(info.absoluteFilePath());
+        }
+    }
+}
+
+Q_GLOBAL_STATIC_WITH_ARGS(LcmsTransformDiskCache, s_instance, (defaultCacheDirectory()))
+
+LcmsTransformDiskCache::LcmsTransformDiskCache(const QString &cacheDirectory, qint64 maxCacheSize)
+    : m_d(new Private)
+{
+    m_d->cacheDirectory = cacheDirectory;
+    m_d->maxCacheSize = maxCacheSize;
+}
+
+LcmsTransformDiskCache::~LcmsTransformDiskCache()
+{
+}
+
+LcmsTransformDiskCache *LcmsTransformDiskCache::instance()
+{
+    return s_instance;
+}
+
+bool LcmsTransformDiskCache::isCacheable(const LcmsColorProfileContainer *srcProfile, cmsUInt32Number srcType,
+                                         const LcmsColorProfileContainer *dstProfile, cmsUInt32Number dstType,
+                                         cmsUInt32Number renderingIntent, cmsUInt32Number flags)
+{
+    /**
+     * Device links store the pipeline in a 16-bit CLUT, which is
+     * not precise enough for floating point and unbounded data
+     */
+    if (T_FLOAT(srcType) || T_FLOAT(dstType)) return false;
+    if (flags & (cmsFLAGS_NOOPTIMIZE | cmsFLAGS_GAMUTCHECK | cmsFLAGS_SOFTPROOFING | cmsFLAGS_NULLTRANSFORM)) return false;
+
+    if (srcProfile->rawDataHash().isEmpty() ||
+        dstProfile->rawDataHash().isEmpty()) {
+
+        return false;
+    }
+
+    /**
+     * Pipelines of matrix-shaper profiles are optimized by LCMS
+     * almost instantly, loading a link would be slower
+     */
+    return cmsIsCLUT(srcProfile->lcmsProfile(), renderingIntent, LCMS_USED_AS_INPUT) ||
+        cmsIsCLUT(dstProfile->lcmsProfile(), renderingIntent, LCMS_USED_AS_OUTPUT);
+}
+
+cmsHTRANSFORM LcmsTransformDiskCache::createTransform(const LcmsColorProfileContainer *srcProfile, cmsUInt32Number srcType,
+                                                      const LcmsColorProfileContainer *dstProfile, cmsUInt32Number dstType,
+                                                      cmsUInt32Number renderingIntent, cmsUInt32Number flags)
+{
+    if (!isCacheable(srcProfile, srcType, dstProfile, dstType, renderingIntent, flags)) {
+        return cmsCreateTransform(srcProfile->lcmsProfile(), srcType,
+                                  dstProfile->lcmsProfile(), dstType,
+                                  renderingIntent, flags);
+    }
+
+    const QByteArray key = cacheKey(srcProfile, srcType, dstProfile, dstType, renderingIntent, flags);
+    const QString path = m_d->entryPath(key);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray linkData;
+    qint64 storedBuildTime = 0;
+
+    if (m_d->loadEntry(path, &linkData, &storedBuildTime)) {
+        cmsHTRANSFORM transform = createTransformFromLink(linkData, srcType, dstType, renderingIntent, flags);
+
+        if (transform) {
+            const qint64 loadTime = timer.nsecsElapsed();
+
+            dbgPigment << "Loaded cached color transformation" << key
+                       << "in" << loadTime / 1000000.0 << "ms,"
+                       << "building it took" << storedBuildTime / 1000000.0 << "ms";
+
+            QMutexLocker l(&m_d->statisticsMutex);
+            m_d->statistics.hits++;
+            m_d->statistics.loadTime += loadTime;
+            m_d->statistics.savedTime += qMax(qint64(0), storedBuildTime - loadTime);
+            return transform;
+        }
+
+        warnPigment << "Removing invalid color transformation cache entry" << path;
+        QFile::remove(path);
+        timer.restart();
+    }
+
+    cmsHTRANSFORM transform = cmsCreateTransform(srcProfile->lcmsProfile(), srcType,
+                                                 dstProfile->lcmsProfile(), dstType,
+                                                 renderingIntent, flags);
+    if (!transform) return transform;
+
+    const qint64 buildTime = timer.nsecsElapsed();
+
+    /**
+     * The freshly built transformation is returned as it is, only its
+     * device link is stored for the next sessions. The link is a
+     * resampled 16-bit CLUT, so using it right away would only lose
+     * precision.
+     */
+    linkData = saveTransformToLink(transform);
+
+    if (!linkData.isEmpty()) {
+        m_d->storeEntry(path, linkData, buildTime);
+    }
+
+    dbgPigment << "Built color transformation" << key
+               << "in" << buildTime / 1000000.0 << "ms";
+
+    QMutexLocker l(&m_d->statisticsMutex);
+    m_d->statistics.misses++;
+    m_d->statistics.buildTime += buildTime;
+
+    return transform;
+}
+
+LcmsTransformDiskCache::Statistics LcmsTransformDiskCache::statistics() const
+{
+    QMutexLocker l(&m_d->statisticsMutex);
+    return m_d->statistics;
+}
+
+QString LcmsTransformDiskCache::cacheDirectory() const
+{
+    return m_d->cacheDirectory;
+}
+
+void LcmsTransformDiskCache::clear()
+{
+    QMutexLocker l(&m_d->storageMutex);
+
+    QDir dir(m_d->cacheDirectory);
+    Q_FOREACH (const QString &entry, dir.entryList(QStringList() << "*.kct", QDir::Files)) {
+        dir.remove(entry);
+    }
+}
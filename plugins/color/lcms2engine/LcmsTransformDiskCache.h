@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef LCMSTRANSFORMDISKCACHE_H
+#define LCMSTRANSFORMDISKCACHE_H
+
+#include <QScopedPointer>
+#include <QString>
+
+#include <lcms2.h>
+
+class LcmsColorProfileContainer;
+
+/**
+ * @brief A disk-backed cache of LCMS transformations
+ *
+ * Building a transformation that involves a LUT-based profile (CMYK,
+ * Lab, printer profiles and so on) makes LCMS evaluate the whole
+ * pipeline for every node of a precalculated CLUT, which may take
+ * hundreds of milliseconds. The cache saves the optimized pipeline as
+ * a device link profile and creates the transformation from that link
+ * the next time the same pair of profiles is requested, even in a
+ * different session.
+ *
+ * The entries are keyed by the hashes of the raw data of both profiles,
+ * pixel formats, intent, flags, adaptation state and the version of
+ * LCMS, so a changed profile or library never reuses a stale link. The
+ * old entries are evicted when the cache grows over its size limit.
+ *
+ * On a cache miss the exact transformation built by LCMS is used, and
+ * its device link is only written to the disk. Transformations created
+ * from a cached link may differ from it by the precision of the 16-bit
+ * CLUT.
+ *
+ * The cache is thread-safe.
+ */
+class LcmsTransformDiskCache
+{
+public:
+    struct Statistics {
+        /// number of transformations created from a cached device link
+        int hits = 0;
+        /// number of cacheable transformations built from scratch
+        int misses = 0;
+        /// time spent on creating transformations from cached links (ns)
+        qint64 loadTime = 0;
+        /// time spent on building transformations from scratch (ns)
+        qint64 buildTime = 0;
+        /// time that would have been spent on building the transformations
+        /// created from the cached links (ns)
+        qint64 savedTime = 0;
+    };
+
+public:
+    explicit LcmsTransformDiskCache(const QString &cacheDirectory, qint64 maxCacheSize = 64 * 1024 * 1024);
+    ~LcmsTransformDiskCache();
+
+    static LcmsTransformDiskCache *instance();
+
+    /**
+     * @return true if the transformation is expensive enough to be
+     * cached and can be represented by a device link without losing
+     * precision
+     */
+    static bool isCacheable(const LcmsColorProfileContainer *srcProfile, cmsUInt32Number srcType,
+                            const LcmsColorProfileContainer *dstProfile, cmsUInt32Number dstType,
+                            cmsUInt32Number renderingIntent, cmsUInt32Number flags);
+
+    /**
+     * A drop-in replacement for cmsCreateTransform(). Non-cacheable
+     * transformations are created directly.
+     */
+    cmsHTRANSFORM createTransform(const LcmsColorProfileContainer *srcProfile, cmsUInt32Number srcType,
+                                  const LcmsColorProfileContainer *dstProfile, cmsUInt32Number dstType,
+                                  cmsUInt32Number renderingIntent, cmsUInt32Number flags);
+
+    Statistics statistics() const;
+
+    QString cacheDirectory() const;
+
+    /**
+     * Removes all the cached device links from the disk
+     */
+    void clear();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // LCMSTRANSFORMDISKCACHE_H
@@ -11,6 +11,7 @@
 
 #include "LcmsColorProfileContainer.h"
 
+#include <QCryptographicHash>
 #include <QGenericMatrix>
 #include <QTransform>
 #include <array>
@@ -102,6 +103,10 @@ public:
     bool isMatrixShaper;
 
     QByteArray uniqueId;
+
+    using LazyByteArray = KisLazyStorage<KisLazyValueWrapper<QByteArray>, std::function<QByteArray()>>;
+
+    LazyByteArray rawDataHash = LazyByteArray(LazyByteArray::init_value_tag{}, {});
 };
 
 LcmsColorProfileContainer::LcmsColorProfileContainer()
@@ -115,6 +120,9 @@ LcmsColorProfileContainer::LcmsColorProfileContainer(IccColorProfile::Data *data
 {
     d->data = data;
     d->profile = 0;
+    d->rawDataHash = Private::LazyByteArray([d = d] () {
+        return QCryptographicHash::hash(d->data->rawData(), QCryptographicHash::Sha1);
+    });
     init();
 }
 
@@ -627,6 +635,11 @@ QByteArray LcmsColorProfileContainer::getProfileUniqueId() const
     return d->uniqueId;
 }
 
+QByteArray LcmsColorProfileContainer::rawDataHash() const
+{
+    return *d->rawDataHash;
+}
+
 bool LcmsColorProfileContainer::compareTRC(TransferCharacteristics characteristics, float error) const
 {
     if (!*d->hasTRC) {
@@ -93,6 +93,14 @@ public:
     QString info() const override;
     QByteArray getProfileUniqueId() const override;
 
+    /**
+     * @return SHA-1 hash of the raw profile data. Unlike the profile
+     * ID in the header, which is often zero or not updated by the
+     * tools that edit the profile, it always identifies the content
+     * of the profile. The hash is calculated on the first call.
+     */
+    QByteArray rawDataHash() const;
+
     bool compareTRC(TransferCharacteristics characteristics, float error) const override;
 
     static cmsToneCurve* transferFunction(TransferCharacteristics transferFunction);
@@ -0,0 +1,200 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsMatrixShaperConversion.h"
+
+#include <simpletest.h>
+#include <testpigment.h>
+
+#include <lcms2.h>
+
+#include "kis_debug.h"
+
+#include "KoColorProfile.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformation.h"
+
+namespace {
+
+const int numPixels = 4096;
+
+cmsUInt32Number lcmsPixelType(const KoColorSpace *cs)
+{
+    const KoID depthId = cs->colorDepthId();
+
+    if (depthId == Integer8BitsColorDepthID) {
+        return TYPE_BGRA_8;
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return TYPE_BGRA_16;
+    } else if (depthId == Float16BitsColorDepthID) {
+        return TYPE_RGBA_HALF_FLT;
+    }
+
+    return TYPE_RGBA_FLT;
+}
+
+cmsHPROFILE lcmsProfile(const KoColorSpace *cs)
+{
+    const QByteArray rawData = cs->profile()->rawData();
+    return cmsOpenProfileFromMem(rawData.constData(), rawData.size());
+}
+
+QVector<quint8> generateSourcePixels(const KoColorSpace *cs)
+{
+    const KoColorSpace *rgb16 = KoColorSpaceRegistry::instance()->rgb16();
+
+    QVector<quint16> rgb16Data(numPixels * 4);
+    for (int i = 0; i < rgb16Data.size(); i++) {
+        rgb16Data[i] = quint16((i * 40503) ^ (i >> 3));
+    }
+
+    QVector<quint8> result(numPixels * cs->pixelSize());
+    rgb16->convertPixelsTo(reinterpret_cast<const quint8*>(rgb16Data.constData()), result.data(), cs, numPixels,
+                           KoColorConversionTransformation::internalRenderingIntent(),
+                           KoColorConversionTransformation::internalConversionFlags());
+    return result;
+}
+
+qreal tolerance(const KoColorSpace *cs)
+{
+    const KoID depthId = cs->colorDepthId();
+
+    if (depthId == Integer8BitsColorDepthID) {
+        return 1.01 / 255.0;
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return 1.01 / 65535.0;
+    } else if (depthId == Float16BitsColorDepthID) {
+        return 0.002;
+    }
+
+    return 0.001;
+}
+
+}
+
+void TestLcmsMatrixShaperConversion::testCompareWithLcms_data()
+{
+    QTest::addColumn<QString>("srcDepthID");
+    QTest::addColumn<QString>("srcProfile");
+    QTest::addColumn<QString>("dstDepthID");
+    QTest::addColumn<QString>("dstProfile");
+    QTest::addColumn<int>("intent");
+
+    const QString srgb = "sRGB-elle-V2-srgbtrc.icc";
+    const QString srgbV4 = "sRGB-elle-V4-srgbtrc.icc";
+    const QString linear = "sRGB-elle-V2-g10.icc";
+    const QString rec2020 = "Rec2020-elle-V4-g10.icc";
+    const QString wide = "WideRGB-elle-V2-g22.icc";
+
+    const int perceptual = KoColorConversionTransformation::IntentPerceptual;
+    const int relative = KoColorConversionTransformation::IntentRelativeColorimetric;
+
+    QTest::newRow("srgb U8 -> srgb U16") << "U8" << srgb << "U16" << srgb << perceptual;
+    QTest::newRow("srgb U16 -> srgb U8") << "U16" << srgb << "U8" << srgb << perceptual;
+    QTest::newRow("srgb U8 -> srgb F32") << "U8" << srgb << "F32" << srgb << perceptual;
+    QTest::newRow("srgb F32 -> srgb U16") << "F32" << srgb << "U16" << srgb << perceptual;
+    QTest::newRow("srgb U8 -> srgb F16") << "U8" << srgb << "F16" << srgb << perceptual;
+    QTest::newRow("srgb U8 -> linear F32") << "U8" << srgb << "F32" << linear << perceptual;
+    QTest::newRow("linear F32 -> srgb U8") << "F32" << linear << "U8" << srgb << perceptual;
+    QTest::newRow("linear F32 -> srgb v4 U16") << "F32" << linear << "U16" << srgbV4 << relative;
+    QTest::newRow("srgb v4 U16 -> rec2020 F32") << "U16" << srgbV4 << "F32" << rec2020 << relative;
+    QTest::newRow("rec2020 F32 -> wide U16") << "F32" << rec2020 << "U16" << wide << relative;
+    QTest::newRow("wide U16 -> srgb U16") << "U16" << wide << "U16" << srgb << perceptual;
+
+    // V4 profiles in perceptual intent are converted by LCMS itself
+    QTest::newRow("srgb v4 F32 -> rec2020 F32") << "F32" << srgbV4 << "F32" << rec2020 << perceptual;
+    QTest::newRow("wide U8 -> srgb U8") << "U8" << wide << "U8" << srgb << relative;
+}
+
+void TestLcmsMatrixShaperConversion::testCompareWithLcms()
+{
+    QFETCH(QString, srcDepthID);
+    QFETCH(QString, srcProfile);
+    QFETCH(QString, dstDepthID);
+    QFETCH(QString, dstProfile);
+    QFETCH(int, intent);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), srcDepthID, srcProfile);
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), dstDepthID, dstProfile);
+
+    if (!srcCs || !dstCs) {
+        QSKIP("The color space is not available on this system");
+    }
+
+    const KoColorConversionTransformation::Intent renderingIntent =
+        KoColorConversionTransformation::Intent(intent);
+    KoColorConversionTransformation::ConversionFlags flags =
+        KoColorConversionTransformation::internalConversionFlags();
+
+    const QVector<quint8> srcData = generateSourcePixels(srcCs);
+    QVector<quint8> dstData(numPixels * dstCs->pixelSize());
+    QVector<quint8> refData(numPixels * dstCs->pixelSize());
+
+    QScopedPointer<KoColorConversionTransformation> transform(
+        KoColorSpaceRegistry::instance()->createColorConverter(srcCs, dstCs, renderingIntent, flags));
+    transform->transform(srcData.constData(), dstData.data(), numPixels);
+
+    cmsHPROFILE srcLcmsProfile = lcmsProfile(srcCs);
+    cmsHPROFILE dstLcmsProfile = lcmsProfile(dstCs);
+    cmsHTRANSFORM lcmsTransform =
+        cmsCreateTransform(srcLcmsProfile, lcmsPixelType(srcCs),
+                           dstLcmsProfile, lcmsPixelType(dstCs),
+                           renderingIntent,
+                           flags | KoColorConversionTransformation::NoOptimization | KoColorConversionTransformation::CopyAlpha);
+    QVERIFY(lcmsTransform);
+
+    cmsDoTransform(lcmsTransform, srcData.constData(), refData.data(), numPixels);
+
+    cmsDeleteTransform(lcmsTransform);
+    cmsCloseProfile(srcLcmsProfile);
+    cmsCloseProfile(dstLcmsProfile);
+
+    const qreal maxError = tolerance(dstCs);
+    QVector<float> dstChannels(4);
+    QVector<float> refChannels(4);
+
+    for (int i = 0; i < numPixels; i++) {
+        dstCs->normalisedChannelsValue(dstData.constData() + i * dstCs->pixelSize(), dstChannels);
+        dstCs->normalisedChannelsValue(refData.constData() + i * dstCs->pixelSize(), refChannels);
+
+        for (int ch = 0; ch < 4; ch++) {
+            if (qAbs(dstChannels[ch] - refChannels[ch]) > maxError) {
+                qDebug() << "Failed pixel" << i << "channel" << ch;
+                qDebug() << "    expected:" << refChannels;
+                qDebug() << "    actual:  " << dstChannels;
+                QFAIL("The conversion differs from LCMS");
+            }
+        }
+    }
+}
+
+void TestLcmsMatrixShaperConversion::testInPlace()
+{
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), "U16", "sRGB-elle-V2-srgbtrc.icc");
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), "U16", "sRGB-elle-V2-g10.icc");
+
+    if (!srcCs || !dstCs) {
+        QSKIP("The color space is not available on this system");
+    }
+
+    const QVector<quint8> srcData = generateSourcePixels(srcCs);
+    QVector<quint8> dstData(srcData.size());
+    QVector<quint8> inPlaceData = srcData;
+
+    QScopedPointer<KoColorConversionTransformation> transform(
+        KoColorSpaceRegistry::instance()->createColorConverter(srcCs, dstCs,
+                                                               KoColorConversionTransformation::internalRenderingIntent(),
+                                                               KoColorConversionTransformation::internalConversionFlags()));
+
+    transform->transform(srcData.constData(), dstData.data(), numPixels);
+    transform->transform(inPlaceData.constData(), inPlaceData.data(), numPixels);
+
+    QCOMPARE(inPlaceData, dstData);
+}
+
+KISTEST_MAIN(TestLcmsMatrixShaperConversion)
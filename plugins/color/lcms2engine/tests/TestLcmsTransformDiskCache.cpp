@@ -0,0 +1,184 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsTransformDiskCache.h"
+
+#include <simpletest.h>
+#include <testpigment.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <lcms2.h>
+
+#include "KoColorProfile.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformation.h"
+
+namespace {
+
+const int numPixels = 4096;
+
+QString cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/colortransforms";
+}
+
+QStringList cacheEntries()
+{
+    return QDir(cacheDirectory()).entryList(QStringList() << "*.kct", QDir::Files, QDir::Name);
+}
+
+QStringList newEntries(const QStringList &before, const QStringList &after)
+{
+    QStringList result;
+    Q_FOREACH (const QString &entry, after) {
+        if (!before.contains(entry)) {
+            result << entry;
+        }
+    }
+    return result;
+}
+
+const KoColorSpace *cmykColorSpace()
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), 0);
+}
+
+QVector<quint8> generateSourcePixels()
+{
+    QVector<quint8> result(numPixels * 4);
+    for (int i = 0; i < result.size(); i++) {
+        result[i] = quint8((i * 37) ^ (i >> 8));
+    }
+    return result;
+}
+
+QVector<quint8> convert(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                        KoColorConversionTransformation::Intent intent,
+                        const QVector<quint8> &srcData)
+{
+    QScopedPointer<KoColorConversionTransformation> transform(
+        KoColorSpaceRegistry::instance()->createColorConverter(srcCs, dstCs, intent,
+                                                               KoColorConversionTransformation::internalConversionFlags()));
+
+    QVector<quint8> result(numPixels * dstCs->pixelSize());
+    transform->transform(srcData.constData(), result.data(), numPixels);
+    return result;
+}
+
+}
+
+void TestLcmsTransformDiskCache::initTestCase()
+{
+    QDir(cacheDirectory()).removeRecursively();
+}
+
+void TestLcmsTransformDiskCache::testReuseCachedTransform()
+{
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCs = cmykColorSpace();
+
+    if (!dstCs) {
+        QSKIP("The color space is not available on this system");
+    }
+
+    const QVector<quint8> srcData = generateSourcePixels();
+    const KoColorConversionTransformation::Intent intent = KoColorConversionTransformation::IntentPerceptual;
+
+    const QStringList initialEntries = cacheEntries();
+
+    const QVector<quint8> firstResult = convert(srcCs, dstCs, intent, srcData);
+    const QStringList entriesAfterFirst = cacheEntries();
+    QCOMPARE(newEntries(initialEntries, entriesAfterFirst).size(), 1);
+
+    const QVector<quint8> secondResult = convert(srcCs, dstCs, intent, srcData);
+    QCOMPARE(cacheEntries(), entriesAfterFirst);
+
+    // the exact transform is used on a miss, the device link is close to it
+    const QByteArray srcProfileData = srcCs->profile()->rawData();
+    const QByteArray dstProfileData = dstCs->profile()->rawData();
+    cmsHPROFILE srcProfile = cmsOpenProfileFromMem(srcProfileData.constData(), srcProfileData.size());
+    cmsHPROFILE dstProfile = cmsOpenProfileFromMem(dstProfileData.constData(), dstProfileData.size());
+    cmsHTRANSFORM lcmsTransform =
+        cmsCreateTransform(srcProfile, TYPE_BGRA_8, dstProfile, TYPE_CMYKA_8, intent,
+                           KoColorConversionTransformation::internalConversionFlags() | KoColorConversionTransformation::CopyAlpha);
+    QVERIFY(lcmsTransform);
+
+    QVector<quint8> refData(firstResult.size());
+    cmsDoTransform(lcmsTransform, srcData.constData(), refData.data(), numPixels);
+
+    cmsDeleteTransform(lcmsTransform);
+    cmsCloseProfile(srcProfile);
+    cmsCloseProfile(dstProfile);
+
+    for (int i = 0; i < refData.size(); i++) {
+        if (firstResult[i] != refData[i]) {
+            qDebug() << "Failed byte" << i << "expected" << refData[i] << "actual" << firstResult[i];
+            QFAIL("The freshly built conversion differs from LCMS");
+        }
+
+        if (qAbs(int(secondResult[i]) - int(refData[i])) > 2) {
+            qDebug() << "Failed byte" << i << "expected" << refData[i] << "actual" << secondResult[i];
+            QFAIL("The cached conversion differs from LCMS");
+        }
+    }
+}
+
+void TestLcmsTransformDiskCache::testIntentChangesKey()
+{
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCs = cmykColorSpace();
+
+    if (!dstCs) {
+        QSKIP("The color space is not available on this system");
+    }
+
+    const QVector<quint8> srcData = generateSourcePixels();
+
+    convert(srcCs, dstCs, KoColorConversionTransformation::IntentPerceptual, srcData);
+    const QStringList entriesBefore = cacheEntries();
+
+    convert(srcCs, dstCs, KoColorConversionTransformation::IntentSaturation, srcData);
+    QCOMPARE(newEntries(entriesBefore, cacheEntries()).size(), 1);
+}
+
+void TestLcmsTransformDiskCache::testCorruptedEntry()
+{
+    const KoColorSpace *srcCs = cmykColorSpace();
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->rgb8();
+
+    if (!srcCs) {
+        QSKIP("The color space is not available on this system");
+    }
+
+    const QVector<quint8> srcData = generateSourcePixels();
+    const KoColorConversionTransformation::Intent intent = KoColorConversionTransformation::IntentRelativeColorimetric;
+
+    const QStringList entriesBefore = cacheEntries();
+    const QVector<quint8> referenceResult = convert(srcCs, dstCs, intent, srcData);
+
+    const QStringList entries = newEntries(entriesBefore, cacheEntries());
+    QCOMPARE(entries.size(), 1);
+
+    const QString entryPath = cacheDirectory() + "/" + entries.first();
+
+    {
+        QFile file(entryPath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("garbage");
+    }
+
+    // the broken entry is rebuilt and the result does not change
+    QCOMPARE(convert(srcCs, dstCs, intent, srcData), referenceResult);
+    QVERIFY(QFileInfo(entryPath).size() > 7);
+}
+
+KISTEST_MAIN(TestLcmsTransformDiskCache)
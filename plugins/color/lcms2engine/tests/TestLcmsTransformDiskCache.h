@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSTRANSFORMDISKCACHE_H
+#define TESTLCMSTRANSFORMDISKCACHE_H
+
+#include <QObject>
+
+class TestLcmsTransformDiskCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testReuseCachedTransform();
+    void testIntentChangesKey();
+    void testCorruptedEntry();
+};
+
+#endif // TESTLCMSTRANSFORMDISKCACHE_H
@@ -43,13 +43,15 @@ KisHalftoneFilter::KisHalftoneFilter()
     : KisFilter(id(), FiltersCategoryArtisticId, i18n("&Halftone..."))
 {
     setSupportsPainting(true);
+    setScalesConfigurationForLevelOfDetail(true);
 }
 
 void KisHalftoneFilter::processImpl(KisPaintDeviceSP device,
                                     const QRect &applyRect,
-                                    const KisFilterConfigurationSP config,
+                                    const KisFilterConfigurationSP _config,
                                     KoUpdater *progressUpdater) const
 {
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
     const KisHalftoneFilterConfiguration *filterConfig =
             dynamic_cast<const KisHalftoneFilterConfiguration*>(config.data());
 
@@ -703,6 +705,74 @@ KisFilterConfigurationSP KisHalftoneFilter::factoryConfiguration(KisResourcesInt
     return new KisHalftoneFilterConfiguration("halftone", 1, resourcesInterface);
 }
 
+namespace {
+
+QStringList generatorPrefixes(const KisHalftoneFilterConfiguration *config)
+{
+    QStringList prefixes;
+
+    if (config->mode() == KisHalftoneFilterConfiguration::HalftoneMode_IndependentChannels) {
+        const QString prefix = config->colorModelId() + "_channel";
+        for (int i = 0; i < 4; ++i) {
+            prefixes << prefix + QString::number(i) + "_";
+        }
+    } else {
+        prefixes << config->mode() + "_";
+    }
+
+    return prefixes;
+}
+
+/**
+ * Only the screentone generator has its parameters measured in pixels,
+ * the other generators cannot be scaled for level of detail
+ */
+const QString s_scalableGeneratorId = "screentone";
+
+}
+
+bool KisHalftoneFilter::supportsLevelOfDetail(const KisFilterConfigurationSP config, int lod) const
+{
+    Q_UNUSED(lod);
+
+    const KisHalftoneFilterConfiguration *filterConfig =
+            dynamic_cast<const KisHalftoneFilterConfiguration*>(config.data());
+    if (!filterConfig) return false;
+
+    Q_FOREACH (const QString &prefix, generatorPrefixes(filterConfig)) {
+        const QString generatorId = filterConfig->generatorId(prefix);
+        if (!generatorId.isEmpty() && generatorId != s_scalableGeneratorId) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void KisHalftoneFilter::scaleConfigurationForLevelOfDetail(KisFilterConfigurationSP config, int lod) const
+{
+    KisHalftoneFilterConfiguration *filterConfig =
+            dynamic_cast<KisHalftoneFilterConfiguration*>(config.data());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(filterConfig);
+
+    Q_FOREACH (const QString &prefix, generatorPrefixes(filterConfig)) {
+        if (filterConfig->generatorId(prefix) != s_scalableGeneratorId) continue;
+
+        KisFilterConfigurationSP generatorConfig = filterConfig->generatorConfiguration(prefix);
+        if (!generatorConfig) continue;
+
+        // the screen size is defined either in pixels or by the resolution
+        // and the frequency, so both the ways are scaled
+        scaleLevelOfDetailProperty(generatorConfig, "size_x", lod);
+        scaleLevelOfDetailProperty(generatorConfig, "size_y", lod);
+        scaleLevelOfDetailProperty(generatorConfig, "resolution", lod);
+        scaleLevelOfDetailProperty(generatorConfig, "position_x", lod);
+        scaleLevelOfDetailProperty(generatorConfig, "position_y", lod);
+
+        filterConfig->setGeneratorConfiguration(prefix, generatorConfig);
+    }
+}
+
 KisConfigWidget *KisHalftoneFilter::createConfigurationWidget(QWidget *parent, const KisPaintDeviceSP dev, bool useForMasks) const
 {
     Q_UNUSED(useForMasks);
@@ -46,6 +46,11 @@ public:
     KisFilterConfigurationSP factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
     KisConfigWidget *createConfigurationWidget(QWidget *parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
 
+    bool supportsLevelOfDetail(const KisFilterConfigurationSP config, int lod) const override;
+
+protected:
+    void scaleConfigurationForLevelOfDetail(KisFilterConfigurationSP config, int lod) const override;
+
 private:
     mutable KisCachedSelection m_selectionsCache;
     mutable KisCachedPaintDevice m_grayDevicesCache;
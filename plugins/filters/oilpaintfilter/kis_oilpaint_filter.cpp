@@ -46,16 +46,20 @@ KisOilPaintFilter::KisOilPaintFilter() : KisFilter(id(), FiltersCategoryArtistic
     setSupportsPainting(true);
     setSupportsThreading(false);
     setSupportsAdjustmentLayers(true);
+
+    addLevelOfDetailScaledProperty("brushSize", 1);
 }
 
 void KisOilPaintFilter::processImpl(KisPaintDeviceSP device,
                                     const QRect& applyRect,
-                                    const KisFilterConfigurationSP config,
+                                    const KisFilterConfigurationSP _config,
                                     KoUpdater* progressUpdater
                                     ) const
 {
     Q_ASSERT(!device.isNull());
 
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
+
     //read the filter configuration values from the KisFilterConfiguration object
     const quint32 brushSize = config ? config->getInt("brushSize", 1) : 1;
     const quint32 smooth = config ? config->getInt("smooth", 30) : 30;
@@ -185,15 +189,17 @@ void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, quint8* dst, con
     delete [] AverageChannels;
 }
 
-QRect KisOilPaintFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int /*lod*/) const
+QRect KisOilPaintFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
 {
-    const quint32 brushSize = _config ? _config->getInt("brushSize", 1) : 1;
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, lod);
+    const quint32 brushSize = config ? config->getInt("brushSize", 1) : 1;
     return rect.adjusted(-brushSize * 2, -brushSize * 2, brushSize * 2, brushSize * 2);
 }
 
-QRect KisOilPaintFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int /*lod*/) const
+QRect KisOilPaintFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
 {
-    const quint32 brushSize = _config ? _config->getInt("brushSize", 1) : 1;
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, lod);
+    const quint32 brushSize = config ? config->getInt("brushSize", 1) : 1;
 
     return rect.adjusted( -brushSize*2, -brushSize*2, brushSize*2, brushSize*2);
 }
@@ -49,6 +49,12 @@ KisRainDropsFilter::KisRainDropsFilter()
     setSupportsPainting(false);
     setSupportsThreading(false);
     setSupportsAdjustmentLayers(false);
+
+    /**
+     * The number of drops is not scaled: the drops are distributed over
+     * the scaled area, so the preview shows the same pattern
+     */
+    addLevelOfDetailScaledProperty("dropSize", 6);
 }
 
 // This method have been ported from Pieter Z. Voloshyn algorithm code.
@@ -73,7 +79,7 @@ KisRainDropsFilter::KisRainDropsFilter()
 
 void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
                                      const QRect& applyRect,
-                                     const KisFilterConfigurationSP config,
+                                     const KisFilterConfigurationSP _config,
                                      KoUpdater* progressUpdater ) const
 {
     /**
@@ -85,6 +91,8 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
     QPoint srcTopLeft = applyRect.topLeft();
     Q_ASSERT(device);
 
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
+
     //read the filter configuration values from the KisFilterConfiguration object
     quint32 DropSize = config->getInt("dropSize", 80);
     quint32 number = config->getInt("number", 80);
@@ -55,18 +55,21 @@ KisFilterRandomPick::KisFilterRandomPick() : KisFilter(id(), FiltersCategoryOthe
 {
     setColorSpaceIndependence(FULLY_INDEPENDENT);
     setSupportsPainting(true);
+
+    addLevelOfDetailScaledProperty("windowsize");
 }
 
 
 void KisFilterRandomPick::processImpl(KisPaintDeviceSP device,
                                       const QRect& applyRect,
-                                      const KisFilterConfigurationSP config,
+                                      const KisFilterConfigurationSP _config,
                                       KoUpdater* progressUpdater
                                       ) const
 {
-    Q_UNUSED(config);
     Q_ASSERT(!device.isNull());
 
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
+
     const KoColorSpace * cs = device->colorSpace();
 
     QVariant value;
@@ -128,9 +131,9 @@ KisFilterConfigurationSP KisFilterRandomPick::defaultConfiguration(KisResourcesI
     return config;
 }
 
-QRect KisFilterRandomPick::neededRect(const QRect& rect, const KisFilterConfigurationSP config, int lod) const
+QRect KisFilterRandomPick::neededRect(const QRect& rect, const KisFilterConfigurationSP _config, int lod) const
 {
-    Q_UNUSED(lod);
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, lod);
 
     QVariant value;
     int windowsize = ceil((config && config->getProperty("windowsize", value)) ? value.toDouble() : 2.5);
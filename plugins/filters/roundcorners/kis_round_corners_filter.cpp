@@ -43,6 +43,7 @@ KisRoundCornersFilter::KisRoundCornersFilter() : KisFilter(id(), FiltersCategory
 {
     setSupportsPainting(false);
 
+    addLevelOfDetailScaledProperty("radius", 1);
 }
 
 void fadeOneCorner(KisPaintDeviceSP device,
@@ -67,19 +68,20 @@ void fadeOneCorner(KisPaintDeviceSP device,
 
 void KisRoundCornersFilter::processImpl(KisPaintDeviceSP device,
                                         const QRect& applyRect,
-                                        const KisFilterConfigurationSP config,
+                                        const KisFilterConfigurationSP _config,
                                         KoUpdater* progressUpdater
                                         ) const
 {
-    Q_UNUSED(config);
     Q_ASSERT(!device.isNull());
 
-    if (!device || !config) {
+    if (!device || !_config) {
         warnKrita << "Invalid parameters for round corner filter";
-        dbgPlugins << device << " " << config;
+        dbgPlugins << device << " " << _config;
         return;
     }
 
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
+
     const QRect bounds = device->defaultBounds()->imageBorderRect();
 
     const qint32 radius = qMin(KisAlgebra2D::minDimension(bounds) / 2, qMax(1, config->getInt("radius" , 30)));
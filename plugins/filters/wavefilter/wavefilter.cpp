@@ -99,6 +99,13 @@ KisFilterWave::KisFilterWave() : KisFilter(id(), FiltersCategoryOtherId, i18n("&
     setColorSpaceIndependence(FULLY_INDEPENDENT);
     setSupportsPainting(false);
     setSupportsAdjustmentLayers(true);
+
+    addLevelOfDetailScaledProperty("horizontalwavelength", 1);
+    addLevelOfDetailScaledProperty("horizontalshift");
+    addLevelOfDetailScaledProperty("horizontalamplitude");
+    addLevelOfDetailScaledProperty("verticalwavelength", 1);
+    addLevelOfDetailScaledProperty("verticalshift");
+    addLevelOfDetailScaledProperty("verticalamplitude");
 }
 
 KisFilterConfigurationSP KisFilterWave::defaultConfiguration(KisResourcesInterfaceSP resourcesInterface) const
@@ -122,12 +129,14 @@ KisConfigWidget * KisFilterWave::createConfigurationWidget(QWidget* parent, cons
 
 void KisFilterWave::processImpl(KisPaintDeviceSP device,
                                 const QRect& applyRect,
-                                const KisFilterConfigurationSP config,
+                                const KisFilterConfigurationSP _config,
                                 KoUpdater* progressUpdater
                                 ) const
 {
     Q_ASSERT(device.data() != 0);
 
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, device);
+
     QVariant value;
     int horizontalwavelength = (config && config->getProperty("horizontalwavelength", value)) ? value.toInt() : 50;
     int horizontalshift = (config && config->getProperty("horizontalshift", value)) ? value.toInt() : 50;
@@ -164,9 +173,9 @@ void KisFilterWave::processImpl(KisPaintDeviceSP device,
     delete horizontalWave;
 }
 
-QRect KisFilterWave::changedRect(const QRect &rect, const KisFilterConfigurationSP config, int lod) const
+QRect KisFilterWave::changedRect(const QRect &rect, const KisFilterConfigurationSP _config, int lod) const
 {
-    Q_UNUSED(lod);
+    const KisFilterConfigurationSP config = configurationForLevelOfDetail(_config, lod);
 
     QVariant value;
     int horizontalamplitude = (config && config->getProperty("horizontalamplitude", value)) ? value.toInt() : 4;
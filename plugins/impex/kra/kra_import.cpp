@@ -30,7 +30,22 @@ KisImportExportErrorCode KraImport::convert(KisDocument *document, QIODevice *io
     KisImportExportErrorCode result = kraConverter.buildImage(io);
     if (result.isOk()) {
         KisNodeSP preActivatedNode = !kraConverter.activeNodes().isEmpty() ? kraConverter.activeNodes().first() : nullptr;
-        document->setCurrentImage(kraConverter.image(), true, preActivatedNode);
+        KisImageSP image = kraConverter.image();
+
+        /**
+         * If the projection already contains the merged image from the
+         * file, the canvas can be shown right away and the layers are
+         * composed asynchronously. In batch mode the caller expects the
+         * image to be fully composed on return.
+         */
+        const bool useAsyncRefresh = !batchMode() && kraConverter.hasPreviewProjection();
+
+        document->setCurrentImage(image, !useAsyncRefresh, preActivatedNode);
+
+        if (useAsyncRefresh) {
+            // the same as KisImage::initialRefreshGraph(), but without waiting
+            image->refreshGraphAsync(0, image->bounds(), QRect());
+        }
 
         if (kraConverter.assistants().size() > 0) {
             document->setAssistants(kraConverter.assistants());
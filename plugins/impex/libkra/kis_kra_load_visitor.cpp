@@ -32,6 +32,7 @@
 #include "kis_dom_utils.h"
 #include "kis_filter_registry.h"
 #include "kis_generator_registry.h"
+#include "kis_image_config.h"
 #include "kis_paint_device_frames_interface.h"
 #include "kis_raster_keyframe_channel.h"
 #include "kis_shape_selection.h"
@@ -98,6 +99,7 @@ KisKraLoadVisitor::KisKraLoadVisitor(KisImageSP image,
     , m_keyframeFilenames(keyframeFilenames)
     , m_name(name)
     , m_shapeController(shapeController)
+    , m_lazyLoading(KisImageConfig(true).lazyLayerLoading())
 {
     m_store->pushDirectory();
 
@@ -529,8 +531,8 @@ QStringList KisKraLoadVisitor::warningMessages() const
 
 struct SimpleDevicePolicy
 {
-    bool read(KisPaintDeviceSP dev, QIODevice *stream) {
-        return dev->read(stream);
+    bool read(KisPaintDeviceSP dev, QIODevice *stream, bool lazy) {
+        return dev->read(stream, lazy);
     }
 
     void setDefaultPixel(KisPaintDeviceSP dev, const KoColor &defaultPixel) const {
@@ -543,8 +545,8 @@ struct FramedDevicePolicy
     FramedDevicePolicy(int frameId)
         :  m_frameId(frameId) {}
 
-    bool read(KisPaintDeviceSP dev, QIODevice *stream) {
-        return dev->framesInterface()->readFrame(stream, m_frameId);
+    bool read(KisPaintDeviceSP dev, QIODevice *stream, bool lazy) {
+        return dev->framesInterface()->readFrame(stream, m_frameId, lazy);
     }
 
     void setDefaultPixel(KisPaintDeviceSP dev, const KoColor &defaultPixel) const {
@@ -608,7 +610,7 @@ bool KisKraLoadVisitor::loadPaintDeviceFrame(KisPaintDeviceSP device, const QStr
     }
 
     if (m_store->open(location)) {
-        if (!policy.read(device, m_store->device())) {
+        if (!policy.read(device, m_store->device(), m_lazyLoading)) {
             m_warningMessages << i18n("Could not read pixel data: %1.", location);
             device->disconnect();
             m_store->close();
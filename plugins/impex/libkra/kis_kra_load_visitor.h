@@ -96,6 +96,12 @@ private:
     QStringList m_warningMessages;
     KoShapeControllerBase *m_shapeController;
     QMap<QString, const KoColorProfile *> m_profileCache;
+
+    /**
+     * If true, the tiles of the paint devices are decompressed
+     * on the first access instead of during loading
+     */
+    bool m_lazyLoading;
 };
 
 #endif // KIS_KRA_LOAD_VISITOR_H_
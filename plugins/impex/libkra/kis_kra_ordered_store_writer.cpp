@@ -0,0 +1,211 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "kis_kra_ordered_store_writer.h"
+
+#include <deque>
+
+#include <QBuffer>
+#include <QFuture>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <KoStore.h>
+#include <KoStoreDevice.h>
+
+#include <kis_assert.h>
+#include <kis_debug.h>
+
+
+struct KisKraOrderedStoreWriter::Private
+{
+    struct Entry {
+        QString location;
+        Compression compression = KeepCompression;
+        QSharedPointer<QByteArray> data;
+        QFuture<bool> future;
+        bool isAsync = false;
+    };
+
+    KoStore *store = nullptr;
+    int numThreads = 1;
+    int maxPendingJobs = 1;
+
+    QThreadPool threadPool;
+    std::deque<Entry> pendingEntries;
+    int numPendingJobs = 0;
+
+    QStringList failedFiles;
+    bool hasNewFailures = false;
+
+    void addFailure(const QString &location) {
+        failedFiles << location;
+        hasNewFailures = true;
+    }
+
+    void applyCompression(Compression compression);
+    void restoreCompression(Compression compression);
+    bool writeToStore(const QString &location, Compression compression, const QByteArray &data);
+    void writeHeadEntry();
+    void writeFinishedEntries();
+};
+
+void KisKraOrderedStoreWriter::Private::applyCompression(Compression compression)
+{
+    if (compression != KeepCompression) {
+        store->setCompressionEnabled(compression == Compressed);
+    }
+}
+
+void KisKraOrderedStoreWriter::Private::restoreCompression(Compression compression)
+{
+    /**
+     * Explicit compression mode is applied to a single file only,
+     * afterwards the store gets back to its default mode
+     */
+    if (compression != KeepCompression) {
+        store->setCompressionEnabled(true);
+    }
+}
+
+bool KisKraOrderedStoreWriter::Private::writeToStore(const QString &location, Compression compression, const QByteArray &data)
+{
+    applyCompression(compression);
+
+    bool result = false;
+
+    if (store->open(location)) {
+        result = store->write(data) == data.size();
+        result &= store->close();
+    }
+
+    restoreCompression(compression);
+
+    return result;
+}
+
+void KisKraOrderedStoreWriter::Private::writeHeadEntry()
+{
+    Entry entry = pendingEntries.front();
+    pendingEntries.pop_front();
+
+    bool result = true;
+
+    if (entry.isAsync) {
+        result = entry.future.result();
+        numPendingJobs--;
+    }
+
+    if (result) {
+        result = writeToStore(entry.location, entry.compression, *entry.data);
+    }
+
+    if (!result) {
+        warnFile << "Failed to save" << entry.location;
+        addFailure(entry.location);
+    }
+}
+
+void KisKraOrderedStoreWriter::Private::writeFinishedEntries()
+{
+    while (!pendingEntries.empty() &&
+           (!pendingEntries.front().isAsync || pendingEntries.front().future.isFinished())) {
+
+        writeHeadEntry();
+    }
+}
+
+KisKraOrderedStoreWriter::KisKraOrderedStoreWriter(KoStore *store, int numThreads)
+    : m_d(new Private)
+{
+    m_d->store = store;
+    m_d->numThreads = qMax(1, numThreads);
+    m_d->maxPendingJobs = 2 * m_d->numThreads;
+    m_d->threadPool.setMaxThreadCount(m_d->numThreads);
+}
+
+KisKraOrderedStoreWriter::~KisKraOrderedStoreWriter()
+{
+    flush();
+}
+
+void KisKraOrderedStoreWriter::addFile(const QString &location, const QByteArray &data, Compression compression)
+{
+    Private::Entry entry;
+    entry.location = location;
+    entry.compression = compression;
+    entry.data.reset(new QByteArray(data));
+
+    m_d->pendingEntries.push_back(entry);
+    m_d->writeFinishedEntries();
+}
+
+void KisKraOrderedStoreWriter::addFile(const QString &location, Job job, Compression compression)
+{
+    if (m_d->numThreads <= 1) {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->pendingEntries.empty());
+
+        m_d->applyCompression(compression);
+
+        bool result = false;
+
+        if (m_d->store->open(location)) {
+            KoStoreDevice device(m_d->store);
+            device.open(QIODevice::WriteOnly);
+            result = job(&device);
+            result &= m_d->store->close();
+        }
+
+        m_d->restoreCompression(compression);
+
+        if (!result) {
+            warnFile << "Failed to save" << location;
+            m_d->addFailure(location);
+        }
+
+        return;
+    }
+
+    Private::Entry entry;
+    entry.location = location;
+    entry.compression = compression;
+    entry.data.reset(new QByteArray());
+    entry.isAsync = true;
+
+    QSharedPointer<QByteArray> data = entry.data;
+
+    entry.future = QtConcurrent::run(&m_d->threadPool,
+        [job, data] () {
+            QBuffer buffer(data.data());
+            buffer.open(QIODevice::WriteOnly);
+            return job(&buffer);
+        });
+
+    m_d->pendingEntries.push_back(entry);
+    m_d->numPendingJobs++;
+
+    m_d->writeFinishedEntries();
+
+    while (m_d->numPendingJobs > m_d->maxPendingJobs) {
+        m_d->writeHeadEntry();
+    }
+}
+
+bool KisKraOrderedStoreWriter::flush()
+{
+    while (!m_d->pendingEntries.empty()) {
+        m_d->writeHeadEntry();
+    }
+
+    const bool result = !m_d->hasNewFailures;
+    m_d->hasNewFailures = false;
+    return result;
+}
+
+QStringList KisKraOrderedStoreWriter::failedFiles() const
+{
+    return m_d->failedFiles;
+}
@@ -0,0 +1,81 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_KRA_ORDERED_STORE_WRITER_H
+#define KIS_KRA_ORDERED_STORE_WRITER_H
+
+#include <functional>
+
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+#include "kritalibkra_export.h"
+
+class QIODevice;
+class KoStore;
+
+/**
+ * @brief Writes files into a KoStore in the order they were added,
+ *        while generating their content on a pool of worker threads
+ *
+ * The content of every file is produced by a job, which gets a
+ * QIODevice to write into. When more than one thread is allowed, the
+ * jobs are run in parallel into memory buffers and the buffers are
+ * written into the store strictly in the order of addFile() calls,
+ * so the resulting archive is identical to the one written serially.
+ * When only one thread is allowed, every job writes directly into the
+ * store, exactly like the code did before.
+ *
+ * The number of the buffers waiting for being written is limited, so
+ * the memory overhead is bounded by a few compressed layers.
+ *
+ * NOTE: the location of a file is resolved when the file is written
+ *       into the store, so the caller should call flush() before
+ *       changing the current directory of the store.
+ */
+class KRITALIBKRA_EXPORT KisKraOrderedStoreWriter
+{
+public:
+    using Job = std::function<bool(QIODevice *device)>;
+
+    enum Compression {
+        KeepCompression, ///< use the compression mode the store has at the moment of writing
+        Compressed,
+        Uncompressed
+    };
+
+public:
+    KisKraOrderedStoreWriter(KoStore *store, int numThreads);
+
+    /**
+     * Waits for all the running jobs and writes their results
+     */
+    ~KisKraOrderedStoreWriter();
+
+    void addFile(const QString &location, const QByteArray &data,
+                 Compression compression = KeepCompression);
+
+    void addFile(const QString &location, Job job,
+                 Compression compression = KeepCompression);
+
+    /**
+     * Waits for all the jobs and writes the pending files into the store
+     * @return false if some of the files could not be generated or written
+     */
+    bool flush();
+
+    /**
+     * @return the locations of the files that failed to be generated
+     *         or written since the creation of the writer
+     */
+    QStringList failedFiles() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KIS_KRA_ORDERED_STORE_WRITER_H
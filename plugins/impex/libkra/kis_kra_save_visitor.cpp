@@ -11,6 +11,8 @@
 
 #include <QBuffer>
 #include <QByteArray>
+#include <QMutex>
+#include <QSharedPointer>
 
 #include <KoColorProfile.h>
 #include <KoStore.h>
@@ -43,7 +45,8 @@
 #include <kis_transparency_mask.h>
 
 #include "kis_config.h"
-#include "kis_store_paintdevice_writer.h"
+#include "kis_paint_device_writer.h"
+#include "kis_kra_ordered_store_writer.h"
 #include "flake/kis_shape_selection.h"
 
 #include "kis_raster_keyframe_channel.h"
@@ -57,19 +60,43 @@
 
 using namespace KRA;
 
-KisKraSaveVisitor::KisKraSaveVisitor(KoStore *store, const QString & name, QMap<const KisNode*, QString> nodeFileNames)
+namespace {
+
+class IODevicePaintDeviceWriter : public KisPaintDeviceWriter
+{
+public:
+    IODevicePaintDeviceWriter(QIODevice *device)
+        : m_device(device)
+    {
+    }
+
+    bool write(const QByteArray &data) override {
+        return m_device->write(data) == data.size();
+    }
+
+    bool write(const char* data, qint64 length) override {
+        return m_device->write(data, length) == length;
+    }
+
+private:
+    QIODevice *m_device;
+};
+
+}
+
+KisKraSaveVisitor::KisKraSaveVisitor(KoStore *store, const QString & name, QMap<const KisNode*, QString> nodeFileNames, int numThreads)
     : KisNodeVisitor()
     , m_store(store)
     , m_external(false)
     , m_name(name)
     , m_nodeFileNames(nodeFileNames)
-    , m_writer(new KisStorePaintDeviceWriter(store))
+    , m_storeWriter(new KisKraOrderedStoreWriter(store, numThreads))
 {
 }
 
 KisKraSaveVisitor::~KisKraSaveVisitor()
 {
-    delete m_writer;
+    delete m_storeWriter;
 }
 
 void KisKraSaveVisitor::setExternalUri(const QString &uri)
@@ -88,6 +115,7 @@ bool KisKraSaveVisitor::visit(KisExternalLayer * layer)
         Q_FOREACH(KoShape *shape, shapes) {
             auto *reference = dynamic_cast<KisReferenceImage*>(shape);
             KIS_ASSERT_RECOVER_RETURN_VALUE(reference, false);
+            flush();
             bool saved = reference->saveImage(m_store);
             if (!saved) {
                 m_errorMessages << i18n("Failed to save reference image %1.", reference->internalFile());
@@ -100,6 +128,7 @@ bool KisKraSaveVisitor::visit(KisExternalLayer * layer)
             m_errorMessages << i18n("Failed to save the metadata for layer %1.", layer->name());
             return false;
         }
+        flush();
         m_store->pushDirectory();
         QString location = getLocation(layer, DOT_SHAPE_LAYER);
         result = m_store->enterDirectory(location);
@@ -226,20 +255,8 @@ bool KisKraSaveVisitor::visit(KisTransformMask *mask)
     root.appendChild(data);
 
     QString location = getLocation(mask, DOT_TRANSFORMCONFIG);
-    if (m_store->open(location)) {
-        QByteArray a = doc.toByteArray();
-        bool retval = m_store->write(a) == a.size();
-
-        if (!retval) {
-            warnFile << "Could not write transform mask configuration";
-        }
-        if (!m_store->close()) {
-            warnFile << "Could not close store after writing transform mask configuration";
-            retval = false;
-        }
-        return retval;
-    }
-    return false;
+    addFile(location, doc.toByteArray());
+    return true;
 }
 
 bool KisKraSaveVisitor::visit(KisTransparencyMask *mask)
@@ -262,6 +279,9 @@ bool KisKraSaveVisitor::visit(KisSelectionMask *mask)
 
 bool KisKraSaveVisitor::visit(KisColorizeMask *mask)
 {
+    // the pending files should be written before changing the directory
+    flush();
+
     m_store->pushDirectory();
     QString location = getLocation(mask, DOT_COLORIZE_MASK);
     bool result = m_store->enterDirectory(location);
@@ -297,11 +317,26 @@ bool KisKraSaveVisitor::visit(KisColorizeMask *mask)
     savePaintDevice(mask->coloringProjection(), COLORIZE_COLORING_DEVICE);
     saveIccProfile(mask, mask->colorSpace()->profile());
 
+    flush();
     m_store->popDirectory();
 
     return true;
 }
 
+bool KisKraSaveVisitor::flush()
+{
+    const QStringList previousFailures = m_storeWriter->failedFiles();
+
+    if (m_storeWriter->flush()) return true;
+
+    const QStringList failures = m_storeWriter->failedFiles();
+    for (int i = previousFailures.size(); i < failures.size(); i++) {
+        m_errorMessages << i18n("Failed to save %1.", failures[i]);
+    }
+
+    return false;
+}
+
 QStringList KisKraSaveVisitor::errorMessages() const
 {
     return m_errorMessages;
@@ -320,10 +355,16 @@ struct SimpleDevicePolicy
 
 struct FramedDevicePolicy
 {
-    FramedDevicePolicy(int frameId)
-        :  m_frameId(frameId) {}
+    FramedDevicePolicy(int frameId, QSharedPointer<QMutex> framesLock)
+        :  m_frameId(frameId),
+           m_framesLock(framesLock) {}
 
     bool write(KisPaintDeviceSP dev, KisPaintDeviceWriter &store) {
+        /**
+         * The frames interface is not reentrant, so the frames
+         * of the same device are serialized one by one
+         */
+        QMutexLocker l(m_framesLock.data());
         return dev->framesInterface()->writeFrame(store, m_frameId);
     }
 
@@ -332,6 +373,7 @@ struct FramedDevicePolicy
     }
 
     int m_frameId;
+    QSharedPointer<QMutex> m_framesLock;
 };
 
 bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
@@ -339,7 +381,7 @@ bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
 {
     // Layer data
     KisConfig cfg(true);
-    m_store->setCompressionEnabled(cfg.compressKra());
+    const bool compressed = cfg.compressKra();
 
     KisPaintDeviceFramesInterface *frameInterface = device->framesInterface();
     QList<int> frames;
@@ -349,9 +391,10 @@ bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
     }
 
     if (!frameInterface || frames.count() <= 1) {
-        savePaintDeviceFrame(device, location, SimpleDevicePolicy());
+        savePaintDeviceFrame(device, location, SimpleDevicePolicy(), compressed);
     } else {
         KisRasterKeyframeChannel *keyframeChannel = device->keyframeChannel();
+        QSharedPointer<QMutex> framesLock(new QMutex());
 
         for (int i = 0; i < frames.count(); i++) {
             int id = frames[i];
@@ -359,37 +402,48 @@ bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
             QString frameFilename = getLocation(keyframeChannel->frameFilename(id));
             Q_ASSERT(!frameFilename.isEmpty());
 
-            if (!savePaintDeviceFrame(device, frameFilename, FramedDevicePolicy(id))) {
+            if (!savePaintDeviceFrame(device, frameFilename, FramedDevicePolicy(id, framesLock), compressed)) {
                 return false;
             }
         }
     }
 
-    m_store->setCompressionEnabled(true);
     return true;
 }
 
 
 template<class DevicePolicy>
-bool KisKraSaveVisitor::savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy)
+bool KisKraSaveVisitor::savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy, bool compressed)
 {
-    if (m_store->open(location)) {
-        if (!policy.write(device, *m_writer)) {
-            device->disconnect();
-            m_store->close();
-            return false;
-        }
-
-        m_store->close();
-    }
-    if (m_store->open(location + ".defaultpixel")) {
-        m_store->write((char*)policy.defaultPixel(device).data(), device->colorSpace()->pixelSize());
-        m_store->close();
-    }
+    const KisKraOrderedStoreWriter::Compression compression =
+        compressed ? KisKraOrderedStoreWriter::Compressed : KisKraOrderedStoreWriter::Uncompressed;
+
+    /**
+     * Tile compression is the most expensive part of saving, so the
+     * device is serialized by the store writer's thread pool. Reading
+     * the device from a worker thread is safe, since the image being saved
+     * is not modified until saving is finished.
+     */
+    m_storeWriter->addFile(location,
+                           [device, policy] (QIODevice *io) mutable {
+                               IODevicePaintDeviceWriter writer(io);
+                               return policy.write(device, writer);
+                           },
+                           compression);
+
+    const KoColor defaultPixel = policy.defaultPixel(device);
+    m_storeWriter->addFile(location + ".defaultpixel",
+                           QByteArray(reinterpret_cast<const char*>(defaultPixel.data()), device->colorSpace()->pixelSize()),
+                           compression);
 
     return true;
 }
 
+void KisKraSaveVisitor::addFile(const QString &location, const QByteArray &data)
+{
+    m_storeWriter->addFile(location, data);
+}
+
 bool KisKraSaveVisitor::saveAnnotations(KisLayer* layer)
 {
     if (!layer) return false;
@@ -420,12 +474,7 @@ bool KisKraSaveVisitor::saveIccProfile(KisNode *node, const KoColorProfile *prof
 
         if (annotation) {
             // save layer profile
-            if (m_store->open(getLocation(node, DOT_ICC))) {
-                m_store->write(annotation->annotation());
-                m_store->close();
-            } else {
-                return false;
-            }
+            addFile(getLocation(node, DOT_ICC), annotation->annotation());
         }
     }
     return true;
@@ -455,6 +504,7 @@ bool KisKraSaveVisitor::saveSelection(KisNode* node)
     }
 
     if (selection->hasNonEmptyShapeSelection()) {
+        flush();
         m_store->pushDirectory();
         retval = m_store->enterDirectory(getLocation(node, DOT_SHAPE_SELECTION));
         if (retval) {
@@ -488,10 +538,9 @@ bool KisKraSaveVisitor::saveFilterConfiguration(KisNode* node)
 
     if (filter) {
         QString location = getLocation(node, DOT_FILTERCONFIG);
-        if (m_store->open(location)) {
-            QString s = filter->toXML();
-            retval = (m_store->write(s.toUtf8(), qstrlen(s.toUtf8())) == qstrlen(s.toUtf8())); m_store->close();
-        }
+        const QByteArray data = filter->toXML().toUtf8();
+        addFile(location, QByteArray(data.constData(), qstrlen(data)));
+        retval = true;
     }
     return retval;
 }
@@ -524,9 +573,8 @@ bool KisKraSaveVisitor::saveMetaData(KisNode* node)
         QByteArray data = buffer.data();
         dbgFile << "\t information size is" << data.size();
 
-        if (data.size() > 0 && m_store->open(location)) {
-            retval = m_store->write(data,  data.size());
-            m_store->close();
+        if (data.size() > 0) {
+            addFile(location, data);
         }
         if (!retval) {
             m_errorMessages << i18n("Could not write for %1 metadata to the file.", node->name());
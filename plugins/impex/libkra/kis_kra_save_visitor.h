@@ -16,13 +16,18 @@
 #include "kis_image.h"
 #include "kritalibkra_export.h"
 
-class KisPaintDeviceWriter;
 class KoStore;
+class KisKraOrderedStoreWriter;
 
 class KRITALIBKRA_EXPORT KisKraSaveVisitor : public KisNodeVisitor
 {
 public:
-    KisKraSaveVisitor(KoStore *store, const QString & name, QMap<const KisNode*, QString> nodeFileNames);
+    /**
+     * @param numThreads the number of threads used for serializing the
+     *        paint devices; the files are still written into \p store
+     *        in the order of traversal (see KisKraOrderedStoreWriter)
+     */
+    KisKraSaveVisitor(KoStore *store, const QString & name, QMap<const KisNode*, QString> nodeFileNames, int numThreads = 1);
     ~KisKraSaveVisitor() override;
     using KisNodeVisitor::visit;
 
@@ -55,6 +60,13 @@ public:
 
     bool visit(KisColorizeMask *mask) override;
 
+    /**
+     * Waits for the paint devices being serialized in the background and
+     * writes all the pending files into the store. Should be called after
+     * the traversal, the errors are added to errorMessages().
+     */
+    bool flush();
+
     /// @return a list with everything that went wrong while saving
     QStringList errorMessages() const;
 
@@ -63,7 +75,9 @@ private:
     bool savePaintDevice(KisPaintDeviceSP device, QString location);
 
     template<class DevicePolicy>
-    bool savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy);
+    bool savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy, bool compressed);
+
+    void addFile(const QString &location, const QByteArray &data);
 
     bool saveAnnotations(KisLayer* layer);
     bool saveSelection(KisNode* node);
@@ -80,7 +94,7 @@ private:
     QString m_uri;
     QString m_name;
     QMap<const KisNode*, QString> m_nodeFileNames;
-    KisPaintDeviceWriter *m_writer;
+    KisKraOrderedStoreWriter *m_storeWriter;
     QStringList m_errorMessages;
 };
 
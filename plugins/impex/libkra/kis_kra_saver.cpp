@@ -19,6 +19,7 @@
 
 #include <QUrl>
 #include <QBuffer>
+#include <QtConcurrent>
 
 #include <KoDocumentInfo.h>
 #include <KoColorSpaceRegistry.h>
@@ -47,6 +48,7 @@
 #include "kis_dom_utils.h"
 #include "kis_grid_config.h"
 #include "kis_guides_config.h"
+#include "kis_image_config.h"
 #include "KisProofingConfiguration.h"
 #include "kis_asl_layer_style_serializer.h"
 
@@ -473,16 +475,48 @@ bool KisKraSaver::saveBinaryData(KoStore* store, KisImageSP image, const QString
 {
     QString location;
 
+    const int numThreads = KisImageConfig(true).maxNumberOfThreads();
+
+    /**
+     * PNG encoding of the merged image doesn't depend on the layers,
+     * so it is started in the background while the layers are saved.
+     * The encoded data is written into the store at its usual place.
+     */
+    QFuture<QByteArray> mergedImageData;
+    const bool encodeMergedImageInBackground = addMergedImage && numThreads > 1;
+
+    if (encodeMergedImageInBackground) {
+        KisPaintDeviceSP dev = image->projection();
+        const QRect bounds = image->bounds();
+        const qreal xRes = image->xRes();
+        const qreal yRes = image->yRes();
+
+        mergedImageData = QtConcurrent::run([dev, bounds, xRes, yRes] () {
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+
+            if (!KisPNGConverter::saveDeviceToIODevice(&buffer, bounds, xRes, yRes, dev)) {
+                data.clear();
+            }
+            return data;
+        });
+    }
+
     // Save the layers data
-    KisKraSaveVisitor visitor(store, m_d->imageName, m_d->nodeFileNames);
+    KisKraSaveVisitor visitor(store, m_d->imageName, m_d->nodeFileNames, numThreads);
 
     if (external)
         visitor.setExternalUri(uri);
 
     image->rootLayer()->accept(visitor);
+    visitor.flush();
 
     m_d->errorMessages.append(visitor.errorMessages());
     if (!m_d->errorMessages.isEmpty()) {
+        if (encodeMergedImageInBackground) {
+            mergedImageData.waitForFinished();
+        }
         return false;
     }
 
@@ -647,7 +681,16 @@ bool KisKraSaver::saveBinaryData(KoStore* store, KisImageSP image, const QString
     if (addMergedImage) {
         KisPaintDeviceSP dev = image->projection();
         store->setCompressionEnabled(false);
-        r = KisPNGConverter::saveDeviceToStore("mergedimage.png", image->bounds(), image->xRes(), image->yRes(), dev, store);
+        if (encodeMergedImageInBackground) {
+            const QByteArray data = mergedImageData.result();
+            r = !data.isEmpty() && store->open("mergedimage.png");
+            if (r) {
+                r = store->write(data) == data.size();
+                r &= store->close();
+            }
+        } else {
+            r = KisPNGConverter::saveDeviceToStore("mergedimage.png", image->bounds(), image->xRes(), image->yRes(), dev, store);
+        }
         savingMergedImageSuccess = savingMergedImageSuccess && r;
         store->setCompressionEnabled(KisConfig(true).compressKra());
     }
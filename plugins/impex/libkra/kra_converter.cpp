@@ -8,6 +8,7 @@
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QImage>
 #include <QScopedPointer>
 #include <QUrl>
 #include <QVersionNumber>
@@ -23,6 +24,7 @@
 #include <kis_clone_layer.h>
 #include <kis_group_layer.h>
 #include <kis_image.h>
+#include <kis_image_config.h>
 #include <kis_paint_layer.h>
 
 static const char CURRENT_DTD_VERSION[] = "2.0";
@@ -104,6 +106,10 @@ KisImportExportErrorCode KraConverter::buildImage(QIODevice *io)
         success = completeLoading(m_store);
     }
 
+    if (success) {
+        m_hasPreviewProjection = loadPreviewProjection(m_store);
+    }
+
     fixCloneLayers(m_image, m_image->root());
 
     return success ? ImportExportCodes::OK : ImportExportCodes::Failure;
@@ -134,6 +140,11 @@ StoryboardCommentList KraConverter::storyboardCommentList()
     return m_storyboardCommentList;
 }
 
+bool KraConverter::hasPreviewProjection() const
+{
+    return m_hasPreviewProjection;
+}
+
 KisImportExportErrorCode KraConverter::buildFile(QIODevice *io, const QString &filename, bool addMergedImage)
 {
     if (m_image->size().isEmpty()) {
@@ -464,6 +475,37 @@ bool KraConverter::completeLoading(KoStore* store)
     return true;
 }
 
+bool KraConverter::loadPreviewProjection(KoStore *store)
+{
+    /**
+     * When the layers are loaded lazily, composing them is the slowest
+     * part of opening the file, since all the tiles are decompressed
+     * on the way. The merged image stored in the file has exactly the
+     * same content, so it is shown until the real projection is ready.
+     */
+    if (!KisImageConfig(true).lazyLayerLoading()) return false;
+
+    /**
+     * When the root layer obliges its only child, the projection is
+     * the device of that child, which must not be overwritten.
+     */
+    KisPaintDeviceSP projection = m_image->rootLayer()->lazyDestinationForSubtreeComposition();
+    if (!projection) return false;
+
+    if (!store->hasFile("mergedimage.png") || !store->open("mergedimage.png")) return false;
+
+    const QByteArray bytes = store->read(store->size());
+    store->close();
+
+    QImage mergedImage;
+    if (!mergedImage.loadFromData(bytes, "PNG") || mergedImage.size() != m_image->size()) {
+        return false;
+    }
+
+    projection->convertFromQImage(mergedImage, 0);
+    return true;
+}
+
 void KraConverter::cancel()
 {
     m_stop = true;
@@ -44,6 +44,13 @@ public:
     StoryboardItemList storyboardItemList();
     StoryboardCommentList storyboardCommentList();
 
+    /**
+     * Returns true if the projection of the image has been filled with
+     * the merged image stored in the file. In such a case the image can
+     * be shown to the user before its layers are composed.
+     */
+    bool hasPreviewProjection() const;
+
 public Q_SLOTS:
 
     virtual void cancel();
@@ -57,6 +64,7 @@ private:
     KisImportExportErrorCode oldLoadAndParse(KoStore *store, const QString &filename, QDomDocument &xmldoc);
     KisImportExportErrorCode loadXML(const QDomDocument &doc, KoStore *store);
     bool completeLoading(KoStore *store);
+    bool loadPreviewProjection(KoStore *store);
 
     void setProgress(int progress);
 
@@ -68,6 +76,7 @@ private:
     StoryboardItemList m_storyboardItemList;
     StoryboardCommentList m_storyboardCommentList;
     bool m_stop {false};
+    bool m_hasPreviewProjection {false};
 
     KoStore *m_store {0};
     KisKraSaver *m_kraSaver {0};
@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_kra_saver_benchmark.h"
+
+#include <simpletest.h>
+#include <testui.h>
+
+#include <QThread>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoColor.h>
+
+#include <KisDocument.h>
+#include <KisPart.h>
+#include "kis_image.h"
+#include "kis_group_layer.h"
+#include "kis_paint_layer.h"
+#include "kis_paint_device.h"
+#include "kis_sequential_iterator.h"
+#include "kis_image_config.h"
+
+namespace {
+
+const int imageWidth = 4096;
+const int imageHeight = 4096;
+const int numLayers = 24;
+
+/**
+ * Fills the device with a mix of flat areas and noise, so that
+ * the tiles are neither empty nor trivially compressible
+ */
+void fillLayer(KisPaintDeviceSP dev, int seed)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+
+    KoColor background(QColor::fromHsv((seed * 47) % 360, 200, 200), cs);
+    dev->fill(QRect(0, 0, imageWidth, imageHeight), background);
+
+    const QRect noiseRect(seed * 97 % (imageWidth / 2), seed * 61 % (imageHeight / 2),
+                          imageWidth / 2, imageHeight / 2);
+
+    quint32 state = 0x9E3779B9u * (seed + 1);
+
+    KisSequentialIterator it(dev, noiseRect);
+    while (it.nextPixel()) {
+        quint8 *pixel = it.rawData();
+        for (quint32 i = 0; i < cs->pixelSize(); i++) {
+            state = state * 1664525u + 1013904223u;
+            pixel[i] = quint8(state >> 24);
+        }
+    }
+}
+
+}
+
+void KisKraSaverBenchmark::initTestCase()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageWidth, imageHeight, cs, "kra saving benchmark");
+
+    for (int i = 0; i < numLayers; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8);
+        fillLayer(layer->paintDevice(), i);
+        image->addNode(layer, image->rootLayer());
+    }
+
+    image->initialRefreshGraph();
+
+    m_doc.reset(KisPart::instance()->createDocument());
+    m_doc->setCurrentImage(image);
+
+    m_oldNumThreads = KisImageConfig(true).maxNumberOfThreads();
+}
+
+void KisKraSaverBenchmark::cleanupTestCase()
+{
+    KisImageConfig(false).setMaxNumberOfThreads(m_oldNumThreads);
+    m_doc.reset();
+}
+
+void KisKraSaverBenchmark::benchmarkSave_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads = 1; numThreads <= QThread::idealThreadCount(); numThreads *= 2) {
+        QTest::addRow("%d threads", numThreads) << numThreads;
+    }
+}
+
+void KisKraSaverBenchmark::benchmarkSave()
+{
+    QFETCH(int, numThreads);
+
+    KisImageConfig(false).setMaxNumberOfThreads(numThreads);
+
+    QBENCHMARK_ONCE {
+        QVERIFY(m_doc->exportDocumentSync("kra_saver_benchmark.kra", m_doc->mimeType()));
+    }
+}
+
+KISTEST_MAIN(KisKraSaverBenchmark)
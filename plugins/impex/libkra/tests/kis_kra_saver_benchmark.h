@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_KRA_SAVER_BENCHMARK_H
+#define KIS_KRA_SAVER_BENCHMARK_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+class KisDocument;
+
+class KisKraSaverBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkSave_data();
+    void benchmarkSave();
+
+private:
+    QScopedPointer<KisDocument> m_doc;
+    int m_oldNumThreads = 0;
+};
+
+#endif // KIS_KRA_SAVER_BENCHMARK_H
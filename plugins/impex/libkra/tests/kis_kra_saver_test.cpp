@@ -572,4 +572,62 @@ void KisKraSaverTest::testExportToReadonly()
     TestUtil::testExportToReadonly(KraMimetype);
 }
 
+#include <KoStore.h>
+#include "kis_image_config.h"
+
+namespace {
+
+QList<QPair<QString, QByteArray>> readStoreEntries(const QString &fileName)
+{
+    QList<QPair<QString, QByteArray>> result;
+
+    QScopedPointer<KoStore> store(KoStore::createStore(fileName, KoStore::Read, "", KoStore::Zip));
+    if (!store || store->bad()) return result;
+
+    Q_FOREACH (const QString &entry, store->directoryList()) {
+        // document info contains the saving date
+        if (entry.endsWith('/') || entry == "documentinfo.xml") continue;
+
+        QByteArray data;
+        if (store->open(entry)) {
+            data = store->read(store->size());
+            store->close();
+        }
+        result << qMakePair(entry, data);
+    }
+
+    return result;
+}
+
+}
+
+void KisKraSaverTest::testParallelSaveIsIdentical()
+{
+    QScopedPointer<KisDocument> doc(createCompleteDocument());
+    doc->image()->waitForDone();
+
+    KisImageConfig cfg(false);
+    const int oldNumThreads = cfg.maxNumberOfThreads();
+
+    cfg.setMaxNumberOfThreads(1);
+    QVERIFY(doc->exportDocumentSync("serialsavetest.kra", doc->mimeType()));
+
+    cfg.setMaxNumberOfThreads(8);
+    QVERIFY(doc->exportDocumentSync("parallelsavetest.kra", doc->mimeType()));
+
+    cfg.setMaxNumberOfThreads(oldNumThreads);
+
+    const QList<QPair<QString, QByteArray>> serialEntries = readStoreEntries("serialsavetest.kra");
+    const QList<QPair<QString, QByteArray>> parallelEntries = readStoreEntries("parallelsavetest.kra");
+
+    QVERIFY(!serialEntries.isEmpty());
+    QCOMPARE(parallelEntries.size(), serialEntries.size());
+
+    for (int i = 0; i < serialEntries.size(); i++) {
+        QCOMPARE(parallelEntries[i].first, serialEntries[i].first);
+        QVERIFY2(parallelEntries[i].second == serialEntries[i].second,
+                 qPrintable(serialEntries[i].first));
+    }
+}
+
 KISTEST_MAIN(KisKraSaverTest)
@@ -30,6 +30,8 @@ KisDabRenderingJob::KisDabRenderingJob(const KisDabRenderingJob &rhs)
       type(rhs.type),
       originalDevice(rhs.originalDevice),
       postprocessedDevice(rhs.postprocessedDevice),
+      useSharedCache(rhs.useSharedCache),
+      sharedCacheKey(rhs.sharedCacheKey),
       status(rhs.status),
       opacity(rhs.opacity),
       flow(rhs.flow)
@@ -43,6 +45,8 @@ KisDabRenderingJob &KisDabRenderingJob::operator=(const KisDabRenderingJob &rhs)
     type = rhs.type;
     originalDevice = rhs.originalDevice;
     postprocessedDevice = rhs.postprocessedDevice;
+    useSharedCache = rhs.useSharedCache;
+    sharedCacheKey = rhs.sharedCacheKey;
     status = rhs.status;
     opacity = rhs.opacity;
     flow = rhs.flow;
@@ -95,7 +99,21 @@ int KisDabRenderingJobRunner::executeOneJob(KisDabRenderingJob *job,
         // TODO: thing about better interface for the reverse queue link
         job->originalDevice = parentQueue->fetchCachedPaintDevice();
 
-        generateDab(job->generationInfo, resources, &job->originalDevice);
+        KisFixedPaintDeviceSP sharedDab =
+            job->useSharedCache ? KisDabMaskCache::instance()->fetch(job->sharedCacheKey) : 0;
+
+        if (sharedDab) {
+            *job->originalDevice = *sharedDab;
+            job->generationInfo.dstDabRect =
+                correctDabRectWhenFetchedFromCache(job->generationInfo.dstDabRect,
+                                                   job->originalDevice->bounds().size());
+        } else {
+            generateDab(job->generationInfo, resources, &job->originalDevice);
+
+            if (job->useSharedCache) {
+                KisDabMaskCache::instance()->store(job->sharedCacheKey, job->originalDevice);
+            }
+        }
     }
 
     // by now the original device should be already prepared
@@ -9,6 +9,7 @@
 
 #include <QRunnable>
 #include <KisDabCacheUtils.h>
+#include <KisDabMaskCache.h>
 #include <kis_fixed_paint_device.h>
 #include <kis_types.h>
 #include "kritadefaultpaintops_export.h"
@@ -45,6 +46,10 @@ public:
     KisFixedPaintDeviceSP originalDevice;
     KisFixedPaintDeviceSP postprocessedDevice;
 
+    /// the dab may be fetched from (or stored into) the shared KisDabMaskCache
+    bool useSharedCache = false;
+    KisDabMaskCache::Key sharedCacheKey;
+
     // high-level members, not directly related to job execution itself
     Status status = New;
 
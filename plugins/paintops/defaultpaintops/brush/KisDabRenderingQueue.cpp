@@ -145,6 +145,11 @@ KisDabRenderingJobSP KisDabRenderingQueue::addDab(const KisDabCacheUtils::DabReq
     bool shouldUseCache = false;
     m_d->cacheInterface->getDabType(lastDabJobIndex >= 0, resources, request, &job->generationInfo, &shouldUseCache);
 
+    if (!shouldUseCache) {
+        job->useSharedCache =
+            m_d->cacheInterface->getSharedCacheKey(m_d->colorSpace, resources, &job->sharedCacheKey);
+    }
+
     m_d->putResourcesToCache(resources);
     resources = nullptr;
 
@@ -16,6 +16,7 @@ class KisDabRenderingJob;
 struct KisRenderedDab;
 
 #include "KisDabCacheUtils.h"
+#include "KisDabMaskCache.h"
 
 class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingQueue
 {
@@ -30,6 +31,24 @@ public:
                                 bool *shouldUseCache) = 0;
 
         virtual bool hasSeparateOriginal(KisDabCacheUtils::DabRenderingResources *resources) const = 0;
+
+        /**
+         * Calculates the key of the dab, whose type has been fetched by
+         * the last call to getDabType(), in the process-wide
+         * KisDabMaskCache. The default implementation doesn't share
+         * any dabs.
+         *
+         * @return false if the dab cannot be shared
+         */
+        virtual bool getSharedCacheKey(const KoColorSpace *cs,
+                                       KisDabCacheUtils::DabRenderingResources *resources,
+                                       /* out */
+                                       KisDabMaskCache::Key *key) {
+            Q_UNUSED(cs);
+            Q_UNUSED(resources);
+            Q_UNUSED(key);
+            return false;
+        }
     };
 
 
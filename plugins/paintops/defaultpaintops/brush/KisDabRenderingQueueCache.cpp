@@ -11,6 +11,12 @@ struct KisDabRenderingQueueCache::Private
     Private()
     {
     }
+
+    /**
+     * All the resources of the queue are created from the same brush
+     * settings, so the key of the brush is calculated only once
+     */
+    QByteArray brushKey;
 };
 
 KisDabRenderingQueueCache::KisDabRenderingQueueCache()
@@ -31,3 +37,12 @@ bool KisDabRenderingQueueCache::hasSeparateOriginal(KisDabCacheUtils::DabRenderi
 {
     return needSeparateOriginal(resources->textureOption.data(), resources->sharpnessOption.data());
 }
+
+bool KisDabRenderingQueueCache::getSharedCacheKey(const KoColorSpace *cs, KisDabCacheUtils::DabRenderingResources *resources, KisDabMaskCache::Key *key)
+{
+    if (m_d->brushKey.isEmpty()) {
+        m_d->brushKey = KisDabMaskCache::brushKey(resources->brush);
+    }
+
+    return fetchSharedCacheKey(cs, m_d->brushKey, false, key);
+}
@@ -29,6 +29,11 @@ public:
 
     bool hasSeparateOriginal(KisDabCacheUtils::DabRenderingResources *resources) const override;
 
+    bool getSharedCacheKey(const KoColorSpace *cs,
+                           KisDabCacheUtils::DabRenderingResources *resources,
+                           /* out */
+                           KisDabMaskCache::Key *key) override;
+
 private:
     struct Private;
     QScopedPointer<Private> m_d;
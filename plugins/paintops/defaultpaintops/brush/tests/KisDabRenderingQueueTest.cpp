@@ -486,6 +486,67 @@ void KisDabRenderingQueueTest::testRunningJobs()
     QCOMPARE(renderedDabs[1].offset, QPoint(15,15));
 }
 
+void KisDabRenderingQueueTest::testSharedCache()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisDabMaskCache *sharedCache = KisDabMaskCache::instance();
+    sharedCache->clear();
+    sharedCache->resetStatistics();
+
+    KoColor color(Qt::red, cs);
+    QPointF pos1(10,10);
+    QPointF pos2(20,20);
+    KisDabShape shape;
+    KisPaintInformation pi1(pos1);
+    KisPaintInformation pi2(pos2);
+
+    KisDabCacheUtils::DabRequestInfo request1(color, pos1, shape, pi1, 1.0);
+    KisDabCacheUtils::DabRequestInfo request2(color, pos2, shape, pi2, 1.0);
+
+    // the first stroke generates the dab and puts it into the shared cache
+    KisDabRenderingQueue queue1(cs, testResourcesFactory);
+    queue1.setCacheInterface(new KisDabRenderingQueueCache());
+
+    KisDabRenderingJobSP job1 = queue1.addDab(request1, OPACITY_OPAQUE_F, OPACITY_OPAQUE_F);
+    QVERIFY(job1);
+    QVERIFY(job1->useSharedCache);
+
+    KisDabRenderingJobRunner runner1(job1, &queue1, 0);
+    runner1.run();
+
+    QCOMPARE(sharedCache->statistics().hits, qint64(0));
+    QCOMPARE(sharedCache->statistics().misses, qint64(1));
+
+    // the second stroke with the same brush fetches the dab from the shared cache
+    KisDabRenderingQueue queue2(cs, testResourcesFactory);
+    queue2.setCacheInterface(new KisDabRenderingQueueCache());
+
+    KisDabRenderingJobSP job2 = queue2.addDab(request2, OPACITY_OPAQUE_F, OPACITY_OPAQUE_F);
+    QVERIFY(job2);
+    QVERIFY(job2->useSharedCache);
+    QVERIFY(job2->sharedCacheKey == job1->sharedCacheKey);
+
+    KisDabRenderingJobRunner runner2(job2, &queue2, 0);
+    runner2.run();
+
+    QCOMPARE(sharedCache->statistics().hits, qint64(1));
+    QCOMPARE(sharedCache->statistics().misses, qint64(1));
+
+    QVERIFY(job1->originalDevice != job2->originalDevice);
+    QCOMPARE(job2->originalDevice->bounds(), job1->originalDevice->bounds());
+
+    const QRect bounds = job1->originalDevice->bounds();
+    QVERIFY(!memcmp(job1->originalDevice->data(), job2->originalDevice->data(),
+                    bounds.width() * bounds.height() * cs->pixelSize()));
+
+    QList<KisRenderedDab> renderedDabs = queue2.takeReadyDabs();
+    QCOMPARE(renderedDabs.size(), 1);
+    QCOMPARE(renderedDabs[0].offset, QPoint(15,15));
+
+    sharedCache->clear();
+}
+
 #include "../KisDabRenderingExecutor.h"
 #include "KisFakeRunnableStrokeJobsExecutor.h"
 
@@ -0,0 +1,198 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDabMaskCache.h"
+
+#include <list>
+
+#include <QCryptographicHash>
+#include <QDomDocument>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <kis_brush.h>
+#include <kis_fixed_paint_device.h>
+
+Q_GLOBAL_STATIC(KisDabMaskCache, s_instance)
+
+
+bool KisDabMaskCache::Key::operator==(const Key &rhs) const
+{
+    return precisionLevel == rhs.precisionLevel &&
+        width == rhs.width &&
+        height == rhs.height &&
+        brushIndex == rhs.brushIndex &&
+        angle == rhs.angle &&
+        subPixelX == rhs.subPixelX &&
+        subPixelY == rhs.subPixelY &&
+        softnessFactor == rhs.softnessFactor &&
+        lightnessStrength == rhs.lightnessStrength &&
+        ratio == rhs.ratio &&
+        horizontalMirror == rhs.horizontalMirror &&
+        verticalMirror == rhs.verticalMirror &&
+        normalizedImageStamp == rhs.normalizedImageStamp &&
+        color == rhs.color &&
+        colorSpaceKey == rhs.colorSpaceKey &&
+        brushKey == rhs.brushKey;
+}
+
+uint qHash(const KisDabMaskCache::Key &key, uint seed)
+{
+    return qHash(key.brushKey, seed) ^
+        qHash(key.color, seed) ^
+        qHash(key.width, seed) ^
+        qHash(key.height << 16, seed) ^
+        qHash(key.angle, seed) ^
+        qHash((key.subPixelX << 8) ^ key.subPixelY, seed) ^
+        qHash(key.softnessFactor ^ (key.lightnessStrength << 16) ^ (key.ratio << 32), seed) ^
+        qHash(key.brushIndex ^ (key.precisionLevel << 24), seed);
+}
+
+struct KisDabMaskCache::Private
+{
+    struct Entry {
+        Key key;
+        KisFixedPaintDeviceSP dab;
+        qint64 memoryUsage = 0;
+    };
+
+    using EntriesList = std::list<Entry>;
+
+    QMutex mutex;
+
+    /// most recently used entries are stored at the front of the list
+    EntriesList entries;
+    QHash<Key, EntriesList::iterator> index;
+
+    qint64 maxMemoryUsage = 0;
+    Statistics stats;
+
+    void evictExtraEntries();
+};
+
+void KisDabMaskCache::Private::evictExtraEntries()
+{
+    while (!entries.empty() && stats.memoryUsage > maxMemoryUsage) {
+        const Entry &entry = entries.back();
+
+        stats.memoryUsage -= entry.memoryUsage;
+        stats.evictions++;
+        index.remove(entry.key);
+        entries.pop_back();
+    }
+
+    stats.numEntries = index.size();
+}
+
+KisDabMaskCache::KisDabMaskCache(qint64 maxMemoryUsage)
+    : m_d(new Private)
+{
+    m_d->maxMemoryUsage = maxMemoryUsage;
+}
+
+KisDabMaskCache::~KisDabMaskCache()
+{
+}
+
+KisDabMaskCache *KisDabMaskCache::instance()
+{
+    return s_instance;
+}
+
+QByteArray KisDabMaskCache::brushKey(KisBrushSP brush)
+{
+    QDomDocument doc;
+    QDomElement element = doc.createElement("brush_definition");
+    brush->toXML(doc, element);
+    doc.appendChild(element);
+
+    return QCryptographicHash::hash(doc.toByteArray(), QCryptographicHash::Md5);
+}
+
+KisFixedPaintDeviceSP KisDabMaskCache::fetch(const Key &key)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    auto it = m_d->index.find(key);
+    if (it == m_d->index.end()) {
+        m_d->stats.misses++;
+        return KisFixedPaintDeviceSP();
+    }
+
+    m_d->stats.hits++;
+
+    Private::EntriesList::iterator entry = it.value();
+    m_d->entries.splice(m_d->entries.begin(), m_d->entries, entry);
+
+    return entry->dab;
+}
+
+void KisDabMaskCache::store(const Key &key, KisFixedPaintDeviceSP dab)
+{
+    const QRect bounds = dab->bounds();
+    const qint64 memoryUsage = qint64(bounds.width()) * bounds.height() * dab->pixelSize();
+
+    KisFixedPaintDeviceSP copy = new KisFixedPaintDevice(*dab);
+
+    QMutexLocker l(&m_d->mutex);
+
+    if (memoryUsage > m_d->maxMemoryUsage) return;
+
+    auto it = m_d->index.find(key);
+    if (it != m_d->index.end()) {
+        Private::EntriesList::iterator entry = it.value();
+        m_d->stats.memoryUsage -= entry->memoryUsage;
+        m_d->entries.erase(entry);
+        m_d->index.erase(it);
+    }
+
+    m_d->entries.push_front({key, copy, memoryUsage});
+    m_d->index.insert(key, m_d->entries.begin());
+    m_d->stats.memoryUsage += memoryUsage;
+
+    m_d->evictExtraEntries();
+}
+
+void KisDabMaskCache::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->entries.clear();
+    m_d->index.clear();
+    m_d->stats.memoryUsage = 0;
+    m_d->stats.numEntries = 0;
+}
+
+void KisDabMaskCache::setMaxMemoryUsage(qint64 value)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->maxMemoryUsage = value;
+    m_d->evictExtraEntries();
+}
+
+qint64 KisDabMaskCache::maxMemoryUsage() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->maxMemoryUsage;
+}
+
+KisDabMaskCache::Statistics KisDabMaskCache::statistics() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->stats;
+}
+
+void KisDabMaskCache::resetStatistics()
+{
+    QMutexLocker l(&m_d->mutex);
+
+    m_d->stats.hits = 0;
+    m_d->stats.misses = 0;
+    m_d->stats.evictions = 0;
+}
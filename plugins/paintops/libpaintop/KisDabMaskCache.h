@@ -0,0 +1,120 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDABMASKCACHE_H
+#define KISDABMASKCACHE_H
+
+#include "kritapaintop_export.h"
+
+#include <QByteArray>
+#include <QScopedPointer>
+
+#include <kis_types.h>
+
+
+/**
+ * @brief KisDabMaskCache is a process-wide LRU cache of generated dabs
+ *
+ * KisDabCacheBase can reuse only the previously generated dab, so any
+ * pressure-dependent stroke regenerates the mask for every single dab.
+ * KisDabMaskCache keeps the dabs generated for the recent requests,
+ * keyed by the parameters quantised according to the precision level
+ * of the brush, so the dabs of the same size, angle and sub-pixel phase
+ * are reused across the whole stroke and across the following strokes
+ * painted with the same preset.
+ *
+ * The dabs are stored *before* any postprocessing (texture, sharpness)
+ * is applied. The stored devices are never modified, so the caller
+ * should copy the data into its own device before modifying it.
+ *
+ * The cache is thread-safe.
+ */
+class PAINTOP_EXPORT KisDabMaskCache
+{
+public:
+    struct Key {
+        /// identity of the brush tip, see KisDabMaskCache::brushKey()
+        QByteArray brushKey;
+        QByteArray colorSpaceKey;
+        QByteArray color;
+
+        /**
+         * The quantisation steps of all the other values depend on the
+         * precision level, so the level must be a part of the key
+         */
+        int precisionLevel = 0;
+
+        int width = 0;
+        int height = 0;
+        int brushIndex = 0;
+
+        qint64 angle = 0;
+        qint64 subPixelX = 0;
+        qint64 subPixelY = 0;
+        qint64 softnessFactor = 0;
+        qint64 lightnessStrength = 0;
+        qint64 ratio = 0;
+
+        bool horizontalMirror = false;
+        bool verticalMirror = false;
+        bool normalizedImageStamp = false;
+
+        bool operator==(const Key &rhs) const;
+    };
+
+    struct Statistics {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 evictions = 0;
+        int numEntries = 0;
+        qint64 memoryUsage = 0;
+
+        qreal hitRate() const {
+            return hits + misses > 0 ? qreal(hits) / (hits + misses) : 0.0;
+        }
+    };
+
+public:
+    KisDabMaskCache(qint64 maxMemoryUsage = 64 * 1024 * 1024);
+    ~KisDabMaskCache();
+
+    static KisDabMaskCache* instance();
+
+    /**
+     * Calculates the identity of the brush tip. The brush is cloned for
+     * every stroke, so the key is based on the serialized brush definition
+     * rather than on the brush object itself.
+     */
+    static QByteArray brushKey(KisBrushSP brush);
+
+    /**
+     * @return the dab stored under \p key or a null pointer if there
+     * is no such dab. The returned device must not be modified.
+     */
+    KisFixedPaintDeviceSP fetch(const Key &key);
+
+    /**
+     * Stores a copy of \p dab under \p key, evicting the least recently
+     * used dabs if the cache exceeds its memory limit
+     */
+    void store(const Key &key, KisFixedPaintDeviceSP dab);
+
+    void clear();
+
+    void setMaxMemoryUsage(qint64 value);
+    qint64 maxMemoryUsage() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+PAINTOP_EXPORT uint qHash(const KisDabMaskCache::Key &key, uint seed = 0);
+
+#endif // KISDABMASKCACHE_H
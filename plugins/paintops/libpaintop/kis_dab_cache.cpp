@@ -13,6 +13,7 @@
 #include "kis_color_source.h"
 #include "KisSharpnessOption.h"
 #include "kis_texture_option.h"
+#include "KisDabMaskCache.h"
 
 #include <kundo2command.h>
 
@@ -32,6 +33,16 @@ struct KisDabCache::Private {
 
     KisSharpnessOption *sharpnessOption = 0;
     KisTextureOption *textureOption = 0;
+
+    bool useSharedCache = true;
+    QByteArray brushKey;
+
+    const QByteArray& sharedBrushKey() {
+        if (brushKey.isEmpty()) {
+            brushKey = KisDabMaskCache::brushKey(brush);
+        }
+        return brushKey;
+    }
 };
 
 
@@ -61,6 +72,16 @@ bool KisDabCache::needSeparateOriginal() const
     return KisDabCacheBase::needSeparateOriginal(m_d->textureOption, m_d->sharpnessOption);
 }
 
+void KisDabCache::setSharedCacheEnabled(bool value)
+{
+    m_d->useSharedCache = value;
+}
+
+bool KisDabCache::sharedCacheEnabled() const
+{
+    return m_d->useSharedCache;
+}
+
 
 KisFixedPaintDeviceSP KisDabCache::fetchDab(const KoColorSpace *cs,
         KisColorSource *colorSource,
@@ -215,9 +236,27 @@ KisFixedPaintDeviceSP KisDabCache::fetchDabCommon(const KoColorSpace *cs,
         return fetchFromCache(&resources, info, dstDabRect);
     }
 
-    // 3. Generate new dab
+    // 3. Try to fetch the dab from the shared cache or generate a new one
+
+    KisDabMaskCache::Key sharedCacheKey;
+    const bool useSharedCache =
+        m_d->useSharedCache &&
+        fetchSharedCacheKey(cs, m_d->sharedBrushKey(),
+                            forceNormalizedRGBAImageStamp, &sharedCacheKey);
+
+    KisFixedPaintDeviceSP sharedDab =
+        useSharedCache ? KisDabMaskCache::instance()->fetch(sharedCacheKey) : 0;
 
-    generateDab(di, &resources, &m_d->dab, forceNormalizedRGBAImageStamp);
+    if (sharedDab) {
+        *m_d->dab = *sharedDab;
+        *dstDabRect = correctDabRectWhenFetchedFromCache(*dstDabRect, m_d->dab->bounds().size());
+    } else {
+        generateDab(di, &resources, &m_d->dab, forceNormalizedRGBAImageStamp);
+
+        if (useSharedCache) {
+            KisDabMaskCache::instance()->store(sharedCacheKey, m_d->dab);
+        }
+    }
 
     // 4. Do postprocessing
     if (di.needsPostprocessing) {
@@ -227,7 +266,7 @@ KisFixedPaintDeviceSP KisDabCache::fetchDabCommon(const KoColorSpace *cs,
 
         *m_d->dabOriginal = *m_d->dab;
 
-        postProcessDab(m_d->dab, di.dstDabRect.topLeft(), info, &resources);
+        postProcessDab(m_d->dab, dstDabRect->topLeft(), info, &resources);
     }
 
     return m_d->dab;
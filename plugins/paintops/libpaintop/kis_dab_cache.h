@@ -75,6 +75,13 @@ public:
 
     bool needSeparateOriginal() const;
 
+    /**
+     * Enables reusing the dabs from the process-wide KisDabMaskCache,
+     * which is shared between all the strokes. Enabled by default.
+     */
+    void setSharedCacheEnabled(bool value);
+    bool sharedCacheEnabled() const;
+
 private:
 
     inline KisFixedPaintDeviceSP fetchFromCache(KisDabCacheUtils::DabRenderingResources *resources, const KisPaintInformation& info,
@@ -7,6 +7,8 @@
 #include "kis_dab_cache_base.h"
 
 #include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorProfile.h>
 #include "kis_color_source.h"
 #include "kis_paint_device.h"
 #include "kis_brush.h"
@@ -19,6 +21,8 @@
 
 #include <kundo2command.h>
 
+#include <QtMath>
+
 struct PrecisionValues {
     qreal angle;
     qreal sizeFrac;
@@ -81,6 +85,8 @@ struct KisDabCacheBase::Private {
     bool subPixelPrecisionDisabled;
 
     SavedDabParameters lastSavedDabParameters;
+    int lastPrecisionLevel = 4;
+    bool lastDabIsShareable = false;
 
     static qreal positiveFraction(qreal x);
 };
@@ -281,8 +287,75 @@ void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
 
     if (!*shouldUseCache) {
         m_d->lastSavedDabParameters = newParams;
+        m_d->lastPrecisionLevel = precisionLevel;
+        m_d->lastDabIsShareable = supportsCaching && di->solidColorFill;
     }
 
     di->needsPostprocessing = needSeparateOriginal(resources->textureOption.data(), resources->sharpnessOption.data());
 }
 
+
+namespace {
+inline qint64 quantize(qreal value, qreal step)
+{
+    return qFloor(value / step);
+}
+
+inline int quantizeSize(int size, qreal sizeFrac)
+{
+    /**
+     * The size tolerance is relative, so the buckets are distributed
+     * exponentially
+     */
+    return sizeFrac > 0 ? qFloor(std::log(qMax(1, size)) / std::log1p(sizeFrac)) : size;
+}
+}
+
+bool KisDabCacheBase::fetchSharedCacheKey(const KoColorSpace *cs,
+                                          const QByteArray &brushKey,
+                                          bool forceNormalizedRGBAImageStamp,
+                                          KisDabMaskCache::Key *key) const
+{
+    if (!m_d->lastDabIsShareable) return false;
+
+    const SavedDabParameters &params = m_d->lastSavedDabParameters;
+    const PrecisionValues &prec = precisionLevels[m_d->lastPrecisionLevel];
+
+    key->brushKey = brushKey;
+
+    key->colorSpaceKey = cs->id().toLatin1();
+    if (cs->profile()) {
+        key->colorSpaceKey += cs->profile()->name().toUtf8();
+    }
+
+    if (params.color.colorSpace()) {
+        key->colorSpaceKey += params.color.colorSpace()->id().toLatin1();
+        key->color = QByteArray(reinterpret_cast<const char*>(params.color.data()),
+                                params.color.colorSpace()->pixelSize());
+    } else {
+        key->color.clear();
+    }
+
+    key->precisionLevel = m_d->lastPrecisionLevel;
+    key->width = quantizeSize(params.width, prec.sizeFrac);
+    key->height = quantizeSize(params.height, prec.sizeFrac);
+    key->brushIndex = params.index;
+
+    /**
+     * The sub-pixel offset is quantised into phases: with the default
+     * precision levels the whole pixel is a single phase, level 4 has two
+     * phases per axis and the precise level keeps the exact offset.
+     */
+    key->angle = qRound64(params.angle / prec.angle);
+    key->subPixelX = quantize(params.subPixelX, prec.subPixel);
+    key->subPixelY = quantize(params.subPixelY, prec.subPixel);
+    key->softnessFactor = qRound64(params.softnessFactor / prec.softnessFactor);
+    key->lightnessStrength = qRound64(params.lightnessStrength / prec.lightnessStrength);
+    key->ratio = qRound64(params.ratio / prec.ratio);
+
+    key->horizontalMirror = params.mirrorProperties.horizontalMirror;
+    key->verticalMirror = params.mirrorProperties.verticalMirror;
+    key->normalizedImageStamp = forceNormalizedRGBAImageStamp;
+
+    return true;
+}
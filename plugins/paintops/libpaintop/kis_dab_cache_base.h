@@ -11,6 +11,7 @@
 #include "kis_brush.h"
 
 #include "KisDabCacheUtils.h"
+#include "KisDabMaskCache.h"
 
 class KisColorSource;
 class KisSharpnessOption;
@@ -86,6 +87,26 @@ protected:
                                 KisDabCacheUtils::DabGenerationInfo *di,
                                 bool *shouldUseCache);
 
+    /**
+     * Calculates the key of the dab, whose generation info has been fetched
+     * by the last call to fetchDabGenerationInfo(), in the shared
+     * KisDabMaskCache. The parameters of the dab are quantised according
+     * to the current precision level, so the dabs that would be reused by
+     * fetchDabGenerationInfo() get the same key.
+     *
+     * @param cs the color space of the dab
+     * @param brushKey identity of the brush, see KisDabMaskCache::brushKey()
+     * @param forceNormalizedRGBAImageStamp the dab is generated as a normalized image stamp
+     * @param key (OUT) the calculated key
+     * @return false if the dab cannot be shared, e.g. when the brush doesn't
+     *         support caching or the dab is filled with a non-uniform color source
+     */
+    bool fetchSharedCacheKey(const KoColorSpace *cs,
+                             const QByteArray &brushKey,
+                             bool forceNormalizedRGBAImageStamp,
+                             /* out */
+                             KisDabMaskCache::Key *key) const;
+
 private:
     struct SavedDabParameters;
     struct DabPosition;
@@ -0,0 +1,236 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisDabMaskCacheTest.h"
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_auto_brush.h>
+#include <kis_circle_mask_generator.h>
+#include <kis_dab_cache.h>
+#include <kis_dab_shape.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_paint_information.h>
+#include <kis_precision_option.h>
+#include <kis_properties_configuration.h>
+#include <KisDabMaskCache.h>
+
+namespace {
+
+KisFixedPaintDeviceSP createDab(int size, quint8 value)
+{
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+    dab->setRect(QRect(0, 0, size, size));
+    dab->lazyGrowBufferWithoutInitialization();
+    memset(dab->data(), value, size * size);
+    return dab;
+}
+
+KisDabMaskCache::Key createKey(int width)
+{
+    KisDabMaskCache::Key key;
+    key.brushKey = "brush";
+    key.width = width;
+    key.height = width;
+    return key;
+}
+
+}
+
+void KisDabMaskCacheTest::testLruEviction()
+{
+    // every dab takes 100 bytes, so only two of them fit into the cache
+    KisDabMaskCache cache(250);
+
+    cache.store(createKey(1), createDab(10, 1));
+    cache.store(createKey(2), createDab(10, 2));
+
+    QCOMPARE(cache.statistics().numEntries, 2);
+    QCOMPARE(cache.statistics().memoryUsage, qint64(200));
+
+    // make the first dab the most recently used one
+    QVERIFY(cache.fetch(createKey(1)));
+
+    cache.store(createKey(3), createDab(10, 3));
+
+    QCOMPARE(cache.statistics().numEntries, 2);
+    QCOMPARE(cache.statistics().evictions, qint64(1));
+    QCOMPARE(cache.statistics().memoryUsage, qint64(200));
+
+    QVERIFY(!cache.fetch(createKey(2)));
+
+    KisFixedPaintDeviceSP dab1 = cache.fetch(createKey(1));
+    KisFixedPaintDeviceSP dab3 = cache.fetch(createKey(3));
+
+    QVERIFY(dab1);
+    QVERIFY(dab3);
+    QCOMPARE(*dab1->data(), quint8(1));
+    QCOMPARE(*dab3->data(), quint8(3));
+
+    // replacing a dab under the same key doesn't evict anything
+    cache.store(createKey(1), createDab(10, 4));
+
+    QCOMPARE(cache.statistics().numEntries, 2);
+    QCOMPARE(cache.statistics().evictions, qint64(1));
+    QCOMPARE(*cache.fetch(createKey(1))->data(), quint8(4));
+
+    // now the third dab is the least recently used one
+    cache.store(createKey(5), createDab(10, 5));
+
+    QVERIFY(!cache.fetch(createKey(3)));
+    QVERIFY(cache.fetch(createKey(1)));
+    QVERIFY(cache.fetch(createKey(5)));
+}
+
+void KisDabMaskCacheTest::testMemoryLimit()
+{
+    KisDabMaskCache cache(250);
+
+    // the dab is bigger than the whole cache
+    cache.store(createKey(1), createDab(20, 1));
+
+    QCOMPARE(cache.statistics().numEntries, 0);
+    QVERIFY(!cache.fetch(createKey(1)));
+
+    cache.store(createKey(2), createDab(10, 2));
+    cache.store(createKey(3), createDab(10, 3));
+
+    cache.setMaxMemoryUsage(150);
+
+    QCOMPARE(cache.statistics().numEntries, 1);
+    QCOMPARE(cache.statistics().memoryUsage, qint64(100));
+    QVERIFY(!cache.fetch(createKey(2)));
+    QVERIFY(cache.fetch(createKey(3)));
+
+    // the cache stores a copy of the dab
+    KisFixedPaintDeviceSP dab = createDab(10, 6);
+    cache.store(createKey(6), dab);
+    memset(dab->data(), 7, 100);
+
+    QCOMPARE(*cache.fetch(createKey(6))->data(), quint8(6));
+}
+
+void KisDabMaskCacheTest::testKeyEquality()
+{
+    const KisDabMaskCache::Key base = createKey(10);
+
+    QVERIFY(base == createKey(10));
+    QCOMPARE(qHash(base), qHash(createKey(10)));
+
+    QVector<KisDabMaskCache::Key> keys;
+
+    /**
+     * The values are quantised with the steps of the precision level, so
+     * the same numbers may mean different dabs on different levels
+     */
+    keys << base; keys.last().precisionLevel = 1;
+    keys << base; keys.last().angle = 1;
+    keys << base; keys.last().subPixelX = 1;
+    keys << base; keys.last().subPixelY = 1;
+    keys << base; keys.last().width = 11;
+    keys << base; keys.last().height = 11;
+    keys << base; keys.last().ratio = 1;
+    keys << base; keys.last().softnessFactor = 1;
+    keys << base; keys.last().lightnessStrength = 1;
+    keys << base; keys.last().brushIndex = 1;
+    keys << base; keys.last().horizontalMirror = true;
+    keys << base; keys.last().verticalMirror = true;
+    keys << base; keys.last().normalizedImageStamp = true;
+    keys << base; keys.last().color = "color";
+    keys << base; keys.last().colorSpaceKey = "cs";
+    keys << base; keys.last().brushKey = "another brush";
+
+    for (int i = 0; i < keys.size(); i++) {
+        QVERIFY2(!(keys[i] == base), qPrintable(QString("key %1 aliases the base key").arg(i)));
+    }
+}
+
+void KisDabMaskCacheTest::testDabsDoNotAlias_data()
+{
+    QTest::addColumn<int>("precisionLevel");
+    QTest::addColumn<QPointF>("pos1");
+    QTest::addColumn<QPointF>("pos2");
+    QTest::addColumn<qreal>("scale1");
+    QTest::addColumn<qreal>("scale2");
+    QTest::addColumn<qreal>("angle1");
+    QTest::addColumn<qreal>("angle2");
+
+    const QPointF pos(100.0, 100.0);
+
+    QTest::addRow("precise-subpixel") << 5 << pos << pos + QPointF(0.3, 0.0) << 1.0 << 1.0 << 0.0 << 0.0;
+    QTest::addRow("precise-angle") << 5 << pos << pos << 1.0 << 1.0 << 0.0 << 0.01;
+    QTest::addRow("precise-scale") << 5 << pos << pos << 1.0 << 1.05 << 0.0 << 0.0;
+
+    // level 4 has two sub-pixel phases per axis
+    QTest::addRow("level4-subpixel") << 4 << pos + QPointF(0.1, 0.0) << pos + QPointF(0.6, 0.0) << 1.0 << 1.0 << 0.0 << 0.0;
+    QTest::addRow("level4-angle") << 4 << pos << pos << 1.0 << 1.0 << 0.0 << 0.1;
+    QTest::addRow("level4-scale") << 4 << pos << pos << 1.0 << 1.05 << 0.0 << 0.0;
+
+    // level 1 tolerates 5% of the size difference only
+    QTest::addRow("level1-scale") << 1 << pos << pos << 1.0 << 1.5 << 0.0 << 0.0;
+    QTest::addRow("level1-angle") << 1 << pos << pos << 1.0 << 1.0 << 0.0 << 0.1;
+}
+
+void KisDabMaskCacheTest::testDabsDoNotAlias()
+{
+    QFETCH(int, precisionLevel);
+    QFETCH(QPointF, pos1);
+    QFETCH(QPointF, pos2);
+    QFETCH(qreal, scale1);
+    QFETCH(qreal, scale2);
+    QFETCH(qreal, angle1);
+    QFETCH(qreal, angle2);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColor color(Qt::black, cs);
+
+    KisCircleMaskGenerator *circle = new KisCircleMaskGenerator(40, 0.7, 0.5, 0.5, 2, false);
+    KisBrushSP brush(new KisAutoBrush(circle, 0.0, 0.0));
+
+    KisPropertiesConfiguration config;
+    KisPrecisionOption precisionOption(&config);
+    precisionOption.setPrecisionLevel(precisionLevel);
+
+    KisDabMaskCache *sharedCache = KisDabMaskCache::instance();
+    sharedCache->clear();
+    sharedCache->resetStatistics();
+
+    auto fetchDab = [&] (const QPointF &pos, qreal scale, qreal angle) {
+        // every dab is fetched by a new stroke, so the local cache is never used
+        KisDabCache cache(brush);
+        cache.setPrecisionOption(&precisionOption);
+
+        QRect dstDabRect;
+        KisFixedPaintDeviceSP dab =
+            cache.fetchDab(cs, color, pos, KisDabShape(scale, 1.0, angle),
+                           KisPaintInformation(pos, 1.0), 1.0, &dstDabRect);
+
+        return QByteArray(reinterpret_cast<const char*>(dab->data()),
+                          dab->bounds().width() * dab->bounds().height() * dab->pixelSize());
+    };
+
+    const QByteArray dab1 = fetchDab(pos1, scale1, angle1);
+    QCOMPARE(sharedCache->statistics().misses, qint64(1));
+    QCOMPARE(sharedCache->statistics().numEntries, 1);
+
+    const QByteArray dab2 = fetchDab(pos2, scale2, angle2);
+    QCOMPARE(sharedCache->statistics().hits, qint64(0));
+    QCOMPARE(sharedCache->statistics().misses, qint64(2));
+    QCOMPARE(sharedCache->statistics().numEntries, 2);
+
+    QVERIFY(dab1 != dab2);
+
+    // the same parameters are still shared between the strokes
+    QCOMPARE(fetchDab(pos1, scale1, angle1), dab1);
+    QCOMPARE(fetchDab(pos2, scale2, angle2), dab2);
+
+    QCOMPARE(sharedCache->statistics().hits, qint64(2));
+    QCOMPARE(sharedCache->statistics().misses, qint64(2));
+
+    sharedCache->clear();
+}
+
+SIMPLE_TEST_MAIN(KisDabMaskCacheTest)
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISDABMASKCACHETEST_H
+#define KISDABMASKCACHETEST_H
+
+#include <simpletest.h>
+
+class KisDabMaskCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLruEviction();
+    void testMemoryLimit();
+    void testKeyEquality();
+
+    void testDabsDoNotAlias_data();
+    void testDabsDoNotAlias();
+};
+
+#endif // KISDABMASKCACHETEST_H
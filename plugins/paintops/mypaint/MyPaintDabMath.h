@@ -0,0 +1,87 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_MYPAINT_DAB_MATH_H
+#define KIS_MYPAINT_DAB_MATH_H
+
+#include <type_traits>
+
+#include <KoMultiArchBuildSupport.h>
+
+#include "MyPaintDabMathBase.h"
+
+template<typename _impl, typename EnableDummyType = void>
+struct KisMyPaintDabMath : public KisMyPaintDabMathBase
+{
+    void calculateAlpha(const KisMyPaintDabShape &shape, int x, int y, int numPixels, float *alpha) const override
+    {
+        calculateAlphaScalar(shape, x, y, numPixels, alpha);
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+template<typename _impl>
+struct KisMyPaintDabMath<
+        _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KisMyPaintDabMathBase
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using float_m = typename float_v::batch_bool_type;
+
+    void calculateAlpha(const KisMyPaintDabShape &shape, int x, int y, int numPixels, float *alpha) const override
+    {
+        const int block = numPixels / static_cast<int>(float_v::size);
+        const int rest = numPixels % static_cast<int>(float_v::size);
+
+        const float_v vSn(shape.sn);
+        const float_v vCs(shape.cs);
+        const float_v vAspectRatio(shape.aspectRatio);
+        const float_v vOneOverRadius2(shape.oneOverRadius2);
+        const float_v vHardness(shape.hardness);
+        const float_v vSlope1(shape.slope1);
+        const float_v vSlope2(shape.slope2);
+        const float_v vOuterRadius2(shape.outerRadius2);
+        const float_v vCenterX(shape.x);
+        const float_v vHalf(0.5f);
+        const float_v vZero(0.0f);
+        const float_v vOne(1.0f);
+
+        // the row is the same for all the pixels
+        const float_v yy(y + 0.5f - shape.y);
+        const float_v dy2(float(y - shape.y) * float(y - shape.y));
+
+        const float_v increment(static_cast<float>(float_v::size));
+        float_v xp = float_v(float(x)) + xsimd::detail::make_sequence_as_batch<float_v>();
+
+        for (int i = 0; i < block; i++) {
+            const float_v xx = xp + vHalf - vCenterX;
+            const float_v yyr = (yy * vCs - xx * vSn) * vAspectRatio;
+            const float_v xxr = yy * vSn + xx * vCs;
+            const float_v rr = (yyr * yyr + xxr * xxr) * vOneOverRadius2;
+
+            const float_v dx = xp - vCenterX;
+            const float_m outsideMask = (rr > vOne) | (dx * dx + dy2 > vOuterRadius2);
+
+            const float_v value =
+                xsimd::select(rr <= vHardness,
+                              vOne + rr * vSlope1,
+                              rr * vSlope2 - vSlope2);
+
+            xsimd::select(outsideMask, vZero, value).store_unaligned(alpha);
+
+            xp = xp + increment;
+            alpha += float_v::size;
+        }
+
+        calculateAlphaScalar(shape, x + block * static_cast<int>(float_v::size), y, rest, alpha);
+    }
+};
+
+#endif /* defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KIS_MYPAINT_DAB_MATH_H
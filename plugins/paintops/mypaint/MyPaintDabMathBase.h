@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_MYPAINT_DAB_MATH_BASE_H
+#define KIS_MYPAINT_DAB_MATH_BASE_H
+
+/**
+ * Geometry of a single libmypaint dab, precalculated once per dab
+ */
+struct KisMyPaintDabShape
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float sn = 0.0f;
+    float cs = 1.0f;
+    float aspectRatio = 1.0f;
+    float oneOverRadius2 = 1.0f;
+    float hardness = 1.0f;
+    float slope1 = 0.0f;
+    float slope2 = 0.0f;
+
+    /// squared radius of the circle outside of which the dab is never painted
+    float outerRadius2 = 0.0f;
+};
+
+/**
+ * Calculates the shape of the non-antialiased (radius >= 3) libmypaint
+ * dabs row by row. The implementations are compiled for every supported
+ * instruction set, see KisMyPaintDabMathFactoryImpl.
+ */
+class KisMyPaintDabMathBase
+{
+public:
+    virtual ~KisMyPaintDabMathBase() = default;
+
+    /**
+     * Writes the base alpha (before applying the opacity) of \p numPixels
+     * pixels of row \p y, starting at column \p x, into \p alpha. The pixels
+     * outside the dab get zero alpha.
+     */
+    virtual void calculateAlpha(const KisMyPaintDabShape &shape, int x, int y, int numPixels, float *alpha) const = 0;
+
+    static inline float calculate_rr(int xp, int yp, const KisMyPaintDabShape &shape) {
+        const float yy = (yp + 0.5f - shape.y);
+        const float xx = (xp + 0.5f - shape.x);
+        const float yyr = (yy * shape.cs - xx * shape.sn) * shape.aspectRatio;
+        const float xxr = yy * shape.sn + xx * shape.cs;
+        const float rr = (yyr * yyr + xxr * xxr) * shape.oneOverRadius2;
+        /* rr is in range 0.0..1.0*sqrt(2) */
+        return rr;
+    }
+
+    static inline float calculate_alpha_for_rr(float rr, float hardness, float slope1, float slope2) {
+        if (rr > 1.0f)
+            return 0.0f;
+        else if (rr <= hardness)
+            return 1.0f + rr * slope1;
+        else
+            return rr * slope2 - slope2;
+    }
+
+    static inline bool isOutside(int xp, int yp, const KisMyPaintDabShape &shape) {
+        const float dx = xp - shape.x;
+        const float dy = yp - shape.y;
+        return dx * dx + dy * dy > shape.outerRadius2;
+    }
+
+protected:
+    static void calculateAlphaScalar(const KisMyPaintDabShape &shape, int x, int y, int numPixels, float *alpha) {
+        for (int i = 0; i < numPixels; i++) {
+            const int xp = x + i;
+
+            alpha[i] = isOutside(xp, y, shape) ? 0.0f :
+                calculate_alpha_for_rr(calculate_rr(xp, y, shape),
+                                       shape.hardness, shape.slope1, shape.slope2);
+        }
+    }
+};
+
+#endif // KIS_MYPAINT_DAB_MATH_BASE_H
@@ -0,0 +1,18 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "MyPaintDabMathFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "MyPaintDabMath.h"
+
+template<>
+KisMyPaintDabMathBase* KisMyPaintDabMathFactoryImpl::create<xsimd::current_arch>()
+{
+    return new KisMyPaintDabMath<xsimd::current_arch>();
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
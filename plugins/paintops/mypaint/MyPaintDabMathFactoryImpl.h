@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_MYPAINT_DAB_MATH_FACTORY_IMPL_H
+#define KIS_MYPAINT_DAB_MATH_FACTORY_IMPL_H
+
+#include <KoMultiArchBuildSupport.h>
+
+class KisMyPaintDabMathBase;
+
+struct KisMyPaintDabMathFactoryImpl {
+    template<typename _impl>
+    static KisMyPaintDabMathBase* create();
+};
+
+#endif // KIS_MYPAINT_DAB_MATH_FACTORY_IMPL_H
@@ -20,10 +20,22 @@
 #include <kis_paintop_plugin_utils.h>
 #include <kis_paintop_settings.h>
 #include <kis_spacing_information.h>
+#include <kis_paintop_utils.h>
+#include <kis_image_config.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobUtils.h>
+#include <kis_pointer_utils.h>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <cmath>
 #include <libmypaint/mypaint-brush.h>
 
 KisMyPaintPaintOp::KisMyPaintPaintOp(const KisPaintOpSettingsSP settings, KisPainter *painter, KisNodeSP /*node*/, KisImageSP image)
-    : KisPaintOp (painter) {
+    : KisPaintOp (painter)
+    , m_idealNumRects(KisImageConfig(true).maxNumberOfThreads())
+    , m_minUpdatePeriod(10)
+    , m_maxUpdatePeriod(100)
+    , m_currentUpdatePeriod(m_minUpdatePeriod) {
 
     m_image = image;
 
@@ -53,6 +65,10 @@ KisMyPaintPaintOp::KisMyPaintPaintOp(const KisPaintOpSettingsSP settings, KisPai
 }
 
 KisMyPaintPaintOp::~KisMyPaintPaintOp() {
+    // the stroke might have been finished without the final update
+    if (m_surface->hasQueuedDabs()) {
+        m_surface->flushQueuedDabs();
+    }
 }
 
 KisSpacingInformation KisMyPaintPaintOp::paintAt(const KisPaintInformation& info) {
@@ -104,3 +120,103 @@ KisSpacingInformation KisMyPaintPaintOp::computeSpacing(const KisPaintInformatio
                                                    false, 0.0, false, m_radius*2,
                                                    true, 1, lodScale, &m_airBrushData, nullptr, info);
 }
+
+struct KisMyPaintPaintOp::UpdateSharedState
+{
+    KisMyPaintSurface *surface = 0;
+    KisMyPaintSurface::DabsBatchSP batch;
+    QVector<QRect> allDirtyRects;
+    QElapsedTimer dabRenderingTimer;
+};
+
+std::pair<int, bool> KisMyPaintPaintOp::doAsynchronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    /**
+     * The surface starts queueing the dabs only when we know that the
+     * stroke calls this function regularly. Until that, every dab is
+     * painted by libmypaint callback immediately.
+     */
+    if (!m_batchingRequested) {
+        m_batchingRequested = true;
+        m_surface->setBatchingEnabled(true);
+    }
+
+    bool someDabsAreStillInQueue = false;
+
+    if (!m_updateSharedState && m_surface->hasQueuedDabs()) {
+
+        m_updateSharedState = toQShared(new UpdateSharedState());
+        UpdateSharedStateSP state = m_updateSharedState;
+
+        state->surface = m_surface.data();
+        const QVector<KisMyPaintSurface::DabInfo> dabsQueue = m_surface->takeQueuedDabs();
+
+        QVector<QRect> dabRects;
+        qreal totalDiameter = 0.0;
+        qreal totalDistance = 0.0;
+
+        for (int i = 0; i < dabsQueue.size(); i++) {
+            const KisMyPaintSurface::DabInfo &dab = dabsQueue[i];
+
+            dabRects.append(dab.bounds());
+            totalDiameter += 2.0 * dab.radius;
+
+            if (i > 0) {
+                const KisMyPaintSurface::DabInfo &prevDab = dabsQueue[i - 1];
+                totalDistance += std::hypot(dab.x - prevDab.x, dab.y - prevDab.y);
+            }
+        }
+
+        const int diameter = qMax(1, qRound(totalDiameter / dabsQueue.size()));
+        const qreal spacing =
+            dabsQueue.size() > 1 ?
+                qBound(0.0, totalDistance / (dabsQueue.size() - 1) / diameter, 2.0) :
+                1.0;
+
+        // split/merge rects into non-overlapping areas
+        const QVector<QRect> rects =
+            KisPaintOpUtils::splitDabsIntoRects(dabRects, m_idealNumRects, diameter, spacing);
+
+        state->allDirtyRects = rects;
+
+        /**
+         * The render jobs may run concurrently with the next Data job of
+         * the stroke. If libmypaint samples the color of the surface in it,
+         * the surface completes the batch itself and the pending jobs of
+         * the batch just skip their rects.
+         */
+        state->batch = m_surface->startBatch(dabsQueue, rects);
+
+        KritaUtils::addJobSequential(jobs,
+            [state] () {
+                state->dabRenderingTimer.start();
+            }
+        );
+
+        for (int i = 0; i < rects.size(); i++) {
+            KritaUtils::addJobConcurrent(jobs,
+                [i, state] () {
+                    state->surface->renderBatchRect(state->batch, i);
+                }
+            );
+        }
+
+        KritaUtils::addJobSequential(jobs,
+            [state, this] () {
+                state->surface->finishBatch(state->batch);
+                painter()->addDirtyRects(state->allDirtyRects);
+
+                const int updateRenderingTime = state->dabRenderingTimer.elapsed();
+
+                m_currentUpdatePeriod =
+                    qBound(m_minUpdatePeriod, int(1.5 * updateRenderingTime), m_maxUpdatePeriod);
+
+                m_updateSharedState.clear();
+            }
+        );
+    } else if (m_updateSharedState && m_surface->hasQueuedDabs()) {
+        someDabsAreStillInQueue = true;
+    }
+
+    return std::make_pair(m_currentUpdatePeriod, someDabsAreStillInQueue);
+}
@@ -35,9 +35,17 @@ protected:
 
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
+    std::pair<int, bool> doAsynchronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
+
 private:
     KisSpacingInformation computeSpacing(const KisPaintInformation &info, qreal lodScale) const;
 
+private:
+    struct UpdateSharedState;
+    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
+
+    UpdateSharedStateSP m_updateSharedState;
+
 private:
     QScopedPointer<KisMyPaintPaintOpPreset> m_brush;
     QScopedPointer<KisMyPaintSurface> m_surface;
@@ -46,6 +54,12 @@ private:
     KisImageWSP m_image;
     double m_dtime, m_radius, m_previousTime = 0;
     bool m_isStrokeStarted;
+
+    bool m_batchingRequested = false;
+    const int m_idealNumRects;
+    const int m_minUpdatePeriod;
+    const int m_maxUpdatePeriod;
+    int m_currentUpdatePeriod;
 };
 
 #endif // KIS_MY_PAINTOP_H_
@@ -38,6 +38,7 @@ public:
     }
 
     bool paintIncremental() override;
+    bool needsAsynchronousUpdates() const override;
     void resetSettings(const QStringList &preserveProperties = QStringList()) override;
 
     void onPropertyChanged() override;
@@ -11,6 +11,7 @@
 #include <KoColorSpaceMaths.h>
 #include <QtMath>
 #include <kis_algebra_2d.h>
+#include <kis_assert.h>
 #include <kis_cross_device_color_sampler.h>
 #include <kis_image.h>
 #include <kis_node.h>
@@ -19,9 +20,33 @@
 #include <qmath.h>
 #include <KoCompositeOpRegistry.h>
 #include <KoMixColorsOp.h>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+#include "MyPaintDabMathFactoryImpl.h"
 
 using namespace std;
 
+struct KisMyPaintSurface::DabsBatch
+{
+    enum RectState {
+        Pending,
+        InProgress,
+        Done
+    };
+
+    QVector<DabInfo> dabs;
+    QVector<QRect> rects;
+    QVector<RectState> rectStates;
+    bool isPrepared = false;
+
+    QMutex mutex;
+    QWaitCondition rectDone;
+};
+
 void destroy_internal_surface_callback(MyPaintSurface *surface)
 {
     KisMyPaintSurface::MyPaintSurfaceInternal *ptr = static_cast<KisMyPaintSurface::MyPaintSurfaceInternal*>(surface);
@@ -57,10 +82,15 @@ KisMyPaintSurface::KisMyPaintSurface(KisPainter *painter, KisPaintDeviceSP paint
     // devices for mask information
     static const KoColorSpace *maskCs = KoColorSpaceRegistry::instance()->alpha8();
     m_maskDevice = KisFixedPaintDeviceSP(new KisFixedPaintDevice(maskCs));
+
+    m_dabMath.reset(createOptimizedClass<KisMyPaintDabMathFactoryImpl>());
 }
 
 KisMyPaintSurface::~KisMyPaintSurface()
 {
+    if (m_currentBatch) {
+        completeBatch(m_currentBatch);
+    }
     mypaint_surface_unref(m_surface);
 }
 
@@ -68,29 +98,36 @@ int KisMyPaintSurface::draw_dab(MyPaintSurface *self, float x, float y, float ra
                                 float color_b, float opaque, float hardness, float color_a,
                                 float aspect_ratio, float angle, float lock_alpha, float colorize) {
 
+    Q_UNUSED(lock_alpha);
+
     MyPaintSurfaceInternal *surface = static_cast<MyPaintSurfaceInternal*>(self);
 
-    if (surface->bitDepth == KoChannelInfo::UINT8) {
-        return surface->m_owner->drawDabImpl<quint8>(self, x, y, radius, color_r, color_g,
-                 color_b, opaque, hardness, color_a,
-                aspect_ratio, angle, lock_alpha,  colorize);
+    const DabInfo dab = {x, y, radius, color_r, color_g, color_b,
+                         opaque, hardness, color_a, aspect_ratio, angle, colorize};
+
+    if (surface->m_owner->m_batchingEnabled) {
+        surface->m_owner->m_queuedDabs.append(dab);
+        return 1;
     }
-    else if (surface->bitDepth == KoChannelInfo::UINT16) {
-        return surface->m_owner->drawDabImpl<quint16>(self, x, y, radius, color_r, color_g,
-                 color_b, opaque, hardness, color_a,
-                aspect_ratio, angle, lock_alpha,  colorize);
+
+    return surface->m_owner->drawDab(dab);
+}
+
+int KisMyPaintSurface::drawDab(const DabInfo &dab) {
+
+    if (m_surface->bitDepth == KoChannelInfo::UINT8) {
+        return drawDabImpl<quint8>(dab);
+    }
+    else if (m_surface->bitDepth == KoChannelInfo::UINT16) {
+        return drawDabImpl<quint16>(dab);
     }
 #if defined HAVE_OPENEXR
-    else if (surface->bitDepth == KoChannelInfo::FLOAT16) {
-        return surface->m_owner->drawDabImpl<half>(self, x, y, radius, color_r, color_g,
-                 color_b, opaque, hardness, color_a,
-                aspect_ratio, angle, lock_alpha,  colorize);
+    else if (m_surface->bitDepth == KoChannelInfo::FLOAT16) {
+        return drawDabImpl<half>(dab);
     }
 #endif
     else {
-        return surface->m_owner->drawDabImpl<float>(self, x, y, radius, color_r, color_g,
-                 color_b, opaque, hardness, color_a,
-                aspect_ratio, angle, lock_alpha,  colorize);
+        return drawDabImpl<float>(dab);
     }
 }
 
@@ -98,6 +135,12 @@ void KisMyPaintSurface::get_color(MyPaintSurface *self, float x, float y, float
                             float * color_r, float * color_g, float * color_b, float * color_a) {
 
     MyPaintSurfaceInternal *surface = static_cast<MyPaintSurfaceInternal*>(self);
+
+    // the color should be sampled from the surface with all the dabs painted
+    if (surface->m_owner->m_currentBatch || surface->m_owner->hasQueuedDabs()) {
+        surface->m_owner->flushQueuedDabs();
+    }
+
     if (surface->bitDepth == KoChannelInfo::UINT8) {
         surface->m_owner->getColorImpl<quint8>(self, x, y, radius, color_r, color_g, color_b, color_a);
     }
@@ -115,157 +158,194 @@ void KisMyPaintSurface::get_color(MyPaintSurface *self, float x, float y, float
 }
 
 
+QRect KisMyPaintSurface::DabInfo::bounds() const
+{
+    const QPoint pt = QPoint(x - radius - 1, y - radius - 1);
+    const QSize sz = QSize(2 * (radius+1), 2 * (radius+1));
+
+    return QRect(pt, sz);
+}
+
 /*GIMP's draw_dab and get_color code*/
 template <typename channelType>
-int KisMyPaintSurface::drawDabImpl(MyPaintSurface *self, float x, float y, float radius, float color_r, float color_g,
-                                float color_b, float opaque, float hardness, float color_a,
-                                float aspect_ratio, float angle, float lock_alpha, float colorize) {
+void KisMyPaintSurface::renderDab(const DabInfo &dab, const QRect &bufferRect, quint8 *buffer,
+                                  const QRect &processRect, quint8 *mask, bool eraser) const {
+
+    const float x = dab.x;
+    const float y = dab.y;
+    const float radius = dab.radius;
+    const float color_r = dab.color_r;
+    const float color_g = dab.color_g;
+    const float color_b = dab.color_b;
+    const float color_a = dab.color_a;
+    const float opaque = dab.opaque;
 
-    Q_UNUSED(self);
-    Q_UNUSED(lock_alpha);
     const float one_over_radius2 = 1.0f / (radius * radius);
-    const double angle_rad = kisDegreesToRadians(angle);
+    const double angle_rad = kisDegreesToRadians(dab.angle);
     const float cs = cos(angle_rad);
     const float sn = sin(angle_rad);
     float normal_mode;
-    float segment1_slope;
-    float segment2_slope;
+    float colorize;
     float r_aa_start;
 
-    hardness = CLAMP (hardness, 0.0f, 1.0f);
-    segment1_slope = -(1.0f / hardness - 1.0f);
-    segment2_slope = -hardness / (1.0f - hardness);
-    aspect_ratio = max(1.0f, aspect_ratio);
+    KisMyPaintDabShape shape;
+    shape.x = x;
+    shape.y = y;
+    shape.sn = sn;
+    shape.cs = cs;
+    shape.oneOverRadius2 = one_over_radius2;
+    shape.hardness = CLAMP (dab.hardness, 0.0f, 1.0f);
+    shape.slope1 = -(1.0f / shape.hardness - 1.0f);
+    shape.slope2 = -shape.hardness / (1.0f - shape.hardness);
+    shape.aspectRatio = max(1.0f, dab.aspect_ratio);
+    shape.outerRadius2 = (radius + 1.0f) * (radius + 1.0f);
 
     r_aa_start = radius - 1.0f;
     r_aa_start = max(r_aa_start, 0.0f);
-    r_aa_start = (r_aa_start * r_aa_start) / aspect_ratio;
-
-    normal_mode = opaque * (1.0f - colorize);
-    colorize = opaque * colorize;
-
-    const QPoint pt = QPoint(x - radius - 1, y - radius - 1);
-    const QSize sz = QSize(2 * (radius+1), 2 * (radius+1));
+    r_aa_start = (r_aa_start * r_aa_start) / shape.aspectRatio;
 
-    const QRect dabRectAligned = QRect(pt, sz);
-    const QPointF center = QPointF(x, y);
-
-    KisAlgebra2D::OuterCircle outer(center, radius);
-    m_precisePainterWrapper.readRects(m_tempPainter->calculateAllMirroredRects(dabRectAligned));
-    m_tempPainter->copyAreaOptimized(dabRectAligned.topLeft(), m_tempPainter->device(), m_dab, dabRectAligned);
-    KisSequentialIterator it(m_dab, dabRectAligned);
+    normal_mode = opaque * (1.0f - dab.colorize);
+    colorize = opaque * dab.colorize;
 
     quint8 maskUnitValue = KoColorSpaceMathsTraits<quint8>::unitValue; // because it's alpha8
 
     float unitValue = KoColorSpaceMathsTraits<channelType>::unitValue;
     float minValue = KoColorSpaceMathsTraits<channelType>::min;
-    bool eraser = painter()->compositeOpId() == COMPOSITE_ERASE;
 
+    const int pixelSize = 4 * sizeof(channelType);
+    const int bufferRowStride = bufferRect.width() * pixelSize;
 
-    m_maskDevice->setRect(dabRectAligned);
-    m_maskDevice->lazyGrowBufferWithoutInitialization();
-
+    QVarLengthArray<float, 256> baseAlphaRow(processRect.width());
 
-    // Dmitry says that going with the pointer should be in the same order
-    // as using the sequential iterator
-    quint8* maskPointer = m_maskDevice->data();
+    for (int row = processRect.top(); row <= processRect.bottom(); row++) {
 
+        float *baseAlphaPointer = baseAlphaRow.data();
 
-    while(it.nextPixel()) {
+        if (radius < 3.0) {
+            for (int col = processRect.left(); col <= processRect.right(); col++) {
+                const float rr = calculate_rr_antialiased (col, row, x, y, shape.aspectRatio, sn, cs, one_over_radius2, r_aa_start);
 
-        // first initialize to 0;
-        *maskPointer = 0;
+                *baseAlphaPointer++ =
+                    KisMyPaintDabMathBase::isOutside(col, row, shape) ? 0.0f :
+                    KisMyPaintDabMathBase::calculate_alpha_for_rr (rr, shape.hardness, shape.slope1, shape.slope2);
+            }
+        } else {
+            m_dabMath->calculateAlpha(shape, processRect.left(), row, processRect.width(), baseAlphaPointer);
+        }
 
-        QPoint pt(it.x(), it.y());
+        baseAlphaPointer = baseAlphaRow.data();
 
-        if(outer.fadeSq(pt) > 1.0f) {
-            maskPointer++;
-            continue;
-        }
+        const int rowOffset = (row - bufferRect.top()) * bufferRowStride +
+            (processRect.left() - bufferRect.left()) * pixelSize;
 
-        float rr, base_alpha, alpha, dst_alpha, r, g, b, a;
+        channelType *nativeArray = reinterpret_cast<channelType*>(buffer + rowOffset);
 
-        if (radius < 3.0) {
-            rr = calculate_rr_antialiased (it.x(), it.y(), x, y, aspect_ratio, sn, cs, one_over_radius2, r_aa_start);
-        }
-        else {
-            rr = calculate_rr (it.x(), it.y(), x, y, aspect_ratio, sn, cs, one_over_radius2);
-        }
+        quint8 *maskPointer = mask ?
+            mask + (row - bufferRect.top()) * bufferRect.width() + (processRect.left() - bufferRect.left()) :
+            nullptr;
 
-        base_alpha = calculate_alpha_for_rr (rr, hardness, segment1_slope, segment2_slope);
+        for (int col = processRect.left(); col <= processRect.right(); col++, nativeArray += 4) {
 
-        m_tempPainter->selection();
-        alpha = base_alpha * normal_mode;
+            const float base_alpha = *baseAlphaPointer++;
+            float alpha, dst_alpha, r, g, b, a;
 
-        // set alpha to mask
-        if (alpha > minValue) {
-            *maskPointer = (quint8)(maskUnitValue);
-        }
+            alpha = base_alpha * normal_mode;
 
-        channelType* nativeArray = reinterpret_cast<channelType*>(it.rawData());
+            /**
+             * Only the pixels covered by the dab are copied into the
+             * destination device, the rest is left untouched. For floating
+             * point color spaces the pixels with zero alpha are not changed
+             * by the blending, so they can be skipped as well.
+             */
+            const bool isPainted = base_alpha > 0.0f && alpha > minValue;
 
-        b = nativeArray[0]/unitValue;
-        g = nativeArray[1]/unitValue;
-        r = nativeArray[2]/unitValue;
-        dst_alpha = nativeArray[3]/unitValue;
+            if (maskPointer) {
+                *maskPointer++ = isPainted ? maskUnitValue : 0;
+            }
 
-        if (unitValue == 1.0f) {
-            swap(b, r);
-        }
+            if (!isPainted) continue;
 
-        a = alpha * (color_a - dst_alpha) + dst_alpha;
+            b = nativeArray[0]/unitValue;
+            g = nativeArray[1]/unitValue;
+            r = nativeArray[2]/unitValue;
+            dst_alpha = nativeArray[3]/unitValue;
 
-        if (eraser) {
-            alpha = 1 - (opaque*base_alpha);
-            a = dst_alpha * alpha ;
-        } else {
-            if (a > 0.0f) {
-                float src_term = (alpha * color_a) / a;
-                float dst_term = 1.0f - src_term;
-                r = color_r * src_term + r * dst_term;
-                g = color_g * src_term + g * dst_term;
-                b = color_b * src_term + b * dst_term;
+            if (unitValue == 1.0f) {
+                swap(b, r);
             }
 
-            if (colorize > 0.0f && base_alpha > 0.0f) {
-
-                alpha = base_alpha * colorize;
-                a = alpha + dst_alpha - alpha * dst_alpha;
+            a = alpha * (color_a - dst_alpha) + dst_alpha;
 
+            if (eraser) {
+                alpha = 1 - (opaque*base_alpha);
+                a = dst_alpha * alpha ;
+            } else {
                 if (a > 0.0f) {
+                    float src_term = (alpha * color_a) / a;
+                    float dst_term = 1.0f - src_term;
+                    r = color_r * src_term + r * dst_term;
+                    g = color_g * src_term + g * dst_term;
+                    b = color_b * src_term + b * dst_term;
+                }
 
-                    float pixel_h, pixel_s, pixel_l, out_h, out_s, out_l;
-                    float out_r = r, out_g = g, out_b = b;
+                if (colorize > 0.0f && base_alpha > 0.0f) {
 
-                    float src_term = alpha / a;
-                    float dst_term = 1.0f - src_term;
+                    alpha = base_alpha * colorize;
+                    a = alpha + dst_alpha - alpha * dst_alpha;
+
+                    if (a > 0.0f) {
+
+                        float pixel_h, pixel_s, pixel_l, out_h, out_s, out_l;
+                        float out_r = r, out_g = g, out_b = b;
 
-                    RGBToHSL(color_r, color_g, color_b, &pixel_h, &pixel_s, &pixel_l);
-                    RGBToHSL(out_r, out_g, out_b, &out_h, &out_s, &out_l);
+                        float src_term = alpha / a;
+                        float dst_term = 1.0f - src_term;
 
-                    out_h = pixel_h;
-                    out_s = pixel_s;
+                        RGBToHSL(color_r, color_g, color_b, &pixel_h, &pixel_s, &pixel_l);
+                        RGBToHSL(out_r, out_g, out_b, &out_h, &out_s, &out_l);
 
-                    HSLToRGB(out_h, out_s, out_l, &out_r, &out_g, &out_b);
+                        out_h = pixel_h;
+                        out_s = pixel_s;
 
-                    r = (float)out_r * src_term + r * dst_term;
-                    g = (float)out_g * src_term + g * dst_term;
-                    b = (float)out_b * src_term + b * dst_term;
+                        HSLToRGB(out_h, out_s, out_l, &out_r, &out_g, &out_b);
+
+                        r = (float)out_r * src_term + r * dst_term;
+                        g = (float)out_g * src_term + g * dst_term;
+                        b = (float)out_b * src_term + b * dst_term;
+                    }
                 }
             }
-        }
 
-        if (unitValue == 1.0f) {
-            swap(b, r);
+            if (unitValue == 1.0f) {
+                swap(b, r);
+            }
+            nativeArray[0] = KoColorSpaceMaths<float, channelType>::scaleToA(b);
+            nativeArray[1] = KoColorSpaceMaths<float, channelType>::scaleToA(g);
+            nativeArray[2] = KoColorSpaceMaths<float, channelType>::scaleToA(r);
+            nativeArray[3] = KoColorSpaceMaths<float, channelType>::scaleToA(a);
         }
-        nativeArray[0] = KoColorSpaceMaths<float, channelType>::scaleToA(b);
-        nativeArray[1] = KoColorSpaceMaths<float, channelType>::scaleToA(g);
-        nativeArray[2] = KoColorSpaceMaths<float, channelType>::scaleToA(r);
-        nativeArray[3] = KoColorSpaceMaths<float, channelType>::scaleToA(a);
-
-        maskPointer++;
     }
+}
+
+template <typename channelType>
+int KisMyPaintSurface::drawDabImpl(const DabInfo &dab) {
+
+    const QRect dabRectAligned = dab.bounds();
+
+    m_precisePainterWrapper.readRects(m_tempPainter->calculateAllMirroredRects(dabRectAligned));
+
+    m_dabBuffer.resize(dabRectAligned.width() * dabRectAligned.height() * m_dab->pixelSize());
+    m_tempPainter->device()->readBytes(m_dabBuffer.data(), dabRectAligned);
+
+    m_maskDevice->setRect(dabRectAligned);
+    m_maskDevice->lazyGrowBufferWithoutInitialization();
+
+    const bool eraser = painter()->compositeOpId() == COMPOSITE_ERASE;
+
+    renderDab<channelType>(dab, dabRectAligned, m_dabBuffer.data(),
+                           dabRectAligned, m_maskDevice->data(), eraser);
 
+    m_dab->writeBytes(m_dabBuffer.data(), dabRectAligned);
 
     m_tempPainter->bitBltWithFixedSelection(dabRectAligned.x(), dabRectAligned.y(), m_dab, m_maskDevice, dabRectAligned.x(), dabRectAligned.y(), dabRectAligned.x(), dabRectAligned.y(), dabRectAligned.width(), dabRectAligned.height());
     m_tempPainter->renderMirrorMask(dabRectAligned, m_dab, dabRectAligned.x(), dabRectAligned.y(), m_maskDevice);
@@ -275,6 +355,174 @@ int KisMyPaintSurface::drawDabImpl(MyPaintSurface *self, float x, float y, float
     return 1;
 }
 
+template <typename channelType>
+void KisMyPaintSurface::renderDabsImpl(const QRect &rc, const QVector<DabInfo> &dabs) {
+
+    KisPaintDeviceSP overlay = m_precisePainterWrapper.overlay();
+
+    /**
+     * All the dabs touching the rect are painted over the same buffer,
+     * so the overlapping dabs cost only one read and one write of the
+     * device pixels
+     */
+    QVector<quint8> buffer(rc.width() * rc.height() * overlay->pixelSize());
+    overlay->readBytes(buffer.data(), rc);
+
+    const bool eraser = painter()->compositeOpId() == COMPOSITE_ERASE;
+
+    Q_FOREACH (const DabInfo &dab, dabs) {
+        const QRect processRect = dab.bounds() & rc;
+        if (processRect.isEmpty()) continue;
+
+        renderDab<channelType>(dab, rc, buffer.data(), processRect, nullptr, eraser);
+    }
+
+    overlay->writeBytes(buffer.data(), rc);
+    m_precisePainterWrapper.writeRects({rc});
+}
+
+bool KisMyPaintSurface::setBatchingEnabled(bool value) {
+
+    if (!value) {
+        if (hasQueuedDabs()) {
+            flushQueuedDabs();
+        }
+        m_batchingEnabled = false;
+        return false;
+    }
+
+    KisPaintDeviceSP device = m_painter->device();
+
+    m_batchingEnabled =
+        !m_painter->selection() &&
+        !m_painter->hasMirroring() &&
+        m_painter->channelFlags().isEmpty() &&
+        !device->defaultBounds()->wrapAroundMode();
+
+    return m_batchingEnabled;
+}
+
+bool KisMyPaintSurface::batchingEnabled() const {
+    return m_batchingEnabled;
+}
+
+bool KisMyPaintSurface::hasQueuedDabs() const {
+    return !m_queuedDabs.isEmpty();
+}
+
+QVector<KisMyPaintSurface::DabInfo> KisMyPaintSurface::takeQueuedDabs() {
+    QVector<DabInfo> dabs;
+    std::swap(dabs, m_queuedDabs);
+    return dabs;
+}
+
+KisMyPaintSurface::DabsBatchSP KisMyPaintSurface::startBatch(const QVector<DabInfo> &dabs, const QVector<QRect> &rects) {
+
+    if (m_currentBatch) {
+        completeBatch(m_currentBatch);
+    }
+
+    DabsBatchSP batch(new DabsBatch());
+    batch->dabs = dabs;
+    batch->rects = rects;
+    batch->rectStates.fill(DabsBatch::Pending, rects.size());
+
+    m_currentBatch = batch;
+    return batch;
+}
+
+void KisMyPaintSurface::renderBatchRect(DabsBatchSP batch, int rectIndex) {
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(rectIndex >= 0 && rectIndex < batch->rects.size());
+
+    {
+        QMutexLocker l(&batch->mutex);
+
+        if (batch->rectStates[rectIndex] != DabsBatch::Pending) return;
+        batch->rectStates[rectIndex] = DabsBatch::InProgress;
+
+        /**
+         * Reading rects into the overlay modifies the state of the
+         * overlay wrapper, so it is done by the first thread that
+         * claims a rect of the batch, before any rendering starts
+         */
+        if (!batch->isPrepared) {
+            m_precisePainterWrapper.readRects(batch->rects);
+            batch->isPrepared = true;
+        }
+    }
+
+    renderDabs(batch->rects[rectIndex], batch->dabs);
+
+    {
+        QMutexLocker l(&batch->mutex);
+        batch->rectStates[rectIndex] = DabsBatch::Done;
+        batch->rectDone.wakeAll();
+    }
+}
+
+void KisMyPaintSurface::completeBatch(DabsBatchSP batch) {
+
+    for (int i = 0; i < batch->rects.size(); i++) {
+        renderBatchRect(batch, i);
+    }
+
+    /**
+     * The rects we could not claim are being rendered by the threads
+     * that are already running, so it is safe to wait for them
+     */
+    QMutexLocker l(&batch->mutex);
+    while (std::find_if(batch->rectStates.begin(), batch->rectStates.end(),
+                        [] (DabsBatch::RectState state) { return state != DabsBatch::Done; })
+           != batch->rectStates.end()) {
+
+        batch->rectDone.wait(&batch->mutex);
+    }
+}
+
+void KisMyPaintSurface::finishBatch(DabsBatchSP batch) {
+
+    completeBatch(batch);
+
+    if (m_currentBatch == batch) {
+        m_currentBatch.clear();
+    }
+}
+
+void KisMyPaintSurface::renderDabs(const QRect &rc, const QVector<DabInfo> &dabs) {
+
+    if (m_surface->bitDepth == KoChannelInfo::UINT8) {
+        renderDabsImpl<quint8>(rc, dabs);
+    }
+    else if (m_surface->bitDepth == KoChannelInfo::UINT16) {
+        renderDabsImpl<quint16>(rc, dabs);
+    }
+#if defined HAVE_OPENEXR
+    else if (m_surface->bitDepth == KoChannelInfo::FLOAT16) {
+        renderDabsImpl<half>(rc, dabs);
+    }
+#endif
+    else {
+        renderDabsImpl<float>(rc, dabs);
+    }
+}
+
+void KisMyPaintSurface::flushQueuedDabs() {
+
+    /**
+     * The dabs of the batch in flight precede the queued ones, so they
+     * should be rendered first. The batch is not detached from the surface
+     * here, since its owner still has to call finishBatch() for it.
+     */
+    if (m_currentBatch) {
+        completeBatch(m_currentBatch);
+    }
+
+    Q_FOREACH (const DabInfo &dab, takeQueuedDabs()) {
+        drawDab(dab);
+    }
+}
+
 template <typename channelType>
 void KisMyPaintSurface::getColorImpl(MyPaintSurface *self, float x, float y, float radius,
                             float * color_r, float * color_g, float * color_b, float * color_a) {
@@ -406,24 +654,6 @@ qreal KisMyPaintSurface::calculateOpacity(float angle, float hardness, float opa
     return pixel_opacity;
 }
 
-inline float KisMyPaintSurface::calculate_rr (int  xp,
-              int   yp,
-              float x,
-              float y,
-              float aspect_ratio,
-              float sn,
-              float cs,
-              float one_over_radius2) {
-
-    const float yy = (yp + 0.5f - y);
-    const float xx = (xp + 0.5f - x);
-    const float yyr=(yy*cs-xx*sn)*aspect_ratio;
-    const float xxr=yy*sn+xx*cs;
-    const float rr = (yyr*yyr + xxr*xxr) * one_over_radius2;
-    /* rr is in range 0.0..1.0*sqrt(2) */
-    return rr;
-}
-
 static inline float
 calculate_r_sample (float x, float y, float aspect_ratio, float sn, float cs) {
 
@@ -461,7 +691,7 @@ closest_point_to_line (float  lx, float  ly, float  px, float  py, float *ox, fl
  */
 inline float KisMyPaintSurface::calculate_rr_antialiased (int  xp, int  yp, float x, float y,
                           float aspect_ratio, float sn, float cs, float one_over_radius2,
-                          float r_aa_start) {
+                          float r_aa_start) const {
 
     /* calculate pixel position and borders in a way
      * that the dab's center is always at zero */
@@ -541,13 +771,3 @@ inline float KisMyPaintSurface::calculate_rr_antialiased (int  xp, int  yp, floa
     return 1.0f - visibilityNear;
 }
 /* -- end mypaint code */
-
-inline float KisMyPaintSurface::calculate_alpha_for_rr (float rr, float hardness, float slope1, float slope2) {
-
-  if (rr > 1.0f)
-    return 0.0f;
-  else if (rr <= hardness)
-    return 1.0f + rr * slope1;
-  else
-    return rr * slope2 - slope2;
-}
@@ -8,6 +8,7 @@
 #define KIS_MYPAINT_SURFACE_H
 
 #include <QObject>
+#include <QSharedPointer>
 
 #include <kis_paint_device.h>
 #include <kis_fixed_paint_device.h>
@@ -22,6 +23,8 @@
 #include <libmypaint/mypaint-brush.h>
 #include <libmypaint/mypaint-surface.h>
 
+#include "MyPaintDabMathBase.h"
+
 class KisMyPaintSurface
 {
 public:
@@ -31,6 +34,26 @@ public:
           KoChannelInfo::enumChannelValueType bitDepth;
     };
 
+    /**
+     * Parameters of a dab as passed by libmypaint to draw_dab()
+     */
+    struct DabInfo {
+        float x;
+        float y;
+        float radius;
+        float color_r;
+        float color_g;
+        float color_b;
+        float opaque;
+        float hardness;
+        float color_a;
+        float aspect_ratio;
+        float angle;
+        float colorize;
+
+        QRect bounds() const;
+    };
+
 public:
     KisMyPaintSurface(KisPainter* painter, KisPaintDeviceSP paintNode=nullptr, KisImageSP image = nullptr);
     ~KisMyPaintSurface();
@@ -49,9 +72,7 @@ public:
                             float * color_r, float * color_g, float * color_b, float * color_a);
 
     template <typename channelType>
-    int drawDabImpl(MyPaintSurface *self, float x, float y, float radius, float color_r, float color_g,
-                                    float color_b, float opaque, float hardness, float color_a,
-                                    float aspect_ratio, float angle, float lock_alpha, float colorize);
+    int drawDabImpl(const DabInfo &dab);
 
     template <typename channelType>
     void getColorImpl(MyPaintSurface *self, float x, float y, float radius,
@@ -59,14 +80,61 @@ public:
 
     inline float
     calculate_rr_antialiased (int  xp, int  yp, float x, float y, float aspect_ratio,
-                              float sn, float cs, float one_over_radius2, float r_aa_start);
+                              float sn, float cs, float one_over_radius2, float r_aa_start) const;
 
-    inline float
-    calculate_alpha_for_rr (float rr, float hardness, float slope1, float slope2);
+    /**
+     * In batched mode draw_dab() only queues the dabs, the owner of
+     * the surface is expected to fetch them with takeQueuedDabs() and
+     * render them as a batch, see startBatch(). The queue is flushed
+     * synchronously whenever libmypaint samples the color of the surface.
+     *
+     * The mode can be enabled only when the painter has no selection,
+     * mirroring and channel flags and the device is not in wrap-around
+     * mode, otherwise the surface keeps painting every dab immediately.
+     *
+     * @return true if the batched mode has been enabled
+     */
+    bool setBatchingEnabled(bool value);
+    bool batchingEnabled() const;
+
+    bool hasQueuedDabs() const;
+    QVector<DabInfo> takeQueuedDabs();
+
+    struct DabsBatch;
+    typedef QSharedPointer<DabsBatch> DabsBatchSP;
 
-    inline float
-    calculate_rr (int xp, int yp, float x, float y, float aspect_ratio,
-                  float sn, float cs, float one_over_radius2);
+    /**
+     * Starts asynchronous rendering of \p dabs split into non-overlapping
+     * \p rects. The rects are rendered with renderBatchRect(), which may
+     * be called concurrently for different rects, and the batch is closed
+     * with finishBatch().
+     *
+     * While the batch is in flight, get_color() and flushQueuedDabs()
+     * complete it in the calling thread: they render all the rects that
+     * have not been started yet and wait for the ones being rendered
+     * by other threads. Therefore the color is always sampled with all
+     * the previous dabs painted and the pending render jobs of the batch
+     * become no-op.
+     */
+    DabsBatchSP startBatch(const QVector<DabInfo> &dabs, const QVector<QRect> &rects);
+
+    /**
+     * Renders the part of the batch dabs that intersects rect
+     * \p rectIndex, unless it has already been rendered by someone else
+     */
+    void renderBatchRect(DabsBatchSP batch, int rectIndex);
+
+    /**
+     * Renders the rest of \p batch (if any) and detaches it from the
+     * surface. Should be called sequentially after all renderBatchRect()
+     * calls of the batch.
+     */
+    void finishBatch(DabsBatchSP batch);
+
+    /**
+     * Renders all the queued dabs synchronously
+     */
+    void flushQueuedDabs();
 
 
     KisPainter* painter();
@@ -76,6 +144,20 @@ public:
 
     MyPaintSurface* surface();
 
+private:
+    int drawDab(const DabInfo &dab);
+
+    template <typename channelType>
+    void renderDab(const DabInfo &dab, const QRect &bufferRect, quint8 *buffer,
+                   const QRect &processRect, quint8 *mask, bool eraser) const;
+
+    void renderDabs(const QRect &rc, const QVector<DabInfo> &dabs);
+
+    template <typename channelType>
+    void renderDabsImpl(const QRect &rc, const QVector<DabInfo> &dabs);
+
+    void completeBatch(DabsBatchSP batch);
+
 private:
     KisPainter *m_painter;
     KisPaintDeviceSP m_imageDevice;
@@ -87,7 +169,13 @@ private:
     QScopedPointer<KisPainter> m_backgroundPainter;
     KisFixedPaintDeviceSP m_blendDevice;
     KisFixedPaintDeviceSP m_maskDevice;
+    QVector<quint8> m_dabBuffer;
+
+    QScopedPointer<KisMyPaintDabMathBase> m_dabMath;
 
+    bool m_batchingEnabled = false;
+    QVector<DabInfo> m_queuedDabs;
+    DabsBatchSP m_currentBatch;
 };
 
 #endif // KIS_MYPAINT_SURFACE_H
@@ -17,11 +17,19 @@
 #include <kis_paint_information.h>
 #include <kis_random_accessor_ng.h>
 #include <KisGlobalResourcesInterface.h>
+#include <KoColor.h>
+#include <KoCompositeOpRegistry.h>
+#include <kis_global.h>
+#include <KisSupportedArchitectures.h>
+#include <KoMultiArchBuildSupport.h>
+#include <kis_paintop_utils.h>
 
 #include "kis_mypaintop_test.h"
 #include "MyPaintPaintOp.h"
 #include "MyPaintSurface.h"
 #include "MyPaintPaintOpSettings.h"
+#include "MyPaintDabMathBase.h"
+#include "MyPaintDabMathFactoryImpl.h"
 
 #include <qimage_test_util.h>
 
@@ -86,4 +94,276 @@ void KisMyPaintOpTest::testLoading() {
     QVERIFY(brush->valid());
 }
 
+void KisMyPaintOpTest::testCalculateAlphaVectorized()
+{
+    const QStringList archs = KisSupportedArchitectures::optimizedArchNames();
+
+    if (archs.isEmpty()) {
+        QSKIP("Krita is built without vectorized implementations");
+    }
+
+    Q_FOREACH (const QString &arch, archs) {
+        QScopedPointer<KisMyPaintDabMathBase> dabMath(
+            createOptimizedClassForArch<KisMyPaintDabMathFactoryImpl>(arch));
+
+        Q_FOREACH (float angle, QVector<float>({0.0f, 30.0f, 90.0f, 217.0f})) {
+            Q_FOREACH (float aspectRatio, QVector<float>({1.0f, 2.5f})) {
+                Q_FOREACH (float hardness, QVector<float>({0.3f, 0.8f, 1.0f})) {
+                    const float radius = 13.7f;
+
+                    KisMyPaintDabShape shape;
+                    shape.x = 20.3f;
+                    shape.y = 17.6f;
+                    shape.sn = std::sin(kisDegreesToRadians(angle));
+                    shape.cs = std::cos(kisDegreesToRadians(angle));
+                    shape.aspectRatio = aspectRatio;
+                    shape.oneOverRadius2 = 1.0f / (radius * radius);
+                    shape.hardness = hardness;
+                    shape.slope1 = -(1.0f / shape.hardness - 1.0f);
+                    shape.slope2 = -shape.hardness / (1.0f - shape.hardness);
+                    shape.outerRadius2 = (radius + 1.0f) * (radius + 1.0f);
+
+                    /**
+                     * Every pixel is also calculated with a separate call, which
+                     * goes through the scalar tail of the same implementation.
+                     * The implementations for different instruction sets may be
+                     * compiled with different floating point contraction, so the
+                     * scalar result is taken from the same implementation to be
+                     * able to compare exactly.
+                     */
+                    for (int y = 2; y < 34; y++) {
+                        for (int x = 4; x < 8; x++) {
+                            // the width is not a multiple of any vector size
+                            const int numPixels = 37 - x;
+
+                            QVector<float> rowAlpha(numPixels);
+                            dabMath->calculateAlpha(shape, x, y, numPixels, rowAlpha.data());
+
+                            for (int i = 0; i < numPixels; i++) {
+                                float pixelAlpha = -1.0f;
+                                dabMath->calculateAlpha(shape, x + i, y, 1, &pixelAlpha);
+
+                                if (rowAlpha[i] != pixelAlpha) {
+                                    QFAIL(qPrintable(
+                                        QString("Alpha differs: arch %1, pixel (%2, %3), angle %4, "
+                                                "aspect ratio %5, hardness %6: vector %7, scalar %8")
+                                            .arg(arch).arg(x + i).arg(y).arg(angle)
+                                            .arg(aspectRatio).arg(hardness)
+                                            .arg(double(rowAlpha[i])).arg(double(pixelAlpha))));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+QVector<KisMyPaintSurface::DabInfo> testDabs()
+{
+    QVector<KisMyPaintSurface::DabInfo> dabs;
+
+    /**
+     * A stroke of overlapping dabs with changing parameters. The small
+     * dabs use the antialiased path, the big ones the vectorized one.
+     */
+    for (int i = 0; i < 40; i++) {
+        KisMyPaintSurface::DabInfo dab;
+        dab.x = 30.0f + 7.3f * i;
+        dab.y = 50.0f + 20.0f * std::sin(0.3f * i);
+        dab.radius = (i % 5 == 0) ? 2.2f : 5.0f + (i % 7) * 3.1f;
+        dab.color_r = 0.9f;
+        dab.color_g = 0.1f * (i % 10);
+        dab.color_b = 0.3f;
+        dab.opaque = 0.4f + 0.05f * (i % 12);
+        dab.hardness = 0.2f + 0.1f * (i % 9);
+        dab.color_a = 1.0f;
+        dab.aspect_ratio = 1.0f + 0.3f * (i % 4);
+        dab.angle = 11.0f * i;
+        dab.colorize = (i % 6 == 0) ? 0.5f : 0.0f;
+
+        dabs.append(dab);
+    }
+
+    return dabs;
+}
+
+void drawDab(KisMyPaintSurface *surface, const KisMyPaintSurface::DabInfo &dab)
+{
+    surface->draw_dab(surface->surface(), dab.x, dab.y, dab.radius,
+                      dab.color_r, dab.color_g, dab.color_b, dab.opaque, dab.hardness,
+                      dab.color_a, dab.aspect_ratio, dab.angle, 0.0f, dab.colorize);
+}
+
+QVector<QRect> splitDabs(const QVector<KisMyPaintSurface::DabInfo> &dabs)
+{
+    QVector<QRect> dabRects;
+    Q_FOREACH (const KisMyPaintSurface::DabInfo &dab, dabs) {
+        dabRects.append(dab.bounds());
+    }
+
+    // split the dabs the same way KisMyPaintPaintOp does
+    return KisPaintOpUtils::splitDabsIntoRects(dabRects, 8, 20, 0.3);
+}
+
+bool compareDevices(KisPaintDeviceSP dev1, KisPaintDeviceSP dev2, QPoint *errorPoint)
+{
+    const QRect bounds = dev1->exactBounds() | dev2->exactBounds();
+    const int pixelSize = dev1->pixelSize();
+
+    QByteArray bytes1(bounds.width() * bounds.height() * pixelSize, 0);
+    QByteArray bytes2(bounds.width() * bounds.height() * pixelSize, 0);
+
+    dev1->readBytes(reinterpret_cast<quint8*>(bytes1.data()), bounds);
+    dev2->readBytes(reinterpret_cast<quint8*>(bytes2.data()), bounds);
+
+    for (int i = 0; i < bytes1.size(); i += pixelSize) {
+        if (memcmp(bytes1.constData() + i, bytes2.constData() + i, pixelSize) != 0) {
+            const int pixel = i / pixelSize;
+            *errorPoint = QPoint(bounds.x() + pixel % bounds.width(),
+                                 bounds.y() + pixel / bounds.width());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+void KisMyPaintOpTest::testBatchedRendering_data()
+{
+    QTest::addColumn<QString>("depth");
+    QTest::addColumn<QString>("compositeOp");
+
+    Q_FOREACH (const QString &depth, QStringList() << "U8" << "U16" << "F32") {
+        Q_FOREACH (const QString &compositeOp, QStringList() << COMPOSITE_OVER << COMPOSITE_ERASE) {
+            QTest::addRow("%s-%s", qPrintable(depth), qPrintable(compositeOp)) << depth << compositeOp;
+        }
+    }
+}
+
+void KisMyPaintOpTest::testBatchedRendering()
+{
+    QFETCH(QString, depth);
+    QFETCH(QString, compositeOp);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", depth, "");
+    const QVector<KisMyPaintSurface::DabInfo> dabs = testDabs();
+
+    KisPaintDeviceSP immediateDevice = new KisPaintDevice(cs);
+    immediateDevice->fill(QRect(0, 0, 200, 120), KoColor(Qt::darkGreen, cs));
+
+    KisPaintDeviceSP batchedDevice = new KisPaintDevice(*immediateDevice);
+
+    {
+        KisPainter painter(immediateDevice);
+        painter.setCompositeOpId(compositeOp);
+
+        KisMyPaintSurface surface(&painter, immediateDevice);
+        Q_FOREACH (const KisMyPaintSurface::DabInfo &dab, dabs) {
+            drawDab(&surface, dab);
+        }
+    }
+
+    {
+        KisPainter painter(batchedDevice);
+        painter.setCompositeOpId(compositeOp);
+
+        KisMyPaintSurface surface(&painter, batchedDevice);
+        QVERIFY(surface.setBatchingEnabled(true));
+
+        Q_FOREACH (const KisMyPaintSurface::DabInfo &dab, dabs) {
+            drawDab(&surface, dab);
+        }
+
+        const QVector<KisMyPaintSurface::DabInfo> queuedDabs = surface.takeQueuedDabs();
+        QCOMPARE(queuedDabs.size(), dabs.size());
+
+        const QVector<QRect> rects = splitDabs(queuedDabs);
+
+        KisMyPaintSurface::DabsBatchSP batch = surface.startBatch(queuedDabs, rects);
+        for (int i = 0; i < rects.size(); i++) {
+            surface.renderBatchRect(batch, i);
+        }
+        surface.finishBatch(batch);
+    }
+
+    QPoint errorPoint;
+    if (!compareDevices(immediateDevice, batchedDevice, &errorPoint)) {
+        QFAIL(qPrintable(QString("Batched rendering differs from the immediate one at pixel %1,%2")
+                         .arg(errorPoint.x()).arg(errorPoint.y())));
+    }
+}
+
+void KisMyPaintOpTest::testGetColorWithPendingBatch()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QVector<KisMyPaintSurface::DabInfo> dabs = testDabs();
+
+    KisPaintDeviceSP immediateDevice = new KisPaintDevice(cs);
+    immediateDevice->fill(QRect(0, 0, 200, 120), KoColor(Qt::darkGreen, cs));
+
+    KisPaintDeviceSP batchedDevice = new KisPaintDevice(*immediateDevice);
+
+    // sample the color right under the last dab of the stroke
+    const KisMyPaintSurface::DabInfo &sampledDab = dabs.last();
+
+    float expectedColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float sampledColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    {
+        KisPainter painter(immediateDevice);
+        KisMyPaintSurface surface(&painter, immediateDevice);
+
+        Q_FOREACH (const KisMyPaintSurface::DabInfo &dab, dabs) {
+            drawDab(&surface, dab);
+        }
+
+        surface.get_color(surface.surface(), sampledDab.x, sampledDab.y, sampledDab.radius,
+                          &expectedColor[0], &expectedColor[1], &expectedColor[2], &expectedColor[3]);
+    }
+
+    {
+        KisPainter painter(batchedDevice);
+        KisMyPaintSurface surface(&painter, batchedDevice);
+        QVERIFY(surface.setBatchingEnabled(true));
+
+        Q_FOREACH (const KisMyPaintSurface::DabInfo &dab, dabs) {
+            drawDab(&surface, dab);
+        }
+
+        const QVector<KisMyPaintSurface::DabInfo> queuedDabs = surface.takeQueuedDabs();
+        const QVector<QRect> rects = splitDabs(queuedDabs);
+        QVERIFY(rects.size() > 1);
+
+        KisMyPaintSurface::DabsBatchSP batch = surface.startBatch(queuedDabs, rects);
+
+        // only the first render job has managed to run before the sampling
+        surface.renderBatchRect(batch, 0);
+
+        surface.get_color(surface.surface(), sampledDab.x, sampledDab.y, sampledDab.radius,
+                          &sampledColor[0], &sampledColor[1], &sampledColor[2], &sampledColor[3]);
+
+        // the rest of the render jobs should not paint the dabs for the second time
+        for (int i = 0; i < rects.size(); i++) {
+            surface.renderBatchRect(batch, i);
+        }
+        surface.finishBatch(batch);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(sampledColor[i], expectedColor[i]);
+    }
+
+    QPoint errorPoint;
+    if (!compareDevices(immediateDevice, batchedDevice, &errorPoint)) {
+        QFAIL(qPrintable(QString("Batched rendering differs from the immediate one at pixel %1,%2")
+                         .arg(errorPoint.x()).arg(errorPoint.y())));
+    }
+}
+
 SIMPLE_TEST_MAIN(KisMyPaintOpTest)
@@ -24,6 +24,12 @@ private Q_SLOTS:
     void testDab();
     void testGetColor();
     void testLoading();
+
+    void testCalculateAlphaVectorized();
+
+    void testBatchedRendering_data();
+    void testBatchedRendering();
+    void testGetColorWithPendingBatch();
 };
 
 #endif // KIS_MYPAINTOP_TEST_H
@@ -21,6 +21,7 @@
 #include <kis_transform_mask.h>
 #include "kis_transform_mask_adapter.h"
 #include "kis_transform_utils.h"
+#include "kis_liquify_transform_worker.h"
 #include "kis_convex_hull.h"
 #include "kis_abstract_projection_plane.h"
 #include "kis_recalculate_transform_mask_job.h"
@@ -97,6 +98,18 @@ struct InplaceTransformStrokeStrategy::Private
     QHash<KisPaintDevice*, KisPaintDeviceSP> devicesCacheHash;
     QHash<KisTransformMask*, KisPaintDeviceSP> transformMaskCacheHash;
 
+    /**
+     * Liquify is rendered incrementally: for every transformed device and
+     * level of detail we keep the last rendered result together with a copy
+     * of the worker it was rendered with, so that only the cells changed
+     * since the previous update are re-rasterized.
+     */
+    struct LiquifyCache {
+        QScopedPointer<KisLiquifyTransformWorker> worker;
+        KisPaintDeviceSP result;
+    };
+    QHash<QPair<KisPaintDevice*, int>, QSharedPointer<LiquifyCache>> liquifyCacheHash;
+
     QMutex dirtyRectsMutex;
     KisBatchNodeUpdate dirtyRects;
     KisBatchNodeUpdate prevDirtyRects;
@@ -815,9 +828,13 @@ void InplaceTransformStrokeStrategy::transformNode(KisNodeSP node, const ToolTra
 
         KisTransaction transaction(device);
 
-        KisProcessingVisitor::ProgressHelper helper(node);
-        KisTransformUtils::transformAndMergeDevice(config, cachedPortion,
-                                                   device, &helper);
+        if (config.mode() == ToolTransformArgs::LIQUIFY && config.liquifyWorker()) {
+            liquifyAndMergeDevice(config, cachedPortion, device, levelOfDetail);
+        } else {
+            KisProcessingVisitor::ProgressHelper helper(node);
+            KisTransformUtils::transformAndMergeDevice(config, cachedPortion,
+                                                       device, &helper);
+        }
 
         executeAndAddCommand(transaction.endAndTake(), commandGroup, KisStrokeJobData::CONCURRENT);
         addDirtyRect(node, cachedPortion->extent() | node->projectionPlane()->tightUserVisibleBounds(), levelOfDetail);
@@ -859,6 +876,43 @@ void InplaceTransformStrokeStrategy::transformNode(KisNodeSP node, const ToolTra
     }
 }
 
+void InplaceTransformStrokeStrategy::liquifyAndMergeDevice(const ToolTransformArgs &config,
+                                                           KisPaintDeviceSP src,
+                                                           KisPaintDeviceSP dst,
+                                                           int levelOfDetail)
+{
+    QSharedPointer<Private::LiquifyCache> cache;
+
+    {
+        QMutexLocker l(&m_d->devicesCacheMutex);
+
+        QSharedPointer<Private::LiquifyCache> &cacheRef =
+            m_d->liquifyCacheHash[qMakePair(dst.data(), levelOfDetail)];
+
+        if (!cacheRef) {
+            cacheRef.reset(new Private::LiquifyCache());
+        }
+        cache = cacheRef;
+    }
+
+    // every device is transformed by a single job only, so the cache
+    // itself needs no locking
+    if (!cache->worker) {
+        cache->worker.reset(new KisLiquifyTransformWorker(*config.liquifyWorker()));
+        cache->result = new KisPaintDevice(src->colorSpace());
+        cache->result->prepareClone(src);
+    } else {
+        cache->worker->updatePointsFrom(*config.liquifyWorker());
+    }
+
+    cache->worker->runIncremental(src, cache->result);
+
+    const QRect mergeRect = cache->result->extent();
+    KisPainter painter(dst);
+    painter.bitBlt(mergeRect.topLeft(), cache->result, mergeRect);
+    painter.end();
+}
+
 void InplaceTransformStrokeStrategy::createCacheAndClearNode(KisNodeSP node)
 {
     KisPaintDeviceSP device;